@@ -2132,6 +2132,13 @@ mfxStatus VideoDECODEMJPEGBase_SW::FillEntryPoint(MFX_ENTRY_POINT *pEntryPoint,
 
     pEntryPoint->requiredNumThreads = std::min(pLastTask->m_pMJPEGVideoDecoder->NumDecodersAllocated(),
                                                pLastTask->NumPiecesCollected());
+
+    // a single piece can't be shared, let the other threads help with
+    // the reconstruction of its MCU rows
+    if (pLastTask->m_pMJPEGVideoDecoder->StartPipeline(*pLastTask))
+    {
+        pEntryPoint->requiredNumThreads = pLastTask->m_pMJPEGVideoDecoder->NumDecodersAllocated();
+    }
     pEntryPoint->pParam = pLastTask;
 
     return MFX_ERR_NONE;
@@ -2192,6 +2199,28 @@ mfxStatus VideoDECODEMJPEGBase_SW::RunThread(void *pParam, mfxU32 threadNumber,
     if (!task)
         return MFX_ERR_NULL_PTR;
 
+    // pipelined picture. the first call entropy decodes the picture, the
+    // helper calls reconstruct rows being ready and leave. They are called
+    // again until the picture is done. A helper finding no row ready reports
+    // busy, so the thread doesn't spin on the task.
+    if (task->m_pMJPEGVideoDecoder->IsPipelined())
+    {
+        if (0 == callNumber)
+        {
+            task->m_pMJPEGVideoDecoder->DecodePicturePipelined(*task);
+
+            return MFX_TASK_DONE;
+        }
+
+        int rows = task->m_pMJPEGVideoDecoder->ProcessPipelinedRows(threadNumber);
+        if (rows < 0)
+        {
+            return MFX_TASK_DONE;
+        }
+
+        return (rows) ? (MFX_TASK_WORKING) : (MFX_TASK_BUSY);
+    }
+
     // check the number of call. one call = one piece decoded. all extra call
     // should go exit.
     if (callNumber >= task->NumPiecesCollected())
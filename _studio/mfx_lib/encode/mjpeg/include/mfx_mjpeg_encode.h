@@ -67,10 +67,18 @@ public:
 
     mfxU32           m_initialDataLength;
 
+    // The task is a single piece encoded by the intra-scan pipeline
+    bool             m_pipelined;
+
     std::unique_ptr<UMC::MJPEGVideoEncoder> m_pMJPEGVideoEncoder;
 
     mfxStatus EncodePiece(const mfxU32 threadNumber);
 
+    // Encode the single piece of the task. Call 0 entropy codes the piece,
+    // the other calls transform MCU rows being available and leave. They are
+    // called again until the piece is done.
+    mfxStatus EncodePiecePipelined(const mfxU32 threadNumber, const mfxU32 callNumber);
+
 protected:
     // Close the object, release all resources
     void      Close(void);
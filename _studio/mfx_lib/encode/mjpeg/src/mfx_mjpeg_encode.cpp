@@ -43,6 +43,7 @@ MJPEGEncodeTask::MJPEGEncodeTask(void)
     , bs(NULL)
     , auxInput()
     , m_initialDataLength(0)
+    , m_pipelined(false)
     , encodedPieces(0)
 {
 } // MJPEGEncodeTask::MJPEGEncodeTask(void)
@@ -93,6 +94,7 @@ mfxStatus MJPEGEncodeTask::Initialize(UMC::VideoEncoderParams* params)
 void MJPEGEncodeTask::Reset(void)
 {
     m_initialDataLength = 0;
+    m_pipelined = false;
     encodedPieces = 0;
 
     if(m_pMJPEGVideoEncoder)
@@ -624,6 +626,33 @@ mfxStatus MJPEGEncodeTask::EncodePiece(const mfxU32 threadNumber)
     return (pieceNum == NumPiecesCollected()) ? (MFX_TASK_DONE) : (MFX_TASK_WORKING);
 }
 
+mfxStatus MJPEGEncodeTask::EncodePiecePipelined(const mfxU32 threadNumber, const mfxU32 callNumber)
+{
+    // the helper calls don't wait for the rows, the scheduler calls them again
+    if (callNumber)
+    {
+        int rows = m_pMJPEGVideoEncoder->ProcessPipelinedRows(threadNumber);
+        if (rows < 0)
+        {
+            return MFX_TASK_DONE;
+        }
+
+        return (rows) ? (MFX_TASK_WORKING) : (MFX_TASK_BUSY);
+    }
+
+    UMC::Status umc_sts = m_pMJPEGVideoEncoder->EncodePiecePipelined();
+    if(UMC::UMC_ERR_INVALID_PARAMS == umc_sts)
+    {
+        return MFX_ERR_UNDEFINED_BEHAVIOR;
+    }
+    if(UMC::UMC_OK != umc_sts)
+    {
+        return MFX_ERR_UNKNOWN;
+    }
+
+    return MFX_TASK_DONE;
+}
+
 mfxStatus MFXVideoENCODEMJPEG::MJPEGENCODERoutine(void *pState, void *pParam, mfxU32 threadNumber, mfxU32 callNumber)
 {
     mfxStatus mfxRes = MFX_ERR_NONE;
@@ -631,6 +660,12 @@ mfxStatus MFXVideoENCODEMJPEG::MJPEGENCODERoutine(void *pState, void *pParam, mf
     MJPEGEncodeTask *pTask = (MJPEGEncodeTask*)pParam;
 
     mfxRes = obj.RunThread(*pTask, threadNumber, callNumber);
+
+    // the helper calls come back until the first one is done, finish them
+    if (pTask->m_pipelined && 0 == callNumber && MFX_ERR_NONE > mfxRes)
+    {
+        pTask->m_pMJPEGVideoEncoder->FinishPipeline();
+    }
     MFX_CHECK_STS(mfxRes);
 
     return mfxRes;
@@ -1702,6 +1737,11 @@ mfxStatus MFXVideoENCODEMJPEG::RunThread(MJPEGEncodeTask &task, mfxU32 threadNum
         return MFX_TASK_WORKING;
     }
 
+    if (task.m_pipelined)
+    {
+        return task.EncodePiecePipelined(threadNumber, callNumber);
+    }
+
     return task.EncodePiece(threadNumber);
 }
 
@@ -1948,8 +1988,19 @@ mfxStatus MFXVideoENCODEMJPEG::EncodeFrameCheck(mfxEncodeCtrl *ctrl, mfxFrameSur
             pTask = m_freeTasks.front();
         }
 
+        mfxU32 numPieces = pTask->CalculateNumPieces(pOriginalSurface, &(m_vParam.mfx.FrameInfo));
+
         pEntryPoint->requiredNumThreads = std::min<mfxU32>( { pTask->m_pMJPEGVideoEncoder->NumEncodersAllocated(), m_vParam.mfx.NumThread,
-                                                      pTask->CalculateNumPieces(pOriginalSurface, &(m_vParam.mfx.FrameInfo)) } );
+                                                      numPieces } );
+
+        // a single piece can't be shared, let the other threads help with
+        // the transform of its MCU rows
+        pTask->m_pipelined = pTask->m_pMJPEGVideoEncoder->IsPipelineAllowed(numPieces) && (m_vParam.mfx.NumThread > 1);
+        if (pTask->m_pipelined)
+        {
+            pTask->m_pMJPEGVideoEncoder->StartPipeline();
+            pEntryPoint->requiredNumThreads = std::min<mfxU32>(pTask->m_pMJPEGVideoEncoder->NumEncodersAllocated(), m_vParam.mfx.NumThread);
+        }
 
         pTask->bs           = bs;
         pTask->ctrl         = ctrl;
@@ -989,6 +989,7 @@ namespace MfxHwH264Encode
             , m_wsGpuImage(0)
             , m_wsIdxGpuImage(0)
             , m_Yscd(0)
+            , m_scdQueued(false)
         {
             Zero(m_ctrl);
             Zero(m_internalListCtrl);
@@ -1241,6 +1242,7 @@ namespace MfxHwH264Encode
         CmSurface2DUP *m_wsGpuImage;
         SurfaceIndex  *m_wsIdxGpuImage;
         mfxU8         *m_Yscd;
+        bool           m_scdQueued; // system memory frame waits in ASC queue
 
         BRCFrameParams  m_brcFrameParams;
         mfxBRCFrameCtrl m_brcFrameCtrl;
@@ -1984,7 +1984,15 @@ mfxStatus ImplementationAvc::SCD_Put_Frame(DdiTask & task)
             return Error(MFX_ERR_LOCK_MEMORY);
         task.m_idxScd = FindFreeResourceIndex(m_scd);
         task.m_Yscd = (mfxU8*)m_scd.GetSysmemBuffer(task.m_idxScd);
-        MFX_SAFE_CALL(amtScd.PutFrameProgressive(pData.Y, pData.Pitch));
+        MFX_SAFE_CALL(amtScd.QueueFrameProgressive(pData.Y, pData.Pitch));
+        task.m_scdQueued = true;
+
+        // Input surface is referenced till the task is encoded, but a frame
+        // mapped for this call only has to be subsampled before unlock.
+        // Otherwise it is done by EncodeFrameCheck() of the next frame or
+        // at STG_WAIT_SCD.
+        if (task.m_yuv->Data.Y == 0)
+            amtScd.PrepareQueuedFrames();
     }
     return MFX_ERR_NONE;
 }
@@ -1996,6 +2004,11 @@ mfxStatus ImplementationAvc::SCD_Get_FrameType(DdiTask & task)
         MFX_SAFE_CALL(amtScd.ProcessQueuedFrame(&task.m_wsSubSamplingEv, &task.m_wsSubSamplingTask, &task.m_wsGpuImage, &task.m_Yscd));
         ReleaseResource(m_scd, (mfxHDL)task.m_wsGpuImage);
     }
+    else if (task.m_scdQueued)
+    {
+        MFX_SAFE_CALL(amtScd.ProcessQueuedFrame());
+        task.m_scdQueued = false;
+    }
     mfxExtCodingOption2 const & extOpt2 = GetExtBufferRef(m_video);
     mfxExtCodingOption3 const & extOpt3 = GetExtBufferRef(m_video);
     task.m_SceneChange = amtScd.Get_frame_shot_Decision();
@@ -2079,6 +2092,11 @@ mfxStatus ImplementationAvc::Prd_LTR_Operation(DdiTask & task)
         m_scd.UpdateResourcePointers(task.m_idxScd, (void *)task.m_Yscd, (void *)task.m_wsGpuImage);
         ReleaseResource(m_scd, (mfxHDL)task.m_wsGpuImage);
     }
+    else if (task.m_scdQueued)
+    {
+        MFX_SAFE_CALL(amtScd.ProcessQueuedFrame());
+        task.m_scdQueued = false;
+    }
     task.m_frameLtrReassign = 0;
     task.m_LtrOrder = m_LtrOrder;
     task.m_RefOrder = m_RefOrder;
@@ -3345,6 +3363,12 @@ mfxStatus ImplementationAvc::EncodeFrameCheckNormalWay(
     }
 
 
+    // Frame queued for scene change detection by the previous AsyncRoutine
+    // is subsampled here, its Rs/Cs are computed in parallel with
+    // the scheduler's thread.
+    if (IsExtBrcSceneChangeSupported(m_video) && !IsCmNeededForSCD(m_video))
+        amtScd.PrepareQueuedFrame();
+
     *reordered_surface = surface;
 
     entryPoints[0].pState               = this;
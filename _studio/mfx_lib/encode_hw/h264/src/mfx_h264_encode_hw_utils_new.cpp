@@ -3193,7 +3193,7 @@ void AsyncRoutineEmulator::Init(MfxVideoParam const & video)
     default:
         m_stageGreediness[STG_ACCEPT_FRAME] = 1;
         m_stageGreediness[STG_START_SCD] = 1;
-        m_stageGreediness[STG_WAIT_SCD] = IsExtBrcSceneChangeSupported(video) && IsCmNeededForSCD(video) ? 1 + !!(video.AsyncDepth > 1) : 1;
+        m_stageGreediness[STG_WAIT_SCD] = IsExtBrcSceneChangeSupported(video) ? 1 + !!(video.AsyncDepth > 1) : 1;
         m_stageGreediness[STG_START_LA    ] = video.mfx.EncodedOrder ? 1 : video.mfx.GopRefDist;
         m_stageGreediness[STG_WAIT_LA     ] = 1;
         m_stageGreediness[STG_START_HIST  ] = 1;
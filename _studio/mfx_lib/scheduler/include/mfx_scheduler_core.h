@@ -36,6 +36,7 @@
 #include <umc_event.h>
 
 #include <vector>
+#include <mutex>
 
 #include "mfx_common.h"
 
@@ -57,6 +58,40 @@ enum
     MFX_INVALID_THREAD_ID       = -1
 };
 
+enum
+{
+    // number of buckets in the time histograms. The bucket i counts times
+    // in range [2^i, 2^(i+1)) usec, the last bucket counts all larger times.
+    MFX_SCHEDULER_HISTOGRAM_BINS = 16
+};
+
+typedef
+struct MFX_SCHEDULER_STATISTICS
+{
+    // Time tasks spent ready to run before their first call
+    mfxU64 queueWaitTime[MFX_SCHEDULER_HISTOGRAM_BINS];
+    // Overall time spent by calls of completed tasks
+    mfxU64 runTime[MFX_SCHEDULER_HISTOGRAM_BINS];
+
+    // Integral time (in usec) all threads waited for the scheduler's guard
+    mfxU64 lockWaitTime;
+    // Integral time (in usec) all threads held the scheduler's guard
+    mfxU64 lockHoldTime;
+
+    // Number of threads notified by WakeUpThreads
+    mfxU64 numWakeUps;
+    // Number of wake ups, after which the thread found no task to do
+    mfxU64 numSpuriousWakeUps;
+
+    // Number of dependency table entries currently in use (including holes)
+    mfxU32 numDependencies;
+    // Peak number of dependency table entries in use
+    mfxU32 maxNumDependencies;
+    // Size of the dependency table
+    mfxU32 dependencyTableSize;
+
+} MFX_SCHEDULER_STATISTICS;
+
 enum
 {
     MFX_THREAD_TIME_TO_WAIT     = 1000
@@ -216,7 +251,43 @@ public:
     // WA for SINGLE THREAD MODE
     virtual
     mfxStatus GetTimeout(mfxU32 & maxTimeToRun);
+
+    // Get the scheduler's contention and latency statistics
+    mfxStatus GetStatistics(MFX_SCHEDULER_STATISTICS *pStat);
 protected:
+    // Scoped lock of the scheduler's guard. The time threads wait for the guard
+    // and hold it is accumulated into the statistics, the time of waiting on
+    // a condition variable is not counted as holding.
+    class Guard
+    {
+    public:
+        explicit Guard(mfxSchedulerCore &core) : m_core(core), m_owns(false) { lock(); }
+        ~Guard() { if (m_owns) unlock(); }
+
+        void lock() { m_core.LockGuard(); m_owns = true; }
+        void unlock() { m_owns = false; m_core.UnlockGuard(); }
+
+        // Leave the guard for the time of waiting, the routine waits on the given lock
+        template <class Routine>
+        void Wait(Routine wait)
+        {
+            m_core.m_lockHoldTime += m_core.GetHighPerformanceCounter() - m_core.m_lockAcquired;
+
+            std::unique_lock<std::mutex> lock(m_core.m_guard, std::adopt_lock);
+            wait(lock);
+            lock.release();
+
+            m_core.m_lockAcquired = m_core.GetHighPerformanceCounter();
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    private:
+        mfxSchedulerCore &m_core;
+        bool m_owns;
+    };
+
     // Destructor is protected to avoid deletion the object by occasion.
     virtual
     ~mfxSchedulerCore(void);
@@ -225,7 +296,12 @@ protected:
     void Close(void);
 
     // Wait until the scheduler got more work
-    void Wait(const mfxU32 curThreadNum, std::unique_lock<std::mutex>& mutex);
+    void Wait(const mfxU32 curThreadNum, Guard& guard);
+
+    // Enter and leave the scheduler's guard, counting the time of waiting
+    // for it and holding it
+    void LockGuard(void);
+    void UnlockGuard(void);
 
     // Get high performance counter value. This counter is used to calculate
     // tasks duration and priority management.
@@ -237,6 +313,9 @@ protected:
     // Version of synchronize function, which uses handle
     mfxStatus Synchronize(mfxTaskHandle handle, mfxU32 timeToWait);
 
+    // Convert high performance counter ticks into usec
+    mfxU64 GetTimeUsec(mfxU64 ticks) const;
+
     //
     // WARNING: The functions below are not a thread-safe function,
     // external synchronization is required.
@@ -266,6 +345,13 @@ protected:
     void GetTimeStat(mfxU64 timeSpent[MFX_PRIORITY_NUMBER],
                      mfxU64 totalTimeSpent[MFX_PRIORITY_NUMBER]);
 
+    // Add the time (in ticks) to the histogram
+    void UpdateTimeHistogram(mfxU64 histogram[MFX_SCHEDULER_HISTOGRAM_BINS], mfxU64 ticks);
+    // Collect the statistics of the scheduler and its threads
+    void GetStatisticsUnsafe(MFX_SCHEDULER_STATISTICS &stat);
+    // Export the statistics as trace counters
+    void TraceStatistics(void);
+
     // Check if the thread can continue the previous task.
     mfxStatus CanContinuePreviousTask(MFX_CALL_INFO &callInfo,
                                       mfxTaskHandle previousTask,
@@ -280,6 +366,21 @@ protected:
                          MFX_SCHEDULER_TASK *pTask,
                          const mfxU32 threadNum);
 
+    // Provide a task from the threads' ready queues (work stealing mode).
+    mfxStatus GetReadyTask(MFX_CALL_INFO &callInfo,
+                           const mfxU32 threadNum,
+                           const mfxU64 timeSpent[MFX_PRIORITY_NUMBER],
+                           const mfxU64 totalTimeSpent[MFX_PRIORITY_NUMBER]);
+    // Put the ready task into the ready queue of the given thread
+    void PushReadyTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum);
+    // Put the task with resolved dependencies into the ready queue,
+    // the parked list or the waiting list depending on its state
+    void QueueTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum);
+    // Return parked tasks of the thread assignment into the ready queues
+    void UnparkTasks(MFX_THREAD_ASSIGNMENT &occupancyInfo, const mfxU32 threadNum);
+    // Move 'waiting' tasks, which got ready, into the ready queue of the thread
+    void RequeueWaitingTasks(const mfxU32 threadNum);
+
     inline void call_pRoutine(MFX_CALL_INFO& call);
 
     //
@@ -365,6 +466,15 @@ protected:
     MFX_THREADS_TIME m_workingTime[MFX_TIME_STAT_PARTS];
     // Current time statistic index
     mfxU32 m_timeIdx;
+    // Contention and latency statistics. Threads' spurious wake ups
+    // are kept in the threads' contexts.
+    MFX_SCHEDULER_STATISTICS m_stat;
+    // Integral time (in ticks) of waiting for the guard and holding it,
+    // updated by the guard's owner
+    mfxU64 m_lockWaitTime;
+    mfxU64 m_lockHoldTime;
+    // Time the current owner acquired the guard
+    mfxU64 m_lockAcquired;
 
     //
     // THREADING STUFF
@@ -413,6 +523,14 @@ protected:
     mfxU32 m_DedicatedThreadsToWakeUp;
     // Number of tasks for non-dedicated threads
     mfxU32 m_RegularThreadsToWakeUp;
+    // Ready tasks are distributed over the threads' queues
+    bool m_bWorkStealing;
+    // Queue to put the next submitted task to (work stealing mode)
+    mfxU32 m_nextReadyQueue;
+    // Queue to put tasks with just resolved dependencies to (work stealing mode)
+    mfxU32 m_resolvingThreadNum;
+    // Tasks waiting for a busy object to get free (work stealing mode)
+    std::vector<MFX_SCHEDULER_TASK *> m_waitingTasks;
 
     // these members are used only from the main thread,
     // so synchronization is not necessary to access them.
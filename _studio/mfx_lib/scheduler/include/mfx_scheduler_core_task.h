@@ -34,6 +34,20 @@ struct MFX_SCHEDULER_TASK;
 
 
 class mfxSchedulerCore;
+
+// Queue holding a task in the work stealing mode
+enum MFX_SCHEDULER_QUEUE_STATE
+{
+    // task is not queued. It is either being processed, or it is not ready
+    MFX_QUEUE_NONE = 0,
+    // task is in a thread's ready queue
+    MFX_QUEUE_READY = 1,
+    // task is in the parked list of its thread assignment
+    MFX_QUEUE_PARKED = 2,
+    // task is in the scheduler's list of 'waiting' tasks
+    MFX_QUEUE_WAITING = 3
+};
+
 struct MFX_THREAD_ASSIGNMENT
 {
     // Pointer to the object being shared among the threads/tasks
@@ -55,6 +69,10 @@ struct MFX_THREAD_ASSIGNMENT
     // Pointer to the last task using this pState.
     MFX_SCHEDULER_TASK *pLastTask;
 
+    // List of ready tasks waiting for threads of this element to get free.
+    // It is used in the work stealing mode only.
+    MFX_SCHEDULER_TASK *pParkedTasks;
+
 };
 
 struct MFX_SCHEDULER_TASK : public mfxDependencyItem<MFX_TASK_NUM_DEPENDENCIES>
@@ -118,6 +136,8 @@ struct MFX_SCHEDULER_TASK : public mfxDependencyItem<MFX_TASK_NUM_DEPENDENCIES>
 
         // task timing parameters
         bool bWaiting;                                              // (bool) task needs some waiting
+        MFX_SCHEDULER_QUEUE_STATE queueState;                       // (MFX_SCHEDULER_QUEUE_STATE) queue holding the task
+        MFX_SCHEDULER_TASK *pNextParked;                            // (MFX_SCHEDULER_TASK *) next task of the parked list
         struct
         {
             // Time in msec of the last 'entering' to the task
@@ -132,6 +152,8 @@ struct MFX_SCHEDULER_TASK : public mfxDependencyItem<MFX_TASK_NUM_DEPENDENCIES>
             mfxU64 timeOverhead;
             // HW counter value of the last 'entering' to the task
             mfxU64 hwCounterLastEnter;
+            // Time stamp of the task becoming ready to run
+            mfxU64 timeReady;
         } timing;
 
         // source file info
@@ -22,12 +22,23 @@
 #define __MFX_SCHEDULER_CORE_THREAD_H
 
 #include <mfxdefs.h>
+#include <mfx_task.h>
 
 #include <thread>
 #include <condition_variable>
+#include <deque>
 
 // forward declaration of the owning class
 class mfxSchedulerCore;
+struct MFX_SCHEDULER_TASK;
+
+// Entry of a ready tasks queue. The job number lets the scheduler skip entries
+// of tasks, which were completed (and probably reused) after being queued.
+struct MFX_SCHEDULER_READY_TASK
+{
+    MFX_SCHEDULER_TASK *pTask;
+    mfxU32 jobID;
+};
 
 struct MFX_SCHEDULER_THREAD_CONTEXT
 {
@@ -38,6 +49,7 @@ struct MFX_SCHEDULER_THREAD_CONTEXT
       , threadHandle()
       , workTime(0)
       , sleepTime(0)
+      , numSpuriousWakeUps(0)
     {}
 
     enum State {
@@ -51,8 +63,13 @@ struct MFX_SCHEDULER_THREAD_CONTEXT
     std::thread threadHandle;          // thread handle
     std::condition_variable taskAdded; // cond. variable to signal new tasks
 
+    // ready tasks queues of the thread, used in the work stealing mode only.
+    // The owner takes tasks from the back, other threads steal from the front.
+    std::deque<MFX_SCHEDULER_READY_TASK> readyTasks[MFX_PRIORITY_NUMBER][MFX_TYPE_NUMBER];
+
     mfxU64 workTime;                   // integral working time
     mfxU64 sleepTime;                  // integral sleeping time
+    mfxU64 numSpuriousWakeUps;         // number of wake ups without a task to do
 };
 
 #endif // #ifndef __MFX_SCHEDULER_CORE_THREAD_H
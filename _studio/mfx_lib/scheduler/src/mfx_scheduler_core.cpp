@@ -37,12 +37,19 @@ mfxSchedulerCore::mfxSchedulerCore(void)
     , m_hwWakeUpThread()
     , m_DedicatedThreadsToWakeUp(0)
     , m_RegularThreadsToWakeUp(0)
+    , m_bWorkStealing(false)
+    , m_nextReadyQueue(0)
+    , m_resolvingThreadNum(0)
 {
     memset(&m_param, 0, sizeof(m_param));
     m_refCounter = 1;
 
     memset(m_workingTime, 0, sizeof(m_workingTime));
     m_timeIdx = 0;
+    memset(&m_stat, 0, sizeof(m_stat));
+    m_lockWaitTime = 0;
+    m_lockHoldTime = 0;
+    m_lockAcquired = 0;
 
     m_bQuit = false;
 
@@ -113,7 +120,7 @@ void mfxSchedulerCore::Close(void)
 
         {
             // set the events to wake up sleeping threads
-            std::lock_guard<std::mutex> guard(m_guard);
+            Guard guard(*this);
             WakeUpThreads();
         }
 
@@ -150,6 +157,7 @@ void mfxSchedulerCore::Close(void)
 
     memset(m_workingTime, 0, sizeof(m_workingTime));
     m_timeIdx = 0;
+    memset(&m_stat, 0, sizeof(m_stat));
 
     // reset variables
     m_bQuit = false;
@@ -170,6 +178,11 @@ void mfxSchedulerCore::Close(void)
     // reset task counters
     m_taskCounter = 0;
     m_jobCounter = 0;
+
+    m_bWorkStealing = false;
+    m_nextReadyQueue = 0;
+    m_resolvingThreadNum = 0;
+    m_waitingTasks.clear();
 }
 
 void mfxSchedulerCore::WakeUpThreads(mfxU32 num_dedicated_threads, mfxU32 num_regular_threads)
@@ -184,6 +197,7 @@ void mfxSchedulerCore::WakeUpThreads(mfxU32 num_dedicated_threads, mfxU32 num_re
         thctx = GetThreadCtx(0);
         if (thctx->state == MFX_SCHEDULER_THREAD_CONTEXT::Waiting) {
             thctx->taskAdded.notify_one();
+            m_stat.numWakeUps += 1;
         }
     }
     // if we have woken up dedicated thread, we exclude it from the loop below
@@ -191,20 +205,38 @@ void mfxSchedulerCore::WakeUpThreads(mfxU32 num_dedicated_threads, mfxU32 num_re
         thctx = GetThreadCtx(i);
         if (thctx->state == MFX_SCHEDULER_THREAD_CONTEXT::Waiting) {
             thctx->taskAdded.notify_one();
+            m_stat.numWakeUps += 1;
             --num_regular_threads;
         }
     }
 }
 
-void mfxSchedulerCore::Wait(const mfxU32 curThreadNum, std::unique_lock<std::mutex>& mutex)
+void mfxSchedulerCore::Wait(const mfxU32 curThreadNum, Guard& guard)
 {
     MFX_SCHEDULER_THREAD_CONTEXT* thctx = GetThreadCtx(curThreadNum);
 
     if (thctx) {
-        thctx->taskAdded.wait(mutex);
+        guard.Wait([thctx](std::unique_lock<std::mutex>& lock) { thctx->taskAdded.wait(lock); });
     }
 }
 
+void mfxSchedulerCore::LockGuard(void)
+{
+    mfxU64 start = GetHighPerformanceCounter();
+
+    m_guard.lock();
+    m_lockAcquired = GetHighPerformanceCounter();
+    m_lockWaitTime += m_lockAcquired - start;
+
+} // void mfxSchedulerCore::LockGuard(void)
+
+void mfxSchedulerCore::UnlockGuard(void)
+{
+    m_lockHoldTime += GetHighPerformanceCounter() - m_lockAcquired;
+    m_guard.unlock();
+
+} // void mfxSchedulerCore::UnlockGuard(void)
+
 mfxU64 mfxSchedulerCore::GetHighPerformanceCounter(void)
 {
     return (mfxU64) vm_time_get_tick();
@@ -216,6 +248,101 @@ mfxU32 mfxSchedulerCore::GetLowResCurrentTime(void)
     return vm_time_get_current_time();
 
 } // mfxU32 mfxSchedulerCore::GetCurrentTime(void)
+
+mfxU64 mfxSchedulerCore::GetTimeUsec(mfxU64 ticks) const
+{
+    return (m_vmtick_msec_frequency) ? (ticks * 1000 / m_vmtick_msec_frequency) : (0);
+
+} // mfxU64 mfxSchedulerCore::GetTimeUsec(mfxU64 ticks) const
+
+void mfxSchedulerCore::UpdateTimeHistogram(mfxU64 histogram[MFX_SCHEDULER_HISTOGRAM_BINS], mfxU64 ticks)
+{
+    mfxU64 time = GetTimeUsec(ticks);
+    mfxU32 bin = 0;
+
+    // find the log2 bucket of the time
+    while ((time >>= 1) && (bin < MFX_SCHEDULER_HISTOGRAM_BINS - 1))
+    {
+        bin += 1;
+    }
+    histogram[bin] += 1;
+
+} // void mfxSchedulerCore::UpdateTimeHistogram(mfxU64 histogram[MFX_SCHEDULER_HISTOGRAM_BINS], mfxU64 ticks)
+
+void mfxSchedulerCore::GetStatisticsUnsafe(MFX_SCHEDULER_STATISTICS &stat)
+{
+    mfxU32 i;
+
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    stat = m_stat;
+    stat.lockWaitTime = GetTimeUsec(m_lockWaitTime);
+    // the current owner's time is counted up to the moment
+    stat.lockHoldTime = GetTimeUsec(m_lockHoldTime + GetHighPerformanceCounter() - m_lockAcquired);
+
+    // gather threads' counters
+    for (i = 0; (m_pThreadCtx) && (i < m_param.numberOfThreads); i += 1)
+    {
+        stat.numSpuriousWakeUps += m_pThreadCtx[i].numSpuriousWakeUps;
+    }
+
+    stat.numDependencies = m_numDependencies;
+    stat.dependencyTableSize = (mfxU32) m_pDependencyTable.size();
+
+} // void mfxSchedulerCore::GetStatisticsUnsafe(MFX_SCHEDULER_STATISTICS &stat)
+
+void mfxSchedulerCore::TraceStatistics(void)
+{
+#ifdef MFX_TRACE_ENABLE
+    // every counter needs its own static handle, the histograms' ones are
+    // kept together with the names of the bins
+    struct HistogramCounters
+    {
+        HistogramCounters(const char *pName)
+        {
+            memset(handles, 0, sizeof(handles));
+            for (mfxU32 i = 0; i < MFX_SCHEDULER_HISTOGRAM_BINS; i += 1)
+            {
+                snprintf(names[i], sizeof(names[i]), "%s[%u]", pName, i);
+            }
+        }
+
+        void Trace(const mfxU64 histogram[MFX_SCHEDULER_HISTOGRAM_BINS])
+        {
+            for (mfxU32 i = 0; i < MFX_SCHEDULER_HISTOGRAM_BINS; i += 1)
+            {
+                MFXTrace_Counter(&handles[i], __FILE__, __LINE__, __FUNCTION__, MFX_TRACE_CATEGORY,
+                                 MFX_TRACE_LEVEL_SCHED, names[i], histogram[i]);
+            }
+        }
+
+        mfxTraceStaticHandle handles[MFX_SCHEDULER_HISTOGRAM_BINS];
+        char names[MFX_SCHEDULER_HISTOGRAM_BINS][32];
+    };
+    static HistogramCounters queueWaitCounters("queueWaitTime"), runCounters("runTime");
+    MFX_SCHEDULER_STATISTICS stat;
+
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    GetStatisticsUnsafe(stat);
+
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "lockWaitTime", stat.lockWaitTime);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "lockHoldTime", stat.lockHoldTime);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "numWakeUps", stat.numWakeUps);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "numSpuriousWakeUps", stat.numSpuriousWakeUps);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "numDependencies", stat.numDependencies);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_SCHED, "maxNumDependencies", stat.maxNumDependencies);
+    queueWaitCounters.Trace(stat.queueWaitTime);
+    runCounters.Trace(stat.runTime);
+#endif // MFX_TRACE_ENABLE
+
+} // void mfxSchedulerCore::TraceStatistics(void)
 mfxStatus mfxSchedulerCore::AllocateEmptyTask(void)
 {
     //
@@ -514,6 +641,7 @@ void mfxSchedulerCore::RegisterTaskDependencies(MFX_SCHEDULER_TASK  *pTask)
     {
         m_numDependencies = tableIdx;
     }
+    m_stat.maxNumDependencies = std::max(mfxU32(m_stat.maxNumDependencies), mfxU32(m_numDependencies));
 
     // if dependency were failed,
     // set the task into the 'aborted' state
@@ -93,6 +93,9 @@ mfxStatus mfxSchedulerCore::Initialize2(const MFX_SCHEDULER_PARAM2 *pParam)
             return MFX_ERR_UNSUPPORTED;
         }
 
+        // ready tasks are distributed over the threads' queues
+        m_bWorkStealing = (MFX_SCHEDULER_QUEUE_WORK_STEALING == m_param.queueMode);
+
 
         try
         {
@@ -196,7 +199,7 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
         mfxU64 frequency = vm_time_get_frequency();
         while (MFX_WRN_IN_EXECUTION == pTask->opRes)
         {
-            std::unique_lock<std::mutex> guard(m_guard);
+            Guard guard(*this);
             task_sts = GetTask(call, previousTaskHandle, 0);
 
             if (task_sts != MFX_ERR_NONE)
@@ -265,14 +268,16 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
     }
     else
     {
-        std::unique_lock<std::mutex> guard(m_guard);
+        Guard guard(*this);
 
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_PRIVATE, "Scheduler::Wait");
         MFX_LTRACE_1(MFX_TRACE_LEVEL_SCHED, "^Depends^on", "%d", pTask->param.task.nParentId);
         MFX_LTRACE_I(MFX_TRACE_LEVEL_SCHED, timeToWait);
 
-        pTask->done.wait_for(guard, std::chrono::milliseconds(timeToWait), [pTask, handle] {
-           return (pTask->jobID != handle.jobID) || (MFX_WRN_IN_EXECUTION != pTask->opRes);
+        guard.Wait([pTask, handle, timeToWait](std::unique_lock<std::mutex>& lock) {
+            pTask->done.wait_for(lock, std::chrono::milliseconds(timeToWait), [pTask, handle] {
+               return (pTask->jobID != handle.jobID) || (MFX_WRN_IN_EXECUTION != pTask->opRes);
+            });
         });
 
         if (pTask->jobID == handle.jobID) {
@@ -287,6 +292,26 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
     }
 }
 
+mfxStatus mfxSchedulerCore::GetStatistics(MFX_SCHEDULER_STATISTICS *pStat)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+    if (NULL == pStat)
+    {
+        return MFX_ERR_NULL_PTR;
+    }
+
+    Guard guard(*this);
+
+    GetStatisticsUnsafe(*pStat);
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerCore::GetStatistics(MFX_SCHEDULER_STATISTICS *pStat)
+
 mfxStatus mfxSchedulerCore::GetTimeout(mfxU32& maxTimeToRun)
 {
     (void)maxTimeToRun;
@@ -311,7 +336,7 @@ mfxStatus mfxSchedulerCore::WaitForDependencyResolved(const void *pDependency)
 
     // find a handle to wait
     {
-        std::lock_guard<std::mutex> guard(m_guard);
+        Guard guard(*this);
         mfxU32 curIdx;
 
         for (curIdx = 0; curIdx < m_numDependencies; curIdx += 1)
@@ -355,7 +380,7 @@ mfxStatus mfxSchedulerCore::WaitForAllTasksCompletion(const void *pOwner)
 
     // make sure that threads are running
     {
-        std::lock_guard<std::mutex> guard(m_guard);
+        Guard guard(*this);
 
         ResetWaitingTasks(pOwner);
         WakeUpThreads();
@@ -364,7 +389,7 @@ mfxStatus mfxSchedulerCore::WaitForAllTasksCompletion(const void *pOwner)
     std::list<mfxTaskHandle> tasks;
 
     {
-        std::lock_guard<std::mutex> guard(m_guard);
+        Guard guard(*this);
 
         ForEachTask(
             [&pOwner, &tasks](MFX_SCHEDULER_TASK* task)
@@ -409,7 +434,7 @@ mfxStatus mfxSchedulerCore::ResetWaitingStatus(const void *pOwner)
     // reset 'waiting' tasks belong to the given state
     ResetWaitingTasks(pOwner);
 
-    std::lock_guard<std::mutex> guard(m_guard);
+    Guard guard(*this);
 
     // wake up sleeping threads
     WakeUpThreads();
@@ -464,7 +489,7 @@ mfxStatus mfxSchedulerCore::Reset(void)
 
     // enter guarded section
     {
-        std::lock_guard<std::mutex> guard(m_guard);
+        Guard guard(*this);
 
         // clean up the working queue
         ScrubCompletedTasks(true);
@@ -539,7 +564,7 @@ mfxStatus mfxSchedulerCore::AddTask(const MFX_TASK &task, mfxSyncPoint *pSyncPoi
 
     // enter protected section
     {
-        std::lock_guard<std::mutex> guard(m_guard);
+        Guard guard(*this);
         mfxStatus mfxRes;
         MFX_SCHEDULER_TASK *pTask, **ppTemp;
         mfxTaskHandle handle;
@@ -650,6 +675,12 @@ mfxStatus mfxSchedulerCore::AddTask(const MFX_TASK &task, mfxSyncPoint *pSyncPoi
         }
 
         // wake up working threads if task has resolved dependencies
+        pTask->param.timing.timeReady = GetHighPerformanceCounter();
+        if (m_bWorkStealing) {
+            // spread submitted tasks over the threads' queues
+            QueueTask(pTask, m_nextReadyQueue);
+            m_nextReadyQueue = (m_nextReadyQueue + 1) % m_param.numberOfThreads;
+        }
         if (IsReadyToRun(pTask)) {
             WakeUpThreads(num_hw_threads, num_sw_threads);
         }
@@ -130,6 +130,12 @@ mfxStatus mfxSchedulerCore::GetTask(MFX_CALL_INFO &callInfo,
     // get time spent statistic
     GetTimeStat(timeSpent, totalTimeSpent);
 
+    // in the work stealing mode tasks are taken from the threads' queues
+    if (m_bWorkStealing)
+    {
+        return GetReadyTask(callInfo, threadNum, timeSpent, totalTimeSpent);
+    }
+
     // get the priority of the previous task
     prevTaskPriority = GetTaskPriority(previousTask);
 
@@ -228,6 +234,226 @@ mfxStatus mfxSchedulerCore::CanContinuePreviousTask(MFX_CALL_INFO &callInfo,
 
 } // mfxStatus mfxSchedulerCore::CanContinuePreviousTask(MFX_CALL_INFO &callInfo,
 
+mfxStatus mfxSchedulerCore::GetReadyTask(MFX_CALL_INFO &callInfo,
+                                         const mfxU32 threadNum,
+                                         const mfxU64 timeSpent[MFX_PRIORITY_NUMBER],
+                                         const mfxU64 totalTimeSpent[MFX_PRIORITY_NUMBER])
+{
+    mfxU32 run;
+
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    // 'waiting' tasks might get ready since the last call
+    RequeueWaitingTasks(threadNum);
+
+    // the runs are the same as in GetTask, but instead of scanning
+    // the whole task lists, the thread inspects its own ready queue first
+    // and steals ready tasks from other threads' queues after that.
+    for (run = 0; run < NUMBER_OF_RUNS; run += 1)
+    {
+        int priority;
+
+        for (priority = MFX_PRIORITY_HIGH;
+             priority >= MFX_PRIORITY_LOW;
+             priority -= 1)
+        {
+            if ((PRIORITY_RUN != run) ||
+                (TaskPriorityRatio[priority] * totalTimeSpent[priority] >=
+                 100 * timeSpent[priority]))
+            {
+                int type;
+
+                for (type = (threadNum) ? (MFX_TYPE_SOFTWARE) : (MFX_TYPE_HARDWARE);
+                     type <= MFX_TYPE_SOFTWARE;
+                     type += 1)
+                {
+                    mfxU32 i;
+
+                    for (i = 0; i < m_param.numberOfThreads; i += 1)
+                    {
+                        const mfxU32 victimNum = (threadNum + i) % m_param.numberOfThreads;
+
+                        // dedicated tasks are queued to the thread 0 only
+                        if ((MFX_TYPE_HARDWARE == type) && (victimNum))
+                        {
+                            break;
+                        }
+
+                        std::deque<MFX_SCHEDULER_READY_TASK> &queue =
+                            GetThreadCtx(victimNum)->readyTasks[priority][type];
+
+                        while (false == queue.empty())
+                        {
+                            MFX_SCHEDULER_READY_TASK entry;
+
+                            // take the latest task from the own queue,
+                            // steal the oldest task from other queues.
+                            if (victimNum == threadNum)
+                            {
+                                entry = queue.back();
+                                queue.pop_back();
+                            }
+                            else
+                            {
+                                entry = queue.front();
+                                queue.pop_front();
+                            }
+
+                            // the task was completed after queueing,
+                            // the entry belongs to the previous job.
+                            if (entry.jobID != entry.pTask->jobID)
+                            {
+                                continue;
+                            }
+                            entry.pTask->param.queueState = MFX_QUEUE_NONE;
+
+                            if (MFX_ERR_NONE == WrapUpTask(callInfo, entry.pTask, threadNum))
+                            {
+                                // let other threads join the task
+                                QueueTask(entry.pTask, threadNum);
+
+                                return MFX_ERR_NONE;
+                            }
+
+                            // park the task or put it into the waiting list.
+                            // Tasks occupied by other threads are queued
+                            // again, when these threads leave them.
+                            QueueTask(entry.pTask, threadNum);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return MFX_ERR_NOT_FOUND;
+
+} // mfxStatus mfxSchedulerCore::GetReadyTask(MFX_CALL_INFO &callInfo,
+
+void mfxSchedulerCore::PushReadyTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    const MFX_SCHEDULER_READY_TASK entry = {pTask, pTask->jobID};
+
+    if (MFX_TASK_DEDICATED & pTask->param.task.threadingPolicy)
+    {
+        GetThreadCtx(0)->readyTasks[pTask->param.task.priority][MFX_TYPE_HARDWARE].push_back(entry);
+    }
+    else
+    {
+        GetThreadCtx(threadNum)->readyTasks[pTask->param.task.priority][MFX_TYPE_SOFTWARE].push_back(entry);
+    }
+    pTask->param.queueState = MFX_QUEUE_READY;
+
+} // void mfxSchedulerCore::PushReadyTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum)
+
+void mfxSchedulerCore::QueueTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    // the task is queued already, or it is done, or it is not ready yet
+    if ((MFX_QUEUE_NONE != pTask->param.queueState) ||
+        (MFX_TASK_NEED_CONTINUE != pTask->curStatus) ||
+        (false == pTask->IsDependenciesResolved()))
+    {
+        return;
+    }
+
+    if (IsReadyToRun(pTask))
+    {
+        PushReadyTask(pTask, threadNum);
+    }
+    // threads inside the task queue it again on leaving
+    else if (pTask->param.occupancy)
+    {
+    }
+    // the task waits for a busy object, it is re-examined later
+    else if (pTask->param.bWaiting)
+    {
+        m_waitingTasks.push_back(pTask);
+        pTask->param.queueState = MFX_QUEUE_WAITING;
+    }
+    // the task waits for threads of other tasks of its thread assignment
+    else
+    {
+        MFX_THREAD_ASSIGNMENT &occupancyInfo = *(pTask->param.pThreadAssignment);
+
+        pTask->param.pNextParked = occupancyInfo.pParkedTasks;
+        occupancyInfo.pParkedTasks = pTask;
+        pTask->param.queueState = MFX_QUEUE_PARKED;
+    }
+
+} // void mfxSchedulerCore::QueueTask(MFX_SCHEDULER_TASK *pTask, const mfxU32 threadNum)
+
+void mfxSchedulerCore::UnparkTasks(MFX_THREAD_ASSIGNMENT &occupancyInfo, const mfxU32 threadNum)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    MFX_SCHEDULER_TASK *pTask = occupancyInfo.pParkedTasks;
+
+    // detach the list, tasks still waiting for threads are parked again
+    occupancyInfo.pParkedTasks = NULL;
+    m_resolvingThreadNum = threadNum;
+
+    while (pTask)
+    {
+        MFX_SCHEDULER_TASK *pNext = pTask->param.pNextParked;
+
+        pTask->param.pNextParked = NULL;
+        pTask->param.queueState = MFX_QUEUE_NONE;
+
+        // queue the task and wake up threads as if it just got
+        // its dependencies resolved
+        OnDependencyResolved(pTask);
+
+        pTask = pNext;
+    }
+
+} // void mfxSchedulerCore::UnparkTasks(MFX_THREAD_ASSIGNMENT &occupancyInfo, const mfxU32 threadNum)
+
+void mfxSchedulerCore::RequeueWaitingTasks(const mfxU32 threadNum)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    size_t i = 0;
+
+    while (i < m_waitingTasks.size())
+    {
+        MFX_SCHEDULER_TASK *pTask = m_waitingTasks[i];
+
+        if ((MFX_TASK_NEED_CONTINUE == pTask->curStatus) &&
+            (false == IsReadyToRun(pTask)))
+        {
+            i += 1;
+            continue;
+        }
+
+        // remove the task from the list, the order is not important
+        m_waitingTasks[i] = m_waitingTasks.back();
+        m_waitingTasks.pop_back();
+
+        pTask->param.queueState = MFX_QUEUE_NONE;
+        QueueTask(pTask, threadNum);
+    }
+
+} // void mfxSchedulerCore::RequeueWaitingTasks(const mfxU32 threadNum)
+
 // static section of the file
 namespace
 {
@@ -335,6 +561,13 @@ mfxStatus mfxSchedulerCore::WrapUpTask(MFX_CALL_INFO &callInfo,
     callInfo.threadNum = GetFreeThreadNumber(occupancyInfo, pTask);
     callInfo.callNum = pTask->param.numberOfCalls;
 
+    // update the time the task waited for the first call
+    if ((0 == pTask->param.numberOfCalls) &&
+        (m_currentTimeStamp > pTask->param.timing.timeReady))
+    {
+        UpdateTimeHistogram(m_stat.queueWaitTime, m_currentTimeStamp - pTask->param.timing.timeReady);
+    }
+
     // update the scheduler
     m_numAssignedTasks[pTask->param.task.priority] += 1;
 
@@ -389,6 +622,10 @@ void mfxSchedulerCore::ResetWaitingTasks(const void *pOwner)
 
 void mfxSchedulerCore::OnDependencyResolved(MFX_SCHEDULER_TASK *pTask)
 {
+    pTask->param.timing.timeReady = GetHighPerformanceCounter();
+    if (m_bWorkStealing) {
+        QueueTask(pTask, m_resolvingThreadNum);
+    }
     if (IsReadyToRun(pTask)) {
         if (MFX_TASK_DEDICATED & pTask->param.task.threadingPolicy) {
             m_DedicatedThreadsToWakeUp += pTask->param.task.entryPoint.requiredNumThreads;
@@ -401,9 +638,6 @@ void mfxSchedulerCore::OnDependencyResolved(MFX_SCHEDULER_TASK *pTask)
 void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                                          const mfxU32 threadNum)
 {
-    (void)pCallInfo;
-    (void)threadNum;
-
     MFX_SCHEDULER_TASK *pTask = nullptr;
     pTask = m_ppTaskLookUpTable.at(pCallInfo->taskHandle.taskID);
 
@@ -428,6 +662,9 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
         m_timeIdx = (m_timeIdx + 1) % MFX_TIME_STAT_PARTS;
         memset(m_workingTime + m_timeIdx, 0, sizeof(m_workingTime[m_timeIdx]));
         m_workingTime[m_timeIdx].startTime = curTime;
+
+        // export the scheduler's counters once per statistic part
+        TraceStatistics();
     }
     m_workingTime[m_timeIdx].time[pTask->param.task.priority] += pCallInfo->timeSpend;
 
@@ -452,6 +689,14 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
     m_DedicatedThreadsToWakeUp = 0;
     m_RegularThreadsToWakeUp = 0;
 
+    // the thread assignment got a free thread, let parked tasks run
+    if ((m_bWorkStealing) &&
+        (occupancyInfo.pParkedTasks) &&
+        (0 == (MFX_TASK_INTER & occupancyInfo.threadingPolicy)))
+    {
+        UnparkTasks(occupancyInfo, threadNum);
+    }
+
     // try to not overwrite the newest status from other thread
     if (pTask->param.timing.timeLastCallProcessed < pCallInfo->timeStamp)
     {
@@ -498,6 +743,9 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
         if ((isFailed(pTask->curStatus)) ||
             (MFX_TASK_DONE == pTask->curStatus))
         {
+            // update the overall time spent by the task
+            UpdateTimeHistogram(m_stat.runTime, pTask->param.timing.timeSpent);
+
             // store TaskId for tracing event
             nTraceTaskId = pCallInfo->pTask->nTaskId;
 
@@ -509,7 +757,7 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                 mfxStatus mfxRes;
 
                 // temporarily leave the protected code section
-                m_guard.unlock();
+                UnlockGuard();
 
                 mfxRes = pTask->CompleteTask(pTask->curStatus);
                 if ((isFailed(mfxRes)) &&
@@ -519,7 +767,7 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                 }
 
                 // enter the protected code section
-                m_guard.lock();
+                LockGuard();
             }
         }
 
@@ -574,7 +822,9 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                 }
             }
 
-            // mark all dependent task as 'ready'
+            // mark all dependent task as 'ready',
+            // ready tasks are queued to the current thread.
+            m_resolvingThreadNum = threadNum;
             pTask->ResolveDependencies(MFX_ERR_NONE);
             // release all allocated resources
             pTask->ReleaseResources();
@@ -585,6 +835,12 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
     }
 
 
+    // threads left the task, but it still has a job to do
+    if (m_bWorkStealing)
+    {
+        QueueTask(pTask, threadNum);
+    }
+
     // wake up additional threads for this task and tasks dependent
     if (m_DedicatedThreadsToWakeUp || m_RegularThreadsToWakeUp) {
         WakeUpThreads(m_DedicatedThreadsToWakeUp, m_RegularThreadsToWakeUp);
@@ -50,9 +50,10 @@ mfxStatus mfxSchedulerCore::StopWakeUpThread(void)
 
 void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
 {
-    std::unique_lock<std::mutex> guard(m_guard);
+    Guard guard(*this);
     mfxTaskHandle previousTaskHandle = {};
     const uint32_t threadNum = pContext->threadNum;
+    bool bWokenUp = false;
 
     {
         char thread_name[30] = {};
@@ -74,6 +75,7 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
         if (MFX_ERR_NONE == mfxRes)
         {
             pContext->state = MFX_SCHEDULER_THREAD_CONTEXT::Running;
+            bWokenUp = false;
             guard.unlock();
             {
                 // perform asynchronous operation
@@ -94,6 +96,11 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
         {
             mfxU64 start, stop;
 
+            // the thread was woken up, but there is nothing to do
+            if (bWokenUp)
+            {
+                pContext->numSpuriousWakeUps += 1;
+            }
 
             // mark beginning of sleep period
             start = GetHighPerformanceCounter();
@@ -104,6 +111,7 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
 
             // mark end of sleep period
             stop = GetHighPerformanceCounter();
+            bWokenUp = true;
 
             // update thread statistic
             pContext->sleepTime += (stop - start);
@@ -136,7 +144,7 @@ void mfxSchedulerCore::WakeupThreadProc()
             //MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_SCHED, "HW Event");
             IncrementHWEventCounter();
             {
-                std::lock_guard<std::mutex> guard(m_guard);
+                Guard guard(*this);
                 WakeUpThreads(1,1);
             }
         }
@@ -44,6 +44,14 @@ enum mfxSchedulerFlags
     MFX_SINGLE_THREAD = 1
 };
 
+enum mfxSchedulerQueueMode
+{
+    // all threads pick tasks from the shared task queues
+    MFX_SCHEDULER_QUEUE_SHARED = 0,
+    // ready tasks are kept in per-thread queues, idle threads steal work
+    MFX_SCHEDULER_QUEUE_WORK_STEALING = 1
+};
+
 enum mfxSchedulerMessage
 {
     // Drop any performance adjustments
@@ -127,6 +135,8 @@ struct MFX_SCHEDULER_PARAM2: public MFX_SCHEDULER_PARAM
 {
     // user-adjustable extended parameters
     mfxExtThreadsParam params;
+    // the way ready tasks are distributed among working threads
+    mfxSchedulerQueueMode queueMode;
 };
 
 class MFXIScheduler2 : public MFXIScheduler
@@ -884,6 +884,11 @@ mfxStatus _mfxSession_1_10::InitEx(mfxInitParam& par)
         if (par.NumExtParam) {
             schedParam.params = *((mfxExtThreadsParam*)par.ExtParam[0]);
         }
+#if defined(MFX_ENABLE_SCHEDULER_WORK_STEALING)
+        schedParam.queueMode = MFX_SCHEDULER_QUEUE_WORK_STEALING;
+#else
+        schedParam.queueMode = MFX_SCHEDULER_QUEUE_SHARED;
+#endif
         mfxRes = pScheduler2->Initialize2(&schedParam);
 
         m_pScheduler->Release();
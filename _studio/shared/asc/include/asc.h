@@ -105,6 +105,9 @@ typedef struct ASCextended_storage {
         frameOrder;
 }ASCVidRead;
 
+struct ASCcpu_task;
+struct ASCCpuPipeline;
+
 class ASC {
 public:
     ASC_API ASC();
@@ -149,6 +152,7 @@ private:
     ASCVidRead *m_support;
     ASCVidData *m_dataIn;
     ASCVidSample **m_videoData;
+    ASCCpuPipeline *m_cpuPipe;
     bool
         m_dataReady,
         m_cmDeviceAssigned,
@@ -188,11 +192,13 @@ private:
         pmfxU8 pSrc, mfxU32 srcWidth, mfxU32 srcHeight, mfxU32 srcPitch,
         pmfxU8 pDst, mfxU32 dstWidth, mfxU32 dstHeight, mfxU32 dstPitch,
         mfxI16 &avgLuma);
+    mfxStatus GainCorrectionCalc();
+    void RsCsCalcFrame(ASCimageData &data);
     mfxStatus RsCsCalc();
     mfxI32 ShotDetect(ASCimageData& Data, ASCimageData& DataRef, ASCImDetails& imageInfo, ASCTSCstat *current, ASCTSCstat *reference, mfxU8 controlLevel);
     void MotionAnalysis(ASCVidSample *videoIn, ASCVidSample *videoRef, mfxU32 *TSC, mfxU16 *AFD, mfxU32 *MVdiffVal, mfxU32 *AbsMVSize, mfxU32 *AbsMVHSize, mfxU32 *AbsMVVSize, ASCLayers lyrIdx);
 
-    typedef void(ASC::*t_resizeImg)(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ns_asc::ASCLayers dstIdx, mfxU32 parity);
+    typedef void(ASC::*t_resizeImg)(ASCVidSample *video, mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ns_asc::ASCLayers dstIdx, mfxU32 parity);
     t_resizeImg resizeFunc;
     mfxStatus VidSample_Alloc();
     void VidSample_dispose();
@@ -212,8 +218,8 @@ private:
     void InitStruct();
     mfxStatus VidRead_Init();
     void VidSample_Init();
-    void SubSampleASC_ImagePro(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity);
-    void SubSampleASC_ImageInt(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity);
+    void SubSampleASC_ImagePro(ASCVidSample *video, mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity);
+    void SubSampleASC_ImageInt(ASCVidSample *video, mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity);
     bool CompareStats(mfxU8 current, mfxU8 reference);
     bool FrameRepeatCheck();
     void DetectShotChangeFrame();
@@ -236,6 +242,11 @@ private:
     mfxStatus QueueFrame(SurfaceIndex *idxFrom, CmEvent **subSamplingEv, CmTask **subSamplingTask, CmThreadSpace *subThreadSpace, mfxU32 parity);
 #endif
     void AscFrameAnalysis();
+    mfxStatus CpuPipeline_Init();
+    void CpuPipeline_Close();
+    void CpuPipeline_RunTask(ASCcpu_task &task);
+    mfxStatus QueueFrame(mfxU8 *frame, mfxU32 parity);
+    mfxStatus ProcessQueuedCpuFrame();
     mfxStatus RunFrame(SurfaceIndex *idxFrom, mfxU32 parity);
     mfxStatus RunFrame(mfxHDL frameHDL, mfxU32 parity);
     mfxStatus RunFrame(mfxU8 *frame, mfxU32 parity);
@@ -273,6 +284,18 @@ public:
     ASC_API mfxStatus QueueFrameProgressive(SurfaceIndex* idxSurf);
     ASC_API mfxStatus QueueFrameInterlaced(SurfaceIndex* idxSurf);
 
+    // System memory frames: ProcessQueuedFrame() analyzes them in order.
+    // Other threads of the caller (e.g. the scheduler's ones) may subsample
+    // queued frames and compute their Rs/Cs ahead with PrepareQueuedFrame(),
+    // it returns false when no frame is left to prepare. Frames must stay
+    // valid until prepared, PrepareQueuedFrames() prepares all of them and
+    // waits for other threads. Only available without a CM device.
+    ASC_API mfxStatus QueueFrameProgressive(mfxU8 *frame, mfxI32 Pitch);
+    ASC_API mfxStatus QueueFrameInterlaced(mfxU8 *frame, mfxI32 Pitch);
+    ASC_API bool PrepareQueuedFrame();
+    ASC_API void PrepareQueuedFrames();
+    ASC_API mfxU32 Query_queued_frames();
+
     ASC_API bool Query_resize_Event();
     ASC_API mfxStatus ProcessQueuedFrame(CmEvent **subSamplingEv, CmTask **subSamplingTask, CmSurface2DUP **inputFrame, mfxU8 **pixelData);
     ASC_API mfxStatus ProcessQueuedFrame();
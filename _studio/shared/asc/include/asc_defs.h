@@ -51,6 +51,7 @@
 
 #define TSCSTATBUFFER     3
 #define ASCVIDEOSTATSBUF  2
+#define ASCCPUQUEUEDEPTH  4  // system memory frames in flight per ASC instance
 
 #define SCD_BLOCK_PIXEL_WIDTH   32
 #define SCD_BLOCK_HEIGHT        8
@@ -22,6 +22,48 @@
 
 #include "asc_structures.h"
 
+// Inputs of the scene change random forest, signed values are stored biased
+// by 0x80000000 so that every split is an unsigned compare
+enum ASCRFFeature {
+    RF_MVDiff = 0,
+    RF_RsCsDiff,
+    RF_Rs,
+    RF_gchDC,
+    RF_CsDiff,
+    RF_diffTSC,
+    RF_refDCval,
+    RF_TSC,
+    RF_diffRsCsdiff,
+    RF_posBalance,
+    RF_Cs,
+    RF_TSCindex,
+    RF_Scindex,
+    RF_AFD,
+    RF_SC,
+    RF_RsDiff,
+    RF_diffAFD,
+    RF_negBalance,
+    RF_ssDCval,
+    RF_diffMVdiffVal,
+    RF_Zero,            // always 0, used by leaves
+    RF_NUM_FEATURES
+};
+
+typedef mfxU32 ASCRFFeatures[RF_NUM_FEATURES];
+
+void SCDetectRF_Features(
+                 mfxI32 diffMVdiffVal, mfxU32 RsCsDiff,   mfxU32 MVDiff,   mfxU32 Rs,       mfxU32 AFD,
+                 mfxU32 CsDiff,        mfxI32 diffTSC,    mfxU32 TSC,      mfxU32 gchDC,    mfxI32 diffRsCsdiff,
+                 mfxU32 posBalance,    mfxU32 SC,         mfxU32 TSCindex, mfxU32 Scindex,  mfxU32 Cs,
+                 mfxI32 diffAFD,       mfxU32 negBalance, mfxU32 ssDCval,  mfxU32 refDCval, mfxU32 RsDiff,
+                 ASCRFFeatures features);
+
+// Number of trees voting for a scene change
+mfxU8 SCDetectRF_Votes(const ASCRFFeatures features);
+
+// Evaluates several frames at once, decisions[i] matches SCDetectRF() for features[i]
+void SCDetectRF_Batch(const ASCRFFeatures *features, mfxU32 count, mfxU8 control, bool *decisions);
+
 bool SCDetectRF( mfxI32 diffMVdiffVal, mfxU32 RsCsDiff,   mfxU32 MVDiff,   mfxU32 Rs,       mfxU32 AFD,
                  mfxU32 CsDiff,        mfxI32 diffTSC,    mfxU32 TSC,      mfxU32 gchDC,    mfxI32 diffRsCsdiff,
                  mfxU32 posBalance,    mfxU32 SC,         mfxU32 TSCindex, mfxU32 Scindex,  mfxU32 Cs,
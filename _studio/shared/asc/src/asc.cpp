@@ -32,6 +32,10 @@
 #include "../include/motion_estimation_engine.h"
 #include <limits.h>
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
 
 using std::min;
 using std::max;
@@ -54,6 +58,34 @@ static mfxI8
 static mfxU32 lmt_sc2[NumSC] = { 112, 255, 512, 1536, 4096, 6144, 10752, 16384, 23040, UINT_MAX };
 static mfxU32 lmt_tsc2[NumTSC] = { 24, 48, 72, 96, 128, 160, 192, 224, 256, UINT_MAX };
 
+typedef struct ASCcpu_task {
+    ASCVidSample
+        *video;
+    mfxU8
+        *frame;
+    mfxI32
+        pitch;
+    mfxU32
+        parity;
+    bool
+        started,
+        done;
+} ASCCpuTask;
+
+// State of the system memory pipeline: threads calling PrepareQueuedFrame()
+// subsample frames and compute their Rs/Cs, the ProcessQueuedFrame() caller
+// does it for frames nobody took and runs the analysis in order.
+struct ASCCpuPipeline {
+    std::mutex
+        mtx;
+    std::condition_variable
+        ready;
+    std::deque<ASCCpuTask>
+        tasks;                      // frame order, front is analyzed next
+    std::vector<ASCVidSample *>
+        free;                       // staging samples not referenced by tasks or m_videoData
+};
+
 ASC_API ASCimageData::ASCimageData() {
     Image.data = nullptr;
     Image.Y = nullptr;
@@ -206,6 +238,7 @@ ASC_API ASC::ASC()
     m_support  = nullptr;
     m_dataIn   = nullptr;
     m_videoData = nullptr;
+    m_cpuPipe  = nullptr;
     
     m_dataReady = false;
     m_cmDeviceAssigned = false;
@@ -755,6 +788,13 @@ ASC_API mfxStatus ASC::Init(mfxI32 Width, mfxI32 Height, mfxI32 Pitch, mfxU32 Pi
         (PicStruct & MFX_PICSTRUCT_FIELD_BFF) ? ASCbotfieldFirst_frame :
         ASCprogressive_frame);
     SCD_CHECK_MFX_ERR(sts);
+
+    // created ahead, so that other threads may call PrepareQueuedFrame()
+    // at any time after Init()
+    if (!Query_ASCCmDevice()) {
+        sts = CpuPipeline_Init();
+        SCD_CHECK_MFX_ERR(sts);
+    }
     m_dataReady = false;
     m_ASCinitialized = (sts == MFX_ERR_NONE);
     return sts;
@@ -796,6 +836,8 @@ ASC_API void ASC::ResetGoPSize() {
 }
 
 ASC_API void ASC::Close() {
+    CpuPipeline_Close();
+
     if(m_videoData != nullptr) {
         VidSample_dispose();
         delete[] m_videoData;
@@ -845,11 +887,11 @@ ASC_API void ASC::Close() {
     m_threadSpaceCp = nullptr;
 }
 
-void ASC::SubSampleASC_ImagePro(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 /*parity*/) {
+void ASC::SubSampleASC_ImagePro(ASCVidSample *video, mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 /*parity*/) {
 
     ASCImDetails *pIDetDst = &m_dataIn->layer[dstIdx];
-    mfxU8 *pDst = m_videoData[ASCCurrent_Frame]->layer.Image.Y;
-    mfxI16& avgLuma = m_videoData[ASCCurrent_Frame]->layer.avgval;
+    mfxU8 *pDst = video->layer.Image.Y;
+    mfxI16& avgLuma = video->layer.avgval;
 
     mfxI32 dstWidth = pIDetDst->Original_Width;
     mfxI32 dstHeight = pIDetDst->Original_Height;
@@ -858,11 +900,11 @@ void ASC::SubSampleASC_ImagePro(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight,
     SubSample_Point(frame, srcWidth, srcHeight, inputPitch, pDst, dstWidth, dstHeight, dstPitch, avgLuma);
 }
 
-void ASC::SubSampleASC_ImageInt(mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity) {
+void ASC::SubSampleASC_ImageInt(ASCVidSample *video, mfxU8 *frame, mfxI32 srcWidth, mfxI32 srcHeight, mfxI32 inputPitch, ASCLayers dstIdx, mfxU32 parity) {
 
     ASCImDetails *pIDetDst = &m_dataIn->layer[dstIdx];
-    mfxU8 *pDst = m_videoData[ASCCurrent_Frame]->layer.Image.Y;
-    mfxI16 &avgLuma = m_videoData[ASCCurrent_Frame]->layer.avgval;
+    mfxU8 *pDst = video->layer.Image.Y;
+    mfxI16 &avgLuma = video->layer.avgval;
 
     mfxI32 dstWidth = pIDetDst->Original_Width;
     mfxI32 dstHeight = pIDetDst->Original_Height;
@@ -902,29 +944,35 @@ void ASC::SubSample_Point(
     avgLuma = (mfxI16)(sumAll >> 13);
 }
 
-mfxStatus ASC::RsCsCalc() {
-    ASCYUV
-         *pFrame = &m_videoData[ASCCurrent_Frame]->layer.Image;
+mfxStatus ASC::GainCorrectionCalc() {
     ASCImDetails
         vidCar = m_dataIn->layer[0];
     pmfxU8
-        ss = pFrame->Y;
-    mfxU32
-        hblocks = (pFrame->height >> BLOCK_SIZE_SHIFT) /*- 2*/,
-        wblocks = (pFrame->width >> BLOCK_SIZE_SHIFT) /*- 2*/;
-
+        ss = m_videoData[ASCReference_Frame]->layer.Image.Y;
     mfxI16
         diff = m_videoData[ASCReference_Frame]->layer.avgval - m_videoData[ASCCurrent_Frame]->layer.avgval;
-    ss = m_videoData[ASCReference_Frame]->layer.Image.Y;
     if (!m_support->firstFrame && abs(diff) >= GAINDIFF_THR) {
         if (m_support->gainCorrection.Image.Y == nullptr)
             return MFX_ERR_MEMORY_ALLOC;
         GainOffset(&ss, &m_support->gainCorrection.Image.Y, (mfxU16)vidCar._cwidth, (mfxU16)vidCar._cheight, (mfxU16)vidCar.Extended_Width, diff);
     }
-    ss = m_videoData[ASCCurrent_Frame]->layer.Image.Y;
+    return MFX_ERR_NONE;
+}
+
+// Rs/Cs of a single subsampled frame, does not depend on the reference
+void ASC::RsCsCalcFrame(ASCimageData &data) {
+    mfxU32
+        hblocks = (data.Image.height >> BLOCK_SIZE_SHIFT) /*- 2*/,
+        wblocks = (data.Image.width >> BLOCK_SIZE_SHIFT) /*- 2*/;
+
+    RsCsCalc_4x4(data.Image.Y, data.Image.pitch, wblocks, hblocks, data.Rs, data.Cs);
+    RsCsCalc_bound(data.Rs, data.Cs, data.RsCs, &data.RsVal, &data.CsVal, wblocks, hblocks);
+}
 
-    RsCsCalc_4x4(ss, pFrame->pitch, wblocks, hblocks, m_videoData[ASCCurrent_Frame]->layer.Rs, m_videoData[ASCCurrent_Frame]->layer.Cs);
-    RsCsCalc_bound(m_videoData[ASCCurrent_Frame]->layer.Rs, m_videoData[ASCCurrent_Frame]->layer.Cs, m_videoData[ASCCurrent_Frame]->layer.RsCs, &m_videoData[ASCCurrent_Frame]->layer.RsVal, &m_videoData[ASCCurrent_Frame]->layer.CsVal, wblocks, hblocks);
+mfxStatus ASC::RsCsCalc() {
+    mfxStatus sts = GainCorrectionCalc();
+    SCD_CHECK_MFX_ERR(sts);
+    RsCsCalcFrame(m_videoData[ASCCurrent_Frame]->layer);
     return MFX_ERR_NONE;
 }
 
@@ -1388,9 +1436,163 @@ ASC_API mfxStatus ASC::ProcessQueuedFrame(CmEvent **subSamplingEv, CmTask **subS
 
 ASC_API mfxStatus ASC::ProcessQueuedFrame()
 {
+    if (m_cpuPipe && !m_cpuPipe->tasks.empty())
+        return ProcessQueuedCpuFrame();
     return ProcessQueuedFrame(&m_subSamplingEv, &m_task, nullptr, nullptr);
 }
 
+mfxStatus ASC::CpuPipeline_Init() {
+    if (m_cpuPipe)
+        return MFX_ERR_NONE;
+    mfxStatus sts = MFX_ERR_NONE;
+    try
+    {
+        m_cpuPipe = new ASCCpuPipeline;
+        for (mfxI32 i = 0; i < ASCCPUQUEUEDEPTH && sts == MFX_ERR_NONE; i++) {
+            ASCVidSample *video = new ASCVidSample;
+            m_cpuPipe->free.push_back(video);
+            nullifier(&video->layer);
+            video->layer.gpuImage = nullptr;
+            video->layer.idxImage = nullptr;
+            video->frame_number = -1;
+            video->forward_reference = -1;
+            video->backward_reference = -1;
+            sts = video->layer.InitFrame(m_dataIn->layer);
+        }
+    }
+    catch (...)
+    {
+        sts = MFX_ERR_MEMORY_ALLOC;
+    }
+    if (sts != MFX_ERR_NONE)
+        CpuPipeline_Close();
+    return sts;
+}
+
+void ASC::CpuPipeline_Close() {
+    if (!m_cpuPipe)
+        return;
+    {
+        // frames being prepared by other threads still use their samples
+        std::unique_lock<std::mutex> lock(m_cpuPipe->mtx);
+        m_cpuPipe->ready.wait(lock, [this] {
+            return std::none_of(m_cpuPipe->tasks.begin(), m_cpuPipe->tasks.end(),
+                [](const ASCCpuTask &task) { return task.started && !task.done; });
+        });
+    }
+
+    // samples swapped into m_videoData are released by VidSample_dispose()
+    for (auto& task : m_cpuPipe->tasks)
+        m_cpuPipe->free.push_back(task.video);
+    for (auto video : m_cpuPipe->free) {
+        video->layer.Close();
+        delete video;
+    }
+    delete m_cpuPipe;
+    m_cpuPipe = nullptr;
+}
+
+void ASC::CpuPipeline_RunTask(ASCCpuTask &task) {
+    (this->*(resizeFunc))(task.video, task.frame, m_width, m_height, task.pitch, (ASCLayers)0, task.parity);
+    RsCsCalcFrame(task.video->layer);
+}
+
+ASC_API bool ASC::PrepareQueuedFrame() {
+    if (!m_cpuPipe)
+        return false;
+    std::unique_lock<std::mutex> lock(m_cpuPipe->mtx);
+    auto it = std::find_if(m_cpuPipe->tasks.begin(), m_cpuPipe->tasks.end(),
+        [](const ASCCpuTask &t) { return !t.started; });
+    if (it == m_cpuPipe->tasks.end())
+        return false;
+    ASCCpuTask &task = *it;
+    task.started = true;
+    lock.unlock();
+
+    // the task stays in the queue till it is done, queueing more frames
+    // doesn't move it
+    CpuPipeline_RunTask(task);
+
+    lock.lock();
+    task.done = true;
+    m_cpuPipe->ready.notify_all();
+    return true;
+}
+
+ASC_API void ASC::PrepareQueuedFrames() {
+    if (!m_cpuPipe)
+        return;
+    while (PrepareQueuedFrame())
+        ;
+    std::unique_lock<std::mutex> lock(m_cpuPipe->mtx);
+    m_cpuPipe->ready.wait(lock, [this] {
+        return std::all_of(m_cpuPipe->tasks.begin(), m_cpuPipe->tasks.end(),
+            [](const ASCCpuTask &task) { return task.done; });
+    });
+}
+
+mfxStatus ASC::QueueFrame(mfxU8 *frame, mfxU32 parity) {
+    if (!m_ASCinitialized)
+        return MFX_ERR_NOT_INITIALIZED;
+    if (Query_ASCCmDevice())
+        return MFX_ERR_UNDEFINED_BEHAVIOR;
+    if (frame == nullptr)
+        return MFX_ERR_NULL_PTR;
+    MFX_SAFE_CALL(CpuPipeline_Init());
+    if (m_cpuPipe->free.empty())
+        return MFX_WRN_DEVICE_BUSY;
+
+    ASCCpuTask task = {};
+    task.video  = m_cpuPipe->free.back();
+    task.frame  = frame;
+    task.pitch  = m_pitch;
+    task.parity = parity;
+    m_cpuPipe->free.pop_back();
+    {
+        std::unique_lock<std::mutex> lock(m_cpuPipe->mtx);
+        m_cpuPipe->tasks.push_back(task);
+    }
+    return MFX_ERR_NONE;
+}
+
+mfxStatus ASC::ProcessQueuedCpuFrame() {
+    if (!m_ASCinitialized)
+        return MFX_ERR_NOT_INITIALIZED;
+    if (!m_cpuPipe || m_cpuPipe->tasks.empty())
+        return MFX_ERR_MORE_DATA;
+
+    ASCVidSample *video = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(m_cpuPipe->mtx);
+        ASCCpuTask &task = m_cpuPipe->tasks.front();
+        if (!task.started) {
+            task.started = true;
+            lock.unlock();
+            CpuPipeline_RunTask(task);
+            lock.lock();
+            task.done = true;
+        }
+        else {
+            m_cpuPipe->ready.wait(lock, [&task] { return task.done; });
+        }
+        video = task.video;
+        m_cpuPipe->tasks.pop_front();
+    }
+
+    // staged sample becomes the current frame, the replaced one is recycled
+    std::swap(video, m_videoData[ASCCurrent_Frame]);
+    m_cpuPipe->free.push_back(video);
+
+    m_videoData[ASCCurrent_Frame]->frame_number = m_videoData[ASCReference_Frame]->frame_number + 1;
+    mfxStatus sts = GainCorrectionCalc();
+    m_dataReady = (sts == MFX_ERR_NONE);
+    SCD_CHECK_MFX_ERR(sts);
+    DetectShotChangeFrame();
+    Put_LTR_Hint();
+    GeneralBufferRotation();
+    return MFX_ERR_NONE;
+}
+
 mfxStatus ASC::RunFrame(SurfaceIndex *idxFrom, mfxU32 parity) {
     if (!m_ASCinitialized)
         return MFX_ERR_NOT_INITIALIZED;
@@ -1487,7 +1689,7 @@ mfxStatus ASC::RunFrame(mfxU8 *frame, mfxU32 parity) {
     if (!m_ASCinitialized)
         return MFX_ERR_NOT_INITIALIZED;
     m_videoData[ASCCurrent_Frame]->frame_number = m_videoData[ASCReference_Frame]->frame_number + 1;
-    (this->*(resizeFunc))(frame, m_width, m_height, m_pitch, (ASCLayers)0, parity);
+    (this->*(resizeFunc))(m_videoData[ASCCurrent_Frame], frame, m_width, m_height, m_pitch, (ASCLayers)0, parity);
     RsCsCalc();
     DetectShotChangeFrame();
     Put_LTR_Hint();
@@ -1546,6 +1748,34 @@ ASC_API mfxStatus ASC::PutFrameProgressive(mfxU8 *frame, mfxI32 Pitch) {
     return sts;
 }
 
+ASC_API mfxStatus ASC::QueueFrameProgressive(mfxU8 *frame, mfxI32 Pitch) {
+    mfxStatus sts;
+    if (Pitch > 0) {
+        sts = SetPitch(Pitch);
+        SCD_CHECK_MFX_ERR(sts);
+    }
+
+    sts = QueueFrame(frame, ASCTopField);
+    return sts;
+}
+
+ASC_API mfxStatus ASC::QueueFrameInterlaced(mfxU8 *frame, mfxI32 Pitch) {
+    mfxStatus sts;
+    if (Pitch > 0) {
+        sts = SetPitch(Pitch);
+        SCD_CHECK_MFX_ERR(sts);
+    }
+
+    sts = QueueFrame(frame, m_dataIn->currentField);
+    if (sts == MFX_ERR_NONE)
+        SetNextField();
+    return sts;
+}
+
+ASC_API mfxU32 ASC::Query_queued_frames() {
+    return m_cpuPipe ? (mfxU32)m_cpuPipe->tasks.size() : 0;
+}
+
 ASC_API mfxStatus ASC::PutFrameInterlaced(mfxU8 *frame, mfxI32 Pitch) {
     mfxStatus sts;
 
@@ -25,6 +25,12 @@
 #include "mfx_trace.h"
 #include "mfxdefs.h"
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "umc_mutex.h"
 
 enum
@@ -34,175 +40,508 @@ enum
     COPY_VIDEO_TO_SYS = 2,
 };
 
+enum
+{
+    // planes of at least this size are copied with streaming stores and
+    // split into bands of rows copied by several threads
+    FAST_COPY_LARGE_PLANE   = 4 * 1024 * 1024,
+    FAST_COPY_MAX_BANDS     = 4,
+    FAST_COPY_MIN_BAND_ROWS = 64,
+};
+
+enum FastCopyIsa
+{
+    FAST_COPY_SSE4   = 0,
+    FAST_COPY_AVX2   = 1,
+    FAST_COPY_AVX512 = 2,
+};
+
 #include <immintrin.h>
-inline void copyVideoToSys(const mfxU8* src, mfxU8* dst, int width)
+
+// AVX2 and AVX-512 kernels are built regardless of the compiler flags and
+// picked at run time
+#define FAST_COPY_TARGET_AVX2   __attribute__((target("avx2")))
+#define FAST_COPY_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+
+// Row kernels. Video memory is uncached, so it is read with streaming loads.
+// Aligned streaming stores are used on request when source and destination
+// have the same alignment; wider variants handle unaligned head and the tail
+// with narrower ones.
+
+template <bool stream>
+inline void storeRow(__m128i* dst, __m128i val)
+{
+    if (stream)
+        _mm_stream_si128(dst, val);
+    else
+        _mm_storeu_si128(dst, val);
+}
+
+template <bool stream>
+inline void copyVideoToSys_SSE4(const mfxU8* src, mfxU8* dst, int width)
 {
     static const int item_size = 4*sizeof(__m128i);
 
-    int align16 = (0x10 - (reinterpret_cast<size_t>(src) & 0xf)) & 0xf;
+    int align16 = std::min<int>((0x10 - (reinterpret_cast<size_t>(src) & 0xf)) & 0xf, width);
     for (int i = 0; i < align16; i++)
         *dst++ = *src++;
 
     int w = width - align16;
-    if (w < 0)
-        return;
-
-    int width4 = w & (-item_size);
 
     __m128i * src_reg = (__m128i *)src;
     __m128i * dst_reg = (__m128i *)dst;
 
-    int i = 0;
-    for (; i < width4; i += item_size)
+    for (; w >= item_size; w -= item_size)
     {
         __m128i xmm0 = _mm_stream_load_si128(src_reg);
         __m128i xmm1 = _mm_stream_load_si128(src_reg+1);
         __m128i xmm2 = _mm_stream_load_si128(src_reg+2);
         __m128i xmm3 = _mm_stream_load_si128(src_reg+3);
-        _mm_storeu_si128(dst_reg, xmm0);
-        _mm_storeu_si128(dst_reg+1, xmm1);
-        _mm_storeu_si128(dst_reg+2, xmm2);
-        _mm_storeu_si128(dst_reg+3, xmm3);
+        storeRow<stream>(dst_reg, xmm0);
+        storeRow<stream>(dst_reg+1, xmm1);
+        storeRow<stream>(dst_reg+2, xmm2);
+        storeRow<stream>(dst_reg+3, xmm3);
 
         src_reg += 4;
         dst_reg += 4;
     }
 
-    size_t tail_data_sz = w & (item_size - 1);
-    if (tail_data_sz)
+    for (; w >= (int)sizeof(__m128i); w -= sizeof(__m128i))
     {
-        for (; tail_data_sz >= sizeof(__m128i); tail_data_sz -= sizeof(__m128i))
-        {
-            __m128i xmm0 = _mm_stream_load_si128(src_reg);
-            _mm_storeu_si128(dst_reg, xmm0);
-            src_reg += 1;
-            dst_reg += 1;
-        }
+        __m128i xmm0 = _mm_stream_load_si128(src_reg);
+        storeRow<stream>(dst_reg, xmm0);
+        src_reg += 1;
+        dst_reg += 1;
+    }
 
-        src = (const mfxU8 *)src_reg;
-        dst = (mfxU8 *)dst_reg;
+    src = (const mfxU8 *)src_reg;
+    dst = (mfxU8 *)dst_reg;
 
-        for (; tail_data_sz > 0; tail_data_sz--)
-            *dst++ = *src++;
-    }
+    for (; w > 0; w--)
+        *dst++ = *src++;
 }
 
-inline void copyVideoToSysShift(const mfxU16* src, mfxU16* dst, int width, int shift)
+template <bool stream>
+inline void copyVideoToSysShift_SSE4(const mfxU16* src, mfxU16* dst, int width, int shift)
 {
-    static const int item_size = 4 * sizeof(__m128i);
+    static const int item_size = 4 * sizeof(__m128i) / sizeof(mfxU16);
 
-    int align16 = (0x10 - (reinterpret_cast<size_t>((mfxU8*)src) & 0xf)) & 0xf;
-    for (int i = 0; i < align16/2; i++)
-        *dst++ = (*src++)>>shift;
-
-    int w = width*2 - align16;
-    if (w < 0)
-        return;
+    int align16 = std::min<int>(((0x10 - (reinterpret_cast<size_t>(src) & 0xf)) & 0xf) / 2, width);
+    for (int i = 0; i < align16; i++)
+        *dst++ = (*src++) >> shift;
 
-    int width4 = w & (-item_size);
+    int w = width - align16;
 
     __m128i * src_reg = (__m128i *)src;
     __m128i * dst_reg = (__m128i *)dst;
 
-    int i = 0;
-    for (; i < width4; i += item_size)
+    for (; w >= item_size; w -= item_size)
     {
         __m128i xmm0 = _mm_stream_load_si128(src_reg);
         __m128i xmm1 = _mm_stream_load_si128(src_reg + 1);
         __m128i xmm2 = _mm_stream_load_si128(src_reg + 2);
         __m128i xmm3 = _mm_stream_load_si128(src_reg + 3);
-        __m128i xmm4 = _mm_srli_epi16(xmm0, shift);
-        __m128i xmm5 = _mm_srli_epi16(xmm1, shift);
-        __m128i xmm6 = _mm_srli_epi16(xmm2, shift);
-        __m128i xmm7 = _mm_srli_epi16(xmm3, shift);
-        _mm_storeu_si128(dst_reg, xmm4);
-        _mm_storeu_si128(dst_reg + 1, xmm5);
-        _mm_storeu_si128(dst_reg + 2, xmm6);
-        _mm_storeu_si128(dst_reg + 3, xmm7);
+        storeRow<stream>(dst_reg,     _mm_srli_epi16(xmm0, shift));
+        storeRow<stream>(dst_reg + 1, _mm_srli_epi16(xmm1, shift));
+        storeRow<stream>(dst_reg + 2, _mm_srli_epi16(xmm2, shift));
+        storeRow<stream>(dst_reg + 3, _mm_srli_epi16(xmm3, shift));
 
         src_reg += 4;
         dst_reg += 4;
     }
 
-    size_t tail_data_sz = w & (item_size - 1);
-    if (tail_data_sz)
+    for (; w >= (int)(sizeof(__m128i) / sizeof(mfxU16)); w -= sizeof(__m128i) / sizeof(mfxU16))
     {
-        for (; tail_data_sz >= sizeof(__m128i); tail_data_sz -= sizeof(__m128i))
-        {
-            __m128i xmm0 = _mm_stream_load_si128(src_reg);
-            __m128i xmm1 = _mm_srli_epi16(xmm0, shift);
-            _mm_storeu_si128(dst_reg, xmm1);
-            src_reg += 1;
-            dst_reg += 1;
-        }
+        __m128i xmm0 = _mm_stream_load_si128(src_reg);
+        storeRow<stream>(dst_reg, _mm_srli_epi16(xmm0, shift));
+        src_reg += 1;
+        dst_reg += 1;
+    }
 
-        src = (const mfxU16 *)src_reg;
-        dst = (mfxU16 *)dst_reg;
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
 
-        for (; tail_data_sz > 0; tail_data_sz--)
-            *dst++ = (*src++)>>shift;
-    }
+    for (; w > 0; w--)
+        *dst++ = (*src++) >> shift;
 }
 
-inline void copySysToVideoShift(const mfxU16* src, mfxU16* dst, int width, int shift)
+template <bool stream>
+inline void copySysToVideoShift_SSE4(const mfxU16* src, mfxU16* dst, int width, int shift)
 {
-    static const int item_size = 4 * sizeof(__m128i);
+    static const int item_size = 4 * sizeof(__m128i) / sizeof(mfxU16);
 
-    int align16 = (0x10 - (reinterpret_cast<size_t>((mfxU8*)src) & 0xf)) & 0xf;
+    int align16 = std::min<int>(((0x10 - (reinterpret_cast<size_t>(src) & 0xf)) & 0xf) / 2, width);
     for (int i = 0; i < align16; i++)
-        *dst++ = (*src++)<< shift;
+        *dst++ = (*src++) << shift;
 
-    int w = width*2 - align16;
-    if (w < 0)
-        return;
-
-    int width4 = w & (-item_size);
+    int w = width - align16;
 
     __m128i * src_reg = (__m128i *)src;
     __m128i * dst_reg = (__m128i *)dst;
 
-    int i = 0;
-    for (; i < width4; i += item_size)
+    for (; w >= item_size; w -= item_size)
     {
         __m128i xmm0 = _mm_load_si128(src_reg);
         __m128i xmm1 = _mm_load_si128(src_reg + 1);
         __m128i xmm2 = _mm_load_si128(src_reg + 2);
         __m128i xmm3 = _mm_load_si128(src_reg + 3);
-        __m128i xmm4 = _mm_slli_epi32(xmm0, shift);
-        __m128i xmm5 = _mm_slli_epi32(xmm1, shift);
-        __m128i xmm6 = _mm_slli_epi32(xmm2, shift);
-        __m128i xmm7 = _mm_slli_epi32(xmm3, shift);
-        _mm_storeu_si128(dst_reg, xmm4);
-        _mm_storeu_si128(dst_reg + 1, xmm5);
-        _mm_storeu_si128(dst_reg + 2, xmm6);
-        _mm_storeu_si128(dst_reg + 3, xmm7);
+        storeRow<stream>(dst_reg,     _mm_slli_epi16(xmm0, shift));
+        storeRow<stream>(dst_reg + 1, _mm_slli_epi16(xmm1, shift));
+        storeRow<stream>(dst_reg + 2, _mm_slli_epi16(xmm2, shift));
+        storeRow<stream>(dst_reg + 3, _mm_slli_epi16(xmm3, shift));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    for (; w >= (int)(sizeof(__m128i) / sizeof(mfxU16)); w -= sizeof(__m128i) / sizeof(mfxU16))
+    {
+        __m128i xmm0 = _mm_load_si128(src_reg);
+        storeRow<stream>(dst_reg, _mm_slli_epi16(xmm0, shift));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
+
+    for (; w > 0; w--)
+        *dst++ = (*src++) << shift;
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX2 inline void storeRow(__m256i* dst, __m256i val)
+{
+    if (stream)
+        _mm256_stream_si256(dst, val);
+    else
+        _mm256_storeu_si256(dst, val);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX2 inline void copyVideoToSys_AVX2(const mfxU8* src, mfxU8* dst, int width)
+{
+    static const int item_size = 4 * sizeof(__m256i);
+
+    int align32 = (0x20 - (reinterpret_cast<size_t>(src) & 0x1f)) & 0x1f;
+    if (width < align32 + item_size)
+        return copyVideoToSys_SSE4<stream>(src, dst, width);
+
+    copyVideoToSys_SSE4<stream>(src, dst, align32);
+    src += align32;
+    dst += align32;
+
+    int w = width - align32;
+
+    __m256i * src_reg = (__m256i *)src;
+    __m256i * dst_reg = (__m256i *)dst;
+
+    for (; w >= item_size; w -= item_size)
+    {
+        __m256i ymm0 = _mm256_stream_load_si256(src_reg);
+        __m256i ymm1 = _mm256_stream_load_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_stream_load_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_stream_load_si256(src_reg + 3);
+        storeRow<stream>(dst_reg,     ymm0);
+        storeRow<stream>(dst_reg + 1, ymm1);
+        storeRow<stream>(dst_reg + 2, ymm2);
+        storeRow<stream>(dst_reg + 3, ymm3);
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    copyVideoToSys_SSE4<stream>((const mfxU8 *)src_reg, (mfxU8 *)dst_reg, w);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX2 inline void copyVideoToSysShift_AVX2(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m256i) / sizeof(mfxU16);
+
+    int align32 = ((0x20 - (reinterpret_cast<size_t>(src) & 0x1f)) & 0x1f) / 2;
+    if (width < align32 + item_size)
+        return copyVideoToSysShift_SSE4<stream>(src, dst, width, shift);
+
+    copyVideoToSysShift_SSE4<stream>(src, dst, align32, shift);
+    src += align32;
+    dst += align32;
+
+    int w = width - align32;
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    __m256i * src_reg = (__m256i *)src;
+    __m256i * dst_reg = (__m256i *)dst;
+
+    for (; w >= item_size; w -= item_size)
+    {
+        __m256i ymm0 = _mm256_stream_load_si256(src_reg);
+        __m256i ymm1 = _mm256_stream_load_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_stream_load_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_stream_load_si256(src_reg + 3);
+        storeRow<stream>(dst_reg,     _mm256_srl_epi16(ymm0, count));
+        storeRow<stream>(dst_reg + 1, _mm256_srl_epi16(ymm1, count));
+        storeRow<stream>(dst_reg + 2, _mm256_srl_epi16(ymm2, count));
+        storeRow<stream>(dst_reg + 3, _mm256_srl_epi16(ymm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    copyVideoToSysShift_SSE4<stream>((const mfxU16 *)src_reg, (mfxU16 *)dst_reg, w, shift);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX2 inline void copySysToVideoShift_AVX2(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m256i) / sizeof(mfxU16);
+
+    int align32 = ((0x20 - (reinterpret_cast<size_t>(src) & 0x1f)) & 0x1f) / 2;
+    if (width < align32 + item_size)
+        return copySysToVideoShift_SSE4<stream>(src, dst, width, shift);
+
+    copySysToVideoShift_SSE4<stream>(src, dst, align32, shift);
+    src += align32;
+    dst += align32;
+
+    int w = width - align32;
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    __m256i * src_reg = (__m256i *)src;
+    __m256i * dst_reg = (__m256i *)dst;
+
+    for (; w >= item_size; w -= item_size)
+    {
+        __m256i ymm0 = _mm256_load_si256(src_reg);
+        __m256i ymm1 = _mm256_load_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_load_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_load_si256(src_reg + 3);
+        storeRow<stream>(dst_reg,     _mm256_sll_epi16(ymm0, count));
+        storeRow<stream>(dst_reg + 1, _mm256_sll_epi16(ymm1, count));
+        storeRow<stream>(dst_reg + 2, _mm256_sll_epi16(ymm2, count));
+        storeRow<stream>(dst_reg + 3, _mm256_sll_epi16(ymm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    copySysToVideoShift_SSE4<stream>((const mfxU16 *)src_reg, (mfxU16 *)dst_reg, w, shift);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX512 inline void storeRow(__m512i* dst, __m512i val)
+{
+    if (stream)
+        _mm512_stream_si512(dst, val);
+    else
+        _mm512_storeu_si512(dst, val);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX512 inline void copyVideoToSys_AVX512(const mfxU8* src, mfxU8* dst, int width)
+{
+    static const int item_size = 4 * sizeof(__m512i);
+
+    int align64 = (0x40 - (reinterpret_cast<size_t>(src) & 0x3f)) & 0x3f;
+    if (width < align64 + item_size)
+        return copyVideoToSys_AVX2<stream>(src, dst, width);
+
+    copyVideoToSys_AVX2<stream>(src, dst, align64);
+    src += align64;
+    dst += align64;
+
+    int w = width - align64;
+
+    __m512i * src_reg = (__m512i *)src;
+    __m512i * dst_reg = (__m512i *)dst;
+
+    for (; w >= item_size; w -= item_size)
+    {
+        __m512i zmm0 = _mm512_stream_load_si512((void *)(src_reg));
+        __m512i zmm1 = _mm512_stream_load_si512((void *)(src_reg + 1));
+        __m512i zmm2 = _mm512_stream_load_si512((void *)(src_reg + 2));
+        __m512i zmm3 = _mm512_stream_load_si512((void *)(src_reg + 3));
+        storeRow<stream>(dst_reg,     zmm0);
+        storeRow<stream>(dst_reg + 1, zmm1);
+        storeRow<stream>(dst_reg + 2, zmm2);
+        storeRow<stream>(dst_reg + 3, zmm3);
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    copyVideoToSys_AVX2<stream>((const mfxU8 *)src_reg, (mfxU8 *)dst_reg, w);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX512 inline void copyVideoToSysShift_AVX512(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m512i) / sizeof(mfxU16);
+
+    int align64 = ((0x40 - (reinterpret_cast<size_t>(src) & 0x3f)) & 0x3f) / 2;
+    if (width < align64 + item_size)
+        return copyVideoToSysShift_AVX2<stream>(src, dst, width, shift);
+
+    copyVideoToSysShift_AVX2<stream>(src, dst, align64, shift);
+    src += align64;
+    dst += align64;
+
+    int w = width - align64;
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    __m512i * src_reg = (__m512i *)src;
+    __m512i * dst_reg = (__m512i *)dst;
+
+    for (; w >= item_size; w -= item_size)
+    {
+        __m512i zmm0 = _mm512_stream_load_si512((void *)(src_reg));
+        __m512i zmm1 = _mm512_stream_load_si512((void *)(src_reg + 1));
+        __m512i zmm2 = _mm512_stream_load_si512((void *)(src_reg + 2));
+        __m512i zmm3 = _mm512_stream_load_si512((void *)(src_reg + 3));
+        storeRow<stream>(dst_reg,     _mm512_srl_epi16(zmm0, count));
+        storeRow<stream>(dst_reg + 1, _mm512_srl_epi16(zmm1, count));
+        storeRow<stream>(dst_reg + 2, _mm512_srl_epi16(zmm2, count));
+        storeRow<stream>(dst_reg + 3, _mm512_srl_epi16(zmm3, count));
 
         src_reg += 4;
         dst_reg += 4;
     }
 
-    size_t tail_data_sz = w & (item_size - 1);
-    if (tail_data_sz)
+    copyVideoToSysShift_AVX2<stream>((const mfxU16 *)src_reg, (mfxU16 *)dst_reg, w, shift);
+}
+
+template <bool stream>
+FAST_COPY_TARGET_AVX512 inline void copySysToVideoShift_AVX512(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m512i) / sizeof(mfxU16);
+
+    int align64 = ((0x40 - (reinterpret_cast<size_t>(src) & 0x3f)) & 0x3f) / 2;
+    if (width < align64 + item_size)
+        return copySysToVideoShift_AVX2<stream>(src, dst, width, shift);
+
+    copySysToVideoShift_AVX2<stream>(src, dst, align64, shift);
+    src += align64;
+    dst += align64;
+
+    int w = width - align64;
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    __m512i * src_reg = (__m512i *)src;
+    __m512i * dst_reg = (__m512i *)dst;
+
+    for (; w >= item_size; w -= item_size)
     {
-        for (; tail_data_sz >= sizeof(__m128i); tail_data_sz -= sizeof(__m128i))
+        __m512i zmm0 = _mm512_load_si512(src_reg);
+        __m512i zmm1 = _mm512_load_si512(src_reg + 1);
+        __m512i zmm2 = _mm512_load_si512(src_reg + 2);
+        __m512i zmm3 = _mm512_load_si512(src_reg + 3);
+        storeRow<stream>(dst_reg,     _mm512_sll_epi16(zmm0, count));
+        storeRow<stream>(dst_reg + 1, _mm512_sll_epi16(zmm1, count));
+        storeRow<stream>(dst_reg + 2, _mm512_sll_epi16(zmm2, count));
+        storeRow<stream>(dst_reg + 3, _mm512_sll_epi16(zmm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    copySysToVideoShift_AVX2<stream>((const mfxU16 *)src_reg, (mfxU16 *)dst_reg, w, shift);
+}
+
+typedef void (*CopyRowFunc)(const mfxU8* src, mfxU8* dst, int width);
+typedef void (*CopyShiftRowFunc)(const mfxU16* src, mfxU16* dst, int width, int shift);
+
+// picks the widest row kernels the CPU supports up to maxIsa, [1] entries
+// use streaming stores
+struct FastCopyDispatcher
+{
+    FastCopyIsa      Isa;
+    CopyRowFunc      VideoToSys[2];
+    CopyShiftRowFunc VideoToSysShift[2];
+    CopyShiftRowFunc SysToVideoShift[2];
+
+    explicit FastCopyDispatcher(FastCopyIsa maxIsa = FAST_COPY_AVX512)
+    {
+        if (maxIsa >= FAST_COPY_AVX512 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        {
+            Set(FAST_COPY_AVX512,
+                copyVideoToSys_AVX512<false>, copyVideoToSys_AVX512<true>,
+                copyVideoToSysShift_AVX512<false>, copyVideoToSysShift_AVX512<true>,
+                copySysToVideoShift_AVX512<false>, copySysToVideoShift_AVX512<true>);
+        }
+        else if (maxIsa >= FAST_COPY_AVX2 && __builtin_cpu_supports("avx2"))
         {
-            __m128i xmm0 = _mm_load_si128(src_reg);
-            __m128i xmm1 = _mm_slli_epi32(xmm0, shift);
-            _mm_storeu_si128(dst_reg, xmm1);
-            src_reg += 1;
-            dst_reg += 1;
+            Set(FAST_COPY_AVX2,
+                copyVideoToSys_AVX2<false>, copyVideoToSys_AVX2<true>,
+                copyVideoToSysShift_AVX2<false>, copyVideoToSysShift_AVX2<true>,
+                copySysToVideoShift_AVX2<false>, copySysToVideoShift_AVX2<true>);
         }
+        else
+        {
+            Set(FAST_COPY_SSE4,
+                copyVideoToSys_SSE4<false>, copyVideoToSys_SSE4<true>,
+                copyVideoToSysShift_SSE4<false>, copyVideoToSysShift_SSE4<true>,
+                copySysToVideoShift_SSE4<false>, copySysToVideoShift_SSE4<true>);
+        }
+    }
 
-        src = (const mfxU16 *)src_reg;
-        dst = (mfxU16 *)dst_reg;
+    void Set(FastCopyIsa isa, CopyRowFunc v2s, CopyRowFunc v2sStream,
+             CopyShiftRowFunc v2sShift, CopyShiftRowFunc v2sShiftStream,
+             CopyShiftRowFunc s2vShift, CopyShiftRowFunc s2vShiftStream)
+    {
+        Isa                = isa;
+        VideoToSys[0]      = v2s;
+        VideoToSys[1]      = v2sStream;
+        VideoToSysShift[0] = v2sShift;
+        VideoToSysShift[1] = v2sShiftStream;
+        SysToVideoShift[0] = s2vShift;
+        SysToVideoShift[1] = s2vShiftStream;
+    }
 
-        for (; tail_data_sz > 0; tail_data_sz--)
-            *dst++ = (*src++)<<shift;
+    static const FastCopyDispatcher& Get()
+    {
+        static const FastCopyDispatcher dispatcher;
+        return dispatcher;
     }
+};
+
+// streaming stores need the same alignment of source and destination
+inline bool canStream(const void* src, const void* dst)
+{
+    return !((reinterpret_cast<size_t>(src) ^ reinterpret_cast<size_t>(dst)) & 0x3f);
+}
+
+inline void copyVideoToSys(const mfxU8* src, mfxU8* dst, int width, bool stream = false)
+{
+    FastCopyDispatcher::Get().VideoToSys[stream && canStream(src, dst)](src, dst, width);
+}
+
+inline void copyVideoToSysShift(const mfxU16* src, mfxU16* dst, int width, int shift, bool stream = false)
+{
+    // elements on odd addresses can't be aligned for vector loads
+    if (reinterpret_cast<size_t>(src) & 1)
+    {
+        for (int i = 0; i < width; i++)
+            dst[i] = src[i] >> shift;
+        return;
+    }
+
+    FastCopyDispatcher::Get().VideoToSysShift[stream && canStream(src, dst)](src, dst, width, shift);
+}
+
+inline void copySysToVideoShift(const mfxU16* src, mfxU16* dst, int width, int shift, bool stream = false)
+{
+    if (reinterpret_cast<size_t>(src) & 1)
+    {
+        for (int i = 0; i < width; i++)
+            dst[i] = src[i] << shift;
+        return;
+    }
+
+    FastCopyDispatcher::Get().SysToVideoShift[stream && canStream(src, dst)](src, dst, width, shift);
 }
 
 template<typename T>
-inline int mfxCopyRect(const T* pSrc, int srcStep, T* pDst, int dstStep, mfxSize roiSize, int flag)
+inline int mfxCopyRect(const T* pSrc, int srcStep, T* pDst, int dstStep, mfxSize roiSize, int flag, bool stream = false)
 {
     if (!pDst || !pSrc || roiSize.width < 0 || roiSize.height < 0 || srcStep < 0 || dstStep < 0)
         return -1;
@@ -211,7 +550,7 @@ inline int mfxCopyRect(const T* pSrc, int srcStep, T* pDst, int dstStep, mfxSize
     {
         for(int h = 0; h < roiSize.height; h++ )
         {
-            copyVideoToSys((const mfxU8*)pSrc, (mfxU8*)pDst, roiSize.width*sizeof(T));
+            copyVideoToSys((const mfxU8*)pSrc, (mfxU8*)pDst, roiSize.width*sizeof(T), stream);
             pSrc = (T *)((mfxU8*)pSrc + srcStep);
             pDst = (T *)((mfxU8*)pDst + dstStep);
         }
@@ -227,12 +566,137 @@ inline int mfxCopyRect(const T* pSrc, int srcStep, T* pDst, int dstStep, mfxSize
     return 0;
 }
 
+// Threads copying bands of rows of large planes. They are started once and
+// wait for the next plane, so a copy doesn't pay for thread creation. One
+// plane is split at a time, other callers meanwhile copy their planes alone.
+class FastCopyBands
+{
+public:
+    explicit FastCopyBands(int threads)
+        : m_copyBand(nullptr)
+        , m_rows(0)
+        , m_bands(0)
+        , m_next(0)
+        , m_pending(0)
+        , m_stop(false)
+    {
+        for (int i = 0; i < threads; i++)
+        {
+            try
+            {
+                m_threads.emplace_back(&FastCopyBands::Work, this);
+            }
+            catch (std::system_error&)
+            {
+                // the threads which were started are enough
+                break;
+            }
+        }
+    }
+
+    ~FastCopyBands()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    int Threads() const
+    {
+        return (int)m_threads.size();
+    }
+
+    // Calls copyBand(firstRow, numRows) for bands of the plane, the calling
+    // thread copies bands as well and returns when all of them are copied.
+    void Run(int rows, const std::function<void(int, int)>& copyBand)
+    {
+        int bands = std::min(Threads() + 1, rows / FAST_COPY_MIN_BAND_ROWS);
+        std::unique_lock<std::mutex> single(m_single, std::try_to_lock);
+
+        if (bands <= 1 || !single.owns_lock())
+        {
+            copyBand(0, rows);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_copyBand = &copyBand;
+        m_rows     = rows;
+        m_bands    = bands;
+        m_next     = 0;
+        m_pending  = bands;
+        m_start.notify_all();
+
+        while (m_next < m_bands)
+            CopyNextBand(lock);
+
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        m_copyBand = nullptr;
+        m_bands    = 0;
+    }
+
+    static FastCopyBands& Get()
+    {
+        static FastCopyBands bands(std::min<int>(std::thread::hardware_concurrency(), FAST_COPY_MAX_BANDS) - 1);
+        return bands;
+    }
+
+private:
+    void Work()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;)
+        {
+            m_start.wait(lock, [this] { return m_stop || m_next < m_bands; });
+            if (m_stop)
+                return;
+            CopyNextBand(lock);
+        }
+    }
+
+    void CopyNextBand(std::unique_lock<std::mutex>& lock)
+    {
+        int band  = m_next++;
+        int rows  = m_rows / m_bands;
+        int first = band * rows;
+        int count = (band == m_bands - 1) ? m_rows - first : rows;
+        const std::function<void(int, int)>& copyBand = *m_copyBand;
+
+        lock.unlock();
+        copyBand(first, count);
+        lock.lock();
+
+        if (--m_pending == 0)
+            m_done.notify_all();
+    }
+
+    FastCopyBands(FastCopyBands const &);
+    FastCopyBands & operator =(FastCopyBands const &);
+
+    std::mutex                           m_single;  // one plane is split at a time
+    std::mutex                           m_mutex;
+    std::condition_variable              m_start;
+    std::condition_variable              m_done;
+    std::vector<std::thread>             m_threads;
+    const std::function<void(int, int)>* m_copyBand;
+    int                                  m_rows;
+    int                                  m_bands;
+    int                                  m_next;
+    int                                  m_pending;
+    bool                                 m_stop;
+};
 
 class FastCopy
 {
 public:
     // copy memory by streaming
-    static mfxStatus Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, mfxSize roi, int flag)
+    static mfxStatus Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, mfxSize roi, int flag,
+        FastCopyBands& bands = FastCopyBands::Get())
     {
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "FastCopy::Copy");
 
@@ -247,11 +711,27 @@ public:
         static UMC::Mutex mutex; // This is thread-safe since C++11
         UMC::AutomaticUMCMutex guard(mutex);
 
-        mfxCopyRect<mfxU8>(pSrc, srcPitch, pDst, dstPitch, roi, flag);
+        bool stream = (size_t)roi.height * roi.width >= FAST_COPY_LARGE_PLANE;
+
+        if (!stream)
+        {
+            mfxCopyRect<mfxU8>(pSrc, srcPitch, pDst, dstPitch, roi, flag);
+            return MFX_ERR_NONE;
+        }
+
+        // bands are copied while the mutex is held, the threads are
+        // already running and the copy stays atomic
+        bands.Run(roi.height, [=](int first, int count)
+        {
+            mfxSize band = { roi.width, count };
+            mfxCopyRect<mfxU8>(pSrc + (size_t)first * srcPitch, srcPitch, pDst + (size_t)first * dstPitch, dstPitch, band, flag, true);
+            _mm_sfence();
+        });
 
         return MFX_ERR_NONE;
     }
-    static mfxStatus CopyAndShift(mfxU16 *pDst, mfxU32 dstPitch, mfxU16 *pSrc, mfxU32 srcPitch, mfxSize roi, mfxU8 lshift, mfxU8 rshift, int flag)
+    static mfxStatus CopyAndShift(mfxU16 *pDst, mfxU32 dstPitch, mfxU16 *pSrc, mfxU32 srcPitch, mfxSize roi, mfxU8 lshift, mfxU8 rshift, int flag,
+        FastCopyBands& bands = FastCopyBands::Get())
     {
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "FastCopy::Copy");
 
@@ -260,23 +740,32 @@ public:
             return MFX_ERR_NULL_PTR;
         }
 
-        if (flag & COPY_VIDEO_TO_SYS)
+        bool stream = (size_t)roi.height * roi.width * sizeof(mfxU16) >= FAST_COPY_LARGE_PLANE;
+
+        auto copyBand = [=](int first, int count)
         {
-            for (int h = 0; h < roi.height; h++)
-            {
-                copyVideoToSysShift( pSrc, pDst, roi.width, rshift);
-                pSrc = (mfxU16 *)((mfxU8*)pSrc + srcPitch);
-                pDst = (mfxU16 *)((mfxU8*)pDst + dstPitch);
-            }
-        }
-        else {
-            for (int h = 0; h < roi.height; h++)
+            const mfxU16* src = (const mfxU16 *)((const mfxU8*)pSrc + (size_t)first * srcPitch);
+            mfxU16*       dst = (mfxU16 *)((mfxU8*)pDst + (size_t)first * dstPitch);
+
+            for (int h = 0; h < count; h++)
             {
-                copySysToVideoShift( pSrc, pDst, roi.width, lshift);
-                pSrc = (mfxU16 *)((mfxU8*)pSrc + srcPitch);
-                pDst = (mfxU16 *)((mfxU8*)pDst + dstPitch);
+                if (flag & COPY_VIDEO_TO_SYS)
+                    copyVideoToSysShift(src, dst, roi.width, rshift, stream);
+                else
+                    copySysToVideoShift(src, dst, roi.width, lshift, stream);
+                src = (const mfxU16 *)((const mfxU8*)src + srcPitch);
+                dst = (mfxU16 *)((mfxU8*)dst + dstPitch);
             }
-        }
+
+            if (stream)
+                _mm_sfence();
+        };
+
+        if (stream)
+            bands.Run(roi.height, copyBand);
+        else
+            copyBand(0, roi.height);
+
         return MFX_ERR_NONE;
     }
 };
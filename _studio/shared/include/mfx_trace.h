@@ -29,6 +29,7 @@
 //#define MFX_TRACE_ENABLE_ITT
 //#define MFX_TRACE_ENABLE_TEXTLOG
 //#define MFX_TRACE_ENABLE_STAT
+//#define MFX_TRACE_ENABLE_BINLOG
 
 #if (defined(LINUX32) || defined(ANDROID)) && defined(MFX_TRACE_ENABLE_ITT) && !defined(MFX_TRACE_ENABLE_FTRACE)
     // Accompany ITT trace with ftrace. This combination is used by VTune.
@@ -42,7 +43,7 @@
     #define MFX_TRACE_ENABLE_REFLECT
 #endif
 
-#if defined(MFX_TRACE_ENABLE_TEXTLOG) || defined(MFX_TRACE_ENABLE_STAT) || defined(MFX_TRACE_ENABLE_ITT) || defined(MFX_TRACE_ENABLE_FTRACE)
+#if defined(MFX_TRACE_ENABLE_TEXTLOG) || defined(MFX_TRACE_ENABLE_STAT) || defined(MFX_TRACE_ENABLE_ITT) || defined(MFX_TRACE_ENABLE_FTRACE) || defined(MFX_TRACE_ENABLE_BINLOG)
 #define MFX_TRACE_ENABLE
 #endif
 
@@ -84,6 +85,7 @@ enum
 
     MFX_TRACE_OUTPUT_ITT    = 0x10,
     MFX_TRACE_OUTPUT_FTRACE = 0x20,
+    MFX_TRACE_OUTPUT_BINLOG = 0x40,
     // special keys
     MFX_TRACE_OUTPUT_ALL     = 0xFFFFFFFF,
     MFX_TRACE_OUTPUT_REG     = MFX_TRACE_OUTPUT_ALL // output mode should be read from registry
@@ -198,6 +200,8 @@ typedef struct
     mfxTraceHandle sd7;
     // reserved for itt
     mfxTraceHandle itt1;
+    // reserved for binary log
+    mfxTraceHandle bl1;
 } mfxTraceStaticHandle;
 
 typedef struct
@@ -209,6 +213,7 @@ typedef struct
     mfxTraceHandle fd4;
     // reserved for stat dump:
     mfxTraceHandle sd1;
+    mfxTraceHandle sd2;
     // reserved for TAL:
     mfxTraceHandle tal1;
     // reserved for ETW:
@@ -216,6 +221,8 @@ typedef struct
     mfxTraceHandle etw2;
     // reserved for itt
     mfxTraceHandle itt1;
+    // reserved for binary log
+    mfxTraceHandle bl1;
 } mfxTraceTaskHandle;
 
 /*------------------------------------------------------------------------------*/
@@ -254,6 +261,12 @@ mfxTraceU32 MFXTrace_BeginTask(mfxTraceStaticHandle *static_handle,
 mfxTraceU32 MFXTrace_EndTask(mfxTraceStaticHandle *static_handle,
                              mfxTraceTaskHandle *task_handle);
 
+mfxTraceU32 MFXTrace_Counter(mfxTraceStaticHandle *static_handle,
+                             const char *file_name, mfxTraceU32 line_num,
+                             const char *function_name,
+                             mfxTraceChar* category, mfxTraceLevel level,
+                             const char *counter_name, mfxTraceU64 value);
+
 /*------------------------------------------------------------------------------*/
 // basic macroses
 
@@ -280,12 +293,22 @@ mfxTraceU32 MFXTrace_EndTask(mfxTraceStaticHandle *static_handle,
     MFXTrace_DebugMessage _trace_all_params;                \
     ROLLBACK_WARN_HIDE_PREV_LOCAL_DECLARATION               \
 }
+
+// sets the value of a counter, the name must be the same for all calls from the place
+#define MFX_LTRACE_COUNTER(_level, _name, _value)                                   \
+{                                                                                   \
+    DISABLE_WARN_HIDE_PREV_LOCAL_DECLARATION                                        \
+    static mfxTraceStaticHandle _trace_static_handle = {};                          \
+    MFXTrace_Counter(MFX_TRACE_PARAMS, _level, _name, (mfxTraceU64)(_value));      \
+    ROLLBACK_WARN_HIDE_PREV_LOCAL_DECLARATION                                       \
+}
 #else
 #define MFX_TRACE_INIT()
 #define MFX_TRACE_INIT_RES(res)
 #define MFX_TRACE_CLOSE()
 #define MFX_TRACE_CLOSE_RES(res)
 #define MFX_LTRACE(_trace_all_params)
+#define MFX_LTRACE_COUNTER(_level, _name, _value)
 #endif
 
 /*------------------------------------------------------------------------------*/
@@ -22,6 +22,8 @@
 #define _MFX_ALLOC_WRAPPER_H_
 
 #include <vector>
+#include <deque>
+#include <unordered_map>
 #include <memory> // unique_ptr
 
 #include "mfx_common.h"
@@ -157,6 +159,9 @@ protected:
 
     virtual mfxI32 AddSurface(mfxFrameSurface1 *surface);
 
+    void ResetFreeSurfaces();
+    void PushFreeSurface(mfxU32 index);
+
     class InternalFrameData
     {
         class FrameRefInfo
@@ -177,6 +182,7 @@ protected:
         void ResetFrameData(mfxU32 index);
         mfxU32 IncreaseRef(mfxU32 index);
         mfxU32 DecreaseRef(mfxU32 index);
+        bool IsReferenced(mfxU32 index) const;
 
         bool IsValidMID(mfxU32 index) const;
 
@@ -198,6 +204,17 @@ protected:
 
     std::vector<surf_descr> m_extSurfaces;
 
+    // internal surfaces in the order they were released, may contain surfaces locked since then
+    std::deque<mfxU32> m_freeSurfaces;
+    std::vector<bool>  m_isInFreeList;
+    // a released surface is still locked outside of the allocator, it is unlocked
+    // bypassing Free() and only a rescan of the pool finds it
+    bool               m_rescanFreeSurfaces;
+
+    // last found index of surfaces looked up by FindSurface, checked on every hit
+    std::unordered_map<mfxMemId, mfxU32>          m_memIdIndex[2]; // [isOpaq]
+    std::unordered_map<mfxFrameSurface1*, mfxU32> m_extSurfaceIndex;
+
     mfxI32        m_curIndex;
 
     bool m_IsUseExternalFrames;
@@ -0,0 +1,142 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_TRACE_BINLOG_H__
+#define __MFX_TRACE_BINLOG_H__
+
+#include "mfx_trace.h"
+
+/*------------------------------------------------------------------------------*/
+// binary log file format, shared with the offline converter
+//
+// The file starts with mfxTraceBinLogHeader followed by chunks. Each chunk is
+// mfxTraceBinLogChunk and a payload of the given size:
+//  - MFX_TRACE_BINLOG_CHUNK_NAME: mfxTraceBinLogName followed by zero terminated
+//    task (or counter) name, function name and file name of the static handle
+//  - MFX_TRACE_BINLOG_CHUNK_EVENTS: mfxTraceBinLogEvents followed by records of
+//    a single thread in the order they happened
+//  - MFX_TRACE_BINLOG_CHUNK_CLOCK: mfxTraceBinLogClock, written on start and on
+//    every flush to convert record ticks into time
+// All values are little endian.
+
+#define MFX_TRACE_BINLOG_MAGIC   "MFXTRBIN"
+#define MFX_TRACE_BINLOG_VERSION 2
+
+// set in mfxTraceBinLogRecord::id for EndTask records
+#define MFX_TRACE_BINLOG_END     0x80000000
+// set in mfxTraceBinLogRecord::id for counter records, task is the value
+// of the counter saturated to 32 bits
+#define MFX_TRACE_BINLOG_COUNTER 0x40000000
+
+enum
+{
+    MFX_TRACE_BINLOG_CHUNK_NAME   = 1,
+    MFX_TRACE_BINLOG_CHUNK_EVENTS = 2,
+    MFX_TRACE_BINLOG_CHUNK_CLOCK  = 3
+};
+
+typedef struct
+{
+    char        magic[8];
+    mfxTraceU32 version;
+    mfxTraceU32 pid;
+} mfxTraceBinLogHeader;
+
+typedef struct
+{
+    mfxTraceU32 type;
+    mfxTraceU32 size;
+} mfxTraceBinLogChunk;
+
+typedef struct
+{
+    mfxTraceU32 id;
+    mfxTraceU32 line_num;
+} mfxTraceBinLogName;
+
+typedef struct
+{
+    mfxTraceU32 thread;
+    mfxTraceU32 dropped; // records lost since the previous chunk of the thread
+} mfxTraceBinLogEvents;
+
+typedef struct
+{
+    mfxTraceU64 ticks;   // ticks of the trace clock at the same moment
+    mfxTraceU64 time;    // CLOCK_MONOTONIC in nanoseconds
+} mfxTraceBinLogClock;
+
+typedef struct
+{
+    mfxTraceU64 ticks;
+    mfxTraceU32 id;      // static handle id, MFX_TRACE_BINLOG_END for EndTask,
+                         // MFX_TRACE_BINLOG_COUNTER for counters
+    mfxTraceU32 task;    // task id if it was requested, 0 otherwise
+} mfxTraceBinLogRecord;
+
+#ifdef MFX_TRACE_ENABLE_BINLOG
+
+/*------------------------------------------------------------------------------*/
+
+// trace registry options and parameters
+#define MFX_TRACE_BINLOG_REG_FILE_NAME MFX_TRACE_STRING("BinLog")
+#define MFX_TRACE_BINLOG_REG_RING_SIZE MFX_TRACE_STRING("BinLogRingSize")
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_Init();
+
+mfxTraceU32 MFXTraceBinLog_SetLevel(mfxTraceChar* category,
+                                    mfxTraceLevel level);
+
+mfxTraceU32 MFXTraceBinLog_DebugMessage(mfxTraceStaticHandle *static_handle,
+                                        const char *file_name, mfxTraceU32 line_num,
+                                        const char *function_name,
+                                        mfxTraceChar* category, mfxTraceLevel level,
+                                        const char *message,
+                                        const char *format, ...);
+
+mfxTraceU32 MFXTraceBinLog_vDebugMessage(mfxTraceStaticHandle *static_handle,
+                                         const char *file_name, mfxTraceU32 line_num,
+                                         const char *function_name,
+                                         mfxTraceChar* category, mfxTraceLevel level,
+                                         const char *message,
+                                         const char *format, va_list args);
+
+mfxTraceU32 MFXTraceBinLog_BeginTask(mfxTraceStaticHandle *static_handle,
+                                     const char *file_name, mfxTraceU32 line_num,
+                                     const char *function_name,
+                                     mfxTraceChar* category, mfxTraceLevel level,
+                                     const char *task_name, mfxTraceTaskHandle *task_handle,
+                                     const void *task_params);
+
+mfxTraceU32 MFXTraceBinLog_EndTask(mfxTraceStaticHandle *static_handle,
+                                   mfxTraceTaskHandle *task_handle);
+
+mfxTraceU32 MFXTraceBinLog_Counter(mfxTraceStaticHandle *static_handle,
+                                   const char *file_name, mfxTraceU32 line_num,
+                                   const char *function_name,
+                                   mfxTraceChar* category, mfxTraceLevel level,
+                                   const char *counter_name, mfxTraceU64 value);
+
+mfxTraceU32 MFXTraceBinLog_Close(void);
+
+#endif // #ifdef MFX_TRACE_ENABLE_BINLOG
+#endif // #ifndef __MFX_TRACE_BINLOG_H__
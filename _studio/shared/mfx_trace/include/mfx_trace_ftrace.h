@@ -55,6 +55,12 @@ mfxTraceU32 MFXTraceFtrace_BeginTask(mfxTraceStaticHandle *static_handle,
 mfxTraceU32 MFXTraceFtrace_EndTask(mfxTraceStaticHandle *static_handle,
     mfxTraceTaskHandle *task_handle);
 
+mfxTraceU32 MFXTraceFtrace_Counter(mfxTraceStaticHandle *static_handle,
+    const char *file_name, mfxTraceU32 line_num,
+    const char *function_name,
+    mfxTraceChar* category, mfxTraceLevel level,
+    const char *counter_name, mfxTraceU64 value);
+
 mfxTraceU32 MFXTraceFtrace_Close(void);
 
 #endif // #if defined(MFX_TRACE_ENABLE_FTRACE) && (defined(LINUX32) || defined(ANDROID))
@@ -41,6 +41,24 @@ enum
     MFX_TRACE_STAT_SUPPRESS_LEVEL         = 0x08
 };
 
+// latency of a task at one place of the call tree of traced tasks, merged over all threads
+typedef struct
+{
+    mfxTraceU32 id;             // node id, ids are stable until the process exits
+    mfxTraceU32 parent;         // id of the calling task, 0 for top level tasks
+    mfxTraceU32 depth;          // 1 for top level tasks
+    const char* function_name;
+    const char* task_name;
+    mfxTraceU64 count;
+    // times in seconds, percentiles are precise up to 1/32 of the value
+    double      total;
+    double      min;
+    double      max;
+    double      p50;
+    double      p99;
+    double      p999;
+} mfxTraceStatLatency;
+
 /*------------------------------------------------------------------------------*/
 
 mfxTraceU32 MFXTraceStat_Init();
@@ -72,7 +90,21 @@ mfxTraceU32 MFXTraceStat_BeginTask(mfxTraceStaticHandle *static_handle,
 mfxTraceU32 MFXTraceStat_EndTask(mfxTraceStaticHandle *static_handle,
                               mfxTraceTaskHandle *task_handle);
 
+mfxTraceU32 MFXTraceStat_Counter(mfxTraceStaticHandle *static_handle,
+                                 const char *file_name, mfxTraceU32 line_num,
+                                 const char *function_name,
+                                 mfxTraceChar* category, mfxTraceLevel level,
+                                 const char *counter_name, mfxTraceU64 value);
+
 mfxTraceU32 MFXTraceStat_Close(void);
 
+// Copies latency of the tasks in depth-first order of the call tree, only tasks
+// which have ended since MFXTraceStat_Init are reported. If *count is less than
+// the number of tasks, returns 1 and sets *count to the required number.
+mfxTraceU32 MFXTraceStat_GetLatency(mfxTraceStatLatency* latency, mfxTraceU32* count);
+
+// Returns in *time (seconds) the given percentile (0, 100] of the latency of node id.
+mfxTraceU32 MFXTraceStat_GetPercentile(mfxTraceU32 id, double percentile, double* time);
+
 #endif // #ifdef MFX_TRACE_ENABLE_STAT
 #endif // #ifndef __MFX_TRACE_STAT_H__
@@ -73,6 +73,12 @@ mfxTraceU32 MFXTraceTextLog_BeginTask(mfxTraceStaticHandle *static_handle,
 mfxTraceU32 MFXTraceTextLog_EndTask(mfxTraceStaticHandle *static_handle,
                               mfxTraceTaskHandle *task_handle);
 
+mfxTraceU32 MFXTraceTextLog_Counter(mfxTraceStaticHandle *static_handle,
+                                    const char *file_name, mfxTraceU32 line_num,
+                                    const char *function_name,
+                                    mfxTraceChar* category, mfxTraceLevel level,
+                                    const char *counter_name, mfxTraceU64 value);
+
 mfxTraceU32 MFXTraceTextLog_Close(void);
 
 #endif // #ifdef MFX_TRACE_ENABLE_TEXTLOG
@@ -37,6 +37,7 @@ extern "C"
 #include "mfx_trace_stat.h"
 #include "mfx_trace_itt.h"
 #include "mfx_trace_ftrace.h"
+#include "mfx_trace_binlog.h"
 }
 #include <stdlib.h>
 #include <string.h>
@@ -73,6 +74,12 @@ typedef mfxTraceU32 (*MFXTrace_BeginTaskFn)(mfxTraceStaticHandle *static_handle,
 typedef mfxTraceU32 (*MFXTrace_EndTaskFn)(mfxTraceStaticHandle *static_handle,
                                      mfxTraceTaskHandle *task_handle);
 
+typedef mfxTraceU32 (*MFXTrace_CounterFn)(mfxTraceStaticHandle *static_handle,
+                                     const char *file_name, mfxTraceU32 line_num,
+                                     const char *function_name,
+                                     mfxTraceChar* category, mfxTraceLevel level,
+                                     const char *counter_name, mfxTraceU64 value);
+
 typedef mfxTraceU32 (*MFXTrace_CloseFn)(void);
 
 struct mfxTraceAlgorithm
@@ -85,6 +92,7 @@ struct mfxTraceAlgorithm
     MFXTrace_vDebugMessageFn m_vDebugMessageFn;
     MFXTrace_BeginTaskFn     m_BeginTaskFn;
     MFXTrace_EndTaskFn       m_EndTaskFn;
+    MFXTrace_CounterFn       m_CounterFn;
     MFXTrace_CloseFn         m_CloseFn;
 };
 
@@ -109,6 +117,7 @@ mfxTraceAlgorithm g_TraceAlgorithms[] =
         MFXTraceTextLog_vDebugMessage,
         MFXTraceTextLog_BeginTask,
         MFXTraceTextLog_EndTask,
+        MFXTraceTextLog_Counter,
         MFXTraceTextLog_Close
     },
 #endif
@@ -122,6 +131,7 @@ mfxTraceAlgorithm g_TraceAlgorithms[] =
         MFXTraceStat_vDebugMessage,
         MFXTraceStat_BeginTask,
         MFXTraceStat_EndTask,
+        MFXTraceStat_Counter,
         MFXTraceStat_Close
     },
 #endif
@@ -135,6 +145,7 @@ mfxTraceAlgorithm g_TraceAlgorithms[] =
         MFXTraceITT_vDebugMessage,
         MFXTraceITT_BeginTask,
         MFXTraceITT_EndTask,
+        MFXTraceITT_Counter,
         MFXTraceITT_Close
     },
 #endif
@@ -148,9 +159,24 @@ mfxTraceAlgorithm g_TraceAlgorithms[] =
         MFXTraceFtrace_vDebugMessage,
         MFXTraceFtrace_BeginTask,
         MFXTraceFtrace_EndTask,
+        MFXTraceFtrace_Counter,
         MFXTraceFtrace_Close
     },
 #endif
+#ifdef MFX_TRACE_ENABLE_BINLOG
+    {
+        0,
+        MFX_TRACE_OUTPUT_BINLOG,
+        MFXTraceBinLog_Init,
+        MFXTraceBinLog_SetLevel,
+        MFXTraceBinLog_DebugMessage,
+        MFXTraceBinLog_vDebugMessage,
+        MFXTraceBinLog_BeginTask,
+        MFXTraceBinLog_EndTask,
+        MFXTraceBinLog_Counter,
+        MFXTraceBinLog_Close
+    },
+#endif
 };
 
 /*------------------------------------------------------------------------------*/
@@ -240,6 +266,9 @@ mfxTraceU32 MFXTrace_Init()
 #if defined(MFX_TRACE_ENABLE_FTRACE)
     g_OutputMode |= MFX_TRACE_OUTPUT_FTRACE;
 #endif
+#if defined(MFX_TRACE_ENABLE_BINLOG)
+    g_OutputMode |= MFX_TRACE_OUTPUT_BINLOG;
+#endif
 
     if (vm_interlocked_inc32(&g_refCounter) != 1)
     {
@@ -457,6 +486,32 @@ mfxTraceU32 MFXTrace_EndTask(mfxTraceStaticHandle *static_handle,
     return sts;
 }
 
+mfxTraceU32 MFXTrace_Counter(mfxTraceStaticHandle *static_handle,
+                             const char *file_name, mfxTraceU32 line_num,
+                             const char *function_name,
+                             mfxTraceChar* category, mfxTraceLevel level,
+                             const char *counter_name, mfxTraceU64 value)
+{
+    if (!MFXTrace_IsPrintableCategoryAndLevel(category, level)) return 0;
+
+    mfxTraceU32 sts = 0, res = 0;
+    mfxTraceU32 i = 0;
+
+    for (i = 0; i < sizeof(g_TraceAlgorithms)/sizeof(mfxTraceAlgorithm); ++i)
+    {
+        if (g_OutputMode & g_TraceAlgorithms[i].m_OutputInitilized)
+        {
+            res = g_TraceAlgorithms[i].m_CounterFn(static_handle,
+                                                   file_name, line_num,
+                                                   function_name,
+                                                   category, level,
+                                                   counter_name, value);
+            if (!sts && res) sts = res;
+        }
+    }
+    return sts;
+}
+
 /*------------------------------------------------------------------------------*/
 // C++ class MFXTraceTask
 
@@ -0,0 +1,485 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_trace.h"
+
+#ifdef MFX_TRACE_ENABLE_BINLOG
+extern "C"
+{
+#include "mfx_trace_utils.h"
+#include "mfx_trace_binlog.h"
+}
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#define MFT_TRACE_PATH_TO_TEMP_BINLOG MFX_TRACE_STRING("/tmp/mfxlib.trace")
+
+// default and limits of the number of records in the ring of a thread
+#define MFX_TRACE_BINLOG_RING_SIZE     (1 << 16)
+#define MFX_TRACE_BINLOG_MIN_RING_SIZE (1 << 10)
+#define MFX_TRACE_BINLOG_MAX_RING_SIZE (1 << 24)
+
+// period of draining the rings to the file
+#define MFX_TRACE_BINLOG_FLUSH_MS      10
+
+/*------------------------------------------------------------------------------*/
+
+// Ring of records of a single thread. The thread is the only one to move head,
+// the writer is the only one to move tail, so no locks are taken to add a record.
+// A full ring drops records and counts them.
+struct mfxTraceBinLogRing
+{
+    std::atomic<mfxTraceU32> head;
+    char                     pad0[64 - sizeof(std::atomic<mfxTraceU32>)];
+    std::atomic<mfxTraceU32> tail;
+    char                     pad1[64 - sizeof(std::atomic<mfxTraceU32>)];
+    std::atomic<mfxTraceU32> dropped;
+    bool                     orphan; // the thread has exited
+    mfxTraceU32              thread;
+    mfxTraceU32              mask;
+    std::vector<mfxTraceBinLogRecord> records;
+
+    mfxTraceBinLogRing(mfxTraceU32 size)
+        : head(0)
+        , tail(0)
+        , dropped(0)
+        , orphan(false)
+        , thread((mfxTraceU32)syscall(SYS_gettid))
+        , mask(size - 1)
+        , records(size)
+    {}
+};
+
+static mfxTraceChar g_mfxTraceBinLogFileName[MAX_PATH] = MFT_TRACE_PATH_TO_TEMP_BINLOG;
+static mfxTraceU32  g_mfxTraceBinLogRingSize = MFX_TRACE_BINLOG_RING_SIZE;
+static FILE*        g_mfxTraceBinLogFile = NULL;
+
+// g_BinLogMutex protects the list of rings, pending names and the file,
+// adding records takes no locks
+static std::mutex                       g_BinLogMutex;
+static std::condition_variable          g_BinLogCondVar;
+static std::thread                      g_BinLogWriter;
+static bool                             g_BinLogStop = false;
+static std::vector<mfxTraceBinLogRing*> g_BinLogRings;
+static std::vector<char>                g_BinLogNames;
+static mfxTraceU32                      g_BinLogLastId = 0;
+
+// incremented on close, static handles and rings of previous runs are stale
+static std::atomic<mfxTraceU32>         g_BinLogGeneration(1);
+
+struct mfxTraceBinLogThread
+{
+    mfxTraceBinLogRing* ring;
+    mfxTraceU32         generation;
+
+    ~mfxTraceBinLogThread()
+    {
+        std::lock_guard<std::mutex> lock(g_BinLogMutex);
+        if (ring && generation == g_BinLogGeneration.load())
+            ring->orphan = true;
+    }
+};
+
+static thread_local mfxTraceBinLogThread t_BinLogThread = { NULL, 0 };
+
+/*------------------------------------------------------------------------------*/
+
+static mfxTraceU64 MFXTraceBinLog_GetTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (mfxTraceU64)ts.tv_sec * 1000000000 + (mfxTraceU64)ts.tv_nsec;
+}
+
+// Time stamp counter costs a fraction of clock_gettime(), ticks are matched
+// with time by clock chunks of the log.
+static inline mfxTraceU64 MFXTraceBinLog_GetTicks(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    return MFXTraceBinLog_GetTime();
+#endif
+}
+
+static mfxTraceBinLogRing* MFXTraceBinLog_GetRing(void)
+{
+    mfxTraceBinLogThread& self = t_BinLogThread;
+    mfxTraceU32 generation = g_BinLogGeneration.load(std::memory_order_acquire);
+
+    if (self.ring && self.generation == generation)
+        return self.ring;
+
+    self.ring = NULL;
+
+    mfxTraceBinLogRing* ring = NULL;
+    try
+    {
+        ring = new mfxTraceBinLogRing(g_mfxTraceBinLogRingSize);
+    }
+    catch (std::bad_alloc&)
+    {
+        return NULL;
+    }
+
+    std::lock_guard<std::mutex> lock(g_BinLogMutex);
+    if (!g_mfxTraceBinLogFile || generation != g_BinLogGeneration.load())
+    {
+        delete ring;
+        return NULL;
+    }
+    g_BinLogRings.push_back(ring);
+
+    self.ring       = ring;
+    self.generation = generation;
+    return ring;
+}
+
+// assigns id to the static handle on the first use in the current run
+static mfxTraceU32 MFXTraceBinLog_GetId(mfxTraceStaticHandle *static_handle,
+                                        const char *file_name, mfxTraceU32 line_num,
+                                        const char *function_name, const char *task_name)
+{
+    mfxTraceU64 generation = g_BinLogGeneration.load(std::memory_order_acquire);
+    mfxTraceU64 value = __atomic_load_n(&static_handle->bl1.uint64, __ATOMIC_ACQUIRE);
+
+    if ((value >> 32) == generation)
+        return (mfxTraceU32)value;
+
+    std::lock_guard<std::mutex> lock(g_BinLogMutex);
+
+    value = static_handle->bl1.uint64;
+    if ((value >> 32) == generation)
+        return (mfxTraceU32)value;
+
+    mfxTraceBinLogName name = { ++g_BinLogLastId, line_num };
+    const char* strings[] = { task_name, function_name, file_name };
+
+    mfxTraceBinLogChunk chunk = { MFX_TRACE_BINLOG_CHUNK_NAME, sizeof(name) };
+    for (const char* str : strings)
+        chunk.size += (mfxTraceU32)(str ? strlen(str) : 0) + 1;
+
+    g_BinLogNames.insert(g_BinLogNames.end(), (const char*)&chunk, (const char*)(&chunk + 1));
+    g_BinLogNames.insert(g_BinLogNames.end(), (const char*)&name, (const char*)(&name + 1));
+    for (const char* str : strings)
+    {
+        if (str)
+            g_BinLogNames.insert(g_BinLogNames.end(), str, str + strlen(str));
+        g_BinLogNames.push_back('\0');
+    }
+
+    __atomic_store_n(&static_handle->bl1.uint64, (generation << 32) | name.id, __ATOMIC_RELEASE);
+    return name.id;
+}
+
+static mfxTraceU32 MFXTraceBinLog_AddRecord(mfxTraceU32 id, mfxTraceU32 task)
+{
+    mfxTraceU64 ticks = MFXTraceBinLog_GetTicks();
+    mfxTraceBinLogRing* ring = MFXTraceBinLog_GetRing();
+
+    if (!ring) return 1;
+
+    mfxTraceU32 head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) > ring->mask)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    mfxTraceBinLogRecord& record = ring->records[head & ring->mask];
+    record.ticks = ticks;
+    record.id   = id;
+    record.task = task;
+
+    ring->head.store(head + 1, std::memory_order_release);
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+static void MFXTraceBinLog_WriteClock(FILE* file)
+{
+    mfxTraceBinLogChunk chunk = { MFX_TRACE_BINLOG_CHUNK_CLOCK, sizeof(mfxTraceBinLogClock) };
+    mfxTraceBinLogClock clock;
+
+    clock.ticks = MFXTraceBinLog_GetTicks();
+    clock.time  = MFXTraceBinLog_GetTime();
+
+    fwrite(&chunk, sizeof(chunk), 1, file);
+    fwrite(&clock, sizeof(clock), 1, file);
+}
+
+// writes pending names and records to the file, called under g_BinLogMutex
+static void MFXTraceBinLog_Drain(void)
+{
+    if (!g_mfxTraceBinLogFile) return;
+
+    MFXTraceBinLog_WriteClock(g_mfxTraceBinLogFile);
+
+    if (!g_BinLogNames.empty())
+    {
+        fwrite(g_BinLogNames.data(), 1, g_BinLogNames.size(), g_mfxTraceBinLogFile);
+        g_BinLogNames.clear();
+    }
+
+    for (size_t i = 0; i < g_BinLogRings.size();)
+    {
+        mfxTraceBinLogRing* ring = g_BinLogRings[i];
+        bool orphan = ring->orphan;
+
+        mfxTraceU32 head = ring->head.load(std::memory_order_acquire);
+        mfxTraceU32 tail = ring->tail.load(std::memory_order_relaxed);
+        mfxTraceBinLogEvents events = { ring->thread, ring->dropped.exchange(0) };
+
+        if (head != tail || events.dropped)
+        {
+            mfxTraceU32 count = head - tail;
+            mfxTraceU32 first = tail & ring->mask;
+            mfxTraceU32 part  = std::min(count, ring->mask + 1 - first);
+            mfxTraceBinLogChunk chunk = { MFX_TRACE_BINLOG_CHUNK_EVENTS, (mfxTraceU32)(sizeof(events) + count * sizeof(mfxTraceBinLogRecord)) };
+
+            fwrite(&chunk, sizeof(chunk), 1, g_mfxTraceBinLogFile);
+            fwrite(&events, sizeof(events), 1, g_mfxTraceBinLogFile);
+            fwrite(&ring->records[first], sizeof(mfxTraceBinLogRecord), part, g_mfxTraceBinLogFile);
+            fwrite(&ring->records[0], sizeof(mfxTraceBinLogRecord), count - part, g_mfxTraceBinLogFile);
+
+            ring->tail.store(head, std::memory_order_release);
+        }
+
+        if (orphan)
+        {
+            delete ring;
+            g_BinLogRings.erase(g_BinLogRings.begin() + i);
+        }
+        else ++i;
+    }
+}
+
+static void MFXTraceBinLog_Writer(void)
+{
+    std::unique_lock<std::mutex> lock(g_BinLogMutex);
+
+    while (!g_BinLogStop)
+    {
+        g_BinLogCondVar.wait_for(lock, std::chrono::milliseconds(MFX_TRACE_BINLOG_FLUSH_MS));
+        MFXTraceBinLog_Drain();
+    }
+    MFXTraceBinLog_Drain();
+}
+
+/*------------------------------------------------------------------------------*/
+
+extern "C"
+{
+
+mfxTraceU32 MFXTraceBinLog_GetRegistryParams(void)
+{
+    FILE* conf_file = mfx_trace_open_conf_file(MFX_TRACE_CONFIG);
+    mfxTraceU32 value = 0;
+
+    if (!conf_file) return 1;
+    mfx_trace_get_conf_string(conf_file,
+                              MFX_TRACE_BINLOG_REG_FILE_NAME,
+                              g_mfxTraceBinLogFileName,
+                              sizeof(g_mfxTraceBinLogFileName));
+
+    if (!mfx_trace_get_conf_dword(conf_file,
+                                  MFX_TRACE_BINLOG_REG_RING_SIZE,
+                                  &value))
+    {
+        g_mfxTraceBinLogRingSize = MFX_TRACE_BINLOG_MIN_RING_SIZE;
+        while (g_mfxTraceBinLogRingSize < value && g_mfxTraceBinLogRingSize < MFX_TRACE_BINLOG_MAX_RING_SIZE)
+            g_mfxTraceBinLogRingSize <<= 1;
+    }
+    fclose(conf_file);
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_Init()
+{
+    mfxTraceU32 sts = 0;
+
+    sts = MFXTraceBinLog_Close();
+    if (!sts) sts = MFXTraceBinLog_GetRegistryParams();
+    if (!sts)
+    {
+        FILE* file = mfx_trace_tfopen(g_mfxTraceBinLogFileName, MFX_TRACE_STRING("wb"));
+        if (!file) return 1;
+
+        mfxTraceBinLogHeader header = {};
+        memcpy(header.magic, MFX_TRACE_BINLOG_MAGIC, sizeof(header.magic));
+        header.version = MFX_TRACE_BINLOG_VERSION;
+        header.pid     = (mfxTraceU32)getpid();
+        fwrite(&header, sizeof(header), 1, file);
+        MFXTraceBinLog_WriteClock(file);
+
+        std::lock_guard<std::mutex> lock(g_BinLogMutex);
+        g_mfxTraceBinLogFile = file;
+        g_BinLogStop = false;
+        try
+        {
+            g_BinLogWriter = std::thread(MFXTraceBinLog_Writer);
+        }
+        catch (std::system_error&)
+        {
+            fclose(g_mfxTraceBinLogFile);
+            g_mfxTraceBinLogFile = NULL;
+            return 1;
+        }
+    }
+    return sts;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_Close(void)
+{
+    if (g_BinLogWriter.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_BinLogMutex);
+            g_BinLogStop = true;
+        }
+        g_BinLogCondVar.notify_one();
+        g_BinLogWriter.join();
+    }
+
+    std::lock_guard<std::mutex> lock(g_BinLogMutex);
+
+    g_BinLogGeneration.fetch_add(1);
+    for (mfxTraceBinLogRing* ring : g_BinLogRings)
+        delete ring;
+    g_BinLogRings.clear();
+    g_BinLogNames.clear();
+    g_BinLogLastId = 0;
+
+    if (g_mfxTraceBinLogFile)
+    {
+        fclose(g_mfxTraceBinLogFile);
+        g_mfxTraceBinLogFile = NULL;
+    }
+    g_mfxTraceBinLogRingSize = MFX_TRACE_BINLOG_RING_SIZE;
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_SetLevel(mfxTraceChar* /*category*/, mfxTraceLevel /*level*/)
+{
+    return 1;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_DebugMessage(mfxTraceStaticHandle* /*static_handle*/,
+                                        const char* /*file_name*/, mfxTraceU32 /*line_num*/,
+                                        const char* /*function_name*/,
+                                        mfxTraceChar* /*category*/, mfxTraceLevel /*level*/,
+                                        const char* /*message*/, const char* /*format*/, ...)
+{
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+// only tasks are logged, formatting messages is what this mode avoids
+mfxTraceU32 MFXTraceBinLog_vDebugMessage(mfxTraceStaticHandle* /*static_handle*/,
+                                         const char* /*file_name*/, mfxTraceU32 /*line_num*/,
+                                         const char* /*function_name*/,
+                                         mfxTraceChar* /*category*/, mfxTraceLevel /*level*/,
+                                         const char* /*message*/,
+                                         const char* /*format*/, va_list /*args*/)
+{
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_BeginTask(mfxTraceStaticHandle *static_handle,
+                                     const char *file_name, mfxTraceU32 line_num,
+                                     const char *function_name,
+                                     mfxTraceChar* /*category*/, mfxTraceLevel /*level*/,
+                                     const char *task_name, mfxTraceTaskHandle *task_handle,
+                                     const void *task_params)
+{
+    if (!static_handle || !task_handle) return 1;
+
+    mfxTraceU32 id = MFXTraceBinLog_GetId(static_handle, file_name, line_num, function_name, task_name);
+
+    task_handle->bl1.uint32 = (task_params) ? *(const mfxTraceU32*)task_params : 0;
+
+    return MFXTraceBinLog_AddRecord(id, task_handle->bl1.uint32);
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_EndTask(mfxTraceStaticHandle *static_handle,
+                                   mfxTraceTaskHandle *task_handle)
+{
+    if (!static_handle || !task_handle) return 1;
+
+    mfxTraceU32 id = (mfxTraceU32)__atomic_load_n(&static_handle->bl1.uint64, __ATOMIC_ACQUIRE);
+
+    return MFXTraceBinLog_AddRecord(id | MFX_TRACE_BINLOG_END, task_handle->bl1.uint32);
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceBinLog_Counter(mfxTraceStaticHandle *static_handle,
+                                   const char *file_name, mfxTraceU32 line_num,
+                                   const char *function_name,
+                                   mfxTraceChar* /*category*/, mfxTraceLevel /*level*/,
+                                   const char *counter_name, mfxTraceU64 value)
+{
+    if (!static_handle) return 1;
+
+    mfxTraceU32 id = MFXTraceBinLog_GetId(static_handle, file_name, line_num, function_name, counter_name);
+
+    return MFXTraceBinLog_AddRecord(id | MFX_TRACE_BINLOG_COUNTER, (mfxTraceU32)std::min<mfxTraceU64>(value, 0xFFFFFFFF));
+}
+
+} // extern "C"
+
+// flushes the log if the application exits without closing the trace
+static struct mfxTraceBinLogGuard
+{
+    ~mfxTraceBinLogGuard()
+    {
+        MFXTraceBinLog_Close();
+    }
+} g_BinLogGuard;
+
+#endif // #ifdef MFX_TRACE_ENABLE_BINLOG
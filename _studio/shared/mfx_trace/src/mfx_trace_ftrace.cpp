@@ -256,6 +256,31 @@ mfxTraceU32 MFXTraceFtrace_EndTask(mfxTraceStaticHandle * //static_handle
     return 0;
 }
 
+/*------------------------------------------------------------------------------*/
+
+// counters are written in the systrace format understood by the trace viewers
+mfxTraceU32 MFXTraceFtrace_Counter(mfxTraceStaticHandle * //static_handle
+    , const char * //file_name
+    , mfxTraceU32 //line_num
+    , const char * //function_name
+    , mfxTraceChar* //category
+    , mfxTraceLevel //level
+    , const char * counter_name
+    , mfxTraceU64 value
+    )
+{
+    if (trace_handle == -1) return 1;
+
+    char str[MFX_TRACE_MAX_LINE_LENGTH] = {0};
+    int size = snprintf(str, sizeof(str), "C|%d|%s|%llu\n", (int)getpid(), counter_name, (unsigned long long)value);
+
+    if (size < 0 || write(trace_handle, str, (size_t)size) == -1)
+    {
+        return 1;
+    }
+    return 0;
+}
+
 } // extern "C"
 
 
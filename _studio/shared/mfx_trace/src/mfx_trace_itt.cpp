@@ -137,5 +137,29 @@ mfxTraceU32 MFXTraceITT_EndTask(mfxTraceStaticHandle * //static_handle
     return 0;
 }
 
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceITT_Counter(mfxTraceStaticHandle *static_handle
+                                ,const char * //file_name
+                                ,mfxTraceU32 //line_num
+                                ,const char * //function_name
+                                ,mfxTraceChar* //category
+                                ,mfxTraceLevel //level
+                                ,const char * counter_name
+                                ,mfxTraceU64 value)
+{
+    if (!static_handle) return 1;
+
+    // cache counter handle across calls
+    if (NULL == static_handle->itt1.ptr)
+    {
+        static_handle->itt1.ptr = __itt_counter_create(counter_name, "MediaSDK");
+    }
+
+    __itt_counter_set_value((__itt_counter)static_handle->itt1.ptr, &value);
+
+    return 0;
+}
+
 } // extern "C"
 #endif // #ifdef MFX_TRACE_ENABLE_ITT
@@ -28,11 +28,398 @@ extern "C"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+}
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <time.h>
+
+/*------------------------------------------------------------------------------*/
+
+// Latency histograms are log-linear: values below 2^SUB_BITS ns have own buckets,
+// every next power of two is split into 2^SUB_BITS buckets. Tasks longer than
+// 2^MAX_EXP ns (~18 minutes) fall into the last bucket.
+#define MFX_TRACE_STAT_HIST_SUB_BITS 4
+#define MFX_TRACE_STAT_HIST_SUB      (1 << MFX_TRACE_STAT_HIST_SUB_BITS)
+#define MFX_TRACE_STAT_HIST_MAX_EXP  40
+#define MFX_TRACE_STAT_HIST_SIZE     ((MFX_TRACE_STAT_HIST_MAX_EXP - MFX_TRACE_STAT_HIST_SUB_BITS + 2) * MFX_TRACE_STAT_HIST_SUB)
+
+static mfxTraceU32 mfx_trace_stat_bucket(mfxTraceU64 ns)
+{
+    if (ns < MFX_TRACE_STAT_HIST_SUB) return (mfxTraceU32)ns;
+
+    mfxTraceU32 exp = 63 - __builtin_clzll(ns);
+    if (exp > MFX_TRACE_STAT_HIST_MAX_EXP) return MFX_TRACE_STAT_HIST_SIZE - 1;
+
+    return (exp - MFX_TRACE_STAT_HIST_SUB_BITS + 1) * MFX_TRACE_STAT_HIST_SUB
+        + (mfxTraceU32)((ns >> (exp - MFX_TRACE_STAT_HIST_SUB_BITS)) & (MFX_TRACE_STAT_HIST_SUB - 1));
+}
+
+// middle of the bucket
+static mfxTraceU64 mfx_trace_stat_bucket_value(mfxTraceU32 bucket)
+{
+    if (bucket < MFX_TRACE_STAT_HIST_SUB) return bucket;
+
+    mfxTraceU32 shift = bucket / MFX_TRACE_STAT_HIST_SUB - 1;
+    mfxTraceU64 low = (mfxTraceU64)(MFX_TRACE_STAT_HIST_SUB + bucket % MFX_TRACE_STAT_HIST_SUB) << shift;
+
+    return low + (((mfxTraceU64)1 << shift) >> 1);
+}
+
+static mfxTraceU64 mfx_trace_stat_get_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (mfxTraceU64)ts.tv_sec * 1000000000 + (mfxTraceU64)ts.tv_nsec;
+}
+
+/*------------------------------------------------------------------------------*/
+
+// Histogram of a single thread: only the owner thread adds values, so no atomic
+// read-modify-write is needed; atomics let other threads merge it at any time.
+struct mfxTraceStatHist
+{
+    std::atomic<mfxTraceU64> count;
+    std::atomic<mfxTraceU64> total;
+    std::atomic<mfxTraceU64> min;
+    std::atomic<mfxTraceU64> max;
+    std::atomic<mfxTraceU64> bucket[MFX_TRACE_STAT_HIST_SIZE];
+
+    mfxTraceStatHist() { Reset(); }
+
+    void Reset()
+    {
+        count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        min.store((mfxTraceU64)-1, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+        for (mfxTraceU32 i = 0; i < MFX_TRACE_STAT_HIST_SIZE; ++i)
+            bucket[i].store(0, std::memory_order_relaxed);
+    }
+
+    void Add(mfxTraceU64 ns)
+    {
+        std::atomic<mfxTraceU64>& b = bucket[mfx_trace_stat_bucket(ns)];
+
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total.store(total.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns < min.load(std::memory_order_relaxed)) min.store(ns, std::memory_order_relaxed);
+        if (ns > max.load(std::memory_order_relaxed)) max.store(ns, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// Histogram merged over threads
+struct mfxTraceStatSum
+{
+    mfxTraceU64 count;
+    mfxTraceU64 total;
+    mfxTraceU64 min;
+    mfxTraceU64 max;
+    std::vector<mfxTraceU64> bucket;
+
+    mfxTraceStatSum() : count(0), total(0), min((mfxTraceU64)-1), max(0), bucket(MFX_TRACE_STAT_HIST_SIZE, 0) {}
+
+    void Add(const mfxTraceStatHist& hist)
+    {
+        count += hist.count.load(std::memory_order_relaxed);
+        total += hist.total.load(std::memory_order_relaxed);
+        if (hist.min.load(std::memory_order_relaxed) < min) min = hist.min.load(std::memory_order_relaxed);
+        if (hist.max.load(std::memory_order_relaxed) > max) max = hist.max.load(std::memory_order_relaxed);
+        for (mfxTraceU32 i = 0; i < MFX_TRACE_STAT_HIST_SIZE; ++i)
+            bucket[i] += hist.bucket[i].load(std::memory_order_relaxed);
+    }
+
+    // ns
+    mfxTraceU64 Percentile(double percentile) const
+    {
+        mfxTraceU64 n = 0, sum = 0, rank = 0;
+
+        // buckets are read after count, so they may be ahead of it
+        for (mfxTraceU32 i = 0; i < MFX_TRACE_STAT_HIST_SIZE; ++i) n += bucket[i];
+        if (!n) return 0;
+
+        rank = (mfxTraceU64)ceil(percentile / 100. * (double)n);
+        if (rank < 1) rank = 1;
+        if (rank > n) rank = n;
+
+        for (mfxTraceU32 i = 0; i < MFX_TRACE_STAT_HIST_SIZE; ++i)
+        {
+            sum += bucket[i];
+            if (sum >= rank)
+            {
+                mfxTraceU64 value = mfx_trace_stat_bucket_value(i);
+                if (value < min) value = min;
+                if (value > max) value = max;
+                return value;
+            }
+        }
+        return max;
+    }
+};
+
+// Place of a task in the call tree: same task called from different tasks gets different nodes
+struct mfxTraceStatNode
+{
+    mfxTraceU32  parent;
+    mfxTraceU32  depth;
+    const char*  function_name;
+    std::string  task_name;
+};
+
+struct mfxTraceStatThread
+{
+    std::vector<mfxTraceStatHist*> hist;  // by node id, changed under the tree lock
+    std::map<std::pair<mfxTraceU32, const void*>, mfxTraceU32> nodes; // (parent, static handle) -> node id
+    mfxTraceU32 current;                  // node of the innermost running task
+
+    mfxTraceStatThread() : current(0) {}
+    ~mfxTraceStatThread()
+    {
+        for (size_t i = 0; i < hist.size(); ++i) delete hist[i];
+    }
+};
+
+// Call tree of the traced tasks and histograms of all threads. The lock is taken
+// only when a thread meets a new node, and to merge or reset the histograms.
+class mfxStatLatencyTree
+{
+public:
+    mfxStatLatencyTree() : m_alive(true)
+    {
+        mfxTraceStatNode root = { 0, 0, NULL, std::string() };
+        m_nodes.push_back(root);
+    }
+
+    ~mfxStatLatencyTree()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        for (size_t i = 0; i < m_threads.size(); ++i) delete m_threads[i];
+        m_threads.clear();
+        m_alive = false;
+    }
+
+    mfxTraceStatThread* AddThread()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (!m_alive) return NULL;
+
+        mfxTraceStatThread* thread = new mfxTraceStatThread;
+        m_threads.push_back(thread);
+        return thread;
+    }
+
+    // keeps histograms of the exited thread in m_retired
+    void RemoveThread(mfxTraceStatThread* thread)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        if (!m_alive) return;
+
+        for (size_t i = 0; i < m_threads.size(); ++i)
+        {
+            if (m_threads[i] != thread) continue;
+
+            for (mfxTraceU32 id = 0; id < thread->hist.size(); ++id)
+            {
+                if (!thread->hist[id]) continue;
+                if (!Hist(m_retired, id)) break;
+                Merge(*m_retired.hist[id], *thread->hist[id]);
+            }
+            m_threads.erase(m_threads.begin() + i);
+            delete thread;
+            break;
+        }
+    }
+
+    // returns 0 on allocation failure
+    mfxTraceU32 GetNode(mfxTraceStatThread& thread, mfxTraceU32 parent,
+                        mfxTraceStaticHandle* static_handle,
+                        const char* function_name, const char* task_name)
+    {
+        std::pair<mfxTraceU32, const void*> key(parent, static_handle);
+        std::map<std::pair<mfxTraceU32, const void*>, mfxTraceU32>::iterator it = thread.nodes.find(key);
+
+        if (it != thread.nodes.end()) return it->second;
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        mfxTraceU32 id = 0;
+
+        try
+        {
+            std::map<std::pair<mfxTraceU32, const void*>, mfxTraceU32>::iterator node = m_index.find(key);
+            if (node == m_index.end())
+            {
+                mfxTraceStatNode info = { parent, m_nodes[parent].depth + 1, function_name, task_name ? task_name : "" };
+                m_nodes.push_back(info);
+                node = m_index.insert(std::make_pair(key, (mfxTraceU32)(m_nodes.size() - 1))).first;
+            }
+            id = node->second;
+            if (!Hist(thread, id)) return 0;
+            thread.nodes[key] = id;
+        }
+        catch (...)
+        {
+            return 0;
+        }
+        return id;
+    }
+
+    // for tasks ended on other thread than begun
+    mfxTraceStatHist* GetHist(mfxTraceStatThread& thread, mfxTraceU32 id)
+    {
+        if (id < thread.hist.size() && thread.hist[id]) return thread.hist[id];
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return Hist(thread, id);
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        for (size_t i = 0; i < m_threads.size(); ++i)
+        {
+            for (size_t id = 0; id < m_threads[i]->hist.size(); ++id)
+                if (m_threads[i]->hist[id]) m_threads[i]->hist[id]->Reset();
+        }
+        for (size_t id = 0; id < m_retired.hist.size(); ++id)
+            if (m_retired.hist[id]) m_retired.hist[id]->Reset();
+    }
+
+    // Merges histograms of all threads; nodes without ended tasks are kept only
+    // as parents of nodes with ended tasks. Returns ids in depth-first order.
+    void Collect(std::vector<mfxTraceStatNode>& nodes, std::vector<mfxTraceStatSum>& sums, std::vector<mfxTraceU32>& order)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        nodes.assign(m_nodes.begin(), m_nodes.end());
+        sums.assign(m_nodes.size(), mfxTraceStatSum());
+        order.clear();
+
+        for (size_t i = 0; i <= m_threads.size(); ++i)
+        {
+            mfxTraceStatThread& thread = (i < m_threads.size()) ? *m_threads[i] : m_retired;
+            for (size_t id = 0; id < thread.hist.size(); ++id)
+                if (thread.hist[id]) sums[id].Add(*thread.hist[id]);
+        }
+
+        // parent is always created before its children
+        std::vector<bool> used(m_nodes.size(), false);
+        std::vector<std::vector<mfxTraceU32> > children(m_nodes.size());
+        for (size_t id = m_nodes.size() - 1; id > 0; --id)
+        {
+            if (sums[id].count) used[id] = true;
+            if (used[id]) used[m_nodes[id].parent] = true;
+        }
+        for (size_t id = 1; id < m_nodes.size(); ++id)
+        {
+            if (used[id]) children[m_nodes[id].parent].push_back((mfxTraceU32)id);
+        }
+
+        std::vector<mfxTraceU32> stack(children[0].rbegin(), children[0].rend());
+        while (!stack.empty())
+        {
+            mfxTraceU32 id = stack.back();
+            stack.pop_back();
+            order.push_back(id);
+            stack.insert(stack.end(), children[id].rbegin(), children[id].rend());
+        }
+    }
+
+    // merges histograms of a single node, returns false for unknown node
+    bool Sum(mfxTraceU32 id, mfxTraceStatSum& sum)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        if (!id || id >= m_nodes.size()) return false;
+        for (size_t i = 0; i <= m_threads.size(); ++i)
+        {
+            mfxTraceStatThread& thread = (i < m_threads.size()) ? *m_threads[i] : m_retired;
+            if (id < thread.hist.size() && thread.hist[id]) sum.Add(*thread.hist[id]);
+        }
+        return true;
+    }
+
+    // nodes are never removed, so the name lives until the process exits
+    const char* TaskName(mfxTraceU32 id)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        if (id >= m_nodes.size() || m_nodes[id].task_name.empty()) return NULL;
+        return m_nodes[id].task_name.c_str();
+    }
+
+protected:
+    // should be called under the lock
+    static mfxTraceStatHist* Hist(mfxTraceStatThread& thread, mfxTraceU32 id)
+    {
+        try
+        {
+            if (id >= thread.hist.size()) thread.hist.resize(id + 1, NULL);
+            if (!thread.hist[id]) thread.hist[id] = new mfxTraceStatHist;
+        }
+        catch (...)
+        {
+            return NULL;
+        }
+        return thread.hist[id];
+    }
+
+    static void Merge(mfxTraceStatHist& dst, const mfxTraceStatHist& src)
+    {
+        mfxTraceStatSum sum;
+
+        sum.Add(dst);
+        sum.Add(src);
+        dst.count.store(sum.count, std::memory_order_relaxed);
+        dst.total.store(sum.total, std::memory_order_relaxed);
+        dst.min.store(sum.min, std::memory_order_relaxed);
+        dst.max.store(sum.max, std::memory_order_relaxed);
+        for (mfxTraceU32 i = 0; i < MFX_TRACE_STAT_HIST_SIZE; ++i)
+            dst.bucket[i].store(sum.bucket[i], std::memory_order_relaxed);
+    }
+
+    std::mutex                         m_mtx;
+    bool                               m_alive;
+    std::deque<mfxTraceStatNode>       m_nodes;  // [0] is the root, elements never move
+    std::map<std::pair<mfxTraceU32, const void*>, mfxTraceU32> m_index;
+    std::vector<mfxTraceStatThread*>   m_threads;
+    mfxTraceStatThread                 m_retired; // histograms of exited threads
+};
+
+static mfxStatLatencyTree g_StatLatency;
+
+// registers the thread on the first task and merges its histograms on exit
+struct mfxTraceStatThreadSlot
+{
+    mfxTraceStatThread* thread;
+
+    mfxTraceStatThreadSlot() : thread(g_StatLatency.AddThread()) {}
+    ~mfxTraceStatThreadSlot()
+    {
+        if (thread) g_StatLatency.RemoveThread(thread);
+    }
+};
+
+static mfxTraceStatThread* mfx_trace_stat_get_thread(void)
+{
+    static thread_local mfxTraceStatThreadSlot slot;
+    return slot.thread;
+}
 
 /*------------------------------------------------------------------------------*/
 
+extern "C"
+{
+
 mfxTraceU32 MFXTraceStat_PrintHeader(void);
 mfxTraceU32 MFXTraceStat_PrintInfo(mfxTraceStaticHandle* static_handle);
+mfxTraceU32 MFXTraceStat_PrintLatency(void);
 
 #define FORMAT_FN_NAME    "%-40s: "
 #define FORMAT_TASK_NAME  "%-40s: "
@@ -51,13 +438,15 @@ mfxTraceU32 MFXTraceStat_PrintInfo(mfxTraceStaticHandle* static_handle);
 #define FORMAT_HDR_FILE_NAME FORMAT_FILE_NAME
 #define FORMAT_HDR_LINE_NUM  ": %s"
 
+#define FORMAT_TREE_NAME     "%-40s: "
+#define FORMAT_TREE_STAT     "%6llu, %10.6f, %10.6f, %10.6f, %10.6f, %10.6f"
+#define FORMAT_HDR_TREE_STAT "%6s, %10s, %10s, %10s, %10s, %10s"
+
 /*------------------------------------------------------------------------------*/
 
 typedef mfxTraceU64 mfxTraceTick;
 
 #if defined(LINUX32)
-#include <sys/time.h>
-
 #define MFX_TRACE_TIME_MHZ 1000000
 #endif
 
@@ -68,14 +457,6 @@ static mfxTraceTick mfx_trace_get_frequency(void)
     return (mfxTraceTick)MFX_TRACE_TIME_MHZ;
 }
 
-static mfxTraceTick mfx_trace_get_tick(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (mfxTraceTick)tv.tv_sec * (mfxTraceTick)MFX_TRACE_TIME_MHZ + (mfxTraceTick)tv.tv_usec;
-}
-
 #define mfx_trace_get_time(T,S,F) ((double)(__INT64)((T)-(S))/(double)(__INT64)(F))
 
 /*------------------------------------------------------------------------------*/
@@ -143,6 +524,8 @@ public:
             }
         }
         m_StatTableIndex = 0;
+        MFXTraceStat_PrintLatency();
+        g_StatLatency.Reset();
     };
 
 protected:
@@ -396,6 +779,114 @@ mfxTraceU32 MFXTraceStat_PrintInfo(mfxTraceStaticHandle* static_handle)
 
 /*------------------------------------------------------------------------------*/
 
+mfxTraceU32 MFXTraceStat_PrintLatency(void)
+{
+    if (!g_mfxTraceStatFile) return 1;
+
+    std::vector<mfxTraceStatNode> nodes;
+    std::vector<mfxTraceStatSum> sums;
+    std::vector<mfxTraceU32> order;
+
+    try
+    {
+        g_StatLatency.Collect(nodes, sums, order);
+    }
+    catch (...)
+    {
+        return 1;
+    }
+    if (order.empty()) return 0;
+
+    fprintf(g_mfxTraceStatFile, "\n" FORMAT_TREE_NAME FORMAT_HDR_TREE_STAT "\n",
+            "Task tree", "Number", "p50", "p99", "p99.9", "Max", "Total time");
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const mfxTraceStatNode& node = nodes[order[i]];
+        const mfxTraceStatSum& sum = sums[order[i]];
+        std::string name((node.depth - 1) * 2, ' ');
+
+        name += node.task_name.empty() ? node.function_name : node.task_name;
+        fprintf(g_mfxTraceStatFile, FORMAT_TREE_NAME FORMAT_TREE_STAT "\n",
+                name.c_str(), (unsigned long long)sum.count,
+                sum.Percentile(50.) * 1e-9, sum.Percentile(99.) * 1e-9, sum.Percentile(99.9) * 1e-9,
+                sum.count ? sum.max * 1e-9 : 0., sum.total * 1e-9);
+    }
+    fflush(g_mfxTraceStatFile);
+
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceStat_GetLatency(mfxTraceStatLatency* latency, mfxTraceU32* count)
+{
+    if (!count) return 1;
+
+    std::vector<mfxTraceStatNode> nodes;
+    std::vector<mfxTraceStatSum> sums;
+    std::vector<mfxTraceU32> order;
+
+    try
+    {
+        g_StatLatency.Collect(nodes, sums, order);
+    }
+    catch (...)
+    {
+        return 1;
+    }
+    if (*count < order.size() || (order.size() && !latency))
+    {
+        *count = (mfxTraceU32)order.size();
+        return 1;
+    }
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const mfxTraceStatNode& node = nodes[order[i]];
+        const mfxTraceStatSum& sum = sums[order[i]];
+
+        latency[i].id            = order[i];
+        latency[i].parent        = node.parent;
+        latency[i].depth         = node.depth;
+        latency[i].function_name = node.function_name;
+        latency[i].task_name     = g_StatLatency.TaskName(order[i]);
+        latency[i].count         = sum.count;
+        latency[i].total         = sum.total * 1e-9;
+        latency[i].min           = sum.count ? sum.min * 1e-9 : 0.;
+        latency[i].max           = sum.max * 1e-9;
+        latency[i].p50           = sum.Percentile(50.) * 1e-9;
+        latency[i].p99           = sum.Percentile(99.) * 1e-9;
+        latency[i].p999          = sum.Percentile(99.9) * 1e-9;
+    }
+    *count = (mfxTraceU32)order.size();
+
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceStat_GetPercentile(mfxTraceU32 id, double percentile, double* time)
+{
+    if (!time || !(percentile > 0.) || percentile > 100.) return 1;
+
+    mfxTraceStatSum sum;
+
+    try
+    {
+        if (!g_StatLatency.Sum(id, sum)) return 1;
+    }
+    catch (...)
+    {
+        return 1;
+    }
+    *time = sum.Percentile(percentile) * 1e-9;
+
+    return 0;
+}
+
+/*------------------------------------------------------------------------------*/
+
 mfxTraceU32 MFXTraceStat_BeginTask(mfxTraceStaticHandle *static_handle,
                               const char *file_name, mfxTraceU32 line_num,
                               const char *function_name,
@@ -420,7 +911,21 @@ mfxTraceU32 MFXTraceStat_BeginTask(mfxTraceStaticHandle *static_handle,
         }
         else static_handle->sd4.str = NULL;
     }
-    task_handle->sd1.tick = mfx_trace_get_tick();
+
+    // sd2 keeps the node of the task and of its parent to restore on the task end
+    mfxTraceStatThread* thread = mfx_trace_stat_get_thread();
+    task_handle->sd2.uint64 = 0;
+    if (thread)
+    {
+        mfxTraceU32 parent = thread->current;
+        mfxTraceU32 id = g_StatLatency.GetNode(*thread, parent, static_handle, function_name, task_name);
+        if (id)
+        {
+            task_handle->sd2.uint64 = ((mfxTraceU64)parent << 32) | id;
+            thread->current = id;
+        }
+    }
+    task_handle->sd1.tick = mfx_trace_stat_get_ns();
 
     return 0;
 }
@@ -439,8 +944,22 @@ mfxTraceU32 MFXTraceStat_EndTask(mfxTraceStaticHandle *static_handle,
     category      = static_handle->category;
     level         = static_handle->level;
 
+    mfxTraceU64 end = mfx_trace_stat_get_ns();
+    mfxTraceU64 ns = end - task_handle->sd1.tick;
+    mfxTraceU32 id = (mfxTraceU32)task_handle->sd2.uint64;
+
+    if (id)
+    {
+        mfxTraceStatThread* thread = mfx_trace_stat_get_thread();
+        mfxTraceStatHist* hist = thread ? g_StatLatency.GetHist(*thread, id) : NULL;
+
+        if (hist) hist->Add(ns);
+        if (thread && thread->current == id) thread->current = (mfxTraceU32)(task_handle->sd2.uint64 >> 32);
+    }
+
     ++(static_handle->sd5.uint32);
-    time = mfx_trace_get_tick() - task_handle->sd1.tick;
+    // totals are kept in ticks of mfx_trace_get_frequency()
+    time = end / (1000000000 / mfx_trace_get_frequency()) - task_handle->sd1.tick / (1000000000 / mfx_trace_get_frequency());
     static_handle->sd6.tick += time;
     static_handle->sd7.tick += time*time;
 
@@ -451,5 +970,18 @@ mfxTraceU32 MFXTraceStat_EndTask(mfxTraceStaticHandle *static_handle,
     return 0;
 }
 
+/*------------------------------------------------------------------------------*/
+
+// statistics are collected for tasks only
+mfxTraceU32 MFXTraceStat_Counter(mfxTraceStaticHandle* /*static_handle*/,
+                                 const char* /*file_name*/, mfxTraceU32 /*line_num*/,
+                                 const char* /*function_name*/,
+                                 mfxTraceChar* /*category*/, mfxTraceLevel /*level*/,
+                                 const char* /*counter_name*/, mfxTraceU64 /*value*/)
+{
+    if (!g_mfxTraceStatFile) return 1;
+    return 0;
+}
+
 } // extern "C"
 #endif // #ifdef MFX_TRACE_ENABLE_STAT
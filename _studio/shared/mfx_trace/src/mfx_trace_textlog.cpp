@@ -236,5 +236,20 @@ mfxTraceU32 MFXTraceTextLog_EndTask(mfxTraceStaticHandle *static_handle,
                                        task_name, (task_name)? ": EXIT": "EXIT");
 }
 
+/*------------------------------------------------------------------------------*/
+
+mfxTraceU32 MFXTraceTextLog_Counter(mfxTraceStaticHandle *static_handle,
+                                    const char *file_name, mfxTraceU32 line_num,
+                                    const char *function_name,
+                                    mfxTraceChar* category, mfxTraceLevel level,
+                                    const char *counter_name, mfxTraceU64 value)
+{
+    return MFXTraceTextLog_DebugMessage(static_handle,
+                                       file_name, line_num,
+                                       function_name,
+                                       category, level,
+                                       counter_name, " = %llu", (unsigned long long)value);
+}
+
 } // extern "C"
 #endif // #ifdef MFX_TRACE_ENABLE_TEXTLOG
@@ -182,6 +182,14 @@ mfxU32 mfx_UMC_FrameAllocator::InternalFrameData::DecreaseRef(mfxU32 index)
     return frameRef->m_referenceCounter;
 }
 
+bool mfx_UMC_FrameAllocator::InternalFrameData::IsReferenced(mfxU32 index) const
+{
+    if (!IsValidMID(index))
+        throw std::exception();
+
+    return m_frameDataRefs[index].m_referenceCounter != 0;
+}
+
 void mfx_UMC_FrameAllocator::InternalFrameData::Reset()
 {
     // unlock internal sufraces
@@ -225,7 +233,8 @@ void mfx_UMC_FrameAllocator::InternalFrameData::AddNewFrame(mfx_UMC_FrameAllocat
 
 
 mfx_UMC_FrameAllocator::mfx_UMC_FrameAllocator()
-    : m_curIndex(-1)
+    : m_rescanFreeSurfaces(false)
+    , m_curIndex(-1)
     , m_IsUseExternalFrames(true)
     , m_sfcVideoPostProcessing(false)
     , m_surface_info()
@@ -341,6 +350,8 @@ UMC::Status mfx_UMC_FrameAllocator::InitMfx(UMC::FrameAllocatorParams *,
             // set correct width & height to planes
             frameData.Init(&m_info, (UMC::FrameMemID)i, this);
         }
+
+        ResetFreeSurfaces();
     }
     else
     {
@@ -360,6 +371,11 @@ UMC::Status mfx_UMC_FrameAllocator::Close()
     Reset();
     m_frameDataInternal.Close();
     m_extSurfaces.clear();
+    m_freeSurfaces.clear();
+    m_isInFreeList.clear();
+    m_rescanFreeSurfaces = false;
+    m_memIdIndex[0].clear();
+    m_memIdIndex[1].clear();
     return UMC::UMC_OK;
 }
 
@@ -381,6 +397,8 @@ UMC::Status mfx_UMC_FrameAllocator::Reset()
     mfxStatus sts = MFX_ERR_NONE;
 
     m_frameDataInternal.Reset();
+    ResetFreeSurfaces();
+    m_extSurfaceIndex.clear();
 
     // free external sufraces
     for (mfxU32 i = 0; i < m_extSurfaces.size(); i++)
@@ -672,6 +690,11 @@ UMC::Status mfx_UMC_FrameAllocator::Free(UMC::FrameMemID mid)
     if (sts < MFX_ERR_NONE)
         return UMC::UMC_ERR_FAILED;
 
+    if (!m_frameDataInternal.GetSurface(index).Data.Locked)
+        PushFreeSurface(index);
+    else
+        m_rescanFreeSurfaces = true;
+
     if ((m_IsUseExternalFrames) || (m_sfcVideoPostProcessing))
     {
         if (m_extSurfaces[index].FrameSurface)
@@ -872,6 +895,16 @@ mfxI32 mfx_UMC_FrameAllocator::FindSurface(mfxFrameSurface1 *surf, bool isOpaq)
 
     if (data->MemId && m_IsUseExternalFrames)
     {
+        std::unordered_map<mfxMemId, mfxU32> & memIdIndex = m_memIdIndex[isOpaq ? 1 : 0];
+
+        auto it = memIdIndex.find(data->MemId);
+        if (it != memIdIndex.end() && m_frameDataInternal.IsValidMID(it->second))
+        {
+            mfxMemId memId = m_frameDataInternal.GetSurface(it->second).Data.MemId;
+            if ((isOpaq == true ? memId : m_pCore->MapIdx(memId)) == data->MemId)
+                return it->second;
+        }
+
         mfxMemId sMemId;
         for (mfxU32 i = 0; i < m_frameDataInternal.GetSize(); i++)
         {
@@ -879,15 +912,21 @@ mfxI32 mfx_UMC_FrameAllocator::FindSurface(mfxFrameSurface1 *surf, bool isOpaq)
             sMemId = isOpaq == true ? memId : m_pCore->MapIdx(memId);
             if (sMemId == data->MemId)
             {
+                memIdIndex[data->MemId] = i;
                 return i;
             }
         }
     }
 
+    auto it = m_extSurfaceIndex.find(surf);
+    if (it != m_extSurfaceIndex.end() && it->second < m_extSurfaces.size() && m_extSurfaces[it->second].FrameSurface == surf)
+        return it->second;
+
     for (mfxU32 i = 0; i < m_extSurfaces.size(); i++)
     {
         if (m_extSurfaces[i].FrameSurface == surf)
         {
+            m_extSurfaceIndex[surf] = i;
             return i;
         }
     }
@@ -907,15 +946,53 @@ mfxI32 mfx_UMC_FrameAllocator::FindFreeSurface()
     if (m_curIndex != -1)
         return m_curIndex;
 
+    // surfaces locked after they were queued are dropped here, Free() queues them again
+    while (!m_freeSurfaces.empty())
+    {
+        mfxU32 index = m_freeSurfaces.front();
+        if (m_frameDataInternal.IsValidMID(index) && !m_frameDataInternal.GetSurface(index).Data.Locked)
+            return index;
+
+        m_isInFreeList[index] = false;
+        m_freeSurfaces.pop_front();
+        m_rescanFreeSurfaces = true;
+    }
+
+    // surfaces unlocked bypassing Free() are not queued, look through the whole pool
+    // only if such a surface was released since the last look
+    if (!m_rescanFreeSurfaces)
+        return -1;
+
+    ResetFreeSurfaces();
+
+    return m_freeSurfaces.empty() ? -1 : (mfxI32)m_freeSurfaces.front();
+}
+
+void mfx_UMC_FrameAllocator::ResetFreeSurfaces()
+{
+    m_freeSurfaces.clear();
+    m_isInFreeList.assign(m_frameDataInternal.GetSize(), false);
+    m_rescanFreeSurfaces = false;
+
     for (mfxU32 i = 0; i < m_frameDataInternal.GetSize(); i++)
     {
         if (!m_frameDataInternal.GetSurface(i).Data.Locked)
-        {
-            return i;
-        }
+            PushFreeSurface(i);
+        else if (!m_frameDataInternal.IsReferenced(i))
+            m_rescanFreeSurfaces = true; // locked by someone else than the decoder
     }
+}
 
-    return -1;
+void mfx_UMC_FrameAllocator::PushFreeSurface(mfxU32 index)
+{
+    if (index >= m_isInFreeList.size())
+        m_isInFreeList.resize(index + 1, false);
+
+    if (m_isInFreeList[index])
+        return;
+
+    m_isInFreeList[index] = true;
+    m_freeSurfaces.push_back(index);
 }
 
 mfxFrameSurface1 * mfx_UMC_FrameAllocator::GetInternalSurface(UMC::FrameMemID index)
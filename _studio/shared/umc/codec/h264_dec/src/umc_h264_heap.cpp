@@ -25,6 +25,8 @@
 #include "umc_h264_heap.h"
 #include "umc_h264_dec_defs_dec.h"
 
+#include <atomic>
+
 namespace UMC
 {
 enum
@@ -324,6 +326,39 @@ void RefCounter::DecrementReference()
         Free();
     }
 }
+
+// The cache of the heap which the thread used last
+struct H264HeapCacheSlot
+{
+    uint64_t        heap;
+    H264HeapCache * cache;
+};
+
+static thread_local H264HeapCacheSlot t_heapCacheSlot = { 0, 0 };
+
+uint64_t H264_Heap_Objects::NewId()
+{
+    static std::atomic<uint64_t> lastId(0);
+    return ++lastId;
+}
+
+H264HeapCache & H264_Heap_Objects::GetCache()
+{
+    // a thread using several heaps in turn looks its cache up under the lock
+    if (t_heapCacheSlot.heap != m_id)
+    {
+        AutomaticUMCMutex guard(m_mGuard);
+
+        std::unique_ptr<Cache> & cache = m_caches[std::this_thread::get_id()];
+        if (!cache)
+            cache.reset(new Cache);
+
+        t_heapCacheSlot.heap  = m_id;
+        t_heapCacheSlot.cache = cache.get();
+    }
+
+    return *t_heapCacheSlot.cache;
+}
 } // namespace UMC
 
 #endif // MFX_ENABLE_H264_VIDEO_DECODE
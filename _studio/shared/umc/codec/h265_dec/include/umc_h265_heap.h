@@ -25,6 +25,8 @@
 #define __UMC_H265_HEAP_H
 
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include "umc_mutex.h"
 #include "umc_h265_dec_defs.h"
 #include "umc_media_data.h"
@@ -109,6 +111,7 @@ protected:
 // Item class
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class Heap_Objects;
+struct HeapBin;
 
 class Item
 {
@@ -118,6 +121,8 @@ public:
         , m_Ptr(ptr)
         , m_Size(size)
         , m_isTyped(isTyped)
+        , m_isFree(false)
+        , m_pBin(0)
         , m_heap(heap)
     {
     }
@@ -130,6 +135,8 @@ public:
     void * m_Ptr;
     size_t m_Size;
     bool   m_isTyped;
+    bool   m_isFree;
+    HeapBin * m_pBin;
     Heap_Objects * m_heap;
 
     static Item * Allocate(Heap_Objects * heap, size_t size, bool isTyped = false)
@@ -155,15 +162,58 @@ public:
     }
 };
 
+// Free items of one size and typed-ness. Typed items keep constructed objects,
+// so items are reused for the exact size only.
+struct HeapBin
+{
+    HeapBin()
+        : m_pFirstFree(0)
+        , m_free(0)
+        , m_inUse(0)
+        , m_highWater(0)
+    {
+    }
+
+    Item * m_pFirstFree;
+    size_t m_free;
+    size_t m_inUse;     // items allocated or in a cache of a thread
+    size_t m_highWater; // max of m_inUse since the last trim
+};
+
+// Free items of one thread, newest last. The thread reuses them without locking
+// the heap. Caches belong to the heap, threads find theirs through a thread local
+// slot.
+struct HeapCache
+{
+    enum { SIZE = 32 };
+
+    HeapCache()
+        : m_count(0)
+        , m_frees(0)
+    {
+    }
+
+    Item *   m_items[SIZE];
+    int      m_count;
+    uint32_t m_frees; // frees by the thread since its last trim
+};
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Collection of heap objects
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class Heap_Objects
 {
+    typedef HeapBin   Bin;
+    typedef HeapCache Cache;
+
+    // a thread returns its cached items to the bins and free items above the high
+    // water mark are released every TRIM_PERIOD frees of the thread
+    enum { TRIM_PERIOD = 1024 };
+
 public:
 
     Heap_Objects()
-        : m_pFirstFree(0)
+        : m_id(NewId())
     {
     }
 
@@ -174,44 +224,46 @@ public:
 
     Item * GetItemForAllocation(size_t size, bool typed = false)
     {
-        UMC::AutomaticUMCMutex guard(m_mGuard);
+        Cache & cache = GetCache();
 
-        if (!m_pFirstFree)
+        for (int i = cache.m_count - 1; i >= 0; i--)
         {
-            return 0;
-        }
+            Item * item = cache.m_items[i];
+            if (item->m_Size != size || item->m_isTyped != typed)
+                continue;
 
-        if (m_pFirstFree->m_Size == size && m_pFirstFree->m_isTyped == typed)
-        {
-            Item * ptr = m_pFirstFree;
-            m_pFirstFree = m_pFirstFree->m_pNext;
-            VM_ASSERT(ptr->m_Size == size);
-            return ptr;
+            cache.m_count--;
+            for (; i < cache.m_count; i++)
+                cache.m_items[i] = cache.m_items[i + 1];
+
+            item->m_isFree = false;
+            return item;
         }
 
-        Item * temp = m_pFirstFree;
+        UMC::AutomaticUMCMutex guard(m_mGuard);
 
-        while (temp->m_pNext)
-        {
-            if (temp->m_pNext->m_Size == size && temp->m_pNext->m_isTyped == typed)
-            {
-                Item * ptr = temp->m_pNext;
-                temp->m_pNext = temp->m_pNext->m_pNext;
-                return ptr;
-            }
+        Bin & bin = m_bins[Key(size, typed)];
+        Item * item = bin.m_pFirstFree;
 
-            temp = temp->m_pNext;
+        if (!item)
+        {
+            return 0;
         }
 
-        return 0;
+        bin.m_pFirstFree = item->m_pNext;
+        bin.m_free--;
+        item->m_pNext = 0;
+        item->m_isFree = false;
+        Acquire(bin);
+        return item;
     }
 
     void* Allocate(size_t size, bool isTyped = false)
     {
-        Item * item = GetItemForAllocation(size);
+        Item * item = GetItemForAllocation(size, isTyped);
         if (!item)
         {
-            item = Item::Allocate(this, size, isTyped);
+            item = AllocateItem(size, isTyped);
         }
 
         return item->m_Ptr;
@@ -228,9 +280,10 @@ public:
     {
         Item * item = GetItemForAllocation(sizeof(T), true);
 
+        // not Allocate(), another thread may have freed an item meanwhile
         if (!item)
         {
-            void * ptr = Allocate(sizeof(T), true);
+            void * ptr = AllocateItem(sizeof(T), true)->m_Ptr;
             return new(ptr) T();
         }
 
@@ -247,22 +300,17 @@ public:
         if (!obj)
             return;
 
-        UMC::AutomaticUMCMutex guard(m_mGuard);
         Item * item = (Item *) ((uint8_t*)obj - sizeof(Item));
 
-        // check
-        Item * temp = m_pFirstFree;
-
-        while (temp)
-        {
-            if (temp == item) //was removed yet
-                return;
-
-            temp = temp->m_pNext;
-        }
+        if (item->m_isFree) //was removed yet
+            return;
 
         if (force)
         {
+            UMC::AutomaticUMCMutex guard(m_mGuard);
+            // bins with items in use are never removed
+            VM_ASSERT(item->m_pBin->m_inUse);
+            item->m_pBin->m_inUse--;
             Item::Free(item);
             return;
         }
@@ -275,26 +323,159 @@ public:
             }
         }
 
-        item->m_pNext = m_pFirstFree;
-        m_pFirstFree = item;
+        item->m_isFree = true;
+
+        Cache & cache = GetCache();
+        if (cache.m_count == Cache::SIZE)
+        {
+            UMC::AutomaticUMCMutex guard(m_mGuard);
+            Flush(cache, Cache::SIZE / 2);
+        }
+        cache.m_items[cache.m_count++] = item;
+
+        if (++cache.m_frees >= TRIM_PERIOD)
+            Trim();
     }
 
+    // Returns the items cached by the calling thread to the bins and releases free
+    // items which were not needed since the previous trim, so sizes which are not
+    // used anymore (e.g. after resolution change) go away completely. Objects freed
+    // while still referenced are kept, the last reference frees them again.
+    void Trim()
+    {
+        Cache & cache = GetCache();
+        UMC::AutomaticUMCMutex guard(m_mGuard);
+
+        cache.m_frees = 0;
+        Flush(cache, cache.m_count);
+        FreeItems(Detach(false));
+    }
+
+    // Releases all free items, other threads must not use the heap meanwhile
     void Release()
     {
         UMC::AutomaticUMCMutex guard(m_mGuard);
 
-        while (m_pFirstFree)
+        for (std::unordered_map<std::thread::id, std::unique_ptr<Cache> >::iterator it = m_caches.begin(); it != m_caches.end(); ++it)
+            Flush(*it->second, it->second->m_count);
+        FreeItems(Detach(true));
+    }
+
+private:
+
+    static size_t Key(size_t size, bool typed)
+    {
+        return (size << 1) | (typed ? 1 : 0);
+    }
+
+    static void Acquire(Bin & bin)
+    {
+        bin.m_inUse++;
+        if (bin.m_highWater < bin.m_inUse)
+            bin.m_highWater = bin.m_inUse;
+    }
+
+    static bool IsReferenced(Item * item)
+    {
+        return item->m_isTyped && reinterpret_cast<HeapObject *>(item->m_Ptr)->GetRefCounter();
+    }
+
+    static uint64_t NewId();
+
+    Item * AllocateItem(size_t size, bool isTyped)
+    {
+        Item * item = Item::Allocate(this, size, isTyped);
+
+        UMC::AutomaticUMCMutex guard(m_mGuard);
+        item->m_pBin = &m_bins[Key(size, isTyped)];
+        Acquire(*item->m_pBin);
+        return item;
+    }
+
+    // The cache of the calling thread
+    Cache & GetCache();
+
+    // Moves the oldest items of the cache to their bins, the heap is locked
+    void Flush(Cache & cache, int count)
+    {
+        for (int i = 0; i < count; i++)
         {
-            Item *pTemp = m_pFirstFree->m_pNext;
-            Item::Free(m_pFirstFree);
-            m_pFirstFree = pTemp;
+            Item * item = cache.m_items[i];
+            Bin & bin = *item->m_pBin;
+
+            // bins with items in use are never removed
+            VM_ASSERT(bin.m_inUse);
+            bin.m_inUse--;
+            item->m_pNext = bin.m_pFirstFree;
+            bin.m_pFirstFree = item;
+            bin.m_free++;
         }
+
+        cache.m_count -= count;
+        for (int i = 0; i < cache.m_count; i++)
+            cache.m_items[i] = cache.m_items[i + count];
     }
 
-private:
+    // Unlinks free items to release: all or above the high water mark, except
+    // referenced objects. Items are destroyed after that as destructors may free
+    // other objects to the heap.
+    Item * Detach(bool all)
+    {
+        Item * list = 0;
 
-    Item * m_pFirstFree;
-    UMC::Mutex m_mGuard;
+        for (std::unordered_map<size_t, Bin>::iterator it = m_bins.begin(); it != m_bins.end(); )
+        {
+            Bin & bin = it->second;
+            size_t keep = all ? 0 : bin.m_highWater - bin.m_inUse;
+
+            for (Item ** link = &bin.m_pFirstFree; *link; )
+            {
+                Item * item = *link;
+
+                if (keep)
+                {
+                    keep--;
+                    link = &item->m_pNext;
+                    continue;
+                }
+
+                if (!all && IsReferenced(item))
+                {
+                    link = &item->m_pNext;
+                    continue;
+                }
+
+                *link = item->m_pNext;
+                bin.m_free--;
+                item->m_pNext = list;
+                list = item;
+            }
+
+            bin.m_highWater = bin.m_inUse;
+
+            if (!bin.m_inUse && !bin.m_free)
+                it = m_bins.erase(it);
+            else
+                ++it;
+        }
+
+        return list;
+    }
+
+    static void FreeItems(Item * list)
+    {
+        while (list)
+        {
+            Item *pTemp = list->m_pNext;
+            Item::Free(list);
+            list = pTemp;
+        }
+    }
+
+    const uint64_t m_id;                    // tells the caches of heaps apart
+    std::unordered_map<size_t, Bin> m_bins; // by Key(size, typed)
+    std::unordered_map<std::thread::id, std::unique_ptr<Cache> > m_caches;
+    UMC::Mutex m_mGuard;                    // all but the caches
 };
 
 //*********************************************************************************************/
@@ -25,6 +25,7 @@
 #include "umc_h265_heap.h"
 #include "umc_h265_dec_defs.h"
 #include <cstdarg>
+#include <atomic>
 
 namespace UMC_HEVC_DECODER
 {
@@ -334,5 +335,38 @@ void RefCounter::DecrementReference()
     }
 }
 
+// The cache of the heap which the thread used last
+struct HeapCacheSlot
+{
+    uint64_t        heap;
+    HeapCache * cache;
+};
+
+static thread_local HeapCacheSlot t_heapCacheSlot = { 0, 0 };
+
+uint64_t Heap_Objects::NewId()
+{
+    static std::atomic<uint64_t> lastId(0);
+    return ++lastId;
+}
+
+HeapCache & Heap_Objects::GetCache()
+{
+    // a thread using several heaps in turn looks its cache up under the lock
+    if (t_heapCacheSlot.heap != m_id)
+    {
+        UMC::AutomaticUMCMutex guard(m_mGuard);
+
+        std::unique_ptr<Cache> & cache = m_caches[std::this_thread::get_id()];
+        if (!cache)
+            cache.reset(new Cache);
+
+        t_heapCacheSlot.heap  = m_id;
+        t_heapCacheSlot.cache = cache.get();
+    }
+
+    return *t_heapCacheSlot.cache;
+}
+
 } // namespace UMC_HEVC_DECODER
 #endif // MFX_ENABLE_H265_VIDEO_DECODE
@@ -79,30 +79,30 @@ public:
   uint8_t* GetCCBufferPtr(int thread_id = 0);
   // Get the buffer pointer
   template <class type_t> inline
-  type_t *GetCCBufferPtr(const uint32_t colMCU) const;
+  type_t *GetCCBufferPtr(const uint32_t colMCU, const int thread_id = 0) const;
 
   uint8_t* GetSSBufferPtr(int thread_id = 0);
   // Get the buffer pointer
   template <class type_t> inline
-  type_t *GetSSBufferPtr(const uint32_t colMCU) const;
+  type_t *GetSSBufferPtr(const uint32_t colMCU, const int thread_id = 0) const;
 
   uint8_t* GetLNZBufferPtr(int thread_id = 0);
 
 };
 
 template <class type_t> inline
-type_t *CJPEGColorComponent::GetCCBufferPtr (const uint32_t colMCU) const
+type_t *CJPEGColorComponent::GetCCBufferPtr (const uint32_t colMCU, const int thread_id) const
 {
-  type_t *ptr = (type_t *) m_cc_buf.m_buffer;
+  type_t *ptr = (type_t *) (m_cc_buf.m_buffer + m_cc_bufsize * thread_id);
 
   return (ptr + colMCU * 8 * m_hsampling);
 
 } // type_t *CJPEGColorComponent::GetCCBufferPtr (const uint32_t colMCU) const
 
 template <class type_t> inline
-type_t *CJPEGColorComponent::GetSSBufferPtr(const uint32_t colMCU) const
+type_t *CJPEGColorComponent::GetSSBufferPtr(const uint32_t colMCU, const int thread_id) const
 {
-  type_t *ptr = (type_t *) m_ss_buf.m_buffer;
+  type_t *ptr = (type_t *) (m_ss_buf.m_buffer + m_ss_bufsize * thread_id);
 
   return (ptr + colMCU * 8 * m_hsampling);
 
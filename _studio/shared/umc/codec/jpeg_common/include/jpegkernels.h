@@ -0,0 +1,115 @@
+// Copyright (c) 2019 Intel Corporation
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef __JPEGKERNELS_H__
+#define __JPEGKERNELS_H__
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_DECODE) || defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+#include "ippdefs.h"
+#include "jpegbase.h"
+
+// Pixel packing, transform and color conversion kernels of the software JPEG
+// codec. Implementation (C/SSE4/AVX2) is selected at runtime by the CPU
+// features, all of them give the same output as the IPP functions they replace.
+// roi is given in pixels of the source planes.
+
+enum JPEGKernelsLevel
+{
+  JPEG_KERNELS_C    = 0,
+  JPEG_KERNELS_SSE4 = 1,
+  JPEG_KERNELS_AVX2 = 2
+};
+
+// Limits the runtime selection to maxLevel and returns the level in use.
+// Not thread safe, meant for tests and benchmarks only.
+JPEGKernelsLevel JPEG_SetKernelsLevel(JPEGKernelsLevel maxLevel);
+
+// NV12 chroma: pDst[2*j] = pSrcU[j], pDst[2*j + 1] = pSrcV[j]
+void JPEG_InterleaveUV_8u(
+  const uint8_t* pSrcU,
+  int            srcUStep,
+  const uint8_t* pSrcV,
+  int            srcVStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi);
+
+// gray to B,G,R,A with opaque alpha
+void JPEG_GrayToBGRA_8u(
+  const uint8_t* pSrc,
+  int            srcStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi);
+
+// planar R,G,B to B,G,R,A with opaque alpha
+void JPEG_RGBToBGRA_8u_P3C4R(
+  const uint8_t* pSrc[3],
+  int            srcStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi);
+
+// B,G,R,A to planar R,G,B, alpha is dropped
+void JPEG_BGRAToRGB_8u_C4P3R(
+  const uint8_t* pSrc,
+  int            srcStep,
+  uint8_t*       pDst[3],
+  int            dstStep,
+  mfxSize        roi);
+
+// mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R for numBlocks horizontally adjacent
+// blocks: block n is read from pSrc + 64*n and written to pDst + 8*n
+IppStatus JPEG_DCTQuantInv8x8LS_16s8u_C1R(
+  const int16_t*  pSrc,
+  uint8_t*        pDst,
+  int             dstStep,
+  const uint16_t* pQuantInvTable,
+  int             numBlocks);
+
+// mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R for numBlocks horizontally adjacent
+// blocks: block n is read from pSrc + 8*n and written to pDst + 64*n
+IppStatus JPEG_DCTQuantFwd8x8LS_8u16s_C1R(
+  const uint8_t*  pSrc,
+  int             srcStep,
+  int16_t*        pDst,
+  const uint16_t* pQuantFwdTable,
+  int             numBlocks);
+
+// One row of Y and horizontally 2:1 subsampled Cb, Cr to B,G,R,A with opaque
+// alpha. Chroma is upsampled as mfxiSampleUpRowH2V1_Triangle_JPEG_8u_C1 does,
+// or as mfxiSampleUpRowH2V2_Triangle_JPEG_8u_C1 does when the further chroma
+// rows pCbFar, pCrFar are given (NULL otherwise), and colors are converted as
+// mfxiYCbCrToBGR_JPEG_8u_P3C4R does. chromaWidth (>= 2) samples of the chroma
+// rows are used, width <= 2*chromaWidth pixels are written.
+void JPEG_YCbCrH2ToBGRA_8u_Row(
+  const uint8_t* pY,
+  const uint8_t* pCb,
+  const uint8_t* pCr,
+  const uint8_t* pCbFar,
+  const uint8_t* pCrFar,
+  int            chromaWidth,
+  uint8_t*       pDst,
+  int            width);
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_DECODE || MFX_ENABLE_MJPEG_VIDEO_ENCODE
+#endif // __JPEGKERNELS_H__
@@ -0,0 +1,1019 @@
+// Copyright (c) 2019 Intel Corporation
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_DECODE) || defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+
+#include <immintrin.h>
+#include <algorithm>
+
+#include "ippj.h"
+#include "jpegkernels.h"
+
+// kernels for the newer instruction sets are built regardless of the compiler
+// flags and only called when the CPU reports the support
+#define JPEG_TARGET_AVX2 __attribute__((target("avx2")))
+
+typedef void (*InterleaveUVRowFunc)(const uint8_t* pSrcU, const uint8_t* pSrcV, uint8_t* pDst, int width);
+typedef void (*GrayToBGRARowFunc)(const uint8_t* pSrc, uint8_t* pDst, int width);
+typedef void (*RGBToBGRARowFunc)(const uint8_t* pR, const uint8_t* pG, const uint8_t* pB, uint8_t* pDst, int width);
+typedef void (*BGRAToRGBRowFunc)(const uint8_t* pSrc, uint8_t* pR, uint8_t* pG, uint8_t* pB, int width);
+typedef void (*YCbCrH2ToBGRARowFunc)(const uint8_t* pY, const uint8_t* pCb, const uint8_t* pCr,
+                                     const uint8_t* pCbFar, const uint8_t* pCrFar, int chromaWidth,
+                                     uint8_t* pDst, int width);
+typedef void (*DCTQuantInv2BlocksFunc)(const int16_t* pSrc, uint8_t* pDst, int dstStep, const uint16_t* pQuantInvTable);
+typedef void (*DCTQuantFwd2BlocksFunc)(const uint8_t* pSrc, int srcStep, int16_t* pDst, const uint16_t* pQuantFwdTable);
+
+// fixed point constants of mfxiYCbCrToBGR_JPEG_8u_P3C4R: Y is scaled by 16,
+// Cb and Cr by 128 and only the high 16 bits of the products are kept
+enum
+{
+  JPEG_CC_RCR = 0x2cdd,
+  JPEG_CC_GCR = 0x16da,
+  JPEG_CC_GCB = 0x0b03,
+  JPEG_CC_BCB = 0x38b4,
+  JPEG_CC_R   = 0x0b37,
+  JPEG_CC_G   = 0x0877,
+  JPEG_CC_B   = 0x0e2d
+};
+
+
+static void InterleaveUVRow_C(const uint8_t* pSrcU, const uint8_t* pSrcV, uint8_t* pDst, int width)
+{
+  for(int j = 0; j < width; j++)
+  {
+    pDst[2*j + 0] = pSrcU[j];
+    pDst[2*j + 1] = pSrcV[j];
+  }
+}
+
+static void GrayToBGRARow_C(const uint8_t* pSrc, uint8_t* pDst, int width)
+{
+  for(int j = 0; j < width; j++)
+  {
+    pDst[4*j + 0] = pSrc[j];
+    pDst[4*j + 1] = pSrc[j];
+    pDst[4*j + 2] = pSrc[j];
+    pDst[4*j + 3] = 0xFF;
+  }
+}
+
+static void RGBToBGRARow_C(const uint8_t* pR, const uint8_t* pG, const uint8_t* pB, uint8_t* pDst, int width)
+{
+  for(int j = 0; j < width; j++)
+  {
+    pDst[4*j + 0] = pB[j];
+    pDst[4*j + 1] = pG[j];
+    pDst[4*j + 2] = pR[j];
+    pDst[4*j + 3] = 0xFF;
+  }
+}
+
+static void BGRAToRGBRow_C(const uint8_t* pSrc, uint8_t* pR, uint8_t* pG, uint8_t* pB, int width)
+{
+  for(int j = 0; j < width; j++)
+  {
+    pR[j] = pSrc[4*j + 2];
+    pG[j] = pSrc[4*j + 1];
+    pB[j] = pSrc[4*j + 0];
+  }
+}
+
+static inline uint8_t ClampToU8(int v)
+{
+  return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Chroma of pixel j upsampled by the triangle filter: 3/4 of the nearer and
+// 1/4 of the further sample, horizontally and with pFar also vertically.
+// The samples next to the row ends are repeated.
+static inline int UpSampleH2(const uint8_t* p, const uint8_t* pFar, int chromaWidth, int j)
+{
+  const int c = j >> 1;
+  const int n = (j & 1) ? std::min(c + 1, chromaWidth - 1) : std::max(c - 1, 0);
+
+  if(!pFar)
+    return (3*p[c] + p[n] + 1 + (j & 1)) >> 2;
+
+  return (3*(3*p[c] + pFar[c]) + 3*p[n] + pFar[n] + 8 - (j & 1)) >> 4;
+}
+
+static void YCbCrH2ToBGRAPixels_C(const uint8_t* pY, const uint8_t* pCb, const uint8_t* pCr,
+                                  const uint8_t* pCbFar, const uint8_t* pCrFar, int chromaWidth,
+                                  uint8_t* pDst, int first, int last)
+{
+  for(int j = first; j < last; j++)
+  {
+    const int y  = pY[j] << 4;
+    const int cb = UpSampleH2(pCb, pCbFar, chromaWidth, j) << 7;
+    const int cr = UpSampleH2(pCr, pCrFar, chromaWidth, j) << 7;
+
+    pDst[4*j + 0] = ClampToU8((((cb * JPEG_CC_BCB) >> 16) + y - JPEG_CC_B + 8) >> 4);
+    pDst[4*j + 1] = ClampToU8((y + JPEG_CC_G - ((cb * JPEG_CC_GCB) >> 16) - ((cr * JPEG_CC_GCR) >> 16) + 8) >> 4);
+    pDst[4*j + 2] = ClampToU8((((cr * JPEG_CC_RCR) >> 16) + y - JPEG_CC_R + 8) >> 4);
+    pDst[4*j + 3] = 0xFF;
+  }
+}
+
+static void YCbCrH2ToBGRARow_C(const uint8_t* pY, const uint8_t* pCb, const uint8_t* pCr,
+                               const uint8_t* pCbFar, const uint8_t* pCrFar, int chromaWidth,
+                               uint8_t* pDst, int width)
+{
+  YCbCrH2ToBGRAPixels_C(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, 0, width);
+}
+
+
+static void InterleaveUVRow_SSE4(const uint8_t* pSrcU, const uint8_t* pSrcV, uint8_t* pDst, int width)
+{
+  int j = 0;
+
+  for(; j + 16 <= width; j += 16)
+  {
+    const __m128i u = _mm_loadu_si128((const __m128i*)(pSrcU + j));
+    const __m128i v = _mm_loadu_si128((const __m128i*)(pSrcV + j));
+
+    _mm_storeu_si128((__m128i*)(pDst + 2*j +  0), _mm_unpacklo_epi8(u, v));
+    _mm_storeu_si128((__m128i*)(pDst + 2*j + 16), _mm_unpackhi_epi8(u, v));
+  }
+
+  InterleaveUVRow_C(pSrcU + j, pSrcV + j, pDst + 2*j, width - j);
+}
+
+static void GrayToBGRARow_SSE4(const uint8_t* pSrc, uint8_t* pDst, int width)
+{
+  // replicate each gray byte three times, the 4th byte is taken from alpha
+  const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+  const __m128i mask0 = _mm_setr_epi8( 0,  0,  0, -1,  1,  1,  1, -1,  2,  2,  2, -1,  3,  3,  3, -1);
+  const __m128i mask1 = _mm_setr_epi8( 4,  4,  4, -1,  5,  5,  5, -1,  6,  6,  6, -1,  7,  7,  7, -1);
+  const __m128i mask2 = _mm_setr_epi8( 8,  8,  8, -1,  9,  9,  9, -1, 10, 10, 10, -1, 11, 11, 11, -1);
+  const __m128i mask3 = _mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+  int j = 0;
+
+  for(; j + 16 <= width; j += 16)
+  {
+    const __m128i g = _mm_loadu_si128((const __m128i*)(pSrc + j));
+
+    _mm_storeu_si128((__m128i*)(pDst + 4*j +  0), _mm_or_si128(_mm_shuffle_epi8(g, mask0), alpha));
+    _mm_storeu_si128((__m128i*)(pDst + 4*j + 16), _mm_or_si128(_mm_shuffle_epi8(g, mask1), alpha));
+    _mm_storeu_si128((__m128i*)(pDst + 4*j + 32), _mm_or_si128(_mm_shuffle_epi8(g, mask2), alpha));
+    _mm_storeu_si128((__m128i*)(pDst + 4*j + 48), _mm_or_si128(_mm_shuffle_epi8(g, mask3), alpha));
+  }
+
+  GrayToBGRARow_C(pSrc + j, pDst + 4*j, width - j);
+}
+
+// 16 pixels of R, G, B bytes to B,G,R,A with opaque alpha
+static inline void StoreBGRA_SSE4(__m128i r, __m128i g, __m128i b, uint8_t* pDst)
+{
+  const __m128i alpha = _mm_set1_epi8(-1);
+
+  const __m128i bgLo = _mm_unpacklo_epi8(b, g);
+  const __m128i bgHi = _mm_unpackhi_epi8(b, g);
+  const __m128i raLo = _mm_unpacklo_epi8(r, alpha);
+  const __m128i raHi = _mm_unpackhi_epi8(r, alpha);
+
+  _mm_storeu_si128((__m128i*)(pDst +  0), _mm_unpacklo_epi16(bgLo, raLo));
+  _mm_storeu_si128((__m128i*)(pDst + 16), _mm_unpackhi_epi16(bgLo, raLo));
+  _mm_storeu_si128((__m128i*)(pDst + 32), _mm_unpacklo_epi16(bgHi, raHi));
+  _mm_storeu_si128((__m128i*)(pDst + 48), _mm_unpackhi_epi16(bgHi, raHi));
+}
+
+static void RGBToBGRARow_SSE4(const uint8_t* pR, const uint8_t* pG, const uint8_t* pB, uint8_t* pDst, int width)
+{
+  int j = 0;
+
+  for(; j + 16 <= width; j += 16)
+  {
+    StoreBGRA_SSE4(_mm_loadu_si128((const __m128i*)(pR + j)),
+                   _mm_loadu_si128((const __m128i*)(pG + j)),
+                   _mm_loadu_si128((const __m128i*)(pB + j)),
+                   pDst + 4*j);
+  }
+
+  RGBToBGRARow_C(pR + j, pG + j, pB + j, pDst + 4*j, width - j);
+}
+
+static void BGRAToRGBRow_SSE4(const uint8_t* pSrc, uint8_t* pR, uint8_t* pG, uint8_t* pB, int width)
+{
+  // gathers R0-3, G0-3, B0-3 of 4 pixels into dwords 0, 1 and 2
+  const __m128i mask = _mm_setr_epi8(2, 6, 10, 14, 1, 5, 9, 13, 0, 4, 8, 12, -1, -1, -1, -1);
+  int j = 0;
+
+  for(; j + 16 <= width; j += 16)
+  {
+    const __m128i s0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pSrc + 4*j +  0)), mask);
+    const __m128i s1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pSrc + 4*j + 16)), mask);
+    const __m128i s2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pSrc + 4*j + 32)), mask);
+    const __m128i s3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pSrc + 4*j + 48)), mask);
+
+    const __m128i rg01 = _mm_unpacklo_epi32(s0, s1);
+    const __m128i rg23 = _mm_unpacklo_epi32(s2, s3);
+    const __m128i b01  = _mm_unpackhi_epi32(s0, s1);
+    const __m128i b23  = _mm_unpackhi_epi32(s2, s3);
+
+    _mm_storeu_si128((__m128i*)(pR + j), _mm_unpacklo_epi64(rg01, rg23));
+    _mm_storeu_si128((__m128i*)(pG + j), _mm_unpackhi_epi64(rg01, rg23));
+    _mm_storeu_si128((__m128i*)(pB + j), _mm_unpacklo_epi64(b01, b23));
+  }
+
+  BGRAToRGBRow_C(pSrc + 4*j, pR + j, pG + j, pB + j, width - j);
+}
+
+// Upsampled chroma of the 16 pixels of samples c..c+7, the neighbours c-1
+// and c+8 have to be inside the row.
+static inline void UpSampleH2_SSE4(const uint8_t* p, const uint8_t* pFar, int c, __m128i& lo, __m128i& hi)
+{
+  __m128i cur  = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(p + c)));
+  __m128i prev = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(p + c - 1)));
+  __m128i next = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(p + c + 1)));
+  __m128i even, odd;
+
+  if(pFar)
+  {
+    // column sums 3*near + far
+    cur  = _mm_add_epi16(_mm_mullo_epi16(cur,  _mm_set1_epi16(3)), _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(pFar + c))));
+    prev = _mm_add_epi16(_mm_mullo_epi16(prev, _mm_set1_epi16(3)), _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(pFar + c - 1))));
+    next = _mm_add_epi16(_mm_mullo_epi16(next, _mm_set1_epi16(3)), _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(pFar + c + 1))));
+    cur  = _mm_mullo_epi16(cur, _mm_set1_epi16(3));
+    even = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, prev), _mm_set1_epi16(8)), 4);
+    odd  = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, next), _mm_set1_epi16(7)), 4);
+  }
+  else
+  {
+    cur  = _mm_mullo_epi16(cur, _mm_set1_epi16(3));
+    even = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, prev), _mm_set1_epi16(1)), 2);
+    odd  = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, next), _mm_set1_epi16(2)), 2);
+  }
+
+  lo = _mm_unpacklo_epi16(even, odd);
+  hi = _mm_unpackhi_epi16(even, odd);
+}
+
+// 8 pixels of 16-bit Y, Cb, Cr to R, G, B as mfxiYCbCrToBGR_JPEG_8u_P3C4R does
+static inline void YCbCrToRGB_SSE4(__m128i y, __m128i cb, __m128i cr, __m128i& r, __m128i& g, __m128i& b)
+{
+  const __m128i rnd = _mm_set1_epi16(8);
+
+  y  = _mm_slli_epi16(y,  4);
+  cb = _mm_slli_epi16(cb, 7);
+  cr = _mm_slli_epi16(cr, 7);
+
+  r = _mm_adds_epi16(_mm_mulhi_epi16(cr, _mm_set1_epi16(JPEG_CC_RCR)), y);
+  r = _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(r, _mm_set1_epi16(JPEG_CC_R)), rnd), 4);
+
+  b = _mm_adds_epi16(_mm_mulhi_epi16(cb, _mm_set1_epi16(JPEG_CC_BCB)), y);
+  b = _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(b, _mm_set1_epi16(JPEG_CC_B)), rnd), 4);
+
+  g = _mm_adds_epi16(_mm_mulhi_epi16(cb, _mm_set1_epi16(JPEG_CC_GCB)), _mm_mulhi_epi16(cr, _mm_set1_epi16(JPEG_CC_GCR)));
+  g = _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(_mm_adds_epi16(y, _mm_set1_epi16(JPEG_CC_G)), g), rnd), 4);
+}
+
+static void YCbCrH2ToBGRARow_SSE4(const uint8_t* pY, const uint8_t* pCb, const uint8_t* pCr,
+                                  const uint8_t* pCbFar, const uint8_t* pCrFar, int chromaWidth,
+                                  uint8_t* pDst, int width)
+{
+  // the first sample has no left neighbour
+  int c = 1;
+
+  YCbCrH2ToBGRAPixels_C(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, 0, std::min(2, width));
+
+  for(; c + 8 < chromaWidth && 2*c + 16 <= width; c += 8)
+  {
+    __m128i cbLo, cbHi, crLo, crHi;
+    __m128i r0, g0, b0, r1, g1, b1;
+    const __m128i y = _mm_loadu_si128((const __m128i*)(pY + 2*c));
+
+    UpSampleH2_SSE4(pCb, pCbFar, c, cbLo, cbHi);
+    UpSampleH2_SSE4(pCr, pCrFar, c, crLo, crHi);
+
+    YCbCrToRGB_SSE4(_mm_cvtepu8_epi16(y), cbLo, crLo, r0, g0, b0);
+    YCbCrToRGB_SSE4(_mm_cvtepu8_epi16(_mm_srli_si128(y, 8)), cbHi, crHi, r1, g1, b1);
+
+    StoreBGRA_SSE4(_mm_packus_epi16(r0, r1), _mm_packus_epi16(g0, g1), _mm_packus_epi16(b0, b1), pDst + 8*c);
+  }
+
+  YCbCrH2ToBGRAPixels_C(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, std::min(2*c, width), width);
+}
+
+
+// 256-bit unpacks work within 128-bit lanes. Spreading the source quadwords
+// as 0,2,1,3 first makes unpacklo/unpackhi produce sequential output.
+#define JPEG_SPREAD_LANES(x) _mm256_permute4x64_epi64(x, 0xD8)
+
+static JPEG_TARGET_AVX2 void InterleaveUVRow_AVX2(const uint8_t* pSrcU, const uint8_t* pSrcV, uint8_t* pDst, int width)
+{
+  int j = 0;
+
+  for(; j + 32 <= width; j += 32)
+  {
+    const __m256i u = JPEG_SPREAD_LANES(_mm256_loadu_si256((const __m256i*)(pSrcU + j)));
+    const __m256i v = JPEG_SPREAD_LANES(_mm256_loadu_si256((const __m256i*)(pSrcV + j)));
+
+    _mm256_storeu_si256((__m256i*)(pDst + 2*j +  0), _mm256_unpacklo_epi8(u, v));
+    _mm256_storeu_si256((__m256i*)(pDst + 2*j + 32), _mm256_unpackhi_epi8(u, v));
+  }
+
+  InterleaveUVRow_SSE4(pSrcU + j, pSrcV + j, pDst + 2*j, width - j);
+}
+
+static JPEG_TARGET_AVX2 void GrayToBGRARow_AVX2(const uint8_t* pSrc, uint8_t* pDst, int width)
+{
+  const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+  const __m256i mask0 = _mm256_setr_epi8( 0,  0,  0, -1,  1,  1,  1, -1,  2,  2,  2, -1,  3,  3,  3, -1,
+                                          4,  4,  4, -1,  5,  5,  5, -1,  6,  6,  6, -1,  7,  7,  7, -1);
+  const __m256i mask1 = _mm256_setr_epi8( 8,  8,  8, -1,  9,  9,  9, -1, 10, 10, 10, -1, 11, 11, 11, -1,
+                                         12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+  int j = 0;
+
+  for(; j + 16 <= width; j += 16)
+  {
+    // both lanes see all 16 gray bytes
+    const __m256i g = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pSrc + j)));
+
+    _mm256_storeu_si256((__m256i*)(pDst + 4*j +  0), _mm256_or_si256(_mm256_shuffle_epi8(g, mask0), alpha));
+    _mm256_storeu_si256((__m256i*)(pDst + 4*j + 32), _mm256_or_si256(_mm256_shuffle_epi8(g, mask1), alpha));
+  }
+
+  GrayToBGRARow_C(pSrc + j, pDst + 4*j, width - j);
+}
+
+// 32 pixels of R, G, B bytes to B,G,R,A with opaque alpha, the sources are
+// given with spread lanes (pixels 0-7, 16-23 | 8-15, 24-31)
+static JPEG_TARGET_AVX2 inline void StoreBGRA_AVX2(__m256i r, __m256i g, __m256i b, uint8_t* pDst)
+{
+  const __m256i alpha = _mm256_set1_epi8(-1);
+
+  // B,G and R,A pairs of pixels 0-15 and 16-31
+  const __m256i bgLo = JPEG_SPREAD_LANES(_mm256_unpacklo_epi8(b, g));
+  const __m256i bgHi = JPEG_SPREAD_LANES(_mm256_unpackhi_epi8(b, g));
+  const __m256i raLo = JPEG_SPREAD_LANES(_mm256_unpacklo_epi8(r, alpha));
+  const __m256i raHi = JPEG_SPREAD_LANES(_mm256_unpackhi_epi8(r, alpha));
+
+  _mm256_storeu_si256((__m256i*)(pDst +  0), _mm256_unpacklo_epi16(bgLo, raLo));
+  _mm256_storeu_si256((__m256i*)(pDst + 32), _mm256_unpackhi_epi16(bgLo, raLo));
+  _mm256_storeu_si256((__m256i*)(pDst + 64), _mm256_unpacklo_epi16(bgHi, raHi));
+  _mm256_storeu_si256((__m256i*)(pDst + 96), _mm256_unpackhi_epi16(bgHi, raHi));
+}
+
+static JPEG_TARGET_AVX2 void RGBToBGRARow_AVX2(const uint8_t* pR, const uint8_t* pG, const uint8_t* pB, uint8_t* pDst, int width)
+{
+  int j = 0;
+
+  for(; j + 32 <= width; j += 32)
+  {
+    StoreBGRA_AVX2(JPEG_SPREAD_LANES(_mm256_loadu_si256((const __m256i*)(pR + j))),
+                   JPEG_SPREAD_LANES(_mm256_loadu_si256((const __m256i*)(pG + j))),
+                   JPEG_SPREAD_LANES(_mm256_loadu_si256((const __m256i*)(pB + j))),
+                   pDst + 4*j);
+  }
+
+  RGBToBGRARow_SSE4(pR + j, pG + j, pB + j, pDst + 4*j, width - j);
+}
+
+static JPEG_TARGET_AVX2 void BGRAToRGBRow_AVX2(const uint8_t* pSrc, uint8_t* pR, uint8_t* pG, uint8_t* pB, int width)
+{
+  const __m256i mask  = _mm256_setr_epi8(2, 6, 10, 14, 1, 5, 9, 13, 0, 4, 8, 12, -1, -1, -1, -1,
+                                         2, 6, 10, 14, 1, 5, 9, 13, 0, 4, 8, 12, -1, -1, -1, -1);
+  // dwords come out as pixels 0-3, 8-11, 16-19, 24-27 | 4-7, 12-15, 20-23, 28-31
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  int j = 0;
+
+  for(; j + 32 <= width; j += 32)
+  {
+    const __m256i s0 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pSrc + 4*j +  0)), mask);
+    const __m256i s1 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pSrc + 4*j + 32)), mask);
+    const __m256i s2 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pSrc + 4*j + 64)), mask);
+    const __m256i s3 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pSrc + 4*j + 96)), mask);
+
+    const __m256i rg01 = _mm256_unpacklo_epi32(s0, s1);
+    const __m256i rg23 = _mm256_unpacklo_epi32(s2, s3);
+    const __m256i b01  = _mm256_unpackhi_epi32(s0, s1);
+    const __m256i b23  = _mm256_unpackhi_epi32(s2, s3);
+
+    _mm256_storeu_si256((__m256i*)(pR + j), _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(rg01, rg23), order));
+    _mm256_storeu_si256((__m256i*)(pG + j), _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(rg01, rg23), order));
+    _mm256_storeu_si256((__m256i*)(pB + j), _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(b01, b23), order));
+  }
+
+  BGRAToRGBRow_SSE4(pSrc + 4*j, pR + j, pG + j, pB + j, width - j);
+}
+
+// Upsampled chroma of the 32 pixels of samples c..c+15 as pixels 0-15 and
+// 16-31, the neighbours c-1 and c+16 have to be inside the row.
+static JPEG_TARGET_AVX2 inline void UpSampleH2_AVX2(const uint8_t* p, const uint8_t* pFar, int c, __m256i& lo, __m256i& hi)
+{
+  __m256i cur  = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(p + c)));
+  __m256i prev = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(p + c - 1)));
+  __m256i next = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(p + c + 1)));
+  __m256i even, odd;
+
+  if(pFar)
+  {
+    // column sums 3*near + far
+    cur  = _mm256_add_epi16(_mm256_mullo_epi16(cur,  _mm256_set1_epi16(3)), _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pFar + c))));
+    prev = _mm256_add_epi16(_mm256_mullo_epi16(prev, _mm256_set1_epi16(3)), _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pFar + c - 1))));
+    next = _mm256_add_epi16(_mm256_mullo_epi16(next, _mm256_set1_epi16(3)), _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pFar + c + 1))));
+    cur  = _mm256_mullo_epi16(cur, _mm256_set1_epi16(3));
+    even = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(cur, prev), _mm256_set1_epi16(8)), 4);
+    odd  = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(cur, next), _mm256_set1_epi16(7)), 4);
+  }
+  else
+  {
+    cur  = _mm256_mullo_epi16(cur, _mm256_set1_epi16(3));
+    even = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(cur, prev), _mm256_set1_epi16(1)), 2);
+    odd  = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(cur, next), _mm256_set1_epi16(2)), 2);
+  }
+
+  // unpacks give pixels 0-7, 16-23 and 8-15, 24-31
+  const __m256i p0 = _mm256_unpacklo_epi16(even, odd);
+  const __m256i p1 = _mm256_unpackhi_epi16(even, odd);
+
+  lo = _mm256_permute2x128_si256(p0, p1, 0x20);
+  hi = _mm256_permute2x128_si256(p0, p1, 0x31);
+}
+
+// 16 pixels of 16-bit Y, Cb, Cr to R, G, B as mfxiYCbCrToBGR_JPEG_8u_P3C4R does
+static JPEG_TARGET_AVX2 inline void YCbCrToRGB_AVX2(__m256i y, __m256i cb, __m256i cr, __m256i& r, __m256i& g, __m256i& b)
+{
+  const __m256i rnd = _mm256_set1_epi16(8);
+
+  y  = _mm256_slli_epi16(y,  4);
+  cb = _mm256_slli_epi16(cb, 7);
+  cr = _mm256_slli_epi16(cr, 7);
+
+  r = _mm256_adds_epi16(_mm256_mulhi_epi16(cr, _mm256_set1_epi16(JPEG_CC_RCR)), y);
+  r = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_subs_epi16(r, _mm256_set1_epi16(JPEG_CC_R)), rnd), 4);
+
+  b = _mm256_adds_epi16(_mm256_mulhi_epi16(cb, _mm256_set1_epi16(JPEG_CC_BCB)), y);
+  b = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_subs_epi16(b, _mm256_set1_epi16(JPEG_CC_B)), rnd), 4);
+
+  g = _mm256_adds_epi16(_mm256_mulhi_epi16(cb, _mm256_set1_epi16(JPEG_CC_GCB)), _mm256_mulhi_epi16(cr, _mm256_set1_epi16(JPEG_CC_GCR)));
+  g = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_subs_epi16(_mm256_adds_epi16(y, _mm256_set1_epi16(JPEG_CC_G)), g), rnd), 4);
+}
+
+static JPEG_TARGET_AVX2 void YCbCrH2ToBGRARow_AVX2(const uint8_t* pY, const uint8_t* pCb, const uint8_t* pCr,
+                                                   const uint8_t* pCbFar, const uint8_t* pCrFar, int chromaWidth,
+                                                   uint8_t* pDst, int width)
+{
+  // the first sample has no left neighbour
+  int c = 1;
+
+  YCbCrH2ToBGRAPixels_C(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, 0, std::min(2, width));
+
+  for(; c + 16 < chromaWidth && 2*c + 32 <= width; c += 16)
+  {
+    __m256i cbLo, cbHi, crLo, crHi;
+    __m256i r0, g0, b0, r1, g1, b1;
+
+    UpSampleH2_AVX2(pCb, pCbFar, c, cbLo, cbHi);
+    UpSampleH2_AVX2(pCr, pCrFar, c, crLo, crHi);
+
+    YCbCrToRGB_AVX2(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pY + 2*c))),      cbLo, crLo, r0, g0, b0);
+    YCbCrToRGB_AVX2(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pY + 2*c + 16))), cbHi, crHi, r1, g1, b1);
+
+    // in-lane packs leave the bytes with spread lanes
+    StoreBGRA_AVX2(_mm256_packus_epi16(r0, r1), _mm256_packus_epi16(g0, g1), _mm256_packus_epi16(b0, b1), pDst + 8*c);
+  }
+
+  YCbCrH2ToBGRAPixels_C(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, std::min(2*c, width), width);
+}
+
+
+// The transforms below run the SSE2 sequences of the IPP 8x8 DCT for two
+// horizontally adjacent blocks at once, one block per 128-bit lane. None of
+// the steps crosses lanes, so the output is exactly the one of IPP.
+
+#define JPEG_SHUF_2020 0x88
+#define JPEG_SHUF_3131 0xDD
+#define JPEG_SHUF_1032 0x4E
+#define JPEG_SHUF_0123 0x1B
+
+#define JPEG_BROADCAST_ROW(p) _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(p)))
+
+static const int16_t tg_1_16  =  13036;
+static const int16_t tg_2_16  =  27146;
+static const int16_t tg_3_16  = -21746;
+static const int16_t cos_4_16 = -19195;
+static const int16_t ocos_4_16 = 23170;
+
+// inverse row transform: tables and rounding of rows 0-7 (pjdecdctcn.c)
+static const int16_t tab_i_04[32] =
+{ 16384,  21407,  16384,   8867, -16384,  21407,  16384,  -8867,
+  16384,  -8867,  16384, -21407,  16384,   8867, -16384, -21407,
+  22725,  19266,  19266,  -4520,   4520,  19266,  19266, -22725,
+  12873, -22725,   4520, -12873,  12873,   4520, -22725, -12873 };
+static const int16_t tab_i_17[32] =
+{ 22725,  29692,  22725,  12299, -22725,  29692,  22725, -12299,
+  22725, -12299,  22725, -29692,  22725,  12299, -22725, -29692,
+  31521,  26722,  26722,  -6270,   6270,  26722,  26722, -31521,
+  17855, -31521,   6270, -17855,  17855,   6270, -31521, -17855 };
+static const int16_t tab_i_26[32] =
+{ 21407,  27969,  21407,  11585, -21407,  27969,  21407, -11585,
+  21407, -11585,  21407, -27969,  21407,  11585, -21407, -27969,
+  29692,  25172,  25172,  -5906,   5906,  25172,  25172, -29692,
+  16819, -29692,   5906, -16819,  16819,   5906, -29692, -16819 };
+static const int16_t tab_i_35[32] =
+{ 19266,  25172,  19266,  10426, -19266,  25172,  19266, -10426,
+  19266, -10426,  19266, -25172,  19266,  10426, -19266, -25172,
+  26722,  22654,  22654,  -5315,   5315,  22654,  22654, -26722,
+  15137, -26722,   5315, -15137,  15137,   5315, -26722, -15137 };
+
+static const int16_t* const tab_i[8] = { tab_i_04, tab_i_17, tab_i_26, tab_i_35, tab_i_04, tab_i_35, tab_i_26, tab_i_17 };
+static const int32_t round_i[8] = { 65536, 2901, 2260, 1704, 1024, 455, 512, 373 };
+
+// forward row transform: tables of the row pairs 0-4, 1-7, 2-6 and 3-5 (pidct88im7as.s)
+static const int16_t tab_f_04[32] =
+{ 16384,  16384,  22725,  19266,  -8867, -21407, -22725, -12873,
+  16384,  16384,  12873,   4520,  21407,   8867,  19266,  -4520,
+  16384, -16384,  12873, -22725,  21407,  -8867,  19266, -22725,
+ -16384,  16384,   4520,  19266,   8867, -21407,   4520, -12873 };
+static const int16_t tab_f_17[32] =
+{ 22725,  22725,  31521,  26722, -12299, -29692, -31521, -17855,
+  22725,  22725,  17855,   6270,  29692,  12299,  26722,  -6270,
+  22725, -22725,  17855, -31521,  29692, -12299,  26722, -31521,
+ -22725,  22725,   6270,  26722,  12299, -29692,   6270, -17855 };
+static const int16_t tab_f_26[32] =
+{ 21407,  21407,  29692,  25172, -11585, -27969, -29692, -16819,
+  21407,  21407,  16819,   5906,  27969,  11585,  25172,  -5906,
+  21407, -21407,  16819, -29692,  27969, -11585,  25172, -29692,
+ -21407,  21407,   5906,  25172,  11585, -27969,   5906, -16819 };
+static const int16_t tab_f_35[32] =
+{ 19266,  19266,  26722,  22654, -10426, -25172, -26722, -15137,
+  19266,  19266,  15137,   5315,  25172,  10426,  22654,  -5315,
+  19266, -19266,  15137, -26722,  25172, -10426,  22654, -26722,
+ -19266,  19266,   5315,  22654,  10426, -25172,   5315, -15137 };
+
+static JPEG_TARGET_AVX2 inline __m256i DCTInvRow_AVX2(__m256i x, const int16_t* tab, int32_t round)
+{
+  const __m256i xe = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, JPEG_SHUF_2020), JPEG_SHUF_2020);
+  const __m256i xo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, JPEG_SHUF_3131), JPEG_SHUF_3131);
+
+  const __m256i t1e = _mm256_add_epi32(_mm256_madd_epi16(xe, JPEG_BROADCAST_ROW(tab + 0)), _mm256_set1_epi32(round));
+  const __m256i t2e = _mm256_shuffle_epi32(_mm256_madd_epi16(xe, JPEG_BROADCAST_ROW(tab + 8)), JPEG_SHUF_1032);
+  const __m256i t1o = _mm256_madd_epi16(xo, JPEG_BROADCAST_ROW(tab + 16));
+  const __m256i t2o = _mm256_shuffle_epi32(_mm256_madd_epi16(xo, JPEG_BROADCAST_ROW(tab + 24)), JPEG_SHUF_1032);
+
+  const __m256i a0 = _mm256_add_epi32(t1e, t2e);
+  const __m256i b0 = _mm256_add_epi32(t1o, t2o);
+
+  const __m256i s0 = _mm256_srai_epi32(_mm256_add_epi32(a0, b0), 11);
+  const __m256i s1 = _mm256_srai_epi32(_mm256_sub_epi32(a0, b0), 11);
+
+  return _mm256_shufflehi_epi16(_mm256_packs_epi32(s0, s1), JPEG_SHUF_0123);
+}
+
+static JPEG_TARGET_AVX2 void DCTQuantInv2Blocks_AVX2(const int16_t* pSrc, uint8_t* pDst, int dstStep, const uint16_t* pQuantInvTable)
+{
+  __m256i x[8];
+
+  // rows, dequantized
+  for(int i = 0; i < 8; i++)
+  {
+    const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(pSrc + 8*i))),
+                                              _mm_loadu_si128((const __m128i*)(pSrc + 64 + 8*i)), 1);
+
+    x[i] = DCTInvRow_AVX2(_mm256_mullo_epi16(v, JPEG_BROADCAST_ROW(pQuantInvTable + 8*i)), tab_i[i], round_i[i]);
+  }
+
+  // columns
+  const __m256i tg1  = _mm256_set1_epi16(tg_1_16);
+  const __m256i tg2  = _mm256_set1_epi16(tg_2_16);
+  const __m256i tg3  = _mm256_set1_epi16(tg_3_16);
+  const __m256i cos4 = _mm256_set1_epi16(cos_4_16);
+
+  __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+  __m256i tp03, tm03, tp12, tm12, tp65, tm65, tp465, tm465, tp765, tm765;
+
+  t3    = _mm256_adds_epi16(_mm256_mulhi_epi16(x[3], tg3), x[3]);
+  t5    = _mm256_adds_epi16(_mm256_mulhi_epi16(x[5], tg3), x[5]);
+  tm765 = _mm256_adds_epi16(t5, x[3]);
+  tm465 = _mm256_subs_epi16(x[5], t3);
+
+  t1    = _mm256_mulhi_epi16(x[1], tg1);
+  t7    = _mm256_mulhi_epi16(x[7], tg1);
+  tp765 = _mm256_adds_epi16(x[1], t7);
+  tp465 = _mm256_subs_epi16(t1, x[7]);
+
+  t7    = _mm256_adds_epi16(tp765, tm765);
+  tp65  = _mm256_subs_epi16(tp765, tm765);
+  t4    = _mm256_adds_epi16(tp465, tm465);
+  tm65  = _mm256_subs_epi16(tp465, tm465);
+
+  t2    = _mm256_mulhi_epi16(x[2], tg2);
+  t6    = _mm256_mulhi_epi16(x[6], tg2);
+  tm03  = _mm256_adds_epi16(x[2], t6);
+  tm12  = _mm256_subs_epi16(t2, x[6]);
+
+  t5    = _mm256_subs_epi16(tp65, tm65);
+  t6    = _mm256_adds_epi16(tp65, tm65);
+  t5    = _mm256_adds_epi16(_mm256_mulhi_epi16(t5, cos4), t5);
+  t6    = _mm256_adds_epi16(_mm256_mulhi_epi16(t6, cos4), t6);
+
+  tp03  = _mm256_adds_epi16(x[0], x[4]);
+  tp12  = _mm256_subs_epi16(x[0], x[4]);
+
+  t0    = _mm256_adds_epi16(tp03, tm03);
+  t3    = _mm256_subs_epi16(tp03, tm03);
+  t1    = _mm256_adds_epi16(tp12, tm12);
+  t2    = _mm256_subs_epi16(tp12, tm12);
+
+  const __m256i y[8] =
+  {
+    _mm256_adds_epi16(t0, t7),
+    _mm256_adds_epi16(t1, t6),
+    _mm256_adds_epi16(t2, t5),
+    _mm256_adds_epi16(t3, t4),
+    _mm256_subs_epi16(t3, t4),
+    _mm256_subs_epi16(t2, t5),
+    _mm256_subs_epi16(t1, t6),
+    _mm256_subs_epi16(t0, t7)
+  };
+
+  // level shift, each pair of rows is packed as block 0, 1 of the first row
+  // then block 0, 1 of the second one
+  const __m256i shift = _mm256_set1_epi16(128);
+
+  for(int i = 0; i < 8; i += 2)
+  {
+    const __m256i r0 = _mm256_add_epi16(_mm256_srai_epi16(y[i],     6), shift);
+    const __m256i r1 = _mm256_add_epi16(_mm256_srai_epi16(y[i + 1], 6), shift);
+    const __m256i rows = _mm256_permute4x64_epi64(_mm256_packus_epi16(r0, r1), 0xD8);
+
+    _mm_storeu_si128((__m128i*)(pDst + i*dstStep),       _mm256_castsi256_si128(rows));
+    _mm_storeu_si128((__m128i*)(pDst + (i + 1)*dstStep), _mm256_extracti128_si256(rows, 1));
+  }
+}
+
+static JPEG_TARGET_AVX2 inline void DCTFwdRows_AVX2(__m256i a, __m256i b, const int16_t* tab, __m256i& outA, __m256i& outB)
+{
+  const __m256i rnd = _mm256_set1_epi32(1 << 19);
+  const __m256i t0  = JPEG_BROADCAST_ROW(tab + 0);
+  const __m256i t1  = JPEG_BROADCAST_ROW(tab + 8);
+  const __m256i t2  = JPEG_BROADCAST_ROW(tab + 16);
+  const __m256i t3  = JPEG_BROADCAST_ROW(tab + 24);
+
+  const __m256i lo = _mm256_unpacklo_epi64(a, b);
+  const __m256i hi = _mm256_unpackhi_epi64(a, b);
+  const __m256i s  = _mm256_adds_epi16(lo, hi);
+  const __m256i d  = _mm256_subs_epi16(lo, hi);
+
+  const __m256i x0 = _mm256_unpacklo_epi32(s, d);
+  const __m256i x4 = _mm256_unpackhi_epi32(s, d);
+  const __m256i x2 = _mm256_shuffle_epi32(x0, 78);
+  const __m256i x6 = _mm256_shuffle_epi32(x4, 78);
+
+  outA = _mm256_packs_epi32(
+           _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_madd_epi16(x0, t0), rnd), _mm256_madd_epi16(x2, t1)), 20),
+           _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_madd_epi16(x0, t2), rnd), _mm256_madd_epi16(x2, t3)), 20));
+  outB = _mm256_packs_epi32(
+           _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_madd_epi16(x4, t0), rnd), _mm256_madd_epi16(x6, t1)), 20),
+           _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_madd_epi16(x4, t2), rnd), _mm256_madd_epi16(x6, t3)), 20));
+}
+
+// mfxownsMul_16u16s_PosSfs with scale factor 15: the product is shifted
+// with rounding of the halves to even
+static JPEG_TARGET_AVX2 inline __m256i QuantFwd_AVX2(__m256i x, __m256i q)
+{
+  const __m256i ones  = _mm256_set1_epi16(1);
+  const __m256i one32 = _mm256_set1_epi32(1);
+  const __m256i rnd   = _mm256_set1_epi32(((1 << 14) - 1) >> 1);
+  const __m256i zero  = _mm256_setzero_si256();
+
+  // (q*x) >> 1 as (q >> 1)*x + (q & 1)*(x >> 1), the dropped bit separately
+  const __m256i qh = _mm256_srli_epi16(q, 1);
+  const __m256i ql = _mm256_and_si256(q, ones);
+  const __m256i xh = _mm256_srai_epi16(x, 1);
+  const __m256i bit = _mm256_and_si256(ql, x);
+
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(qh, ql), _mm256_unpacklo_epi16(x, xh));
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(qh, ql), _mm256_unpackhi_epi16(x, xh));
+
+  const __m256i bitLo = _mm256_or_si256(_mm256_unpacklo_epi16(bit, zero), _mm256_and_si256(_mm256_srli_epi32(lo, 14), one32));
+  const __m256i bitHi = _mm256_or_si256(_mm256_unpackhi_epi16(bit, zero), _mm256_and_si256(_mm256_srli_epi32(hi, 14), one32));
+
+  lo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(lo, rnd), bitLo), 14);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(hi, rnd), bitHi), 14);
+
+  return _mm256_packs_epi32(lo, hi);
+}
+
+static JPEG_TARGET_AVX2 void DCTQuantFwd2Blocks_AVX2(const uint8_t* pSrc, int srcStep, int16_t* pDst, const uint16_t* pQuantFwdTable)
+{
+  __m256i r[8];
+
+  // level shift
+  for(int i = 0; i < 8; i++)
+  {
+    r[i] = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pSrc + i*srcStep))), _mm256_set1_epi16(128));
+  }
+
+  // columns
+  const __m256i tg1   = _mm256_set1_epi16(tg_1_16);
+  const __m256i tg2   = _mm256_set1_epi16(tg_2_16);
+  const __m256i tg3   = _mm256_set1_epi16(tg_3_16);
+  const __m256i ocos4 = _mm256_set1_epi16(ocos_4_16);
+  const __m256i one   = _mm256_set1_epi16(1);
+
+  const __m256i p16 = _mm256_slli_epi16(_mm256_adds_epi16(r[1], r[6]), 3);
+  const __m256i p25 = _mm256_slli_epi16(_mm256_adds_epi16(r[2], r[5]), 3);
+  const __m256i p07 = _mm256_adds_epi16(r[0], r[7]);
+  const __m256i p34 = _mm256_adds_epi16(r[3], r[4]);
+
+  const __m256i a = _mm256_subs_epi16(p16, p25);
+  const __m256i b = _mm256_adds_epi16(p16, p25);
+  const __m256i c = _mm256_slli_epi16(_mm256_subs_epi16(p07, p34), 3);
+  const __m256i d = _mm256_slli_epi16(_mm256_adds_epi16(p07, p34), 3);
+
+  const __m256i e = _mm256_slli_epi16(_mm256_subs_epi16(r[1], r[6]), 4);
+  const __m256i f = _mm256_slli_epi16(_mm256_subs_epi16(r[2], r[5]), 4);
+  const __m256i g = _mm256_slli_epi16(_mm256_subs_epi16(r[3], r[4]), 3);
+  const __m256i j = _mm256_slli_epi16(_mm256_subs_epi16(r[0], r[7]), 3);
+
+  const __m256i h  = _mm256_or_si256(_mm256_mulhi_epi16(_mm256_adds_epi16(e, f), ocos4), one);
+  const __m256i ef = _mm256_mulhi_epi16(_mm256_subs_epi16(e, f), ocos4);
+  const __m256i k  = _mm256_subs_epi16(g, ef);
+  const __m256i ii = _mm256_adds_epi16(g, ef);
+  const __m256i l  = _mm256_subs_epi16(j, h);
+  const __m256i m  = _mm256_adds_epi16(j, h);
+
+  __m256i col[8];
+
+  col[0] = _mm256_adds_epi16(d, b);
+  col[4] = _mm256_subs_epi16(d, b);
+  col[2] = _mm256_or_si256(_mm256_adds_epi16(_mm256_mulhi_epi16(a, tg2), c), one);
+  col[6] = _mm256_or_si256(_mm256_subs_epi16(_mm256_mulhi_epi16(c, tg2), a), one);
+  col[1] = _mm256_or_si256(_mm256_adds_epi16(_mm256_mulhi_epi16(ii, tg1), m), one);
+  col[3] = _mm256_subs_epi16(l, _mm256_adds_epi16(_mm256_mulhi_epi16(k, tg3), k));
+  col[5] = _mm256_adds_epi16(_mm256_adds_epi16(_mm256_mulhi_epi16(l, tg3), l), k);
+  col[7] = _mm256_subs_epi16(_mm256_mulhi_epi16(m, tg1), ii);
+
+  for(int n = 0; n < 8; n++)
+  {
+    col[n] = _mm256_shufflehi_epi16(col[n], JPEG_SHUF_0123);
+  }
+
+  // rows
+  __m256i row[8];
+
+  DCTFwdRows_AVX2(col[0], col[4], tab_f_04, row[0], row[4]);
+  DCTFwdRows_AVX2(col[1], col[7], tab_f_17, row[1], row[7]);
+  DCTFwdRows_AVX2(col[2], col[6], tab_f_26, row[2], row[6]);
+  DCTFwdRows_AVX2(col[3], col[5], tab_f_35, row[3], row[5]);
+
+  // quantization, block 0 goes to pDst, block 1 to pDst + 64
+  for(int n = 0; n < 8; n++)
+  {
+    const __m256i q = QuantFwd_AVX2(row[n], JPEG_BROADCAST_ROW(pQuantFwdTable + 8*n));
+
+    _mm_storeu_si128((__m128i*)(pDst + 8*n),      _mm256_castsi256_si128(q));
+    _mm_storeu_si128((__m128i*)(pDst + 64 + 8*n), _mm256_extracti128_si256(q, 1));
+  }
+}
+
+#undef JPEG_BROADCAST_ROW
+#undef JPEG_SHUF_0123
+#undef JPEG_SHUF_1032
+#undef JPEG_SHUF_3131
+#undef JPEG_SHUF_2020
+
+#undef JPEG_SPREAD_LANES
+
+
+struct JPEGKernelsDispatcher
+{
+  InterleaveUVRowFunc    InterleaveUVRow;
+  GrayToBGRARowFunc      GrayToBGRARow;
+  RGBToBGRARowFunc       RGBToBGRARow;
+  BGRAToRGBRowFunc       BGRAToRGBRow;
+  YCbCrH2ToBGRARowFunc   YCbCrH2ToBGRARow;
+  // NULL when IPP is used block by block
+  DCTQuantInv2BlocksFunc DCTQuantInv2Blocks;
+  DCTQuantFwd2BlocksFunc DCTQuantFwd2Blocks;
+  JPEGKernelsLevel       level;
+
+  JPEGKernelsDispatcher()
+  {
+    Select(JPEG_KERNELS_AVX2);
+  }
+
+  void Select(JPEGKernelsLevel maxLevel)
+  {
+    InterleaveUVRow    = InterleaveUVRow_C;
+    GrayToBGRARow      = GrayToBGRARow_C;
+    RGBToBGRARow       = RGBToBGRARow_C;
+    BGRAToRGBRow       = BGRAToRGBRow_C;
+    YCbCrH2ToBGRARow   = YCbCrH2ToBGRARow_C;
+    DCTQuantInv2Blocks = NULL;
+    DCTQuantFwd2Blocks = NULL;
+    level              = JPEG_KERNELS_C;
+
+    if(maxLevel >= JPEG_KERNELS_AVX2 && __builtin_cpu_supports("avx2"))
+    {
+      InterleaveUVRow    = InterleaveUVRow_AVX2;
+      GrayToBGRARow      = GrayToBGRARow_AVX2;
+      RGBToBGRARow       = RGBToBGRARow_AVX2;
+      BGRAToRGBRow       = BGRAToRGBRow_AVX2;
+      YCbCrH2ToBGRARow   = YCbCrH2ToBGRARow_AVX2;
+      DCTQuantInv2Blocks = DCTQuantInv2Blocks_AVX2;
+      DCTQuantFwd2Blocks = DCTQuantFwd2Blocks_AVX2;
+      level              = JPEG_KERNELS_AVX2;
+      return;
+    }
+
+    if(maxLevel >= JPEG_KERNELS_SSE4 && __builtin_cpu_supports("sse4.1"))
+    {
+      InterleaveUVRow    = InterleaveUVRow_SSE4;
+      GrayToBGRARow      = GrayToBGRARow_SSE4;
+      RGBToBGRARow       = RGBToBGRARow_SSE4;
+      BGRAToRGBRow       = BGRAToRGBRow_SSE4;
+      YCbCrH2ToBGRARow   = YCbCrH2ToBGRARow_SSE4;
+      level              = JPEG_KERNELS_SSE4;
+    }
+  }
+};
+
+static JPEGKernelsDispatcher& GetDispatcher()
+{
+  static JPEGKernelsDispatcher dispatcher;
+  return dispatcher;
+}
+
+
+JPEGKernelsLevel JPEG_SetKernelsLevel(JPEGKernelsLevel maxLevel)
+{
+  JPEGKernelsDispatcher& dispatcher = GetDispatcher();
+
+  dispatcher.Select(maxLevel);
+
+  return dispatcher.level;
+} // JPEG_SetKernelsLevel()
+
+
+void JPEG_InterleaveUV_8u(
+  const uint8_t* pSrcU,
+  int            srcUStep,
+  const uint8_t* pSrcV,
+  int            srcVStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi)
+{
+  const InterleaveUVRowFunc row = GetDispatcher().InterleaveUVRow;
+
+  for(int i = 0; i < roi.height; i++)
+  {
+    row(pSrcU + i*srcUStep, pSrcV + i*srcVStep, pDst + i*dstStep, roi.width);
+  }
+} // JPEG_InterleaveUV_8u()
+
+
+void JPEG_GrayToBGRA_8u(
+  const uint8_t* pSrc,
+  int            srcStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi)
+{
+  const GrayToBGRARowFunc row = GetDispatcher().GrayToBGRARow;
+
+  for(int i = 0; i < roi.height; i++)
+  {
+    row(pSrc + i*srcStep, pDst + i*dstStep, roi.width);
+  }
+} // JPEG_GrayToBGRA_8u()
+
+
+void JPEG_RGBToBGRA_8u_P3C4R(
+  const uint8_t* pSrc[3],
+  int            srcStep,
+  uint8_t*       pDst,
+  int            dstStep,
+  mfxSize        roi)
+{
+  const RGBToBGRARowFunc row = GetDispatcher().RGBToBGRARow;
+
+  for(int i = 0; i < roi.height; i++)
+  {
+    row(pSrc[0] + i*srcStep, pSrc[1] + i*srcStep, pSrc[2] + i*srcStep, pDst + i*dstStep, roi.width);
+  }
+} // JPEG_RGBToBGRA_8u_P3C4R()
+
+
+void JPEG_BGRAToRGB_8u_C4P3R(
+  const uint8_t* pSrc,
+  int            srcStep,
+  uint8_t*       pDst[3],
+  int            dstStep,
+  mfxSize        roi)
+{
+  const BGRAToRGBRowFunc row = GetDispatcher().BGRAToRGBRow;
+
+  for(int i = 0; i < roi.height; i++)
+  {
+    row(pSrc + i*srcStep, pDst[0] + i*dstStep, pDst[1] + i*dstStep, pDst[2] + i*dstStep, roi.width);
+  }
+} // JPEG_BGRAToRGB_8u_C4P3R()
+
+
+IppStatus JPEG_DCTQuantInv8x8LS_16s8u_C1R(
+  const int16_t*  pSrc,
+  uint8_t*        pDst,
+  int             dstStep,
+  const uint16_t* pQuantInvTable,
+  int             numBlocks)
+{
+  const DCTQuantInv2BlocksFunc pair = GetDispatcher().DCTQuantInv2Blocks;
+  int n = 0;
+
+  if(!pSrc || !pDst || !pQuantInvTable)
+    return ippStsNullPtrErr;
+
+  if(dstStep <= 0)
+    return ippStsStepErr;
+
+  if(pair)
+  {
+    for(; n + 2 <= numBlocks; n += 2)
+    {
+      pair(pSrc + DCTSIZE2*n, pDst + 8*n, dstStep, pQuantInvTable);
+    }
+  }
+
+  for(; n < numBlocks; n++)
+  {
+    IppStatus status = mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R(pSrc + DCTSIZE2*n, pDst + 8*n, dstStep, pQuantInvTable);
+    if(ippStsNoErr != status)
+      return status;
+  }
+
+  return ippStsNoErr;
+} // JPEG_DCTQuantInv8x8LS_16s8u_C1R()
+
+
+IppStatus JPEG_DCTQuantFwd8x8LS_8u16s_C1R(
+  const uint8_t*  pSrc,
+  int             srcStep,
+  int16_t*        pDst,
+  const uint16_t* pQuantFwdTable,
+  int             numBlocks)
+{
+  const DCTQuantFwd2BlocksFunc pair = GetDispatcher().DCTQuantFwd2Blocks;
+  int n = 0;
+
+  if(!pSrc || !pDst || !pQuantFwdTable)
+    return ippStsNullPtrErr;
+
+  if(srcStep <= 0)
+    return ippStsStepErr;
+
+  if(pair)
+  {
+    for(; n + 2 <= numBlocks; n += 2)
+    {
+      pair(pSrc + 8*n, srcStep, pDst + DCTSIZE2*n, pQuantFwdTable);
+    }
+  }
+
+  for(; n < numBlocks; n++)
+  {
+    IppStatus status = mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R(pSrc + 8*n, srcStep, pDst + DCTSIZE2*n, pQuantFwdTable);
+    if(ippStsNoErr != status)
+      return status;
+  }
+
+  return ippStsNoErr;
+} // JPEG_DCTQuantFwd8x8LS_8u16s_C1R()
+
+
+void JPEG_YCbCrH2ToBGRA_8u_Row(
+  const uint8_t* pY,
+  const uint8_t* pCb,
+  const uint8_t* pCr,
+  const uint8_t* pCbFar,
+  const uint8_t* pCrFar,
+  int            chromaWidth,
+  uint8_t*       pDst,
+  int            width)
+{
+  GetDispatcher().YCbCrH2ToBGRARow(pY, pCb, pCr, pCbFar, pCrFar, chromaWidth, pDst, width);
+} // JPEG_YCbCrH2ToBGRA_8u_Row()
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_DECODE || MFX_ENABLE_MJPEG_VIDEO_ENCODE
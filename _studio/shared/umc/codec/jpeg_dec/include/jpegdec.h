@@ -25,6 +25,10 @@
 #if defined (MFX_ENABLE_MJPEG_VIDEO_DECODE)
 #include "jpegdec_base.h"
 
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
 class CBaseStreamInput;
 
 class CJPEGDecoder : public CJPEGDecoderBase
@@ -102,6 +106,23 @@ public:
   int    IsAVI1APP0Detected(void)      { return m_avi1_app0_detected; }
   int    GetAVI1APP0Polarity(void)     { return m_avi1_app0_polarity; }
 
+  // Intra-scan pipeline. Baseline scans without restart markers
+  // can not be split into pieces, so the thread calling ReadData() entropy
+  // decodes MCU rows into a ring of coefficient buffers while the threads
+  // calling ProcessPipelinedRows() reconstruct, upsample and color convert
+  // the completed rows. Must be configured before the first header is read.
+  void     SetPipelineThreads(int numThreads);
+  int      GetPipelineThreads(void)    { return m_pipe_threads; }
+  // Arm the pipeline for the next picture
+  void     StartPipeline(void);
+  // Mark the current picture finished
+  void     FinishPipeline(void);
+  // Helper thread entry. Reconstructs the rows being ready in the buffers
+  // of the given thread (1 .. threads - 1) without waiting for other rows.
+  // Returns the number of rows reconstructed, -1 when the current picture
+  // is finished.
+  int      ProcessPipelinedRows(int thread_id);
+
 public:
   int       m_jpeg_quality;
 
@@ -142,6 +163,25 @@ public:
   int      m_num_threads;
   int      m_sof_find;
 
+  // intra-scan pipeline state, see DecodeScanBaselineMT()
+  enum
+  {
+    JPIPE_IDLE    = 0,
+    JPIPE_RUNNING = 1,
+    JPIPE_DONE    = 2
+  };
+
+  int                       m_pipe_threads;
+  int                       m_pipe_state;
+  uint32_t                  m_pipe_rows;      // ring depth in MCU rows
+  uint32_t                  m_pipe_decoded;   // rows entropy decoded
+  uint32_t                  m_pipe_claimed;   // rows handed out for reconstruction
+  uint32_t                  m_pipe_completed; // rows reconstructed
+  JERRCODE                  m_pipe_error;
+  std::vector<uint8_t>      m_pipe_busy;      // ring slot holds a row not yet reconstructed
+  std::mutex                m_pipe_guard;
+  std::condition_variable   m_pipe_cond;
+
 
   IMAGE                       m_dst;
   CJPEGDecoderHuffmanState    m_state;
@@ -149,8 +189,10 @@ public:
 public:
   JERRCODE Init(void);
   virtual JERRCODE Clean(void);
-  JERRCODE ColorConvert(uint32_t rowCMU, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU);
+  JERRCODE ColorConvert(uint32_t rowCMU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  // UpSampling() followed by ColorConvert(), fused where the kernels allow
+  JERRCODE UpSamplingColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
 
   JERRCODE FindNextImage();
   JERRCODE ParseData();
@@ -163,6 +205,7 @@ public:
   JERRCODE ParseCOM(void);
 
   JERRCODE DecodeScanBaseline(void);     // interleaved / non-interleaved scans
+  JERRCODE DecodeScanBaselineMT(void);   // scan without restart intervals, rows pipelined across threads
   JERRCODE DecodeScanBaselineIN(void);   // interleaved scan
   JERRCODE DecodeScanBaselineIN_P(void); // interleaved scan for plane image
   JERRCODE DecodeScanBaselineNI(void);   // non-interleaved scan
@@ -179,12 +222,18 @@ public:
   JERRCODE DecodeHuffmanMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
 
   // inverse DCT, de-quantization, level-shift for mcu row
-  JERRCODE ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowEX(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
+  JERRCODE ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE ReconstructMCURowBL8x8(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE ReconstructMCURowEX(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+
+  // reconstruct, upsample and color convert one entropy decoded MCU row
+  JERRCODE ProcessMCURowBL(int16_t* pMCUBuf, uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  // claim the oldest entropy decoded row of the ring and reconstruct it.
+  // The guard is released while the row is processed.
+  void     ProcessPipelinedRow(std::unique_lock<std::mutex> &guard, int thread_id);
 
   JERRCODE ProcessBuffer(int nMCURow, int thread_id = 0);
   // reconstruct mcu row lossless process
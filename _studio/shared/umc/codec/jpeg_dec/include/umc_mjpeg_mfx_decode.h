@@ -76,6 +76,25 @@ public:
     // Get next frame
     virtual Status DecodePicture(const CJpegTask &task, const mfxU32 threadNumber, const mfxU32 callNumber);
 
+    // Check if the task may be decoded by the intra-scan pipeline. It is used
+    // for single piece pictures, which can't be split among the decoders.
+    // The scan must be a sequential DCT scan without restart intervals.
+    bool IsPipelineAllowed(const CJpegTask &task) const;
+
+    // Arm the intra-scan pipeline, if the task can use it.
+    // Returns false, if the task is decoded piece by piece.
+    bool StartPipeline(const CJpegTask &task);
+
+    // Check if the current task is decoded by the intra-scan pipeline
+    bool IsPipelined(void) const { return m_pipelined; }
+
+    // Entropy decode the picture by the intra-scan pipeline
+    Status DecodePicturePipelined(const CJpegTask &task);
+
+    // Reconstruct MCU rows being ready without waiting for other rows.
+    // Returns the number of rows reconstructed, -1 when the picture is finished.
+    int ProcessPipelinedRows(const mfxU32 threadNumber);
+
     void SetFrameAllocator(FrameAllocator * frameAllocator) override;
 
     Status DecodeHeader(MediaData* in);
@@ -142,6 +161,9 @@ protected:
     // Pointer to the last buffer decoded. It is required to check if header was already decoded.
     const CJpegTaskBuffer *m_pLastPicBuffer[JPEG_MAX_THREADS];
 
+    // The current task is decoded by the intra-scan pipeline
+    bool                    m_pipelined;
+
     double                  m_local_frame_time;
     double                  m_local_delta_frame_time;
 
@@ -24,10 +24,12 @@
 #include "ippi.h"
 #include "ipps.h"
 #include <memory>
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
 #include "jpegbase.h"
 #include "jpegdec.h"
+#include "jpegkernels.h"
 #include <cstdlib>
 #include <assert.h>
 
@@ -156,6 +158,14 @@ void CJPEGDecoder::Reset(void)
   m_use_qdct               = 0;
   m_sof_find               = 0;
 
+  m_pipe_threads           = 1;
+  m_pipe_state             = JPIPE_IDLE;
+  m_pipe_rows              = 0;
+  m_pipe_decoded           = 0;
+  m_pipe_claimed           = 0;
+  m_pipe_completed         = 0;
+  m_pipe_error             = JPEG_OK;
+
   return;
 } // CJPEGDecoder::Reset(void)
 
@@ -1239,7 +1249,7 @@ JERRCODE CJPEGDecoder::Init(void)
   if(m_init_done)
     return JPEG_OK;
 
-  m_num_threads = get_num_threads();
+  m_num_threads = std::max(get_num_threads(), m_pipe_threads);
 
   // TODO:
   //   need to add support for images with more than 4 components per frame
@@ -1301,7 +1311,10 @@ JERRCODE CJPEGDecoder::Init(void)
           curr_comp->m_ss_height += 2; // add border lines (top and bottom)
         }
 
-        tr_buf_size = m_numxMCU * m_nblock * DCTSIZE2 * sizeof(int16_t) * m_num_threads;
+        // pipelined scans keep a ring of entropy decoded MCU rows
+        m_pipe_rows = (m_pipe_threads > 1) ? 2 * m_pipe_threads : 0;
+
+        tr_buf_size = m_numxMCU * m_nblock * DCTSIZE2 * sizeof(int16_t) * std::max<int>(m_num_threads, m_pipe_rows);
 
         break;
       } // JPEG_BASELINE
@@ -1388,6 +1401,8 @@ JERRCODE CJPEGDecoder::Init(void)
 
   m_state.Create();
 
+  m_pipe_busy.assign(m_pipe_rows, 0);
+
   m_init_done = 1;
 
   return JPEG_OK;
@@ -1419,7 +1434,7 @@ uint32_t JPEG_BPP[JC_MAX] =
 #define iGv  0x00006b2f
 #define iBv  0x000014d1
 
-JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU)
+JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int       cc_h;
   mfxSize  roi;
@@ -1452,9 +1467,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
       srcStep = m_ccomp[0].m_cc_step;
 
-      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
-      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
-      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
 
       dstStep = m_dst.lineStep[0];
       bpp = JPEG_BPP[m_dst.color % JC_MAX];
@@ -1463,14 +1478,21 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
           rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep / m_dd_factor + 
           colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor * bpp;
 
-      for(int n = m_curr_scan->first_comp; n < m_curr_scan->first_comp + m_curr_scan->ncomps; n++)
+      if(0 == m_curr_scan->first_comp && 3 == m_curr_scan->ncomps)
       {
-          for(int i=0; i<roi.height; i++)
-              for(int j=0; j<roi.width; j++)
-              {
-                  pDst8u[i*dstStep + j*4 + 2 - n] = pSrc8u[n][i*srcStep + j];
-                  pDst8u[i*dstStep + j*4 + 3] = 0xFF;
-              }
+          JPEG_RGBToBGRA_8u_P3C4R((const uint8_t**)pSrc8u, srcStep, pDst8u, dstStep, roi);
+      }
+      else
+      {
+          for(int n = m_curr_scan->first_comp; n < m_curr_scan->first_comp + m_curr_scan->ncomps; n++)
+          {
+              for(int i=0; i<roi.height; i++)
+                  for(int j=0; j<roi.width; j++)
+                  {
+                      pDst8u[i*dstStep + j*4 + 2 - n] = pSrc8u[n][i*srcStep + j];
+                      pDst8u[i*dstStep + j*4 + 3] = 0xFF;
+                  }
+          }
       }
   }
   else if (JC_YCBCR == m_jpeg_color && JC_NV12 == m_dst.color)
@@ -1484,9 +1506,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       srcStep[1] = m_ccomp[1].m_cc_step;
       srcStep[2] = m_ccomp[2].m_cc_step;
 
-      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
-      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor / 2;
-      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor / 2;
+      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor / 2;
+      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor / 2;
 
       dstStep[0] = m_dst.lineStep[0];
       dstStep[1] = m_dst.lineStep[1];
@@ -1503,10 +1525,17 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
           if(n == 0)
           {
               for(int i=0; i<roi.height; i++)
-                  for(int j=0; j<roi.width; j++)
-                  {
-                      pDst8u[0][i*dstStep[0] + j] = pSrc8u[0][i*srcStep[0] + j];
-                  }
+              {
+                  MFX_INTERNAL_CPY(pDst8u[0] + i*dstStep[0], pSrc8u[0] + i*srcStep[0], roi.width);
+              }
+          }
+          else if(n == 1 && m_curr_scan->first_comp + m_curr_scan->ncomps == 3)
+          {
+              // both chroma components are in the scan, interleave them at once
+              mfxSize uvRoi = { roi.width >> 1, roi.height >> 1 };
+
+              JPEG_InterleaveUV_8u(pSrc8u[1], srcStep[1], pSrc8u[2], srcStep[2], pDst8u[1], dstStep[1], uvRoi);
+              break;
           }
           else
           {
@@ -1529,9 +1558,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       srcStep[1] = m_ccomp[0].m_cc_step;
       srcStep[2] = m_ccomp[0].m_cc_step;
 
-      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
-      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
-      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+      pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
 
       dstStep[0] = m_dst.lineStep[0];
       dstStep[1] = m_dst.lineStep[1];
@@ -1550,10 +1579,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       for(int n = m_curr_scan->first_comp; n < m_curr_scan->first_comp + m_curr_scan->ncomps; n++)
       {
           for(int i=0; i<roi.height; i++)
-              for(int j=0; j<roi.width; j++)
-              {
-                  pDst8u[n][i*dstStep[n] + j] = pSrc8u[n][i*srcStep[n] + j];
-              }
+          {
+              MFX_INTERNAL_CPY(pDst8u[n] + i*dstStep[n], pSrc8u[n] + i*srcStep[n], roi.width);
+          }
       }
   }
   else if(JC_GRAY == m_jpeg_color && m_dst.color == JC_BGRA)
@@ -1565,7 +1593,7 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
       srcStep = m_ccomp[0].m_cc_step;
 
-      pSrc8u = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
+      pSrc8u = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
 
       dstStep = m_dst.lineStep[0];
       bpp = JPEG_BPP[m_dst.color % JC_MAX];
@@ -1574,14 +1602,7 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
           rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep / m_dd_factor + 
           colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor * bpp;
 
-      for(int i=0; i<roi.height; i++)
-          for(int j=0; j<roi.width; j++)
-          {
-              pDst8u[i*dstStep + j*4 + 0] = pSrc8u[i*srcStep + j];
-              pDst8u[i*dstStep + j*4 + 1] = pSrc8u[i*srcStep + j];
-              pDst8u[i*dstStep + j*4 + 2] = pSrc8u[i*srcStep + j];
-              pDst8u[i*dstStep + j*4 + 3] = 0xFF;
-          }
+      JPEG_GrayToBGRA_8u(pSrc8u, srcStep, pDst8u, dstStep, roi);
   }
   else if(JC_GRAY == m_jpeg_color && m_dst.color == JC_NV12)
   {
@@ -1591,7 +1612,7 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       uint8_t*  pDst8u[2];
 
       srcStep = m_ccomp[0].m_cc_step;
-      pSrc8u = m_ccomp[0].GetCCBufferPtr<uint8_t> (colMCU);
+      pSrc8u = m_ccomp[0].GetCCBufferPtr<uint8_t> (colMCU, thread_id);
 
       dstStep[0] = m_dst.lineStep[0];
       dstStep[1] = m_dst.lineStep[1];
@@ -1604,13 +1625,12 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
           colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
 
       for(int i=0; i<roi.height >> 1; i++)
-          for(int j=0; j<roi.width; j++)
-          {
-              pDst8u[0][ (i<<1)   *dstStep[0] + j] = pSrc8u[ (i<<1)   *srcStep + j];
-              pDst8u[0][((i<<1)+1)*dstStep[0] + j] = pSrc8u[((i<<1)+1)*srcStep + j];
+      {
+          MFX_INTERNAL_CPY(pDst8u[0] +  (i<<1)   *dstStep[0], pSrc8u +  (i<<1)   *srcStep, roi.width);
+          MFX_INTERNAL_CPY(pDst8u[0] + ((i<<1)+1)*dstStep[0], pSrc8u + ((i<<1)+1)*srcStep, roi.width);
 
-              pDst8u[1][i*dstStep[1] + j] = 0x80;
-          }
+          memset(pDst8u[1] + i*dstStep[1], 0x80, roi.width);
+      }
   }
   else if(m_jpeg_ncomp == m_curr_scan->ncomps)
   {
@@ -1624,9 +1644,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
           srcStep = m_ccomp[0].m_cc_step;
 
-          pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
-          pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
-          pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
 
           dstStep[0] = m_dst.lineStep[0];
           dstStep[1] = m_dst.lineStep[1];
@@ -1676,9 +1696,9 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
           srcStep = m_ccomp[0].m_cc_step;
 
-          pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
-          pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
-          pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[0] = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[1] = m_ccomp[1].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
+          pSrc8u[2] = m_ccomp[2].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth;
 
           dstStep = m_dst.lineStep[0];
           bpp = JPEG_BPP[m_dst.color % JC_MAX];
@@ -1702,7 +1722,7 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 } // JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowCMU, uint32_t colMCU, uint32_t maxMCU)
 
 
-JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU)
+JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int i, j, k, n, c;
   int need_upsampling;
@@ -1736,9 +1756,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
           dstStep = curr_comp->m_cc_step;
 
           // set the pointer to source buffer
-          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_scan_hsampling;
+          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_scan_hsampling;
           // set the pointer to destination buffer
-          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_h_factor;
+          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_h_factor;
 
           intervalSize = m_curr_scan->jpeg_restart_interval ? 
                          m_curr_scan->jpeg_restart_interval * 8 * curr_comp->m_scan_hsampling : 
@@ -1783,9 +1803,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
           srcStep = curr_comp->m_ss_step;
 
           // set the pointer to source buffer
-          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_scan_hsampling;
+          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_scan_hsampling;
           // set the pointer to destination buffer
-          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_h_factor;
+          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_h_factor;
 
           for(i = 0; i < (m_mcuHeight >> 1) - 1; i++)
           {
@@ -1827,9 +1847,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
           dstStep = curr_comp->m_cc_step;
 
           // set the pointer to source buffer
-          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_scan_hsampling;
+          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_scan_hsampling;
           // set the pointer to destination buffer
-          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_h_factor;
+          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_h_factor;
 
           intervalSize = m_curr_scan->jpeg_restart_interval ? 
                          m_curr_scan->jpeg_restart_interval * 8 * curr_comp->m_scan_hsampling : 
@@ -1924,11 +1944,11 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
           dstStep = curr_comp->m_cc_step;
 
           // set the pointer to source buffer
-          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_scan_hsampling;
+          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_scan_hsampling;
           // set the pointer to temporary buffer
           std::unique_ptr<uint8_t[]> pTmp( new uint8_t[2 * srcWidth / m_dd_factor] );
           // set the pointer to destination buffer
-          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_h_factor;
+          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_h_factor;
          
           intervalSize = m_curr_scan->jpeg_restart_interval ? 
                          m_curr_scan->jpeg_restart_interval * 8 * curr_comp->m_scan_hsampling : 
@@ -1995,9 +2015,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
           v_step  = curr_comp->m_v_factor;
 
           // set the pointer to source buffer
-          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_scan_hsampling;
+          pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_scan_hsampling;
           // set the pointer to destination buffer
-          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * curr_comp->m_h_factor;
+          pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * curr_comp->m_h_factor;
 
           for(n = 0; n < curr_comp->m_ss_height; n++)
           {
@@ -2051,11 +2071,11 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
             tmpStep = srcStep;            
 
             // set the pointer to source buffer
-            pSrc = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU;
+            pSrc = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
             // set the pointer to temporary buffer
             std::unique_ptr<uint8_t[]> pTmp( new uint8_t[tmpStep * m_curr_scan->mcuHeight / 2] );
             // set the pointer to destination buffer
-            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU / 2;  
+            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU / 2;  
 
             // set ROI of source
             srcRoiSize.width = (maxMCU - colMCU) * 8;
@@ -2093,9 +2113,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
             dstStep = curr_comp->m_cc_step;     
 
             // set the pointer to source buffer
-            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU;
+            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
             // set the pointer to destination buffer
-            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU;  
+            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;  
 
             // set ROI of source
             srcRoiSize.width = (maxMCU - colMCU) * 8;
@@ -2129,9 +2149,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
             dstStep = curr_comp->m_cc_step;
 
             // set the pointer to source buffer
-            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + m_curr_scan->mcuWidth * colMCU;
+            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + m_curr_scan->mcuWidth * colMCU;
             // set the pointer to destination buffer
-            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + m_curr_scan->mcuWidth * colMCU / 2;
+            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + m_curr_scan->mcuWidth * colMCU / 2;
 
             // set ROI of source
             srcRoiSize.width = (maxMCU - colMCU) * m_curr_scan->mcuWidth;
@@ -2162,9 +2182,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
             dstStep = curr_comp->m_cc_step;
 
             // set the pointer to source buffer
-            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU;
+            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
             // set the pointer to destination buffer
-            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU;
+            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
 
             // set ROI of source
             srcRoiSize.width = (maxMCU - colMCU) * 8;
@@ -2197,9 +2217,9 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
             dstStep = curr_comp->m_cc_step;
 
             // set the pointer to source buffer
-            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * colMCU;
+            pSrc = curr_comp->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
             // set the pointer to destination buffer
-            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * colMCU * 2;  
+            pDst = curr_comp->GetCCBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU * 2;  
 
             // set ROI of source
             srcRoiSize.width = (maxMCU - colMCU) * 8;
@@ -2218,7 +2238,115 @@ JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t max
   }
 
   return JPEG_OK;
-} // JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU)
+} // JERRCODE CJPEGDecoder::UpSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
+
+
+JERRCODE CJPEGDecoder::UpSamplingColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
+{
+  JERRCODE jerr;
+
+  // YCbCr 422H or 420 to BGRA of whole MCU rows: chroma is upsampled while
+  // converting colors, no intermediate upsampled planes are written.
+  // Restart intervals of whole rows do not split the rows in tiles.
+  if(JC_YCBCR == m_jpeg_color && JC_BGRA == m_dst.color && 8 == m_jpeg_precision && 1 == m_dd_factor &&
+     3 == m_jpeg_ncomp && 3 == m_curr_scan->ncomps &&
+     0 == colMCU && (uint32_t)m_curr_scan->numxMCU == maxMCU &&
+     (0 == m_curr_scan->jpeg_restart_interval || 0 == m_curr_scan->jpeg_restart_interval % m_curr_scan->numxMCU) &&
+     1 == m_ccomp[0].m_h_factor && 1 == m_ccomp[0].m_v_factor &&
+     2 == m_ccomp[1].m_h_factor && 2 == m_ccomp[2].m_h_factor &&
+     m_ccomp[1].m_v_factor == m_ccomp[2].m_v_factor && m_ccomp[1].m_v_factor <= 2 &&
+     m_ccomp[1].m_need_upsampling && m_ccomp[2].m_need_upsampling)
+  {
+    CJPEGColorComponent* cb = &m_ccomp[1];
+    CJPEGColorComponent* cr = &m_ccomp[2];
+    int height = m_curr_scan->mcuHeight * m_curr_scan->min_v_factor;
+    int width  = maxMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor - m_curr_scan->xPadding;
+    int chromaWidth = maxMCU * 8 * cb->m_scan_hsampling;
+    int chromaRows  = m_mcuHeight / cb->m_v_factor;
+    int dstStep     = m_dst.lineStep[0];
+
+    if(rowMCU == (uint32_t)m_curr_scan->numyMCU - 1)
+    {
+      height -= m_curr_scan->yPadding;
+    }
+
+    const uint8_t* pY  = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id);
+    const uint8_t* pCb = cb->GetSSBufferPtr<uint8_t> (0, thread_id);
+    const uint8_t* pCr = cr->GetSSBufferPtr<uint8_t> (0, thread_id);
+    uint8_t*       pDst = m_dst.p.Data8u[0] + rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep;
+
+    for(int i = 0; i < height; i++)
+    {
+      // 420: the nearer chroma row and the row on the other side of the
+      // output row, repeated at the MCU row edges
+      int nearRow = (1 == cb->m_v_factor) ? i : (i >> 1);
+      int farRow  = (i & 1) ? std::min(nearRow + 1, chromaRows - 1) : std::max(nearRow - 1, 0);
+
+      JPEG_YCbCrH2ToBGRA_8u_Row(
+        pY  + i * m_ccomp[0].m_cc_step,
+        pCb + nearRow * cb->m_ss_step,
+        pCr + nearRow * cr->m_ss_step,
+        (1 == cb->m_v_factor) ? NULL : pCb + farRow * cb->m_ss_step,
+        (1 == cr->m_v_factor) ? NULL : pCr + farRow * cr->m_ss_step,
+        chromaWidth,
+        pDst + i * dstStep,
+        width);
+    }
+
+    return JPEG_OK;
+  }
+
+  // YCbCr 420 to NV12: chroma already has the destination sampling, it is
+  // interleaved straight from the decoded planes without copying them to
+  // the color conversion buffers first.
+  if(JC_YCBCR == m_jpeg_color && JC_NV12 == m_dst.color && JS_420 == m_jpeg_sampling &&
+     8 == m_jpeg_precision && 1 == m_dd_factor &&
+     3 == m_jpeg_ncomp && 0 == m_curr_scan->first_comp && 3 == m_curr_scan->ncomps)
+  {
+    CJPEGColorComponent* cb = &m_ccomp[1];
+    CJPEGColorComponent* cr = &m_ccomp[2];
+    mfxSize roi;
+    int dstStep[2] = { m_dst.lineStep[0], m_dst.lineStep[1] };
+
+    roi.height = m_curr_scan->mcuHeight * m_curr_scan->min_v_factor;
+    if(rowMCU == (uint32_t)m_curr_scan->numyMCU - 1)
+    {
+      roi.height -= m_curr_scan->yPadding;
+    }
+
+    roi.width = (maxMCU - colMCU) * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+    if(maxMCU == (uint32_t)m_curr_scan->numxMCU)
+    {
+      roi.width -= m_curr_scan->xPadding;
+    }
+
+    const uint8_t* pY  = m_ccomp[0].GetCCBufferPtr<uint8_t> (0, thread_id) + colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+    const uint8_t* pCb = cb->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
+    const uint8_t* pCr = cr->GetSSBufferPtr<uint8_t> (0, thread_id) + 8 * colMCU;
+    uint8_t*       pDstY  = m_dst.p.Data8u[0] +
+      rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep[0] +
+      colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+    uint8_t*       pDstUV = m_dst.p.Data8u[1] +
+      rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep[1] / 2 +
+      colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
+    mfxSize uvRoi = { roi.width >> 1, roi.height >> 1 };
+
+    for(int i = 0; i < roi.height; i++)
+    {
+      MFX_INTERNAL_CPY(pDstY + i * dstStep[0], pY + i * m_ccomp[0].m_cc_step, roi.width);
+    }
+
+    JPEG_InterleaveUV_8u(pCb, cb->m_ss_step, pCr, cr->m_ss_step, pDstUV, dstStep[1], uvRoi);
+
+    return JPEG_OK;
+  }
+
+  jerr = UpSampling(rowMCU, colMCU, maxMCU, thread_id);
+  if(JPEG_OK != jerr)
+    return jerr;
+
+  return ColorConvert(rowMCU, colMCU, maxMCU, thread_id);
+} // JERRCODE CJPEGDecoder::UpSamplingColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 
 
 JERRCODE CJPEGDecoder::ProcessBuffer(int nMCURow, int thread_id)
@@ -2509,7 +2637,8 @@ JERRCODE CJPEGDecoder::DecodeHuffmanMCURowLS(int16_t* pMCUBuf)
 
 JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf,
                                                   uint32_t colMCU,
-                                                  uint32_t maxMCU)
+                                                  uint32_t maxMCU,
+                                                  int      thread_id)
 {
   int       c, k, l, curr_lnz;
   uint32_t mcu_col;
@@ -2518,7 +2647,6 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf,
   int       dstStep = m_ccWidth;
   int status;
   CJPEGColorComponent* curr_comp;
-  const int thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -2605,17 +2733,16 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf,
 
 JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8(int16_t* pMCUBuf,
                                               uint32_t colMCU,
-                                              uint32_t maxMCU)
+                                              uint32_t maxMCU,
+                                              int      thread_id)
 {
-    int       c, k, l;
+    int       c, k;
   uint32_t mcu_col;
   uint8_t*    dst     = 0;
-  uint8_t*    p       = 0;
   int       dstStep = m_ccWidth;
   uint16_t*   qtbl;
   int status;
   CJPEGColorComponent* curr_comp;
-  const uint32_t thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -2647,21 +2774,16 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8(int16_t* pMCUBuf,
           curr_comp->m_need_upsampling = 1;
         }
 
-        for(l = 0; l < curr_comp->m_scan_hsampling; l++)
-        {
-          p = dst + l*8;
+        // the blocks of the row are adjacent, they are transformed together
+        status = JPEG_DCTQuantInv8x8LS_16s8u_C1R(pMCUBuf, dst, dstStep, qtbl, curr_comp->m_scan_hsampling);
 
+        if(ippStsNoErr > status)
+        {
+          LOG0("Error: JPEG_DCTQuantInv8x8LS_16s8u_C1R() failed!");
+          return JPEG_ERR_INTERNAL;
+        }
 
-          status = mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R(pMCUBuf, p, dstStep, qtbl);
-
-          if(ippStsNoErr > status)
-          {
-            LOG0("Error: mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R() failed!");
-            return JPEG_ERR_INTERNAL;
-          }
-
-          pMCUBuf += DCTSIZE2;
-        } // for m_hsampling
+        pMCUBuf += DCTSIZE2 * curr_comp->m_scan_hsampling;
       } // for m_vsampling
     } // for m_jpeg_ncomp
   } // for m_numxMCU
@@ -2673,7 +2795,8 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8(int16_t* pMCUBuf,
 
 JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf,
                                                    uint32_t colMCU,
-                                                   uint32_t maxMCU)
+                                                   uint32_t maxMCU,
+                                                   int      thread_id)
 {
   int       c, k, l;
   uint32_t mcu_col;
@@ -2682,7 +2805,6 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf,
   uint16_t*   qtbl;
   int status;
   CJPEGColorComponent* curr_comp;
-  const int thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -2778,7 +2900,8 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf,
 
 JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf,
                                                    uint32_t colMCU,
-                                                   uint32_t maxMCU)
+                                                   uint32_t maxMCU,
+                                                   int      thread_id)
 {
   int       c, k, l;
   uint32_t mcu_col;
@@ -2787,7 +2910,6 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf,
   uint16_t*   qtbl;
   int status;
   CJPEGColorComponent* curr_comp;
-  const int thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -2883,7 +3005,8 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf,
 
 JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf,
                                                    uint32_t colMCU,
-                                                   uint32_t maxMCU)
+                                                   uint32_t maxMCU,
+                                                   int      thread_id)
 {
   int       c, k, l;
   uint32_t mcu_col;
@@ -2893,7 +3016,6 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf,
   int status;
 
   CJPEGColorComponent* curr_comp;
-  const int thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -2979,7 +3101,8 @@ JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf,
 
 JERRCODE CJPEGDecoder::ReconstructMCURowEX(int16_t* pMCUBuf,
                                            uint32_t colMCU,
-                                           uint32_t maxMCU)
+                                           uint32_t maxMCU,
+                                           int      thread_id)
 {
   int       c, k, l;
   uint32_t mcu_col;
@@ -2988,7 +3111,6 @@ JERRCODE CJPEGDecoder::ReconstructMCURowEX(int16_t* pMCUBuf,
   float*   qtbl;
   int status;
   CJPEGColorComponent* curr_comp;
-  const int thread_id = 0;
 
   for(mcu_col = colMCU; mcu_col < maxMCU; mcu_col++)
   {
@@ -3239,6 +3361,13 @@ JERRCODE CJPEGDecoder::DecodeScanBaseline(void)
       return jerr;
   }
 
+    // without restart intervals the scan is a single piece, so let the
+    // helper threads reconstruct the rows behind the entropy decoder
+    if (m_pipe_rows && 0 == m_curr_scan->jpeg_restart_interval)
+    {
+        return DecodeScanBaselineMT();
+    }
+
     {
         int16_t* pMCUBuf;
         uint32_t rowMCU, colMCU, maxMCU;
@@ -3270,52 +3399,8 @@ JERRCODE CJPEGDecoder::DecodeScanBaseline(void)
             if (JPEG_OK != jerr)
                 return jerr;
 
-            // reconstruct a MCU row
-            if(m_jpeg_precision == 12)
-                jerr = ReconstructMCURowEX(pMCUBuf, colMCU, maxMCU);
-            else
-            {
-                switch (m_jpeg_dct_scale)
-                {
-                default:
-                case JD_1_1:
-                    {
-                        if(m_use_qdct)
-                            jerr = ReconstructMCURowBL8x8_NxN(pMCUBuf, colMCU, maxMCU);
-                        else
-                            jerr = ReconstructMCURowBL8x8(pMCUBuf, colMCU, maxMCU);
-                    }
-                    break;
-
-                case JD_1_2:
-                    {
-                        jerr = ReconstructMCURowBL8x8To4x4(pMCUBuf, colMCU, maxMCU);
-                    }
-                    break;
-
-                case JD_1_4:
-                    {
-                        jerr = ReconstructMCURowBL8x8To2x2(pMCUBuf, colMCU, maxMCU);
-                    }
-                    break;
-
-                case JD_1_8:
-                    {
-                        jerr = ReconstructMCURowBL8x8To1x1(pMCUBuf, colMCU, maxMCU);
-                    }
-                    break;
-                }
-            }
-
-            if (JPEG_OK != jerr)
-                return jerr;
-
-
-            jerr = UpSampling(rowMCU, colMCU, maxMCU);
-            if (JPEG_OK != jerr)
-                return jerr;
-
-            jerr = ColorConvert(rowMCU, colMCU, maxMCU);
+            // reconstruct, upsample and color convert a MCU row
+            jerr = ProcessMCURowBL(pMCUBuf, rowMCU, colMCU, maxMCU);
             if (JPEG_OK != jerr)
                 return jerr;
 
@@ -3346,6 +3431,162 @@ JERRCODE CJPEGDecoder::DecodeScanBaseline(void)
 } // CJPEGDecoder::DecodeScanBaseline()
 
 
+JERRCODE CJPEGDecoder::ProcessMCURowBL(int16_t* pMCUBuf,
+                                       uint32_t rowMCU,
+                                       uint32_t colMCU,
+                                       uint32_t maxMCU,
+                                       int      thread_id)
+{
+  JERRCODE jerr;
+
+  // reconstruct a MCU row
+  if(m_jpeg_precision == 12)
+    jerr = ReconstructMCURowEX(pMCUBuf, colMCU, maxMCU, thread_id);
+  else
+  {
+    switch (m_jpeg_dct_scale)
+    {
+    default:
+    case JD_1_1:
+      {
+        if(m_use_qdct)
+          jerr = ReconstructMCURowBL8x8_NxN(pMCUBuf, colMCU, maxMCU, thread_id);
+        else
+          jerr = ReconstructMCURowBL8x8(pMCUBuf, colMCU, maxMCU, thread_id);
+      }
+      break;
+
+    case JD_1_2:
+      {
+        jerr = ReconstructMCURowBL8x8To4x4(pMCUBuf, colMCU, maxMCU, thread_id);
+      }
+      break;
+
+    case JD_1_4:
+      {
+        jerr = ReconstructMCURowBL8x8To2x2(pMCUBuf, colMCU, maxMCU, thread_id);
+      }
+      break;
+
+    case JD_1_8:
+      {
+        jerr = ReconstructMCURowBL8x8To1x1(pMCUBuf, colMCU, maxMCU, thread_id);
+      }
+      break;
+    }
+  }
+
+  if(JPEG_OK != jerr)
+    return jerr;
+
+  return UpSamplingColorConvert(rowMCU, colMCU, maxMCU, thread_id);
+
+} // CJPEGDecoder::ProcessMCURowBL()
+
+
+void CJPEGDecoder::ProcessPipelinedRow(std::unique_lock<std::mutex> &guard, int thread_id)
+{
+  JERRCODE jerr;
+  uint32_t rowMCU = m_pipe_claimed++;
+  uint32_t slot   = rowMCU % m_pipe_rows;
+  int16_t* pMCUBuf = m_block_buffer + slot * m_numxMCU * m_nblock * DCTSIZE2;
+
+  // the row is owned by this thread until the slot is released
+  guard.unlock();
+  jerr = ProcessMCURowBL(pMCUBuf, rowMCU, 0, m_curr_scan->numxMCU, thread_id);
+  guard.lock();
+
+  if(JPEG_OK != jerr && JPEG_OK == m_pipe_error)
+    m_pipe_error = jerr;
+
+  m_pipe_busy[slot] = 0;
+  m_pipe_completed += 1;
+
+  // only the entropy decoding thread waits for released slots
+  m_pipe_cond.notify_one();
+
+} // CJPEGDecoder::ProcessPipelinedRow()
+
+
+JERRCODE CJPEGDecoder::DecodeScanBaselineMT(void)
+{
+  JERRCODE jerr = JPEG_OK;
+  uint32_t rowMCU;
+  uint32_t numyMCU = m_curr_scan->numyMCU;
+  uint32_t rowSize = m_numxMCU * m_nblock * DCTSIZE2;
+
+  // the helper threads pick up rows since now
+  {
+    std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+    m_pipe_decoded   = 0;
+    m_pipe_claimed   = 0;
+    m_pipe_completed = 0;
+    m_pipe_error     = JPEG_OK;
+    std::fill(m_pipe_busy.begin(), m_pipe_busy.end(), 0);
+
+    m_pipe_state = JPIPE_RUNNING;
+  }
+
+  for(rowMCU = 0; rowMCU < numyMCU; rowMCU++)
+  {
+    uint32_t slot    = rowMCU % m_pipe_rows;
+    int16_t* pMCUBuf = m_block_buffer + slot * rowSize;
+
+    // wait for the slot to be released. The entropy decoder is the
+    // bottleneck, but the helpers may be busy with other tasks, so
+    // reconstruct the oldest rows here rather than sleeping.
+    {
+      std::unique_lock<std::mutex> guard(m_pipe_guard);
+
+      while(m_pipe_busy[slot] && JPEG_OK == m_pipe_error)
+      {
+        if(m_pipe_claimed < m_pipe_decoded)
+          ProcessPipelinedRow(guard, 0);
+        else
+          m_pipe_cond.wait(guard);
+      }
+
+      if(JPEG_OK != m_pipe_error)
+        break;
+    }
+
+    // decode a MCU row
+    mfxsZero_16s(pMCUBuf, rowSize);
+
+    jerr = DecodeHuffmanMCURowBL(pMCUBuf, 0, m_curr_scan->numxMCU);
+    if(JPEG_OK != jerr)
+      break;
+
+    {
+      std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+      m_pipe_busy[slot] = 1;
+      m_pipe_decoded += 1;
+    }
+  }
+
+  // help with the remaining rows and wait for the rows being reconstructed
+  {
+    std::unique_lock<std::mutex> guard(m_pipe_guard);
+
+    while(m_pipe_completed < m_pipe_decoded)
+    {
+      if(m_pipe_claimed < m_pipe_decoded)
+        ProcessPipelinedRow(guard, 0);
+      else
+        m_pipe_cond.wait(guard);
+    }
+
+    if(JPEG_OK == jerr)
+      jerr = m_pipe_error;
+  }
+
+  return jerr;
+
+} // CJPEGDecoder::DecodeScanBaselineMT()
+
+
 JERRCODE CJPEGDecoder::DecodeScanBaselineIN(void)
 {
   int status;
@@ -3499,11 +3740,7 @@ JERRCODE CJPEGDecoder::DecodeScanBaselineIN(void)
                 continue;
 
 
-            jerr = UpSampling(rowMCU, colMCU, maxMCU);
-            if(JPEG_OK != jerr)
-                continue;
-
-            jerr = ColorConvert(rowMCU, colMCU, maxMCU);
+            jerr = UpSamplingColorConvert(rowMCU, colMCU, maxMCU);
             if(JPEG_OK != jerr)
                 continue;
 
@@ -4334,6 +4571,54 @@ JERRCODE CJPEGDecoder::ReadData(uint32_t restartNum, uint32_t restartsToDecode)
 
 } // CJPEGDecoder::ReadData(uint32_t restartNum)
 
+void CJPEGDecoder::SetPipelineThreads(int numThreads)
+{
+  m_pipe_threads = std::max(numThreads, 1);
+
+} // CJPEGDecoder::SetPipelineThreads()
+
+
+void CJPEGDecoder::StartPipeline(void)
+{
+  std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+  m_pipe_state     = JPIPE_IDLE;
+  m_pipe_decoded   = 0;
+  m_pipe_claimed   = 0;
+  m_pipe_completed = 0;
+
+} // CJPEGDecoder::StartPipeline()
+
+
+void CJPEGDecoder::FinishPipeline(void)
+{
+  std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+  m_pipe_state = JPIPE_DONE;
+
+} // CJPEGDecoder::FinishPipeline()
+
+
+int CJPEGDecoder::ProcessPipelinedRows(int thread_id)
+{
+  std::unique_lock<std::mutex> guard(m_pipe_guard);
+  int rows = 0;
+
+  // buffers of thread 0 belong to the entropy decoding thread
+  if(0 >= thread_id || thread_id >= m_pipe_threads)
+    return -1;
+
+  // don't wait for the entropy decoder, the caller comes back later
+  while(JPIPE_RUNNING == m_pipe_state && m_pipe_claimed < m_pipe_decoded)
+  {
+    ProcessPipelinedRow(guard, thread_id);
+    rows++;
+  }
+
+  return (JPIPE_DONE == m_pipe_state && 0 == rows) ? -1 : rows;
+
+} // CJPEGDecoder::ProcessPipelinedRows()
+
 JERRCODE CJPEGDecoder::ReadPictureHeaders(void)
 {
     return JPEG_OK;
@@ -52,6 +52,7 @@ MJPEGVideoDecoderMFX::MJPEGVideoDecoderMFX(void)
     m_frameAllocator = 0;
 
     std::fill(std::begin(m_pLastPicBuffer), std::end(m_pLastPicBuffer), nullptr);
+    m_pipelined = false;
 
     m_framePrecision = 0;
     m_frameChannels = 0;
@@ -106,6 +107,10 @@ Status MJPEGVideoDecoderMFX::Init(BaseCodecParams* lpInit)
         m_dec[i].reset(new CJPEGDecoder());
     }
 
+    // the first decoder runs the intra-scan pipeline on the threads of
+    // the other decoders
+    m_dec[0]->SetPipelineThreads(numThreads);
+
     m_decBase = m_dec[0].get();
 
     m_local_delta_frame_time = 1.0/30;
@@ -142,6 +147,7 @@ Status MJPEGVideoDecoderMFX::Reset(void)
     m_local_frame_time = 0;
 
     std::fill(std::begin(m_pLastPicBuffer), std::end(m_pLastPicBuffer), nullptr);
+    m_pipelined = false;
 
     return UMC_OK;
 
@@ -161,6 +167,7 @@ Status MJPEGVideoDecoderMFX::Close(void)
     m_frame        = 0;
     m_frameSampling = 0;
     m_rotation     = 0;
+    m_pipelined    = false;
 
     m_local_frame_time = 0;
 
@@ -655,6 +662,97 @@ Status MJPEGVideoDecoderMFX::DecodePicture(const CJpegTask &task,
 
 } // Status MJPEGVideoDecoderMFX::DecodePicture(const CJpegTask &task,
 
+bool MJPEGVideoDecoderMFX::IsPipelineAllowed(const CJpegTask &task) const
+{
+    if ((1 != task.NumPiecesCollected()) ||
+        (1 >= m_dec[0]->GetPipelineThreads()))
+    {
+        return false;
+    }
+
+    const CJpegTaskBuffer &picBuffer = task.GetPictureBuffer(0);
+    const uint8_t *pCur = picBuffer.pBuf;
+    const uint8_t *pEnd = picBuffer.pBuf + picBuffer.pieceOffset[0];
+    bool sequentialDCT = false;
+
+    if (1 != picBuffer.numScans)
+    {
+        return false;
+    }
+
+    // walk through the markers preceding the scan
+    while (pCur + 4 <= pEnd)
+    {
+        const uint32_t marker = pCur[1];
+
+        if ((0xff != pCur[0]) || (0xff == marker) || (0 == marker))
+        {
+            pCur += 1;
+            continue;
+        }
+        if ((JM_SOI == marker) || ((JM_RST0 <= marker) && (JM_RST7 >= marker)))
+        {
+            pCur += 2;
+            continue;
+        }
+
+        const uint32_t length = (pCur[2] << 8) | pCur[3];
+
+        if ((JM_SOF0 == marker) || (JM_SOF1 == marker))
+        {
+            sequentialDCT = true;
+        }
+        // other frame types are not decoded by DecodeScanBaseline
+        else if (((JM_SOF2 <= marker) && (JM_SOF7 >= marker) && (JM_DHT != marker)) ||
+                 ((JM_SOF9 <= marker) && (JM_SOFF >= marker) && (0xcc != marker)))
+        {
+            return false;
+        }
+        // restart intervals are decoded piece by piece
+        else if ((JM_DRI == marker) && (pCur + 6 <= pEnd) &&
+                 (0 != ((pCur[4] << 8) | pCur[5])))
+        {
+            return false;
+        }
+
+        pCur += 2 + length;
+    }
+
+    return sequentialDCT;
+
+} // bool MJPEGVideoDecoderMFX::IsPipelineAllowed(const CJpegTask &task) const
+
+bool MJPEGVideoDecoderMFX::StartPipeline(const CJpegTask &task)
+{
+    m_pipelined = IsPipelineAllowed(task);
+    if (m_pipelined)
+    {
+        m_dec[0]->StartPipeline();
+    }
+
+    return m_pipelined;
+
+} // bool MJPEGVideoDecoderMFX::StartPipeline(const CJpegTask &task)
+
+Status MJPEGVideoDecoderMFX::DecodePicturePipelined(const CJpegTask &task)
+{
+    Status umcRes;
+
+    umcRes = DecodePicture(task, 0, 0);
+
+    // let the helpers go even if the picture failed
+    m_dec[0]->FinishPipeline();
+
+    return umcRes;
+
+} // Status MJPEGVideoDecoderMFX::DecodePicturePipelined(const CJpegTask &task)
+
+int MJPEGVideoDecoderMFX::ProcessPipelinedRows(const mfxU32 threadNumber)
+{
+    return m_dec[0]->ProcessPipelinedRows((int) threadNumber);
+
+} // int MJPEGVideoDecoderMFX::ProcessPipelinedRows(const mfxU32 threadNumber)
+
 Status MJPEGVideoDecoderMFX::PostProcessing(double pts)
 {
     VideoData rotatedFrame;
@@ -37,6 +37,8 @@ public:
   int                    m_hclass;
   uint8_t                  m_bits[16];
   uint8_t                  m_vals[256];
+  // (code size << 16) | code for each symbol, zero if the symbol has no code
+  uint32_t                 m_hcs[256];
 
   CJPEGEncoderHuffmanTable(void);
   virtual ~CJPEGEncoderHuffmanTable(void);
@@ -37,6 +37,10 @@
 #include "colorcomp.h"
 #include "bitstreamout.h"
 
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
 
 class CBaseStreamOutput;
 
@@ -163,6 +167,28 @@ public:
   bool     IsACTableInited();
   bool     IsDCTableInited();
 
+  // Intra-scan pipeline. Baseline scans without restart intervals
+  // can not be split into pieces, so the threads calling
+  // ProcessPipelinedRows() color convert, downsample and transform MCU rows
+  // into a ring of coefficient buffers while the thread calling WriteData()
+  // entropy codes them in order. Must be configured before WriteHeader().
+  void     SetPipelineThreads(int numThreads);
+  int      GetPipelineThreads(void)    { return m_pipe_threads; }
+  // Arm the pipeline for the next picture
+  void     StartPipeline(void);
+  // Mark the current picture finished
+  void     FinishPipeline(void);
+  // Helper thread entry. Transforms the rows being available in the buffers
+  // of the given thread (1 .. threads - 1) without waiting for other rows.
+  // Returns the number of rows transformed, -1 when the current picture
+  // is finished.
+  int      ProcessPipelinedRows(int thread_id);
+
+  // Optimal tables of a baseline scan without restart intervals are
+  // generated while the symbols are buffered, the disabled single pass
+  // transforms the picture twice. Both produce the same bitstream.
+  void     SetHuffmanSinglePass(bool enable) { m_huff_single_pass = enable; }
+
 protected:
   IMAGE      m_src;
 
@@ -199,6 +225,12 @@ protected:
   int        m_optimal_htbl;
   JPEG_SCAN* m_scan_script;
 
+  // run/size symbols of the scan buffered by the single pass optimal
+  // tables generation, see GenerateHuffmanTablesEX()
+  std::vector<uint32_t> m_huff_symbols;
+  bool       m_huff_buffered;
+  bool       m_huff_single_pass;
+
   // Number of MCU already encoded
   uint32_t     m_mcu_encoded;
   // Number of MCU remain in the current VLC unit
@@ -226,6 +258,25 @@ protected:
 
   int16_t**   m_lastDC;
 
+  // intra-scan pipeline state, see EncodeScanBaselineMT()
+  enum
+  {
+    JPIPE_IDLE    = 0,
+    JPIPE_RUNNING = 1,
+    JPIPE_DONE    = 2
+  };
+
+  int                       m_pipe_threads;
+  int                       m_pipe_state;
+  uint32_t                  m_pipe_rows;      // ring depth in MCU rows
+  uint32_t                  m_pipe_claimed;   // rows handed out for transform
+  uint32_t                  m_pipe_completed; // rows transformed
+  uint32_t                  m_pipe_encoded;   // rows entropy coded
+  JERRCODE                  m_pipe_error;
+  std::vector<uint8_t>      m_pipe_ready;     // ring slot holds a row not yet entropy coded
+  std::mutex                m_pipe_guard;
+  std::condition_variable   m_pipe_cond;
+
   CJPEGEncoderHuffmanState*   m_state_t;
 
   CJPEGColorComponent        m_ccomp[MAX_COMPS_PER_SCAN];
@@ -236,8 +287,8 @@ protected:
 
   JERRCODE Init(void);
   JERRCODE Clean(void);
-  JERRCODE ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU/*int nMCURow, int thread_id = 0*/);
-  JERRCODE DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU/*int nMCURow, int thread_id = 0*/);
+  JERRCODE ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  JERRCODE DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
 
   JERRCODE WriteSOI(void);
   JERRCODE WriteEOI(void);
@@ -256,6 +307,7 @@ protected:
   JERRCODE WriteCOM(char* comment = 0);
 
   JERRCODE EncodeScanBaseline(void);
+  JERRCODE EncodeScanBaselineMT(void);   // MCU rows of a scan without restart intervals, pipelined across threads
 
   JERRCODE EncodeScanBaselineRSTI(void);
   JERRCODE EncodeScanBaselineRSTI_P(void);
@@ -273,6 +325,12 @@ protected:
   JERRCODE GenerateHuffmanTables(int ncomp,int id[MAX_COMPS_PER_SCAN],int Ss,int Se,int Ah,int Al);
   JERRCODE GenerateHuffmanTables(void);
   JERRCODE GenerateHuffmanTablesEX(void);
+  bool     IsHuffmanSinglePass(void);
+
+  // gather the statistics of a quantized block and buffer its symbols
+  void     BufferHuffmanSymbols8x8(const int16_t* pMCUBuf, int dcStatistics[256], int acStatistics[256], int16_t* pLastDC);
+  // encode the buffered symbols of the scan with the generated tables
+  JERRCODE EncodeHuffmanSymbols(void);
 
   JERRCODE ProcessRestart(int id[MAX_COMPS_PER_SCAN],int Ss,int Se,int Ah,int Al);
   JERRCODE ProcessRestart(int stat[2][256],int id[MAX_COMPS_PER_SCAN],int Ss,int Se,int Ah,int Al);
@@ -280,9 +338,17 @@ protected:
   JERRCODE EncodeHuffmanMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
   JERRCODE EncodeHuffmanMCURowLS(int16_t* pMCUBuf);
 
-  JERRCODE TransformMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU/*int16_t* pMCUBuf, int thread_id = 0*/);
+  JERRCODE TransformMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+
+  JERRCODE ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
 
-  JERRCODE ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU);//(int nMCURow, int thread_id = 0);
+  // color convert, downsample and transform one MCU row
+  JERRCODE ProcessMCURowBL(int16_t* pMCUBuf, uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id = 0);
+  // check if the next MCU row may be handed out for transform
+  bool     IsPipelinedRowAvailable(void);
+  // claim the next MCU row of the ring and transform it.
+  // The guard is released while the row is processed.
+  void     ProcessPipelinedRow(std::unique_lock<std::mutex> &guard, int thread_id);
   JERRCODE EncodeScanProgressive_P(void);
 
   JERRCODE TransformMCURowEX(int16_t* pMCUBuf, int thread_id = 0);
@@ -168,6 +168,23 @@ public:
     // 
     virtual Status EncodePiece(const mfxU32 threadNumber, const uint32_t numPiece);
 
+    // Check if the frame may be encoded by the intra-scan pipeline. It is used
+    // for single piece frames, which can't be split among the encoders.
+    bool IsPipelineAllowed(const uint32_t numPieces) const;
+
+    // Prepare the intra-scan pipeline for the next frame
+    void StartPipeline(void);
+
+    // Mark the frame of the intra-scan pipeline finished
+    void FinishPipeline(void);
+
+    // Entropy code the single piece by the intra-scan pipeline
+    Status EncodePiecePipelined(void);
+
+    // Transform MCU rows being available without waiting for other rows.
+    // Returns the number of rows transformed, -1 when the piece is finished.
+    int ProcessPipelinedRows(const mfxU32 threadNumber);
+
     // Get codec working (initialization) parameter(s)
     virtual Status GetInfo(BaseCodecParams *info);
 
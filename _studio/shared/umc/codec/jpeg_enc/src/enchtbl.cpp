@@ -35,6 +35,7 @@ CJPEGEncoderHuffmanTable::CJPEGEncoderHuffmanTable(void)
 
   memset(m_bits, 0, sizeof(m_bits));
   memset(m_vals, 0, sizeof(m_vals));
+  memset(m_hcs,  0, sizeof(m_hcs));
 
   return;
 } // ctor
@@ -86,6 +87,7 @@ JERRCODE CJPEGEncoderHuffmanTable::Destroy(void)
 
   memset(m_bits, 0, sizeof(m_bits));
   memset(m_vals, 0, sizeof(m_vals));
+  memset(m_hcs,  0, sizeof(m_hcs));
 
   if(0 != m_table)
   {
@@ -99,6 +101,8 @@ JERRCODE CJPEGEncoderHuffmanTable::Destroy(void)
 
 JERRCODE CJPEGEncoderHuffmanTable::Init(int id,int hclass,uint8_t* bits,uint8_t* vals)
 {
+  int      i, j, k;
+  uint32_t code;
   int status;
 
   m_id     = id     & 0x0f;
@@ -114,6 +118,20 @@ JERRCODE CJPEGEncoderHuffmanTable::Init(int id,int hclass,uint8_t* bits,uint8_t*
     return JPEG_ERR_INTERNAL;
   }
 
+  // keep the codes for the symbols buffered by the encoder,
+  // ISO/IEC 10918-1, Annex C. The table was validated above.
+  memset(m_hcs, 0, sizeof(m_hcs));
+
+  for(code = 0, k = 0, i = 0; i < 16; i++)
+  {
+    for(j = 0; j < m_bits[i]; j++, k++)
+    {
+      m_hcs[m_vals[k]] = ((uint32_t)(i + 1) << 16) | code;
+      code++;
+    }
+    code <<= 1;
+  }
+
   m_bValid = true;
 
   return JPEG_OK;
@@ -22,10 +22,49 @@
 #if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
 
 #include <string>
+#include <algorithm>
 
 #include "ippcc.h"
 #include "jpegbase.h"
 #include "jpegenc.h"
+#include "jpegkernels.h"
+
+// natural order index of the coefficients in zigzag order
+static const int own_izigzag[DCTSIZE2] =
+{
+   0,  1,  8, 16,  9,  2,  3, 10,
+  17, 24, 32, 25, 18, 11,  4,  5,
+  12, 19, 26, 33, 40, 48, 41, 34,
+  27, 20, 13,  6,  7, 14, 21, 28,
+  35, 42, 49, 56, 57, 50, 43, 36,
+  29, 22, 15, 23, 30, 37, 44, 51,
+  58, 59, 52, 45, 38, 31, 39, 46,
+  53, 60, 61, 54, 47, 55, 62, 63
+};
+
+// size category of a DC difference or an AC coefficient
+static inline int own_category(int data)
+{
+  unsigned int v = (data < 0) ? -data : data;
+  int ssss = 0;
+
+  while(v)
+  {
+    ssss++;
+    v >>= 1;
+  }
+
+  return ssss;
+} // own_category()
+
+// symbol in the high word, its additional bits in the low word
+static inline uint32_t own_symbol(int sym, int data, int ssss)
+{
+  if(data < 0)
+    data -= 1;
+
+  return ((uint32_t)sym << 16) | ((uint32_t)data & ((1u << ssss) - 1));
+} // own_symbol()
 
 
 CJPEGEncoder::CJPEGEncoder(void) : m_src()
@@ -77,6 +116,8 @@ CJPEGEncoder::CJPEGEncoder(void) : m_src()
   // 1 - to set generated table, 0 for default or external tables
   m_optimal_htbl      = 0;
   m_scan_script       = 0;
+  m_huff_buffered     = false;
+  m_huff_single_pass  = true;
 
   m_mcu_encoded       = 0;
   m_mcu_to_encode     = 0;
@@ -105,6 +146,14 @@ CJPEGEncoder::CJPEGEncoder(void) : m_src()
   m_BitStreamOutT = NULL;
   m_lastDC = NULL;
 
+  m_pipe_threads   = 1;
+  m_pipe_state     = JPIPE_IDLE;
+  m_pipe_rows      = 0;
+  m_pipe_claimed   = 0;
+  m_pipe_completed = 0;
+  m_pipe_encoded   = 0;
+  m_pipe_error     = JPEG_OK;
+
 
   return;
 } // ctor
@@ -1962,7 +2011,8 @@ JERRCODE CJPEGEncoder::Init(void)
   CJPEGColorComponent* curr_comp;
   JERRCODE  jerr;
 
-  m_num_threads = get_num_threads();
+  // the pipeline helpers use their own color convert and sampling buffers
+  m_num_threads = std::max(get_num_threads(), m_pipe_threads);
 
   m_ccWidth  = m_curr_scan.mcuWidth * m_curr_scan.numxMCU;
   m_ccHeight = m_curr_scan.mcuHeight;
@@ -2054,8 +2104,13 @@ JERRCODE CJPEGEncoder::Init(void)
   switch(m_jpeg_mode)
   {
   case JPEG_BASELINE:
-    if(!m_optimal_htbl)
-      tr_buf_size = m_curr_scan.numxMCU * m_nblock * DCTSIZE2 * sizeof(int16_t) * m_num_threads * m_rstiHeight;
+    // keep two rows per pipeline thread in flight
+    m_pipe_rows = (m_pipe_threads > 1 && !m_optimal_htbl) ? 2 * m_pipe_threads : 0;
+
+    // the optimal tables of a scan without restart intervals are generated
+    // in a single pass, which buffers symbols rather than coefficients
+    if(!m_optimal_htbl || IsHuffmanSinglePass())
+      tr_buf_size = m_curr_scan.numxMCU * m_nblock * DCTSIZE2 * sizeof(int16_t) * std::max<int>(m_num_threads * m_rstiHeight, m_pipe_rows);
     else
       tr_buf_size = m_curr_scan.numxMCU * m_curr_scan.numyMCU * m_nblock * DCTSIZE2 * sizeof(int16_t) * m_num_threads;
     break;
@@ -2088,6 +2143,10 @@ JERRCODE CJPEGEncoder::Init(void)
     memset((uint8_t*)m_block_buffer, 0, tr_buf_size);
   }
 
+  m_pipe_ready.assign(m_pipe_rows, 0);
+
+  m_huff_buffered = false;
+
   int buflen;
 
   buflen = (m_jpeg_mode == JPEG_LOSSLESS) ?
@@ -2106,7 +2165,7 @@ JERRCODE CJPEGEncoder::Init(void)
 } // CJPEGEncoder::Init()
 
 
-JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU/*int nMCURow, int thread_id*/)
+JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int       cc_h;
   int       srcStep;
@@ -2150,13 +2209,13 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
         if(m_src.precision <= 8)
         {
-          pDst8u = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
+          pDst8u = m_ccomp[0].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_8u_C1R(pSrc8u,srcStep,pDst8u,dstStep,roi);
         }
         else
         {
-          pDst16u = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
+          pDst16u = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_16s_C1R((int16_t*)pSrc16u,srcStep,(int16_t*)pDst16u,dstStep,roi);
         }
@@ -2180,17 +2239,17 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
         if(m_src.precision <= 8)
         {
-          pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-          pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-          pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+          pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+          pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+          pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_8u_C3P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
         }
         else
         {
-          pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-          pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-          pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+          pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
+          pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(thread_id);
+          pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_16s_C3P3R((int16_t*)pSrc16u,srcStep,(int16_t**)pDst16u,dstStep,roi);
         }
@@ -2214,19 +2273,19 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
         if(m_src.precision <= 8)
         {
-          pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-          pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-          pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
-          pDst8u[3] = m_ccomp[3].GetCCBufferPtr(0/*thread_id*/);
+          pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+          pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+          pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
+          pDst8u[3] = m_ccomp[3].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_8u_C4P4R(pSrc8u,srcStep,pDst8u,dstStep,roi);
         }
         else
         {
-          pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-          pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-          pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
-          pDst16u[3] = (uint16_t*)m_ccomp[3].GetCCBufferPtr(0/*thread_id*/);
+          pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
+          pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(thread_id);
+          pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(thread_id);
+          pDst16u[3] = (uint16_t*)m_ccomp[3].GetCCBufferPtr(thread_id);
 
           status = mfxiCopy_16s_C4P4R((int16_t*)pSrc16u,srcStep,(int16_t**)pDst16u,dstStep,roi);
         }
@@ -2256,13 +2315,13 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
     if(m_src.precision <= 8)
     {
-      pDst8u  = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
+      pDst8u  = m_ccomp[0].GetCCBufferPtr(thread_id);
 
       status  = mfxiCopy_8u_C1R(pSrc8u,srcStep,pDst8u,dstStep,roi);
     }
     else
     {
-      pDst16u = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
+      pDst16u = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
 
       status = mfxiCopy_16s_C1R((int16_t*)pSrc16u,srcStep,(int16_t*)pDst16u,dstStep,roi);
     }
@@ -2288,7 +2347,7 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u = m_ccomp[0].GetCCBufferPtr(thread_id);
 
     if(!pSrc8u)
     {
@@ -2315,17 +2374,17 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
     if(m_src.precision <= 8)
     {
-      pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+      pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+      pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
       status = mfxiCopy_8u_C3P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
     }
     else
     {
-      pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-      pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-      pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+      pDst16u[0] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
+      pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(thread_id);
+      pDst16u[2] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(thread_id);
 
       status = mfxiCopy_16s_C3P3R((int16_t*)pSrc16u,srcStep,(int16_t**)pDst16u,dstStep,roi);
     }
@@ -2349,17 +2408,17 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
     if(m_src.precision <= 8)
     {
-      pDst8u[2] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[0] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+      pDst8u[2] = m_ccomp[0].GetCCBufferPtr(thread_id);
+      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+      pDst8u[0] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
       status = mfxiCopy_8u_C3P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
     }
     else
     {
-      pDst16u[2] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-      pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-      pDst16u[0] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+      pDst16u[2] = (uint16_t*)m_ccomp[0].GetCCBufferPtr(thread_id);
+      pDst16u[1] = (uint16_t*)m_ccomp[1].GetCCBufferPtr(thread_id);
+      pDst16u[0] = (uint16_t*)m_ccomp[2].GetCCBufferPtr(thread_id);
 
       status = mfxiCopy_16s_C3P3R((int16_t*)pSrc16u,srcStep,(int16_t**)pDst16u,dstStep,roi);
     }
@@ -2382,23 +2441,11 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 
     if(m_src.precision <= 8)
     {
-      pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-      pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+      pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+      pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+      pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
-      for(int i=0; i<roi.height; i++)
-      {
-          for(int j=0; j<roi.width; j++)
-          {
-              pDst8u[0][j] = pSrc8u[j*4 + 2];
-              pDst8u[1][j] = pSrc8u[j*4 + 1];
-              pDst8u[2][j] = pSrc8u[j*4 + 0];
-          }
-          pDst8u[0] += dstStep;
-          pDst8u[1] += dstStep;
-          pDst8u[2] += dstStep;
-          pSrc8u += srcStep;
-      }
+      JPEG_BGRAToRGB_8u_C4P3R(pSrc8u, srcStep, pDst8u, dstStep, roi);
     }
     else
     {
@@ -2415,9 +2462,9 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
     if(JD_PIXEL == m_src.order)
     {
@@ -2459,9 +2506,9 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
     status = mfxiBGRToYCbCr_JPEG_8u_C3P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
 
@@ -2486,9 +2533,9 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
     status = mfxiRGBToYCbCr_JPEG_8u_C4P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
 
@@ -2517,9 +2564,9 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep[1] = m_ccomp[1].m_cc_step;
     dstStep[2] = m_ccomp[2].m_cc_step;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
 
     status = mfxiYCbCr422_8u_C2P3R(pSrc8u,srcStep,pDst8u,dstStep,roi);
 
@@ -2544,10 +2591,10 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[3] = m_ccomp[3].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
+    pDst8u[3] = m_ccomp[3].GetCCBufferPtr(thread_id);
 
     status = mfxiCopy_8u_C4P4R(pSrc8u,srcStep,pDst8u,dstStep,roi);
 
@@ -2572,10 +2619,10 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     dstStep = m_ccomp[0].m_cc_step;
     convert = 1;
 
-    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(0/*thread_id*/);
-    pDst8u[3] = m_ccomp[3].GetCCBufferPtr(0/*thread_id*/);
+    pDst8u[0] = m_ccomp[0].GetCCBufferPtr(thread_id);
+    pDst8u[1] = m_ccomp[1].GetCCBufferPtr(thread_id);
+    pDst8u[2] = m_ccomp[2].GetCCBufferPtr(thread_id);
+    pDst8u[3] = m_ccomp[3].GetCCBufferPtr(thread_id);
 
     status = mfxiCMYKToYCCK_JPEG_8u_C4P4R(pSrc8u,srcStep,pDst8u,dstStep,roi);
 
@@ -2593,7 +2640,7 @@ JERRCODE CJPEGEncoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 } // CJPEGEncoder::ColorConvert()
 
 
-JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU/*int nMCURow, int thread_id*/)
+JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int i, j, k;
   int cc_h;
@@ -2617,7 +2664,7 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       {
         if(m_src.precision <= 8)
         {
-          p = curr_comp->GetCCBufferPtr(0/*thread_id*/) + i*curr_comp->m_cc_step;
+          p = curr_comp->GetCCBufferPtr(thread_id) + i*curr_comp->m_cc_step;
           val = p[(maxMCU - colMCU) * 8 * curr_comp->m_hsampling - 1];
           for(j = 0; j < m_xPadding; j++)
           {
@@ -2628,7 +2675,7 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
         {
           uint16_t  v16;
           uint16_t* p16;
-          p16 = (uint16_t*)(curr_comp->GetCCBufferPtr(0/*thread_id*/) + i*curr_comp->m_cc_step);
+          p16 = (uint16_t*)(curr_comp->GetCCBufferPtr(thread_id) + i*curr_comp->m_cc_step);
           v16 = p16[(maxMCU - colMCU) * 8 * curr_comp->m_hsampling - 1];
           for(j = 0; j < m_xPadding; j++)
           {
@@ -2642,7 +2689,7 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     if(rowMCU == (uint32_t)m_numyMCU - 1)
     {
       cc_h = cc_h - m_yPadding;
-      p = curr_comp->GetCCBufferPtr(0/*thread_id*/) + (cc_h-1) * curr_comp->m_cc_step;
+      p = curr_comp->GetCCBufferPtr(thread_id) + (cc_h-1) * curr_comp->m_cc_step;
       p1 = p;
 
       for(i = 0; i < m_yPadding; i++)
@@ -2655,8 +2702,8 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
     // sampling 444
     if(curr_comp->m_h_factor == 1 && curr_comp->m_v_factor == 1)
     {
-      uint8_t* pSrc = curr_comp->GetCCBufferPtr(0/*thread_id*/);
-      uint8_t* pDst = curr_comp->GetSSBufferPtr(0/*thread_id*/);
+      uint8_t* pSrc = curr_comp->GetCCBufferPtr(thread_id);
+      uint8_t* pDst = curr_comp->GetSSBufferPtr(thread_id);
 
       MFX_INTERNAL_CPY(pDst,pSrc,curr_comp->m_cc_bufsize);
     }
@@ -2672,8 +2719,8 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       srcStep = curr_comp->m_cc_step;
       dstStep = curr_comp->m_ss_step;
 
-      pSrc = curr_comp->GetCCBufferPtr(0/*thread_id*/);
-      pDst = curr_comp->GetSSBufferPtr(0/*thread_id*/);
+      pSrc = curr_comp->GetCCBufferPtr(thread_id);
+      pDst = curr_comp->GetSSBufferPtr(thread_id);
 
       if(m_src.sampling == JS_422H)
       {
@@ -2718,8 +2765,8 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       srcStep = curr_comp->m_cc_step;
       srcWidth = (maxMCU - colMCU) * 8 * curr_comp->m_hsampling;
 
-      pSrc = curr_comp->GetCCBufferPtr(0/*thread_id*/);
-      pDst = curr_comp->GetSSBufferPtr(0/*thread_id*/);
+      pSrc = curr_comp->GetCCBufferPtr(thread_id);
+      pDst = curr_comp->GetSSBufferPtr(thread_id);
 
       for(i = 0; i < cc_h; i += 2)
       {
@@ -2742,7 +2789,7 @@ JERRCODE CJPEGEncoder::DownSampling(uint32_t rowMCU, uint32_t colMCU, uint32_t m
 } // CJPEGEncoder::DownSampling()
 
 
-JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU)//(int nMCURow, int thread_id)
+JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int                  i, j, c;
   int                  copyHeight;
@@ -2789,7 +2836,7 @@ JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t
       roi.width  = srcWidth;
       roi.height = copyHeight;
 
-      pDst8u = curr_comp->GetSSBufferPtr(0);//thread_id);
+      pDst8u = curr_comp->GetSSBufferPtr(thread_id);
 
       status = mfxiCopy_8u_C1R(pSrc8u, srcStep, pDst8u, curr_comp->m_ss_step, roi);
     }
@@ -2822,7 +2869,7 @@ JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t
           xPadd = (m_curr_scan.xPadding + 1) / 2;
         }
 
-        p     = curr_comp->GetSSBufferPtr(0/*thread_id*/) + i*curr_comp->m_ss_step;
+        p     = curr_comp->GetSSBufferPtr(thread_id) + i*curr_comp->m_ss_step;
         val   = p[width - xPadd - 1];
 
         for(j = 0; j < xPadd; j++)
@@ -2835,7 +2882,7 @@ JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t
     // expand bottom edge only for last MCU row
     if(rowMCU == (uint32_t)m_curr_scan.numyMCU - 1)
     {
-      p = curr_comp->GetSSBufferPtr(0/*thread_id*/) + (copyHeight - 1) * curr_comp->m_ss_step;
+      p = curr_comp->GetSSBufferPtr(thread_id) + (copyHeight - 1) * curr_comp->m_ss_step;
       p1 = p;
       uint32_t srcWidth = (maxMCU - colMCU) * m_curr_scan.mcuWidth / curr_comp->m_h_factor;
 
@@ -2851,7 +2898,7 @@ JERRCODE CJPEGEncoder::ProcessBuffer(uint32_t rowMCU, uint32_t colMCU, uint32_t
 } // CJPEGEncoder::ProcessBuffer()
 
 
-JERRCODE CJPEGEncoder::TransformMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU/*int     thread_id*/)
+JERRCODE CJPEGEncoder::TransformMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU, int thread_id)
 {
   int c;
   int vs;
@@ -2873,27 +2920,24 @@ JERRCODE CJPEGEncoder::TransformMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint
 
       srcStep = curr_comp->m_ss_step;
 
+      hs = m_curr_scan.mcuWidth / (8 * curr_comp->m_h_factor); // curr_comp->m_hsampling
+
       for(vs = 0; vs < m_curr_scan.mcuHeight / (8 * curr_comp->m_v_factor); vs++) // curr_comp->m_vsampling
       {
-        src  = curr_comp->GetSSBufferPtr(0/*thread_id*/) +
+        src  = curr_comp->GetSSBufferPtr(thread_id) +
                curr_mcu * m_curr_scan.mcuWidth / curr_comp->m_h_factor +  //8*curr_comp->m_hsampling
                8 * vs * srcStep;
 
-        for(hs = 0; hs < m_curr_scan.mcuWidth / (8 * curr_comp->m_h_factor); hs++) // curr_comp->m_hsampling
-        {
-          src += 8*hs;
-
-          status = mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R(
-                     src,srcStep,pMCUBuf,qtbl);
+        // the blocks of the row are adjacent, they are transformed together
+        status = JPEG_DCTQuantFwd8x8LS_8u16s_C1R(src, srcStep, pMCUBuf, qtbl, hs);
 
-          if(ippStsNoErr != status)
-          {
-            LOG0("Error: mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R() failed!");
-            return JPEG_ERR_INTERNAL;
-          }
+        if(ippStsNoErr != status)
+        {
+          LOG0("Error: JPEG_DCTQuantFwd8x8LS_8u16s_C1R() failed!");
+          return JPEG_ERR_INTERNAL;
+        }
 
-          pMCUBuf += DCTSIZE2;
-        } // for m_hsampling
+        pMCUBuf += DCTSIZE2 * hs;
       } // for m_vsampling
     } // for m_jpeg_ncomp
   } // for m_numxMCU
@@ -3423,6 +3467,7 @@ JERRCODE CJPEGEncoder::GenerateHuffmanTablesEX(void)
   CJPEGColorComponent*   curr_comp;
   JERRCODE  jerr;
   int status;
+  bool      single_pass;
 
   //m_next_restart_num = 0;
   //m_restarts_to_go   = m_jpeg_restart_interval;
@@ -3436,9 +3481,36 @@ JERRCODE CJPEGEncoder::GenerateHuffmanTablesEX(void)
   mfxsZero_8u((uint8_t*)dc_Statistics,sizeof(dc_Statistics));
   mfxsZero_8u((uint8_t*)ac_Statistics,sizeof(ac_Statistics));
 
+  // An interleaved scan without restart intervals is encoded by this encoder
+  // at once, so its symbols are buffered while the statistics are gathered
+  // and EncodeScanBaseline() doesn't transform the picture again.
+  single_pass = IsHuffmanSinglePass();
+
+  if(single_pass)
+  {
+    m_huff_symbols.clear();
+    m_huff_symbols.reserve(m_numxMCU * m_numyMCU * m_nblock * 4);
+
+    for(c = 0; c < m_jpeg_ncomp; c++)
+    {
+      m_ccomp[c].m_lastDC = 0;
+    }
+  }
+
   for(i = 0; i < m_numyMCU; i++)
   {
     pMCUBuf = m_block_buffer + i * m_numxMCU * m_nblock * DCTSIZE2;
+    if(single_pass)
+    {
+      // the row is consumed before the next one is transformed
+      pMCUBuf = m_block_buffer;
+
+      jerr = ProcessMCURowBL(pMCUBuf, i, 0, m_numxMCU);
+      if(JPEG_OK != jerr)
+        return jerr;
+    }
+    else
+    {
     if(JD_PIXEL == m_src.order)
     {
       jerr = ColorConvert(i, 0, m_numxMCU);
@@ -3469,6 +3541,7 @@ JERRCODE CJPEGEncoder::GenerateHuffmanTablesEX(void)
 
     if(JPEG_OK != jerr)
       return jerr;
+    }
 
     for(j = 0; j < m_numxMCU; j++)
     {
@@ -3500,8 +3573,16 @@ JERRCODE CJPEGEncoder::GenerateHuffmanTablesEX(void)
         {
           for(hs = 0; hs < curr_comp->m_hsampling; hs++)
           {
-            status = mfxiGetHuffmanStatistics8x8_JPEG_16s_C1(
-                       pMCUBuf, dc_Statistics[cc], ac_Statistics[cc], &m_ccomp[c].m_lastDC);
+            if(single_pass)
+            {
+              BufferHuffmanSymbols8x8(pMCUBuf, dc_Statistics[cc], ac_Statistics[cc], &m_ccomp[c].m_lastDC);
+              status = ippStsNoErr;
+            }
+            else
+            {
+              status = mfxiGetHuffmanStatistics8x8_JPEG_16s_C1(
+                         pMCUBuf, dc_Statistics[cc], ac_Statistics[cc], &m_ccomp[c].m_lastDC);
+            }
 
           if(ippStsNoErr > status)
           {
@@ -3622,10 +3703,191 @@ JERRCODE CJPEGEncoder::GenerateHuffmanTablesEX(void)
     }
   }
 
+  m_huff_buffered = single_pass;
+
   return JPEG_OK;
 } // CJPEGEncoder::GenerateHuffmanTablesEX()
 
 
+bool CJPEGEncoder::IsHuffmanSinglePass(void)
+{
+  return m_huff_single_pass && JPEG_BASELINE == m_jpeg_mode && 0 == m_jpeg_restart_interval && 1 == m_num_scans;
+
+} // CJPEGEncoder::IsHuffmanSinglePass()
+
+
+void CJPEGEncoder::BufferHuffmanSymbols8x8(
+  const int16_t* pMCUBuf,
+  int            dcStatistics[256],
+  int            acStatistics[256],
+  int16_t*       pLastDC)
+{
+  int i;
+  int r;
+  int rs;
+  int data;
+  int ssss;
+
+  data     = pMCUBuf[0] - *pLastDC;
+  *pLastDC = pMCUBuf[0];
+
+  ssss = own_category(data);
+
+  dcStatistics[ssss]++;
+  m_huff_symbols.push_back(own_symbol(ssss, data, ssss));
+
+  for(r = 0, i = 1; i < DCTSIZE2; i++)
+  {
+    data = pMCUBuf[own_izigzag[i]];
+
+    if(0 == data)
+    {
+      r++;
+      continue;
+    }
+
+    for(; r > 15; r -= 16)
+    {
+      acStatistics[0xf0]++;
+      m_huff_symbols.push_back(0xf0 << 16);
+    }
+
+    ssss = own_category(data);
+    rs   = (r << 4) + ssss;
+
+    acStatistics[rs]++;
+    m_huff_symbols.push_back(own_symbol(rs, data, ssss));
+
+    r = 0;
+  }
+
+  // end of block
+  if(r > 0)
+  {
+    acStatistics[0x00]++;
+    m_huff_symbols.push_back(0);
+  }
+
+  return;
+} // CJPEGEncoder::BufferHuffmanSymbols8x8()
+
+
+JERRCODE CJPEGEncoder::EncodeHuffmanSymbols(void)
+{
+  int       i, j, c, k;
+  int       vs;
+  int       hs;
+  int       rs;
+  int       dstLen;
+  int       currPos;
+  int       nbits = 0;
+  uint64_t  acc   = 0;
+  uint32_t  cs;
+  uint8_t*    dst;
+  uint8_t     byte;
+  const uint32_t* sym = m_huff_symbols.data();
+  CJPEGColorComponent* curr_comp;
+  JERRCODE  jerr;
+
+  dst     = m_BitStreamOut.GetDataPtr();
+  dstLen  = m_BitStreamOut.GetDataLen();
+  currPos = m_BitStreamOut.GetCurrPos();
+
+// append nb bits of the code to the accumulator and output the complete
+// bytes, stuffing a zero byte after 0xff
+#define PUT_BITS(code, nb)                      \
+  {                                             \
+    acc    = (acc << (nb)) | (code);            \
+    nbits += (nb);                              \
+    while(nbits >= 8)                           \
+    {                                           \
+      nbits -= 8;                               \
+      byte = (uint8_t)(acc >> nbits);             \
+      dst[currPos++] = byte;                    \
+      if(0xff == byte)                          \
+        dst[currPos++] = 0x00;                  \
+    }                                           \
+  }
+
+// the symbol must have a code in the generated table
+#define PUT_SYMBOL(tbl, s)                      \
+  {                                             \
+    if(currPos > dstLen - SAFE_NBYTES)          \
+    {                                           \
+      m_BitStreamOut.SetCurrPos(currPos);       \
+      jerr = m_BitStreamOut.FlushBuffer();      \
+      if(JPEG_OK != jerr)                       \
+        return jerr;                            \
+      currPos = m_BitStreamOut.GetCurrPos();    \
+    }                                           \
+    cs = (tbl).m_hcs[s];                        \
+    if(0 == cs)                                 \
+      return JPEG_ERR_DHT_DATA;                 \
+    PUT_BITS(cs & 0xffff, cs >> 16);            \
+  }
+
+  for(i = 0; i < m_numyMCU; i++)
+  {
+    for(j = 0; j < m_numxMCU; j++)
+    {
+      for(c = 0; c < m_jpeg_ncomp; c++)
+      {
+        curr_comp = &m_ccomp[c];
+
+        for(vs = 0; vs < curr_comp->m_vsampling; vs++)
+        {
+          for(hs = 0; hs < curr_comp->m_hsampling; hs++)
+          {
+            // DC difference
+            rs = *sym >> 16;
+            PUT_SYMBOL(m_dctbl[curr_comp->m_dc_selector], rs);
+            if(rs)
+              PUT_BITS(*sym & 0xffff, rs);
+            sym++;
+
+            // AC run/size pairs up to the last coefficient or end of block
+            for(k = 1; k < DCTSIZE2; sym++)
+            {
+              rs = *sym >> 16;
+              PUT_SYMBOL(m_actbl[curr_comp->m_ac_selector], rs);
+
+              if(0x00 == rs)
+              {
+                sym++;
+                break;
+              }
+
+              if(0xf0 == rs)
+              {
+                k += 16;
+                continue;
+              }
+
+              PUT_BITS(*sym & 0xffff, rs & 0x0f);
+              k += (rs >> 4) + 1;
+            }
+          } // for m_hsampling
+        } // for m_vsampling
+      } // for m_jpeg_ncomp
+    } // for numxMCU
+  } // for numyMCU
+
+  // pad the last byte with 1-bits
+  if(nbits)
+    PUT_BITS((1 << (8 - nbits)) - 1, 8 - nbits);
+
+#undef PUT_SYMBOL
+#undef PUT_BITS
+
+  m_BitStreamOut.SetCurrPos(currPos);
+
+  m_mcu_encoded  += m_numxMCU * m_numyMCU;
+  m_mcu_to_encode = 0;
+
+  return JPEG_OK;
+} // CJPEGEncoder::EncodeHuffmanSymbols()
+
+
 JERRCODE CJPEGEncoder::EncodeScan(
   int ncomp,
   int id[MAX_COMPS_PER_SCAN],
@@ -3978,6 +4240,25 @@ JERRCODE CJPEGEncoder::EncodeScanBaseline(void)
   }
 
 
+  // the scan was transformed while the optimal tables were generated
+  if(m_huff_buffered)
+  {
+    jerr = EncodeHuffmanSymbols();
+    if(JPEG_OK != jerr)
+    {
+        return jerr;
+    }
+  }
+  // the scan is a single piece, let the other threads transform its rows
+  else if(m_pipe_rows && 0 == m_jpeg_restart_interval)
+  {
+    jerr = EncodeScanBaselineMT();
+    if(JPEG_OK != jerr)
+    {
+        return jerr;
+    }
+  }
+  else
   {
     uint32_t  rowMCU, colMCU, maxMCU;
     int     thread_id = 0;
@@ -3998,30 +4279,7 @@ JERRCODE CJPEGEncoder::EncodeScanBaseline(void)
 
       if(rowMCU < (uint32_t)m_curr_scan.numyMCU)
       {
-        if(m_src.color == m_jpeg_color && JD_PLANE == m_src.order)
-        {
-          jerr = ProcessBuffer(rowMCU, colMCU, maxMCU);
-          if(JPEG_OK != jerr)
-          {
-              return jerr;
-          }
-        }
-        else
-        {
-          jerr = ColorConvert(rowMCU, colMCU, maxMCU);
-          if(JPEG_OK != jerr)
-          {
-              return jerr;
-          }
-
-          jerr = DownSampling(rowMCU, colMCU, maxMCU);
-          if(JPEG_OK != jerr)
-          {
-              return jerr;
-          }
-        }
-
-        jerr = TransformMCURowBL(pMCUBuf, colMCU, maxMCU);
+        jerr = ProcessMCURowBL(pMCUBuf, rowMCU, colMCU, maxMCU, thread_id);
         if(JPEG_OK != jerr)
         {
             return jerr;
@@ -4084,6 +4342,148 @@ JERRCODE CJPEGEncoder::EncodeScanBaseline(void)
 } // CJPEGEncoder::EncodeScanBaseline_P()
 
 
+JERRCODE CJPEGEncoder::ProcessMCURowBL(int16_t* pMCUBuf, uint32_t rowMCU, uint32_t colMCU, uint32_t maxMCU, int thread_id)
+{
+  JERRCODE jerr;
+
+  if(m_src.color == m_jpeg_color && JD_PLANE == m_src.order)
+  {
+    jerr = ProcessBuffer(rowMCU, colMCU, maxMCU, thread_id);
+    if(JPEG_OK != jerr)
+      return jerr;
+  }
+  else
+  {
+    jerr = ColorConvert(rowMCU, colMCU, maxMCU, thread_id);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    jerr = DownSampling(rowMCU, colMCU, maxMCU, thread_id);
+    if(JPEG_OK != jerr)
+      return jerr;
+  }
+
+  return TransformMCURowBL(pMCUBuf, colMCU, maxMCU, thread_id);
+
+} // CJPEGEncoder::ProcessMCURowBL()
+
+
+bool CJPEGEncoder::IsPipelinedRowAvailable(void)
+{
+  // a row may reuse the slot of a row which was entropy coded already
+  return JPEG_OK == m_pipe_error &&
+         m_pipe_claimed < (uint32_t)m_curr_scan.numyMCU &&
+         m_pipe_claimed < m_pipe_encoded + m_pipe_rows;
+
+} // CJPEGEncoder::IsPipelinedRowAvailable()
+
+
+void CJPEGEncoder::ProcessPipelinedRow(std::unique_lock<std::mutex> &guard, int thread_id)
+{
+  JERRCODE jerr;
+  uint32_t rowMCU = m_pipe_claimed++;
+  uint32_t slot   = rowMCU % m_pipe_rows;
+  int16_t* pMCUBuf = m_block_buffer + slot * m_curr_scan.numxMCU * m_nblock * DCTSIZE2;
+
+  // the row is owned by this thread until the slot is marked ready
+  guard.unlock();
+  jerr = ProcessMCURowBL(pMCUBuf, rowMCU, 0, m_curr_scan.numxMCU, thread_id);
+  guard.lock();
+
+  if(JPEG_OK != jerr && JPEG_OK == m_pipe_error)
+    m_pipe_error = jerr;
+
+  m_pipe_ready[slot] = 1;
+  m_pipe_completed += 1;
+
+  // only the entropy coding thread waits for transformed rows
+  m_pipe_cond.notify_one();
+
+} // CJPEGEncoder::ProcessPipelinedRow()
+
+
+JERRCODE CJPEGEncoder::EncodeScanBaselineMT(void)
+{
+  JERRCODE jerr = JPEG_OK;
+  uint32_t rowMCU;
+  uint32_t numyMCU = m_curr_scan.numyMCU;
+  uint32_t rowSize = m_curr_scan.numxMCU * m_nblock * DCTSIZE2;
+
+  // the helper threads pick up rows since now
+  {
+    std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+    m_pipe_claimed   = 0;
+    m_pipe_completed = 0;
+    m_pipe_encoded   = 0;
+    m_pipe_error     = JPEG_OK;
+    std::fill(m_pipe_ready.begin(), m_pipe_ready.end(), 0);
+
+    m_pipe_state = JPIPE_RUNNING;
+  }
+
+  for(rowMCU = 0; rowMCU < numyMCU; rowMCU++)
+  {
+    uint32_t slot    = rowMCU % m_pipe_rows;
+    int16_t* pMCUBuf = m_block_buffer + slot * rowSize;
+
+    // wait for the row to be transformed. The rows are handed out in order,
+    // so either it is in progress or it is the next one to claim. Transform
+    // rows here rather than sleeping, the helpers may be busy with other tasks
+    // and only pick up the rows available when they are called.
+    {
+      std::unique_lock<std::mutex> guard(m_pipe_guard);
+
+      while(!m_pipe_ready[slot] && JPEG_OK == m_pipe_error)
+      {
+        if(IsPipelinedRowAvailable())
+          ProcessPipelinedRow(guard, 0);
+        else
+          m_pipe_cond.wait(guard);
+      }
+
+      if(JPEG_OK != m_pipe_error)
+        break;
+    }
+
+    // the entropy coder is sequential, rows go to the bitstream in order
+    jerr = EncodeHuffmanMCURowBL(pMCUBuf, 0, m_curr_scan.numxMCU);
+    if(JPEG_OK != jerr)
+      break;
+
+    {
+      std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+      m_pipe_ready[slot] = 0;
+      m_pipe_encoded += 1;
+    }
+  }
+
+  // stop handing out rows on failure and wait for the rows in progress,
+  // they use the coefficient buffers
+  {
+    std::unique_lock<std::mutex> guard(m_pipe_guard);
+
+    if(JPEG_OK != jerr && JPEG_OK == m_pipe_error)
+      m_pipe_error = jerr;
+
+    while(m_pipe_completed < m_pipe_claimed)
+      m_pipe_cond.wait(guard);
+
+    jerr = m_pipe_error;
+  }
+
+  if(JPEG_OK != jerr)
+    return jerr;
+
+  m_mcu_encoded   += numyMCU * m_curr_scan.numxMCU;
+  m_mcu_to_encode  = 0;
+
+  return JPEG_OK;
+
+} // CJPEGEncoder::EncodeScanBaselineMT()
+
+
 JERRCODE CJPEGEncoder::EncodeScanExtended(void)
 {
   int i;
@@ -4615,6 +5015,55 @@ JERRCODE CJPEGEncoder::WriteData(void)
 } // CJPEGEncoder::WriteData()
 
 
+void CJPEGEncoder::SetPipelineThreads(int numThreads)
+{
+  m_pipe_threads = std::max(numThreads, 1);
+
+} // CJPEGEncoder::SetPipelineThreads()
+
+
+void CJPEGEncoder::StartPipeline(void)
+{
+  std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+  m_pipe_state     = JPIPE_IDLE;
+  m_pipe_claimed   = 0;
+  m_pipe_completed = 0;
+  m_pipe_encoded   = 0;
+
+} // CJPEGEncoder::StartPipeline()
+
+
+void CJPEGEncoder::FinishPipeline(void)
+{
+  std::lock_guard<std::mutex> guard(m_pipe_guard);
+
+  m_pipe_state = JPIPE_DONE;
+
+} // CJPEGEncoder::FinishPipeline()
+
+
+int CJPEGEncoder::ProcessPipelinedRows(int thread_id)
+{
+  std::unique_lock<std::mutex> guard(m_pipe_guard);
+  int rows = 0;
+
+  // buffers of thread 0 belong to the entropy coding thread
+  if(0 >= thread_id || thread_id >= m_pipe_threads)
+    return -1;
+
+  // don't wait for the entropy coder, the caller comes back later
+  while(JPIPE_RUNNING == m_pipe_state && IsPipelinedRowAvailable())
+  {
+    ProcessPipelinedRow(guard, thread_id);
+    rows++;
+  }
+
+  return (JPIPE_DONE == m_pipe_state && 0 == rows) ? -1 : rows;
+
+} // CJPEGEncoder::ProcessPipelinedRows()
+
+
 JERRCODE CJPEGEncoder::SetComment( int comment_size, char* comment)
 {
   if(comment_size > 65533)
@@ -231,6 +231,10 @@ Status MJPEGVideoEncoder::Init(BaseCodecParams* lpInit)
             m_pBitstreamBuffer[i].reset(new MediaData(m_EncoderParams.buf_size));
     }
 
+    // the first encoder runs the intra-scan pipeline on the threads of
+    // the other encoders
+    m_enc[0]->SetPipelineThreads(numThreads);
+
     if(m_frame)
         m_frame->Reset();
 
@@ -632,6 +636,39 @@ Status MJPEGVideoEncoder::EncodePiece(const mfxU32 threadNumber, const uint32_t
     return status;
 }
 
+bool MJPEGVideoEncoder::IsPipelineAllowed(const uint32_t numPieces) const
+{
+    return (1 == numPieces) &&
+           (1 < m_enc[0]->GetPipelineThreads());
+}
+
+void MJPEGVideoEncoder::StartPipeline(void)
+{
+    m_enc[0]->StartPipeline();
+}
+
+void MJPEGVideoEncoder::FinishPipeline(void)
+{
+    m_enc[0]->FinishPipeline();
+}
+
+Status MJPEGVideoEncoder::EncodePiecePipelined(void)
+{
+    Status umcRes;
+
+    umcRes = EncodePiece(0, 0);
+
+    // let the helpers go even if the piece failed
+    m_enc[0]->FinishPipeline();
+
+    return umcRes;
+}
+
+int MJPEGVideoEncoder::ProcessPipelinedRows(const mfxU32 threadNumber)
+{
+    return m_enc[0]->ProcessPipelinedRows((int) threadNumber);
+}
+
 Status MJPEGVideoEncoder::PostProcessing(MediaData* out)
 {
     if (!m_IsInit)
@@ -24,6 +24,7 @@
 
 #include "umc_media_data.h"
 #include "umc_mpeg2_splitter.h"
+#include "umc_start_code.h"
 
 namespace UMC_MPEG2_DECODER
 {
@@ -148,14 +149,10 @@ namespace UMC_MPEG2_DECODER
     // Find start code
     uint8_t * RawHeaderIterator::FindStartCode(uint8_t * begin, uint8_t * end)
     {
-        for (; begin < end - prefix_size; ++begin)
-        {
-            if (begin[0] == 0 && begin[1] == 0 && begin[2] == 1)
-            {
-                return begin;
-            }
-        }
-        return nullptr;
+        if (end <= begin || (size_t)(end - begin) <= prefix_size)
+            return nullptr;
+
+        return UMC::FindStartCodePrefix(begin, end - 1); // start code must be followed by at least one byte
     }
 
     // Find unit start, end and type
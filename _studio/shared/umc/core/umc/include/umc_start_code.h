@@ -0,0 +1,67 @@
+// Copyright (c) 2019 Intel Corporation
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_START_CODE_H__
+#define __UMC_START_CODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace UMC
+{
+
+// Searches [begin, end) for the first 0x00 0x00 0x01 start code prefix.
+// Returns the address of the prefix or nullptr if there is no complete prefix in range.
+// Implementation (C/SSE4/AVX2) is selected at runtime by the CPU features.
+const uint8_t * FindStartCodePrefix(const uint8_t * begin, const uint8_t * end);
+
+inline uint8_t * FindStartCodePrefix(uint8_t * begin, uint8_t * end)
+{
+    return const_cast<uint8_t *>(FindStartCodePrefix(static_cast<const uint8_t *>(begin), static_cast<const uint8_t *>(end)));
+}
+
+// Searches [begin, end) for the first 0x00 0x00 0x03 emulation prevention sequence.
+// Returns the address of the sequence or nullptr if there is no one in range.
+const uint8_t * FindEmulationPrevention(const uint8_t * begin, const uint8_t * end);
+
+// Copies nSrcSize bytes from pSource to pDestination removing emulation prevention bytes (0x03 of 0x000003).
+// Offsets (in source) of removed bytes are appended to pRemovedOffsets if it is not null.
+// Returns number of bytes written to pDestination.
+size_t RemoveEmulationPreventionBytes(uint8_t * pDestination, const uint8_t * pSource, size_t nSrcSize, std::vector<uint32_t> * pRemovedOffsets = nullptr);
+
+// Reverses order of bytes in each 32-bit word of the buffer, nSize must be multiple of 4
+void SwapDwords(uint8_t * pBuffer, size_t nSize);
+
+// CPU specific implementations, exposed for validation against the reference one
+const uint8_t * FindStartCodePrefix_C(const uint8_t * begin, const uint8_t * end);
+const uint8_t * FindStartCodePrefix_SSE4(const uint8_t * begin, const uint8_t * end);
+const uint8_t * FindEmulationPrevention_C(const uint8_t * begin, const uint8_t * end);
+const uint8_t * FindEmulationPrevention_SSE4(const uint8_t * begin, const uint8_t * end);
+void SwapDwords_C(uint8_t * pBuffer, size_t nSize);
+void SwapDwords_SSE4(uint8_t * pBuffer, size_t nSize);
+// AVX2 ones may be called only if the CPU supports AVX2
+const uint8_t * FindStartCodePrefix_AVX2(const uint8_t * begin, const uint8_t * end);
+const uint8_t * FindEmulationPrevention_AVX2(const uint8_t * begin, const uint8_t * end);
+void SwapDwords_AVX2(uint8_t * pBuffer, size_t nSize);
+
+} // namespace UMC
+
+#endif // __UMC_START_CODE_H__
@@ -0,0 +1,267 @@
+// Copyright (c) 2019 Intel Corporation
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_start_code.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+// AVX2 kernels are built regardless of the compiler flags and only called
+// when the CPU reports the support
+#define UMC_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace UMC
+{
+
+// All searches look for 0x00 0x00 <last> three byte sequences
+template <uint8_t last>
+static const uint8_t * FindZeroZeroByte_C(const uint8_t * begin, const uint8_t * end)
+{
+    if (end - begin < 3)
+        return nullptr;
+
+    for (const uint8_t * stop = end - 3; begin <= stop; ++begin)
+    {
+        // the third byte mismatches most of the time, if it is not zero no sequence
+        // can start at any of the three bytes
+        if (begin[2] != last)
+        {
+            if (begin[2])
+                begin += 2;
+            continue;
+        }
+
+        if (!begin[1] && !begin[0])
+            return begin;
+    }
+
+    return nullptr;
+}
+
+// Compares three shifted loads at once: bit N of the mask is set if the sequence starts at begin + N
+template <uint8_t last>
+static const uint8_t * FindZeroZeroByte_SSE4(const uint8_t * begin, const uint8_t * end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i byte = _mm_set1_epi8(last);
+
+    // each iteration reads 16 + 2 bytes
+    for (; end - begin >= 18; begin += 16)
+    {
+        const __m128i b2 = _mm_loadu_si128((const __m128i *)(begin + 2));
+        const __m128i eq2 = _mm_cmpeq_epi8(b2, byte);
+        if (!_mm_movemask_epi8(eq2))
+            continue;
+
+        const __m128i b0 = _mm_loadu_si128((const __m128i *)(begin));
+        const __m128i b1 = _mm_loadu_si128((const __m128i *)(begin + 1));
+
+        const __m128i match = _mm_and_si128(
+            _mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)), eq2);
+
+        const uint32_t mask = (uint32_t)_mm_movemask_epi8(match);
+        if (mask)
+            return begin + __builtin_ctz(mask);
+    }
+
+    return FindZeroZeroByte_C<last>(begin, end);
+}
+
+template <uint8_t last>
+static UMC_TARGET_AVX2 const uint8_t * FindZeroZeroByte_AVX2(const uint8_t * begin, const uint8_t * end)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i byte = _mm256_set1_epi8(last);
+
+    // each iteration reads 32 + 2 bytes
+    for (; end - begin >= 34; begin += 32)
+    {
+        const __m256i b2 = _mm256_loadu_si256((const __m256i *)(begin + 2));
+        const __m256i eq2 = _mm256_cmpeq_epi8(b2, byte);
+        if (!_mm256_movemask_epi8(eq2))
+            continue;
+
+        const __m256i b0 = _mm256_loadu_si256((const __m256i *)(begin));
+        const __m256i b1 = _mm256_loadu_si256((const __m256i *)(begin + 1));
+
+        const __m256i match = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpeq_epi8(b0, zero), _mm256_cmpeq_epi8(b1, zero)), eq2);
+
+        const uint32_t mask = (uint32_t)_mm256_movemask_epi8(match);
+        if (mask)
+            return begin + __builtin_ctz(mask);
+    }
+
+    return FindZeroZeroByte_SSE4<last>(begin, end);
+}
+
+const uint8_t * FindStartCodePrefix_C(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_C<1>(begin, end);
+}
+
+const uint8_t * FindStartCodePrefix_SSE4(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_SSE4<1>(begin, end);
+}
+
+const uint8_t * FindEmulationPrevention_C(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_C<3>(begin, end);
+}
+
+const uint8_t * FindEmulationPrevention_SSE4(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_SSE4<3>(begin, end);
+}
+
+void SwapDwords_C(uint8_t * pBuffer, size_t nSize)
+{
+    for (size_t i = 0; i + 4 <= nSize; i += 4)
+    {
+        uint32_t dword;
+        memcpy(&dword, pBuffer + i, sizeof(dword));
+        dword = __builtin_bswap32(dword);
+        memcpy(pBuffer + i, &dword, sizeof(dword));
+    }
+}
+
+void SwapDwords_SSE4(uint8_t * pBuffer, size_t nSize)
+{
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 16 <= nSize; i += 16)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i *)(pBuffer + i));
+        _mm_storeu_si128((__m128i *)(pBuffer + i), _mm_shuffle_epi8(data, shuffle));
+    }
+
+    SwapDwords_C(pBuffer + i, nSize - i);
+}
+
+UMC_TARGET_AVX2 const uint8_t * FindStartCodePrefix_AVX2(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_AVX2<1>(begin, end);
+}
+
+UMC_TARGET_AVX2 const uint8_t * FindEmulationPrevention_AVX2(const uint8_t * begin, const uint8_t * end)
+{
+    return FindZeroZeroByte_AVX2<3>(begin, end);
+}
+
+UMC_TARGET_AVX2 void SwapDwords_AVX2(uint8_t * pBuffer, size_t nSize)
+{
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                             3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    size_t i = 0;
+    for (; i + 32 <= nSize; i += 32)
+    {
+        const __m256i data = _mm256_loadu_si256((const __m256i *)(pBuffer + i));
+        _mm256_storeu_si256((__m256i *)(pBuffer + i), _mm256_shuffle_epi8(data, shuffle));
+    }
+
+    SwapDwords_SSE4(pBuffer + i, nSize - i);
+}
+
+typedef const uint8_t * (*FindSequenceFunc)(const uint8_t * begin, const uint8_t * end);
+typedef void (*SwapDwordsFunc)(uint8_t * pBuffer, size_t nSize);
+
+struct StartCodeDispatcher
+{
+    FindSequenceFunc FindStartCodePrefix;
+    FindSequenceFunc FindEmulationPrevention;
+    SwapDwordsFunc   SwapDwords;
+
+    StartCodeDispatcher()
+        : FindStartCodePrefix(FindStartCodePrefix_C)
+        , FindEmulationPrevention(FindEmulationPrevention_C)
+        , SwapDwords(SwapDwords_C)
+    {
+        if (__builtin_cpu_supports("avx2"))
+        {
+            FindStartCodePrefix     = FindStartCodePrefix_AVX2;
+            FindEmulationPrevention = FindEmulationPrevention_AVX2;
+            SwapDwords              = SwapDwords_AVX2;
+            return;
+        }
+
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            FindStartCodePrefix     = FindStartCodePrefix_SSE4;
+            FindEmulationPrevention = FindEmulationPrevention_SSE4;
+            SwapDwords              = SwapDwords_SSE4;
+        }
+    }
+};
+
+static const StartCodeDispatcher & GetDispatcher()
+{
+    static const StartCodeDispatcher dispatcher;
+    return dispatcher;
+}
+
+const uint8_t * FindStartCodePrefix(const uint8_t * begin, const uint8_t * end)
+{
+    return GetDispatcher().FindStartCodePrefix(begin, end);
+}
+
+const uint8_t * FindEmulationPrevention(const uint8_t * begin, const uint8_t * end)
+{
+    return GetDispatcher().FindEmulationPrevention(begin, end);
+}
+
+void SwapDwords(uint8_t * pBuffer, size_t nSize)
+{
+    GetDispatcher().SwapDwords(pBuffer, nSize);
+}
+
+size_t RemoveEmulationPreventionBytes(uint8_t * pDestination, const uint8_t * pSource, size_t nSrcSize, std::vector<uint32_t> * pRemovedOffsets)
+{
+    const StartCodeDispatcher & dispatcher = GetDispatcher();
+
+    const uint8_t * src = pSource;
+    const uint8_t * end = pSource + nSrcSize;
+    uint8_t * dst = pDestination;
+
+    // copy runs between emulation prevention bytes, most of slices are copied at once
+    for (const uint8_t * prevent = dispatcher.FindEmulationPrevention(src, end);
+         prevent;
+         prevent = dispatcher.FindEmulationPrevention(src, end))
+    {
+        const size_t run = prevent + 2 - src;
+        memcpy(dst, src, run);
+        dst += run;
+
+        if (pRemovedOffsets)
+            pRemovedOffsets->push_back(uint32_t(prevent + 2 - pSource));
+
+        // skip 0x03, next sequence can't overlap it
+        src = prevent + 3;
+    }
+
+    memcpy(dst, src, end - src);
+    dst += end - src;
+
+    return dst - pDestination;
+}
+
+} // namespace UMC
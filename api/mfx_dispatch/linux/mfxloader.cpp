@@ -21,10 +21,13 @@
 #include <assert.h>
 #include <dlfcn.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <iterator>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -156,14 +159,180 @@ private:
   std::list<PluginCtx> m_plugins;
 };
 
+// Identifies file contents well enough to notice that a library or a config
+// file was replaced on disk. Zeroed for files which can't be stat'ed.
+struct FileStamp
+{
+  dev_t dev{};
+  ino_t ino{};
+  off_t size{};
+  time_t mtime{};
+  long mtime_nsec{};
+
+  FileStamp() = default;
+
+  explicit FileStamp(const char* path)
+  {
+    struct stat st;
+
+    if (path && !stat(path, &st)) {
+      dev = st.st_dev;
+      ino = st.st_ino;
+      size = st.st_size;
+      mtime = st.st_mtim.tv_sec;
+      mtime_nsec = st.st_mtim.tv_nsec;
+    }
+  }
+
+  inline bool operator == (const FileStamp& other) const {
+    return dev == other.dev && ino == other.ino && size == other.size &&
+           mtime == other.mtime && mtime_nsec == other.mtime_nsec;
+  }
+
+  inline bool operator != (const FileStamp& other) const {
+    return !(*this == other);
+  }
+};
+
+// Library which was successfully initialized, along with its resolved
+// functions table. Sessions share the handle, so the next sessions get it
+// and skip symbols resolution. Entry itself doesn't keep the library loaded,
+// see GlobalCtx::keepLoaded() for that.
+struct LibraryInfo
+{
+  std::weak_ptr<void> m_dlh;
+  void* m_table[eFunctionsNum]{};
+  FileStamp m_stamp;
+};
+
+// Stamp of the file the library was loaded from, the path is taken from
+// one of the resolved symbols.
+static FileStamp getLibraryStamp(void* const* table)
+{
+  Dl_info info{};
+
+  if (!table[eMFXInitEx] || !dladdr(table[eMFXInitEx], &info)) {
+    return FileStamp();
+  }
+  return FileStamp(info.dli_fname);
+}
+
 struct GlobalCtx
 {
   std::mutex m_mutex;
   std::list<PluginInfo> m_plugins;
+  FileStamp m_plugins_stamp;
+
+  void dropReplacedLibrary(const std::string& name);
+  std::shared_ptr<LibraryInfo> getLibrary(const std::string& name, std::shared_ptr<void>& dlh);
+  void putLibrary(const std::string& name, const std::shared_ptr<void>& dlh, void* const* table);
+  void keepLoaded(const std::shared_ptr<void>& dlh);
+
+private:
+  // Applications normally use one runtime, hardware or software one, so
+  // few most recently initialized libraries are enough to be kept.
+  static const size_t kKeepLoaded = 2;
+
+  void unkeepLoaded(void* handle, std::list<std::shared_ptr<void>>& released);
+
+  std::map<std::string, std::shared_ptr<LibraryInfo>> m_libs;
+  // Libraries kept loaded after their last session is closed, most recently
+  // initialized first. Otherwise short sessions opened one after another
+  // would load and resolve the library each time.
+  std::list<std::shared_ptr<void>> m_loaded;
 };
 
 static GlobalCtx g_GlobalCtx;
 
+void GlobalCtx::unkeepLoaded(void* handle, std::list<std::shared_ptr<void>>& released)
+{
+  auto it = std::find_if(m_loaded.begin(), m_loaded.end(),
+    [handle](const std::shared_ptr<void>& loaded){ return loaded.get() == handle; });
+
+  if (it != m_loaded.end()) {
+    released.splice(released.end(), m_loaded, it);
+  }
+}
+
+// Library which was replaced on disk is not kept loaded anymore, otherwise
+// dlopen() would return the old one. Sessions which use it still keep it.
+void GlobalCtx::dropReplacedLibrary(const std::string& name)
+{
+  // Released libraries are closed out of the mutex.
+  std::list<std::shared_ptr<void>> released;
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_libs.find(name);
+  if (it == m_libs.end()) {
+    return;
+  }
+
+  std::shared_ptr<void> loaded = it->second->m_dlh.lock();
+  if (loaded && it->second->m_stamp == getLibraryStamp(it->second->m_table)) {
+    return;
+  }
+
+  if (loaded) {
+    unkeepLoaded(loaded.get(), released);
+  }
+  m_libs.erase(it);
+}
+
+// Looks for the library opened by dlh in the sessions being open and in the
+// libraries kept loaded. On success dlh is replaced by the shared handle.
+std::shared_ptr<LibraryInfo> GlobalCtx::getLibrary(const std::string& name, std::shared_ptr<void>& dlh)
+{
+  std::list<std::shared_ptr<void>> released;
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_libs.find(name);
+  if (it == m_libs.end()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<void> loaded = it->second->m_dlh.lock();
+  if (loaded && loaded.get() == dlh.get() &&
+      it->second->m_stamp == getLibraryStamp(it->second->m_table)) {
+    dlh = std::move(loaded);
+    return it->second;
+  }
+
+  // Library was closed by the last session, replaced or the name now
+  // refers to another one: drop the entry.
+  if (loaded) {
+    unkeepLoaded(loaded.get(), released);
+  }
+  m_libs.erase(it);
+  return nullptr;
+}
+
+void GlobalCtx::putLibrary(const std::string& name, const std::shared_ptr<void>& dlh, void* const* table)
+{
+  std::shared_ptr<LibraryInfo> lib = std::make_shared<LibraryInfo>();
+
+  lib->m_dlh = dlh;
+  std::copy(table, table + eFunctionsNum, lib->m_table);
+  lib->m_stamp = getLibraryStamp(table);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_libs[name].swap(lib);
+}
+
+// Marks the library as the most recently initialized one. The least recently
+// initialized library above the limit is closed along with its last session.
+void GlobalCtx::keepLoaded(const std::shared_ptr<void>& dlh)
+{
+  std::list<std::shared_ptr<void>> released;
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  unkeepLoaded(dlh.get(), released);
+  m_loaded.push_front(dlh);
+
+  if (m_loaded.size() > kKeepLoaded) {
+    released.splice(released.end(), m_loaded, std::prev(m_loaded.end()));
+  }
+}
+
 std::shared_ptr<void> make_dlopen(const char* filename, int flags)
 {
   return std::shared_ptr<void>(
@@ -199,14 +368,20 @@ mfxStatus LoaderCtx::Init(mfxInitParam& par)
   mfxStatus mfx_res = MFX_ERR_UNSUPPORTED;
 
   for (auto& lib: libs) {
+    g_GlobalCtx.dropReplacedLibrary(lib);
+
     std::shared_ptr<void> hdl = make_dlopen(lib.c_str(), RTLD_LOCAL|RTLD_NOW);
     if (hdl) {
+      // Library which is used by other sessions or kept loaded has its
+      // functions table resolved.
+      std::shared_ptr<LibraryInfo> cached = g_GlobalCtx.getLibrary(lib, hdl);
+
       do {
         /* Loading functions table */
         bool wrong_version = false;
         for (int i = 0; i < eFunctionsNum; ++i) {
           assert(i == g_mfxFuncTable[i].id);
-          m_table[i] = dlsym(hdl.get(), g_mfxFuncTable[i].name);
+          m_table[i] = (cached)? cached->m_table[i]: dlsym(hdl.get(), g_mfxFuncTable[i].name);
           if (!m_table[i] && ((par.Version <= g_mfxFuncTable[i].version) ||
                 (g_mfxFuncTable[i].version <= mfxVersion(VERSION(1, 14))))) {
             // this version of dispatcher requires MFXInitEx which appeared
@@ -246,6 +421,10 @@ mfxStatus LoaderCtx::Init(mfxInitParam& par)
       } while(false);
 
       if (MFX_ERR_NONE == mfx_res) {
+        if (!cached) {
+          g_GlobalCtx.putLibrary(lib, hdl, m_table);
+        }
+        g_GlobalCtx.keepLoaded(hdl);
         m_dlh = std::move(hdl);
         break;
       } else {
@@ -449,10 +628,16 @@ mfxStatus MFXVideoUSER_Load(mfxSession session, const mfxPluginUID *uid, mfxU32
           );
       };
 
-      if (MFX::g_GlobalCtx.m_plugins.empty()) {
+      const char* plugins_cfg = MFX_PLUGINS_CONF_DIR "/plugins.cfg";
+      MFX::FileStamp stamp(plugins_cfg);
+
+      if (MFX::g_GlobalCtx.m_plugins.empty() || MFX::g_GlobalCtx.m_plugins_stamp != stamp) {
         // Parsing plugin configuration file and loading information of
-        // _all_ plugins registered on the system.
-        parse(MFX_PLUGINS_CONF_DIR "/plugins.cfg", MFX::g_GlobalCtx.m_plugins);
+        // _all_ plugins registered on the system. Parsed list is reused
+        // by all sessions till the file is changed.
+        MFX::g_GlobalCtx.m_plugins.clear();
+        MFX::g_GlobalCtx.m_plugins_stamp = stamp;
+        parse(plugins_cfg, MFX::g_GlobalCtx.m_plugins);
       }
 
       // search for plugin description
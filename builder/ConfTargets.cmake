@@ -48,6 +48,11 @@ if (ENABLE_STAT)
   append("-DMFX_TRACE_ENABLE_STAT" CMAKE_CXX_FLAGS)
 endif()
 
+if (ENABLE_BINLOG)
+  append("-DMFX_TRACE_ENABLE_BINLOG" CMAKE_C_FLAGS)
+  append("-DMFX_TRACE_ENABLE_BINLOG" CMAKE_CXX_FLAGS)
+endif()
+
 option( MFX_ENABLE_KERNELS "Build with advanced media kernels support?" ON )
 if(CMAKE_SIZEOF_VOID_P EQUAL 8)
   option( MFX_ENABLE_SW_FALLBACK "Enabled software fallback for codecs?" ON )
@@ -107,6 +112,8 @@ option( MFX_ENABLE_VP9_VIDEO_ENCODE "Enable VP9 encoder?" ON)
 
 option( MFX_ENABLE_ASC "Enable ASC support?"  ON )
 
+option( MFX_ENABLE_SCHEDULER_WORK_STEALING "Run library threads with per-thread ready queues and work stealing?" OFF )
+
 cmake_dependent_option(
   MFX_ENABLE_MCTF "Build with MCTF support?"  ${MFX_1_25_OPTIONS_ALLOWED}
   "MFX_ENABLE_ASC;MFX_ENABLE_KERNELS" OFF)
@@ -24,9 +24,12 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include <string>
 #include <sstream>
 #include <vector>
+#include <deque>
 #include <map>
 #include <stdexcept>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <algorithm>
 
 #include "mfxstructures.h"
@@ -47,6 +50,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "vm/thread_defs.h"
 
 #include "sample_types.h"
+#include "time_statistics.h"
 
 #include "abstract_splitter.h"
 #include "avc_bitstream.h"
@@ -664,6 +668,15 @@ public:
         Data      = m_data.data();
         MaxLength = n_bytes;
     }
+
+    // exchanges the storage with an external buffer (e.g. one taken from a pool), data isn't copied
+    void SwapBuffer(std::vector<mfxU8>& data)
+    {
+        m_data.swap(data);
+
+        Data      = m_data.empty() ? NULL : m_data.data();
+        MaxLength = (mfxU32)m_data.size();
+    }
 private:
     std::vector<mfxU8> m_data;
 };
@@ -679,11 +692,18 @@ public :
     virtual mfxStatus Init(std::list<msdk_string> inputs, mfxU32 ColorFormat, bool shouldShiftP010=false);
     virtual mfxStatus LoadNextFrame(mfxFrameSurface1* pSurface);
     virtual void Reset();
+    // copy frames from memory mapped input files instead of reading them, must be set before Init
+    void EnableMapping(bool bUseMapping) { m_bUseMapping = bUseMapping; }
     mfxU32 m_ColorFormat; // color format of input YUV data, YUV420 or NV12
 
 protected:
+    // fread-like helper, takes the data from the mapped view if the file is mapped
+    mfxU32 ReadFromFile(void* pDst, mfxU32 size, mfxU32 count, mfxU32 vid);
 
     std::vector<FILE*> m_files;
+    std::vector<msdk_file_map> m_maps;
+    std::vector<mfxU64> m_mapPos;
+    bool m_bUseMapping;
 
     bool shouldShift10BitsHigh;
     bool m_bInited;
@@ -743,10 +763,22 @@ public :
     virtual void      Close();
     virtual mfxStatus Init(const msdk_char *strFileName);
     virtual mfxStatus ReadNextFrame(mfxBitstream *pBS);
+    // point bitstreams at the memory mapped input file instead of reading it, must be set before Init.
+    // The file is mapped read-only (PROT_READ): pBS->Data returned by ReadNextFrame must not be
+    // written or freed, patching the bitstream in place faults. Copy the data to modify it.
+    void EnableMapping(bool bUseMapping) { m_bUseMapping = bUseMapping; }
+    bool IsMapped() const { return NULL != m_map.data; }
 
 protected:
+    mfxStatus MapNextFrame(mfxBitstream *pBS);
+
     FILE*     m_fSource;
     bool      m_bInited;
+    bool      m_bUseMapping;
+    msdk_file_map m_map;
+    // file offset of pBS->Data passed to the last MapNextFrame
+    mfxU64    m_mapWindow;
+    bool      m_bMapRestart;
 };
 
 class CH264FrameReader : public CSmplBitstreamReader
@@ -800,6 +832,7 @@ public:
     virtual mfxStatus ReadNextFrame(mfxBitstream *pBS);
 
 protected:
+    mfxStatus MapNextFrame(mfxBitstream *pBS);
 
       /*bytes 0-3    signature: 'DKIF'
     bytes 4-5    version (should be 0)
@@ -1068,6 +1101,111 @@ mfxU16 GetFreeSurfaceIndex(T* pSurfacesPool, mfxU16 nPoolSize)
 mfxU16 GetFreeSurface(mfxFrameSurface1* pSurfacesPool, mfxU16 nPoolSize);
 void FreeSurfacePool(mfxFrameSurface1* pSurfacesPool, mfxU16 nPoolSize);
 
+// Pool of surfaces which keeps a list of free surfaces. Surfaces handed out
+// are kept in the order they were taken; the library returns them roughly in
+// submission order, so they are taken back from the oldest one when the free
+// list runs out. When no surface is free the pool calls the sync callback,
+// which should wait for a task of the pipeline as the library unlocks surfaces
+// when its tasks complete. Without a task to wait for, the caller waits for
+// NotifySurfaceUnlocked() from the threads releasing surfaces of the pool.
+class CSmplSurfacePool
+{
+public:
+    // returns false if there is no task to wait for
+    typedef std::function<bool()> SyncCallback;
+
+    CSmplSurfacePool();
+    virtual ~CSmplSurfacePool() {}
+
+    void Init(mfxFrameSurface1* pSurfaces, mfxU16 nPoolSize);
+    void Init(mfxFrameSurface1** ppSurfaces, mfxU16 nPoolSize);
+    void Close();
+
+    // the callback is kept across Init and Close, it is called without the pool being locked
+    void SetSyncCallback(const SyncCallback& sync) { m_Sync = sync; }
+
+    // returns index of a free surface or MSDK_INVALID_SURF_IDX if no surface was unlocked within timeout (ms)
+    mfxU16 GetFreeSurfaceIndex(mfxU32 timeout);
+    mfxFrameSurface1* GetFreeSurface(mfxU32 timeout);
+    mfxU16 GetSize() const { return (mfxU16)m_Surfaces.size(); }
+
+    // wakes up waiting threads, should be called when the application unlocks a surface of the pool
+    void NotifySurfaceUnlocked();
+    // interrupts current and future waits until the next Init
+    void CancelWaiting();
+
+    CTimeStatisticsReal& GetStallStatistics() { return m_StallStat; }
+
+protected:
+    // moves surfaces unlocked since they were taken to the free list
+    void   Reclaim();
+    mfxU16 TakeFreeSurface();
+
+    std::vector<mfxFrameSurface1*> m_Surfaces;
+    std::vector<mfxU16>            m_Free;       // indices of free surfaces
+    std::deque<mfxU16>             m_Taken;      // indices of taken surfaces, the oldest first
+    mfxU64                         m_nNotifications;
+    bool                           m_bCancelled;
+    SyncCallback                   m_Sync;
+    std::mutex                     m_mutex;
+    std::condition_variable        m_cond;
+    CTimeStatisticsReal            m_StallStat;
+
+private:
+    CSmplSurfacePool(const CSmplSurfacePool&);
+    void operator=(const CSmplSurfacePool&);
+};
+
+// Paces submission of asynchronous tasks of one pipeline component instead of sleeping on MFX_WRN_DEVICE_BUSY.
+// Sync points of the submitted tasks are kept and the oldest one is waited for when the device is busy or
+// when number of tasks in flight reaches the depth. The depth is adapted to completion latency of the tasks.
+// Not thread safe, the component should be driven by one thread.
+class CSmplSubmitController
+{
+public:
+    CSmplSubmitController();
+    virtual ~CSmplSubmitController() {}
+
+    void Init(mfxU16 nMaxDepth);
+    // forgets tasks in flight, should be called when the session is re-created
+    void Reset();
+
+    // registers task which was just submitted
+    void TaskSubmitted(mfxSyncPoint syncp);
+    // waits for the oldest tasks while number of tasks in flight reaches the depth, call before submission
+    mfxStatus WaitForSlot(MFXVideoSession& session, mfxU32 timeout);
+    // waits until the device may accept a task, call on MFX_WRN_DEVICE_BUSY and repeat submission
+    mfxStatus WaitForDevice(MFXVideoSession& session, mfxU32 timeout);
+    // waits for the oldest task in flight, call when resources held by the tasks are needed,
+    // e.g. no surface is free. Returns MFX_ERR_NOT_FOUND if there is no task to wait for
+    mfxStatus WaitForOldest(MFXVideoSession& session, mfxU32 timeout);
+
+    mfxU16 GetDepth() const { return m_nDepth; }
+    // returns time in seconds spent in waits since the previous call
+    mfxF64 TakeBusyWaitTime();
+
+protected:
+    struct Task
+    {
+        mfxSyncPoint syncp;
+        msdk_tick    submitted;
+    };
+
+    mfxStatus SyncOldest(MFXVideoSession& session, mfxU32 timeout);
+
+    std::deque<Task> m_Tasks;       // oldest first
+    mfxU16           m_nMaxDepth;
+    mfxU16           m_nDepth;
+    mfxU16           m_nCredits;    // tasks completed early or in usual time since the depth was changed
+    mfxU32           m_nBackOff;    // sleep in us when the device is busy but there is no task to wait for
+    mfxF64           m_fLatency;    // smoothed completion latency in seconds
+    msdk_tick        m_nBusyTicks;
+
+private:
+    CSmplSubmitController(const CSmplSubmitController&);
+    void operator=(const CSmplSubmitController&);
+};
+
 mfxU16 CalculateDefaultBitrate(mfxU32 nCodecId, mfxU32 nTargetUsage, mfxU32 nWidth, mfxU32 nHeight, mfxF64 dFrameRate);
 
 //serialization fnc set
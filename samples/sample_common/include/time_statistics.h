@@ -25,8 +25,125 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "math.h"
 #include <vector>
 #include <stdio.h>
+#include <string.h>
 
 
+// Streaming summary of measured times (in seconds). Takes constant memory: running mean and
+// variance plus a log-linear histogram with 16 bins per power of two for the percentiles,
+// so they are precise up to 1/32 of the value.
+class CTimeStatisticsSummary
+{
+public:
+    enum
+    {
+        MIN_EXP      = -20, // 2^-20 s ~ 1 us, shorter times go to the first bin
+        MAX_EXP      = 8,   // 2^8 s = 256 s, longer times go to the last bin
+        SUB_BINS_LOG = 4,
+        SUB_BINS     = 1 << SUB_BINS_LOG,
+        NUM_BINS     = (MAX_EXP - MIN_EXP) * SUB_BINS
+    };
+
+    CTimeStatisticsSummary()
+    {
+        Reset();
+    }
+
+    inline void Reset()
+    {
+        numMeasurements = 0;
+        totalTime = 0;
+        mean = 0;
+        m2 = 0;
+        minTime = 1E100;
+        maxTime = -1;
+        memset(bins, 0, sizeof(bins));
+    }
+
+    inline void Add(mfxF64 delta)
+    {
+        numMeasurements++;
+        totalTime += delta;
+
+        // Welford's update doesn't lose precision on long runs unlike the sum of squares
+        mfxF64 diff = delta - mean;
+        mean += diff / numMeasurements;
+        m2 += diff * (delta - mean);
+
+        if (delta < minTime)
+            minTime = delta;
+        if (delta > maxTime)
+            maxTime = delta;
+
+        bins[GetBin(delta)]++;
+    }
+
+    inline mfxU64 GetNumMeasurements() const { return numMeasurements; }
+    inline mfxF64 GetTotalTime() const       { return totalTime; }
+    inline mfxF64 GetAvgTime() const         { return numMeasurements ? mean : 0; }
+    inline mfxF64 GetMinTime() const         { return numMeasurements ? minTime : 0; }
+    inline mfxF64 GetMaxTime() const         { return numMeasurements ? maxTime : 0; }
+
+    inline mfxF64 GetTimeStdDev() const
+    {
+        return numMeasurements ? sqrt(m2 / numMeasurements) : 0;
+    }
+
+    // q is in [0, 1], e.g. 0.99 for the 99th percentile
+    inline mfxF64 GetPercentile(mfxF64 q) const
+    {
+        if (!numMeasurements)
+            return 0;
+
+        mfxU64 rank = (mfxU64)ceil(q * numMeasurements);
+        rank = rank ? (rank > numMeasurements ? numMeasurements : rank) : 1;
+
+        mfxU64 count = 0;
+        for (mfxU32 i = 0; i < NUM_BINS; i++)
+        {
+            count += bins[i];
+            if (count >= rank)
+            {
+                mfxF64 value = GetBinValue(i);
+                return value < minTime ? minTime : (value > maxTime ? maxTime : value);
+            }
+        }
+        return maxTime;
+    }
+
+protected:
+    static inline mfxU32 GetBin(mfxF64 delta)
+    {
+        if (!(delta > 0))
+            return 0;
+
+        int exp = 0;
+        mfxF64 mant = frexp(delta, &exp); // delta = mant * 2^exp, mant is in [0.5, 1)
+        if (exp <= MIN_EXP)
+            return 0;
+        if (exp > MAX_EXP)
+            return NUM_BINS - 1;
+
+        mfxU32 sub = (mfxU32)((mant - 0.5) * 2 * SUB_BINS);
+        return (exp - MIN_EXP - 1) * SUB_BINS + (sub < SUB_BINS ? sub : SUB_BINS - 1);
+    }
+
+    // middle of the bin
+    static inline mfxF64 GetBinValue(mfxU32 bin)
+    {
+        int exp = (int)(bin >> SUB_BINS_LOG) + MIN_EXP + 1;
+        mfxF64 mant = 0.5 + ((bin & (SUB_BINS - 1)) + 0.5) / (2 * SUB_BINS);
+        return ldexp(mant, exp);
+    }
+
+    mfxU64 numMeasurements;
+    mfxF64 totalTime;
+    mfxF64 mean;
+    mfxF64 m2;
+    mfxF64 minTime;
+    mfxF64 maxTime;
+    mfxU64 bins[NUM_BINS];
+};
+
 class CTimeStatisticsReal
 {
 public:
@@ -59,22 +176,11 @@ public:
     inline void StopTimeMeasurement()
     {
         mfxF64 delta=GetDeltaTime();
-        totalTime+=delta;
-        totalTimeSquares+=delta*delta;
+        m_total.Add(delta);
+        m_interval.Add(delta);
         // dump in ms:
         if(m_bNeedDumping)
             m_time_deltas.push_back(delta * 1000);
-
-        if(delta<minTime)
-        {
-            minTime=delta;
-        }
-
-        if(delta>maxTime)
-        {
-            maxTime=delta;
-        }
-        numMeasurements++;
     }
 
     inline void StopTimeMeasurementWithCheck()
@@ -95,77 +201,88 @@ public:
         return GetDeltaTime() * 1000;
     }
 
+    // raw deltas are kept only while dumping is on, the statistics itself doesn't need them
     inline void TurnOnDumping(){m_bNeedDumping = true; }
 
     inline void TurnOffDumping(){m_bNeedDumping = false; }
 
     inline void PrintStatistics(const msdk_char* prefix)
     {
-        msdk_printf(MSDK_STRING("%s Total:%.3lfms(%lld smpls),Avg %.3lfms,StdDev:%.3lfms,Min:%.3lfms,Max:%.3lfms\n"),
-                prefix,totalTime,numMeasurements,
+        msdk_printf(MSDK_STRING("%s Total:%.3lfms(%lld smpls),Avg %.3lfms,StdDev:%.3lfms,Min:%.3lfms,Max:%.3lfms,P50:%.3lfms,P95:%.3lfms,P99:%.3lfms\n"),
+                prefix,GetTotalTime(false),GetNumMeasurements(),
                 GetAvgTime(false),GetTimeStdDev(false),
-                GetMinTime(false),GetMaxTime(false));
+                GetMinTime(false),GetMaxTime(false),
+                GetPercentile(0.5,false),GetPercentile(0.95,false),GetPercentile(0.99,false));
     }
 
     inline mfxU64 GetNumMeasurements()
     {
-        return numMeasurements;
+        return m_total.GetNumMeasurements();
     }
 
     inline mfxF64 GetAvgTime(bool inSeconds=true)
     {
-        if (inSeconds)
-        {
-            return (numMeasurements ? totalTime / numMeasurements : 0);
-        }
-        else
-        {
-            return (numMeasurements ? totalTime / numMeasurements : 0) * 1000;
-        }
+        return ToUnits(m_total.GetAvgTime(), inSeconds);
     }
 
     inline mfxF64 GetTimeStdDev(bool inSeconds=true)
     {
-        mfxF64 avg = GetAvgTime();
-        mfxF64 ftmp = (numMeasurements ? sqrt(totalTimeSquares/numMeasurements-avg*avg) : 0.0);
-        return inSeconds ? ftmp : ftmp * 1000;
+        return ToUnits(m_total.GetTimeStdDev(), inSeconds);
     }
 
     inline mfxF64 GetMinTime(bool inSeconds=true)
     {
-        return inSeconds ? minTime : minTime * 1000;
+        return ToUnits(m_total.GetMinTime(), inSeconds);
     }
 
     inline mfxF64 GetMaxTime(bool inSeconds=true)
     {
-        return inSeconds ? maxTime : maxTime * 1000;
+        return ToUnits(m_total.GetMaxTime(), inSeconds);
     }
 
     inline mfxF64 GetTotalTime(bool inSeconds=true)
     {
-        return inSeconds ? totalTime : totalTime * 1000;
+        return ToUnits(m_total.GetTotalTime(), inSeconds);
+    }
+
+    inline mfxF64 GetPercentile(mfxF64 q, bool inSeconds=true)
+    {
+        return ToUnits(m_total.GetPercentile(q), inSeconds);
+    }
+
+    // statistics since the start or the last ResetStatistics()
+    inline const CTimeStatisticsSummary& GetSummary() const
+    {
+        return m_total;
+    }
+
+    // statistics since the previous snapshot, the interval is restarted
+    inline CTimeStatisticsSummary TakeIntervalSnapshot()
+    {
+        CTimeStatisticsSummary snapshot = m_interval;
+        m_interval.Reset();
+        return snapshot;
     }
 
     inline void ResetStatistics()
     {
-        totalTime=0;
-        totalTimeSquares=0;
-        minTime=1E100;
-        maxTime=-1;
-        numMeasurements=0;
+        m_total.Reset();
+        m_interval.Reset();
         m_time_deltas.clear();
         TurnOffDumping();
     }
 
 protected:
+    static inline mfxF64 ToUnits(mfxF64 seconds, bool inSeconds)
+    {
+        return inSeconds ? seconds : seconds * 1000;
+    }
+
     static msdk_tick frequency;
 
     msdk_tick start;
-    mfxF64 totalTime;
-    mfxF64 totalTimeSquares;
-    mfxF64 minTime;
-    mfxF64 maxTime;
-    mfxU64 numMeasurements;
+    CTimeStatisticsSummary m_total;
+    CTimeStatisticsSummary m_interval;
     std::vector<mfxF64> m_time_deltas;
     bool m_bNeedDumping;
 
@@ -248,6 +365,11 @@ public:
         return  0;
     }
 
+    inline mfxF64 GetPercentile(mfxF64, bool)
+    {
+        return 0;
+    }
+
     inline void ResetStatistics()
     {
     }
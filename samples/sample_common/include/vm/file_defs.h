@@ -37,4 +37,18 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #define msdk_fgets  fgets
 #endif // #if defined(_WIN32) || defined(_WIN64)
 
+/* Read-only view of a whole file, writes through data fault */
+typedef struct
+{
+    mfxU8* data;
+    mfxU64 size;
+} msdk_file_map;
+
+/* Maps the file opened for reading, the view is hinted for sequential access.
+   Returns false if the file can't be mapped (e.g. empty file or a pipe). */
+bool msdk_file_map_open(FILE* file, msdk_file_map* map);
+void msdk_file_map_close(msdk_file_map* map);
+/* Starts reading [offset, offset + size) of the view ahead of the access */
+void msdk_file_map_prefetch(const msdk_file_map* map, mfxU64 offset, mfxU64 size);
+
 #endif // #ifndef __FILE_DEFS_H__
@@ -24,6 +24,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include <fstream>
 #include <algorithm>
 #include <map>
+#include <chrono>
 
 #include "vm/strings_defs.h"
 #include "time_statistics.h"
@@ -72,6 +73,7 @@ CSmplYUVReader::CSmplYUVReader()
     m_bInited = false;
     m_ColorFormat = MFX_FOURCC_YV12;
     shouldShift10BitsHigh = false;
+    m_bUseMapping = false;
 }
 
 mfxStatus CSmplYUVReader::Init(std::list<msdk_string> inputs, mfxU32 ColorFormat, bool enableShifting)
@@ -120,6 +122,15 @@ mfxStatus CSmplYUVReader::Init(std::list<msdk_string> inputs, mfxU32 ColorFormat
         MSDK_CHECK_POINTER(f, MFX_ERR_NULL_PTR);
 
         m_files.push_back(f);
+
+        // files which can't be mapped are read as usual
+        msdk_file_map map = {};
+        if (m_bUseMapping)
+        {
+            msdk_file_map_open(f, &map);
+        }
+        m_maps.push_back(map);
+        m_mapPos.push_back(0);
     }
 
     m_ColorFormat = ColorFormat;
@@ -138,9 +149,12 @@ void CSmplYUVReader::Close()
 {
     for (mfxU32 i = 0; i < m_files.size(); i++)
     {
+        msdk_file_map_close(&m_maps[i]);
         fclose(m_files[i]);
     }
     m_files.clear();
+    m_maps.clear();
+    m_mapPos.clear();
     m_bInited = false;
 }
 
@@ -149,9 +163,28 @@ void CSmplYUVReader::Reset()
     for (mfxU32 i = 0; i < m_files.size(); i++)
     {
         fseek(m_files[i], 0, SEEK_SET);
+        m_mapPos[i] = 0;
     }
 }
 
+mfxU32 CSmplYUVReader::ReadFromFile(void* pDst, mfxU32 size, mfxU32 count, mfxU32 vid)
+{
+    const msdk_file_map& map = m_maps[vid];
+
+    if (!map.data)
+    {
+        return (mfxU32)fread(pDst, size, count, m_files[vid]);
+    }
+
+    // like fread, only complete elements are returned
+    count = (mfxU32)std::min<mfxU64>(count, (map.size - m_mapPos[vid]) / size);
+
+    MSDK_MEMCPY(pDst, map.data + m_mapPos[vid], count * size);
+    m_mapPos[vid] += count * size;
+
+    return count;
+}
+
 mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 {
     // check if reader is initialized
@@ -171,6 +204,8 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
         return MFX_ERR_UNSUPPORTED;
     }
 
+    mfxU64 frameStart = m_mapPos[vid];
+
     if (pInfo.CropH > 0 && pInfo.CropW > 0)
     {
         w = pInfo.CropW;
@@ -208,7 +243,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_files[vid]);
+                nBytesRead = ReadFromFile(ptr + i * pitch, 1, 4*w, vid);
 
                 if ((mfxU32)4*w != nBytesRead)
                 {
@@ -225,7 +260,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 2, w, m_files[vid]);
+                nBytesRead = ReadFromFile(ptr + i * pitch, 2, w, vid);
 
                 if ((mfxU32)w != nBytesRead)
                 {
@@ -239,7 +274,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for (i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 4, w, m_files[vid]);
+                nBytesRead = ReadFromFile(ptr + i * pitch, 4, w, vid);
 
                 if ((mfxU32)w != nBytesRead)
                 {
@@ -256,7 +291,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for (i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4 * w, m_files[vid]);
+                nBytesRead = ReadFromFile(ptr + i * pitch, 1, 4 * w, vid);
 
                 if ((mfxU32)4 * w != nBytesRead)
                 {
@@ -287,7 +322,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, nBytesPerPixel, w, m_files[vid]);
+            nBytesRead = ReadFromFile(ptr + i * pitch, nBytesPerPixel, w, vid);
 
             if (w != nBytesRead)
             {
@@ -335,7 +370,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 // load first chroma plane: U (input == I420) or V (input == YV12)
                 for (i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_files[vid]);
+                    nBytesRead = ReadFromFile(buf, 1, w, vid);
                     if (w != nBytesRead)
                     {
                         return MFX_ERR_MORE_DATA;
@@ -350,7 +385,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 for (i = 0; i < h; i++)
                 {
 
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_files[vid]);
+                    nBytesRead = ReadFromFile(buf, 1, w, vid);
 
                     if (w != nBytesRead)
                     {
@@ -379,7 +414,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 for(i = 0; i < h; i++)
                 {
 
-                    nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_files[vid]);
+                    nBytesRead = ReadFromFile(ptr + i * pitch, 1, w, vid);
 
                     if (w != nBytesRead)
                     {
@@ -388,7 +423,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 }
                 for(i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(ptr2 + i * pitch, 1, w, m_files[vid]);
+                    nBytesRead = ReadFromFile(ptr2 + i * pitch, 1, w, vid);
 
                     if (w != nBytesRead)
                     {
@@ -410,7 +445,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
             ptr  = pData.UV + pInfo.CropX + (pInfo.CropY / 2) * pitch;
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, nBytesPerPixel, w, m_files[vid]);
+                nBytesRead = ReadFromFile(ptr + i * pitch, nBytesPerPixel, w, vid);
 
                 if (w != nBytesRead)
                 {
@@ -438,6 +473,9 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
         return MFX_ERR_UNSUPPORTED;
     }
 
+    // the next frame most likely has the same size
+    msdk_file_map_prefetch(&m_maps[vid], m_mapPos[vid], m_mapPos[vid] - frameStart);
+
     return MFX_ERR_NONE;
 }
 
@@ -579,6 +617,10 @@ CSmplBitstreamReader::CSmplBitstreamReader()
 {
     m_fSource = NULL;
     m_bInited = false;
+    m_bUseMapping = false;
+    MSDK_ZERO_MEMORY(m_map);
+    m_mapWindow = 0;
+    m_bMapRestart = true;
 }
 
 CSmplBitstreamReader::~CSmplBitstreamReader()
@@ -588,6 +630,8 @@ CSmplBitstreamReader::~CSmplBitstreamReader()
 
 void CSmplBitstreamReader::Close()
 {
+    msdk_file_map_close(&m_map);
+
     if (m_fSource)
     {
         fclose(m_fSource);
@@ -603,6 +647,8 @@ void CSmplBitstreamReader::Reset()
         return;
 
     fseek(m_fSource, 0, SEEK_SET);
+    m_mapWindow = 0;
+    m_bMapRestart = true;
 }
 
 mfxStatus CSmplBitstreamReader::Init(const msdk_char *strFileName)
@@ -617,6 +663,14 @@ mfxStatus CSmplBitstreamReader::Init(const msdk_char *strFileName)
     MSDK_FOPEN(m_fSource, strFileName, MSDK_STRING("rb"));
     MSDK_CHECK_POINTER(m_fSource, MFX_ERR_NULL_PTR);
 
+    // files which can't be mapped are read as usual
+    if (m_bUseMapping)
+    {
+        msdk_file_map_open(m_fSource, &m_map);
+    }
+    m_mapWindow = 0;
+    m_bMapRestart = true;
+
     m_bInited = true;
     return MFX_ERR_NONE;
 }
@@ -638,6 +692,9 @@ mfxStatus CSmplBitstreamReader::ReadNextFrame(mfxBitstream *pBS)
     if (pBS->MaxLength == pBS->DataLength)
         return MFX_ERR_NOT_ENOUGH_BUFFER;
 
+    if (m_map.data)
+        return MapNextFrame(pBS);
+
     memmove(pBS->Data, pBS->Data + pBS->DataOffset, pBS->DataLength);
     pBS->DataOffset = 0;
     mfxU32 nBytesRead = (mfxU32)fread(pBS->Data + pBS->DataLength, 1, pBS->MaxLength - pBS->DataLength, m_fSource);
@@ -654,6 +711,39 @@ mfxStatus CSmplBitstreamReader::ReadNextFrame(mfxBitstream *pBS)
     return MFX_ERR_NONE;
 }
 
+// Instead of copying, pBS is pointed at the mapped file. The window starts at the first
+// byte not consumed yet and is bounded by pBS->MaxLength, so callers see the same amount
+// of data as with the buffered reads. pBS->Data must not be written or freed by the caller;
+// a buffer attached later (e.g. by mfxBitstreamWrapper::Extend) is only used to grow the window.
+mfxStatus CSmplBitstreamReader::MapNextFrame(mfxBitstream *pBS)
+{
+    // after Reset the stream starts over, the unconsumed tail of the previous pass is dropped
+    mfxU64 start = m_bMapRestart ? 0 : m_mapWindow + pBS->DataOffset;
+    mfxU64 end   = m_bMapRestart ? 0 : start + pBS->DataLength;
+    mfxU64 last  = std::min<mfxU64>(m_map.size, start + pBS->MaxLength);
+
+    m_bMapRestart = false;
+
+    if (last == m_map.size)
+    {
+        pBS->DataFlag |= MFX_BITSTREAM_EOS;
+    }
+
+    if (last <= end)
+    {
+        return MFX_ERR_MORE_DATA;
+    }
+
+    pBS->Data       = m_map.data + start;
+    pBS->DataOffset = 0;
+    pBS->DataLength = (mfxU32)(last - start);
+    m_mapWindow     = start;
+
+    msdk_file_map_prefetch(&m_map, last, pBS->MaxLength);
+
+    return MFX_ERR_NONE;
+}
+
 
 mfxU32 CJPEGFrameReader::FindMarker(mfxBitstream *pBS,mfxU32 startOffset,CJPEGFrameReader::JPEGMarker marker)
 {
@@ -734,6 +824,9 @@ mfxStatus CIVFFrameReader::ReadNextFrame(mfxBitstream *pBS)
 {
     MSDK_CHECK_POINTER(pBS, MFX_ERR_NULL_PTR);
 
+    if (m_map.data)
+        return MapNextFrame(pBS);
+
     memmove(pBS->Data, pBS->Data + pBS->DataOffset, pBS->DataLength);
     pBS->DataOffset = 0;
     pBS->DataFlag = MFX_BITSTREAM_COMPLETE_FRAME;
@@ -769,6 +862,55 @@ mfxStatus CIVFFrameReader::ReadNextFrame(mfxBitstream *pBS)
     return MFX_ERR_NONE;
 }
 
+// Points pBS at the data of the next frame in the mapped file. The frame headers in between
+// keep the frames apart, so data left in pBS from the previous frame is dropped.
+// The file position of m_fSource is kept in sync with the buffered reads.
+mfxStatus CIVFFrameReader::MapNextFrame(mfxBitstream *pBS)
+{
+    const mfxU32 frameHeaderSize = sizeof(mfxU32) + sizeof(mfxU64);
+
+    long pos = ftell(m_fSource);
+    if (pos < 0)
+        return MFX_ERR_UNKNOWN;
+
+    pBS->DataFlag = MFX_BITSTREAM_COMPLETE_FRAME;
+
+    if ((mfxU64)pos + frameHeaderSize > m_map.size)
+    {
+        pBS->DataFlag |= MFX_BITSTREAM_EOS;
+        return MFX_ERR_MORE_DATA;
+    }
+
+    mfxU32 nBytesInFrame = 0;
+    memcpy(&nBytesInFrame, m_map.data + pos, sizeof(nBytesInFrame));
+
+    //check if bitstream has enough space to hold the frame
+    if (nBytesInFrame > pBS->MaxLength)
+        return MFX_ERR_NOT_ENOUGH_BUFFER;
+
+    mfxU64 end = (mfxU64)pos + frameHeaderSize + nBytesInFrame;
+    if (end > m_map.size)
+    {
+        pBS->DataFlag |= MFX_BITSTREAM_EOS;
+        return MFX_ERR_MORE_DATA;
+    }
+
+    MSDK_CHECK_NOT_EQUAL(fseek(m_fSource, (long)end, SEEK_SET), 0, MFX_ERR_UNKNOWN);
+
+    if (end == m_map.size)
+    {
+        pBS->DataFlag |= MFX_BITSTREAM_EOS;
+    }
+
+    pBS->Data       = m_map.data + pos + frameHeaderSize;
+    pBS->DataOffset = 0;
+    pBS->DataLength = nBytesInFrame;
+
+    msdk_file_map_prefetch(&m_map, end, pBS->MaxLength);
+
+    return MFX_ERR_NONE;
+}
+
 
 CSmplYUVWriter::CSmplYUVWriter()
 {
@@ -1308,6 +1450,342 @@ mfxU16 GetFreeSurface(mfxFrameSurface1* pSurfacesPool, mfxU16 nPoolSize)
     return idx;
 }
 
+CSmplSurfacePool::CSmplSurfacePool()
+    : m_nNotifications(0)
+    , m_bCancelled(false)
+{
+}
+
+void CSmplSurfacePool::Init(mfxFrameSurface1* pSurfaces, mfxU16 nPoolSize)
+{
+    std::vector<mfxFrameSurface1*> surfaces;
+    for (mfxU16 i = 0; pSurfaces && i < nPoolSize; i++)
+    {
+        surfaces.push_back(&pSurfaces[i]);
+    }
+
+    Init(surfaces.empty() ? NULL : surfaces.data(), (mfxU16)surfaces.size());
+}
+
+void CSmplSurfacePool::Init(mfxFrameSurface1** ppSurfaces, mfxU16 nPoolSize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_Surfaces.clear();
+    m_Free.clear();
+    m_Taken.clear();
+    for (mfxU16 i = 0; ppSurfaces && i < nPoolSize; i++)
+    {
+        m_Surfaces.push_back(ppSurfaces[i]);
+    }
+
+    // the free list is taken from the back, hand out the first surfaces first.
+    // Surfaces may be still locked by a previous user of the pool.
+    for (mfxU16 i = (mfxU16)m_Surfaces.size(); i > 0; i--)
+    {
+        if (m_Surfaces[i - 1]->Data.Locked)
+        {
+            m_Taken.push_front((mfxU16)(i - 1));
+        }
+        else
+        {
+            m_Free.push_back((mfxU16)(i - 1));
+        }
+    }
+    m_bCancelled = false;
+}
+
+void CSmplSurfacePool::Close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_Surfaces.clear();
+    m_Free.clear();
+    m_Taken.clear();
+}
+
+void CSmplSurfacePool::Reclaim()
+{
+    // surfaces are mostly unlocked in the order they were taken
+    while (!m_Taken.empty() && 0 == m_Surfaces[m_Taken.front()]->Data.Locked)
+    {
+        m_Free.push_back(m_Taken.front());
+        m_Taken.pop_front();
+    }
+
+    if (!m_Free.empty())
+    {
+        return;
+    }
+
+    // the oldest surface is held longer, e.g. as a reference frame
+    for (std::deque<mfxU16>::iterator it = m_Taken.begin(); it != m_Taken.end();)
+    {
+        if (0 == m_Surfaces[*it]->Data.Locked)
+        {
+            m_Free.push_back(*it);
+            it = m_Taken.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+mfxU16 CSmplSurfacePool::TakeFreeSurface()
+{
+    if (m_Free.empty())
+    {
+        Reclaim();
+    }
+
+    while (!m_Free.empty())
+    {
+        mfxU16 idx = m_Free.back();
+        m_Free.pop_back();
+        m_Taken.push_back(idx);
+
+        // the application may have locked the surface bypassing the pool
+        if (0 == m_Surfaces[idx]->Data.Locked)
+        {
+            return idx;
+        }
+    }
+
+    return MSDK_INVALID_SURF_IDX;
+}
+
+mfxU16 CSmplSurfacePool::GetFreeSurfaceIndex(mfxU32 timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    mfxU16 idx = TakeFreeSurface();
+    if (MSDK_INVALID_SURF_IDX != idx || m_Surfaces.empty())
+    {
+        return idx;
+    }
+
+    m_StallStat.StartTimeMeasurement();
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    bool bSync = !!m_Sync;
+    while (!m_bCancelled)
+    {
+        mfxU64 nNotifications = m_nNotifications;
+
+        if (bSync)
+        {
+            // complete a task of the pipeline, the library unlocks its surfaces
+            lock.unlock();
+            bSync = m_Sync();
+            lock.lock();
+        }
+        else if (!m_cond.wait_until(lock, deadline,
+            [this, nNotifications] { return m_bCancelled || nNotifications != m_nNotifications; }))
+        {
+            break;
+        }
+
+        idx = TakeFreeSurface();
+        if (MSDK_INVALID_SURF_IDX != idx || std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+
+    m_StallStat.StopTimeMeasurement();
+
+    if (MSDK_INVALID_SURF_IDX == idx && !m_bCancelled && timeout)
+    {
+        msdk_printf(MSDK_STRING("ERROR: No free surfaces in pool (during long period)\n"));
+    }
+
+    return idx;
+}
+
+mfxFrameSurface1* CSmplSurfacePool::GetFreeSurface(mfxU32 timeout)
+{
+    mfxU16 idx = GetFreeSurfaceIndex(timeout);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (MSDK_INVALID_SURF_IDX != idx && idx < m_Surfaces.size()) ? m_Surfaces[idx] : NULL;
+}
+
+void CSmplSurfacePool::NotifySurfaceUnlocked()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_nNotifications++;
+    }
+    m_cond.notify_all();
+}
+
+void CSmplSurfacePool::CancelWaiting()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bCancelled = true;
+    }
+    m_cond.notify_all();
+}
+
+CSmplSubmitController::CSmplSubmitController()
+    : m_nMaxDepth(1)
+    , m_nDepth(1)
+    , m_nCredits(0)
+    , m_nBackOff(0)
+    , m_fLatency(0)
+    , m_nBusyTicks(0)
+{
+}
+
+void CSmplSubmitController::Init(mfxU16 nMaxDepth)
+{
+    m_nMaxDepth = std::max<mfxU16>(nMaxDepth, 1);
+    m_nDepth    = m_nMaxDepth;
+    m_fLatency  = 0;
+    Reset();
+}
+
+void CSmplSubmitController::Reset()
+{
+    m_Tasks.clear();
+    m_nCredits = 0;
+    m_nBackOff = 0;
+}
+
+void CSmplSubmitController::TaskSubmitted(mfxSyncPoint syncp)
+{
+    m_nBackOff = 0;
+    if (!syncp)
+        return;
+
+    // tasks which were never waited for (e.g. because of timeouts) shouldn't accumulate
+    if (m_Tasks.size() >= 2 * (size_t)m_nMaxDepth)
+    {
+        m_Tasks.pop_front();
+    }
+
+    Task task = { syncp, msdk_time_get_tick() };
+    m_Tasks.push_back(task);
+}
+
+mfxStatus CSmplSubmitController::SyncOldest(MFXVideoSession& session, mfxU32 timeout)
+{
+    Task task = m_Tasks.front();
+
+    // task completed before we asked means the device has spare capacity
+    mfxStatus sts = session.SyncOperation(task.syncp, 0);
+    if (MFX_WRN_IN_EXECUTION != sts)
+    {
+        m_Tasks.pop_front();
+        if (MFX_ERR_NONE > sts)
+            return sts;
+
+        if (++m_nCredits >= m_nDepth)
+        {
+            m_nDepth   = std::min<mfxU16>(m_nDepth + 1, m_nMaxDepth);
+            m_nCredits = 0;
+        }
+        return MFX_ERR_NONE;
+    }
+
+    sts = session.SyncOperation(task.syncp, timeout);
+    if (MFX_WRN_IN_EXECUTION == sts)
+        return sts;
+
+    m_Tasks.pop_front();
+    if (MFX_ERR_NONE > sts)
+        return sts;
+
+    mfxF64 latency = CTimeStatisticsReal::ConvertToSeconds(msdk_time_get_tick() - task.submitted);
+    if (0 == m_fLatency)
+    {
+        m_fLatency = latency;
+    }
+
+    if (latency > 2 * m_fLatency)
+    {
+        // tasks are queued in the device rather than executed, keep less of them
+        m_nDepth   = std::max<mfxU16>(m_nDepth - 1, 1);
+        m_nCredits = 0;
+    }
+    else if (latency <= m_fLatency && ++m_nCredits >= m_nDepth)
+    {
+        // latency stays flat at this depth, so a busy device may take one more task
+        m_nDepth   = std::min<mfxU16>(m_nDepth + 1, m_nMaxDepth);
+        m_nCredits = 0;
+    }
+    m_fLatency += (latency - m_fLatency) / 8;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CSmplSubmitController::WaitForSlot(MFXVideoSession& session, mfxU32 timeout)
+{
+    if (m_Tasks.size() < m_nDepth)
+        return MFX_ERR_NONE;
+
+    msdk_tick start = msdk_time_get_tick();
+
+    mfxStatus sts = MFX_ERR_NONE;
+    while (MFX_ERR_NONE == sts && m_Tasks.size() >= m_nDepth)
+    {
+        sts = SyncOldest(session, timeout);
+    }
+
+    m_nBusyTicks += msdk_time_get_tick() - start;
+
+    // task running longer than timeout shouldn't block the submission
+    return (MFX_WRN_IN_EXECUTION == sts) ? MFX_ERR_NONE : sts;
+}
+
+mfxStatus CSmplSubmitController::WaitForDevice(MFXVideoSession& session, mfxU32 timeout)
+{
+    msdk_tick start = msdk_time_get_tick();
+    mfxStatus sts = MFX_ERR_NONE;
+
+    if (!m_Tasks.empty())
+    {
+        // device doesn't accept more tasks than we already have in flight
+        m_nDepth   = std::max<mfxU16>(std::min<mfxU16>(m_nDepth, (mfxU16)m_Tasks.size()), 1);
+        m_nCredits = 0;
+
+        sts = SyncOldest(session, timeout);
+        if (MFX_WRN_IN_EXECUTION == sts)
+            sts = MFX_ERR_NONE;
+    }
+    else
+    {
+        // device is loaded by other components, back off exponentially up to 1 ms
+        m_nBackOff = m_nBackOff ? std::min<mfxU32>(2 * m_nBackOff, 1000) : 50;
+        MSDK_USLEEP(m_nBackOff);
+    }
+
+    m_nBusyTicks += msdk_time_get_tick() - start;
+    return sts;
+}
+
+mfxStatus CSmplSubmitController::WaitForOldest(MFXVideoSession& session, mfxU32 timeout)
+{
+    if (m_Tasks.empty())
+        return MFX_ERR_NOT_FOUND;
+
+    msdk_tick start = msdk_time_get_tick();
+    mfxStatus sts = SyncOldest(session, timeout);
+    m_nBusyTicks += msdk_time_get_tick() - start;
+
+    return sts;
+}
+
+mfxF64 CSmplSubmitController::TakeBusyWaitTime()
+{
+    mfxF64 seconds = CTimeStatisticsReal::ConvertToSeconds(m_nBusyTicks);
+    m_nBusyTicks = 0;
+    return seconds;
+}
+
 std::basic_string<msdk_char> CodecIdToStr(mfxU32 nFourCC)
 {
     std::basic_string<msdk_char> fcc;
@@ -0,0 +1,73 @@
+/******************************************************************************\
+Copyright (c) 2005-2019, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#include "mfx_samples_config.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+
+#include "vm/file_defs.h"
+
+#include <windows.h>
+#include <io.h>
+
+bool msdk_file_map_open(FILE* file, msdk_file_map* map)
+{
+    if (!file || !map) return false;
+
+    map->data = NULL;
+    map->size = 0;
+
+    HANDLE hFile = (HANDLE)_get_osfhandle(_fileno(file));
+    LARGE_INTEGER size;
+    if (INVALID_HANDLE_VALUE == hFile || !GetFileSizeEx(hFile, &size) || size.QuadPart <= 0)
+        return false;
+
+    HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!hMapping)
+        return false;
+
+    // the view keeps the mapping object alive
+    void* data = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+    if (!data)
+        return false;
+
+    map->data = (mfxU8*)data;
+    map->size = (mfxU64)size.QuadPart;
+    return true;
+}
+
+void msdk_file_map_close(msdk_file_map* map)
+{
+    if (!map || !map->data) return;
+
+    UnmapViewOfFile(map->data);
+    map->data = NULL;
+    map->size = 0;
+}
+
+void msdk_file_map_prefetch(const msdk_file_map* map, mfxU64 offset, mfxU64 size)
+{
+    // the cache manager reads ahead on its own for sequential access
+    (void)map;
+    (void)offset;
+    (void)size;
+}
+
+#endif // #if defined(_WIN32) || defined(_WIN64)
@@ -0,0 +1,70 @@
+/******************************************************************************\
+Copyright (c) 2005-2019, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include "vm/file_defs.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+bool msdk_file_map_open(FILE* file, msdk_file_map* map)
+{
+    if (!file || !map) return false;
+
+    map->data = NULL;
+    map->size = 0;
+
+    struct stat st;
+    int fd = fileno(file);
+    if (fd < 0 || fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0)
+        return false;
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == data)
+        return false;
+
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    map->data = (mfxU8*)data;
+    map->size = (mfxU64)st.st_size;
+    return true;
+}
+
+void msdk_file_map_close(msdk_file_map* map)
+{
+    if (!map || !map->data) return;
+
+    munmap(map->data, (size_t)map->size);
+    map->data = NULL;
+    map->size = 0;
+}
+
+void msdk_file_map_prefetch(const msdk_file_map* map, mfxU64 offset, mfxU64 size)
+{
+    if (!map || !map->data || offset >= map->size) return;
+
+    // madvise needs a page aligned address
+    mfxU64 page = (mfxU64)sysconf(_SC_PAGESIZE);
+    mfxU64 begin = offset - offset % page;
+    mfxU64 end = (size < map->size - offset) ? offset + size : map->size;
+
+    madvise(map->data + begin, (size_t)(end - begin), MADV_WILLNEED);
+}
+
+#endif // #if !defined(_WIN32) && !defined(_WIN64)
@@ -1932,7 +1932,17 @@ mfxStatus CDecodingPipeline::RunDecoding()
 
                         if (MFX_WRN_DEVICE_BUSY == sts)
                         {
-                            MSDK_SLEEP(1); // just wait and then repeat the same call to RunFrameVPPAsync
+                            // wait for the oldest output instead of sleeping and then repeat the same call to RunFrameVPPAsync
+                            mfxStatus _sts = SyncOutputSurface(MSDK_DEC_WAIT_INTERVAL);
+                            if (MFX_ERR_MORE_DATA == _sts)
+                            {
+                                // nothing of ours is in flight, the device is loaded by other sessions
+                                MSDK_USLEEP(100);
+                            }
+                            else if (MFX_ERR_NONE > _sts)
+                            {
+                                sts = _sts;
+                            }
                         }
                     } while (MFX_WRN_DEVICE_BUSY == sts);
 
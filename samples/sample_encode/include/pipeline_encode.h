@@ -194,6 +194,7 @@ struct sInputParams
     mfxU16 IntRefCycleDist;
 
     bool bUncut;
+    bool bUseMmap; // copy input frames from the memory mapped input files
     bool shouldUseShifted10BitEnc;
     bool shouldUseShifted10BitVPP;
     bool IsSourceMSB;
@@ -325,6 +326,12 @@ protected:
 
     mfxFrameSurface1* m_pEncSurfaces; // frames array for encoder input (vpp output)
     mfxFrameSurface1* m_pVppSurfaces; // frames array for vpp input
+    CSmplSurfacePool m_EncSurfacesPool;
+    CSmplSurfacePool m_VppSurfacesPool;
+
+    // wait for the oldest task of the component on MFX_WRN_DEVICE_BUSY
+    CSmplSubmitController m_EncSubmit;
+    CSmplSubmitController m_VppSubmit;
     mfxFrameAllocResponse m_EncResponse;  // memory allocation response for encoder
     mfxFrameAllocResponse m_VppResponse;  // memory allocation response for vpp
 
@@ -386,6 +393,10 @@ protected:
     virtual mfxStatus LoadNextFrame(mfxFrameSurface1* pSurf);
 
     virtual mfxStatus GetFreeTask(sTask **ppTask);
+    // waits for the oldest encoding task and writes its bitstream
+    virtual mfxStatus SynchronizeFirstTask();
+    // sync callback of the surface pools, the library unlocks surfaces when the tasks using them complete
+    bool SyncSurfacePool(CSmplSurfacePool& pool);
     virtual MFXVideoSession& GetFirstSession(){return m_mfxSession;}
     virtual MFXVideoENCODE* GetFirstEncoder(){return m_pmfxENC;}
 
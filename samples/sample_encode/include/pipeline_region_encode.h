@@ -100,6 +100,7 @@ protected:
     virtual mfxStatus InitMfxEncParams(sInputParams *pParams);
 
     virtual mfxStatus CreateAllocator();
+    virtual mfxStatus SynchronizeFirstTask();
 
     virtual MFXVideoSession& GetFirstSession(){return m_resources[0].Session;}
     virtual MFXVideoENCODE* GetFirstEncoder(){return m_resources[0].pEncoder;}
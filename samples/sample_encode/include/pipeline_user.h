@@ -49,6 +49,7 @@ protected:
     msdk_so_handle          m_PluginModule;
     MFXGenericPlugin*       m_pusrPlugin;
     mfxFrameSurface1*       m_pPluginSurfaces; // frames array for rotate input
+    CSmplSurfacePool        m_PluginSurfacesPool;
     mfxFrameAllocResponse   m_PluginResponse;  // memory allocation response for rotate plugin
 
     mfxVideoParam                   m_pluginVideoParams;
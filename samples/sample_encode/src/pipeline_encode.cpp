@@ -979,8 +979,12 @@ mfxStatus CEncodingPipeline::AllocFrames()
                 MSDK_CHECK_STATUS(sts, "m_pMFXAllocator->Lock failed");
             }
         }
+
+        m_VppSurfacesPool.Init(m_pVppSurfaces, m_VppResponse.NumFrameActual);
     }
 
+    m_EncSurfacesPool.Init(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+
     return MFX_ERR_NONE;
 }
 
@@ -1119,6 +1123,9 @@ mfxStatus CEncodingPipeline::CreateAllocator()
 
 void CEncodingPipeline::DeleteFrames()
 {
+    m_EncSurfacesPool.Close();
+    m_VppSurfacesPool.Close();
+
     // delete surfaces array
     MSDK_SAFE_DELETE_ARRAY(m_pEncSurfaces);
     MSDK_SAFE_DELETE_ARRAY(m_pVppSurfaces);
@@ -1188,6 +1195,9 @@ CEncodingPipeline::CEncodingPipeline()
     m_bInsertIDR = false;
 
     m_bIsFieldSplitting = false;
+
+    m_EncSurfacesPool.SetSyncCallback([this]() { return SyncSurfacePool(m_EncSurfacesPool); });
+    m_VppSurfacesPool.SetSyncCallback([this]() { return SyncSurfacePool(m_VppSurfacesPool); });
 }
 
 CEncodingPipeline::~CEncodingPipeline()
@@ -1605,6 +1615,7 @@ mfxStatus CEncodingPipeline::Init(sInputParams *pParams)
     if (!isV4L2InputEnabled)
     {
         // prepare input file reader
+        m_FileReader.EnableMapping(pParams->bUseMmap);
         sts = m_FileReader.Init(pParams->InputFiles,
             pParams->FileInputFourCC,readerShift);
         MSDK_CHECK_STATUS(sts, "m_FileReader.Init failed");
@@ -1759,6 +1770,16 @@ void CEncodingPipeline::Close()
         msdk_printf(MSDK_STRING("Frame number: %u\r\n"), m_FileWriters.first->m_nProcessedFramesNum);
         mfxF64 ProcDeltaTime = m_statOverall.GetDeltaTime() - m_statFile.GetDeltaTime() - m_TaskPool.GetFileStatistics().GetDeltaTime();
         msdk_printf(MSDK_STRING("Encoding fps: %.0f\n"), m_FileWriters.first->m_nProcessedFramesNum / ProcDeltaTime);
+
+        if (m_EncSurfacesPool.GetStallStatistics().GetNumMeasurements())
+            m_EncSurfacesPool.GetStallStatistics().PrintStatistics(MSDK_STRING("Waiting for free encode surface:"));
+        if (m_VppSurfacesPool.GetStallStatistics().GetNumMeasurements())
+            m_VppSurfacesPool.GetStallStatistics().PrintStatistics(MSDK_STRING("Waiting for free VPP surface:"));
+
+        mfxF64 vppBusy = m_VppSubmit.TakeBusyWaitTime();
+        mfxF64 encBusy = m_EncSubmit.TakeBusyWaitTime();
+        if (vppBusy > 0 || encBusy > 0)
+            msdk_printf(MSDK_STRING("Waiting for busy device: VPP %.3lf ms, encode %.3lf ms\n"), vppBusy * 1000, encBusy * 1000);
     }
 
     std::for_each(m_UserDataUnregSEI.begin(), m_UserDataUnregSEI.end(), [](mfxPayload* payload) { delete[] payload->Data; delete payload; });
@@ -1903,6 +1924,9 @@ mfxStatus CEncodingPipeline::ResetMFXComponents(sInputParams* pParams)
     sts = m_TaskPool.Init(&m_mfxSession, m_FileWriters.first, m_mfxEncParams.AsyncDepth, nEncodedDataBufferSize, m_FileWriters.second);
     MSDK_CHECK_STATUS(sts, "m_TaskPool.Init failed");
 
+    m_VppSubmit.Init(m_mfxEncParams.AsyncDepth);
+    m_EncSubmit.Init(m_mfxEncParams.AsyncDepth);
+
     if (m_bSoftRobustFlag)
         m_TaskPool.SetGpuHangRecoveryFlag();
 
@@ -1975,14 +1999,7 @@ mfxStatus CEncodingPipeline::GetFreeTask(sTask **ppTask)
     sts = m_TaskPool.GetFreeTask(ppTask);
     if (MFX_ERR_NOT_FOUND == sts)
     {
-        sts = m_TaskPool.SynchronizeFirstTask();
-        if (sts == MFX_ERR_GPU_HANG && m_bSoftRobustFlag)
-        {
-            m_TaskPool.ClearTasks();
-            FreeSurfacePool(m_pEncSurfaces, m_EncResponse.NumFrameActual);
-            m_bInsertIDR = true;
-            sts = MFX_ERR_NONE;
-        }
+        sts = SynchronizeFirstTask();
         MSDK_CHECK_STATUS(sts, "m_TaskPool.SynchronizeFirstTask failed");
 
         // try again
@@ -1992,6 +2009,34 @@ mfxStatus CEncodingPipeline::GetFreeTask(sTask **ppTask)
     return sts;
 }
 
+mfxStatus CEncodingPipeline::SynchronizeFirstTask()
+{
+    mfxStatus sts = m_TaskPool.SynchronizeFirstTask();
+    if (sts == MFX_ERR_GPU_HANG && m_bSoftRobustFlag)
+    {
+        m_TaskPool.ClearTasks();
+        FreeSurfacePool(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+        m_EncSurfacesPool.NotifySurfaceUnlocked();
+        m_bInsertIDR = true;
+        sts = MFX_ERR_NONE;
+    }
+
+    return sts;
+}
+
+bool CEncodingPipeline::SyncSurfacePool(CSmplSurfacePool& pool)
+{
+    mfxStatus sts = SynchronizeFirstTask();
+
+    // the surfaces won't be unlocked after a failure, don't wait for them
+    if (MFX_ERR_NONE != sts && MFX_ERR_NOT_FOUND != sts)
+    {
+        pool.CancelWaiting();
+    }
+
+    return MFX_ERR_NONE == sts;
+}
+
 mfxStatus CEncodingPipeline::Run()
 {
     m_statOverall.StartTimeMeasurement();
@@ -2052,7 +2097,7 @@ mfxStatus CEncodingPipeline::Run()
         }
         else
         {
-            nEncSurfIdx = GetFreeSurface(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+            nEncSurfIdx = m_EncSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
         }
         MSDK_CHECK_ERROR(nEncSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 
@@ -2077,7 +2122,7 @@ mfxStatus CEncodingPipeline::Run()
                     }
                     else
                     {
-                        nVppSurfIdx = GetFreeSurface(m_pVppSurfaces, m_VppResponse.NumFrameActual);
+                        nVppSurfIdx = m_VppSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
                     }
                     MSDK_CHECK_ERROR(nVppSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 #endif
@@ -2112,6 +2157,10 @@ mfxStatus CEncodingPipeline::Run()
                 sts = m_pmfxVPP->RunFrameVPPAsync(skipLoadingNextFrame ?  NULL : &m_pVppSurfaces[nVppSurfIdx],
                                                   &m_pEncSurfaces[nEncSurfIdx],
                     NULL, &VppSyncPoint);
+                if (MFX_ERR_NONE <= sts && VppSyncPoint)
+                {
+                    m_VppSubmit.TaskSubmitted(VppSyncPoint);
+                }
 
                 if (m_nPerfOpt)
                 {
@@ -2121,7 +2170,11 @@ mfxStatus CEncodingPipeline::Run()
                 if (MFX_ERR_NONE < sts && !VppSyncPoint) // repeat the call if warning and no output
                 {
                     if (MFX_WRN_DEVICE_BUSY == sts)
-                        MSDK_SLEEP(1); // wait if device is busy
+                    {
+                        // wait for the oldest VPP task instead of sleeping
+                        sts = m_VppSubmit.WaitForDevice(m_mfxSession, MSDK_VPP_WAIT_INTERVAL);
+                        MSDK_BREAK_ON_ERROR(sts);
+                    }
                 }
                 else if (MFX_ERR_NONE < sts && VppSyncPoint)
                 {
@@ -2166,7 +2219,10 @@ mfxStatus CEncodingPipeline::Run()
 
             // at this point surface for encoder contains either a frame from file or a frame processed by vpp
             sts = m_pmfxENC->EncodeFrameAsync(&pCurrentTask->encCtrl, &m_pEncSurfaces[nEncSurfIdx], &pCurrentTask->mfxBS, &pCurrentTask->EncSyncP);
-
+            if (MFX_ERR_NONE <= sts && pCurrentTask->EncSyncP)
+            {
+                m_EncSubmit.TaskSubmitted(pCurrentTask->EncSyncP);
+            }
 
             if (m_nPerfOpt)
             {
@@ -2176,7 +2232,11 @@ mfxStatus CEncodingPipeline::Run()
             if (MFX_ERR_NONE < sts && !pCurrentTask->EncSyncP) // repeat the call if warning and no output
             {
                 if (MFX_WRN_DEVICE_BUSY == sts)
-                    MSDK_SLEEP(1); // wait if device is busy
+                {
+                    // wait for the oldest encoding task instead of sleeping
+                    sts = m_EncSubmit.WaitForDevice(m_mfxSession, MSDK_ENC_WAIT_INTERVAL);
+                    MSDK_BREAK_ON_ERROR(sts);
+                }
             }
             else if (MFX_ERR_NONE < sts && pCurrentTask->EncSyncP)
             {
@@ -2212,17 +2272,25 @@ mfxStatus CEncodingPipeline::Run()
             // MFX_ERR_MORE_DATA is accepted only from EncodeFrameAsync
         {
             // find free surface for encoder input (vpp output)
-            nEncSurfIdx = GetFreeSurface(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+            nEncSurfIdx = m_EncSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
             MSDK_CHECK_ERROR(nEncSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 
             for (;;)
             {
                 sts = m_pmfxVPP->RunFrameVPPAsync(NULL, &m_pEncSurfaces[nEncSurfIdx], NULL, &VppSyncPoint);
+                if (MFX_ERR_NONE <= sts && VppSyncPoint)
+                {
+                    m_VppSubmit.TaskSubmitted(VppSyncPoint);
+                }
 
                 if (MFX_ERR_NONE < sts && !VppSyncPoint) // repeat the call if warning and no output
                 {
                     if (MFX_WRN_DEVICE_BUSY == sts)
-                        MSDK_SLEEP(1); // wait if device is busy
+                    {
+                        // wait for the oldest VPP task instead of sleeping
+                        sts = m_VppSubmit.WaitForDevice(m_mfxSession, MSDK_VPP_WAIT_INTERVAL);
+                        MSDK_BREAK_ON_ERROR(sts);
+                    }
                 }
                 else if (MFX_ERR_NONE < sts && VppSyncPoint)
                 {
@@ -2259,11 +2327,19 @@ mfxStatus CEncodingPipeline::Run()
                 m_bInsertIDR = false;
 
                 sts = m_pmfxENC->EncodeFrameAsync(&pCurrentTask->encCtrl, &m_pEncSurfaces[nEncSurfIdx], &pCurrentTask->mfxBS, &pCurrentTask->EncSyncP);
+                if (MFX_ERR_NONE <= sts && pCurrentTask->EncSyncP)
+                {
+                    m_EncSubmit.TaskSubmitted(pCurrentTask->EncSyncP);
+                }
 
                 if (MFX_ERR_NONE < sts && !pCurrentTask->EncSyncP) // repeat the call if warning and no output
                 {
                     if (MFX_WRN_DEVICE_BUSY == sts)
-                        MSDK_SLEEP(1); // wait if device is busy
+                    {
+                        // wait for the oldest encoding task instead of sleeping
+                        sts = m_EncSubmit.WaitForDevice(m_mfxSession, MSDK_ENC_WAIT_INTERVAL);
+                        MSDK_BREAK_ON_ERROR(sts);
+                    }
                 }
                 else if (MFX_ERR_NONE < sts && pCurrentTask->EncSyncP)
                 {
@@ -296,6 +296,24 @@ CRegionEncodingPipeline::CRegionEncodingPipeline() : CEncodingPipeline()
     m_timeAll = 0;
 }
 
+mfxStatus CRegionEncodingPipeline::SynchronizeFirstTask()
+{
+    mfxStatus sts = MFX_ERR_NOT_FOUND;
+
+    // regions (slices) are written in order, synchronize the first task of every task pool
+    for (int i = 0; i < m_resources.GetSize(); i++)
+    {
+        mfxStatus stsRegion = m_resources[i].TaskPool.SynchronizeFirstTask();
+        if (MFX_ERR_NOT_FOUND == stsRegion)
+            continue;
+        MSDK_CHECK_STATUS(stsRegion, "m_resources[i].TaskPool.SynchronizeFirstTask failed");
+
+        sts = MFX_ERR_NONE;
+    }
+
+    return sts;
+}
+
 CRegionEncodingPipeline::~CRegionEncodingPipeline()
 {
     Close();
@@ -308,6 +326,7 @@ mfxStatus CRegionEncodingPipeline::Init(sInputParams *pParams)
     mfxStatus sts = MFX_ERR_NONE;
 
     // prepare input file reader
+    m_FileReader.EnableMapping(pParams->bUseMmap);
     sts = m_FileReader.Init(pParams->InputFiles,
                             pParams->FileInputFourCC );
     MSDK_CHECK_STATUS(sts, "m_FileReader.Init failed");
@@ -537,7 +556,7 @@ mfxStatus CRegionEncodingPipeline::Run()
         }
         else
         {
-            nEncSurfIdx = GetFreeSurface(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+            nEncSurfIdx = m_EncSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
         }
         MSDK_CHECK_ERROR(nEncSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 
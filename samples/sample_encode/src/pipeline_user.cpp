@@ -136,11 +136,15 @@ mfxStatus CUserPipeline::AllocFrames()
         }
     }
 
+    m_EncSurfacesPool.Init(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+    m_PluginSurfacesPool.Init(m_pPluginSurfaces, m_PluginResponse.NumFrameActual);
+
     return MFX_ERR_NONE;
 }
 
 void CUserPipeline::DeleteFrames()
 {
+    m_PluginSurfacesPool.Close();
     MSDK_SAFE_DELETE_ARRAY(m_pPluginSurfaces);
 
     CEncodingPipeline::DeleteFrames();
@@ -155,6 +159,8 @@ CUserPipeline::CUserPipeline() : CEncodingPipeline()
     MSDK_ZERO_MEMORY(m_pluginVideoParams);
     MSDK_ZERO_MEMORY(m_RotateParams);
     m_MVCflags = MVC_DISABLED;
+
+    m_PluginSurfacesPool.SetSyncCallback([this]() { return SyncSurfacePool(m_PluginSurfacesPool); });
 }
 
 CUserPipeline::~CUserPipeline()
@@ -179,6 +185,7 @@ mfxStatus CUserPipeline::Init(sInputParams *pParams)
     MSDK_CHECK_POINTER(m_pusrPlugin, MFX_ERR_NOT_FOUND);
 
     // prepare input file reader
+    m_FileReader.EnableMapping(pParams->bUseMmap);
     sts = m_FileReader.Init(pParams->InputFiles,
                             pParams->FileInputFourCC );
     MSDK_CHECK_STATUS(sts, "m_FileReader.Init failed");
@@ -340,7 +347,7 @@ mfxStatus CUserPipeline::Run()
         }
         else
         {
-            nRotateSurfIdx = GetFreeSurface(m_pPluginSurfaces, m_PluginResponse.NumFrameActual);
+            nRotateSurfIdx = m_PluginSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
         }
         MSDK_CHECK_ERROR(nRotateSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 
@@ -352,7 +359,7 @@ mfxStatus CUserPipeline::Run()
 
         MSDK_BREAK_ON_ERROR(sts);
 
-        nEncSurfIdx = GetFreeSurface(m_pEncSurfaces, m_EncResponse.NumFrameActual);
+        nEncSurfIdx = m_EncSurfacesPool.GetFreeSurfaceIndex(MSDK_SURFACE_WAIT_INTERVAL);
         MSDK_CHECK_ERROR(nEncSurfIdx, MSDK_INVALID_SURF_IDX, MFX_ERR_MEMORY_ALLOC);
 
         // rotation
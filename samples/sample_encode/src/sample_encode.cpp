@@ -162,6 +162,7 @@ void PrintHelp(msdk_char *strAppName, const msdk_char *strErrorMessage, ...)
     msdk_printf(MSDK_STRING("   [-timeout]               - encoding in cycle not less than specific time in seconds\n"));
     msdk_printf(MSDK_STRING("   [-perf_opt n]            - sets number of prefetched frames. In performance mode app preallocates buffer and load first n frames\n"));
     msdk_printf(MSDK_STRING("   [-uncut]                 - do not cut output file in looped mode (in case of -timeout option)\n"));
+    msdk_printf(MSDK_STRING("   [-mmap]                  - map input files to memory instead of reading them\n"));
     msdk_printf(MSDK_STRING("   [-dump fileName]         - dump MSDK components configuration to the file in text form\n"));
     msdk_printf(MSDK_STRING("   [-usei]                  - insert user data unregistered SEI. eg: 7fc92488825d11e7bb31be2e44b06b34:0:MSDK (uuid:type<0-preifx/1-suffix>:message)\n"));
     msdk_printf(MSDK_STRING("                              the suffix SEI for HEVCe can be inserted when CQP used or HRD disabled\n"));
@@ -810,6 +811,10 @@ mfxStatus ParseInputString(msdk_char* strInput[], mfxU8 nArgNum, sInputParams* p
         {
             pParams->bUncut = true;
         }
+        else if (0 == msdk_strcmp(strInput[i], MSDK_STRING("-mmap")))
+        {
+            pParams->bUseMmap = true;
+        }
         else if (0 == msdk_strcmp(strInput[i], MSDK_STRING("-gpucopy::on")))
         {
             pParams->gpuCopy = MFX_GPUCOPY_ON;
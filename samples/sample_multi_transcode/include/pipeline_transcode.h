@@ -28,11 +28,15 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include <memory>
 #include <vector>
 #include <list>
+#include <deque>
+#include <atomic>
 #include <ctime>
 #include <map>
 #include <future>
 #include <chrono>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "sample_defs.h"
 #include "sample_utils.h"
@@ -185,6 +189,8 @@ namespace TranscodingSample
         bool bPrefferdGfx;
 #endif
         bool   bIsPerf;   // special performance mode. Use pre-allocated bitstreams, output
+        mfxU16 nIOBuffers; // number of bitstreams read ahead and written behind by the I/O thread, 0 - synchronous I/O
+        bool   bUseMmap;  // feed decoder directly from the memory mapped input file
         mfxU16 nThreadsNum; // number of internal session threads number
         bool bRobustFlag;   // Robust transcoding mode. Allows auto-recovery after hardware errors
         bool bSoftRobustFlag;
@@ -391,23 +397,37 @@ namespace TranscodingSample
         PreEncAuxBuffer* pCtrl = nullptr;
     };
 
-    class CIOStat : public CTimeStatistics
+    class CIOStat : public CTimeStatisticsReal
     {
         public:
+            // pipeline components waiting for the device on MFX_WRN_DEVICE_BUSY
+            enum BusyStage
+            {
+                BUSY_DEC = 0,
+                BUSY_VPP,
+                BUSY_PREENC,
+                BUSY_ENC,
+                BUSY_STAGES
+            };
+
             CIOStat()
-              : CTimeStatistics()
+              : CTimeStatisticsReal()
               , ofile(stdout)
+              , ioWaitTime(0)
             {
                 MSDK_ZERO_MEMORY(bufDir);
+                MSDK_ZERO_MEMORY(busyWaitTime);
                 DumpLogFileName.clear();
             }
 
             CIOStat(const msdk_char *dir)
-              : CTimeStatistics()
+              : CTimeStatisticsReal()
               , ofile(stdout)
+              , ioWaitTime(0)
             {
                 msdk_strncopy_s(bufDir, MAX_PREF_LEN, dir, MAX_PREF_LEN - 1);
                 bufDir[MAX_PREF_LEN - 1] = 0;
+                MSDK_ZERO_MEMORY(busyWaitTime);
             }
 
             ~CIOStat()
@@ -441,15 +461,41 @@ namespace TranscodingSample
                 }
             }
 
+            // time in seconds spent waiting for file I/O, the rest of the total time is spent in the codec
+            inline void AddIOWaitTime(mfxF64 seconds)
+            {
+                ioWaitTime += seconds;
+            }
+
+            // time in seconds the component spent waiting for busy device, it is a part of the codec time
+            inline void AddBusyWaitTime(BusyStage stage, mfxF64 seconds)
+            {
+                busyWaitTime[stage] += seconds;
+            }
+
+            inline void ResetStatistics()
+            {
+                CTimeStatisticsReal::ResetStatistics();
+                ioWaitTime = 0;
+                MSDK_ZERO_MEMORY(busyWaitTime);
+            }
+
             inline void PrintStatistics(mfxU32 numPipelineid, mfxF64 target_framerate = -1 /*default stands for infinite*/)
             {
+                // I/O wait is measured inside the frame intervals, but the first wait of the window may precede them
+                mfxF64 ioWait = std::min(ioWaitTime * 1000, GetTotalTime(false));
+
                 // print timings in ms
-                msdk_fprintf(   ofile, MSDK_STRING("stat[%u.%llu]: %s=%d;Framerate=%.3f;Total=%.3lf;Samples=%lld;StdDev=%.3lf;Min=%.3lf;Max=%.3lf;Avg=%.3lf\n"),
+                msdk_fprintf(   ofile, MSDK_STRING("stat[%u.%llu]: %s=%d;Framerate=%.3f;Total=%.3lf;Samples=%lld;StdDev=%.3lf;Min=%.3lf;Max=%.3lf;Avg=%.3lf;P50=%.3lf;P95=%.3lf;P99=%.3lf;IOWait=%.3lf;Codec=%.3lf;DecBusy=%.3lf;VppBusy=%.3lf;PreEncBusy=%.3lf;EncBusy=%.3lf\n"),
                                 msdk_get_current_pid(), rdtsc(),
                                 bufDir, numPipelineid,
                                 target_framerate,
                                 GetTotalTime(false), GetNumMeasurements(),
-                                GetTimeStdDev(false), GetMinTime(false), GetMaxTime(false), GetAvgTime(false));
+                                GetTimeStdDev(false), GetMinTime(false), GetMaxTime(false), GetAvgTime(false),
+                                GetPercentile(0.5, false), GetPercentile(0.95, false), GetPercentile(0.99, false),
+                                ioWait, GetTotalTime(false) - ioWait,
+                                busyWaitTime[BUSY_DEC] * 1000, busyWaitTime[BUSY_VPP] * 1000,
+                                busyWaitTime[BUSY_PREENC] * 1000, busyWaitTime[BUSY_ENC] * 1000);
                 fflush(ofile);
 
                 if(!DumpLogFileName.empty())
@@ -478,55 +524,100 @@ namespace TranscodingSample
                 {
                     perror("DumpDeltas: file cannot be open");
                 }
+                // the file is appended, keep only the deltas which aren't dumped yet
+                m_time_deltas.clear();
             }
         protected:
             msdk_tstring DumpLogFileName;
             FILE*     ofile;
             msdk_char bufDir[MAX_PREF_LEN];
+            mfxF64    ioWaitTime;
+            mfxF64    busyWaitTime[BUSY_STAGES];
     };
 
 
+    // bitstream buffers recycled between the pipelines of one launcher,
+    // buffers are kept in power of two size classes
+    class BitstreamBufferPool
+    {
+    public:
+        BitstreamBufferPool();
+        virtual ~BitstreamBufferPool();
+
+        // grows bitstream buffer to at least nSize bytes, the data is kept
+        void Extend(mfxBitstreamWrapper& bs, mfxU32 nSize);
+        // returns bitstream buffer to the pool
+        void Release(mfxBitstreamWrapper& bs);
+
+        mfxU64 GetAllocations() const { return m_nAllocations; }
+
+    protected:
+        enum
+        {
+            MIN_SIZE_CLASS   = 12, // 4 KB
+            NUM_SIZE_CLASSES = 32 - MIN_SIZE_CLASS,
+            MAX_FREE_BUFFERS = 64  // per size class
+        };
+
+        // smallest class which fits nSize bytes
+        static mfxU32 GetSizeClass(mfxU32 nSize);
+        void PutBuffer(std::vector<mfxU8>& buffer);
+
+        std::mutex                        m_mutex;
+        std::vector<std::vector<mfxU8> >  m_FreeBuffers[NUM_SIZE_CLASSES];
+        std::atomic<mfxU64>               m_nAllocations;
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(BitstreamBufferPool);
+    };
+
     class ExtendedBSStore
     {
     public:
-        explicit ExtendedBSStore(mfxU32 size)
+        explicit ExtendedBSStore(mfxU32 size, const std::shared_ptr<BitstreamBufferPool>& pBufferPool = std::shared_ptr<BitstreamBufferPool>())
+            : m_pExtBS(size)
+            , m_pBufferPool(pBufferPool)
         {
-            m_pExtBS.resize(size);
+            ReleaseAll();
         }
         virtual ~ExtendedBSStore()
         {
+            if (m_pBufferPool)
+            {
+                for (mfxU32 i = 0; i < m_pExtBS.size(); i++)
+                {
+                    m_pBufferPool->Release(m_pExtBS[i].Bitstream);
+                }
+            }
             m_pExtBS.clear();
 
         }
         ExtendedBS* GetNext()
         {
-            for (mfxU32 i=0; i < m_pExtBS.size(); i++)
-            {
-                if (m_pExtBS[i].IsFree)
-                {
-                    m_pExtBS[i].IsFree = false;
-                    return &m_pExtBS[i];
-                }
-            }
-            return NULL;
+            if (m_FreeBS.empty())
+                return NULL;
+
+            ExtendedBS* pBS = m_FreeBS.back();
+            m_FreeBS.pop_back();
+            pBS->IsFree = false;
+            return pBS;
         }
         void Release(ExtendedBS* pBS)
         {
-            for (mfxU32 i=0; i < m_pExtBS.size(); i++)
-            {
-                if (&m_pExtBS[i] == pBS)
-                {
-                    m_pExtBS[i].IsFree = true;
-                    return;
-                }
-            }
-            return;
+            if (!pBS || pBS->IsFree)
+                return;
+
+            pBS->IsFree = true;
+            m_FreeBS.push_back(pBS);
         }
         void ReleaseAll()
         {
-            for (mfxU32 i = 0; i < m_pExtBS.size(); i++)
+            m_FreeBS.clear();
+            // the first element is on top of the stack as it was with the search from the beginning
+            for (mfxU32 i = (mfxU32)m_pExtBS.size(); i > 0; i--)
             {
-                m_pExtBS[i].IsFree = true;
+                m_pExtBS[i - 1].IsFree = true;
+                m_FreeBS.push_back(&m_pExtBS[i - 1]);
             }
             return;
         }
@@ -541,44 +632,99 @@ namespace TranscodingSample
         }
     protected:
         std::vector<ExtendedBS> m_pExtBS;
+        std::vector<ExtendedBS*> m_FreeBS; // stack of free elements of m_pExtBS
+        std::shared_ptr<BitstreamBufferPool> m_pBufferPool;
 
     private:
         DISALLOW_COPY_AND_ASSIGN(ExtendedBSStore);
     };
 
     class CTranscodingPipeline;
-    // thread safety buffer heterogeneous pipeline
-    // only for join sessions
-    class SafetySurfaceBuffer
+
+    // single producer ring of surfaces read by one or more joined sessions
+    // every consumer reads the ring with its own cursor, surface is unlocked when all consumers released it
+    class SurfaceRing
     {
     public:
-        struct SurfaceDescriptor
+        struct Consumer
         {
-            ExtendedSurface   ExtSurface;
-            mfxU32            Locked;
+            std::atomic<mfxU64> Cursor;     // index of the next surface to read
+            std::atomic<bool>   Cancelled;  // consumer doesn't read, producer releases surfaces on its behalf
         };
 
-        SafetySurfaceBuffer(SafetySurfaceBuffer *pNext);
+        SurfaceRing(mfxU32 nSize);
+        virtual ~SurfaceRing();
+
+        // all consumers should be added before the first surface is published
+        Consumer*         AddConsumer();
+        // number of surfaces not released by the slowest consumer
+        mfxU32            GetLength();
+
+        mfxStatus         Publish(const ExtendedSurface& Surf, mfxU32 msec);
+        mfxStatus         Peek(Consumer& c, ExtendedSurface& Surf);
+        mfxStatus         Release(Consumer& c, mfxFrameSurface1* pSurf);
+        void              Cancel(Consumer& c);
+        void              Reset(Consumer& c);
+
+        mfxStatus         WaitForPublish(Consumer& c, mfxU32 msec);
+        mfxStatus         WaitForRelease(mfxU32 msec);
+        void              AddReleaseListener(CSmplSurfacePool* pPool);
+
+    protected:
+        struct Slot
+        {
+            ExtendedSurface     ExtSurface;
+            std::atomic<mfxU32> Refs;
+        };
+
+        void              Drain(Consumer& c, bool bUnlock);
+        void              Drop(Slot& slot, bool bUnlock);
+        void              Notify();
+        template <typename Pred>
+        mfxStatus         Wait(mfxU32 msec, Pred pred);
+
+        std::unique_ptr<Slot[]>          m_Slots;
+        mfxU32                           m_nSize;
+        std::deque<Consumer>             m_Consumers;
+        std::atomic<mfxU64>              m_nHead;      // number of published surfaces
+        std::atomic<mfxU64>              m_nReleased;  // number of surfaces released by all consumers
+
+        // blocking part, is touched only when somebody waits
+        std::atomic<mfxU32>              m_nWaiters;
+        std::mutex                       m_mutex;
+        std::condition_variable          m_cond;
+
+        // pools of the producing session, notified when a surface is unlocked
+        std::vector<CSmplSurfacePool*>   m_ReleaseListeners;
+        std::mutex                       m_ListenersMutex;
+    private:
+        DISALLOW_COPY_AND_ASSIGN(SurfaceRing);
+    };
+
+    // thread safety buffer heterogeneous pipeline
+    // only for join sessions
+    // buffers of 1 to N pipeline share one ring, so a surface added to any of them is read by all the sinks
+    class SafetySurfaceBuffer
+    {
+    public:
+        SafetySurfaceBuffer(SafetySurfaceBuffer *pNext, bool bShareRing = false);
         virtual ~SafetySurfaceBuffer();
 
         mfxU32            GetLength();
         mfxStatus         WaitForSurfaceRelease(mfxU32 msec);
         mfxStatus         WaitForSurfaceInsertion(mfxU32 msec);
-        void              AddSurface(ExtendedSurface Surf);
+        mfxStatus         AddSurface(ExtendedSurface Surf);
         mfxStatus         GetSurface(ExtendedSurface &Surf);
         mfxStatus         ReleaseSurface(mfxFrameSurface1* pSurf);
         mfxStatus         ReleaseSurfaceAll();
         void              CancelBuffering();
+        void              AddReleaseListener(CSmplSurfacePool* pPool);
 
         SafetySurfaceBuffer         *m_pNext;
 
     protected:
-
-        std::mutex                   m_mutex;
-        std::list<SurfaceDescriptor> m_SList;
-        bool                         m_IsBufferingAllowed;
-        MSDKEvent*                   pRelEvent;
-        MSDKEvent*                   pInsEvent;
+        std::shared_ptr<SurfaceRing> m_pRing;
+        SurfaceRing::Consumer*       m_pConsumer;
     private:
         DISALLOW_COPY_AND_ASSIGN(SafetySurfaceBuffer);
     };
@@ -597,12 +743,50 @@ namespace TranscodingSample
         virtual mfxStatus ResetInput();
         virtual mfxStatus ResetOutput();
 
+        // moves bitstream reads and writes to a separate thread, nBuffers bitstreams are
+        // read ahead and written behind; call after SetReader and SetWriter
+        virtual mfxStatus StartAsyncIO(mfxU16 nBuffers);
+        // waits until all queued bitstreams are written
+        virtual mfxStatus FlushOutput();
+
+        // time in seconds the caller spent in GetInputBitstream/ProcessOutputBitstream
+        // since the previous call
+        mfxF64 TakeInputWaitTime();
+        mfxF64 TakeOutputWaitTime();
+
     protected:
+        void StopAsyncIO();
+        void AsyncIORoutine();
+        mfxStatus GetReadAheadBitstream();
+        mfxStatus PutWriteBehindBitstream(mfxBitstream* pBitstream);
+
         std::unique_ptr<CSmplBitstreamReader> m_pFileReader;
         std::unique_ptr<CSmplYUVReader> m_pYUVFileReader;
         // for performance options can be zero
         std::unique_ptr<CSmplBitstreamWriter> m_pFileWriter;
         mfxBitstreamWrapper m_Bitstream;
+
+        mfxF64 m_InputWaitTime;
+        mfxF64 m_OutputWaitTime;
+
+        // Asynchronous I/O: both rings are guarded by m_IOMutex; a slot is owned by the
+        // I/O thread while it is being read or written, and by the caller otherwise
+        std::thread             m_IOThread;
+        std::mutex              m_IOMutex;
+        std::condition_variable m_IOCond;
+        bool                    m_bIOStop;
+
+        std::vector<mfxBitstreamWrapper> m_ReadBuffers;
+        mfxU32                  m_nReadHead;   // next slot to hand out to the decoder
+        mfxU32                  m_nReadCount;  // number of slots filled by the I/O thread
+        mfxStatus               m_ReadStatus;  // MFX_ERR_MORE_DATA at the end of file or a read error
+        mfxU32                  m_nReadGen;    // incremented by ResetInput to discard the read-ahead data
+        mfxU32                  m_nReaderGen;  // generation the reader was last reset for
+
+        std::vector<mfxBitstreamWrapper> m_WriteBuffers;
+        mfxU32                  m_nWriteHead;  // next slot to be written to the file
+        mfxU32                  m_nWriteCount; // number of slots queued for writing
+        mfxStatus               m_WriteStatus; // first write error
     private:
         DISALLOW_COPY_AND_ASSIGN(FileBitstreamProcessor);
     };
@@ -631,6 +815,11 @@ namespace TranscodingSample
 
         mfxU32 GetProcessFrames() {return m_nProcessedFramesNum;}
 
+        // output bitstream buffers are taken from the pool, must be set before Init
+        void SetBitstreamBufferPool(const std::shared_ptr<BitstreamBufferPool>& pPool) { m_pBSBufferPool = pPool; }
+        // number of output bitstream buffer reallocations per 1000 processed frames
+        mfxF64 GetBSReallocationRate() { return m_nProcessedFramesNum ? 1000.0 * m_nBSReallocations / m_nProcessedFramesNum : 0; }
+
         bool   GetJoiningFlag() {return m_bIsJoinSession;}
 
         mfxStatus QueryMFXVersion(mfxVersion *version)
@@ -704,6 +893,8 @@ namespace TranscodingSample
         mfxStatus LoadStaticSurface();
 
         mfxFrameSurface1* GetFreeSurface(bool isDec, mfxU64 timeout);
+        // sync callback of the surface pools, waits for the oldest task of the session
+        bool SyncSurfacePool(CSmplSurfacePool& pool);
         mfxU32 GetFreeSurfacesCount(bool isDec);
         PreEncAuxBuffer*  GetFreePreEncAuxBuffer();
         void SetEncCtrlRT(ExtendedSurface& extSurface, bool bInsertIDR);
@@ -734,7 +925,9 @@ namespace TranscodingSample
         mfxStatus RGB4toBS(mfxFrameSurface1* pSurface,mfxBitstreamWrapper* pBS);
         mfxStatus YUY2toBS(mfxFrameSurface1* pSurface,mfxBitstreamWrapper* pBS);
 
-        void NoMoreFramesSignal();
+        mfxStatus NoMoreFramesSignal();
+        // moves device busy time of the decoder to decStat and of the other components to procStat
+        void TakeBusyWaitTime(CIOStat& decStat, CIOStat& procStat);
         mfxStatus AddLaStreams(mfxU16 width, mfxU16 height);
 
         void LockPreEncAuxBuffer(PreEncAuxBuffer* pBuff);
@@ -786,6 +979,8 @@ namespace TranscodingSample
         typedef std::vector<mfxFrameSurface1*> SurfPointersArray;
         SurfPointersArray  m_pSurfaceDecPool;
         SurfPointersArray  m_pSurfaceEncPool;
+        CSmplSurfacePool   m_DecSurfacePool;
+        CSmplSurfacePool   m_EncSurfacePool;
         mfxU16 m_EncSurfaceType; // actual type of encoder surface pool
         mfxU16 m_DecSurfaceType; // actual type of decoder surface pool
 
@@ -839,7 +1034,11 @@ namespace TranscodingSample
 
         bool           m_bUseOpaqueMemory; // indicates if opaque memory is used in the pipeline
 
-        mfxSyncPoint   m_LastDecSyncPoint;
+        // pace submissions of the components when the device is busy
+        CSmplSubmitController m_DecSubmit;
+        CSmplSubmitController m_VppSubmit;
+        CSmplSubmitController m_PreEncSubmit;
+        CSmplSubmitController m_EncSubmit;
 
         SafetySurfaceBuffer   *m_pBuffer;
         CTranscodingPipeline  *m_pParentPipeline;
@@ -858,6 +1057,8 @@ namespace TranscodingSample
         bool m_bInsertIDR;
 
         std::unique_ptr<ExtendedBSStore>        m_pBSStore;
+        std::shared_ptr<BitstreamBufferPool>    m_pBSBufferPool;
+        mfxU32                                  m_nBSReallocations;
 
         mfxU32                                m_FrameNumberPreference;
         mfxU32                                m_MaxFramesForTranscode;
@@ -84,6 +84,8 @@ namespace TranscodingSample
         std::vector<SafetySurfaceBuffer*>    m_pBufferArray;
 
         std::vector<FileBitstreamProcessor*> m_pExtBSProcArray;
+        // output bitstream buffers shared by all sessions
+        std::shared_ptr<BitstreamBufferPool> m_pBSBufferPool;
         std::unique_ptr<mfxAllocatorParams>    m_pAllocParam;
         std::unique_ptr<CHWDevice>             m_hwdev;
         msdk_tick                            m_StartTime;
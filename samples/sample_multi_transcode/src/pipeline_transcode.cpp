@@ -139,13 +139,13 @@ CTranscodingPipeline::CTranscodingPipeline():
     m_bEncodeEnable(true),
     m_nVPPCompEnable(0),
     m_bUseOpaqueMemory(false),
-    m_LastDecSyncPoint(0),
     m_pBuffer(NULL),
     m_pParentPipeline(NULL),
     m_bIsInit(false),
     m_NumFramesForReset(0),
     isHEVCSW(false),
     m_bInsertIDR(false),
+    m_nBSReallocations(0),
     m_FrameNumberPreference(0xFFFFFFFF),
     m_MaxFramesForTranscode(0xFFFFFFFF),
     m_pBSProcessor(NULL),
@@ -186,6 +186,9 @@ CTranscodingPipeline::CTranscodingPipeline():
     m_nRotationAngle = 0;
     m_bROIasQPMAP = false;
     m_bExtMBQP = false;
+
+    m_DecSurfacePool.SetSyncCallback([this]() { return SyncSurfacePool(m_DecSurfacePool); });
+    m_EncSurfacePool.SetSyncCallback([this]() { return SyncSurfacePool(m_EncSurfacePool); });
 } //CTranscodingPipeline::CTranscodingPipeline()
 
 CTranscodingPipeline::~CTranscodingPipeline()
@@ -540,7 +543,9 @@ mfxStatus CTranscodingPipeline::DecodeOneFrame(ExtendedSurface *pExtSurface)
     {
         if (MFX_WRN_DEVICE_BUSY == sts)
         {
-            WaitForDeviceToBecomeFree(*m_pmfxSession,m_LastDecSyncPoint,sts);
+            sts = m_DecSubmit.WaitForDevice(*m_pmfxSession, MSDK_DEC_WAIT_INTERVAL);
+            HandlePossibleGpuHang(sts);
+            MSDK_BREAK_ON_ERROR(sts);
         }
         else if (MFX_ERR_MORE_DATA == sts)
         {
@@ -557,13 +562,18 @@ mfxStatus CTranscodingPipeline::DecodeOneFrame(ExtendedSurface *pExtSurface)
                 {
                     lock.unlock();
                     // add surfaces in queue for all sinks
-                    NoMoreFramesSignal();
+                    sts = NoMoreFramesSignal();
+                    MSDK_CHECK_STATUS(sts, "NoMoreFramesSignal failed");
                     return MFX_WRN_VALUE_NOT_CHANGED;
                 }
             }
             MSDK_CHECK_POINTER_SAFE(pmfxSurface, MFX_ERR_MEMORY_ALLOC, msdk_printf(MSDK_STRING("ERROR: No free surfaces in decoder pool (during long period)\n"))); // return an error if a free surface wasn't found
         }
 
+        sts = m_DecSubmit.WaitForSlot(*m_pmfxSession, MSDK_DEC_WAIT_INTERVAL);
+        HandlePossibleGpuHang(sts);
+        MSDK_BREAK_ON_ERROR(sts);
+
         sts = m_pmfxDEC->DecodeFrameAsync(m_pmfxBS, pmfxSurface, &pExtSurface->pSurface, &pExtSurface->Syncp);
 
         if ( (MFX_WRN_DEVICE_BUSY == sts) &&
@@ -573,9 +583,9 @@ mfxStatus CTranscodingPipeline::DecodeOneFrame(ExtendedSurface *pExtSurface)
             return MFX_ERR_DEVICE_FAILED;
         }
 
-        if (sts==MFX_ERR_NONE)
+        if (MFX_ERR_NONE <= sts && pExtSurface->Syncp)
         {
-            m_LastDecSyncPoint = pExtSurface->Syncp;
+            m_DecSubmit.TaskSubmitted(pExtSurface->Syncp);
         }
         // ignore warnings if output is available,
         if (MFX_ERR_NONE < sts && pExtSurface->Syncp)
@@ -615,13 +625,24 @@ mfxStatus CTranscodingPipeline::DecodeLastFrame(ExtendedSurface *pExtSurface)
     {
         if (MFX_WRN_DEVICE_BUSY == sts)
         {
-            WaitForDeviceToBecomeFree(*m_pmfxSession,m_LastDecSyncPoint,sts);
+            sts = m_DecSubmit.WaitForDevice(*m_pmfxSession, MSDK_DEC_WAIT_INTERVAL);
+            HandlePossibleGpuHang(sts);
+            MSDK_BREAK_ON_ERROR(sts);
         }
 
         // find new working surface
         pmfxSurface = GetFreeSurface(true, MSDK_SURFACE_WAIT_INTERVAL);
         MSDK_CHECK_POINTER_SAFE(pmfxSurface, MFX_ERR_MEMORY_ALLOC, msdk_printf(MSDK_STRING("ERROR: No free surfaces in decoder pool (during long period)\n"))); // return an error if a free surface wasn't found
+
+        sts = m_DecSubmit.WaitForSlot(*m_pmfxSession, MSDK_DEC_WAIT_INTERVAL);
+        HandlePossibleGpuHang(sts);
+        MSDK_BREAK_ON_ERROR(sts);
+
         sts = m_pmfxDEC->DecodeFrameAsync(NULL, pmfxSurface, &pExtSurface->pSurface, &pExtSurface->Syncp);
+        if (MFX_ERR_NONE <= sts && pExtSurface->Syncp)
+        {
+            m_DecSubmit.TaskSubmitted(pExtSurface->Syncp);
+        }
 
         if ( (MFX_WRN_DEVICE_BUSY == sts) &&
              (DevBusyTimer.GetTime() > MSDK_DEVICE_FREE_WAIT_INTERVAL/1000) )
@@ -683,12 +704,23 @@ mfxStatus CTranscodingPipeline::VPPOneFrame(ExtendedSurface *pSurfaceIn, Extende
 
     for(;;)
     {
+        sts = m_VppSubmit.WaitForSlot(*m_pmfxSession, MSDK_VPP_WAIT_INTERVAL);
+        MSDK_BREAK_ON_ERROR(sts);
+
         sts = m_pmfxVPP->RunFrameVPPAsync(pSurfaceIn->pSurface, out_surface, NULL, &pExtSurface->Syncp);
+        if (MFX_ERR_NONE <= sts && pExtSurface->Syncp)
+        {
+            m_VppSubmit.TaskSubmitted(pExtSurface->Syncp);
+        }
 
         if (MFX_ERR_NONE < sts && !pExtSurface->Syncp) // repeat the call if warning and no output
         {
             if (MFX_WRN_DEVICE_BUSY == sts)
-                MSDK_SLEEP(1); // wait if device is busy
+            {
+                // wait for the oldest VPP task instead of sleeping
+                sts = m_VppSubmit.WaitForDevice(*m_pmfxSession, MSDK_VPP_WAIT_INTERVAL);
+                MSDK_BREAK_ON_ERROR(sts);
+            }
         }
         else if (MFX_ERR_NONE < sts && pExtSurface->Syncp)
         {
@@ -716,13 +748,24 @@ mfxStatus CTranscodingPipeline::EncodeOneFrame(ExtendedSurface *pExtSurface, mfx
 
     for (;;)
     {
+        sts = m_EncSubmit.WaitForSlot(*m_pmfxSession, MSDK_ENC_WAIT_INTERVAL);
+        MSDK_BREAK_ON_ERROR(sts);
+
         // at this point surface for encoder contains either a frame from file or a frame processed by vpp
         sts = m_pmfxENC->EncodeFrameAsync(pExtSurface->pEncCtrl, pExtSurface->pSurface, pBS, &pExtSurface->Syncp);
+        if (MFX_ERR_NONE <= sts && pExtSurface->Syncp)
+        {
+            m_EncSubmit.TaskSubmitted(pExtSurface->Syncp);
+        }
 
         if (MFX_ERR_NONE < sts && !pExtSurface->Syncp) // repeat the call if warning and no output
         {
             if (MFX_WRN_DEVICE_BUSY == sts)
-                MSDK_SLEEP(TIME_TO_SLEEP); // wait if device is busy
+            {
+                // wait for the oldest encoding task instead of sleeping
+                sts = m_EncSubmit.WaitForDevice(*m_pmfxSession, MSDK_ENC_WAIT_INTERVAL);
+                MSDK_BREAK_ON_ERROR(sts);
+            }
         }
         else if (MFX_ERR_NONE < sts && pExtSurface->Syncp)
         {
@@ -763,14 +806,25 @@ mfxStatus CTranscodingPipeline::PreEncOneFrame(ExtendedSurface *pInSurface, Exte
     MSDK_CHECK_POINTER(pAux,  MFX_ERR_MEMORY_ALLOC);
     for (;;)
     {
+        sts = m_PreEncSubmit.WaitForSlot(*m_pmfxSession, MSDK_ENC_WAIT_INTERVAL);
+        MSDK_BREAK_ON_ERROR(sts);
+
         pAux->encInput.InSurface = pInSurface->pSurface;
         // at this point surface for encoder contains either a frame from file or a frame processed by vpp
         sts = m_pmfxPreENC->ProcessFrameAsync(&pAux->encInput, &pAux->encOutput, &pOutSurface->Syncp );
+        if (MFX_ERR_NONE <= sts && pOutSurface->Syncp)
+        {
+            m_PreEncSubmit.TaskSubmitted(pOutSurface->Syncp);
+        }
 
         if (MFX_ERR_NONE < sts && !pOutSurface->Syncp) // repeat the call if warning and no output
         {
             if (MFX_WRN_DEVICE_BUSY == sts)
-                MSDK_SLEEP(TIME_TO_SLEEP); // wait if device is busy
+            {
+                // wait for the oldest PreENC task instead of sleeping
+                sts = m_PreEncSubmit.WaitForDevice(*m_pmfxSession, MSDK_ENC_WAIT_INTERVAL);
+                MSDK_BREAK_ON_ERROR(sts);
+            }
         }
         else if (MFX_ERR_NONE <= sts && pOutSurface->Syncp)
         {
@@ -790,33 +844,34 @@ mfxStatus CTranscodingPipeline::PreEncOneFrame(ExtendedSurface *pInSurface, Exte
     return sts;
 }
 
+void CTranscodingPipeline::TakeBusyWaitTime(CIOStat& decStat, CIOStat& procStat)
+{
+    decStat.AddBusyWaitTime(CIOStat::BUSY_DEC, m_DecSubmit.TakeBusyWaitTime());
+    procStat.AddBusyWaitTime(CIOStat::BUSY_VPP, m_VppSubmit.TakeBusyWaitTime());
+    procStat.AddBusyWaitTime(CIOStat::BUSY_PREENC, m_PreEncSubmit.TakeBusyWaitTime());
+    procStat.AddBusyWaitTime(CIOStat::BUSY_ENC, m_EncSubmit.TakeBusyWaitTime());
+}
+
 // signal that there are no more frames
-void CTranscodingPipeline::NoMoreFramesSignal()
+mfxStatus CTranscodingPipeline::NoMoreFramesSignal()
 {
     SafetySurfaceBuffer *pNextBuffer = m_pBuffer;
 
     // For transcoding pipelines (PipelineMode::Native) this pointer is null
     if (!pNextBuffer)
-        return;
+        return MFX_ERR_NONE;
 
+    // in 1_to_N mode all sinks share the ring, so the surface is added once
     ExtendedSurface surf={};
-    pNextBuffer->AddSurface(surf);
-
-    /*if 1_to_N mode */
-    if (0 == m_nVPPCompEnable)
-    {
-        while (pNextBuffer->m_pNext)
-        {
-            pNextBuffer = pNextBuffer->m_pNext;
-            pNextBuffer->AddSurface(surf);
-        }
-    }
+    return pNextBuffer->AddSurface(surf);
 }
 
 void CTranscodingPipeline::StopSession()
 {
     std::lock_guard<std::mutex> guard(m_mStopSession);
     m_bForceStop = true;
+    m_DecSurfacePool.CancelWaiting();
+    m_EncSurfacePool.CancelWaiting();
 
     msdk_stringstream ss;
     ss << MSDK_STRING("session [") << GetSessionText() << MSDK_STRING("] m_bForceStop is set") << std::endl;
@@ -848,11 +903,19 @@ mfxStatus CTranscodingPipeline::Decode()
         {
             lock.unlock();
             // add surfaces in queue for all sinks
-            NoMoreFramesSignal();
+            sts = NoMoreFramesSignal();
+            MSDK_CHECK_STATUS(sts, "NoMoreFramesSignal failed");
             return MFX_WRN_VALUE_NOT_CHANGED;
         }
     }
 
+    // sinks unlock our surfaces from their threads, let them wake up GetFreeSurface
+    if (m_pBuffer)
+    {
+        m_pBuffer->AddReleaseListener(&m_DecSurfacePool);
+        m_pBuffer->AddReleaseListener(&m_EncSurfacePool);
+    }
+
     if (m_bUseOverlay)
     {
         PreEncExtSurface.pSurface = m_pSurfaceDecPool[0];
@@ -860,7 +923,8 @@ mfxStatus CTranscodingPipeline::Decode()
         if (pNextBuffer->GetLength() == 0)
         {
             // add surfaces in queue for all sinks
-            pNextBuffer->AddSurface(PreEncExtSurface);
+            sts = pNextBuffer->AddSurface(PreEncExtSurface);
+            MSDK_CHECK_STATUS(sts, "AddSurface failed");
             m_nProcessedFramesNum++;
         }
         return MFX_ERR_NONE;
@@ -912,6 +976,8 @@ mfxStatus CTranscodingPipeline::Decode()
                     ((0 == m_nProcessedFramesNum % statisticsWindowSize) || bEndOfFile)
                     )
                 {
+                    inputStatistics.AddIOWaitTime(m_pBSProcessor->TakeInputWaitTime());
+                    TakeBusyWaitTime(inputStatistics, inputStatistics);
                     inputStatistics.PrintStatistics(GetPipelineID());
                     inputStatistics.ResetStatistics();
                 }
@@ -1056,18 +1122,11 @@ mfxStatus CTranscodingPipeline::Decode()
         }
 
         // add surfaces in queue for all sinks
-        pNextBuffer->AddSurface(PreEncExtSurface);
-        /* one of key parts for N_to_1 mode:
-        * decoded frame should be in one buffer only as we have only 1 (one!) sink
+        /* in 1_to_N mode buffers of all sinks share one ring, so decoded frame is added once
+        * and read by every sink; in N_to_1 mode it goes to our buffer only as we have only 1 (one!) sink
         * */
-        if (0 == m_nVPPCompEnable)
-        {
-            while (pNextBuffer->m_pNext)
-            {
-                pNextBuffer = pNextBuffer->m_pNext;
-                pNextBuffer->AddSurface(PreEncExtSurface);
-            }
-        }
+        sts = pNextBuffer->AddSurface(PreEncExtSurface);
+        MSDK_CHECK_STATUS(sts, "AddSurface failed");
 
         // We need to synchronize oldest stored surface if we've already stored enough surfaces in buffer (buffer length >= AsyncDepth)
         // Because we have to wait for decoder to finish processing and free some internally used surfaces
@@ -1109,7 +1168,8 @@ mfxStatus CTranscodingPipeline::Decode()
 
     MSDK_IGNORE_MFX_STS(sts, MFX_ERR_MORE_DATA);
 
-    NoMoreFramesSignal();
+    mfxStatus sigSts = NoMoreFramesSignal();
+    MSDK_CHECK_STATUS(sigSts, "NoMoreFramesSignal failed");
 
     if (MFX_ERR_NONE == sts)
         sts = MFX_WRN_VALUE_NOT_CHANGED;
@@ -1343,6 +1403,8 @@ mfxStatus CTranscodingPipeline::Encode()
         if ( (statisticsWindowSize && m_nOutputFramesNum && 0 == m_nProcessedFramesNum % statisticsWindowSize) ||
              (statisticsWindowSize && (m_nProcessedFramesNum >= m_MaxFramesForTranscode)))
         {
+            outputStatistics.AddIOWaitTime(m_pBSProcessor->TakeOutputWaitTime());
+            TakeBusyWaitTime(outputStatistics, outputStatistics);
             outputStatistics.PrintStatistics(GetPipelineID());
             outputStatistics.ResetStatistics();
         }
@@ -1849,6 +1911,9 @@ mfxStatus CTranscodingPipeline::Transcode()
         if ( (statisticsWindowSize && m_nOutputFramesNum && 0 == m_nProcessedFramesNum % statisticsWindowSize) ||
              (statisticsWindowSize && (m_nProcessedFramesNum >= m_MaxFramesForTranscode)))
             {
+                inputStatistics.AddIOWaitTime(m_pBSProcessor->TakeInputWaitTime());
+                outputStatistics.AddIOWaitTime(m_pBSProcessor->TakeOutputWaitTime());
+                TakeBusyWaitTime(inputStatistics, outputStatistics);
                 inputStatistics.PrintStatistics(GetPipelineID());
                 outputStatistics.PrintStatistics(
                     GetPipelineID(),
@@ -3115,6 +3180,11 @@ mfxStatus CTranscodingPipeline::AllocFrames(mfxFrameAllocRequest *pRequest, bool
         (isDecAlloc) ? m_pSurfaceDecPool.push_back(surface) : m_pSurfaceEncPool.push_back(surface);
     }
 
+    if (isDecAlloc)
+        m_DecSurfacePool.Init(m_pSurfaceDecPool.data(), (mfxU16)m_pSurfaceDecPool.size());
+    else
+        m_EncSurfacePool.Init(m_pSurfaceEncPool.data(), (mfxU16)m_pSurfaceEncPool.size());
+
     (isDecAlloc) ? m_DecSurfaceType = pRequest->Type : m_EncSurfaceType = pRequest->Type;
 
     return MFX_ERR_NONE;
@@ -3472,6 +3542,9 @@ mfxStatus CTranscodingPipeline::InitOpaqueAllocBuffers()
 
 void CTranscodingPipeline::FreeFrames()
 {
+    m_DecSurfacePool.Close();
+    m_EncSurfacePool.Close();
+
     std::for_each(m_pSurfaceDecPool.begin(), m_pSurfaceDecPool.end(), [](mfxFrameSurface1* s)
     { auto surface = static_cast<mfxFrameSurfaceWrap*>(s); delete surface; });
     m_pSurfaceDecPool.clear();
@@ -3516,6 +3589,11 @@ mfxStatus CTranscodingPipeline::Init(sInputParams *pParams,
     m_nTimeout = pParams->nTimeout;
 
     m_AsyncDepth = (0 == pParams->nAsyncDepth)? 1: pParams->nAsyncDepth;
+
+    m_DecSubmit.Init(m_AsyncDepth);
+    m_VppSubmit.Init(m_AsyncDepth);
+    m_PreEncSubmit.Init(m_AsyncDepth);
+    m_EncSubmit.Init(m_AsyncDepth);
     m_FrameNumberPreference = pParams->FrameNumberPreference;
     m_numEncoders = 0;
     m_bUseOverlay = pParams->DecodeId == MFX_CODEC_RGB4 ? true : false;
@@ -3562,7 +3640,11 @@ mfxStatus CTranscodingPipeline::Init(sInputParams *pParams,
 
     if (m_bEncodeEnable)
     {
-        m_pBSStore.reset(new ExtendedBSStore(m_AsyncDepth));
+        if (!m_pBSBufferPool)
+        {
+            m_pBSBufferPool.reset(new BitstreamBufferPool);
+        }
+        m_pBSStore.reset(new ExtendedBSStore(m_AsyncDepth, m_pBSBufferPool));
     }
 
     // Determine processing mode
@@ -3928,44 +4010,43 @@ mfxStatus CTranscodingPipeline::CompleteInit()
 } // mfxStatus CTranscodingPipeline::CompleteInit()
 mfxFrameSurface1* CTranscodingPipeline::GetFreeSurface(bool isDec, mfxU64 timeout)
 {
-    mfxFrameSurface1* pSurf = NULL;
-
-    CTimer t;
-    t.Start();
-    do
     {
+        std::lock_guard<std::mutex> lock(m_mStopSession);
+        if (m_bForceStop)
         {
-            std::lock_guard<std::mutex> lock(m_mStopSession);
-            if (m_bForceStop)
-            {
-                msdk_printf(MSDK_STRING("WARNING: m_bForceStop is set, returning NULL ptr from GetFreeSurface\n"));
-                break;
-            }
+            msdk_printf(MSDK_STRING("WARNING: m_bForceStop is set, returning NULL ptr from GetFreeSurface\n"));
+            return NULL;
         }
+    }
 
-        SurfPointersArray & workArray = isDec ? m_pSurfaceDecPool : m_pSurfaceEncPool;
+    CSmplSurfacePool & workPool = isDec ? m_DecSurfacePool : m_EncSurfacePool;
 
-        for (mfxU32 i = 0; i < workArray.size(); i++)
-        {
-            if (!workArray[i]->Data.Locked)
-            {
-                pSurf = workArray[i];
-                break;
-            }
-        }
-        if (pSurf)
-        {
-            break;
-        }
-        else
-        {
-            MSDK_SLEEP(TIME_TO_SLEEP);
-        }
-    } while ( t.GetTime() < timeout / 1000 );
-
-    return pSurf;
+    // waiting is interrupted by StopSession
+    return workPool.GetFreeSurface((mfxU32)timeout);
 } // mfxFrameSurface1* CTranscodingPipeline::GetFreeSurface(bool isDec)
 
+bool CTranscodingPipeline::SyncSurfacePool(CSmplSurfacePool& pool)
+{
+    // tasks of the later components hold the surfaces of the earlier ones.
+    // Surfaces passed to other sessions are signalled by their release listeners.
+    CSmplSubmitController* submits[] = { &m_EncSubmit, &m_PreEncSubmit, &m_VppSubmit, &m_DecSubmit };
+
+    for (CSmplSubmitController* pSubmit : submits)
+    {
+        mfxStatus sts = pSubmit->WaitForOldest(*m_pmfxSession, MSDK_WAIT_INTERVAL);
+        if (MFX_ERR_NOT_FOUND == sts)
+            continue;
+
+        // the surfaces won't be unlocked after a failure, don't wait for them
+        if (MFX_ERR_NONE > sts)
+            pool.CancelWaiting();
+
+        return MFX_ERR_NONE <= sts;
+    }
+
+    return false;
+} // bool CTranscodingPipeline::SyncSurfacePool(CSmplSurfacePool& pool)
+
 mfxU32 CTranscodingPipeline::GetFreeSurfacesCount(bool isDec)
 {
     SurfPointersArray& workArray = isDec ? m_pSurfaceDecPool : m_pSurfaceEncPool;
@@ -4150,6 +4231,24 @@ void CTranscodingPipeline::Close()
     }
 #endif
 
+    if (m_DecSurfacePool.GetStallStatistics().GetNumMeasurements())
+    {
+        msdk_stringstream ss;
+        ss << MSDK_STRING("Pipeline ") << m_nID << MSDK_STRING(" waiting for free DecPool surface:");
+        m_DecSurfacePool.GetStallStatistics().PrintStatistics(ss.str().c_str());
+    }
+    if (m_EncSurfacePool.GetStallStatistics().GetNumMeasurements())
+    {
+        msdk_stringstream ss;
+        ss << MSDK_STRING("Pipeline ") << m_nID << MSDK_STRING(" waiting for free EncPool surface:");
+        m_EncSurfacePool.GetStallStatistics().PrintStatistics(ss.str().c_str());
+    }
+    if (m_nBSReallocations)
+    {
+        msdk_printf(MSDK_STRING("Pipeline %u bitstream buffer reallocations: %u (%.2lf per 1000 frames)\n"),
+            m_nID, m_nBSReallocations, GetBSReallocationRate());
+    }
+
     // free allocated surfaces AFTER closing components
     FreeFrames();
 
@@ -4212,6 +4311,12 @@ mfxStatus CTranscodingPipeline::Reset()
     sts = m_pmfxSession->InitEx(m_initPar);
     MSDK_CHECK_STATUS(sts, "m_pmfxSession->InitEx failed");
 
+    // sync points of the closed session are not valid anymore
+    m_DecSubmit.Reset();
+    m_VppSubmit.Reset();
+    m_PreEncSubmit.Reset();
+    m_EncSubmit.Reset();
+
     // Release dec and enc surface pools
     for (size_t i = 0; i < m_pSurfaceDecPool.size(); i++)
     {
@@ -4414,7 +4519,15 @@ mfxStatus CTranscodingPipeline::AllocateSufficientBuffer(mfxBitstreamWrapper* pB
             : 2 * pBS->MaxLength;
     }
 
-    pBS->Extend(new_size);
+    if (m_pBSBufferPool)
+    {
+        m_pBSBufferPool->Extend(*pBS, new_size);
+    }
+    else
+    {
+        pBS->Extend(new_size);
+    }
+    m_nBSReallocations++;
 
     return MFX_ERR_NONE;
 } // CTranscodingPipeline::AllocateSufficientBuffer(mfxBitstreamWrapper* pBS)
@@ -4467,143 +4580,402 @@ void DecreaseReference(mfxFrameData *ptr)
     msdk_atomic_dec16((volatile mfxU16 *)&ptr->Locked);
 }
 
-SafetySurfaceBuffer::SafetySurfaceBuffer(SafetySurfaceBuffer *pNext)
-    :m_pNext(pNext),
-     m_IsBufferingAllowed(true)
-{
-    mfxStatus sts=MFX_ERR_NONE;
-    pRelEvent = new MSDKEvent(sts,false,false);
-    MSDK_CHECK_POINTER_NO_RET(pRelEvent);
-
-    pInsEvent = new MSDKEvent(sts,false,false);
-    MSDK_CHECK_POINTER_NO_RET(pInsEvent);
-
-} // SafetySurfaceBuffer::SafetySurfaceBuffer
+// surfaces in flight are limited by the decoder pool, so the ring is not expected to become full
+static const mfxU32 SURFACE_RING_SIZE = 256;
 
-SafetySurfaceBuffer::~SafetySurfaceBuffer()
+SurfaceRing::SurfaceRing(mfxU32 nSize)
+    : m_Slots(new Slot[nSize])
+    , m_nSize(nSize)
+    , m_nHead(0)
+    , m_nReleased(0)
+    , m_nWaiters(0)
 {
-    delete pRelEvent;
-    delete pInsEvent;
-} //SafetySurfaceBuffer::~SafetySurfaceBuffer()
+    for (mfxU32 i = 0; i < m_nSize; i++)
+    {
+        MSDK_ZERO_MEMORY(m_Slots[i].ExtSurface);
+        m_Slots[i].Refs = 0;
+    }
+} // SurfaceRing::SurfaceRing
 
-mfxU32 SafetySurfaceBuffer::GetLength()
+SurfaceRing::~SurfaceRing()
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    return (mfxU32)m_SList.size();
-}
+} // SurfaceRing::~SurfaceRing
 
-mfxStatus SafetySurfaceBuffer::WaitForSurfaceRelease(mfxU32 msec)
+SurfaceRing::Consumer* SurfaceRing::AddConsumer()
 {
-    return pRelEvent->TimedWait(msec);
-}
+    m_Consumers.emplace_back();
 
-mfxStatus SafetySurfaceBuffer::WaitForSurfaceInsertion(mfxU32 msec)
+    Consumer& c = m_Consumers.back();
+    c.Cursor    = m_nHead.load();
+    c.Cancelled = false;
+    return &c;
+} // SurfaceRing::Consumer* SurfaceRing::AddConsumer()
+
+mfxU32 SurfaceRing::GetLength()
 {
-    return pInsEvent->TimedWait(msec);
-}
+    mfxU64 head   = m_nHead.load(std::memory_order_acquire);
+    mfxU64 oldest = head;
 
-void SafetySurfaceBuffer::AddSurface(ExtendedSurface Surf)
+    for (std::deque<Consumer>::iterator it = m_Consumers.begin(); it != m_Consumers.end(); it++)
+    {
+        oldest = std::min(oldest, it->Cursor.load(std::memory_order_acquire));
+    }
+    return (mfxU32)(head - oldest);
+} // mfxU32 SurfaceRing::GetLength()
+
+template <typename Pred>
+mfxStatus SurfaceRing::Wait(mfxU32 msec, Pred pred)
 {
-    bool isBufferingAllowed = false;
+    if (pred())
+        return MFX_ERR_NONE;
 
+    // waiters are counted before the condition is rechecked under the lock,
+    // so a state change made by other thread either is seen here or wakes us up
+    m_nWaiters++;
     {
-        std::lock_guard<std::mutex>  guard(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait_for(lock, std::chrono::milliseconds(msec), pred);
+    }
+    m_nWaiters--;
+
+    return pred() ? MFX_ERR_NONE : MFX_WRN_IN_EXECUTION;
+} // mfxStatus SurfaceRing::Wait(mfxU32 msec, Pred pred)
 
-        isBufferingAllowed = m_IsBufferingAllowed;
-        if (isBufferingAllowed)
+void SurfaceRing::Notify()
+{
+    if (m_nWaiters.load())
+    {
+        // empty critical section orders notification after waiter's check of the condition
         {
-            SurfaceDescriptor sDescriptor;
-            // Locked is used to signal when we can free surface
-            sDescriptor.Locked = 1;
-            sDescriptor.ExtSurface = Surf;
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_cond.notify_all();
+    }
+} // void SurfaceRing::Notify()
 
-            if (Surf.pSurface)
-            {
-                IncreaseReference(&Surf.pSurface->Data);
-            }
+mfxStatus SurfaceRing::Publish(const ExtendedSurface& Surf, mfxU32 msec)
+{
+    if (m_Consumers.empty())
+        return MFX_ERR_NONE;
 
-            m_SList.push_back(sDescriptor);
-        }
+    mfxU64 head = m_nHead.load(std::memory_order_relaxed);
+    Slot& slot = m_Slots[head % m_nSize];
+
+    // slot is reused once all consumers released surface which was published there before
+    mfxStatus sts = Wait(msec, [&slot] { return 0 == slot.Refs.load(); });
+    if (MFX_ERR_NONE != sts)
+    {
+        msdk_printf(MSDK_STRING("ERROR: timed out waiting release of surface by downstream component\n"));
+        return MFX_ERR_NOT_ENOUGH_BUFFER;
     }
 
-    if (isBufferingAllowed)
+    slot.ExtSurface = Surf;
+    if (Surf.pSurface)
     {
-        pInsEvent->Signal();
+        IncreaseReference(&Surf.pSurface->Data);
     }
+    slot.Refs.store((mfxU32)m_Consumers.size(), std::memory_order_relaxed);
+    m_nHead.store(head + 1);
 
-} // SafetySurfaceBuffer::AddSurface(mfxFrameSurface1 *pSurf)
+    // cancelled consumer may have missed this surface while draining, release it on its behalf
+    for (std::deque<Consumer>::iterator it = m_Consumers.begin(); it != m_Consumers.end(); it++)
+    {
+        if (it->Cancelled.load())
+        {
+            Drain(*it, true);
+        }
+    }
 
-mfxStatus SafetySurfaceBuffer::GetSurface(ExtendedSurface &Surf)
+    Notify();
+    return MFX_ERR_NONE;
+} // mfxStatus SurfaceRing::Publish(const ExtendedSurface& Surf, mfxU32 msec)
+
+mfxStatus SurfaceRing::Peek(Consumer& c, ExtendedSurface& Surf)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
+    mfxU64 cursor = c.Cursor.load(std::memory_order_relaxed);
 
     // no ready surfaces
-    if (0 == m_SList.size())
+    if (c.Cancelled.load(std::memory_order_relaxed) || cursor == m_nHead.load(std::memory_order_acquire))
     {
-        MSDK_ZERO_MEMORY(Surf)
+        MSDK_ZERO_MEMORY(Surf);
         return MFX_ERR_MORE_SURFACE;
     }
 
-    SurfaceDescriptor sDescriptor = m_SList.front();
+    Surf = m_Slots[cursor % m_nSize].ExtSurface;
+    return MFX_ERR_NONE;
+} // mfxStatus SurfaceRing::Peek(Consumer& c, ExtendedSurface& Surf)
 
-    Surf = sDescriptor.ExtSurface;
+void SurfaceRing::Drop(Slot& slot, bool bUnlock)
+{
+    // slot can't be reused until our reference is dropped
+    mfxFrameSurface1* pSurf = slot.ExtSurface.pSurface;
 
+    if (1 != slot.Refs.fetch_sub(1))
+        return;
 
-    return MFX_ERR_NONE;
+    if (pSurf && bUnlock)
+    {
+        DecreaseReference(&pSurf->Data);
+    }
+    m_nReleased++;
 
-} // SafetySurfaceBuffer::GetSurface()
+    Notify();
 
-mfxStatus SafetySurfaceBuffer::ReleaseSurface(mfxFrameSurface1* pSurf)
-{
-    std::unique_lock<std::mutex> lock(m_mutex);
+    // wake up producer waiting for a free surface
+    std::lock_guard<std::mutex> guard(m_ListenersMutex);
+    for (size_t i = 0; i < m_ReleaseListeners.size(); i++)
+    {
+        m_ReleaseListeners[i]->NotifySurfaceUnlocked();
+    }
+} // void SurfaceRing::Drop(Slot& slot, bool bUnlock)
 
-    std::list<SurfaceDescriptor>::iterator it;
-    for (it = m_SList.begin(); it != m_SList.end(); it++)
+void SurfaceRing::Drain(Consumer& c, bool bUnlock)
+{
+    // both consumer and producer may drain cancelled consumer, cursor is advanced by the one who wins
+    mfxU64 cursor = c.Cursor.load();
+    while (cursor < m_nHead.load(std::memory_order_acquire))
     {
-        if (pSurf == it->ExtSurface.pSurface)
+        if (c.Cursor.compare_exchange_weak(cursor, cursor + 1))
         {
-            it->Locked--;
-            if (it->ExtSurface.pSurface)
-                DecreaseReference(&it->ExtSurface.pSurface->Data);
-            if (0 == it->Locked)
-            {
-                m_SList.erase(it);
-                lock.unlock();
+            Drop(m_Slots[cursor % m_nSize], bUnlock);
+            cursor++;
+        }
+    }
+} // void SurfaceRing::Drain(Consumer& c, bool bUnlock)
 
-                // event operation should be out of synced context
-                pRelEvent->Signal();
-            }
+mfxStatus SurfaceRing::Release(Consumer& c, mfxFrameSurface1* pSurf)
+{
+    if (c.Cancelled.load(std::memory_order_relaxed))
+    {
+        Drain(c, true);
+        return MFX_ERR_NONE;
+    }
 
-            return MFX_ERR_NONE;
-        }
+    // surfaces are released by consumer in the order they were read
+    mfxU64 cursor = c.Cursor.load(std::memory_order_relaxed);
+    if (cursor == m_nHead.load(std::memory_order_acquire))
+        return MFX_ERR_UNKNOWN;
+
+    Slot& slot = m_Slots[cursor % m_nSize];
+    if (pSurf != slot.ExtSurface.pSurface)
+        return MFX_ERR_UNKNOWN;
+
+    c.Cursor.store(cursor + 1, std::memory_order_release);
+    Drop(slot, true);
+
+    return MFX_ERR_NONE;
+} // mfxStatus SurfaceRing::Release(Consumer& c, mfxFrameSurface1* pSurf)
+
+void SurfaceRing::Cancel(Consumer& c)
+{
+    c.Cancelled.store(true);
+    Drain(c, true);
+} // void SurfaceRing::Cancel(Consumer& c)
+
+void SurfaceRing::Reset(Consumer& c)
+{
+    // surfaces are unlocked by the caller, so only drop references
+    Drain(c, false);
+    c.Cancelled.store(false);
+} // void SurfaceRing::Reset(Consumer& c)
+
+mfxStatus SurfaceRing::WaitForPublish(Consumer& c, mfxU32 msec)
+{
+    return Wait(msec, [this, &c] { return c.Cursor.load(std::memory_order_relaxed) != m_nHead.load(); });
+} // mfxStatus SurfaceRing::WaitForPublish(Consumer& c, mfxU32 msec)
+
+mfxStatus SurfaceRing::WaitForRelease(mfxU32 msec)
+{
+    mfxU64 nReleased = m_nReleased.load();
+    return Wait(msec, [this, nReleased] { return nReleased != m_nReleased.load(); });
+} // mfxStatus SurfaceRing::WaitForRelease(mfxU32 msec)
+
+void SurfaceRing::AddReleaseListener(CSmplSurfacePool* pPool)
+{
+    if (!pPool)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_ListenersMutex);
+    if (std::find(m_ReleaseListeners.begin(), m_ReleaseListeners.end(), pPool) == m_ReleaseListeners.end())
+    {
+        m_ReleaseListeners.push_back(pPool);
+    }
+} // void SurfaceRing::AddReleaseListener(CSmplSurfacePool* pPool)
+
+SafetySurfaceBuffer::SafetySurfaceBuffer(SafetySurfaceBuffer *pNext, bool bShareRing)
+    :m_pNext(pNext),
+     m_pConsumer(NULL)
+{
+    if (bShareRing && pNext)
+    {
+        m_pRing = pNext->m_pRing;
+    }
+    else
+    {
+        m_pRing.reset(new SurfaceRing(SURFACE_RING_SIZE));
     }
+    m_pConsumer = m_pRing->AddConsumer();
+
+} // SafetySurfaceBuffer::SafetySurfaceBuffer
+
+SafetySurfaceBuffer::~SafetySurfaceBuffer()
+{
+} //SafetySurfaceBuffer::~SafetySurfaceBuffer()
+
+mfxU32 SafetySurfaceBuffer::GetLength()
+{
+    return m_pRing->GetLength();
+}
+
+mfxStatus SafetySurfaceBuffer::WaitForSurfaceRelease(mfxU32 msec)
+{
+    return m_pRing->WaitForRelease(msec);
+}
+
+mfxStatus SafetySurfaceBuffer::WaitForSurfaceInsertion(mfxU32 msec)
+{
+    return m_pRing->WaitForPublish(*m_pConsumer, msec);
+}
 
-    return MFX_ERR_UNKNOWN;
+mfxStatus SafetySurfaceBuffer::AddSurface(ExtendedSurface Surf)
+{
+    return m_pRing->Publish(Surf, MSDK_SURFACE_WAIT_INTERVAL);
+} // SafetySurfaceBuffer::AddSurface(mfxFrameSurface1 *pSurf)
+
+mfxStatus SafetySurfaceBuffer::GetSurface(ExtendedSurface &Surf)
+{
+    return m_pRing->Peek(*m_pConsumer, Surf);
+} // SafetySurfaceBuffer::GetSurface()
+
+mfxStatus SafetySurfaceBuffer::ReleaseSurface(mfxFrameSurface1* pSurf)
+{
+    return m_pRing->Release(*m_pConsumer, pSurf);
 } // mfxStatus SafetySurfaceBuffer::ReleaseSurface(mfxFrameSurface1* pSurf)
 
-mfxStatus SafetySurfaceBuffer::ReleaseSurfaceAll()
+void SafetySurfaceBuffer::AddReleaseListener(CSmplSurfacePool* pPool)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
+    m_pRing->AddReleaseListener(pPool);
+} // void SafetySurfaceBuffer::AddReleaseListener(CSmplSurfacePool* pPool)
 
-    m_SList.clear();
-    m_IsBufferingAllowed = true;
+mfxStatus SafetySurfaceBuffer::ReleaseSurfaceAll()
+{
+    m_pRing->Reset(*m_pConsumer);
     return MFX_ERR_NONE;
 
-} // mfxStatus SafetySurfaceBuffer::ReleaseSurface(mfxFrameSurface1* pSurf)
+} // mfxStatus SafetySurfaceBuffer::ReleaseSurfaceAll()
 
 void SafetySurfaceBuffer::CancelBuffering()
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    m_IsBufferingAllowed=false;
+    m_pRing->Cancel(*m_pConsumer);
 }
 
+BitstreamBufferPool::BitstreamBufferPool()
+    : m_nAllocations(0)
+{
+} // BitstreamBufferPool::BitstreamBufferPool
+
+BitstreamBufferPool::~BitstreamBufferPool()
+{
+} // BitstreamBufferPool::~BitstreamBufferPool
+
+mfxU32 BitstreamBufferPool::GetSizeClass(mfxU32 nSize)
+{
+    mfxU32 sizeClass = 0;
+    while (sizeClass < NUM_SIZE_CLASSES - 1 && (1u << (sizeClass + MIN_SIZE_CLASS)) < nSize)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+} // mfxU32 BitstreamBufferPool::GetSizeClass(mfxU32 nSize)
+
+void BitstreamBufferPool::Extend(mfxBitstreamWrapper& bs, mfxU32 nSize)
+{
+    if (bs.MaxLength >= nSize)
+        return;
+
+    std::vector<mfxU8> buffer;
+    mfxU32 sizeClass = GetSizeClass(nSize);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // a bigger buffer will do as well
+        for (mfxU32 i = sizeClass; i < NUM_SIZE_CLASSES; i++)
+        {
+            if (!m_FreeBuffers[i].empty())
+            {
+                buffer.swap(m_FreeBuffers[i].back());
+                m_FreeBuffers[i].pop_back();
+                break;
+            }
+        }
+    }
+
+    if (buffer.size() < nSize)
+    {
+        buffer.resize(std::max<mfxU32>(nSize, 1u << (sizeClass + MIN_SIZE_CLASS)));
+        m_nAllocations++;
+    }
+
+    if (bs.DataLength)
+    {
+        std::copy(bs.Data + bs.DataOffset, bs.Data + bs.DataOffset + bs.DataLength, buffer.begin());
+    }
+    bs.DataOffset = 0;
+    bs.SwapBuffer(buffer);
+
+    // buffer now holds the old storage of the bitstream
+    PutBuffer(buffer);
+} // void BitstreamBufferPool::Extend(mfxBitstreamWrapper& bs, mfxU32 nSize)
+
+void BitstreamBufferPool::Release(mfxBitstreamWrapper& bs)
+{
+    std::vector<mfxU8> buffer;
+    bs.SwapBuffer(buffer);
+    bs.DataOffset = 0;
+    bs.DataLength = 0;
+
+    PutBuffer(buffer);
+} // void BitstreamBufferPool::Release(mfxBitstreamWrapper& bs)
+
+void BitstreamBufferPool::PutBuffer(std::vector<mfxU8>& buffer)
+{
+    // the buffer must be not smaller than any request served from its class
+    mfxU32 sizeClass = GetSizeClass((mfxU32)buffer.size());
+    if (sizeClass && (1u << (sizeClass + MIN_SIZE_CLASS)) > buffer.size())
+    {
+        sizeClass--;
+    }
+    if ((1u << (sizeClass + MIN_SIZE_CLASS)) > buffer.size())
+        return; // too small to keep
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::vector<mfxU8> >& freeBuffers = m_FreeBuffers[sizeClass];
+    if (freeBuffers.size() < MAX_FREE_BUFFERS)
+    {
+        freeBuffers.push_back(std::vector<mfxU8>());
+        freeBuffers.back().swap(buffer);
+    }
+} // void BitstreamBufferPool::PutBuffer(std::vector<mfxU8>& buffer)
+
 FileBitstreamProcessor::FileBitstreamProcessor()
+    : m_InputWaitTime(0)
+    , m_OutputWaitTime(0)
+    , m_bIOStop(false)
+    , m_nReadHead(0)
+    , m_nReadCount(0)
+    , m_ReadStatus(MFX_ERR_NONE)
+    , m_nReadGen(0)
+    , m_nReaderGen(0)
+    , m_nWriteHead(0)
+    , m_nWriteCount(0)
+    , m_WriteStatus(MFX_ERR_NONE)
 {
     m_Bitstream.TimeStamp=(mfxU64)-1;
 }
 
 FileBitstreamProcessor::~FileBitstreamProcessor()
 {
+    StopAsyncIO();
+
     if (m_pFileReader.get())
         m_pFileReader->Close();
     if (m_pFileWriter.get())
@@ -4632,13 +5004,226 @@ mfxStatus FileBitstreamProcessor::SetWriter(std::unique_ptr<CSmplBitstreamWriter
     return MFX_ERR_NONE;
 }
 
+mfxStatus FileBitstreamProcessor::StartAsyncIO(mfxU16 nBuffers)
+{
+    MSDK_CHECK_ERROR(m_IOThread.joinable(), true, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    if (!nBuffers)
+        return MFX_ERR_NONE;
+
+    // a mapped reader doesn't block on reads and hands out its pages without copying
+    if (m_pFileReader.get() && !m_pFileReader->IsMapped())
+    {
+        m_ReadBuffers.resize(nBuffers);
+        for (mfxBitstreamWrapper& bs : m_ReadBuffers)
+            bs.Extend(m_Bitstream.MaxLength);
+    }
+
+    if (m_pFileWriter.get())
+    {
+        m_WriteBuffers.resize(nBuffers);
+    }
+
+    if (m_ReadBuffers.empty() && m_WriteBuffers.empty())
+        return MFX_ERR_NONE;
+
+    m_bIOStop = false;
+    m_IOThread = std::thread(&FileBitstreamProcessor::AsyncIORoutine, this);
+
+    return MFX_ERR_NONE;
+}
+
+void FileBitstreamProcessor::StopAsyncIO()
+{
+    if (!m_IOThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_IOMutex);
+        m_bIOStop = true;
+    }
+    m_IOCond.notify_all();
+
+    // the thread writes the queued bitstreams before exiting
+    m_IOThread.join();
+}
+
+void FileBitstreamProcessor::AsyncIORoutine()
+{
+    std::unique_lock<std::mutex> lock(m_IOMutex);
+
+    for (;;)
+    {
+        // writes go first, they hold the encoder's output back
+        if (m_nWriteCount)
+        {
+            mfxBitstreamWrapper& bs = m_WriteBuffers[m_nWriteHead];
+
+            lock.unlock();
+            mfxStatus sts = m_pFileWriter->WriteNextFrame(&bs, false);
+            lock.lock();
+
+            if (MFX_ERR_NONE == m_WriteStatus)
+                m_WriteStatus = sts;
+            m_nWriteHead = (m_nWriteHead + 1) % m_WriteBuffers.size();
+            m_nWriteCount--;
+            m_IOCond.notify_all();
+            continue;
+        }
+
+        if (m_bIOStop)
+            break;
+
+        bool bResetReader = (m_nReaderGen != m_nReadGen);
+        if (!m_ReadBuffers.empty() && m_nReadCount < m_ReadBuffers.size() &&
+            (MFX_ERR_NONE == m_ReadStatus || bResetReader))
+        {
+            mfxU32 gen = m_nReadGen;
+            mfxBitstreamWrapper& bs = m_ReadBuffers[(m_nReadHead + m_nReadCount) % m_ReadBuffers.size()];
+
+            lock.unlock();
+            if (bResetReader)
+            {
+                m_pFileReader->Reset();
+            }
+
+            bs.DataOffset = 0;
+            bs.DataLength = 0;
+            bs.DataFlag   = 0;
+            mfxStatus sts = m_pFileReader->ReadNextFrame(&bs);
+            // a frame reader needs the slot to fit the whole frame
+            while (MFX_ERR_NOT_ENOUGH_BUFFER == sts)
+            {
+                bs.Extend(bs.MaxLength * 2);
+                sts = m_pFileReader->ReadNextFrame(&bs);
+            }
+            lock.lock();
+
+            m_nReaderGen = gen;
+            // data read before ResetInput is dropped
+            if (gen == m_nReadGen)
+            {
+                if (MFX_ERR_NONE == sts)
+                    m_nReadCount++;
+                else
+                    m_ReadStatus = sts;
+                m_IOCond.notify_all();
+            }
+            continue;
+        }
+
+        m_IOCond.wait(lock);
+    }
+}
+
+mfxStatus FileBitstreamProcessor::GetReadAheadBitstream()
+{
+    std::unique_lock<std::mutex> lock(m_IOMutex);
+
+    m_IOCond.wait(lock, [this] { return m_nReadCount || MFX_ERR_NONE != m_ReadStatus; });
+
+    if (!m_nReadCount)
+    {
+        if (MFX_ERR_MORE_DATA == m_ReadStatus)
+            m_Bitstream.DataFlag |= MFX_BITSTREAM_EOS;
+        return m_ReadStatus;
+    }
+
+    mfxBitstreamWrapper& bs = m_ReadBuffers[m_nReadHead];
+    lock.unlock();
+
+    // same as the reader would do with m_Bitstream: move the remaining data to
+    // the beginning and append as much as fits
+    if (m_Bitstream.MaxLength == m_Bitstream.DataLength)
+        return MFX_ERR_NOT_ENOUGH_BUFFER;
+
+    memmove(m_Bitstream.Data, m_Bitstream.Data + m_Bitstream.DataOffset, m_Bitstream.DataLength);
+    m_Bitstream.DataOffset = 0;
+
+    mfxU32 nBytes = std::min(bs.DataLength, m_Bitstream.MaxLength - m_Bitstream.DataLength);
+    MSDK_MEMCPY_BITSTREAM(m_Bitstream, m_Bitstream.DataLength, bs.Data + bs.DataOffset, nBytes);
+    m_Bitstream.DataLength += nBytes;
+
+    bs.DataOffset += nBytes;
+    bs.DataLength -= nBytes;
+
+    // end of stream is reported with the last byte of the file
+    m_Bitstream.DataFlag |= bs.DataLength ? (bs.DataFlag & ~MFX_BITSTREAM_EOS) : bs.DataFlag;
+
+    lock.lock();
+    if (!bs.DataLength)
+    {
+        m_nReadHead = (m_nReadHead + 1) % m_ReadBuffers.size();
+        m_nReadCount--;
+        m_IOCond.notify_all();
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus FileBitstreamProcessor::PutWriteBehindBitstream(mfxBitstream* pBitstream)
+{
+    std::unique_lock<std::mutex> lock(m_IOMutex);
+
+    // back-pressure: the caller waits while all the slots are queued
+    m_IOCond.wait(lock, [this] { return m_nWriteCount < m_WriteBuffers.size(); });
+
+    MSDK_CHECK_STATUS(m_WriteStatus, "FileBitstreamProcessor: bitstream write failed");
+
+    mfxBitstreamWrapper& bs = m_WriteBuffers[(m_nWriteHead + m_nWriteCount) % m_WriteBuffers.size()];
+    lock.unlock();
+
+    bs.Extend(pBitstream->DataLength);
+    MSDK_MEMCPY_BITSTREAM(bs, 0, pBitstream->Data + pBitstream->DataOffset, pBitstream->DataLength);
+    bs.DataOffset = 0;
+    bs.DataLength = pBitstream->DataLength;
+
+    // the bitstream can be reused as after a synchronous write
+    pBitstream->DataLength = 0;
+
+    lock.lock();
+    m_nWriteCount++;
+    m_IOCond.notify_all();
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus FileBitstreamProcessor::FlushOutput()
+{
+    if (m_WriteBuffers.empty())
+        return MFX_ERR_NONE;
+
+    std::unique_lock<std::mutex> lock(m_IOMutex);
+    m_IOCond.wait(lock, [this] { return 0 == m_nWriteCount; });
+
+    return m_WriteStatus;
+}
+
+mfxF64 FileBitstreamProcessor::TakeInputWaitTime()
+{
+    mfxF64 time = m_InputWaitTime;
+    m_InputWaitTime = 0;
+    return time;
+}
+
+mfxF64 FileBitstreamProcessor::TakeOutputWaitTime()
+{
+    mfxF64 time = m_OutputWaitTime;
+    m_OutputWaitTime = 0;
+    return time;
+}
+
 mfxStatus FileBitstreamProcessor::GetInputBitstream(mfxBitstreamWrapper **pBitstream)
 {
     if (!m_pFileReader.get())
     {
         return MFX_ERR_UNSUPPORTED;
     }
-    mfxStatus sts = m_pFileReader->ReadNextFrame(&m_Bitstream);
+
+    msdk_tick start = msdk_time_get_tick();
+    mfxStatus sts = m_ReadBuffers.empty() ? m_pFileReader->ReadNextFrame(&m_Bitstream) : GetReadAheadBitstream();
+    m_InputWaitTime += MSDK_GET_TIME(msdk_time_get_tick(), start, msdk_time_get_frequency());
+
     if (MFX_ERR_NONE == sts)
     {
         *pBitstream = &m_Bitstream;
@@ -4661,7 +5246,12 @@ mfxStatus FileBitstreamProcessor::GetInputFrame(mfxFrameSurface1 * pSurface)
 mfxStatus FileBitstreamProcessor::ProcessOutputBitstream(mfxBitstreamWrapper* pBitstream)
 {
     if (m_pFileWriter.get())
-        return m_pFileWriter->WriteNextFrame(pBitstream, false);
+    {
+        msdk_tick start = msdk_time_get_tick();
+        mfxStatus sts = m_WriteBuffers.empty() ? m_pFileWriter->WriteNextFrame(pBitstream, false) : PutWriteBehindBitstream(pBitstream);
+        m_OutputWaitTime += MSDK_GET_TIME(msdk_time_get_tick(), start, msdk_time_get_frequency());
+        return sts;
+    }
     else
         return MFX_ERR_NONE;
 
@@ -4671,7 +5261,20 @@ mfxStatus FileBitstreamProcessor::ResetInput()
 {
     if (m_pFileReader.get())
     {
-        m_pFileReader->Reset();
+        if (m_ReadBuffers.empty())
+        {
+            m_pFileReader->Reset();
+        }
+        else
+        {
+            // the reader is reset by the I/O thread before its next read
+            std::lock_guard<std::mutex> guard(m_IOMutex);
+            m_nReadGen++;
+            m_nReadHead  = 0;
+            m_nReadCount = 0;
+            m_ReadStatus = MFX_ERR_NONE;
+            m_IOCond.notify_all();
+        }
     }
     if (m_pYUVFileReader.get())
     {
@@ -4684,7 +5287,9 @@ mfxStatus FileBitstreamProcessor::ResetOutput()
 {
     if (m_pFileWriter.get())
     {
+        mfxStatus sts = FlushOutput();
         m_pFileWriter->Reset();
+        MSDK_CHECK_STATUS(sts, "FileBitstreamProcessor: bitstream write failed");
     }
     return MFX_ERR_NONE;
 }
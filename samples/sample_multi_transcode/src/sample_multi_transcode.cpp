@@ -88,6 +88,7 @@ mfxU32 GetPreferredAdapterNum(const mfxAdaptersInfo & adapters, const sInputPara
 #endif
 
 Launcher::Launcher():
+    m_pBSBufferPool(new BitstreamBufferPool),
     m_StartTime(0),
     m_eDevType(static_cast<mfxHandleType>(0))
 {
@@ -318,6 +319,7 @@ mfxStatus Launcher::Init(int argc, msdk_char *argv[])
         m_pExtBSProcArray.push_back(new FileBitstreamProcessor);
 
         pThreadPipeline->pPipeline.reset(CreatePipeline());
+        pThreadPipeline->pPipeline->SetBitstreamBufferPool(m_pBSBufferPool);
 
 #if (defined(_WIN32) || defined(_WIN64)) && (MFX_VERSION >= MFX_VERSION_NEXT)
         pThreadPipeline->pPipeline->SetPrefferiGfx(m_InputParamsArray[i].bPrefferiGfx);
@@ -344,6 +346,7 @@ mfxStatus Launcher::Init(int argc, msdk_char *argv[])
 
         if (reader.get())
         {
+            reader->EnableMapping(m_InputParamsArray[i].bUseMmap);
             sts = reader->Init(m_InputParamsArray[i].strSrcFile);
             MSDK_CHECK_STATUS(sts, "reader->Init failed");
             sts = m_pExtBSProcArray.back()->SetReader(reader);
@@ -353,6 +356,7 @@ mfxStatus Launcher::Init(int argc, msdk_char *argv[])
         {
             std::list<msdk_string> input;
             input.push_back(m_InputParamsArray[i].strSrcFile);
+            yuvreader->EnableMapping(m_InputParamsArray[i].bUseMmap);
             sts = yuvreader->Init(input, MFX_FOURCC_RGB4);
             MSDK_CHECK_STATUS(sts, "m_YUVReader->Init failed");
             sts = m_pExtBSProcArray.back()->SetReader(yuvreader);
@@ -365,6 +369,9 @@ mfxStatus Launcher::Init(int argc, msdk_char *argv[])
         sts = m_pExtBSProcArray.back()->SetWriter(writer);
         MSDK_CHECK_STATUS(sts, "m_pExtBSProcArray.back()->SetWriter failed");
 
+        sts = m_pExtBSProcArray.back()->StartAsyncIO(m_InputParamsArray[i].nIOBuffers);
+        MSDK_CHECK_STATUS(sts, "m_pExtBSProcArray.back()->StartAsyncIO failed");
+
         if (Sink == m_InputParamsArray[i].eMode)
         {
             /* N_to_1 mode */
@@ -1091,7 +1098,8 @@ mfxStatus Launcher::CreateSafetyBuffers()
         if ((Source == m_InputParamsArray[i].eMode) &&
             (Native == m_InputParamsArray[0].eModeExt))
         {
-            pBuffer = new SafetySurfaceBuffer(pPrevBuffer);
+            // all sinks read decoded surfaces from one ring
+            pBuffer = new SafetySurfaceBuffer(pPrevBuffer, true);
             pPrevBuffer = pBuffer;
             m_pBufferArray.push_back(pBuffer);
         }
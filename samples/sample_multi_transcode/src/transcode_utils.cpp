@@ -181,6 +181,9 @@ void TranscodingSample::PrintHelp()
 
     msdk_printf(MSDK_STRING("  -robust       Recover from gpu hang errors as they come (by resetting components)\n"));
     msdk_printf(MSDK_STRING("  -robust:soft  Recover from gpu hang errors by inserting an IDR\n"));
+    msdk_printf(MSDK_STRING("  -mmap         Map input file to memory and decode from the mapped pages without copying\n"));
+    msdk_printf(MSDK_STRING("  -io_buffers <n>  Read and write bitstreams on a separate thread with up to n buffers read ahead and n written behind\n"));
+    msdk_printf(MSDK_STRING("                   0 - file I/O on the session thread (default)\n"));
 
     msdk_printf(MSDK_STRING("  -async        Depth of asynchronous pipeline. default value 1\n"));
     msdk_printf(MSDK_STRING("  -join         Join session with other session(s), by default sessions are not joined\n"));
@@ -1516,6 +1519,20 @@ mfxStatus CmdProcessor::ParseParamsForOneSession(mfxU32 argc, msdk_char *argv[])
         {
             InputParams.bIsPerf = true;
         }
+        else if (0 == msdk_strcmp(argv[i], MSDK_STRING("-mmap")))
+        {
+            InputParams.bUseMmap = true;
+        }
+        else if (0 == msdk_strcmp(argv[i], MSDK_STRING("-io_buffers")))
+        {
+            VAL_CHECK(i+1 == argc, i, argv[i]);
+            i++;
+            if (MFX_ERR_NONE != msdk_opt_read(argv[i], InputParams.nIOBuffers))
+            {
+                PrintError(MSDK_STRING("io_buffers \"%s\" is invalid"), argv[i]);
+                return MFX_ERR_UNSUPPORTED;
+            }
+        }
         else if (0 == msdk_strcmp(argv[i], MSDK_STRING("-robust")))
         {
             InputParams.bRobustFlag = true;
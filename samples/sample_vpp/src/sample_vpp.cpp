@@ -278,7 +278,7 @@ int main(int argc, msdk_char *argv[])
 
     CRawVideoReader     yuvReaders[MAX_INPUT_STREAMS];
 
-    CTimeStatistics     statTimer;
+    CTimeStatisticsReal statTimer;
 
     sFrameProcessor     frameProcessor;
     sMemoryAllocator    allocator{};
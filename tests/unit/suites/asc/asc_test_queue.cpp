@@ -0,0 +1,293 @@
+// Copyright (c) 2017-2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "asc.h"
+
+using namespace ns_asc;
+
+namespace
+{
+    const mfxI32 width  = 640;
+    const mfxI32 height = 360;
+    const int    frames = 120;
+
+    struct Decision
+    {
+        mfxU32 frameNumber, shot, pdist;
+        mfxI32 spatial, temporal;
+        bool   repeated, ltr;
+
+        bool operator == (const Decision& other) const
+        {
+            return frameNumber == other.frameNumber && shot == other.shot && pdist == other.pdist &&
+                spatial == other.spatial && temporal == other.temporal &&
+                repeated == other.repeated && ltr == other.ltr;
+        }
+    };
+
+    Decision Get(ASC& asc)
+    {
+        return { asc.Get_frame_number(), asc.Get_frame_shot_Decision(), asc.Get_PDist_advice(),
+            asc.Get_frame_Spatial_complexity(), asc.Get_frame_Temporal_complexity(),
+            asc.Get_RepeatedFrame_advice(), asc.Get_LTR_advice() };
+    }
+
+    // moving patterns with a scene cut every 23 frames, gain changes and
+    // repeated frames
+    std::vector<std::vector<mfxU8>> Sequence()
+    {
+        std::vector<std::vector<mfxU8>> seq(frames, std::vector<mfxU8>(width * height));
+
+        for (int i = 0; i < frames; i++)
+        {
+            if (i % 31 == 10)
+            {
+                seq[i] = seq[i - 1];
+                continue;
+            }
+
+            int scene = i / 23;
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    int v = ((x + i * (scene % 3 + 1)) * (scene + 3) / 7 + y * (scene % 5 + 1) / 3 + ((x ^ y) & (scene * 13 % 64))) & 255;
+                    if (i % 17 == 5)
+                        v = v * 3 / 4 + 10;
+                    seq[i][y * width + x] = (mfxU8)v;
+                }
+            }
+        }
+        return seq;
+    }
+
+    class ASCQueue : public ::testing::TestWithParam<mfxU32>
+    {
+    protected:
+        void SetUp() override
+        {
+            seq = Sequence();
+
+            ASC asc;
+            ASSERT_EQ(MFX_ERR_NONE, asc.Init(width, height, width, GetParam(), nullptr));
+            for (auto& frame : seq)
+            {
+                ASSERT_EQ(MFX_ERR_NONE, Interlaced() ? asc.PutFrameInterlaced(frame.data(), width) : asc.PutFrameProgressive(frame.data(), width));
+                expected.push_back(Get(asc));
+                cuts += expected.back().shot;
+            }
+            asc.Close();
+        }
+
+        bool Interlaced() const
+        {
+            return GetParam() != MFX_PICSTRUCT_PROGRESSIVE;
+        }
+
+        // queues the sequence, ProcessQueuedFrame() is called when the queue
+        // is full and at the end
+        std::vector<Decision> RunQueued(ASC& asc)
+        {
+            std::vector<Decision> actual;
+
+            for (auto& frame : seq)
+            {
+                for (;;)
+                {
+                    mfxStatus sts = Interlaced() ? asc.QueueFrameInterlaced(frame.data(), width) : asc.QueueFrameProgressive(frame.data(), width);
+                    if (sts == MFX_ERR_NONE)
+                        break;
+
+                    EXPECT_EQ(MFX_WRN_DEVICE_BUSY, sts);
+                    EXPECT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+                    actual.push_back(Get(asc));
+                }
+            }
+
+            while (asc.Query_queued_frames())
+            {
+                EXPECT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+                actual.push_back(Get(asc));
+            }
+            return actual;
+        }
+
+        std::vector<std::vector<mfxU8>> seq;
+        std::vector<Decision>           expected;
+        mfxU32                          cuts = 0;
+    };
+}
+
+TEST_P(ASCQueue, CallerThreadGivesSameDecisionsAsPutFrame)
+{
+    ASSERT_GT(cuts, 0u);
+
+    ASC asc;
+    ASSERT_EQ(MFX_ERR_NONE, asc.Init(width, height, width, GetParam(), nullptr));
+    EXPECT_FALSE(asc.PrepareQueuedFrame());
+
+    std::vector<Decision> actual = RunQueued(asc);
+    EXPECT_FALSE(asc.PrepareQueuedFrame());
+    asc.Close();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_TRUE(expected[i] == actual[i]) << "frame " << i;
+}
+
+TEST_P(ASCQueue, HelperThreadsGiveSameDecisionsAsPutFrame)
+{
+    ASC asc;
+    ASSERT_EQ(MFX_ERR_NONE, asc.Init(width, height, width, GetParam(), nullptr));
+
+    // helpers may run from Init() on, before any frame is queued
+    std::atomic<bool> stop(false);
+    std::atomic<int>  prepared(0);
+    std::vector<std::thread> helpers;
+    for (int i = 0; i < 2; i++)
+    {
+        helpers.emplace_back([&]
+        {
+            while (!stop)
+            {
+                if (asc.PrepareQueuedFrame())
+                    prepared++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<Decision> actual = RunQueued(asc);
+    stop = true;
+    for (auto& helper : helpers)
+        helper.join();
+    asc.Close();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_TRUE(expected[i] == actual[i]) << "frame " << i;
+    EXPECT_GT(prepared, 0);
+}
+
+TEST_P(ASCQueue, PreparedFramesMayBeReleased)
+{
+    ASC asc;
+    ASSERT_EQ(MFX_ERR_NONE, asc.Init(width, height, width, GetParam(), nullptr));
+
+    // a helper takes some of the frames, the rest are prepared by the caller
+    std::atomic<bool> stop(false);
+    std::thread helper([&]
+    {
+        while (!stop)
+            if (!asc.PrepareQueuedFrame())
+                std::this_thread::yield();
+    });
+
+    // frames are mapped only while being queued, like locked input surfaces
+    // of the encoder: the buffer is overwritten once prepared
+    std::vector<mfxU8> mapped(width * height);
+    std::vector<Decision> actual;
+    for (auto& frame : seq)
+    {
+        mapped = frame;
+        ASSERT_EQ(MFX_ERR_NONE, Interlaced() ? asc.QueueFrameInterlaced(mapped.data(), width) : asc.QueueFrameProgressive(mapped.data(), width));
+        asc.PrepareQueuedFrames();
+        std::fill(mapped.begin(), mapped.end(), mfxU8(0x80));
+
+        if (asc.Query_queued_frames() > 1)
+        {
+            EXPECT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+            actual.push_back(Get(asc));
+        }
+    }
+    while (asc.Query_queued_frames())
+    {
+        EXPECT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+        actual.push_back(Get(asc));
+    }
+    stop = true;
+    helper.join();
+    asc.Close();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_TRUE(expected[i] == actual[i]) << "frame " << i;
+}
+
+// frames/s of PutFrame*() and of the queued path where another thread
+// prepares the next frame while the caller analyzes the previous one, as the
+// H.264 encoder does with two frames between STG_START_SCD and STG_WAIT_SCD
+TEST_P(ASCQueue, DISABLED_FramesPerSecond)
+{
+    const int repeat = 10;
+
+    for (int queued = 0; queued < 2; queued++)
+    {
+        ASC asc;
+        ASSERT_EQ(MFX_ERR_NONE, asc.Init(width, height, width, GetParam(), nullptr));
+
+        std::atomic<bool> stop(false);
+        std::thread helper([&]
+        {
+            while (queued && !stop)
+                if (!asc.PrepareQueuedFrame())
+                    std::this_thread::yield();
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++)
+        {
+            for (auto& frame : seq)
+            {
+                if (!queued)
+                {
+                    ASSERT_EQ(MFX_ERR_NONE, Interlaced() ? asc.PutFrameInterlaced(frame.data(), width) : asc.PutFrameProgressive(frame.data(), width));
+                    continue;
+                }
+
+                ASSERT_EQ(MFX_ERR_NONE, Interlaced() ? asc.QueueFrameInterlaced(frame.data(), width) : asc.QueueFrameProgressive(frame.data(), width));
+                if (asc.Query_queued_frames() > 1)
+                {
+                    ASSERT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+                }
+            }
+        }
+        while (asc.Query_queued_frames())
+            ASSERT_EQ(MFX_ERR_NONE, asc.ProcessQueuedFrame());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        stop = true;
+        helper.join();
+        asc.Close();
+
+        printf("%s: %.0f frames/s\n", queued ? "queued, 1 helper" : "PutFrame", repeat * seq.size() / elapsed.count());
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(PicStruct, ASCQueue,
+    ::testing::Values(MFX_PICSTRUCT_PROGRESSIVE, MFX_PICSTRUCT_FIELD_TFF));
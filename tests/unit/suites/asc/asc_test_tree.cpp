@@ -0,0 +1,1168 @@
+// Copyright (c) 2017-2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <climits>
+#include "tree.h"
+#include "asc_defs.h"
+
+// Inputs of SCDetectRF() with the number of votes the original nested if
+// implementation of the forest gave for them. The first part is recorded from
+// ASC runs, the rest sits on the split thresholds of the trees and reaches
+// nearly every leaf of the forest.
+struct RecordedFeatures
+{
+    mfxI32 diffMVdiffVal;
+    mfxU32 RsCsDiff, MVDiff, Rs, AFD, CsDiff;
+    mfxI32 diffTSC;
+    mfxU32 TSC, gchDC;
+    mfxI32 diffRsCsdiff;
+    mfxU32 posBalance, SC, TSCindex, Scindex, Cs;
+    mfxI32 diffAFD;
+    mfxU32 negBalance, ssDCval, refDCval, RsDiff;
+    mfxU8 votes;
+};
+
+static const RecordedFeatures recorded[] =
+{
+    { 27, 485, 27, 2372, 15, 17, 8, 8, 22, 481, 19, 5168, 9, 5, 2796, 15, 104, 104, 126, 14, 1 },
+    { 143, 9850, 170, 8059, 75, 65, 13, 21, 23, 9365, 75, 14586, 9, 7, 6527, 60, 51, 127, 104, 75, 19 },
+    { 24, 1313, 28, 4531, 15, 23, 10, 12, 22, 1288, 20, 8165, 9, 6, 3634, 13, 103, 105, 127, 28, 2 },
+    { 105, 24218, 109, 11442, 85, 107, 19, 20, 0, 24193, 63, 23362, 9, 9, 11920, 83, 63, 127, 127, 113, 19 },
+    { 8, 3617, 16, 6316, 17, 44, 12, 15, 23, 3327, 21, 12779, 9, 7, 6463, 14, 102, 104, 127, 41, 3 },
+    { 89, 338, 99, 18082, 84, 13, 25, 28, 0, 25, 63, 33759, 9, 9, 15677, 81, 63, 127, 127, 13, 11 },
+    { 0, 6506, 0, 10222, 16, 55, 15, 16, 22, 6506, 20, 18869, 9, 8, 8647, 15, 103, 105, 127, 59, 8 },
+    { 0, 7060, 0, 18858, 16, 52, 0, 16, 23, 554, 109, 34266, 9, 9, 15408, 0, 14, 128, 105, 66, 1 },
+    { 0, 7837, 0, 10786, 15, 59, 13, 15, 22, 7667, 19, 19777, 9, 8, 8991, 13, 104, 105, 127, 66, 6 },
+    { 0, 7321, 0, 18665, 16, 60, 1, 16, 22, -516, 109, 35257, 9, 9, 16592, 1, 15, 127, 105, 61, 1 },
+    { 65, 745, 65, 21732, 85, 4, 8, 24, 2, -6576, 62, 37240, 9, 9, 15508, 69, 64, 125, 127, 27, 9 },
+    { 13, 8945, 23, 11538, 16, 52, 13, 16, 23, 8783, 21, 20418, 9, 8, 8880, 13, 103, 104, 127, 79, 7 },
+    { -9, 9745, 14, 21431, 18, 63, 1, 17, 22, 800, 109, 38381, 9, 9, 16950, 2, 14, 126, 104, 76, 3 },
+    { 73, 898, 80, 4172, 85, 13, 56, 59, 1, 846, 64, 17367, 9, 8, 13195, 82, 62, 127, 126, 27, 20 },
+    { 21, 2405, 28, 2296, 18, 46, 12, 14, 23, 2163, 23, 9600, 9, 6, 7304, 12, 100, 104, 127, 17, 3 },
+    { 66, 5620, 74, 8120, 84, 12, 18, 19, 0, 5412, 64, 22486, 9, 8, 14366, 78, 62, 127, 127, 74, 18 },
+    { 11, 3442, 11, 4532, 16, 51, 13, 15, 22, 3397, 20, 12454, 9, 7, 7922, 14, 103, 105, 127, 29, 5 },
+    { 12, 3442, 13, 4571, 16, 51, 13, 15, 22, 3397, 20, 12499, 9, 7, 7928, 14, 103, 105, 127, 29, 5 },
+    { 87, 10301, 97, 12011, 84, 10, 19, 21, 1, 10291, 64, 27245, 9, 9, 15234, 82, 62, 128, 127, 101, 19 },
+    { 52, 274, 67, 19875, 85, 15, 23, 27, 1, 9, 64, 40156, 9, 9, 20281, 81, 62, 129, 128, 7, 3 },
+    { 3, 1985, 70, 19034, 9, 31, -21, 6, 1, 1711, 125, 37713, 7, 9, 18679, -76, 2, 128, 129, 32, 2 },
+    { 0, 11250, 9, 9854, 19, 75, 11, 17, 23, 8480, 25, 19644, 9, 8, 9790, 10, 98, 104, 127, 75, 3 },
+    { 4, 9397, 13, 19007, 19, 66, 1, 18, 22, -1853, 113, 37294, 9, 9, 18287, 0, 10, 126, 104, 71, 1 },
+    { 89, 490, 99, 21526, 84, 7, 22, 28, 0, -1759, 63, 42219, 9, 9, 20693, 75, 63, 127, 127, 21, 9 },
+    { -108, 10960, 9, 12005, 16, 72, 13, 15, 23, 10915, 20, 23584, 9, 9, 11579, 13, 103, 105, 128, 76, 6 },
+    { 3, 10817, 12, 21774, 17, 71, 2, 17, 22, -143, 109, 42398, 9, 9, 20624, 1, 13, 127, 105, 76, 3 },
+    { -1, 11105, 2, 11914, 16, 73, 12, 15, 22, 11020, 20, 23490, 9, 9, 11576, 13, 102, 105, 127, 76, 4 },
+    { 6, 11268, 8, 21814, 18, 72, 2, 17, 22, 163, 112, 42555, 9, 9, 20741, 2, 11, 127, 105, 78, 3 },
+    { 52, 1160, 63, 4230, 85, 26, 59, 62, 0, 979, 64, 24466, 9, 9, 20236, 82, 63, 127, 127, 22, 13 },
+    { 68, 244, 131, 4230, 7, 10, -59, 3, 0, -916, 126, 24461, 4, 9, 20231, -78, 1, 127, 127, 12, 1 },
+    { 39, 5584, 59, 2350, 17, 72, 12, 15, 22, 5340, 24, 13443, 9, 7, 11093, 10, 99, 105, 127, 20, 3 },
+    { 6, 5584, 65, 4170, 18, 72, 1, 16, 22, 0, 113, 24473, 9, 9, 20303, 1, 10, 127, 105, 20, 1 },
+    { 72, 4996, 96, 8109, 86, 30, 16, 19, 0, 4775, 63, 29371, 9, 9, 21262, 79, 63, 127, 127, 64, 19 },
+    { -21, 1018, 75, 8090, 11, 27, -15, 4, 0, -3978, 125, 29326, 5, 9, 21236, -75, 3, 127, 127, 17, 1 },
+    { 76, 2312, 87, 8150, 22, 34, 4, 7, 0, 1860, 122, 29418, 8, 9, 21268, 11, 5, 128, 128, 34, 1 },
+    { 104, 8185, 118, 11825, 84, 21, 18, 21, 1, 7529, 63, 34157, 9, 9, 22332, 73, 63, 127, 128, 88, 19 },
+    { 36, 7848, 50, 6516, 16, 78, 12, 15, 22, 7598, 21, 18808, 9, 8, 12292, 12, 102, 105, 127, 42, 1 },
+    { 95, 12997, 106, 19192, 84, 1, 28, 30, 0, 12912, 63, 42127, 9, 9, 22935, 80, 62, 127, 127, 114, 18 },
+    { 21, 549, 23, 2336, 15, 18, 8, 8, 22, 544, 19, 5113, 9, 5, 2777, 14, 104, 104, 126, 15, 1 },
+    { 34, 485, 36, 2360, 15, 17, 8, 8, 22, 477, 18, 5157, 9, 5, 2797, 14, 105, 104, 126, 14, 1 },
+    { 138, 9850, 174, 8091, 75, 65, 13, 21, 23, 9365, 75, 14614, 9, 7, 6523, 60, 51, 127, 104, 75, 19 },
+    { 25, 1476, 30, 4525, 16, 24, 10, 12, 22, 1404, 21, 8162, 9, 6, 3637, 13, 102, 105, 127, 30, 2 },
+    { 98, 23834, 107, 12208, 85, 103, 18, 20, 0, 23760, 63, 23447, 9, 9, 11239, 82, 63, 127, 127, 115, 19 },
+    { 76, 468, 89, 18636, 84, 12, 28, 29, 0, 458, 63, 34115, 9, 9, 15479, 83, 63, 127, 127, 18, 18 },
+    { 0, 7442, 0, 11284, 16, 61, 14, 16, 22, 7353, 22, 19997, 9, 8, 8713, 14, 100, 105, 127, 61, 8 },
+    { 0, 8290, 0, 20520, 16, 57, 0, 16, 22, 848, 107, 36688, 9, 9, 16168, 0, 17, 127, 105, 71, 1 },
+    { 0, 7605, 0, 10964, 16, 57, 12, 16, 22, 6925, 17, 20176, 9, 8, 9212, 12, 106, 105, 127, 66, 2 },
+    { 0, 8264, 0, 19277, 17, 58, 1, 17, 22, 659, 111, 35163, 9, 9, 15886, 1, 13, 127, 105, 70, 1 },
+    { 59, 1098, 59, 21583, 85, 3, 7, 24, 1, -7166, 62, 37091, 9, 9, 15508, 68, 64, 126, 127, 33, 6 },
+    { 0, 8741, 18, 11902, 19, 50, 14, 18, 24, 8560, 23, 21036, 9, 8, 9134, 14, 99, 104, 128, 79, 8 },
+    { -2, 9225, 16, 21639, 16, 60, -2, 16, 22, 484, 106, 38576, 9, 9, 16937, -3, 16, 126, 104, 75, 3 },
+    { 60, 953, 78, 4156, 85, 13, 53, 59, 0, 543, 63, 17351, 9, 8, 13195, 79, 63, 127, 127, 28, 18 },
+    { 24, 2372, 33, 2312, 17, 46, 12, 14, 22, 2128, 23, 9629, 9, 6, 7317, 10, 100, 105, 127, 16, 3 },
+    { 87, 5353, 97, 8076, 84, 13, 17, 19, 0, 5103, 64, 22428, 9, 8, 14352, 77, 62, 127, 127, 72, 20 },
+    { 9, 3341, 11, 4479, 16, 50, 14, 15, 22, 3316, 21, 12417, 9, 7, 7938, 15, 102, 105, 127, 29, 5 },
+    { 113, 10730, 135, 12374, 84, 11, 5, 21, 1, 7288, 64, 27590, 9, 9, 15216, 67, 62, 128, 127, 103, 8 },
+    { -2, 5234, 24, 6797, 18, 55, 13, 16, 22, 4945, 23, 15123, 9, 7, 8326, 14, 99, 105, 127, 47, 6 },
+    { 39, 277, 53, 20370, 85, 14, 22, 27, 0, -144, 64, 40374, 9, 9, 20004, 78, 63, 128, 128, 9, 4 },
+    { 3, 2746, 56, 19357, 11, 35, -19, 8, 0, 2469, 124, 37566, 9, 9, 18209, -74, 3, 128, 128, 39, 2 },
+    { -3, 9945, 9, 10007, 18, 69, 9, 17, 23, 6385, 23, 19822, 9, 8, 9815, 6, 100, 104, 127, 72, 1 },
+    { 4, 10376, 13, 19665, 21, 70, 2, 19, 21, 431, 115, 38384, 9, 9, 18719, 3, 8, 125, 104, 74, 1 },
+    { 23, 5945, 56, 18693, 19, 56, 10, 12, 1, 5783, 123, 36824, 9, 9, 18131, 17, 4, 127, 126, 53, 2 },
+    { 119, 712, 131, 21979, 85, 6, 23, 28, 0, -801, 63, 42651, 9, 9, 20672, 78, 63, 127, 127, 26, 9 },
+    { -138, 11405, 11, 12162, 17, 74, 16, 17, 22, 11299, 23, 23762, 9, 9, 11600, 16, 100, 105, 127, 77, 10 },
+    { -1, 10829, 10, 22054, 16, 70, -1, 16, 22, -576, 107, 42654, 9, 9, 20600, -1, 16, 127, 105, 77, 3 },
+    { 0, 10960, 5, 11958, 15, 72, 10, 15, 22, 10595, 18, 23534, 9, 9, 11576, 9, 105, 105, 127, 76, 3 },
+    { 2, 11268, 6, 22022, 17, 72, 15, 17, 22, 11243, 110, 42790, 9, 9, 20768, 15, 13, 127, 105, 78, 7 },
+    { 56, 1170, 67, 4209, 85, 27, 56, 61, 1, 446, 64, 24467, 9, 9, 20258, 78, 62, 127, 126, 21, 13 },
+    { 53, 5729, 69, 2313, 18, 73, 13, 15, 22, 5529, 24, 13330, 9, 7, 11017, 12, 99, 105, 127, 20, 3 },
+    { 84, 4869, 101, 8088, 85, 30, 16, 19, 1, 4667, 63, 29400, 9, 9, 21312, 79, 63, 126, 127, 63, 20 },
+    { 267, 9090, 303, 12396, 84, 21, 17, 22, 0, 8032, 63, 34641, 9, 9, 22245, 72, 63, 127, 127, 93, 18 },
+    { 23, 13460, 60, 19618, 84, 2, 28, 30, 0, 13386, 63, 42779, 9, 9, 23161, 82, 63, 127, 127, 116, 13 },
+    { 0, 5, 0, 4200, 0, 1, 0, 0, 0, 5, 53, 9270, 0, 6, 5070, 0, 0, 126, 126, 2, 0 },
+    { 0, 4, 0, 4170, 0, 2, 0, 0, 0, -1, 54, 9210, 0, 6, 5040, 0, 0, 126, 126, 0, 0 },
+    { 3, 8, 11, 8061, 1, 2, -1, 1, 1, -33, 127, 14602, 2, 7, 6541, -1, 0, 128, 127, 2, 0 },
+    { 0, 136, 8, 11384, 3, 10, -1, 3, 0, -332, 127, 23060, 4, 9, 11676, -1, 0, 127, 127, 6, 0 },
+    { 0, 170, 0, 19237, 2, 7, 1, 2, 0, 42, 109, 35702, 2, 9, 16465, 1, 0, 127, 127, 11, 0 },
+    { -7, 52, 7, 21427, 3, 6, -1, 3, 0, -534, 127, 36823, 4, 9, 15396, -1, 0, 126, 126, 4, 0 },
+    { -1, 221, 53, 4297, 7, 11, 0, 2, 1, -336, 126, 17439, 2, 8, 13142, -6, 1, 126, 127, 10, 0 },
+    { 10, 3501, 23, 8178, 17, 51, 1, 16, 22, 59, 109, 22527, 9, 8, 14349, 1, 14, 127, 105, 30, 0 },
+    { -8, 208, 9, 11720, 5, 12, 0, 4, 0, -13, 126, 26592, 5, 9, 14872, 0, 1, 127, 127, 8, 0 },
+    { -4, 1745, 5, 18508, 9, 28, 1, 7, 0, -179, 125, 36599, 8, 9, 18091, 0, 2, 128, 128, 31, 0 },
+    { 3, 181, 11, 21683, 3, 10, -14, 3, 0, -11087, 126, 42325, 4, 9, 20642, -15, 1, 127, 127, 9, 0 },
+    { -64, 305, 11, 8042, 11, 7, -1, 3, 0, -713, 125, 29265, 4, 9, 21223, 0, 2, 127, 127, 16, 0 },
+    { -3, 8109, 115, 6479, 16, 78, -6, 15, 22, -76, 22, 18863, 9, 8, 12384, -68, 101, 105, 127, 45, 0 },
+    { -6, 85, 11, 11171, 4, 7, -1, 2, 0, -60, 126, 33713, 3, 9, 22542, 0, 1, 127, 127, 6, 0 },
+    { 0, 8, 2, 4185, 1, 2, 0, 0, 0, 0, 79, 9225, 1, 6, 5040, 0, 0, 126, 126, 2, 0 },
+    { -6, 18, 9, 8120, 2, 3, 0, 2, 0, -19, 66, 14674, 2, 7, 6554, -1, 0, 128, 128, 3, 0 },
+    { 1, 666, 9, 12042, 6, 21, 3, 5, 0, 502, 126, 22736, 6, 8, 10694, 4, 1, 127, 127, 15, 0 },
+    { 0, 425, 0, 19863, 2, 13, -1, 2, 0, 137, 36, 36824, 3, 9, 16961, -1, 27, 128, 128, 16, 0 },
+    { -7, 410, 18, 21399, 6, 17, -1, 6, 1, -1255, 126, 36795, 7, 9, 15396, -4, 1, 127, 126, 11, 0 },
+    { -40, 520, 20, 4157, 13, 18, 1, 2, 1, 495, 124, 17331, 3, 8, 13174, 12, 3, 127, 126, 14, 0 },
+    { -3, 181, 6, 8045, 5, 10, 0, 4, 0, 51, 126, 22409, 5, 8, 14364, 0, 1, 127, 127, 9, 0 },
+    { 2, 425, 27, 12641, 7, 13, 2, 5, 1, 276, 126, 27691, 6, 9, 15050, 3, 1, 127, 126, 16, 0 },
+    { -1, 970, 9, 18798, 7, 23, -2, 6, 0, -1867, 125, 36631, 7, 9, 17833, -4, 2, 128, 128, 21, 0 },
+    { 5, 724, 11, 21341, 7, 18, -12, 5, 1, -10544, 125, 41698, 6, 9, 20357, -10, 2, 126, 127, 20, 0 },
+    { -31, 25, 118, 520, 18, 5, 2, 39, 77, 531, 106, 599, 6, 6, 275, -9, 55, 167, UINT_MAX, 0, 1 },
+    { 175, 39, 244, 442, 6, 10, 18, 41, 35, 123, UINT_MAX, 1600, UINT_MAX, 2, 353, 8, 73, 213, 27, 55, 15 },
+    { 50, 163, 47, 1517, 14, 9, -6, 33, 118, 575, 65, 3378, 6, 1, 232, -23, 0, 54, 53, 3, 4 },
+    { 109, 445, 121, 1504, 9, UINT_MAX, 6, 16, 45, 50, 8, 0, 4, 3, 7859, 18, 104, 113, UINT_MAX, 52, 6 },
+    { 349, 254, 0, 54, 34, UINT_MAX, 20, 35, 109, 63, 16, 3949, 8, 6, 387, -23, UINT_MAX, 158, 41, 8, 8 },
+    { -178, 157, 1032, 199, 13, UINT_MAX, 15, 27, 31, INT_MIN, 43, 1211, 6, 6, 2269, 19, 0, 152, 56, 62, 10 },
+    { -25, 445, 812, 0, 16, 14, 19, 14, 0, 0, 30, 1697, 5, 4, 36, 50, 78, 128, 33, 1, 9 },
+    { 517, 0, 681, 277, 32, 1, INT_MAX, 12, 48, INT_MIN, UINT_MAX, 1182, 7, 5, 541, 4, 116, 117, 0, 21, 10 },
+    { 218, 19, 154, 1325, 73, 8, 25, 29, 61, 187, 51, 2722, 5, 2, 1, -38, 56, 31, 39, 110, 11 },
+    { -51, 1439, 186, 4606, 41, 2, INT_MAX, UINT_MAX, 20, -20, 94, 2370, 9, 0, 162, -12, 49, 32, 229, 76, 9 },
+    { 52, 25, 123, 5453, 2, 30, 5, 28, 73, 209, 48, 41, 7, 1, 3595, 10, 7, 93, 27, 65, 4 },
+    { 11, 417, 139, 31, UINT_MAX, 24, 9, 8, 27, -190, 2, 0, 9, 0, 159, 25, 63, 159, 20, 27, 11 },
+    { 74, 622, 392, 96, 26, 29, 24, 53, 86, 259, 26, 128, 8, 3, 4719, 18, 21, 36, 77, 64, 17 },
+    { 83, 2454, 61, 174, 66, 29, 13, 10, 58, 180, 49, 599, 0, 0, 1325, 29, 32, 0, 18, 17, 17 },
+    { INT_MIN, 19, 158, 2096, 15, 14, -2, 38, 65, 175, UINT_MAX, 56, 7, 3, UINT_MAX, 17, 30, 74, 70, UINT_MAX, 8 },
+    { 112, 0, 47, 0, 33, 0, 32, 8, 105, -20, 100, 1976, 10, 4, 524, -7, 26, 131, 36, 56, 10 },
+    { 106, 28, 62, 453, 56, 42, 33, 37, 13, 164, 51, 532, 8, 1, 46, 45, 19, 26, 29, 35, 19 },
+    { 131, 222, 161, 667, 27, UINT_MAX, 11, 37, 118, 75, 117, 690, 8, 3, 131, 13, 124, 219, 65, 12, 13 },
+    { 268, 725, 140, 2, 31, 34, 19, 50, 24, 72, 82, 3907, 5, 4, 1712, 6, 3, 55, 43, 67, 12 },
+    { 438, 0, 520, 3620, 44, 20, 13, 0, 23, 451, 54, UINT_MAX, 7, 4, 137, 22, 104, 222, 57, 9, 12 },
+    { 515, 29, 134, 3008, 25, 33, 13, 62, 82, 576, 3, 1210, 6, 1, 955, 28, 50, 0, 227, UINT_MAX, 15 },
+    { 163, 162, 784, 1389, 23, 23, 10, 7, 67, 46, 80, 360, 9, 5, 1259, INT_MIN, UINT_MAX, 78, 78, 36, 9 },
+    { 703, 726, 1034, 2756, 29, 21, 43, 8, 5, 645, 33, 2541, 4, 5, 622, 1, 98, 218, 108, 4, 7 },
+    { 127, 2455, 315, 2632, 6, 6, -7, 30, 156, INT_MAX, 124, 241, 4, 3, 1006, INT_MAX, 63, 147, 56, 7, 11 },
+    { 55, 262, 160, 948, 27, 4, 17, 36, 9, 222, 95, 2873, 7, 4, 1014, 38, 6, 166, 19, 29, 11 },
+    { 114, 48, 45, 6452, 51, 22, INT_MAX, 16, 22, 52, 70, 1208, 4, 2, 158, 4, 82, 0, 231, 25, 13 },
+    { 11, 64, 1122, 355, 8, 5, -5, 9, 36, -50, 126, 0, 7, 4, 32, 19, 123, 145, 100, 47, 5 },
+    { 73, 82, 421, 815, UINT_MAX, 33, -16, 51, 40, 921, 40, 337, 5, 3, 558, 14, 62, 51, 135, UINT_MAX, 15 },
+    { -93, 444, 269, 1410, 23, 5, 34, 15, 80, 89, 1, 587, 0, 3, 1224, 47, 51, 49, UINT_MAX, 26, 12 },
+    { 284, 623, 0, 39, 2, 21, 18, 6, 23, -463, 0, 3186, 6, 1, 45, -24, 104, 210, 83, 111, 7 },
+    { 785, 502, 262, 1857, 59, 6, 17, 15, 86, 502, 0, 0, 9, 1, 574, 23, 18, 124, 34, 26, 15 },
+    { 702, 337, 43, 2772, 3, 8, 33, 27, 87, 897, 84, 374, 6, 0, UINT_MAX, 2, 5, 0, 160, 10, 13 },
+    { 224, UINT_MAX, 343, 745, UINT_MAX, 7, 16, 25, 35, 83, 127, 794, 6, 3, 1449, 1, 114, 0, 0, 26, 14 },
+    { 149, UINT_MAX, 183, 1194, 31, 18, 12, 49, 37, -114, 99, 375, 8, UINT_MAX, 657, INT_MIN, 68, UINT_MAX, 162, 24, 7 },
+    { INT_MAX, 163, 149, 1964, 29, 14, 8, 15, 143, 47, 70, 1263, 8, 1, 1582, 4, 0, 114, 180, 21, 6 },
+    { 392, 9, 1660, 426, 29, 17, 16, 37, 17, 65, UINT_MAX, 3742, 9, 3, 7, INT_MIN, 48, 133, 33, 36, 11 },
+    { 206, 70, 31, 38, 13, 15, 15, 37, 93, -35, 112, 1183, 9, 3, 222, 30, 0, 153, 136, UINT_MAX, 13 },
+    { INT_MIN, 221, 313, 1862, UINT_MAX, 27, 18, 17, 92, 106, 42, 1522, 7, 4, 907, 41, 13, 78, 108, 8, 6 },
+    { 347, 106, 113, 322, 53, 13, 29, 38, 17, -17, UINT_MAX, UINT_MAX, 8, 4, 3055, -13, 75, 41, 82, 5, 9 },
+    { -233, 10, 113, 33, 86, 40, 9, UINT_MAX, 67, 61, 3, 23, 9, 4, 131, 39, 49, 109, 29, 10, 13 },
+    { 2, 74, 162, 1892, 51, 14, 10, 38, 23, -30, 51, 82, 5, 2, 5226, 13, 79, 229, 89, 28, 2 },
+    { 468, 3, 574, 66, 3, 10, 1, 33, 0, 369, 113, 606, 0, UINT_MAX, 1564, 50, 59, 87, 64, 74, 16 },
+    { 345, 183, 329, 2748, 7, 11, -44, 55, 86, 34, 36, 2079, 7, UINT_MAX, 450, 29, 57, 0, 231, 6, 10 },
+    { 189, 768, 307, 1993, 34, 8, 40, 2, 31, 37, 93, 294, 0, 2, 249, INT_MAX, 0, 137, 38, 56, 12 },
+    { 54, 1440, 214, 1578, 19, 40, 13, 35, 163, 148, 84, 3058, 5, 6, 371, 53, 105, 89, 27, UINT_MAX, 16 },
+    { 53, 3702, 199, 660, 3, 21, 21, 17, 77, 127, 0, 1075, 8, 4, 727, 21, 102, 75, UINT_MAX, 20, 14 },
+    { INT_MAX, 1314, 161, 429, 0, 2, -4, 5, 87, 40, 22, 405, 8, 4, 435, 5, 49, 47, 18, 61, 4 },
+    { 438, 39, UINT_MAX, 829, UINT_MAX, 15, -44, 38, 118, -4, 99, 0, 5, 3, 635, -6, 0, 113, UINT_MAX, 66, 9 },
+    { 69, 53, 481, 376, 57, 3, 1, 24, 85, 256, 45, 2079, 6, 3, 4805, 32, 15, 107, 64, 12, 13 },
+    { -83, 38, 162, 951, 17, 12, -6, 2, 26, 67, 124, 17545, 6, 6, 859, 10, 97, 41, 29, 57, 3 },
+    { 32, 73, 161, 172, 18, 41, INT_MAX, 6, 37, INT_MIN, 92, 3913, 7, 0, 614, 16, 8, UINT_MAX, 32, 17, 10 },
+    { 348, 0, 110, 1696, 12, 27, 13, 19, 105, 247, 24, 360, 0, 0, 1889, 8, 39, 46, 87, 9, 10 },
+    { 271, 767, 10, 1138, 12, 23, -6, 46, 117, INT_MIN, 49, UINT_MAX, 8, 2, 1166, 36, 104, 99, UINT_MAX, 6, 3 },
+    { 217, 64, UINT_MAX, UINT_MAX, 40, 2, 1, 12, 8, -1, 122, 2529, 6, 4, 277, 43, 43, 93, 0, UINT_MAX, 9 },
+    { 93, 2306, 1063, 209, 68, 20, 11, 51, 103, 85, 106, 1187, 9, UINT_MAX, 843, 4, 122, 101, 77, 55, 12 },
+    { 672, 417, 691, 1438, 6, 0, 12, 35, 86, 1059, 79, 2541, 5, 5, 226, -6, 0, 154, 45, 6, 11 },
+    { INT_MIN, 154, 174, 796, 57, 11, 6, 44, 76, 61, 83, 2034, 9, 2, 748, 8, 6, 75, 108, UINT_MAX, 7 },
+    { 45, UINT_MAX, UINT_MAX, 237, 9, 34, -5, 19, 172, 313, 22, 0, 7, 4, 1325, 41, UINT_MAX, 37, 46, 62, 15 },
+    { 219, 419, 292, 185, 4, 20, 11, 27, 177, 64, 93, 2724, 7, 3, 4805, -11, 97, 36, 90, 63, 16 },
+    { 81, 30, 2733, 1019, 17, 29, 18, 36, 27, 785, 57, 1214, 8, 0, 51, 14, 31, 131, 31, 5, 13 },
+    { 51, 15, 72, 61, 23, 25, 17, 34, 50, 34, 62, 2985, 6, 3, 264, -20, 11, 52, 125, 18, 5 },
+    { 52, 305, 66, 216, 42, 20, 16, 9, UINT_MAX, 784, 1, 6992, 8, 3, 1774, 39, 80, 17, 103, 15, 8 },
+    { -1163, 14, 2734, 1868, 14, 16, 8, UINT_MAX, 0, INT_MIN, 19, 2758, 7, 5, 561, 2, 58, 132, 22, 0, 5 },
+    { 57, 181, 412, 2004, 43, UINT_MAX, -15, 30, 68, 40, 112, 2534, 4, UINT_MAX, 0, 23, 110, 34, 124, UINT_MAX, 12 },
+    { 85, 190, 162, 430, 85, 14, 18, 24, 61, -20, 39, 35, 6, 0, 75, 11, 10, 86, UINT_MAX, 18, 5 },
+    { INT_MIN, 67, 1540, 2061, 57, UINT_MAX, -4, 51, 35, 1058, 25, 3900, 5, 2, 983, -8, 106, 87, 63, 178, 17 },
+    { INT_MAX, 0, 50, 35, 13, 3, 17, 26, 84, INT_MIN, 83, 17051, 7, 2, 139, 36, 43, 29, 48, 27, 11 },
+    { 390, 252, 205, 831, 28, 16, INT_MAX, 32, 178, 49, 63, 170, 7, 2, 0, 37, 120, 89, 85, 23, 17 },
+    { 55, 821, 601, 563, 15, 15, INT_MIN, 38, 65, 3, 5, 1611, 5, 6, 434, 26, 13, 51, 115, 8, 5 },
+    { -25, 264, 451, 2112, 3, 23, 23, 24, 8, INT_MAX, 128, 83, 8, 1, 851, 6, 47, 92, 164, 61, 9 },
+    { 107, 30, 0, 1356, 12, 18, 41, 14, 91, 3, 73, 17546, 7, 5, 592, 40, 2, 28, 19, 79, 12 },
+    { 702, 3, 0, 1652, 25, 15, 31, 32, 56, -19, 72, 186, 5, 4, 3731, INT_MAX, 76, 107, 35, 64, 9 },
+    { 112, 2305, 227, 95, 24, 21, 31, 30, 56, -16, 60, 1740, 10, 4, 769, -4, 59, 225, 118, 79, 2 },
+    { 197, 1854, 257, 3419, 49, 9, -44, 47, 24, 27, 54, 35, 7, 2, 805, 36, 5, 103, 47, 57, 6 },
+    { 166, 250, 8, 421, 63, 26, 21, 28, 16, 140, 106, 6990, 6, UINT_MAX, 3893, INT_MIN, 41, 64, 69, 13, 7 },
+    { 218, UINT_MAX, 425, 2688, 45, 0, -42, UINT_MAX, 84, 79, 45, 168, 6, 5, 954, 50, 123, 158, 81, 61, 9 },
+    { 59, 14, 110, 452, 33, 4, 20, 25, 24, 125, 30, 590, 6, 3, 456, INT_MAX, 70, 144, 18, 11, 15 },
+    { 140, 486, 224, 2190, 21, 8, -6, 2, 9, 148, 94, 0, 9, 4, 1053, 8, 24, 92, 106, 79, 1 },
+    { 485, 1476, UINT_MAX, 1272, 31, 5, -3, 0, 3, 73, 57, 1970, 10, 3, 1582, 37, 67, 62, 60, 4, 13 },
+    { 64, 18, 516, 7068, 39, 3, -17, 19, 0, 783, UINT_MAX, 3606, 9, 2, 955, 2, 3, 52, 57, 7, 2 },
+    { -93, 28, 237, 313, 12, 10, -16, 0, 37, 119, 54, 369, 8, 4, 428, -24, 29, 0, 117, 111, 4 },
+    { 347, 2306, 758, 1274, 41, 24, 19, 7, 93, 576, 59, 93, 8, 4, 537, 26, 50, 175, 119, 20, 16 },
+    { INT_MAX, 156, UINT_MAX, 157, 59, 25, 9, 28, 46, 13, 4, 2081, 6, UINT_MAX, 4506, INT_MIN, 50, 72, 126, 23, 7 },
+    { 40, 39, 1121, 518, 68, 11, -2, 6, 80, 1912, UINT_MAX, 1849, 7, 2, 367, INT_MAX, 58, 128, 103, 55, 7 },
+    { INT_MAX, 2306, 543, 629, 60, UINT_MAX, -2, 8, 26, INT_MAX, 71, 2541, 6, 0, 369, 39, 2, 69, 26, 67, 15 },
+    { 979, 822, 232, 3, 0, 4, 6, 9, 103, 16, 59, 823, 5, 5, 2386, 49, 96, 108, 156, 177, 13 },
+    { 115, 43, 217, 300, 65, UINT_MAX, INT_MAX, 20, 0, -1335, 36, 0, 4, 0, 5226, 24, 97, 67, 101, 55, 9 },
+    { -45, 72, 784, 2634, 36, 20, 15, 0, 104, 12, 49, 3196, 7, 4, 955, -2, 0, 38, 108, 18, 8 },
+    { 220, 196, 469, 0, 65, 13, -7, 61, 21, 305, 56, 110, 6, 4, 49, 42, 61, 50, 95, UINT_MAX, 19 },
+    { 83, 1475, 78, 211, 51, 9, -15, 12, 116, 33, 25, 4987, 10, 1, 853, 28, 51, 75, 89, 4, 7 },
+    { INT_MAX, 38, 1672, 2042, 42, 23, -10, 14, 2, 38, 116, 1184, 0, 3, 639, 35, 25, 224, 0, 3, 12 },
+    { INT_MAX, 223, 222, 803, 30, 16, 30, 0, 141, -65, 33, 71, 8, 4, 1418, 3, 126, 83, 20, 36, 8 },
+    { 219, 19314, 79, 22, 38, 20, 6, 20, 69, 90, 38, 2476, 4, 6, 834, 6, 49, 207, 144, 25, 8 },
+    { 81, 128, 328, 301, 64, 21, -2, 34, UINT_MAX, 88, 99, 51, 7, 0, 140, 19, 39, 77, 32, 5, 5 },
+    { 196, 641, 171, 2770, 12, 35, 2, 54, 54, 1089, 44, 240, 5, 0, 650, 3, 119, 118, 70, 17, 12 },
+    { 65, 6143, 349, 127, 17, 13, INT_MAX, 27, UINT_MAX, 250, 60, 3943, 6, 4, 185, 8, 26, 73, 0, 60, 11 },
+    { 281, 40, 619, 1930, 28, 4, 32, 18, 32, -20, 123, 2439, 6, 1, 133, 44, 1, 0, 28, 17, 8 },
+    { 140, 127, 624, 93, 2, 3, 29, UINT_MAX, 3, 338, 59, 118, 7, 5, 0, 10, 75, 28, 137, 6, 20 },
+    { 30, 0, 191, 1676, 87, 4, 4, 52, 12, -246, 114, 2379, 5, 5, 1564, 13, 7, 127, 127, 0, 4 },
+    { 151, 3220, 0, 192, 41, 22, 29, 8, 20, 410, UINT_MAX, 1217, 7, 3, 657, -18, 9, 133, 63, 0, 7 },
+    { 345, 74, 419, 32, 66, 11, 15, 50, 26, 29, 0, 4408, 5, 4, 100, 7, 117, 131, 107, 17, 10 },
+    { 76, 645, 226, 1373, 9, 2, 20, 40, 104, 785, 11, 1600, 6, 3, 658, 45, UINT_MAX, 39, 125, 24, 14 },
+    { 590, UINT_MAX, 1054, UINT_MAX, 42, 10, -6, 19, 75, 62, 54, 2758, 5, 4, 2009, 2, 97, 112, UINT_MAX, 56, 3 },
+    { 254, UINT_MAX, 680, 1707, 12, 7, 20, 38, 60, 41, 105, 1875, 7, 2, 436, 51, 41, 25, 63, 12, 17 },
+    { INT_MAX, 516, 245, 2121, 33, 5, 11, 1, 23, 554, 27, 359, 7, 4, 281, 6, 46, 108, 58, 72, 10 },
+    { 76, 39, 440, 132, 40, 24, 25, 24, 0, 148, 108, 62, 8, 0, 138, -8, 123, 121, 103, 10, 11 },
+    { 223, 99, 209, 2190, 14, 11, INT_MIN, 11, 69, 64, 2, 2, 8, 2, 2365, 51, 98, 56, 63, 56, 14 },
+    { INT_MIN, 72, 1513, 1069, 1, 19, 7, 5, 11, -3, 69, 1213, 6, 3, 789, 22, 39, 77, 146, 32, 6 },
+    { 5, UINT_MAX, 60, 1895, 5, 15, 16, 6, 85, 83, 47, 1974, 6, 3, 637, INT_MAX, 103, 32, 52, 24, 12 },
+    { 208, 733, 57, 716, 22, 20, INT_MIN, 30, 92, 164, 78, 4410, 6, 3, 1642, 20, 74, 111, UINT_MAX, 38, 5 },
+    { 188, 338, 91, 383, 35, 34, -6, 28, 69, 81, UINT_MAX, 0, 6, 1, 553, 42, 0, 88, 43, 10, 8 },
+    { 12, UINT_MAX, 183, 283, 7, 14, 16, 51, 25, -35, 128, 2820, 8, 1, 227, 32, 82, 0, 26, 29, 19 },
+    { 89, 1029, 86, 1654, UINT_MAX, 1, 13, 20, 61, 21, 43, 374, 6, 0, 1, 13, 92, 120, 178, UINT_MAX, 6 },
+    { INT_MIN, 1883, 699, 0, 34, 40, -17, 33, 75, 21, 23, 406, 6, 4, 561, -13, 101, 216, 231, 30, 2 },
+    { 675, 147, 93, 296, 69, 2, -16, 59, 86, 531, 57, 208, 0, 5, 623, -37, 60, 98, 22, 22, 6 },
+    { 61, 17, 122, 306, 10, 8, -18, 32, 5, 249, 96, 196, 8, 1, 189, 7, 31, 78, 26, 0, 5 },
+    { 49, 530, 18, 464, 62, 32, 34, 34, 176, INT_MAX, 19, 6991, 4, 3, 900, 17, 44, 155, 82, 5, 8 },
+    { 129, 25, 228, 1137, 54, UINT_MAX, -1, 20, 6, 643, 81, 1155, 7, 0, 294, 5, 113, 127, 146, 0, 7 },
+    { 44, 198, 62, 710, 55, 32, -5, 1, 43, 6, 67, 0, 8, 5, 477, -19, UINT_MAX, 104, 75, 31, 5 },
+    { 783, 517, 198, 2122, 0, 0, INT_MAX, 0, 39, 200, 29, 2592, 4, 1, 1775, 20, 125, 114, 95, 10, 13 },
+    { 55, 544, 166, 1315, 33, 8, 6, 0, 102, 1090, 38, 2723, 7, 0, 4804, -4, 124, 75, 82, 2, 3 },
+    { -96, 183, 419, 37, 11, 15, 17, 0, 16, 59, 44, 2543, 9, 2, 269, 38, 53, 120, 19, UINT_MAX, 16 },
+    { INT_MAX, 1439, 175, 323, 53, 16, 15, 3, 104, 124, 97, 18, 9, 0, 0, -22, 13, 114, 44, 57, 14 },
+    { 70, 252, 224, UINT_MAX, 21, 23, 36, 59, 8, -113, 72, 2756, 6, UINT_MAX, 1448, 8, 114, 93, 231, 30, 6 },
+    { 269, 56, 59, 5256, 10, 20, 20, 30, 163, -10, 80, 1971, 0, 2, 925, 1, 117, 154, 0, 32, 6 },
+    { -8, 38, 82, 1020, 11, 7, 13, 22, 173, INT_MIN, 91, 1962, 7, 1, 3802, -8, 26, 54, 26, 22, 4 },
+    { -23, 2305, 216, 10565, 51, 10, 27, 20, 5, 1501, 60, 0, 5, 1, 422, 18, 83, 36, 60, 55, 15 },
+    { 189, 42, 51, 3636, 57, 26, 41, 56, 86, 199, 51, UINT_MAX, 7, 2, 1351, -22, 4, 126, 56, 16, 10 },
+    { -35, 0, 60, 871, 14, 13, 14, 31, 161, 502, 54, 0, 9, 1, 18, 0, 34, 48, 21, 56, 16 },
+    { 39, 24, 131, 1962, 4, 15, 7, 27, 6, INT_MAX, 91, 7961, 8, 2, 552, 25, 4, 133, 49, UINT_MAX, 6 },
+    { 186, 6143, 50, 0, 0, 32, 34, 45, 129, 2, 82, 5906, 5, 0, 377, 30, 30, UINT_MAX, 52, 23, 8 },
+    { 106, 223, 134, 2094, 38, 26, 32, 8, 54, 30, 0, 358, 8, UINT_MAX, 948, 16, 68, 98, 36, 36, 10 },
+    { 77, 500, 701, 94, 56, 32, 25, 15, 88, 411, 68, 1304, 4, 5, 393, 51, 124, 53, 227, 62, 18 },
+    { 194, 9, 203, 1476, 61, 26, 18, 13, 0, 46, 99, 170, 8, 4, 424, 52, 39, 222, 140, 38, 17 },
+    { 431, 3704, 105, 156, 22, 24, 30, 17, 29, -113, 113, 3099, 8, 4, 907, 23, 29, 71, 225, 26, 11 },
+    { 59, 263, 143, 32, 30, 1, 19, 50, 35, -114, 122, 239, 6, 3, 683, 30, 62, 58, 34, 58, 14 },
+    { INT_MAX, 648, 8, 196, 6, 3, 18, 29, 78, 501, 28, 1839, 9, 6, 7359, 14, 0, 25, 49, 34, 15 },
+    { INT_MIN, 63, 130, 2141, 64, 42, INT_MIN, 0, UINT_MAX, 164, 52, 2552, 7, 2, 368, 17, 47, 111, 71, 2, 5 },
+    { 142, 25, 451, 8601, 61, 7, 2, UINT_MAX, 58, INT_MIN, 113, 6991, 5, 4, 785, 15, 31, 71, 75, 20, 2 },
+    { 79, 19314, 247, 827, 66, 34, -6, 11, 60, 502, 15, 974, UINT_MAX, 6, 368, INT_MAX, UINT_MAX, 88, 0, 29, 14 },
+    { 95, 147, 327, 313, 32, 18, 27, 39, 16, 896, 35, 17545, 6, 4, 215, 29, 31, 18, 48, 60, 16 },
+    { 202, 2455, 345, 3000, 23, 2, 29, 33, 4, 36, 27, 226, 10, 2, 1918, INT_MIN, 36, 167, 80, 67, 4 },
+    { 76, 419, 308, 519, 47, 40, 29, 14, 22, 29, 96, 450, 8, 5, 3040, 16, 9, 133, 38, 30, 4 },
+    { 27, UINT_MAX, 23, 453, 21, 25, -7, 56, 24, 43, 111, 1960, 7, 3, 0, 32, 21, 118, 65, 18, 2 },
+    { 517, 650, 537, 75, 41, 14, 9, 0, 32, 27, 61, 3378, 8, 5, 367, 21, 18, 18, 33, 6, 14 },
+    { 107, 202, 374, 891, 9, 19, -18, 48, 85, 314, 118, UINT_MAX, 7, 4, UINT_MAX, 17, 30, 31, 119, 8, 17 },
+    { 214, 0, 211, 488, 14, 8, 11, 7, 117, -22, 113, 6990, 8, 5, 1367, 2, 0, 70, UINT_MAX, 10, 1 },
+    { 108, 12, 438, 133, 36, 12, -25, 24, 60, 495, 75, 6924, 8, 4, 863, 50, 46, 50, 28, 67, 17 },
+    { 591, 276, 1121, 1354, 1, 1, -3, 23, 87, 92, 52, 17401, 8, 1, 585, 2, 63, 70, 24, 2, 2 },
+    { 101, 222, 452, 269, 2, 9, 9, 5, 73, 107, UINT_MAX, 890, 9, 4, 813, 27, 8, 22, 135, 8, 15 },
+    { 38, 189, 169, 2538, 22, 20, -44, 30, 11, 33, 22, 241, 6, 5, 191, -21, 121, 68, 227, 25, 1 },
+    { 49, 0, 75, 181, 10, 25, 31, 33, 57, 250, 50, 2818, 6, 0, 137, -37, 121, 96, 65, 5, 4 },
+    { 197, 254, 78, UINT_MAX, 43, 4, -9, 18, 85, -31, 53, 1225, 9, 3, 48, 19, 35, 110, 99, 25, 0 },
+    { 175, 1028, 254, 82, 22, 2, -43, 17, 57, INT_MIN, 17, 938, 7, 2, 220, 14, 102, 18, 81, 2, 14 },
+    { 108, 63, 141, 379, 32, 1, 0, UINT_MAX, 8, INT_MIN, 91, 1561, 7, 1, 2269, -20, 62, 32, 26, 0, 3 },
+    { 76, 41, 184, 773, 25, UINT_MAX, INT_MIN, 2, 38, 75, 81, 13, 8, 2, 1922, 4, 79, 23, 56, 55, 14 },
+    { -165, 20, 120, 1995, 45, 25, 24, 17, 58, 5, 26, 2552, 7, 4, 1661, 3, 39, 46, UINT_MAX, 4, 4 },
+    { 63, 17, 50, 733, 27, UINT_MAX, 4, UINT_MAX, 104, -5, 36, 1837, 7, 4, 1360, 13, 1, 130, 225, 0, 0 },
+    { 79, 235, 218, 2075, UINT_MAX, 21, 1, 17, 71, 92, 48, 18, UINT_MAX, 3, 190, -21, 61, 24, 27, 23, 17 },
+    { 784, 546, 319, 2697, 3, 5, -3, 14, 59, 148, 47, 411, 7, 3, 790, 11, 47, 112, 73, 14, 2 },
+    { 212, 200, 174, 39, 28, 1, 41, 23, 21, -48, 87, 592, 7, 1, 2, 43, 75, 33, 88, 6, 17 },
+    { 269, 40, 1247, 1431, 8, 13, 0, 29, 58, 73, 0, UINT_MAX, 6, 2, 1448, -24, 116, 95, 41, 76, 3 },
+    { 187, 622, 60, UINT_MAX, 50, 26, -7, 0, 16, 35, 127, 3213, 4, 0, 1930, 20, 64, 73, 27, 4, 2 },
+    { 51, 127, 0, 2495, 67, 18, 3, 0, 59, INT_MIN, 0, 2725, 7, 4, 352, 18, 26, 102, 63, 19, 0 },
+    { 703, 1030, 0, 234, 42, 35, 27, 12, 0, 60, 72, 2081, 9, 5, 1658, INT_MAX, 71, 80, 46, 32, 18 },
+    { -169, 70, 52, UINT_MAX, 31, 24, 12, 12, 20, 644, 20, UINT_MAX, 7, 5, 1167, -5, 102, 83, 78, 2, 3 },
+    { 392, 26, 108, 0, 15, 1, 20, 40, 11, INT_MAX, 112, 2478, 6, UINT_MAX, 569, 20, 37, 134, 119, 26, 18 },
+    { 71, 13, 143, 1249, 24, 12, -6, 15, 43, 19, 2, 369, 8, UINT_MAX, 35, -1, 7, 130, 80, 14, 1 },
+    { 58, 20, 664, 142, 0, 2, -2, 31, 6, 160, 4, 1140, 9, 3, 2987, -9, 30, 92, 99, 98, 1 },
+    { 75, UINT_MAX, 197, 477, 14, 15, -43, 8, 55, 7, 0, 127, 6, 4, 3055, -1, 56, 222, 73, 2, 3 },
+    { 55, 6, 222, 1040, 26, 19, -42, 17, 41, INT_MAX, 85, 1601, 8, 3, 858, -3, 52, 110, 102, 57, 3 },
+    { INT_MAX, UINT_MAX, 209, 1819, 58, 6, 18, 16, 6, 254, 3, 0, 7, 3, 574, 6, 77, 36, 91, 67, 16 },
+    { 515, 767, 266, 488, UINT_MAX, 5, -6, 9, 39, -20, 57, 17420, 8, 0, 782, 2, 17, 59, 165, 61, 2 },
+    { -95, 621, 359, 7496, 46, 13, -17, 15, 9, 502, 78, 171, 0, 1, 1893, 14, 39, 116, 62, 56, 3 },
+    { 100, 516, 609, 23, 4, 15, 25, 16, 166, 72, 47, 1696, 4, 5, UINT_MAX, 26, 85, 93, 65, 8, 18 },
+    { 978, UINT_MAX, 185, 1867, 18, 32, 12, 7, 85, 919, 102, 1224, 5, 3, 5022, INT_MAX, 14, 91, 66, 25, 16 },
+    { 108, 445, 1426, 2111, 43, 8, 1, 34, 25, INT_MIN, 31, 5906, 7, 4, 524, 10, 110, 38, 16, 29, 11 },
+    { -53, 516, 187, 295, 11, 10, 5, 15, 7, INT_MIN, 100, 2996, 8, 1, 469, 0, 50, 0, 0, 25, 13 },
+    { 107, 99, 932, 2808, UINT_MAX, 33, 10, 52, 5, 38, 38, 4408, 8, 0, 8, 20, 62, 80, 139, 25, 11 },
+    { 53, 500, 134, 28, 34, 7, 3, 0, 71, 79, 0, 225, 4, 3, 890, 16, 47, 30, 29, 25, 10 },
+    { 132, 10, 111, 1695, 87, 0, 18, 44, 30, 79, UINT_MAX, 1040, 7, 4, 1540, 28, 15, 32, 34, 21, 7 },
+    { 292, 15, UINT_MAX, 2335, 54, 4, 14, 22, 31, 41, 13, 1634, 8, 1, 154, 40, 72, 26, 228, 1, 14 },
+    { 20, 822, 369, 793, 41, 8, -7, 18, 18, 553, 23, 1535, 6, 1, 2267, 4, 45, 32, 29, 11, 6 },
+    { 346, 54, UINT_MAX, 0, 0, 9, 20, 20, 26, -2, 106, 2379, UINT_MAX, 3, 375, -18, 26, 17, 0, 62, 8 },
+    { 172, 63, 445, UINT_MAX, 56, 16, 15, 0, 68, 172, 114, 81, 8, 5, 2759, 22, 62, 53, 43, UINT_MAX, 10 },
+    { 165, 6, 165, 101, 26, 13, -1, 25, 2, 42, 2, 3932, 6, 3, 272, 1, 117, 0, 35, 74, 11 },
+    { 207, 146, 480, 8313, 14, 9, 3, 20, 2, 1075, 7, 1875, 5, 2, 1366, 12, 22, 32, 39, 3, 15 },
+    { 670, 7, 179, 292, 35, UINT_MAX, 9, 6, 77, 500, 68, 2192, 0, 3, 5540, 21, 43, 56, 23, 22, 15 },
+    { 255, 30, 162, 5255, 51, 4, 22, 5, 3, -17, 3, 1261, 8, 3, 184, 9, 34, 26, 35, 31, 15 },
+    { 18, 621, 395, 2771, 54, 3, 9, 24, 0, 939, 3, 6843, 5, 2, 45, 5, 11, 37, 100, 99, 11 },
+    { -115, 1965, 272, 1903, 70, 10, 21, 0, 14, 247, 65, 198, 8, 4, 462, -7, 62, 27, 231, 8, 11 },
+    { 160, 0, 85, 35, 58, 7, -10, 16, 22, 41, 35, 62, UINT_MAX, 4, 0, 17, 13, 63, 27, 8, 13 },
+    { 418, 163, 444, 344, 45, 4, 12, 50, 16, 69, 94, 6708, 6, 4, 1606, 28, 35, 103, 25, 24, 15 },
+    { 218, 14, 121, 1556, 38, 9, -25, 18, 19, 4, 38, 2984, 8, 1, 634, 10, 121, 35, 92, 112, 9 },
+    { 87, 26, 573, 1961, 70, 8, 7, 16, 84, INT_MAX, 24, 3906, 7, 1, 626, 20, 41, 77, 100, 4, 6 },
+    { 173, 126, 662, 2000, 45, 19, 10, 20, 18, 183, 22, 1141, 7, 3, 11, 29, 125, 178, 20, 73, 14 },
+    { 634, 501, 186, 4, 45, 29, -4, 25, 1, -469, 65, 5352, 9, 1, 571, -9, 61, 17, 147, 21, 11 },
+    { INT_MIN, 221, 94, 25, 45, 0, 35, 33, 7, 57, 88, 14, 4, 3, 191, 16, 79, 45, 136, 10, 7 },
+    { 77, 1313, 149, 105, 6, 4, 10, 17, 38, 5, 57, 63, 9, 2, 269, 21, 61, 74, 62, 3, 17 },
+    { -94, 0, 83, 269, 38, 16, 10, 0, 24, 451, 27, 4381, 5, 5, 276, INT_MAX, 45, 38, 106, 5, 5 },
+    { 53, 516, 185, 13162, 70, 17, 6, 12, 1, 635, 12, 4381, 8, 4, 3676, 11, 16, 47, 229, 26, 5 },
+    { 890, 213, 1200, 518, 61, 13, 15, 58, 93, 532, 127, 1899, 7, 0, 2641, 30, 41, 207, 131, 0, 14 },
+    { -234, 197, 700, 354, 27, 1, 5, 2, 0, 500, 52, 1115, 6, 3, 2813, -4, 1, 45, 23, 0, 11 },
+    { 88, 223, 182, 192, 14, UINT_MAX, 3, 4, 16, INT_MIN, 96, 6465, 7, 2, 0, 15, 106, 49, 65, 26, 8 },
+    { INT_MAX, 146, 482, 976, 64, 11, 20, 0, 117, 141, 86, 6043, 8, 5, 7357, 26, 0, 207, 54, 111, 7 },
+    { 32, 126, 372, 3554, 21, 4, 1, 25, 12, INT_MAX, 84, 2642, 8, 4, 171, -5, 0, 0, 35, 46, 8 },
+    { 137, 34, 422, 2334, 18, 10, 20, UINT_MAX, 79, 361, 113, 17009, 9, 2, 852, 43, 7, 112, 0, 111, 13 },
+    { INT_MAX, 31, 186, 1190, 24, 0, 30, 21, 142, 4, 93, 210, 4, 0, 29, 45, 28, 40, 81, 1, 14 },
+    { 137, 156, 145, 1936, 25, 3, 9, 40, 0, 5, 110, 239, 8, 2, 88, 22, 1, 154, 69, 1, 10 },
+    { 25, 106, 485, 22, 31, 23, 3, 27, 141, 576, 84, 2591, 5, 5, UINT_MAX, -23, 119, 35, 98, 11, 13 },
+    { 3, 516, 167, 46, 46, 14, 33, 34, 24, -15, 48, 6922, 6, 3, UINT_MAX, 17, 21, 71, 144, 9, 7 },
+    { -45, 207, 6, 1894, 1, 19, INT_MAX, 33, 162, INT_MIN, 96, 1141, 6, 3, 825, 20, 61, 127, 21, 5, 12 },
+    { -66, 38, 54, 3635, 56, UINT_MAX, 20, UINT_MAX, 24, 409, 123, 0, 5, 3, 353, 10, 81, 229, 23, 0, 9 },
+    { 207, 201, 136, 1943, 39, 4, 3, 18, 154, 78, 81, 1845, 6, UINT_MAX, 150, 22, 43, 39, 91, 26, 12 },
+    { 348, 234, 481, 1310, 67, 2, -43, 22, 22, 63, 85, 6923, UINT_MAX, 3, 0, -12, 39, 51, 115, 18, 5 },
+    { 66, 0, 422, 2189, 69, 2, 11, 1, 38, 105, 53, UINT_MAX, 6, 1, 171, 30, 39, 29, 164, 17, 10 },
+    { 292, 35, 481, 573, 62, 19, 30, 45, 101, 5, 105, 251, 8, 4, 2640, 29, 22, 110, 28, 35, 8 },
+    { 979, 94, 124, 1192, 70, 25, 7, 61, 6, 13, 16, 1961, 7, 2, 449, 14, 117, 47, 82, 12, 14 },
+    { INT_MIN, 621, 534, 28, 20, 3, 6, 59, 142, 897, 53, 340, UINT_MAX, 4, 82, 19, 52, 46, 45, 17, 10 },
+    { 847, 49, 181, 152, 27, 0, -11, 14, 8, 916, 84, 1209, 6, 0, 49, 3, 82, 0, 148, 7, 11 },
+    { 174, 154, 113, 256, 53, 19, 6, 27, 172, -17, 48, 1696, 6, 3, 5227, 12, 42, 44, 66, 67, 8 },
+    { INT_MAX, 1964, 225, 147, 45, 32, 7, 12, 77, 48, 111, 35, 6, 4, 145, 16, 79, 95, 91, 5, 13 },
+    { 188, 263, 70, 0, 41, 23, 20, 58, 54, 829, 104, 3912, 5, 3, 909, 20, 10, 70, 124, 3, 17 },
+    { -1164, 25, 270, 0, 50, 0, -11, 18, 41, 118, 91, 1913, 5, 2, 0, 9, 116, 16, 60, 56, 11 },
+    { -179, 181, 520, 2429, 71, 22, -10, 21, 176, INT_MAX, 23, 2468, 8, 4, 2267, -7, 79, 159, 64, 34, 14 },
+    { 343, 1854, UINT_MAX, 0, 55, 14, 20, 59, 10, 40, 85, 168, 4, 0, 422, 19, 51, 99, 17, 62, 9 },
+    { -95, UINT_MAX, UINT_MAX, 62, 25, 13, -10, 8, 3, -30, 36, 2550, UINT_MAX, 3, 637, 2, 17, 95, 143, 75, 6 },
+    { 48, UINT_MAX, 89, 531, 43, 11, 8, 25, 5, 501, 76, 3942, 6, 3, 860, 2, 34, 24, 24, 17, 8 },
+    { 38, 11, UINT_MAX, 2122, 48, 1, 11, 7, 104, INT_MAX, 43, 1570, 4, 2, 291, 24, 42, 52, 26, 15, 13 },
+    { 135, 12, 190, 178, 59, 20, 15, 23, 36, 39, 90, 91, 5, 0, 118, 32, 13, 68, 76, 7, 13 },
+    { INT_MIN, 17, 393, 430, 11, 15, -12, 27, 7, 20, 14, 5092, 6, UINT_MAX, 0, -2, UINT_MAX, UINT_MAX, 36, 5, 4 },
+    { 450, 29, 425, 1277, 38, 7, 5, 15, 11, 61, 41, 824, 6, 0, 12, 13, 26, 52, 18, 56, 8 },
+    { 57, 69, 369, 0, 0, 10, 6, 21, 4, 88, 110, UINT_MAX, 4, 2, 805, 1, 3, 53, 32, 0, 10 },
+    { INT_MIN, 99, UINT_MAX, 0, 62, 41, 15, 58, 3, 89, 59, 3051, 8, 4, 391, 22, 121, 177, 29, 23, 13 },
+    { 96, 39, 328, 1436, UINT_MAX, 5, 14, 22, 10, 400, UINT_MAX, 916, 4, 2, 180, 35, 10, 144, UINT_MAX, 55, 14 },
+    { 150, 173, UINT_MAX, 188, 63, 25, 9, 0, 15, 79, 125, 7960, 5, 2, 49, 25, 92, 149, 48, 14, 13 },
+    { 25, 19314, 121, 2464, 50, 12, -44, 34, 5, -11, 65, 0, 0, 3, 1449, -4, 74, 56, 97, 74, 15 },
+    { 73, 29, 70, 2096, 11, 10, 6, 54, 33, 74, 11, 3972, 7, 2, 0, 12, 73, 36, 161, 0, 11 },
+    { 69, 11, 86, 1777, 25, 5, 19, 1, 16, 194, 23, 1522, 7, 4, 1367, 26, 32, 81, 29, 0, 14 },
+    { 82, 26, 422, 205, UINT_MAX, 2, 15, 33, 26, 13, 7, 12216, 6, 3, 0, INT_MAX, 68, 86, 45, 99, 9 },
+    { 780, 43, 217, 793, 5, 23, INT_MAX, 35, 98, 916, 22, 3911, 6, 4, 3531, 23, 0, 107, 228, 54, 8 },
+    { INT_MAX, 297, 238, 1350, 55, 1, -12, 1, 2, 60, 91, 871, 8, 4, 2581, 11, 60, 48, 138, 17, 4 },
+    { 109, 2304, 138, 1299, 22, 41, 11, 12, UINT_MAX, 151, UINT_MAX, 2520, 5, 5, 209, 20, 0, 155, 35, 74, 12 },
+    { 23, 3702, 264, 8690, 25, 14, -6, 45, 72, INT_MIN, 126, 2193, 5, 2, 22, 0, 69, 0, 27, 19, 9 },
+    { INT_MAX, 1882, 1123, 628, 8, 26, -3, 17, 176, -22, 32, 1355, 4, 1, 4432, -22, 1, 27, 146, 3, 14 },
+    { 90, 115, 199, 3, 47, 20, -10, 16, 0, 161, 22, 916, 5, UINT_MAX, 1563, -9, 120, 146, 100, 0, 7 },
+    { INT_MIN, 82, 74, 609, 11, 4, 10, 21, 13, 59, 111, 2533, 5, 5, 75, 4, 4, 0, 0, 32, 10 },
+    { 107, 23, 343, 1174, 7, 18, 9, 10, 0, -1, 16, 117, 7, 2, 615, 11, 52, 145, 226, 23, 4 },
+    { 68, 196, 120, 1622, 47, 7, 20, 12, 24, 1090, 1, 288, 8, 3, 458, 18, 64, 55, 57, 67, 15 },
+    { -66, 172, 0, 4084, 42, 7, 13, 38, 28, 247, 3, 2539, 8, 1, 30, 16, 0, 34, UINT_MAX, 36, 7 },
+    { 59, 26, 681, 159, 65, 4, 29, 21, 49, -469, 51, 174, 6, 3, 221, 20, 91, 207, 37, 4, 5 },
+    { 87, 221, 73, 1371, 0, 1, 9, 16, 78, 69, 39, 3092, 7, 0, 616, 14, 34, 42, 58, 13, 12 },
+    { 56, 444, 233, 1544, 1, 4, 7, 18, 12, 162, 128, 740, 9, 3, 500, 35, 39, 64, 47, 60, 8 },
+    { 123, 642, 242, 0, 71, UINT_MAX, 42, 0, 55, INT_MIN, 69, 0, 7, 0, 73, 12, 43, 26, 34, 98, 12 },
+    { 345, 28, 134, 452, 42, 1, 18, 14, 58, -34, 98, 6843, 6, 3, 268, 17, 17, 58, 160, 35, 10 },
+    { INT_MAX, 10, 1660, 2095, 8, 1, -7, 11, 22, 60, 12, 2021, 5, 3, 375, -3, 26, 36, 85, 37, 3 },
+    { -70, 105, 423, 96, 66, 2, 41, 12, 8, 2, 33, 57, 6, 5, 3803, 30, 0, 29, 36, 33, 12 },
+    { 62, 2304, 352, 94, 29, 7, 4, 4, 0, 12, 63, 325, 5, 4, 90, 12, 7, 28, 0, 30, 14 },
+    { 60, 250, 183, 180, 39, 9, 14, 21, 31, 42, 6, 1355, 7, 3, 287, 31, 29, 226, 147, 2, 9 },
+    { -44, 19314, 24, 180, 50, UINT_MAX, INT_MIN, 23, 35, 256, 128, 1215, 6, 1, 4784, -8, 3, 218, 17, 10, 9 },
+    { 11, 282, 111, 53, 6, 10, 11, 20, 176, 553, 54, 6709, 8, UINT_MAX, 0, 15, 40, 133, 41, 4, 12 },
+    { 889, 53, 439, 1300, 60, 3, INT_MAX, 51, 172, 494, 50, UINT_MAX, 5, 4, UINT_MAX, 27, 35, 25, 100, 25, 11 },
+    { -178, 0, 619, 168, 56, 3, 42, 29, 105, -19, 79, 1874, 8, 4, 34, 8, 62, 173, 72, 0, 2 },
+    { 175, 644, 1033, 0, 65, 13, 9, 34, 117, 552, 88, 3950, 8, 3, 2164, 40, 13, 72, 92, 61, 10 },
+    { 217, 2304, 231, 295, 1, 0, 6, 11, 0, 1809, 101, 2590, 5, 2, 257, 14, 27, 93, 20, 36, 12 },
+    { 91, 253, 812, 8909, 19, 8, -25, 32, 17, 1090, 117, 4409, 5, 4, 2134, 26, 21, 166, 118, 46, 12 },
+    { 64, 156, 129, 1475, 8, 18, -2, 7, 0, INT_MIN, 70, 3606, 5, 0, 18, -21, 12, 20, 16, 112, 9 },
+    { 670, 162, 1425, 214, 21, 0, INT_MIN, 28, 86, -16, 54, 74, 5, 2, 1449, 13, 68, 65, 0, 24, 7 },
+    { 783, 3703, 100, 81, 58, 1, 2, 14, 21, -26, 109, 169, 0, 2, 1265, 7, 2, 29, 75, 16, 7 },
+    { 212, 417, 1032, 3760, 35, 32, 3, 24, 85, 496, 60, 2757, 4, 4, 158, 14, 33, 62, UINT_MAX, 3, 7 },
+    { 392, 9, 417, 10, 44, 1, 20, 36, 104, 32, 68, 3874, 6, 5, 14, 22, 40, 85, 0, 9, 10 },
+    { 110, UINT_MAX, 208, 29, 11, 18, 8, 8, 33, 180, 3, 1667, 8, 0, 119, 29, 39, 167, UINT_MAX, 0, 15 },
+    { 345, 221, 1538, 302, 51, 4, INT_MIN, 3, 36, 35, 125, 52, 8, 0, 24, 23, 119, 24, 146, 6, 17 },
+    { 2, 106, 826, 0, 42, 14, -45, 6, UINT_MAX, INT_MIN, 41, 119, 7, 1, 352, -22, 42, 69, 16, 0, 12 },
+    { 90, 274, 310, 24, 60, 0, INT_MIN, 33, 0, 553, 47, 1837, 7, 2, 17, 9, 18, 38, 179, 1, 13 },
+    { 24, 189, 516, 67, 27, 13, 3, 24, 7, INT_MIN, 110, 5050, 5, 1, UINT_MAX, -8, 18, UINT_MAX, UINT_MAX, 23, 3 },
+    { 79, 4481, 220, 5581, 41, 33, 20, 7, 69, -1335, 40, UINT_MAX, 6, 2, 1, 18, 5, 0, 29, 35, 10 },
+    { 20, 235, 252, 301, 33, 10, -16, 27, 1, 19, 83, 1971, 9, 3, 790, -23, 72, 30, 0, 65, 10 },
+    { 41, 47, 112, 797, 9, 13, 8, 60, 5, 174, 112, 522, 5, 1, 90, 25, 44, 47, 80, 8, 10 },
+    { 189, 53, 387, UINT_MAX, 62, 6, 34, 46, 79, 32, 109, 4409, 7, 5, 1366, INT_MAX, 36, 43, 37, 27, 9 },
+    { 98, 19, 508, 1090, UINT_MAX, 0, 15, 34, 4, 90, 45, 2043, 6, 0, 82, 33, 98, 70, 56, 25, 15 },
+    { 218, 733, 1660, 1707, 5, 32, -3, 19, 3, 135, 51, 2438, 8, 4, 583, -8, 77, 40, 20, 1, 4 },
+    { 64, 500, 85, 922, 24, 40, 20, 7, 10, -64, 75, 91, 8, 2, 221, 46, 37, 85, 40, 5, 9 },
+    { 42, 4482, 445, 1274, 20, 9, -6, 27, 6, 140, UINT_MAX, 2439, 7, 1, 616, 6, 123, 212, 38, 25, 4 },
+    { 220, 2304, 689, 22, UINT_MAX, 1, 5, 24, 58, 2, 71, 475, 7, 1, 185, 6, 106, 216, 84, 5, 2 },
+    { 72, 214, 1022, 0, 25, UINT_MAX, -17, 4, 24, 118, 67, 1181, 6, 1, UINT_MAX, 10, UINT_MAX, 70, 162, 6, 5 },
+    { 195, 306, 59, 8601, 64, 23, 12, 33, 8, 336, 80, 119, 9, 1, UINT_MAX, 16, 73, 143, 32, 10, 15 },
+    { 115, 483, 1691, 8908, 61, 12, 14, 16, 8, 920, 31, 1013, 6, 3, 864, 25, 69, 80, 26, 52, 18 },
+    { 76, 262, 59, 2095, 17, 19, -43, 6, 55, 249, 62, 2394, 7, 2, 681, 23, UINT_MAX, 19, 56, 177, 9 },
+    { -112, 200, 57, 941, 5, 17, -44, 29, 0, 2, 79, 75, 7, 1, UINT_MAX, INT_MIN, 83, 173, 230, UINT_MAX, 6 },
+    { INT_MAX, 70, 515, 569, 43, 29, 25, 40, 105, 0, 103, 1115, 4, 1, 100, 16, 21, 70, 25, 21, 8 },
+    { 80, 644, 672, 84, 27, 11, 3, 17, 24, INT_MAX, 101, 340, 8, 2, 1223, 7, 109, 34, 87, 111, 13 },
+    { 889, 52, 88, 4, 49, 1, 12, 18, 0, -190, 20, 1, 5, 1, 226, 11, UINT_MAX, 40, 126, 98, 15 },
+    { INT_MAX, 19, 1537, 84, 14, 7, 10, 12, 8, 23, 82, 118, 4, 4, 91, 14, 25, 101, 74, 112, 16 },
+    { 979, 2305, UINT_MAX, 203, UINT_MAX, 12, -5, 34, 83, 105, 49, 1183, UINT_MAX, 1, 5148, 10, 6, UINT_MAX, 51, 178, 13 },
+    { 55, 46, 121, 115, 47, 20, -16, 30, 4, 66, 93, 1212, UINT_MAX, 2, 1102, 18, 123, 67, 64, 110, 9 },
+    { 45, 207, 304, 1663, 5, 25, 18, 0, 13, 187, 32, 426, 5, 2, 1642, 13, 113, 76, 20, 111, 14 },
+    { INT_MAX, 1964, 1318, UINT_MAX, 70, 6, -12, 12, 36, 223, 67, 2439, 9, 2, 29, 10, 13, UINT_MAX, 36, 18, 7 },
+    { 267, 296, 690, 227, 52, 33, 32, 20, 0, 258, 92, 2528, 8, 3, 3537, 23, 18, 0, 20, 1, 14 },
+    { INT_MAX, 2305, 223, 1826, 42, 0, 29, 44, 59, 96, 115, 1075, 9, 4, 528, 31, 10, 57, 89, 61, 9 },
+    { 119, 29, 190, 1886, 17, 7, -2, 7, 73, 72, UINT_MAX, 0, 5, 1, 103, -2, 13, 96, 82, 32, 5 },
+    { 50, UINT_MAX, 8, 920, 2, 25, 9, 14, 0, INT_MAX, 83, 6709, 4, 3, 4505, -3, 34, 29, 101, 52, 6 },
+    { 77, 38, 103, 66, 48, 0, 24, 27, 3, 24, UINT_MAX, 475, 9, 2, 590, -3, 97, 58, 24, 2, 12 },
+    { INT_MIN, 649, 113, 253, 60, 41, 19, 59, 46, 369, 77, 2932, 8, 2, 422, 41, 30, 154, 232, 17, 13 },
+    { 86, 296, 140, 20, 8, 7, INT_MAX, 3, 21, -18, 99, 503, 5, 1, 559, INT_MIN, 39, 0, 145, 6, 6 },
+    { 890, 106, 783, 5581, 36, 14, 12, 10, 17, 1089, 79, UINT_MAX, 7, 0, 2008, 28, 0, 115, 0, 11, 11 },
+    { 172, 1313, 206, 1310, 63, 23, 8, 7, 13, 50, 105, 187, 8, 4, 705, -10, 13, 207, 64, 65, 10 },
+    { 781, 13, UINT_MAX, 772, 41, 1, 9, 15, 27, 8, UINT_MAX, 3911, 6, 3, 560, 53, 15, 134, 45, 13, 14 },
+    { -52, 5, 534, 83, 48, 0, INT_MIN, 11, 117, INT_MIN, 62, 0, 6, 3, 0, -38, 117, 33, 229, 33, 4 },
+    { 119, 19315, 329, 79, 48, 30, -7, 29, 5, 75, 60, 0, 5, UINT_MAX, 0, 7, UINT_MAX, 59, 111, 13, 10 },
+    { 64, 26, 105, 239, 28, 8, 13, 40, 5, 160, 12, 0, 6, 1, 191, 8, 16, 101, 97, 35, 7 },
+    { 218, 41, 165, 5571, 66, 23, 34, 40, 21, 163, 113, 2725, 7, 3, 7358, 29, 85, UINT_MAX, 227, 17, 11 },
+    { 138, 99, 932, 4707, 53, 0, -11, 23, 3, 11, 3, 793, 8, 0, 371, 11, 71, 64, 74, 14, 1 },
+    { 99, 12, 741, 0, 51, 2, -7, 7, 116, -48, 0, 2995, UINT_MAX, 0, 1023, 42, 57, 27, UINT_MAX, 1, 9 },
+    { INT_MIN, 19314, 1319, 460, 19, 20, 13, 21, 18, 38, 55, 17544, 6, 0, 650, 13, 84, 59, 136, 10, 10 },
+    { 702, 1314, 1123, 15, 55, 0, 11, 28, 8, 73, 70, 18, 5, 2, 1581, 22, 82, 114, 23, 15, 14 },
+    { 59, 486, 317, 1935, 0, 16, INT_MAX, 27, 0, 296, 102, UINT_MAX, 8, 4, 0, 29, 39, 43, 63, 4, 10 },
+    { 264, 417, 318, 1857, 28, 32, 29, 30, 5, 68, 33, 383, 7, 3, 179, 15, 26, 51, 85, 32, 16 },
+    { 466, 29, 242, 106, 70, 32, 2, 9, 67, INT_MAX, 95, 80, 5, 0, 56, 11, 123, 101, 50, 34, 12 },
+    { 172, 517, UINT_MAX, 487, 29, 0, 33, 7, 0, 218, 106, 3211, 5, 1, UINT_MAX, 53, 0, 59, 43, 3, 8 },
+    { 50, 63, 73, 22467, 42, 20, -45, 24, 0, 1090, 88, 3973, 4, 2, 272, 26, 117, 65, 27, 3, 11 },
+    { 73, 207, 232, 1933, 48, 6, 30, 20, UINT_MAX, 3, 53, 521, 5, 4, 0, 43, 34, 219, 23, 34, 12 },
+    { INT_MAX, 155, 1245, 473, 56, 19, -3, 15, 20, 249, 85, 5092, 6, 4, 658, 22, 101, 173, 86, 2, 9 },
+    { 50, 6142, 335, 1826, 53, 11, 7, 61, 78, 98, 37, 2643, 6, 3, 1204, 27, 49, 102, 47, 29, 6 },
+    { 3, 724, 111, 329, 16, 3, -5, 39, 162, 3, 28, 206, 7, 3, 272, 32, 77, 46, 95, 110, 9 },
+    { 137, 245, 24, 608, 47, 29, 16, 2, 38, 149, 26, 1136, 5, 2, 636, 23, 100, 226, 23, 14, 16 },
+    { 284, 114, 271, 778, 22, UINT_MAX, -18, 11, UINT_MAX, 54, 83, 7959, 4, 0, 169, 11, UINT_MAX, 28, 63, 0, 15 },
+    { 517, 191, 573, 829, 65, 0, 12, 8, 129, 53, 4, 24, 8, 5, 230, 40, 35, 206, 35, 57, 16 },
+    { 76, 4482, 285, 168, 32, 20, -11, 26, 0, -26, 35, 24, 8, 1, 424, 19, 24, 101, 179, 29, 6 },
+    { 68, 48, 232, 1350, 57, 7, 13, 32, 0, 175, 72, 6844, 6, 4, 5147, 22, 56, 27, 0, 0, 14 },
+    { -20, 516, 49, 91, 50, 9, -2, 51, 13, 20, 51, 0, 7, 5, 134, 12, 116, 229, 71, 17, 6 },
+    { 69, 155, 1610, 2255, 49, 19, 10, 38, 102, 180, UINT_MAX, 2895, 9, 1, UINT_MAX, 49, 12, 121, 56, 7, 8 },
+    { 141, 305, 370, 8909, 9, 5, 7, 28, 31, 784, 0, 1558, 8, 2, 541, -12, 44, 59, 102, 74, 5 },
+    { 172, 27, 431, 38, 14, 0, 19, 14, 84, 19, UINT_MAX, 6708, 5, 2, 458, 21, 0, 45, 17, 10, 9 },
+    { 222, 67, 1246, 779, 70, 6, 5, 54, 62, 297, 47, 1961, UINT_MAX, 4, 952, 0, 93, 51, 50, 0, 14 },
+    { 978, 20, 480, 67, UINT_MAX, 1, -5, 16, 59, INT_MIN, 23, 0, 5, 4, UINT_MAX, 28, 62, 74, 119, 8, 6 },
+    { 85, 200, 223, UINT_MAX, 10, 18, 8, 12, 0, 574, 78, 3933, 7, 4, 528, 13, 57, 34, 67, 73, 16 },
+    { 63, 724, 2732, 223, 14, 41, 5, 3, 11, -18, 102, 498, 9, 3, 31, -18, UINT_MAX, 122, 225, 25, 5 },
+    { -166, 105, 783, 89, 45, 15, 7, 32, 12, 49, 0, 1001, 8, 3, 24, INT_MIN, 72, 43, 49, 0, 12 },
+    { 110, 214, 228, 0, 38, 6, 9, 0, 0, 3, 53, 2724, 8, 4, 374, 34, 39, 33, 16, 4, 11 },
+    { 107, 1438, 0, 14, 38, 10, 19, 22, 155, 69, 0, 590, 4, 1, 179, 15, 37, 67, 101, 13, 13 },
+    { INT_MIN, 732, 1122, 323, 38, 5, 16, 13, 103, 89, 71, 2542, 7, 1, 680, INT_MIN, 32, 57, 28, 1, 8 },
+    { 106, 67, 369, 956, 70, 9, 3, 0, 3, 337, 46, 174, 9, 4, 352, -8, 58, 86, 108, 3, 4 },
+    { 267, 1742, 610, 69, 11, 9, -25, 18, 177, 16, 0, 1, 8, 0, 192, 12, 102, 69, 42, 11, 10 },
+    { 60, 545, 166, 1544, 19, 2, 10, 3, 13, 313, 25, 6042, 9, 0, 33, 53, 77, 196, 127, 36, 13 },
+    { 101, 83, 173, 2004, 31, 7, 34, 10, 55, 39, 100, 475, 5, 0, 900, 29, 22, 224, 28, 32, 6 },
+    { INT_MAX, 62, 164, 1662, 8, 23, -43, 2, 0, 9, 107, 975, 5, 2, 1344, -19, 22, 24, 17, 0, 10 },
+    { 62, 22, 300, UINT_MAX, UINT_MAX, 29, 10, 21, 74, 409, 0, 2198, 9, 0, 744, INT_MAX, 40, 229, 85, 57, 14 },
+    { 171, 182, 600, 39, 12, 34, 8, 0, 59, -30, 100, 299, 5, UINT_MAX, 1102, 9, 4, 47, 33, 5, 10 },
+    { 51, 263, 70, 792, 48, 6, 24, 34, 56, 360, 21, 16398, 5, 3, 102, 26, 86, 107, 66, 12, 10 },
+    { 85, 5, 46, 1475, 0, 23, 2, 6, 54, -470, 13, 2080, 8, 3, 222, 7, 46, 0, 178, 45, 8 },
+    { 674, 39, UINT_MAX, 13162, 67, 15, 29, 48, 0, 938, 24, 2528, 6, 2, 455, 40, 42, 207, 147, 8, 13 },
+    { 335, 5, 107, 3381, 51, UINT_MAX, 25, 17, 48, -16, 71, 2476, 9, 0, 0, 2, 7, 41, 147, 10, 7 },
+    { 77, 222, 54, 277, 71, 8, 20, 24, 21, 161, 82, 3050, UINT_MAX, 4, 5022, 14, 34, 224, 227, 110, 3 },
+    { 51, 38, 182, 277, 69, 40, -2, 17, 0, 69, 19, 1600, 6, 3, 2640, INT_MAX, 0, UINT_MAX, 38, 1, 9 },
+    { -1164, 1474, UINT_MAX, 311, 7, 9, -5, 4, 29, 495, 82, 83, 7, 1, 1133, 6, 14, 63, 76, 4, 5 },
+    { 91, 38, 1318, 116, 87, 10, 17, 40, 21, INT_MAX, 74, 337, 9, 2, 1562, 33, 33, 122, 22, 73, 10 },
+    { 213, 207, UINT_MAX, 374, 0, 18, 4, 27, 8, 87, 102, 480, 4, 4, 14, 23, 6, 222, 20, 0, 13 },
+    { 113, 6, 431, 37, 13, 2, 10, 2, 7, -19, 56, 1558, 8, 1, 4505, 10, 100, 50, 72, 178, 9 },
+    { INT_MIN, 9, 363, 207, 43, 6, 6, 35, 17, 58, 48, UINT_MAX, 6, 2, 8, 17, 73, 89, 137, 1, 4 },
+    { 54, 183, 213, 156, 23, 2, 15, 37, 0, 1089, 16, 6844, 5, 1, 1509, 26, 83, 50, 137, 61, 12 },
+    { 112, 500, 1144, 314, 22, UINT_MAX, 2, 30, 77, 1, 80, 1516, 8, 4, 1417, INT_MIN, 103, 27, 113, 1, 4 },
+    { 673, 115, 58, 1861, 0, 11, 23, 60, 23, 1513, 71, 4757, 7, 4, 1, 8, 78, 28, 19, 25, 12 },
+    { 22, 821, 30, 48, 12, 12, 5, 10, 10, 43, 0, 2035, 9, 1, 384, -8, 68, 107, 0, 11, 10 },
+    { 220, 0, 373, 680, 37, 5, 15, 34, 132, 249, 91, 207, 8, 1, 114, 52, 0, 107, 228, 14, 17 },
+    { 111, 445, 245, 2, 3, 1, 15, 13, 3, -47, 93, 320, 8, 0, 72, 15, 16, 228, 29, 177, 10 },
+    { 84, 3, 380, 155, 22, 3, -17, 39, 3, -20, 43, 1738, 5, 3, 1222, -2, 80, 143, 22, 111, 7 },
+    { 109, 725, 60, 1144, 54, 23, 41, 12, 128, 575, 117, 2591, 6, 0, 2814, 25, 5, 159, 31, 10, 13 },
+    { 50, 1855, 1115, 7, 21, 2, 2, 9, 77, 4, 12, 210, 7, 4, 171, 18, 64, 0, UINT_MAX, 1, 6 },
+    { 54, 544, 1021, UINT_MAX, 45, 13, 13, 8, 29, 1075, 72, 11, 6, 5, 1712, 34, 23, 155, 76, 111, 12 },
+    { INT_MIN, 42, 4, 1431, 29, 0, -6, 48, 104, 939, 13, 6538, 8, 3, 2133, -37, 122, 19, 74, 4, 7 },
+    { -71, 172, 149, 237, 69, 14, 15, 17, 117, 246, 47, 118, 5, 3, 1528, INT_MAX, 1, 0, 81, 5, 8 },
+    { 119, 622, 87, 172, 33, 9, 3, 32, 3, 635, 97, 684, 8, 2, 0, 9, 0, 207, 23, 12, 10 },
+    { 415, 213, 272, UINT_MAX, 43, 20, 32, 51, 55, 224, 68, 7959, 5, 1, 9, 23, 37, 158, 228, 45, 11 },
+    { 19, 391, 269, 36, 38, 4, 1, 0, 7, -3, 79, 719, 8, 1, 373, -4, 18, 0, 58, 32, 7 },
+    { -1165, 385, 209, 109, 32, 33, INT_MAX, 16, 4, -26, 37, 1013, 7, 1, 18, 16, 57, 118, 44, 13, 15 },
+    { 26, 25, UINT_MAX, 659, 4, 19, 1, 9, 162, -72, 0, 3606, 6, 4, 136, 6, 0, 226, 19, 8, 11 },
+    { 93, 198, 72, 2110, 73, 2, 21, 11, 172, 360, 19, 5351, 4, 1, 1023, 40, 124, 72, 27, 12, 16 },
+    { 112, 0, 269, 28, 28, 2, -2, 16, 103, -11, 30, 0, 6, 1, 369, -18, 13, 36, 49, 110, 4 },
+    { INT_MAX, 200, 509, 710, UINT_MAX, 14, 20, 61, 128, -17, 1, 62, 9, 3, 0, 36, 5, 146, 52, 12, 7 },
+    { 987, 110, 300, 2004, 57, 11, 11, 23, 8, 259, 52, 11870, 7, UINT_MAX, 1563, 19, 27, UINT_MAX, 38, 111, 9 },
+    { 218, 517, 228, 3, 36, 4, 10, UINT_MAX, 90, -190, 103, 939, 5, 1, 384, 51, 16, 31, 46, 1, 13 },
+    { 40, 0, 600, 300, 37, 2, 24, 6, 37, -62, 47, 870, 5, 4, 824, -21, 70, 154, 28, 12, 4 },
+    { 67, 222, 0, 108, 4, 2, 12, 23, 26, 574, 85, 17052, 7, UINT_MAX, 230, 37, 112, 154, 76, 37, 16 },
+    { 66, 30, 418, 12, 73, 0, -6, 9, 30, INT_MIN, 112, 55, 6, 4, 5227, 11, 97, 75, 0, 22, 5 },
+    { -65, 21, 165, 2799, 0, 5, -11, 0, 41, 339, 84, 522, 5, UINT_MAX, 0, 14, 122, 23, 135, 32, 10 },
+    { -96, 196, 150, 892, 41, 12, 11, 7, 35, 58, 0, UINT_MAX, 9, 0, 30, 14, 36, 33, 76, 27, 6 },
+    { 45, 156, 58, UINT_MAX, 7, 5, 31, 31, 101, -30, 97, 2035, 9, 4, 366, 50, 96, 108, 16, 15, 12 },
+    { 73, 15, 60, 162, 18, 33, 10, 19, 19, 70, 97, 1611, 7, 0, 1564, 26, 73, 43, 25, 9, 15 },
+    { 220, 146, 939, 1903, 3, 30, 31, 29, 14, 0, 103, 793, 7, 4, 954, 17, 72, 221, 45, 3, 10 },
+    { 335, 25, 305, UINT_MAX, 30, 40, 10, 29, 107, 643, 92, 3933, 7, 1, 3892, 20, 61, 53, 99, 56, 10 },
+    { 167, 48, 418, 1013, 73, 6, 6, 58, 68, 636, 99, 3058, 7, 5, 501, 53, 21, 130, 26, 8, 10 },
+    { 217, 0, 600, 239, 51, 24, -17, 13, 13, 636, 53, 1611, 5, 1, 575, 11, 121, 0, 46, 32, 11 },
+    { 12, 213, 610, 3795, 66, 5, INT_MIN, 6, 68, 4, UINT_MAX, 954, 8, 2, 2008, INT_MIN, 47, UINT_MAX, UINT_MAX, 65, 8 },
+    { -9, 17, UINT_MAX, 419, 31, 5, 3, 24, 6, 350, 117, 1836, 6, 1, 2164, -5, 52, 22, 43, 56, 10 },
+    { 67, 1313, UINT_MAX, 1557, UINT_MAX, 12, 14, 7, 82, 25, 48, 1211, 5, 3, 435, 30, 27, 104, 143, 2, 9 },
+    { 48, 93, 3, 688, 8, 0, 5, 6, 29, 643, 97, 828, 7, 3, 158, 11, 123, 47, 64, 32, 6 },
+    { 391, 163, 180, 473, 9, 22, 3, 16, 76, 31, 17, 3196, 6, 3, 205, INT_MIN, 30, 24, 0, 4, 12 },
+    { 347, 0, 121, 108, 36, 11, 15, 12, 11, 39, 117, 75, 6, 1, 291, 27, 21, 46, 230, 0, 18 },
+    { 78, 1438, 86, 987, 0, 2, -16, 15, 8, 31, UINT_MAX, 109, 7, 5, 3455, 25, 124, 33, 50, 0, 15 },
+    { 670, 1313, 377, 1961, 65, 3, 9, 25, 65, 783, 127, UINT_MAX, 8, 2, 12050, 24, 16, 66, 58, 30, 12 },
+    { 106, 4482, 1246, 514, 48, 1, 35, 19, 19, 58, 65, 910, 0, 1, 30, -7, 118, 62, 77, 22, 8 },
+    { 293, 27, 1240, 1737, 3, 0, -11, 19, 176, 66, 99, 684, 9, 1, 569, INT_MIN, 18, 46, 231, 17, 9 },
+    { -179, 182, 230, 3182, 41, 0, 9, 26, 25, 69, 94, UINT_MAX, 6, 0, 386, -24, 100, 0, 68, 0, 9 },
+    { 100, 641, 208, 0, 41, 26, 0, 0, 102, 26, 4, 1320, 5, 4, UINT_MAX, 11, 27, 46, 94, 24, 7 },
+    { 83, 93, 438, 156, 87, 4, 29, 8, 38, 64, 107, 2394, 7, 1, 229, 19, 27, 98, 74, 75, 9 },
+    { -115, 4481, 6, 608, 1, 12, 22, 11, 62, 70, 1, 2533, 4, 1, 3726, 18, 36, 109, 33, 31, 7 },
+    { 69, 196, 438, 69, 52, 10, 8, 34, 2, 16, 122, 593, 9, 1, 0, 18, 122, 0, 148, 5, 13 },
+    { 58, 188, 64, 628, 2, 23, 12, 21, 25, 78, 63, 916, 9, 0, 2318, 17, 101, 164, 119, 1, 6 },
+    { 988, 3, 233, 1903, 48, 0, -11, 9, 0, 4, 43, 1203, 9, 2, 637, 12, 14, 0, 0, 74, 14 },
+    { 174, 391, 105, 19, 38, 11, 6, 17, 0, 239, 62, 1960, 8, 3, 664, 38, 81, 109, 101, 0, 15 },
+    { 175, 110, 419, 1878, 9, 0, 10, 5, 2, 246, UINT_MAX, 1982, 7, 1, 1909, 53, 17, 109, 21, 66, 11 },
+    { 124, 191, 145, 1272, 39, 2, 24, 27, 104, 501, 98, 2468, 6, 0, 214, 52, 4, 25, 66, 18, 15 },
+    { INT_MAX, 444, 225, 4083, 36, 0, 8, 6, 2, 249, UINT_MAX, 367, 5, 1, 410, 17, 80, 61, 160, 0, 13 },
+    { 58, UINT_MAX, 290, 239, 48, 7, 1, 17, 20, 4, 86, 367, 6, UINT_MAX, 27, -19, 83, 68, 156, 17, 5 },
+    { INT_MAX, 544, 359, 18, 59, 6, 8, 36, 37, 37, 63, 41, 6, 3, 718, 21, 54, 89, 58, 36, 11 },
+    { 65, 114, 109, 830, 0, 2, 13, 36, 30, 58, 0, 2539, 8, 1, 1301, 29, 37, 226, 36, 0, 7 },
+    { -37, 172, 601, 6, 50, 10, INT_MAX, 9, 57, -5, 77, 1331, 8, 1, 909, 8, 37, 113, 52, 52, 6 },
+    { 30, 6143, 24, 569, 5, 13, -10, 24, 0, 277, 82, 368, 6, 1, 305, 2, 24, 133, 0, 1, 11 },
+    { 20, 10, 0, 3635, 24, 6, -6, 9, 41, INT_MIN, 59, 175, 7, 0, UINT_MAX, -3, 38, 66, 0, 45, 11 },
+    { 292, 11, 1537, 498, 71, 32, 4, 4, 83, 896, 58, 828, 4, 2, 7, 7, UINT_MAX, 207, UINT_MAX, 111, 7 },
+    { 52, 114, 218, 52, 24, 23, 12, 15, 3, 37, 49, 3972, UINT_MAX, 4, UINT_MAX, 15, 51, 70, 228, 37, 7 },
+    { 116, 3218, 279, 155, 23, 2, 2, 10, 27, -62, 50, 117, 6, 4, 27, -38, UINT_MAX, 35, 113, 17, 2 },
+    { 264, 223, 827, 425, 15, 2, INT_MIN, 14, 10, 41, 95, 3093, 5, 1, 1351, 2, 60, 33, 162, 4, 5 },
+    { INT_MAX, 234, 93, 2256, 70, 34, 25, 0, 21, 165, 80, 2541, 7, 2, 8, 38, 41, 90, 20, 177, 16 },
+    { -37, 643, 52, 533, 45, 2, -45, 20, 7, 24, 98, 1961, 6, 1, 905, 3, 100, 226, UINT_MAX, 54, 6 },
+    { -103, 391, 128, 11, 13, 0, -3, 2, 17, -29, 56, 83, UINT_MAX, 2, 1013, 5, 29, 157, 18, UINT_MAX, 9 },
+    { 439, 181, 203, 3838, 0, 15, INT_MIN, 30, 49, 60, 31, 1898, 9, 0, 75, 30, 47, 20, 84, 3, 12 },
+    { 78, 181, 149, 802, 23, 13, 33, 9, 130, 552, 49, 12216, 4, 0, 1102, 17, 13, 58, 77, 61, 13 },
+    { INT_MIN, 0, 217, 1578, 70, 3, -12, 8, 8, INT_MIN, 56, 1224, 8, 2, 1167, 12, 106, 25, 0, 55, 11 },
+    { 127, 11, 1022, 311, 10, 0, -7, 0, 1, INT_MIN, 75, 1570, 6, 1, 752, 1, 30, 22, 49, 33, 2 },
+    { 47, 181, 0, 2125, 47, 5, 34, 11, 18, 141, 25, 3900, 8, 1, 0, 36, 64, 112, 231, 0, 7 },
+    { 76, 69, 69, 1316, 17, 11, 30, 36, 57, 151, 1, UINT_MAX, 4, 1, 8, 22, 124, 157, 46, 7, 8 },
+    { 987, 154, UINT_MAX, 402, UINT_MAX, 21, 16, 27, 23, 125, 81, 6465, 5, 2, 1, 26, 103, 0, 70, 5, 11 },
+    { 68, 34, 373, 368, 12, 11, 7, 13, 28, 239, 90, 3606, UINT_MAX, 0, 7358, 29, 57, 148, 232, 24, 11 },
+    { -15, 183, 88, 1825, 13, 15, 23, 32, 0, 175, 84, 587, 7, 5, UINT_MAX, 11, 58, 91, 82, 20, 5 },
+    { 62, 67, 205, 101, 10, 0, 32, 29, 7, 71, 38, 1032, 6, 3, 77, 32, 98, 80, 92, 1, 12 },
+    { -94, 0, 0, 1595, 53, 19, 5, 34, 2, 39, 22, 8491, 9, 3, 592, INT_MIN, 92, 20, 63, 0, 5 },
+    { 673, 643, 1661, UINT_MAX, 46, 12, -4, 46, 2, 451, 115, 2528, 6, 3, 383, 52, 0, 154, 56, 8, 8 },
+    { 94, 12, 191, 478, 38, 13, -11, 2, 43, 577, 51, 0, 6, 1, 225, 7, 60, 110, 27, 14, 7 },
+    { 110, 19315, 103, 453, 26, 7, 1, 4, 33, 919, 50, 374, UINT_MAX, 3, 718, 13, 29, 64, 42, 0, 9 },
+    { 82, 94, 54, 46, 68, 7, -7, 8, 129, 64, 32, 118, 9, 5, 374, 22, 86, 48, 227, 4, 9 },
+    { 89, 391, 360, 6613, 37, 19, 15, 38, 23, -11, 49, 1001, 8, 1, 658, 10, 60, 50, 34, 4, 11 },
+    { 64, 198, 133, 2293, 10, 0, -3, 7, 4, 552, 107, 170, 5, 4, 551, 6, 123, 0, 36, 15, 10 },
+    { 21, 107, 197, 429, UINT_MAX, 11, 13, 23, 9, 223, 122, 367, 8, 0, 762, 36, 105, 98, UINT_MAX, 19, 11 },
+    { 52, 173, 46, 162, 3, 25, 2, 2, 24, 409, 108, 5092, 8, 1, 22, -4, 10, 116, UINT_MAX, 30, 5 },
+    { 947, 821, 741, 39, 41, 5, 15, UINT_MAX, 3, -48, 34, 0, 8, 1, 372, -19, 0, 102, 123, UINT_MAX, 8 },
+    { -96, 234, UINT_MAX, 5216, 45, 0, 3, 34, 3, -17, UINT_MAX, 5352, 7, 5, 73, -12, 68, 0, 40, 4, 8 },
+    { 96, 42, 82, 10399, 2, 10, 12, 13, 102, -3, 64, 1213, 6, 1, 210, 17, 22, 102, 41, 6, 7 },
+    { 217, 201, 139, 1868, 29, 2, 20, 17, 22, 199, 94, 1534, 6, 3, 3040, 17, 16, 42, 19, 3, 11 },
+    { 890, 38, 291, 5216, 27, 29, 2, 4, 1, 35, 94, 6923, 5, 0, 852, 16, 28, 82, 44, 28, 7 },
+    { 201, 486, 109, UINT_MAX, 85, 1, 9, 9, 91, 44, 55, UINT_MAX, 4, 1, 1112, 28, 53, 37, 108, 34, 12 },
+    { INT_MIN, 766, 70, 257, 47, 41, 18, 25, UINT_MAX, INT_MIN, 76, 1154, 8, 2, 369, 22, 4, 157, 79, 4, 6 },
+    { 219, 643, 1033, 1777, 40, 9, -7, 7, 23, 161, 34, 0, 6, 4, 1, 33, 117, 18, 139, 21, 17 },
+    { 44, 296, 380, 38, 65, 13, 15, 25, UINT_MAX, 96, 11, 3867, 7, 3, 0, 17, 47, 79, 17, UINT_MAX, 13 },
+    { 255, 18, 416, 2452, 13, 0, 40, 35, 90, 47, 64, 1755, 6, 2, 1407, 6, 57, 57, 69, 2, 5 },
+    { 106, 29, 60, 181, 21, 6, 29, 24, 28, 45, 39, 975, 8, 2, 493, 26, 34, 122, 99, 9, 19 },
+    { 74, 127, 160, 2356, 66, 14, 2, 13, 0, 184, 1, 7960, 6, 5, 802, -5, 39, 52, 156, 19, 2 },
+    { INT_MIN, 1742, 1054, UINT_MAX, 20, 15, INT_MAX, 32, 25, 9, UINT_MAX, 872, 7, 3, 56, -9, 124, 228, 47, 56, 11 },
+    { -108, 6142, 428, 380, 68, 33, 11, 55, 98, 256, 86, 910, 5, 1, 3440, 31, 120, 107, 100, UINT_MAX, 15 },
+    { 196, 106, 164, 1247, 18, 0, 5, 18, 162, 50, 71, UINT_MAX, 5, 4, 272, 18, 116, 61, 31, 62, 12 },
+    { 55, 482, 80, 239, 18, 17, 11, 46, 10, INT_MAX, 59, 524, 6, 3, UINT_MAX, 17, 39, 47, 25, 23, 17 },
+    { 129, 445, 335, 298, 38, 5, INT_MAX, 18, 25, INT_MAX, UINT_MAX, UINT_MAX, 6, 4, 552, 51, 29, 149, 84, 8, 20 },
+    { 79, 52, 2732, 1275, 28, 7, INT_MAX, 7, 76, 1512, 113, 3949, 8, 4, UINT_MAX, 31, 33, 102, 57, 5, 13 },
+    { 173, 48, 263, 0, 4, UINT_MAX, -44, 10, 35, -114, 86, 2838, 6, 2, 218, 7, 45, 31, 33, 0, 12 },
+    { 132, 1854, 5, 114, 20, 1, 17, 47, 27, 57, 99, 0, 5, 2, 1923, 19, 14, 86, 70, 5, 10 },
+    { 568, 40, 139, 5103, 46, 16, 16, 23, 4, 21, 53, 4381, 5, 4, 162, 9, 100, 211, 146, 2, 6 },
+    { 57, 198, 1513, 6381, 11, 0, 7, 30, 77, 63, 97, 1401, 8, 1, 856, -5, 83, 126, 16, 4, 7 },
+    { 25, 11, 0, 3554, 38, 7, 13, 21, 0, 59, 60, 336, 9, 1, 1323, 23, 80, 131, 63, 79, 6 },
+    { 58, 6, 196, 1350, 65, 10, 12, 12, 2, 1499, 93, 1468, 8, 3, 525, 19, 71, 211, 62, 26, 8 },
+    { 211, 417, 64, 1663, 39, 33, 34, 50, 55, 339, UINT_MAX, 2379, 7, 3, 4820, 35, 0, 43, 143, 7, 4 },
+    { 282, 18, 388, 16, 37, 29, 26, 12, 12, 65, 110, 23, 8, 0, 366, 17, 1, 174, 115, 13, 13 },
+    { INT_MAX, 0, 344, 114, 67, 19, 2, 27, 27, 11, 65, 24, 7, 4, 785, 39, 86, 216, 0, 2, 7 },
+    { -45, 253, 213, 1825, 2, 11, 6, 26, 6, 303, 41, 2541, 0, 4, 767, -4, 69, 38, 100, 23, 5 },
+    { 174, 2454, 88, 1193, 18, 10, 16, 1, 177, -73, 116, 1822, 7, 4, 2219, 20, 58, 59, 231, 0, 12 },
+    { 515, 156, 31, 23, 29, 6, 6, 3, 85, 15, 91, 71, 8, 3, 4719, 19, 67, 93, 52, 0, 7 },
+    { 5, 17, 1538, 0, 47, 0, -10, 59, 4, 259, 58, 1213, 6, 4, 9, 18, 69, 226, 131, UINT_MAX, 6 },
+    { 53, 500, 85, 8601, 16, 13, 8, 37, 93, 222, 23, 690, 4, 1, 2759, 24, 111, 80, 50, 12, 7 },
+    { 75, UINT_MAX, 151, 95, 41, 12, 14, 20, 128, 79, 59, 2044, 9, 5, 5147, 19, 30, 32, 76, 74, 14 },
+    { 186, 3703, 51, 1023, 8, 1, 6, 26, 7, -64, 103, 1981, UINT_MAX, 5, 802, -10, 51, 0, 39, 12, 6 },
+    { 134, 49, 1032, 986, 0, 9, INT_MAX, 22, 102, 938, 56, 3709, 9, 3, 209, 18, 25, 68, 47, 61, 12 },
+    { -168, 1028, 24, 84, 58, 0, 12, 0, 0, 12, 39, 1253, 4, 2, 954, 30, 46, 64, 22, 35, 8 },
+    { 978, 14, 16, 1079, 56, 14, 24, 17, 90, 84, 68, 3900, 9, 2, 7860, 14, 80, 76, 132, 6, 10 },
+    { 216, 732, 5, 1596, 5, 12, INT_MIN, 54, 0, 248, 42, 1114, 5, 2, 169, 9, 48, 41, 38, 33, 12 },
+    { 187, 1314, 437, 1019, 48, 16, 7, 11, 59, INT_MIN, 41, 13, 6, 4, 57, 26, 71, 65, 79, 15, 11 },
+    { 52, 221, 118, 60, 23, 0, 9, 16, 55, 349, UINT_MAX, 3248, 7, 5, 3803, 16, 13, 0, 99, 0, 6 },
+    { 979, 6143, 1537, 28, 56, 20, -2, 25, 92, -2, 65, 0, 9, 3, 0, 18, 101, 65, UINT_MAX, 34, 10 },
+    { 47, 17, 303, 0, 31, 7, 19, 34, 67, -29, 82, 827, 8, 0, 210, -22, 101, 68, 33, 0, 9 },
+    { 293, 35, 467, 1210, 39, 20, INT_MIN, 0, 84, 24, 69, 3093, 6, 2, 292, 5, 6, 21, 120, 3, 14 },
+    { 217, 544, 1115, 173, 51, 7, 10, 5, 29, 207, 1, 3378, 9, 1, 2387, 12, 72, 137, 225, 31, 9 },
+    { -71, 822, 0, 2770, 7, 24, 14, 11, 75, 59, 97, 2079, 8, 1, UINT_MAX, 13, 57, 0, 25, 5, 11 },
+    { 889, 182, 1425, 0, 18, 2, 17, 29, 103, -32, 3, 1216, 8, 3, 1774, -2, 48, 31, 67, 62, 11 },
+    { -234, 483, 1245, 1191, 13, 4, 2, 39, 0, -48, 3, 503, 6, 1, UINT_MAX, -37, UINT_MAX, 35, 139, 66, 5 },
+    { 220, UINT_MAX, 153, 1079, 14, 20, 13, 15, 25, 846, 83, 0, 7, 4, 115, 18, 0, 110, 30, 5, 14 },
+    { 39, 245, 225, 1108, 41, 2, 22, 26, 0, 1513, 81, 1875, 8, 5, UINT_MAX, 51, 60, 144, 30, 13, 9 },
+    { 91, 26, 1512, 265, 60, 14, 12, 39, 9, 34, 91, 592, 5, 2, 597, 14, UINT_MAX, 228, 42, 61, 7 },
+    { INT_MIN, 199, 330, 24, 10, 5, -7, 44, 10, 72, 58, 17009, 5, 3, 528, 21, 21, 154, 28, 19, 4 },
+    { -95, 107, 64, 59, 85, 30, 20, 10, 3, 13, 115, 206, 6, 0, 709, 9, 49, 41, 59, 1, 8 },
+    { INT_MIN, 297, 376, 1505, UINT_MAX, 4, 1, 15, 12, -3, 54, 605, UINT_MAX, 5, 455, 4, 4, 40, UINT_MAX, 6, 5 },
+    { 21, 17, 300, 0, 19, 20, 3, 5, 20, -30, 13, 0, 7, 2, 634, 1, 52, 0, 92, 52, 6 },
+    { 19, 26, 85, 429, 0, 22, 31, 9, 0, 336, 65, 12216, 6, 4, 160, -23, 41, 35, 136, UINT_MAX, 13 },
+    { 52, 545, 419, 163, 86, 4, 25, 52, 0, 3, 34, 8491, 9, 3, 31, -5, 100, UINT_MAX, 0, 2, 12 },
+    { 439, UINT_MAX, 161, 254, 51, 9, 4, 26, 4, 29, 80, 3058, 5, 4, 2, 11, 44, 74, 72, 32, 6 },
+    { 174, 483, 162, 3382, 28, 7, 8, 32, 16, 39, 96, 503, 6, 1, UINT_MAX, -6, 68, 67, 125, 23, 10 },
+    { -52, 28, 1660, 2041, 33, 6, -3, 2, 18, -469, 27, 320, 4, 2, 584, 7, 48, 25, 165, 80, 6 },
+    { 77, 48, 119, 46, 29, UINT_MAX, 6, 0, 0, 61, 78, 1, 8, 1, 161, 26, 33, 29, 63, 62, 13 },
+    { 5, 155, 417, 1707, 32, 8, 10, 23, 173, 495, 15, 4757, UINT_MAX, 1, 708, 24, 33, 39, 41, 17, 8 },
+    { 162, 34, 139, 63, 0, 11, -12, 13, 17, 40, 26, 74, 9, 2, 905, 21, 116, 51, 40, 66, 15 },
+    { 49, 1742, 229, 164, 25, 1, 17, 37, 34, 6, 21, UINT_MAX, 7, 4, 1166, 15, 65, 0, 36, 61, 15 },
+    { 66, 39, 189, 1344, 32, 19, 8, 16, 25, 1076, 64, 590, 0, 0, 1013, 37, 60, 164, 102, 80, 15 },
+    { 118, 622, 622, 2464, 5, 14, -1, 24, 19, 61, 72, 2983, 6, 0, 375, 30, 79, 105, 104, 9, 12 },
+    { 390, 337, 160, 68, 5, 16, 25, 34, 0, 68, 79, 427, 4, 4, 802, 24, 18, 172, 102, 17, 17 },
+    { 77, 0, 7, 13161, 57, 6, 21, 37, 31, 636, 99, 1211, 6, 4, UINT_MAX, 35, 43, 154, UINT_MAX, 25, 11 },
+    { 948, 182, 24, 444, 35, 29, -12, 21, 162, 61, 56, 3093, 5, 0, 4619, -8, 11, 35, UINT_MAX, 1, 12 },
+    { 11, 155, 1055, 419, 28, 0, 21, 9, 84, INT_MIN, 35, 292, 9, 1, 230, 16, 39, UINT_MAX, 86, 0, 5 },
+    { 391, 4, 348, UINT_MAX, 9, 12, INT_MIN, 60, 59, 20, 96, 36, 6, 4, 7357, 2, 0, UINT_MAX, 226, 112, 10 },
+    { 77, 725, 1653, 204, 7, 19, 30, 0, 106, 336, 123, UINT_MAX, 6, 2, 461, 19, 22, 149, 67, 35, 11 },
+    { 217, 0, 25, 278, 33, 3, 3, 13, 29, 44, UINT_MAX, 0, 5, 1, 15, -21, 119, 53, 67, 24, 6 },
+    { 846, 3703, 238, 1024, 38, 5, 21, 26, 18, 30, 113, 1320, 7, 2, 107, 22, 3, 42, 47, 21, 6 },
+    { 63, 0, 1055, UINT_MAX, 58, 0, 11, 19, 101, -190, 114, 238, 9, 5, 900, 28, 102, 112, 70, 9, 8 },
+    { 438, 114, 386, 3183, 61, 4, 22, 46, 141, 574, 87, 4758, 8, 0, 23, 22, 25, 133, 35, 5, 6 },
+    { 58, 93, 508, 2000, 32, 14, 1, 26, 16, 37, 22, 71, 6, 2, 615, 15, 4, 0, 68, 7, 7 },
+    { 4, 4, 72, 986, 10, 25, -25, 19, 0, 82, 65, 0, 6, 4, 8222, 18, 61, 26, 82, 11, 3 },
+    { 42, 52, 199, 1887, 59, 41, 0, 10, 155, 84, 7, 1850, 6, 4, 2268, 40, UINT_MAX, 172, 80, 2, 8 },
+    { 39, UINT_MAX, 119, 8600, 39, UINT_MAX, 1, UINT_MAX, 2, 126, 13, 2902, 7, 4, 2387, 10, 70, UINT_MAX, 228, 33, 1 },
+    { 206, 4482, 89, 1201, 15, 8, 3, 24, 20, 74, 116, 226, 4, 0, 168, -22, 56, 0, 54, 5, 12 },
+    { 188, 223, 210, 2, 0, 13, -25, 8, 0, 369, 26, 1321, 9, 3, 803, 21, 53, 34, 32, 18, 19 },
+    { 52, 12, 296, 8570, 70, 6, 24, 45, 107, -247, 82, 1838, 4, 1, 1662, 23, 3, 89, 0, 30, 11 },
+    { 889, 338, 120, 15, 10, 22, -18, 8, 82, -21, 48, 2140, 5, 3, 478, 12, 91, 33, 54, 36, 10 },
+    { 82, 68, 610, 228, 61, 3, 41, 11, 117, 180, 107, 1696, 5, 2, 461, 35, 29, 149, 50, 55, 13 },
+    { 172, 0, 401, 295, 6, 22, 9, 11, 23, 118, 127, 3034, 6, 2, 658, 37, 117, 228, 77, 21, 17 },
+    { INT_MAX, 482, 425, 2093, 41, 1, 15, 6, 108, 644, 72, 0, 6, 2, 2888, 49, 35, 173, 60, 6, 17 },
+    { 220, 1854, 534, 209, 69, 1, 10, 5, 0, 149, 38, 81, 8, 5, 1712, 24, UINT_MAX, 196, 147, 4, 15 },
+    { 66, 235, 129, 23, 14, 15, -10, 18, 154, 91, 49, 17009, 5, 3, 615, INT_MAX, 56, 35, 72, 9, 15 },
+    { 187, 1965, 387, 238, 20, 6, 10, 25, 3, 336, 13, 823, 4, 1, 813, 7, 69, 37, 65, 2, 14 },
+    { 41, UINT_MAX, 741, 1299, 11, 25, 9, 9, 18, INT_MAX, 128, 405, 8, 3, 1324, 7, 52, 206, UINT_MAX, 27, 7 },
+    { 45, 145, 303, 2095, 18, 15, 15, 25, 7, 339, 50, 319, 9, 2, 2133, 6, 38, 44, 36, 17, 10 },
+    { 109, 15, 364, 2099, 33, 12, 13, 17, 37, 999, 27, UINT_MAX, 7, 4, 1417, 34, 22, 178, 77, 2, 14 },
+    { 30, 163, 425, 2190, 86, 30, 22, 52, 0, 532, 53, 91, 5, UINT_MAX, 224, 15, 30, 51, 70, 10, 10 },
+    { INT_MAX, 732, UINT_MAX, 164, 4, 40, 18, 15, 102, 20, 47, 1822, 5, 4, 497, 17, 46, 77, 50, 15, 17 },
+    { 292, 724, 218, 58, 28, 14, -16, 24, 45, 12, 97, 739, 9, 3, 114, 26, 11, 109, 116, 3, 7 },
+    { 3, UINT_MAX, 370, 375, 39, 19, 24, 45, 0, 1075, 3, 3972, 7, 0, 589, 42, 45, 46, 111, 24, 15 },
+    { 24, 26, 16, 858, 0, 33, 12, 17, 74, 829, 111, 341, 6, 4, 771, 13, 75, 78, 84, 18, 5 },
+    { 214, 724, 310, 0, 22, 5, INT_MAX, 58, 77, 37, 0, 1558, 5, 1, 180, 35, 103, 178, 90, 72, 11 },
+    { 979, 0, 444, 15, 27, 9, 14, 61, 103, -34, 28, 206, 6, 1, 17, 12, 113, 229, 126, UINT_MAX, 6 },
+    { 84, 180, 411, 30, 70, 20, -6, 3, 1, -469, 0, 341, 4, 5, 12050, 7, 102, 19, UINT_MAX, 8, 10 },
+    { -178, 181, 0, 106, 22, 0, 2, 40, 17, 156, 0, 3873, 4, 3, 3677, -3, 98, 56, 18, 0, 4 },
+    { 196, 12, 165, 793, 86, 1, 35, 8, 21, 31, 56, 13, 8, 1, 470, 36, 91, 35, 65, 5, 15 },
+    { 101, 220, 96, 38, 20, UINT_MAX, INT_MAX, 10, 25, 16, 122, 954, 8, 3, 683, INT_MAX, 14, 130, 179, 1, 16 },
+    { 466, 114, 112, 0, 0, 0, 17, 16, 105, 38, 125, 406, 9, 1, 4783, 53, 3, 114, 54, 1, 13 },
+    { 96, 1883, 1022, 1663, 57, 20, 16, UINT_MAX, 15, 246, 99, 3249, 4, 3, 658, 42, 13, 48, 78, 19, 13 },
+    { 162, 22, 516, 61, 35, 23, -2, 21, 33, 88, 111, 1355, 9, 0, 583, 12, 74, 28, 74, 13, 15 },
+    { 671, 338, 143, 1998, 59, 33, -5, 31, 0, -30, 112, 17545, 5, 1, 23, 0, 22, 223, 227, 6, 3 },
+    { 207, 1313, UINT_MAX, 182, 14, 5, 2, 17, 24, 9, 39, 2044, 6, 5, 115, 9, 101, 57, 112, 45, 1 },
+    { 62, 214, 316, 42, 10, 2, 5, 16, 108, -30, 69, 2642, 5, 0, 444, 17, 45, 60, 43, 60, 7 },
+    { 64, 517, 3, 1323, 45, 30, 19, 20, 0, 62, 53, 42, 6, 5, 3637, 33, 9, 146, 49, 5, 13 },
+    { 113, 145, 74, 5451, 5, 0, 11, 61, 55, 338, 87, 2021, 4, 1, 1711, 41, 0, 42, 83, 24, 9 },
+    { 44, 10, 122, 401, 20, 16, -6, 35, 20, 67, 0, 206, 6, 5, 590, 1, 43, 28, 22, 62, 10 },
+    { 83, 644, 45, 2040, 32, 20, 22, 10, 78, 636, 71, 871, 6, 4, UINT_MAX, 22, 25, UINT_MAX, 80, 9, 11 },
+    { 485, 517, 1539, 421, 51, 16, -3, 31, 7, INT_MIN, 0, 3496, 9, 2, 0, 17, 10, 30, 63, 19, 9 },
+    { 270, 188, 1537, 152, 63, 15, 4, 15, 0, -32, 0, 1837, 5, 1, 2179, -5, 71, 43, UINT_MAX, 9, 6 },
+    { 138, 83, 377, UINT_MAX, 44, 19, 25, 31, 102, 552, 44, 1001, 7, 4, 1112, 26, 124, 28, UINT_MAX, 19, 10 },
+    { 230, 196, 81, 4, 11, 4, 16, 24, 27, 247, 99, 479, 6, 4, 1323, 31, 44, 60, 47, 74, 17 },
+    { 702, 642, 231, 1588, 50, 12, 31, 0, 13, 920, 113, 3912, 7, 1, 5226, 21, 5, 222, 48, 54, 12 },
+    { 216, 9, 1063, 10400, 33, 21, 5, 0, 1, 13, 47, 423, 6, 2, 638, -1, 117, 0, 21, 13, 15 },
+    { 94, 1029, 369, 1219, 26, 20, 32, 60, 21, -62, 19, UINT_MAX, 7, 4, 906, INT_MAX, 39, 60, 80, 63, 10 },
+    { 65, 154, 87, 363, 43, 12, 8, 8, 21, 313, 115, 2370, 8, 4, 541, 40, 70, 0, UINT_MAX, 10, 14 },
+    { 80, 16, 200, 664, 35, 0, 8, 29, 173, 37, 114, 127, 7, 4, 227, 42, 82, 71, 44, 52, 13 },
+    { INT_MAX, 2454, UINT_MAX, 1445, 40, 19, -12, 19, 36, -63, 47, 2722, 5, 5, 1574, INT_MIN, 52, 0, 75, 3, 9 },
+    { INT_MAX, 643, 61, 2041, UINT_MAX, 8, 7, 34, 9, 78, 108, UINT_MAX, 9, 0, 3726, 31, 41, 30, 96, 28, 11 },
+    { 65, 37, 363, 709, 1, 6, 7, 3, 90, 14, 18, 2838, 6, 2, 953, 9, 100, 0, 39, 62, 13 },
+    { 76, 3, 425, 306, 14, 0, 9, 10, 13, 92, 13, 781, 7, 5, 456, 6, 85, 0, 17, 111, 14 },
+    { 346, 9, 110, 663, 47, 4, 12, 20, 18, 49, 86, 1696, 7, 0, 373, 50, 17, 110, 48, 66, 12 },
+    { INT_MIN, 1314, 190, 1577, UINT_MAX, 8, 19, 30, 16, 44, 111, 890, 4, 0, 0, -38, 53, 46, 62, 0, 7 },
+    { 66, 486, 56, 24, 0, 23, 30, 9, 3, 19, 2, 1987, UINT_MAX, 4, 27, 24, 112, 111, 56, 7, 15 },
+    { -179, 55, 93, 192, 26, 13, 6, 32, 5, 248, 0, 2035, 6, 1, 179, -8, 0, 16, 49, 36, 7 },
+    { 216, 30, UINT_MAX, 2632, 70, 12, INT_MAX, 3, 24, 97, 114, 206, 0, 0, 0, 15, 22, 40, 0, 2, 9 },
+    { 26, 0, 386, 1930, 58, 17, -25, 0, 7, INT_MIN, 60, 2043, 8, 2, 211, 5, 42, 221, UINT_MAX, 32, 4 },
+    { 516, 6143, 424, 1144, 22, 15, -12, 4, 1, 350, 7, 2722, 8, 1, 3532, 1, UINT_MAX, 63, 28, 178, 5 },
+    { 268, 725, 420, 1117, 17, 40, INT_MIN, 7, 9, 157, 23, 2020, 7, 5, 214, 13, 97, 112, 28, 14, 5 },
+    { 93, 172, 183, 367, 68, 10, -16, 19, 10, -64, 56, 341, 6, 1, 0, 13, 42, 31, 227, 60, 11 },
+    { -109, 187, 231, 0, 38, 2, 12, 17, UINT_MAX, 122, 42, 1599, 8, 2, 1051, 1, 25, 73, 47, 24, 8 },
+    { 46, 7, 119, 9642, 8, 4, 12, 58, 116, 22, 68, 7548, 8, 2, 459, 28, 47, 64, 139, 53, 7 },
+    { 52, 766, 1512, 210, 46, 16, -12, 24, 87, 313, 52, 2190, 5, 2, 1605, -2, 35, 223, 60, 177, 6 },
+    { 189, 724, 359, 14, 22, 0, -8, 44, 106, 45, 95, 2541, 0, 5, 1, 11, 77, 36, 77, 37, 10 },
+    { 58, 500, 299, 1097, 25, 0, 5, 15, 18, 98, 71, 0, 8, 4, 230, 4, 78, 166, 76, 55, 4 },
+    { 74, 11, 97, 323, 43, 0, 23, 44, 16, 24, 22, 1981, 5, 2, 411, 11, 27, 43, 49, 2, 7 },
+    { 336, 30, 411, 83, 35, 4, 21, 29, 12, 5, 84, 0, 6, 2, 625, 22, 26, 71, 60, 98, 11 },
+    { INT_MAX, 114, 425, 3417, 1, 16, 10, 1, 108, 40, 100, 359, 8, 3, 373, 24, 0, 56, 104, UINT_MAX, 11 },
+    { 18, 189, 9, 930, 62, 26, 18, 15, 33, 222, 59, UINT_MAX, 5, 3, 0, 49, 62, 125, 26, 45, 11 },
+    { 784, 6142, 303, 0, 13, 6, 24, 23, 9, 58, 36, 1077, 8, 1, 404, 2, 79, 86, 43, 33, 14 },
+    { -20, 182, 104, 306, 37, UINT_MAX, 14, 45, 56, 4, 82, 1186, 7, 1, 469, 22, 120, 52, 138, 57, 13 },
+    { 781, 67, 174, UINT_MAX, 42, 22, 11, 0, 131, 58, 92, 374, 6, 4, 0, 37, 42, 118, 62, 18, 15 },
+    { 96, 245, 626, 21, 49, 6, 16, 14, UINT_MAX, 7, 17, 599, 9, 2, 2318, 11, 80, 59, 63, 25, 8 },
+    { 30, 0, UINT_MAX, 3227, 14, 14, INT_MIN, 3, 0, 276, 3, 325, 8, 3, 806, -8, 42, 147, 77, 13, 0 },
+    { 105, 5, 381, 5817, 1, 6, 7, 13, 18, -17, 83, 3606, 5, 4, 3054, 9, 27, 41, 60, 21, 6 },
+    { -70, 30, 1022, 100, 46, 10, 4, 33, 56, 30, 53, 4987, 4, 2, 205, 43, 0, 228, 152, 6, 6 },
+    { 988, 39, UINT_MAX, 5104, 52, 30, 18, 36, 166, 135, 79, 16399, 8, 0, 393, 38, 35, UINT_MAX, 144, 3, 13 },
+    { 670, 1474, 185, 2011, 20, 16, 31, 17, 4, INT_MIN, 126, 325, 8, 2, 134, 38, 38, 177, 106, 18, 15 },
+    { 165, 0, 65, 6452, 54, 0, -3, 14, 13, 783, 95, 81, 8, 1, 1133, 4, 70, 23, 28, 8, 9 },
+    { 66, 0, 204, 0, 8, 11, -24, 45, 87, -47, 2, 524, 8, 2, 2267, 8, 118, 98, 20, 25, 7 },
+    { 223, 621, 1121, 94, 65, 11, 12, 59, 20, -1, 90, 3848, 5, 3, 650, 21, 29, 98, 19, 23, 5 },
+    { -9, 649, 451, 1935, 22, 32, 29, 3, 173, 10, 64, 729, 4, UINT_MAX, 4431, -9, 38, 30, 32, 46, 13 },
+    { -95, 0, 183, 688, 16, 19, 15, 37, 176, 88, 31, 2591, 8, UINT_MAX, 210, 39, UINT_MAX, 143, 0, 2, 12 },
+    { 23, 482, 344, 250, 64, 16, -24, 16, 102, 193, 125, 0, 6, 0, 3727, 21, 58, 35, 75, 66, 10 },
+    { 346, 21, 9, 3381, 21, 40, -45, 59, 0, 296, 56, 2643, 8, 3, 919, 11, 22, 62, 0, 13, 5 },
+    { 25, 6143, 87, 4, UINT_MAX, 17, -4, 31, 4, 34, 104, 4, 5, 1, 806, -24, 50, 75, 228, 13, 10 },
+    { 75, 1965, 534, 940, 32, 11, 19, 52, 3, 399, 112, 1077, 8, 1, 1605, 31, 2, 100, 0, 24, 11 },
+    { 343, 26, 437, 1080, 55, 9, INT_MIN, 16, 118, 2, 75, UINT_MAX, 6, 1, 367, 17, 33, 49, 107, 18, 10 },
+    { INT_MAX, 0, 46, 2496, 0, 41, 26, 29, 0, 5, 0, 47, 9, 2, 1528, 11, 2, 31, 34, 3, 13 },
+    { 14, 544, 269, 2258, 69, 12, 25, 13, 62, -246, 49, UINT_MAX, 7, 3, 469, 33, 10, 113, 41, 54, 10 },
+    { 24, 34, 328, 207, 0, 7, 5, 30, 13, 42, 99, 1013, 8, 3, 767, 13, 13, 48, 21, 66, 6 },
+    { 21, 182, 199, 0, 0, 24, 4, 4, 102, 199, 72, 405, 6, 0, 211, INT_MIN, 52, 29, 139, 33, 6 },
+    { 978, 822, 30, 813, 61, 33, -43, 35, 97, 88, 68, 3197, 4, 3, 218, 3, 121, 20, 31, 33, 8 },
+    { -62, 297, 42, 1012, 70, 9, 13, 36, 1, -20, 23, 3196, 8, 2, 243, 15, 44, 114, 64, 99, 8 },
+    { 267, 52, 107, 3191, 68, 11, 8, 5, 5, 41, 80, 690, 7, 1, 292, 22, 100, 158, 24, 4, 14 },
+    { 74, 10, 521, 141, 29, 20, INT_MIN, 13, 64, INT_MAX, 37, 2931, 8, 5, 825, -10, 92, 64, 71, 0, 8 },
+    { 58, 445, 415, 261, 17, 14, INT_MIN, 5, 86, 10, 43, 1075, UINT_MAX, 5, 1406, 19, 70, 167, 52, 15, 6 },
+    { 108, 22, 25, 321, 73, 15, 15, 23, 28, 40, 64, 4, 7, 0, 570, 25, 92, 153, 23, 1, 17 },
+    { 59, 40, 17, 745, 58, 26, -5, 1, 14, 218, 101, 72, 6, 0, 552, -9, 124, 107, UINT_MAX, 26, 8 },
+    { 94, 9, 168, 4, 39, 40, 14, 5, 33, 553, 3, 3248, 6, 2, 1185, 28, 120, 49, 82, 72, 14 },
+    { 58, 337, 939, 608, 69, 18, -4, 17, 2, 43, 76, 276, 7, 4, 1539, -38, 77, 71, 34, 21, 7 },
+    { 107, UINT_MAX, 40, 8722, 15, UINT_MAX, -4, 5, 31, 7, 106, 2873, 5, 4, 32, 34, UINT_MAX, 72, 39, 32, 10 },
+    { 99, 482, 264, 628, 24, 32, -45, 51, 21, 66, 72, 0, 7, 3, 226, 16, 6, 55, 33, 5, 11 },
+    { 90, 486, 75, 774, 35, 5, 32, 14, 18, 43, 65, 1259, 8, 0, 1134, -10, 31, 72, 75, 24, 6 },
+    { -44, 5, UINT_MAX, 689, 16, 21, -2, 8, 21, 259, 72, 3874, 6, 4, UINT_MAX, -5, 36, 54, 24, 30, 5 },
+    { 466, 1313, 197, 428, 85, 18, -6, 11, 1, 783, 115, 6708, 5, 2, 1112, 30, 23, 114, 94, 1, 12 },
+    { 293, 41, 521, 520, 8, 23, 19, 11, 128, -465, 41, 1076, 5, 3, 119, 24, 80, 65, 77, 21, 8 },
+    { -53, UINT_MAX, 388, 998, 17, 30, -25, 31, 8, 69, 116, 974, 4, 4, 864, -3, 59, 134, 50, 22, 6 },
+    { 102, 275, 180, 2005, 65, 33, -43, 37, 3, 493, 57, 2931, 4, 1, 374, 42, 92, 54, 179, 65, 15 },
+    { 75, 6142, 182, 9789, 24, 23, 32, 18, 13, 207, 69, 2259, 6, 4, 383, 32, UINT_MAX, 155, 105, 46, 12 },
+    { -10, 244, 440, 1059, 50, 24, INT_MIN, 25, 72, 96, 55, 17051, 6, 1, 1922, 6, 12, 73, 92, 177, 9 },
+    { INT_MIN, 517, 479, 2429, 16, 16, 3, 44, 5, INT_MAX, 0, 17009, 8, 2, 5021, 6, 74, 50, 67, 17, 6 },
+    { 91, 822, 134, 0, 33, 23, INT_MIN, 33, 117, 41, 48, 6538, 9, 2, 30, 1, 26, 46, 41, 177, 11 },
+    { 2, 17, 213, 94, 31, 8, 16, 45, 2, 199, 71, 6708, 8, 1, 1738, -23, 0, 36, 112, 21, 7 },
+    { 112, 0, 93, 803, 17, 26, 2, 3, 20, 50, 86, 4713, 6, 3, UINT_MAX, INT_MIN, 81, 23, 102, 16, 8 },
+    { 141, 6143, 1329, 37, 46, 1, 21, 21, 25, 1912, 27, 3, UINT_MAX, 5, 3892, INT_MAX, 53, 178, 64, 6, 14 },
+    { 105, 163, 129, 1075, 17, 0, 30, 11, 83, 184, 52, 0, 9, 3, 292, -4, 124, UINT_MAX, 108, 56, 9 },
+    { 55, 127, 504, UINT_MAX, 28, 19, 14, 45, 117, INT_MAX, 103, 2725, 8, UINT_MAX, 3455, 35, 0, 94, 58, 53, 10 },
+    { 2, 28, 120, 568, 59, 32, -44, 3, 49, -16, 96, 47, 9, 1, 1133, 11, 69, 112, 67, 18, 3 },
+    { 99, 20, 1196, 0, 47, 4, 10, 34, 73, -17, 41, 0, 7, 3, 190, -5, 110, 102, UINT_MAX, 16, 5 },
+    { 635, 72, 233, 4707, 0, 0, -24, 9, 27, 83, 51, 49, 4, 0, 650, -10, 0, 163, 0, 0, 4 },
+    { 78, 4481, 221, UINT_MAX, 61, 32, 14, 35, 37, 1057, 0, 1075, 4, 4, 240, 36, 78, UINT_MAX, 97, 29, 15 },
+    { 517, 19315, 1538, 666, 8, 30, 20, 27, 11, 48, 47, 0, 5, 4, 3677, 41, 39, 122, 143, 29, 14 },
+    { 77, UINT_MAX, 64, UINT_MAX, 70, 32, 4, 11, 33, -189, 123, 3950, 8, 0, 3531, 9, 121, 76, 35, 26, 9 },
+    { 89, 1965, 139, 2451, 49, 40, INT_MAX, 14, 11, 28, 12, 1076, 7, 3, 570, 24, 117, 87, 73, 46, 11 },
+    { 79, 274, UINT_MAX, 146, 34, 14, 8, 39, 56, 184, 79, 1667, 5, 1, 1565, 29, 29, 54, 69, 55, 17 },
+    { 42, 162, 1691, 0, 23, 16, -2, 21, 0, 39, 1, 1522, 6, 2, 946, -9, 7, 20, 70, 29, 4 },
+    { 50, 725, 1144, 587, 22, 26, 7, 6, 3, 88, 38, 3451, 8, 2, 984, -5, 71, 38, 72, 29, 9 },
+    { -15, 1741, 57, 9641, 39, 15, 42, 22, 0, 41, 82, 23, 9, 2, 761, 21, 43, 132, 120, 33, 10 },
+    { 62, 338, 120, 1317, 60, 9, 13, 11, 83, 148, 98, 299, 7, 2, 767, 19, 97, 71, 63, 6, 12 },
+    { 76, 190, 348, 3009, 47, 41, 14, 45, 41, 160, 4, 7548, 8, 2, 1738, 39, 46, 68, 34, 10, 9 },
+    { 51, 767, 208, 8721, 46, 7, -6, 24, 7, 336, 107, UINT_MAX, 7, 4, 5226, 12, 81, 44, 139, 32, 2 },
+    { 172, 9, 185, 2000, 86, 8, INT_MIN, 3, UINT_MAX, -31, 68, 6, 6, 5, 497, -12, 0, 34, 73, 30, 10 },
+    { 66, 29, 6, 2188, 19, 19, -10, 0, 6, 200, 56, 781, 7, 2, 573, 36, 52, 34, 16, 23, 11 },
+    { 101, 107, 310, 497, 31, 5, 26, 18, 65, 7, UINT_MAX, 0, 6, 3, 0, 14, 79, 77, 95, 11, 13 },
+    { 220, 297, 485, 66, 0, 8, 2, 25, 90, 1058, 60, 6990, 9, 5, 2206, 20, 37, 33, 27, 62, 16 },
+    { 98, 222, 4, 569, 9, 41, -6, 22, 62, -62, 40, 521, 6, 2, 525, -4, 72, 16, 87, 177, 11 },
+    { 66, 5, 100, 23, 8, 20, 12, 19, 7, 179, 31, 2724, 0, UINT_MAX, 683, -6, 122, 33, 63, 53, 12 },
+    { -96, 641, 236, 2335, 9, 13, 10, 15, 0, 92, 63, 1032, 6, 4, 3730, -8, 81, 38, 38, 34, 7 },
+    { 569, 29, 225, 2538, 62, 16, 7, 3, 22, 339, 21, 6537, 4, 1, 1301, 26, 39, 219, 160, 99, 13 },
+    { 109, 182, 304, 0, 48, UINT_MAX, 1, 33, 4, -17, 39, 480, 6, 0, 1657, 19, 26, 16, 179, 24, 14 },
+    { -167, 1475, 310, 6128, 29, 13, 4, 4, 35, 126, 36, 1, 9, 0, 0, 46, 38, 94, 37, 1, 4 },
+    { 107, 197, UINT_MAX, 41, 52, UINT_MAX, -16, 9, 8, 174, 13, 684, 5, 0, 1351, 18, 122, 40, 71, UINT_MAX, 11 },
+    { 201, 26, 231, 105, 29, 12, -44, 17, 0, 47, 36, 480, 8, 3, 434, 22, 103, 49, 155, UINT_MAX, 13 },
+    { 67, 189, 237, 310, 24, 8, 14, 38, 75, 118, 106, 1001, 7, 4, 433, 37, 51, 46, 145, 54, 17 },
+    { 947, 531, 1120, 711, 14, 0, 24, 46, 62, 75, 116, 5050, 8, 5, 2219, 14, 0, 48, 62, 66, 7 },
+    { 82, 4481, 46, UINT_MAX, 27, 20, 14, 10, 6, 1094, 55, 719, UINT_MAX, 2, UINT_MAX, -13, 42, 0, 45, 5, 11 },
+    { 77, 3, 388, 5570, 54, 2, 16, 54, 86, -189, 0, 1755, 8, 1, 768, -19, 124, 196, 25, 62, 8 },
+    { 98, 127, 479, 24, 86, 34, 5, 0, 85, 96, 82, 1208, 6, 5, 139, 14, 92, 52, 144, 6, 17 },
+    { 106, 10, 74, 1118, 26, 19, 10, 29, 58, 50, UINT_MAX, 119, 8, 0, 344, 19, 1, 154, 17, 22, 12 },
+    { 3, 172, 5, 710, 26, 7, 2, 1, 0, 42, 96, 2542, 4, 0, 187, -9, 0, 0, 81, 21, 7 },
+    { 47, 53, 16, 568, 39, 1, -18, 61, 0, 123, 64, 3900, 6, 4, 1, 10, 4, 91, 30, 7, 5 },
+    { 293, 26, 438, 1439, 39, 8, 20, 36, 62, 92, 7, 56, 5, 5, 722, 18, 72, 88, 60, 12, 9 },
+    { INT_MAX, 106, 189, 407, 69, 22, 25, 50, 101, 171, 99, 50, 8, 4, 943, 42, 40, 39, 45, 0, 17 },
+    { -1164, 46, 1537, 709, 12, 6, -7, 45, 0, -464, 105, 118, 4, 4, 456, -9, 13, 32, 0, 36, 7 },
+    { 45, 1883, 451, 1639, 86, 1, 26, 39, 82, 71, 80, 5351, 8, 5, UINT_MAX, 10, 82, 91, 106, 23, 12 },
+    { 74, 38, 218, 204, 0, 41, -18, 45, 6, -73, 27, 14, 9, 0, 49, -8, 29, 40, 53, 72, 4 },
+    { 269, 4482, 1538, 0, 39, 0, 14, 28, 0, 19, 64, 911, 8, 4, 1908, 3, 37, 34, 135, 66, 10 },
+    { 64, 198, 199, 311, 54, 15, -1, 15, 108, -34, 83, 6922, 9, 5, 44, 31, 93, 92, 94, 24, 8 },
+    { 23, 49, 136, 985, 15, 11, 13, 19, 20, 643, 91, 729, 8, 3, 0, -13, 0, 87, 47, 17, 6 },
+    { 282, 245, 269, 54, 61, 4, -6, 21, 3, 40, 32, 11, 4, 4, 224, -9, 123, 50, 87, 20, 8 },
+    { 56, 221, 74, 73, 46, 22, -3, 18, 19, -11, 51, 0, 6, 1, 306, 17, 38, 123, 43, 3, 1 },
+    { 69, 30, 1660, 5255, 26, 0, 18, 3, 78, 69, 78, 197, 0, 0, 1351, 23, 23, 226, 231, 74, 6 },
+    { 43, 98, 74, 328, 31, 2, 8, 19, 59, 636, 56, 585, 8, 4, 944, 39, 74, 23, 136, 23, 10 },
+    { 109, 47, 121, UINT_MAX, 15, 12, -4, 3, 23, INT_MAX, 56, 384, 6, 1, 107, 18, UINT_MAX, 37, 123, 16, 14 },
+    { 255, 27, 112, 307, 41, 2, 20, 26, 55, -114, 125, 1183, 5, 2, 806, -21, 3, UINT_MAX, 44, 0, 2 },
+    { 220, 12, 71, 21, 48, 2, 41, 27, 0, 148, 37, 2197, UINT_MAX, 4, 1916, 41, 34, 130, 94, 13, 19 },
+    { 97, 2454, 65, 0, 53, 22, 13, 15, 16, 50, 91, 2984, 7, 1, 1, 29, 1, 146, 126, 7, 5 },
+    { 432, 69, 45, 2010, 29, 7, 16, 28, 172, -72, 71, 3942, 8, 1, 187, INT_MAX, 38, 127, 50, 5, 10 },
+    { 418, 487, 509, 0, 86, 5, 24, 50, 130, 57, 123, 6709, 8, 1, 132, 30, 4, 103, 22, 15, 10 },
+    { 92, 1741, 229, 1109, 19, 19, -2, 2, UINT_MAX, -246, 96, 51, 7, 4, 928, 1, 10, 23, 64, 66, 8 },
+    { 127, 173, 417, 716, 60, 7, -3, 26, 161, INT_MIN, 52, 206, 7, 4, 1662, 24, 9, 79, 136, 2, 6 },
+    { 60, 4, 299, 5582, 56, 3, 4, 61, 90, 16, 48, 1558, 6, 1, 5540, 45, 13, 158, 97, 26, 7 },
+    { 66, 501, 1426, 2357, 50, 33, 14, 50, 105, 1499, 100, 8491, 9, 4, UINT_MAX, 27, 30, 94, 48, 62, 14 },
+    { 569, 197, 62, 227, 9, 22, 25, UINT_MAX, 24, 31, 127, 6922, 8, 5, 649, 21, 2, 133, 72, 80, 9 },
+    { 281, 48, 70, 0, 49, UINT_MAX, 5, 2, 85, -29, 98, 1075, 7, 1, 0, INT_MIN, 3, 206, 44, 23, 10 },
+    { -65, 0, 17, 2757, 40, UINT_MAX, -7, 33, 64, 149, 123, 586, UINT_MAX, 2, 75, -2, 5, 54, 17, 2, 8 },
+    { 988, 183, 825, 232, 25, 14, 1, 45, 71, -190, 115, 19, 5, 1, 48, 8, 3, 123, 230, 62, 3 },
+    { INT_MIN, 4, 1426, 2011, 9, 0, -6, 23, 71, 7, 78, 3197, 7, 1, 1930, 4, 123, 225, 151, 2, 4 },
+    { 335, 19315, 485, 1194, 67, 20, 14, 16, 43, 156, 36, 197, 6, 1, 23, 17, 10, 108, 136, 3, 13 },
+    { 149, 27, 1426, 69, 16, 7, 11, 0, 26, 25, 1, 120, 8, 3, 392, 25, 44, 92, 66, 15, 14 },
+    { 134, 4481, 113, 459, 17, 24, -7, 2, 17, 9, 42, 292, 0, 3, 1223, -23, 98, 35, 73, 5, 3 },
+    { 115, 1965, 1319, 1039, 9, 8, 41, 35, 22, 156, 112, 521, 0, 5, 786, 13, 4, 206, 103, 33, 9 },
+    { 281, 6, 1661, 198, 32, 41, 1, 3, 2, 2, 126, 2721, 4, 3, 623, 3, 97, 21, 46, 21, 9 },
+    { 64, 724, 263, 2496, 29, UINT_MAX, 9, 3, 55, 259, 43, 1703, 8, 0, 528, 15, 4, 38, 25, 0, 8 },
+    { 57, 19315, 118, 1579, 47, 13, 12, 17, 0, -2, 14, 2260, 5, 5, 557, 15, 62, 77, 74, 25, 6 },
+    { 988, 47, 439, 0, 9, 3, 5, 0, 19, 46, 99, 1, 6, 3, 1860, -9, 29, 39, 228, 0, 8 },
+    { 87, 28, 939, 61, 33, 1, 13, 29, 91, 42, UINT_MAX, 127, 9, UINT_MAX, 1360, 7, 0, 157, 226, 37, 4 },
+    { 107, 115, 186, 193, 71, 3, 16, 26, 0, INT_MAX, 61, 2370, 6, 0, 2009, 22, 32, 110, 61, UINT_MAX, 17 },
+    { -104, 20, 72, 1371, 65, 0, 15, 19, 42, 121, 29, 17052, 0, 3, 3537, 19, 50, 126, 37, 25, 7 },
+    { -65, 500, 41, UINT_MAX, 54, UINT_MAX, 22, 51, UINT_MAX, 5, 114, 406, 0, 1, 3636, 30, 26, UINT_MAX, 0, 10, 6 },
+    { -169, 487, 55, 11, 9, 8, 0, 6, 57, 248, 66, 2983, 7, 5, 626, 9, 11, 64, 58, 56, 5 },
+    { -31, 1964, 58, 6612, 60, 3, 19, 29, 107, 635, 75, 0, 9, 2, 5540, 3, 97, 136, 41, 18, 7 },
+    { 201, 163, 182, 1, 53, 8, 7, 27, 82, 16, 0, 374, 6, 0, 424, 28, 65, 94, 112, 0, 11 },
+    { 96, 0, 187, 31, UINT_MAX, 9, 2, 6, 13, 18, 38, 523, 0, 3, 369, 11, 70, 48, 179, 73, 5 },
+    { -1165, 4482, 55, 840, 14, 5, INT_MIN, 11, 67, 19, 30, 3221, 6, 3, 1367, INT_MIN, 71, 67, 135, 46, 5 },
+    { -168, 15, 252, 0, 54, 26, -25, 37, 0, 783, 71, 4758, 7, 0, 1051, 4, 69, 143, 80, 0, 4 },
+    { 346, 197, 1206, 1209, 21, 0, -44, 25, 20, 78, 56, 1634, 0, 0, 4784, 7, 24, 0, 227, 54, 9 },
+    { 229, 29, 378, 3182, 0, 22, 1, 17, 141, -73, 82, 196, 5, 1, 7, 4, 72, 22, 22, 0, 12 },
+    { 222, UINT_MAX, 105, 180, 63, 13, 11, 15, 84, -65, 98, 86, 5, 4, 492, 22, 2, 0, 65, 32, 10 },
+    { -178, 642, 1538, 260, 0, 4, 4, 8, 16, 368, 85, 1115, 8, 4, UINT_MAX, -19, 33, 172, 22, 28, 9 },
+    { 124, 0, 432, 408, 45, 0, 3, 13, 87, 58, UINT_MAX, 4409, 6, 2, 2839, 45, 81, 87, UINT_MAX, 26, 7 },
+    { -14, 40, 623, 165, 29, 3, -43, 52, 0, 150, 33, 1331, 6, 2, 153, -9, 67, 16, 20, 16, 10 },
+    { 4, 224, 5, 363, 24, 2, -3, 4, 5, 493, 78, 1571, 6, 1, 2986, 35, 97, 82, 20, 20, 4 },
+    { 30, 15, 145, 1200, 38, 10, 7, 2, 91, 119, 91, 3034, 7, 2, 2986, 29, 47, 103, UINT_MAX, 11, 6 },
+    { -95, 221, 7, 0, 41, UINT_MAX, 3, 9, 8, 846, 72, 2533, 5, 1, 172, 22, 81, 100, 83, 1, 5 },
+    { 66, 26, 272, 894, 18, 3, 24, 30, 40, 400, 21, 1224, 7, 1, 847, 25, 40, 44, 99, 18, 12 },
+    { -44, 25, 44, 269, 25, 26, 18, 0, 0, 830, 128, 91, 8, 3, 27, -9, 46, 28, 39, 32, 11 },
+    { 53, 31, 243, 91, 28, 16, 10, 32, 0, -72, 68, 2591, 9, 2, 134, INT_MIN, 105, 35, 139, 27, 11 },
+    { 671, 724, 163, 976, 73, 26, INT_MIN, 45, 97, 174, UINT_MAX, 3522, UINT_MAX, UINT_MAX, 420, 40, 13, 157, 72, 53, 12 },
+    { -233, 197, 376, 180, 24, 14, 2, 5, 2, 78, 0, 1849, 7, 1, 652, -4, 9, 86, 162, 3, 0 },
+    { 160, 207, 31, 297, 21, 23, 5, 47, 45, -17, 52, 57, 9, 4, 1323, 18, 42, 40, 139, 32, 11 },
+    { INT_MIN, 253, 3, 259, 11, 14, 24, UINT_MAX, 85, 247, 0, 502, 6, 4, 246, -4, 77, 25, 20, 3, 11 },
+    { 99, 206, 376, 95, 21, 0, -6, 0, 4, -189, 41, 1836, 6, 4, 1540, 8, 42, 163, 56, 0, 1 },
+    { -94, 23, 826, 84, 38, 4, 1, 5, 76, -469, UINT_MAX, 374, 5, 1, 221, 1, 122, 27, 39, 6, 7 },
+    { 670, 4481, 160, 2075, 21, 14, 32, 48, 15, 552, 115, 5352, 4, 5, 1223, 13, 27, 57, 47, 12, 11 },
+    { 5, 181, 257, 162, 19, 16, 30, 7, 84, 147, 42, 3521, 9, 5, 344, 17, 116, 228, 35, 12, 9 },
+    { INT_MAX, 163, 311, 2301, 45, 14, 10, 35, 93, 451, 38, 1076, 8, 2, 944, 26, 74, 102, 155, 28, 12 },
+    { 75, 62, 251, 1324, 42, 7, 14, 9, 1, 45, 57, 73, 6, 2, 1023, 52, 23, 149, 102, 19, 12 },
+    { 39, 28, 458, 314, 14, 2, 42, 32, 162, -31, 17, 74, 7, 1, 573, 14, 103, UINT_MAX, 226, 5, 4 },
+    { 23, 22, 217, 1936, 27, 26, 12, 2, 0, 1095, UINT_MAX, 2591, 8, 3, UINT_MAX, 2, 35, 60, 115, 6, 7 },
+    { 50, UINT_MAX, 151, 1257, 8, 3, 8, 18, 5, INT_MIN, 56, 2139, UINT_MAX, 5, 570, -2, 79, 27, 19, 16, 6 },
+    { 54, 18, 207, 29, UINT_MAX, 3, 35, 35, 45, 188, 97, 293, 8, 3, 5226, 17, 47, 57, 161, 29, 10 },
+    { 263, 0, 71, 591, 61, 41, 11, 23, 13, 495, UINT_MAX, 2539, 7, 0, 2, 27, 16, 105, 74, 74, 13 },
+    { 63, 4481, UINT_MAX, 2004, 49, 9, 4, 3, 5, 48, 3, 585, 9, 5, 0, -7, 119, 173, 64, 16, 5 },
+    { 59, 486, 258, 893, 6, 4, -16, 23, 106, INT_MIN, 74, 17545, 4, 1, 3, -13, 69, 20, 21, 25, 10 },
+    { 211, 1313, 254, 1200, 35, 23, -7, 0, 84, 336, 59, 4757, 5, 4, 23, 10, 6, 23, 34, 4, 16 },
+    { 284, 648, 189, 158, 49, 14, 18, 35, 22, 82, 57, 684, 7, 2, 34, 41, 42, 128, 43, 21, 20 },
+    { 38, UINT_MAX, 395, 22467, 27, 21, -1, 0, 0, -1335, 71, UINT_MAX, 7, 4, 813, 30, 62, 57, 62, 19, 5 },
+    { 65, 162, 699, 644, 55, 3, 10, 12, 20, 938, 13, 1974, 9, 3, UINT_MAX, 52, 102, 66, 0, 45, 12 },
+    { -103, 767, 1512, 1130, 28, 13, 35, 23, 23, 277, 75, 1203, 8, 2, 1167, 16, 29, 78, 58, 21, 16 },
+    { -1165, 4482, 39, 644, 62, 4, 34, 19, 38, 783, 128, 2197, 6, 2, 1613, 25, 9, 54, 115, 32, 16 },
+    { INT_MIN, 1965, 164, 20, 1, 11, 24, 36, 54, -30, 52, 1345, 8, 3, 17, 17, 25, 65, 101, 12, 16 },
+    { 210, 107, 125, 6613, 1, UINT_MAX, 6, 16, 36, 48, 20, 13, 5, 4, 5540, 24, 3, 226, 88, 2, 6 },
+    { 57, UINT_MAX, 229, 2255, 69, 14, -5, 6, 77, 409, 97, 41, 6, 2, 2814, 13, 96, 158, 92, 16, 8 },
+    { 132, 234, 265, 327, 53, 23, 6, 2, 101, 368, 48, 17008, 8, 5, 419, -2, 123, 39, 52, 34, 12 },
+    { 59, 47, 51, 679, 21, 4, -43, 38, 6, 1075, 1, 1987, 7, 5, 385, 1, 33, 69, 23, 66, 10 },
+    { 73, 1314, 479, 598, 47, 26, 3, 13, 12, -11, 94, 4988, 5, UINT_MAX, 0, -23, UINT_MAX, 90, 107, UINT_MAX, 2 },
+    { INT_MIN, 16, 229, 5, 52, 0, 12, 8, 84, 12, 98, 3197, 8, 1, 1015, -6, 102, 63, 64, 24, 5 },
+    { 144, 30, 43, 3183, 3, 9, 15, 26, 0, -464, 38, 48, 7, 1, 767, 12, 26, 167, 36, 3, 8 },
+    { 60, 93, 54, 2334, 58, 8, INT_MAX, 16, 82, 369, 22, 3377, 9, 3, 923, 50, 30, UINT_MAX, 43, 6, 12 },
+    { -14, 337, 8, 19, 41, 3, -4, 31, 76, -470, 35, 56, 7, 1, 73, INT_MIN, 53, 91, 106, 33, 2 },
+    { 48, 220, 230, 1938, 16, 40, -45, 18, 8, 25, 100, 210, 7, 5, 683, 4, 123, 86, 112, 75, 8 },
+    { 174, 182, UINT_MAX, 2190, 18, 4, 42, 1, 1, 89, 54, 1974, 6, 5, UINT_MAX, 21, UINT_MAX, 157, 147, 17, 15 },
+    { 75, 173, 415, 676, 16, 12, -24, 32, 21, -62, 75, 2193, 7, 5, 425, 12, 104, 50, 40, 10, 3 },
+    { 195, 224, 86, 6452, 8, 0, INT_MAX, 0, 4, INT_MIN, 37, 890, 9, 1, 783, 17, 31, 62, 155, 53, 12 },
+    { 131, 1882, 1241, 197, 62, 11, 15, UINT_MAX, 77, -1, 123, 119, 8, 2, 27, 17, 21, 92, 232, 66, 6 },
+    { 167, 0, 145, UINT_MAX, 39, 19, 11, 8, 36, 89, 61, 1982, 6, 3, 2365, 34, 48, 68, UINT_MAX, 25, 15 },
+    { 129, 0, 159, 31, 10, 13, 11, 45, 177, 9, 37, 3521, UINT_MAX, 3, 707, 13, 0, 95, 0, 19, 12 },
+    { 85, 6142, 1201, 259, 14, 7, INT_MAX, 11, 12, 783, UINT_MAX, 2725, 6, 4, 1006, 38, 24, 158, 44, 32, 16 },
+    { 217, 766, 316, 7495, 31, 9, 40, 16, 106, 576, 53, 3912, 6, 4, 2727, 13, 21, 29, 35, 75, 11 },
+    { -62, 545, 0, 344, 60, 12, -44, 6, 11, INT_MAX, 63, 1262, 6, 1, 2164, -3, 34, 23, 52, 79, 6 },
+    { 267, 251, 416, 892, 27, 14, 22, 19, 36, 48, 0, 83, 7, 0, 433, 0, UINT_MAX, 41, 81, 54, 12 },
+    { INT_MIN, 0, 7, 2770, 41, 40, -44, 39, 17, INT_MAX, 125, UINT_MAX, UINT_MAX, 4, 121, 7, 30, 58, 73, 24, 7 },
+    { INT_MAX, UINT_MAX, 690, 354, 9, 12, -44, 1, 101, 83, 48, 2901, UINT_MAX, 1, 39, 21, 14, 154, 64, 79, 13 },
+    { 72, 500, 209, 66, 0, 0, -3, 28, UINT_MAX, 223, 25, 3709, 6, 4, 4432, 20, 38, 39, 85, 26, 14 },
+    { 267, 275, 218, 814, 30, 4, 7, 27, 103, 150, 116, 6923, 6, 3, 1658, 39, 12, 50, 61, 53, 16 },
+    { 201, 26, 314, 284, 38, 13, -4, 3, 48, INT_MAX, 54, 1981, 6, 2, 2, 43, 1, 93, 19, 1, 14 },
+    { 79, 22, 69, 0, 7, 19, 19, 6, 101, 784, 117, 1982, 4, 5, 694, 31, 63, 123, 58, 8, 17 },
+    { -24, 1474, 224, 1115, 30, 26, 9, 36, 102, -34, 23, 83, 5, 0, 802, 19, 32, 134, 78, 26, 3 },
+    { 282, 11, 238, 20, 70, 5, -17, 13, 176, -47, 47, 207, UINT_MAX, 0, 0, 25, 124, 0, 31, 12, 13 },
+    { 196, 207, 238, 3794, 40, 19, -6, 45, 58, 361, 128, 1076, 7, 0, 2220, 23, 5, 104, 42, 5, 3 },
+    { 64, 6, 700, 185, 50, 4, INT_MIN, 11, 0, -25, 98, 1012, UINT_MAX, 5, 883, -3, 37, 93, 0, 26, 5 },
+    { 187, 145, 199, 354, 21, 1, 16, 30, 25, 999, 0, 449, 8, 3, 907, 14, 106, 103, 156, 57, 10 },
+    { 131, 821, 438, 169, 52, 11, 40, 20, 21, 161, 64, 2533, 8, 0, 946, 35, 45, UINT_MAX, 17, 2, 15 },
+    { 48, 127, 388, 2125, 16, 3, 24, 2, 34, 82, 95, 127, 6, 4, 1923, 14, 13, 66, 76, 0, 5 },
+    { 187, 83, 308, 2698, 71, 2, 40, 59, 85, 1, 49, 6466, 9, 2, 1596, 37, 61, 123, 0, 27, 8 },
+    { 59, 1313, 230, 8896, 29, 40, 13, 14, 103, 35, 33, 5, 4, 3, 1923, 9, 16, 90, 119, 56, 6 },
+    { 100, 262, 117, 976, 7, 8, -16, 24, 20, 77, 116, 2521, 4, UINT_MAX, 650, -4, 24, 211, 51, 33, 2 },
+    { 418, 1439, 369, 4488, 15, 6, 5, 40, 15, 337, 111, 1002, 5, 0, 650, 32, 28, 53, UINT_MAX, 72, 10 },
+    { 57, 487, 1033, 1300, UINT_MAX, 34, -45, 32, 3, INT_MAX, 92, 3932, 5, 1, 1036, 23, 0, 132, 21, 18, 7 },
+    { 72, 16, 0, UINT_MAX, 63, 6, 20, 3, 36, 11, 3, 3249, 7, 3, 268, 17, 120, 35, 66, 25, 8 },
+    { 171, 21, 45, 2124, 13, 9, 13, 0, 10, 248, 0, UINT_MAX, 6, 4, 139, 0, 14, 76, 161, 29, 2 },
+    { 128, 28, 199, 223, 6, 10, INT_MAX, 21, 78, -20, 33, 1668, 6, 4, 1, 31, 34, 50, 21, 1, 10 },
+    { INT_MAX, 16, 105, 1027, 38, 25, 24, 50, 103, 223, 64, UINT_MAX, 5, 1, 575, 1, 29, 133, 71, 5, 10 },
+    { 142, 7, 150, 1273, 37, 40, 16, 51, 129, 998, 63, 12, UINT_MAX, 2, 1889, 1, 118, 123, 45, 61, 12 },
+    { -15, 1029, 103, 354, 49, 0, -16, 0, 0, 361, 20, 2590, 5, 4, 22, 3, 69, 219, 75, 80, 5 },
+    { 3, 98, 160, 396, 6, 6, 5, 51, 173, 79, UINT_MAX, 2642, 7, 3, 1, 16, 2, 52, 19, UINT_MAX, 8 },
+    { 216, 24, 130, 7069, 64, 10, 2, 2, 24, -49, 117, 58, 5, 1, 224, 41, 124, 178, 47, 17, 7 },
+    { 97, 19315, 0, 156, 0, 7, 29, 31, 12, 339, UINT_MAX, 16399, 0, 2, UINT_MAX, 23, 53, 68, 45, 27, 13 },
+    { -44, 172, 81, 2799, 71, 11, 7, 9, 16, 1500, 1, 2529, 8, 1, UINT_MAX, 42, 69, 68, 74, 112, 5 },
+    { 281, 500, 1610, 840, 12, 17, 18, 39, 176, 1809, UINT_MAX, 0, 5, 3, 658, 24, 1, 34, 99, 17, 16 },
+    { 466, 30, 158, 383, 3, 2, 4, 40, 11, 248, 99, 18, 4, 4, 3532, -3, 103, 32, 145, 1, 11 },
+    { 112, 385, 177, 253, 40, 0, -16, 39, 9, 1, 122, 1461, 7, 4, 767, 24, 27, 62, 106, 6, 6 },
+    { 90, 250, 270, 47, 52, 20, -17, 8, 102, INT_MIN, 107, 0, 6, 3, 944, -4, 71, 68, 56, 21, 7 },
+    { 23, 15, 128, 188, 5, 6, 5, 1, 106, 253, 116, 586, 8, UINT_MAX, 306, -23, 24, 30, 178, 23, 1 },
+    { 102, 531, 269, 269, 0, 14, 19, 28, UINT_MAX, 4, 112, 360, 6, 4, 3803, 39, 13, 17, 61, 33, 14 },
+    { 124, 17, 1661, 1193, 13, 30, INT_MAX, 4, 0, -2, 127, 117, 5, 4, 718, INT_MIN, 121, 0, 20, 30, 11 },
+    { 51, 296, 0, 563, 3, 25, INT_MIN, 0, 36, 636, 75, 17051, 6, 0, 456, 10, 80, 53, 68, 5, 2 },
+    { 67, 19314, 97, 428, 0, 33, INT_MAX, 10, 7, 361, 60, 6538, 4, 3, 2758, 2, 0, 48, 120, 74, 7 },
+    { 418, 244, 49, 4348, 86, 19, -4, 4, 3, 42, 108, 47, 0, 3, 3440, 10, 28, 211, 131, 1, 6 },
+    { 106, 487, 88, 102, 15, 9, 16, 8, 154, 183, 24, 739, 8, 3, 18, 25, 38, 128, 161, 13, 15 },
+    { 162, 245, 188, 310, 21, 33, INT_MAX, 28, 167, 495, 103, 2128, 5, 4, 264, -13, 106, 35, 16, 20, 11 },
+    { -112, 1, 402, 2122, 28, 0, 14, 0, 6, 207, 83, 1667, 9, 0, 0, -8, 6, 31, 17, 2, 12 },
+    { INT_MAX, 82, 15, 85, 67, 6, -17, 20, 0, 91, 124, 2534, 5, 1, 649, 11, 78, 35, 19, 29, 16 },
+    { 88, 0, 122, 663, 51, 6, 30, 25, 10, 64, 114, 5, 8, 0, 616, 15, 28, 91, 26, 12, 11 },
+    { 110, 250, 268, 1716, 51, 17, 14, 5, 102, 451, 46, 6708, 7, 3, 614, 27, 4, 70, 27, 27, 13 },
+    { 40, 38, 784, 2334, 50, 0, -10, 7, 59, 36, 48, 3912, 5, 5, 651, 0, 77, 75, 96, 18, 2 },
+    { -166, 9, 197, 179, 65, 0, 26, 14, 67, 1500, 2, 1845, 5, 0, 557, 24, 47, 133, 27, 72, 11 },
+    { 60, 46, 0, 8601, 56, 11, 29, 23, 73, 897, 46, 2477, 7, 2, 3538, -19, 57, 38, 135, 0, 7 },
+    { 23, 62, 201, 3760, 69, UINT_MAX, -3, 8, 0, 915, 26, 2020, 8, 3, 191, 10, 46, 129, 27, 24, 2 },
+    { 101, 1313, 151, 297, 29, 1, 21, 28, 129, 43, 127, UINT_MAX, 9, 4, 211, 30, 67, 216, 63, 30, 18 },
+    { 187, 4, 938, 37, 22, 12, 12, 50, 141, 105, 63, 522, 6, 3, 882, 11, 29, 27, 35, 28, 12 },
+    { 292, 31, 172, 59, 60, 5, INT_MIN, 2, 7, -17, 67, 0, 5, 3, 4819, -4, 70, 82, 66, 13, 6 },
+    { -84, 1474, 0, 35, 35, 23, 4, 6, 2, 91, 61, 828, 8, 3, 12049, 6, 25, 33, 21, 2, 4 },
+    { 220, 98, 145, 96, 56, 30, -2, 0, 3, 1058, 13, 56, 7, 1, 946, -24, 16, 70, 84, 18, 5 },
+    { 1, 13, 150, 1354, 37, 17, 5, 51, 76, 6, 24, 916, 5, 2, 2839, 7, 4, 89, 24, 0, 6 },
+    { 391, 0, 70, 174, 30, 2, 7, 46, 15, -3, 96, 11, 5, 3, 856, 40, 29, UINT_MAX, 22, 80, 7 },
+    { 102, 724, 267, 462, 41, 13, 16, 6, 107, 1500, 58, 4988, 8, 5, 422, 26, 41, 87, 80, 46, 16 },
+    { 174, 482, 1517, 6613, 13, 16, -25, 45, 15, 48, 59, 3050, 6, 5, UINT_MAX, -22, 25, 207, 41, 20, 11 },
+    { 68, 282, 5, 110, 40, 6, 3, 17, UINT_MAX, 32, 45, 2996, 9, 1, 190, 22, 4, 68, 48, 7, 6 },
+    { -37, 188, 0, 891, 43, 12, -17, 0, 0, 15, 104, 3950, 9, 4, 385, 12, 100, 149, 31, 33, 1 },
+    { 132, 337, 247, 1191, 28, 5, 7, 7, 34, 33, 25, 869, 8, 3, 119, 38, 124, 223, 32, 8, 13 },
+    { INT_MIN, 444, 395, 534, 45, 0, 9, 13, 4, 77, UINT_MAX, 3211, 5, 4, 919, 50, 81, 44, 0, 12, 14 },
+    { 517, 767, 91, 5, 70, 0, 2, 3, 118, 148, 99, 75, 5, 1, 623, 14, 62, 64, 20, 32, 12 },
+    { 200, 62, 75, 91, 27, 3, INT_MIN, 32, 14, 58, 87, 23, 5, 5, 30, 17, UINT_MAX, 64, 68, 79, 18 },
+    { -95, 47, 140, 663, 0, 22, -11, 0, 24, -64, 61, 225, 7, 0, 5227, 11, 4, 164, 18, 0, 10 },
+    { 30, 172, 122, 25, 48, 0, INT_MIN, 8, 132, 134, 99, 1467, 7, 2, 710, 12, 101, 27, 24, 1, 7 },
+    { 431, 73, UINT_MAX, 441, 34, 9, 6, 36, 11, 46, 0, 2643, 8, 5, 853, 7, 28, 112, 38, UINT_MAX, 11 },
+    { 212, 221, 91, 1891, 25, UINT_MAX, -17, 0, 154, -30, 55, 17400, 6, 1, 1113, 29, 49, 47, 40, 0, 10 },
+    { 31, 6, 1426, 335, 39, 0, 33, 7, 97, 23, 47, 1837, 6, UINT_MAX, 371, 10, 24, 79, 20, 0, 11 },
+    { 673, 6, 230, 6452, 10, 33, 15, 2, 9, 30, 62, 3709, 6, 2, 1662, 2, 0, 0, 164, 32, 11 },
+    { -169, 1854, 216, 426, 0, 3, INT_MIN, 29, 15, -1335, 17, 57, 7, 1, 984, 2, 53, 211, 53, 0, 2 },
+    { 80, 145, 516, 430, 21, 34, 3, 45, 39, -189, 80, 0, 8, 5, 0, -4, 71, 59, 74, 24, 6 },
+    { 673, 162, 1055, 78, 55, 8, 16, 6, 74, 13, 97, 0, 8, 0, 682, 39, 75, 146, 85, 11, 13 },
+    { 515, 126, 372, 192, UINT_MAX, 22, 20, 37, 7, 6, 98, 0, 6, 0, 154, 33, 13, 110, 99, 75, 12 },
+    { 104, 733, 182, 196, 12, 0, 3, 19, 4, 11, 71, 720, 7, 1, 249, 46, 22, 47, 96, 4, 15 },
+    { 53, 483, 6, 152, 23, UINT_MAX, -5, 15, 85, -464, 94, 51, 5, 2, 1406, 16, UINT_MAX, UINT_MAX, 230, 6, 3 },
+    { 702, 115, 225, 0, 12, 0, -18, 46, 38, 532, 49, 1988, 0, 4, 564, 18, 39, 57, UINT_MAX, 55, 15 },
+    { 141, 4, 395, 29, 40, 3, 4, 54, 20, 32, 14, 827, 6, 3, 1258, 3, 68, 121, 0, 8, 8 },
+    { 55, 482, 269, 2255, 43, 2, -4, 34, 33, 148, 0, 225, 5, 1, 790, INT_MIN, 44, 51, 99, 9, 9 },
+    { 44, 72, 60, 232, 29, 4, 10, 29, 68, 24, 59, 2128, UINT_MAX, 1, 752, 10, 49, 93, 37, 57, 4 },
+    { -70, 224, 232, 1194, 22, 0, -5, 33, 154, 276, 50, 74, 6, 0, 851, -3, 33, UINT_MAX, 143, 21, 4 },
+    { 153, 38, 263, 164, 56, 33, 16, 40, 0, -26, 54, 411, 8, 2, 3, 3, 30, 22, 118, 11, 4 },
+    { 144, UINT_MAX, 177, 2357, UINT_MAX, 26, 11, 45, 37, 1057, UINT_MAX, 405, 5, 0, 3879, 25, 54, 92, 55, 11, 12 },
+    { 674, 648, 164, 1964, 36, 41, -7, 20, 60, 125, 78, 2276, 5, 1, 3726, INT_MIN, 65, 94, 89, 177, 6 },
+    { 4, UINT_MAX, 17, 463, 2, 11, 4, 58, 84, 24, 36, 605, 6, 3, 0, 12, 46, 45, 19, 7, 8 },
+    { 92, UINT_MAX, 316, 1040, 36, 20, 23, 31, 74, 253, 12, 277, UINT_MAX, 3, 169, 22, UINT_MAX, 97, 46, 17, 12 },
+    { INT_MAX, 253, 699, 227, UINT_MAX, 40, 8, 55, 38, 45, 112, 1959, 0, 3, 705, 22, 70, UINT_MAX, 89, 30, 8 },
+    { -115, 206, 285, 4707, 23, 0, -11, 18, 85, 163, 79, 81, 5, 0, 943, 4, 4, 67, 37, 61, 2 },
+    { 220, 188, 690, 627, 13, 20, 42, 14, 142, 20, 78, 6537, 8, 4, 2134, 19, 3, 36, 80, 4, 13 },
+    { 100, 38, 191, 273, 23, 9, 0, 45, 68, 40, 68, 2044, 8, UINT_MAX, 1101, INT_MIN, 80, 76, 76, 24, 6 },
+    { -234, 3218, 63, 22468, 49, 5, 25, 45, 10, 188, 93, 8491, 6, 4, 805, -3, 30, 104, 60, 15, 4 },
+    { 107, 5, 39, 476, 5, 34, -11, 16, 18, -17, 35, 3578, 8, 0, 1998, -2, 116, 0, 78, 1, 5 },
+    { 18, 649, 243, 1933, 30, 20, 13, 3, 17, -48, 28, 3949, 7, 1, 1407, 19, 50, 155, 30, 32, 7 },
+    { 418, 1314, 83, 1621, 44, 0, 23, 44, 37, 829, 115, 1988, 5, 3, 374, INT_MAX, 4, 25, 0, 55, 15 },
+    { 783, 4481, 1245, 477, 25, 1, 11, 23, 77, 9, 43, 1331, 9, UINT_MAX, 2267, 31, 2, 122, 76, 27, 7 },
+    { -66, 181, UINT_MAX, 573, 33, 18, 2, 1, 16, 10, 94, 17009, 5, 4, 4506, 4, UINT_MAX, 212, UINT_MAX, 29, 3 },
+    { 218, 10, 50, 408, 67, 11, 20, 17, 107, 337, 98, 3093, 8, 1, 614, 43, 7, 64, 82, 0, 15 },
+    { INT_MIN, 220, 145, 256, 13, 18, -8, 12, 18, 5, 69, UINT_MAX, 5, 3, 1024, 1, 69, 57, 142, 62, 4 },
+    { INT_MAX, 6, 226, 400, 60, 7, 2, 13, 84, -11, 23, 3093, UINT_MAX, 3, 1261, -3, 10, 33, 112, 63, 3 },
+    { 53, 155, 269, 321, 32, 16, 41, 25, 15, 1, 51, 360, 0, 4, 890, 4, 0, 16, UINT_MAX, 28, 11 },
+    { -95, 6, 139, 1679, 20, 5, 2, 29, 0, 14, UINT_MAX, 5351, 5, 4, 3, -9, 101, 60, 17, 177, 11 },
+    { 93, 1314, 155, 1638, 2, 13, 30, 0, 2, 35, 67, 587, 8, 3, 847, 26, 38, 38, 100, 29, 15 },
+    { 589, 12, 1206, 1998, 21, 1, 41, 33, 76, 14, 52, 336, 9, 4, 49, 25, 17, 206, 94, 177, 12 },
+    { 673, 531, 680, 67, 56, 29, 31, 33, 26, 12, 22, 186, 5, 4, 2, 23, 22, 52, 19, 111, 10 },
+    { -112, 53, 8, 2688, 63, 18, -6, 5, 60, 846, 95, 2259, 4, 1, 767, 2, 9, 97, 0, 1, 8 },
+    { 14, 9, 146, 460, 12, 23, -24, 35, 7, -16, 52, 2756, 7, 4, 1203, 19, 53, 20, 40, UINT_MAX, 6 },
+    { 46, 183, 432, UINT_MAX, 38, 4, 12, 35, 62, 122, 78, 35, 8, 2, 3676, 23, 36, 78, 101, 61, 6 },
+    { -37, 621, 57, 210, 2, 21, -6, 35, 7, 44, 6, UINT_MAX, 8, 4, 860, 13, 35, 99, 30, 55, 5 },
+    { 846, 10, 939, 1028, 14, 22, 9, 12, 128, -50, 115, 3973, 0, 2, 955, 14, 10, 31, 155, 29, 12 },
+    { -84, 296, 272, 2098, 36, 10, 18, 44, 45, 35, 112, 2260, 9, 1, 540, 45, 125, 93, 112, 12, 9 },
+    { 2, 6, 0, 1129, 30, 19, -45, 16, 6, 90, 70, 3912, 8, 0, 226, 22, 27, 95, 145, 3, 0 },
+    { 784, 1854, 6, 0, 63, 13, 16, 32, 28, INT_MAX, 33, 2149, 6, 4, 919, 25, 121, 88, 146, 61, 18 },
+    { 484, 17, 190, 296, 45, 10, 5, 34, 37, -15, 111, 4, 8, 3, 17, 22, UINT_MAX, 29, 20, 5, 10 },
+    { 116, UINT_MAX, 0, 323, 16, 3, 20, 30, 141, -114, 1, 195, 8, 0, 693, -5, 28, 0, 16, 52, 9 },
+    { 51, 1854, 1652, 421, 33, 19, 6, 23, 5, 37, 69, 92, 7, 3, 2267, 27, 32, 79, 72, 13, 7 },
+    { 153, 531, 1063, 239, 12, 0, -1, 2, 74, 493, 74, 2818, 6, 0, 374, 5, 29, 126, 60, 1, 2 },
+    { 58, 37, 0, 218, 18, 3, 4, 38, 28, 34, 50, 2260, 5, 1, 478, 29, 0, 17, 16, 55, 8 },
+    { 46, 274, 125, 34, 53, 7, 11, 4, 103, -20, 1, 23, 0, 3, 24, 4, 8, 63, 161, 9, 4 },
+    { 75, 306, 481, 6, 52, 12, 9, 20, 32, -30, 97, 1304, 8, 0, 2814, 1, 120, 35, 145, 5, 11 },
+    { 78, 18, 573, 1474, 3, 0, INT_MIN, 32, 17, -30, 113, 197, 8, 0, 0, 27, 15, 197, 55, 46, 8 },
+    { 212, 49, 377, 53, 21, 21, 26, 11, 98, 1, 27, 358, 6, 2, 540, 8, UINT_MAX, 40, 95, 55, 14 },
+    { -234, 281, 376, 113, 7, 4, 4, 45, 12, 15, 23, 119, 8, 3, 4803, INT_MIN, 78, 26, 50, 20, 6 },
+    { 74, 3703, 0, 1857, 34, 40, -16, 12, 5, 24, 81, 3093, 9, 1, 528, INT_MAX, 69, 45, 92, 178, 11 },
+    { 187, 154, 24, 6452, 50, 4, 42, 13, 97, 50, 60, 119, 0, UINT_MAX, 44, 35, 4, 72, 33, 3, 10 },
+    { -115, 262, 168, 1879, 65, 4, -16, 17, 3, -10, 56, 11871, 7, 4, 4819, INT_MIN, 110, 152, 37, 111, 4 },
+    { -168, 644, 623, 0, 62, 6, -4, 14, 15, 349, 114, 0, 0, 4, 230, -10, 93, 101, 136, 178, 5 },
+    { INT_MAX, 306, 209, 830, 0, 14, -8, 31, 129, 11, 98, 3873, 4, 0, 4720, 13, 70, 82, 139, 33, 3 },
+    { 3, 732, 130, 262, 70, 18, 4, 19, 0, 36, 12, 3849, 5, 1, 4803, 13, 111, 16, 179, 33, 5 },
+    { 292, 17, 504, UINT_MAX, 26, 34, 20, 37, 128, 260, 100, 23, 9, 2, 0, 11, 0, 77, 116, 16, 13 },
+    { -1164, 106, 932, 3635, 0, 33, -11, 58, 24, 60, 58, 2838, 4, UINT_MAX, 1605, -24, 7, UINT_MAX, 82, 30, 4 },
+    { 194, 253, 168, 487, 52, 21, 1, 0, 5, 13, 95, 1216, 4, 4, 48, 2, 101, 76, 96, 11, 2 },
+    { 784, UINT_MAX, 104, 6129, 64, 41, 29, 3, 7, 349, 0, 195, 4, 2, 5022, 17, 43, 164, 178, 13, 16 },
+    { 67, 392, UINT_MAX, 0, 46, UINT_MAX, 32, 11, 7, 18, 30, 87, UINT_MAX, 0, 651, 6, 77, 219, 28, 9, 12 },
+    { -85, 19315, 396, 75, 48, 3, -17, 12, 98, 58, 112, 1960, 8, 3, 8, 15, 69, 45, UINT_MAX, 2, 7 },
+    { 11, 418, 1054, 108, 13, 0, -3, 20, 18, INT_MAX, 0, 890, 5, 3, 1641, -22, 51, 31, 0, 14, 10 },
+    { 517, 40, 1672, 8909, 20, 12, 2, 8, 59, INT_MAX, 46, 211, 7, 0, 946, 5, 29, 65, 54, 31, 6 },
+    { 392, 37, 253, 2998, 27, 13, 8, 31, 13, -17, 42, 359, 5, 3, 2, -6, 37, 211, 21, 54, 4 },
+    { 48, 12, 319, 2539, 64, 6, 6, 18, 10, 157, 46, 383, 8, 1, 847, -12, 79, 51, 82, 1, 7 },
+    { 634, 281, 1063, 2, 23, 14, -6, 31, 24, INT_MIN, 66, 1898, 5, 0, 575, -21, 11, 24, 56, 29, 14 },
+    { -108, 11, 52, 4605, 0, 34, INT_MIN, 51, 0, 250, 38, 1571, 7, 2, 24, 11, 120, UINT_MAX, 131, 29, 4 },
+    { 82, 3219, 134, 5217, 62, 5, 30, 31, 104, 148, 55, 729, 8, 4, 920, 32, 13, 110, 51, 29, 15 },
+    { -25, 30, 1539, 1345, 30, 6, 6, 54, 11, -21, 59, 72, 6, 1, 144, -24, 96, 0, 18, UINT_MAX, 12 },
+    { INT_MAX, 223, 165, 1113, 17, 34, INT_MIN, 14, 25, 336, 122, 2020, 9, 2, 1, 10, 58, 27, 58, 2, 13 },
+    { INT_MIN, 391, 236, 898, 9, 23, 12, 2, 0, 4, UINT_MAX, 1987, 6, 1, 681, 19, 123, 48, 17, 22, 13 },
+    { 101, 4, 191, 102, 26, 5, 12, 46, 12, 35, 126, 521, UINT_MAX, 5, 651, 9, 60, 62, 23, 45, 10 },
+    { 165, 24, 74, 37, 62, 3, 8, 45, 129, 5, 63, 118, 6, 5, 187, -22, 34, 21, 95, 32, 11 },
+    { 47, 253, 120, 93, 56, 7, -44, 17, 11, 18, 63, 870, 5, 2, 4803, 26, 97, 146, 33, 8, 5 },
+    { INT_MAX, 766, 1513, 192, 86, 0, 30, 28, 17, 1076, 0, 5351, 5, 2, UINT_MAX, 9, 71, 96, 56, 26, 9 },
+    { 2, 262, 104, 0, 45, 9, 17, 38, 26, 532, 68, 890, 8, 0, 364, -24, 22, 26, 22, 16, 14 },
+    { 54, 254, 172, 2463, 2, 5, -4, 0, 75, INT_MIN, UINT_MAX, 2034, 6, 4, 1016, -13, 101, 226, 136, 54, 3 },
+    { 85, 21, 217, 859, 35, 34, 6, 2, 130, 57, 82, 0, 4, 1, 8, 11, 91, 36, 126, 27, 14 },
+    { 139, 0, 272, 2633, UINT_MAX, 2, 3, 12, 102, -32, 85, 1468, 7, 4, 834, 12, 37, 173, 56, 56, 3 },
+    { 13, 0, 0, 771, 22, 13, 21, 37, 4, -18, 124, 12216, 8, 3, 1930, -10, 69, 20, 40, 61, 8 },
+    { -15, 500, 135, 2000, 12, 2, 19, 19, 98, -64, 86, 2722, 4, 3, 45, -5, 46, 32, 20, 177, 14 },
+    { 62, 245, 0, 0, 36, UINT_MAX, 17, 15, 7, -22, 20, 3057, 7, 3, 2206, 0, 40, 71, 21, 11, 8 },
+    { 343, 21, UINT_MAX, 1886, 63, 25, 2, 0, 14, -464, 56, 2534, 7, 2, 100, 36, 1, 28, 136, 45, 10 },
+    { 30, 55, 270, 4051, 5, 10, 16, 37, 11, 12, 47, 1987, 7, 1, 744, 19, 91, 136, 63, 11, 3 },
+    { 106, 62, 226, 765, 16, 33, -5, 23, 155, 531, 26, 6042, 8, 2, 1167, 12, 113, 65, 127, 18, 6 },
+    { INT_MIN, 24, 242, 284, 6, 15, 12, 0, 5, 43, 55, 0, 9, 1, 1366, 28, 122, 68, 39, 9, 9 },
+    { 59, 3218, 376, 16, 71, 3, 18, 0, 85, 121, 57, 11, 6, 2, 704, 3, 0, 73, UINT_MAX, 65, 9 },
+    { 270, 70, 163, 46, 37, 1, -44, 10, 177, -246, 31, 1703, 9, 2, 454, 9, 12, 28, 37, 1, 12 },
+    { 102, 1475, 72, 0, 30, 5, -11, 20, 0, 69, 44, 975, 7, 3, 0, 16, 46, 51, 77, UINT_MAX, 15 },
+    { 67, 19315, 172, 1707, 65, 3, INT_MIN, 24, 129, INT_MIN, 83, 47, 8, 3, 49, -12, 75, 0, 0, 53, 9 },
+    { -113, 213, 54, 2228, 64, 20, 13, 46, 19, INT_MAX, 92, 2438, 6, 1, 1367, 40, 123, 88, 88, 13, 13 },
+    { 979, 500, 272, 0, UINT_MAX, 6, -43, 15, 60, 172, 124, 3495, 5, 5, 536, 46, 0, 19, 43, 6, 10 },
+    { 1, UINT_MAX, 2732, 2496, 0, 14, 12, 16, 102, INT_MAX, 41, 2540, 4, 5, 808, 19, 44, 19, 50, 23, 8 },
+    { INT_MIN, 13, 85, 0, 63, 20, -8, 5, UINT_MAX, 248, 128, 87, 4, 5, 1774, -8, 74, 80, 22, 4, 10 },
+    { -96, 12, 172, 464, 28, 19, 22, 0, 6, 46, 46, 1202, 6, 3, 282, 18, 0, 101, 124, 9, 8 },
+    { 77, 16, 368, 182, 32, 0, 30, 55, 104, 26, 85, 1560, 8, 2, 100, -18, 0, 122, 20, 75, 9 },
+    { 94, 444, 134, 5103, 12, 8, 15, 23, 38, 16, 54, 3912, 8, 5, 1528, 39, 101, 43, 100, 22, 15 },
+    { -94, 25, 0, 443, 8, 4, -2, UINT_MAX, 8, 784, 61, 6042, 6, 1, 0, 51, 0, 104, 0, 56, 8 },
+    { 264, 220, 174, 402, 36, 34, 9, 28, 10, 1499, 59, 2533, 5, 4, 2180, 18, 17, 211, 85, 25, 8 },
+    { 73, 28, 142, 1058, 86, 23, -8, 25, 4, 41, 105, 12, 8, UINT_MAX, 2, 14, 25, 25, 20, 2, 8 },
+    { 634, 27, 189, 14, 0, 26, 4, 54, 0, -72, 80, 1668, 7, 1, 2220, INT_MIN, 68, 106, UINT_MAX, 26, 4 },
+    { 102, 108, 1671, 10563, 29, 20, 11, 2, 59, -29, 65, 1076, 9, 0, 241, 14, 8, UINT_MAX, 62, 2, 9 },
+    { 46, 500, 86, 5, 45, 0, 19, 40, 107, -2, 43, 684, 0, 2, 106, 9, 34, 219, 229, 5, 6 },
+    { INT_MAX, 3, 784, 282, 22, 17, 5, 26, 23, -1335, 43, 58, 5, 4, 421, 40, 0, 43, 54, 7, 8 },
+    { 268, 3, 392, 223, 28, 14, INT_MAX, 32, 177, 1090, 104, 2551, 5, 3, 145, 32, 25, 39, 40, 57, 20 },
+    { -70, 214, 71, 165, 47, 25, -12, 0, 6, 350, 83, 912, 8, 3, 161, 6, 103, 62, 230, 22, 2 },
+    { 44, 1474, 1121, 115, 68, 4, -5, 15, 0, 194, 44, 1837, 7, 0, UINT_MAX, 35, 46, 21, 21, UINT_MAX, 9 },
+    { 3, 93, UINT_MAX, 23, 3, 15, 3, 34, 75, 552, 63, 72, UINT_MAX, 1, 1999, -37, 56, 226, 27, 11, 10 },
+    { 173, 98, 0, 519, 54, UINT_MAX, 2, 52, 18, -17, 46, 2044, 8, 0, 2, 23, 86, 40, 86, 60, 8 },
+    { 270, 19315, 573, 107, 34, 33, -24, 0, 19, 1, 25, 1259, 6, 5, 433, 37, 120, 59, 34, 73, 11 },
+    { 38, 189, 0, 402, 42, 5, 19, 55, 0, 0, 38, 3905, 6, 1, 1612, INT_MIN, 52, 28, 0, 55, 12 },
+    { 195, 0, 262, 30, 52, 20, 15, 29, 71, 71, 123, 6923, 5, 5, UINT_MAX, 29, 6, 107, 59, 13, 14 },
+    { 268, 12, 208, 46, 12, UINT_MAX, -10, 19, 20, 90, 103, 2534, 0, 3, 281, INT_MIN, 13, 37, 39, 5, 9 },
+    { 64, 641, 59, 85, 15, 22, 7, 1, 85, 42, 48, 17401, 6, 0, 1916, 13, 82, 130, UINT_MAX, 13, 3 },
+    { -115, 245, 3, 6451, 30, 33, -24, 23, 83, INT_MIN, 48, 74, 7, 1, 0, -2, 110, 220, 34, 20, 5 },
+    { INT_MIN, 93, 163, 41, 49, 1, -45, 9, 97, 576, 33, 1738, 5, 2, 1351, 19, UINT_MAX, 50, 106, 17, 6 },
+    { 51, 109, 90, 1027, 59, 7, -6, 16, 11, 1913, 16, 47, UINT_MAX, 2, 501, 14, 82, 149, 78, 10, 7 },
+    { 42, 28, 1426, 1, 7, UINT_MAX, 31, 10, 0, 9, 57, 7547, 7, 2, 2008, -23, 47, 174, 64, 37, 10 },
+    { 99, 3, 129, 210, 43, 33, -7, 7, 0, -34, 26, 11, 5, 3, 492, INT_MIN, 119, 36, 21, 5, 4 },
+    { 220, 641, 119, 3191, 6, 16, 11, 0, 20, 248, 112, 1739, 5, 3, 433, 21, 21, 73, 63, 22, 12 },
+    { 846, 198, 358, 1993, 50, 9, -8, 55, 27, 4, 2, 6908, 5, 3, 264, INT_MIN, 34, 19, 106, 9, 12 },
+    { 568, 4, 5, 0, 15, 19, -10, 13, 16, -189, 0, 5, 5, UINT_MAX, 809, -10, 78, 109, 152, 62, 0 },
+    { 102, 181, 40, 891, 21, 40, 13, 24, 3, INT_MAX, 111, 0, 7, 0, 205, 23, 122, 63, 115, 7, 17 },
+    { -9, 46, 60, 1893, 70, 0, 8, 32, 22, 135, 65, UINT_MAX, 9, 0, 403, 1, 60, 17, 45, 12, 6 },
+    { 59, 200, 56, 140, 24, 7, 11, 17, 14, 6, 40, 84, 8, 1, 1166, 50, 56, 68, 21, 16, 13 },
+    { 947, 1029, 243, 0, 7, 15, -25, 34, 64, -190, 112, 872, 5, 1, 10, 4, 0, 25, 58, 65, 10 },
+    { 11, 191, 9, 676, 13, 40, 2, 40, 0, -3, 14, 1261, 4, 4, 583, INT_MAX, 117, 0, 29, 25, 9 },
+    { 188, 250, 151, 9789, 28, 26, 12, 7, 78, 896, 56, 72, 6, 1, 282, 38, 21, 148, 30, 36, 18 },
+    { 47, 445, 17, 1622, 27, 41, 18, 14, 0, 496, 114, 6538, UINT_MAX, 4, 286, -37, 68, UINT_MAX, 0, 57, 17 },
+    { 129, 47, 509, 313, 2, 20, 1, 8, 86, 30, 55, 3899, 0, 0, 26, 8, 42, 33, 82, 0, 12 },
+    { 94, 0, 437, 237, 6, 8, 6, 12, 0, 149, 112, 1181, UINT_MAX, 2, 1380, -5, 59, 86, 225, 66, 5 },
+    { -10, 109, 224, 2256, 43, 18, -5, 39, 6, -114, 82, 4380, 5, 1, UINT_MAX, 22, 69, 64, 94, 13, 8 },
+    { 99, 93, 415, 676, 7, 6, -2, 14, 130, -465, 43, 17545, 8, 2, 206, 9, 82, 210, 36, 1, 3 },
+    { INT_MIN, 73, 59, 199, 11, 24, -17, 9, 176, 451, 7, 3905, 7, 3, 552, -21, 59, 48, 44, 17, 1 },
+};
+
+static void GetFeatures(const RecordedFeatures& r, ASCRFFeatures features)
+{
+    SCDetectRF_Features(r.diffMVdiffVal, r.RsCsDiff, r.MVDiff, r.Rs, r.AFD, r.CsDiff, r.diffTSC, r.TSC, r.gchDC, r.diffRsCsdiff,
+                        r.posBalance, r.SC, r.TSCindex, r.Scindex, r.Cs, r.diffAFD, r.negBalance, r.ssDCval, r.refDCval, r.RsDiff, features);
+}
+
+TEST(ASCTree, VotesMatchRecordedVotes)
+{
+    for (size_t i = 0; i < sizeof(recorded) / sizeof(recorded[0]); i++)
+    {
+        ASCRFFeatures features;
+        GetFeatures(recorded[i], features);
+        EXPECT_EQ(recorded[i].votes, SCDetectRF_Votes(features)) << "vector " << i;
+    }
+}
+
+TEST(ASCTree, DecisionMatchesRecordedVotesForAllControlLevels)
+{
+    for (mfxU8 control = 0; control < RF_DECISION_LEVEL; control++)
+    {
+        for (size_t i = 0; i < sizeof(recorded) / sizeof(recorded[0]); i++)
+        {
+            const RecordedFeatures& r = recorded[i];
+            bool decision = SCDetectRF(r.diffMVdiffVal, r.RsCsDiff, r.MVDiff, r.Rs, r.AFD, r.CsDiff, r.diffTSC, r.TSC, r.gchDC, r.diffRsCsdiff,
+                                       r.posBalance, r.SC, r.TSCindex, r.Scindex, r.Cs, r.diffAFD, r.negBalance, r.ssDCval, r.refDCval, r.RsDiff, control);
+            EXPECT_EQ(r.votes > RF_DECISION_LEVEL + control, decision) << "vector " << i << " control " << (int)control;
+        }
+    }
+}
+
+TEST(ASCTree, BatchMatchesSingleFrameDecision)
+{
+    const size_t count = sizeof(recorded) / sizeof(recorded[0]);
+    std::unique_ptr<ASCRFFeatures[]> features(new ASCRFFeatures[count]);
+    for (size_t i = 0; i < count; i++)
+        GetFeatures(recorded[i], features[i]);
+
+    for (mfxU8 control = 0; control < RF_DECISION_LEVEL; control += 3)
+    {
+        std::unique_ptr<bool[]> decisions(new bool[count]);
+        SCDetectRF_Batch(features.get(), (mfxU32)count, control, decisions.get());
+        for (size_t i = 0; i < count; i++)
+            EXPECT_EQ(recorded[i].votes > RF_DECISION_LEVEL + control, decisions[i]) << "vector " << i << " control " << (int)control;
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "bs_mem+.h"
+
+namespace
+{
+    struct AU    { int id; };
+    struct Slice { int id; AU* au; };
+    struct CU    { unsigned char data[48]; };
+
+    struct Object
+    {
+        Object() { constructed++; }
+        ~Object() { destroyed++; }
+
+        static int constructed;
+        static int destroyed;
+    };
+
+    int Object::constructed = 0;
+    int Object::destroyed = 0;
+}
+
+TEST(BsMemAllocator, FreesDependentsWithTheirLastBase)
+{
+    BS_MEM::Allocator allocator;
+
+    AU* au = allocator.alloc<AU>();
+    Slice* slice = allocator.alloc<Slice>(au);
+    CU* cus = allocator.alloc<CU>(slice, 16);
+    Object* objects = allocator.alloc<Object>(slice, 3);
+
+    EXPECT_EQ(3, Object::constructed);
+
+    // bound to a base, the free is delayed until the base is freed
+    allocator.free(slice);
+    EXPECT_TRUE(allocator.touch(slice));
+    EXPECT_TRUE(allocator.touch(cus));
+
+    allocator.free(au);
+    EXPECT_FALSE(allocator.touch(au));
+    EXPECT_FALSE(allocator.touch(slice));
+    EXPECT_FALSE(allocator.touch(cus));
+    EXPECT_FALSE(allocator.touch(objects));
+    EXPECT_EQ(3, Object::destroyed);
+}
+
+TEST(BsMemAllocator, KeepsLockedObjectsUntilUnlocked)
+{
+    BS_MEM::Allocator allocator;
+
+    AU* au = allocator.alloc<AU>();
+    allocator.lock(au);
+    allocator.free(au);
+    EXPECT_TRUE(allocator.touch(au));
+
+    allocator.unlock(au);
+    EXPECT_FALSE(allocator.touch(au));
+}
+
+TEST(BsMemAllocator, DISABLED_Throughput)
+{
+    const int aus = 20000, slices = 4, cusPerSlice = 256, inFlight = 3;
+    BS_MEM::Allocator allocator;
+    std::vector<AU*> pending;
+
+    allocator.SetZero(true);
+
+    // the slice data of an AU is bound to its slices, the slices to the AU;
+    // an AU is released as a whole a few AUs later
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < aus; i++)
+    {
+        AU* au = allocator.alloc<AU>();
+
+        for (int s = 0; s < slices; s++)
+        {
+            Slice* slice = allocator.alloc<Slice>(au);
+
+            for (int c = 0; c < cusPerSlice; c++)
+                allocator.alloc<CU>(slice);
+
+            allocator.free(slice);
+        }
+
+        pending.push_back(au);
+        if (pending.size() > inFlight)
+        {
+            allocator.free(pending.front());
+            pending.erase(pending.begin());
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (AU* au : pending)
+        allocator.free(au);
+
+    printf("AUs: %.0f/s, allocation + free: %.1f ns\n", aus / elapsed.count(),
+        elapsed.count() * 1e9 / (aus * slices * (cusPerSlice + 1)));
+}
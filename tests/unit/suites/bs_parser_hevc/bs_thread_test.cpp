@@ -0,0 +1,269 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bs_thread.h"
+
+namespace
+{
+    // records the order and the worker of the executed tasks,
+    // a task may be held until the test lets it finish
+    struct Trace
+    {
+        struct Entry
+        {
+            std::string name;
+            std::thread::id worker;
+        };
+
+        std::mutex m_mtx;
+        std::vector<Entry> m_entries;
+
+        void Add(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_entries.push_back({ name, std::this_thread::get_id() });
+        }
+
+        std::string Order()
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            std::string order;
+            for (auto& e : m_entries)
+                order += e.name;
+            return order;
+        }
+
+        std::thread::id Worker(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            for (auto& e : m_entries)
+                if (e.name == name)
+                    return e.worker;
+            return std::thread::id();
+        }
+    };
+
+    struct Job
+    {
+        Job(Trace& trace, const char* name)
+            : trace(trace), name(name), gate(release.get_future().share())
+        {}
+
+        Trace& trace;
+        std::string name;
+        std::promise<void> started;
+        std::promise<void> release;
+        std::shared_future<void> gate;
+        bool held = false;
+
+        static BsThread::State Run(void* par, unsigned int)
+        {
+            Job& job = *(Job*)par;
+
+            job.trace.Add(job.name);
+            if (job.held)
+            {
+                job.started.set_value();
+                job.gate.wait();
+            }
+            return BsThread::DONE;
+        }
+
+        Job& Hold()
+        {
+            held = true;
+            return *this;
+        }
+    };
+}
+
+TEST(BsThreadScheduler, WorkerContinuesWithNewestUnblockedTask)
+{
+    BsThread::Scheduler scheduler;
+    Trace trace;
+    Job root(trace, "R"), d1(trace, "1"), d2(trace, "2"), d3(trace, "3"), other(trace, "G");
+
+    scheduler.Init(1);
+
+    root.Hold();
+    BsThread::SyncPoint sp = scheduler.Submit(Job::Run, &root, 0, 0, nullptr);
+    root.started.get_future().wait();
+
+    BsThread::SyncPoint last[4];
+    last[0] = scheduler.Submit(Job::Run, &d1, 0, 1, &sp);
+    last[1] = scheduler.Submit(Job::Run, &d2, 0, 1, &sp);
+    last[2] = scheduler.Submit(Job::Run, &d3, 0, 1, &sp);
+    last[3] = scheduler.Submit(Job::Run, &other, 0, 0, nullptr);
+
+    root.release.set_value();
+
+    for (auto s : last)
+        EXPECT_EQ(BsThread::DONE, scheduler.Sync(s, 10000));
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(sp, 10000));
+
+    // the dependents stay on the worker in LIFO order, the older queued task waits
+    EXPECT_EQ("R321G", trace.Order());
+
+    scheduler.Close();
+}
+
+TEST(BsThreadScheduler, WorkerPrefersQueuedTaskOfHigherPriority)
+{
+    BsThread::Scheduler scheduler;
+    Trace trace;
+    Job root(trace, "R"), d1(trace, "1"), d2(trace, "2"), urgent(trace, "U");
+
+    scheduler.Init(1);
+
+    root.Hold();
+    BsThread::SyncPoint sp = scheduler.Submit(Job::Run, &root, 0, 0, nullptr);
+    root.started.get_future().wait();
+
+    BsThread::SyncPoint last[3];
+    last[0] = scheduler.Submit(Job::Run, &d1, 0, 1, &sp);
+    last[1] = scheduler.Submit(Job::Run, &d2, 0, 1, &sp);
+    last[2] = scheduler.Submit(Job::Run, &urgent, 1, 0, nullptr);
+
+    root.release.set_value();
+
+    for (auto s : last)
+        EXPECT_EQ(BsThread::DONE, scheduler.Sync(s, 10000));
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(sp, 10000));
+
+    EXPECT_EQ("RU21", trace.Order());
+
+    scheduler.Close();
+}
+
+TEST(BsThreadScheduler, IdleWorkerStealsOldestTask)
+{
+    BsThread::Scheduler scheduler;
+    Trace trace;
+    Job root(trace, "R"), busy(trace, "B"), d1(trace, "1"), d2(trace, "2"), d3(trace, "3");
+
+    scheduler.Init(2);
+
+    // both workers are busy while the dependents of R are submitted
+    root.Hold();
+    busy.Hold();
+    BsThread::SyncPoint sp = scheduler.Submit(Job::Run, &root, 0, 0, nullptr);
+    BsThread::SyncPoint spBusy = scheduler.Submit(Job::Run, &busy, 0, 0, nullptr);
+    root.started.get_future().wait();
+    busy.started.get_future().wait();
+
+    d3.Hold();
+    BsThread::SyncPoint last[3];
+    last[0] = scheduler.Submit(Job::Run, &d1, 0, 1, &sp);
+    last[1] = scheduler.Submit(Job::Run, &d2, 0, 1, &sp);
+    last[2] = scheduler.Submit(Job::Run, &d3, 0, 1, &sp);
+
+    // the worker of R continues with the newest dependent and is held there
+    root.release.set_value();
+    d3.started.get_future().wait();
+
+    // the other worker takes the older dependents from the front
+    busy.release.set_value();
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(last[0], 10000));
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(last[1], 10000));
+
+    d3.release.set_value();
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(last[2], 10000));
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(sp, 10000));
+    EXPECT_EQ(BsThread::DONE, scheduler.Sync(spBusy, 10000));
+
+    // R and B start concurrently, the dependents follow in a fixed order
+    EXPECT_EQ("312", trace.Order().substr(2));
+    EXPECT_EQ(trace.Worker("R"), trace.Worker("3"));
+    EXPECT_EQ(trace.Worker("B"), trace.Worker("1"));
+    EXPECT_EQ(trace.Worker("B"), trace.Worker("2"));
+
+    scheduler.Close();
+}
+
+namespace
+{
+    std::atomic<unsigned int> executed(0);
+
+    BsThread::State Count(void*, unsigned int)
+    {
+        executed++;
+        return BsThread::DONE;
+    }
+}
+
+TEST(BsThreadScheduler, DISABLED_Throughput)
+{
+    // rows of tiles: every task depends on the task above it and the one above-right,
+    // like CTU rows in wavefront order
+    const unsigned int rows = 64, columns = 32, pictures = 20;
+    unsigned int maxThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        BsThread::Scheduler scheduler;
+        scheduler.Init(threads, rows * columns + 1);
+        executed = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int p = 0; p < pictures; p++)
+        {
+            std::vector<BsThread::SyncPoint> sp(rows * columns);
+
+            for (unsigned int r = 0; r < rows; r++)
+            {
+                for (unsigned int c = 0; c < columns; c++)
+                {
+                    BsThread::SyncPoint dep[2];
+                    unsigned int nDep = 0;
+
+                    if (r)
+                    {
+                        dep[nDep++] = sp[(r - 1) * columns + c];
+                        if (c + 1 < columns)
+                            dep[nDep++] = sp[(r - 1) * columns + c + 1];
+                    }
+
+                    sp[r * columns + c] = scheduler.Submit(Count, nullptr, 0, nDep, dep);
+                }
+            }
+
+            // the rows above are needed by the rows below, sync in submission order
+            for (auto s : sp)
+                ASSERT_EQ(BsThread::DONE, scheduler.Sync(s, 100000, true));
+            for (auto s : sp)
+                scheduler.Sync(s, 0);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(rows * columns * pictures, executed.load());
+        printf("%2u threads: %.0f tasks/s\n", threads, rows * columns * pictures / elapsed.count());
+
+        scheduler.Close();
+    }
+}
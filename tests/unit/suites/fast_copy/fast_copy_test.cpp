@@ -0,0 +1,374 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "fast_copy.h"
+
+struct CopyVariant
+{
+    const char*      name;
+    FastCopyIsa      isa;
+    bool             supported;
+    CopyRowFunc      copy[2];
+    CopyShiftRowFunc toSysShift[2];
+    CopyShiftRowFunc toVideoShift[2];
+};
+
+static std::vector<CopyVariant> SupportedVariants()
+{
+    std::vector<CopyVariant> variants;
+
+    variants.push_back({ "SSE4", FAST_COPY_SSE4, true,
+        { copyVideoToSys_SSE4<false>, copyVideoToSys_SSE4<true> },
+        { copyVideoToSysShift_SSE4<false>, copyVideoToSysShift_SSE4<true> },
+        { copySysToVideoShift_SSE4<false>, copySysToVideoShift_SSE4<true> } });
+    variants.push_back({ "AVX2", FAST_COPY_AVX2, __builtin_cpu_supports("avx2") != 0,
+        { copyVideoToSys_AVX2<false>, copyVideoToSys_AVX2<true> },
+        { copyVideoToSysShift_AVX2<false>, copyVideoToSysShift_AVX2<true> },
+        { copySysToVideoShift_AVX2<false>, copySysToVideoShift_AVX2<true> } });
+    variants.push_back({ "AVX512", FAST_COPY_AVX512, __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"),
+        { copyVideoToSys_AVX512<false>, copyVideoToSys_AVX512<true> },
+        { copyVideoToSysShift_AVX512<false>, copyVideoToSysShift_AVX512<true> },
+        { copySysToVideoShift_AVX512<false>, copySysToVideoShift_AVX512<true> } });
+
+    std::vector<CopyVariant> supported;
+    for (const CopyVariant& v : variants)
+    {
+        if (v.supported)
+            supported.push_back(v);
+    }
+    return supported;
+}
+
+static void PrintTo(const CopyVariant& v, std::ostream* os)
+{
+    *os << v.name;
+}
+
+// 64 byte aligned buffer with a guard zone after the data
+class Buffer
+{
+public:
+    Buffer(size_t size)
+        : m_data(size + 256, 0xcd)
+    {
+        m_base = m_data.data() + ((64 - (reinterpret_cast<size_t>(m_data.data()) & 63)) & 63);
+    }
+
+    mfxU8* At(size_t offset) { return m_base + offset; }
+
+    void Fill(mfxU32 seed)
+    {
+        for (mfxU8* p = m_base; p < m_data.data() + m_data.size(); p++)
+        {
+            seed = seed * 1103515245 + 12345;
+            *p = mfxU8(seed >> 16);
+        }
+    }
+
+private:
+    std::vector<mfxU8> m_data;
+    mfxU8*             m_base;
+};
+
+class FastCopyVariant : public ::testing::TestWithParam<CopyVariant>
+{
+};
+
+TEST_P(FastCopyVariant, CopiesRowsOfAnyAlignmentAndWidth)
+{
+    const CopyVariant& v = GetParam();
+    Buffer src(1024), dst(1024), ref(1024);
+    src.Fill(1);
+
+    for (int stream = 0; stream < 2; stream++)
+    {
+        for (int srcOffset = 0; srcOffset < 64; srcOffset += 3)
+        {
+            // streaming variants require the same alignment of both rows
+            int dstOffset = stream ? srcOffset : (srcOffset * 7) & 63;
+
+            for (int width = 0; width < 700; width += 13)
+            {
+                dst.Fill(2);
+                ref.Fill(2);
+                memcpy(ref.At(dstOffset), src.At(srcOffset), width);
+
+                v.copy[stream](src.At(srcOffset), dst.At(dstOffset), width);
+
+                ASSERT_EQ(0, memcmp(ref.At(0), dst.At(0), 1024 + 128))
+                    << "stream " << stream << " src offset " << srcOffset << " width " << width;
+            }
+        }
+    }
+}
+
+TEST_P(FastCopyVariant, ShiftsRowsOfAnyAlignmentAndWidth)
+{
+    const CopyVariant& v = GetParam();
+    Buffer src(2048), dst(2048), ref(2048);
+    src.Fill(3);
+
+    for (int stream = 0; stream < 2; stream++)
+    {
+        for (int srcOffset = 0; srcOffset < 64; srcOffset += 2)
+        {
+            int dstOffset = stream ? srcOffset : (srcOffset * 5) & 63;
+
+            for (int width = 0; width < 700; width += 11)
+            {
+                for (int shift = 0; shift < 16; shift += 6)
+                {
+                    const mfxU16* s = (const mfxU16*)src.At(srcOffset);
+
+                    dst.Fill(4);
+                    ref.Fill(4);
+                    mfxU16* r = (mfxU16*)ref.At(dstOffset);
+                    for (int i = 0; i < width; i++)
+                        r[i] = s[i] >> shift;
+
+                    v.toSysShift[stream](s, (mfxU16*)dst.At(dstOffset), width, shift);
+
+                    ASSERT_EQ(0, memcmp(ref.At(0), dst.At(0), 2048 + 128))
+                        << "right stream " << stream << " src offset " << srcOffset << " width " << width << " shift " << shift;
+
+                    dst.Fill(4);
+                    ref.Fill(4);
+                    for (int i = 0; i < width; i++)
+                        r[i] = mfxU16(s[i] << shift);
+
+                    v.toVideoShift[stream](s, (mfxU16*)dst.At(dstOffset), width, shift);
+
+                    ASSERT_EQ(0, memcmp(ref.At(0), dst.At(0), 2048 + 128))
+                        << "left stream " << stream << " src offset " << srcOffset << " width " << width << " shift " << shift;
+                }
+            }
+        }
+    }
+}
+
+// the dispatcher limited to the variant's ISA picks its kernels
+TEST_P(FastCopyVariant, IsPickedByDispatcher)
+{
+    const CopyVariant& v = GetParam();
+    FastCopyDispatcher dispatcher(v.isa);
+
+    EXPECT_EQ(v.isa, dispatcher.Isa);
+    for (int stream = 0; stream < 2; stream++)
+    {
+        EXPECT_EQ(v.copy[stream], dispatcher.VideoToSys[stream]);
+        EXPECT_EQ(v.toSysShift[stream], dispatcher.VideoToSysShift[stream]);
+        EXPECT_EQ(v.toVideoShift[stream], dispatcher.SysToVideoShift[stream]);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Isa, FastCopyVariant, ::testing::ValuesIn(SupportedVariants()),
+    [](const ::testing::TestParamInfo<CopyVariant>& info) { return std::string(info.param.name); });
+
+TEST(FastCopy, PicksWidestSupportedKernels)
+{
+    EXPECT_EQ(SupportedVariants().back().isa, FastCopyDispatcher::Get().Isa);
+}
+
+// frames large enough to be copied with streaming stores, pitches differ from
+// the width
+TEST(FastCopy, CopiesLargePlane)
+{
+    mfxSize roi = { 3840 + 7, 2160 };
+    mfxU32 srcPitch = 4096, dstPitch = 3904;
+    Buffer src(srcPitch * roi.height), dst(dstPitch * roi.height);
+    src.Fill(5);
+    dst.Fill(6);
+
+    ASSERT_EQ(MFX_ERR_NONE, FastCopy::Copy(dst.At(0), dstPitch, src.At(0), srcPitch, roi, COPY_VIDEO_TO_SYS));
+
+    for (int y = 0; y < roi.height; y++)
+        ASSERT_EQ(0, memcmp(src.At(y * srcPitch), dst.At(y * dstPitch), roi.width)) << "row " << y;
+}
+
+TEST(FastCopy, ShiftsLargePlane)
+{
+    mfxSize roi = { 3840, 2160 };
+    mfxU32 pitch = 3840 * 2 + 128;
+    Buffer src(pitch * roi.height), dst(pitch * roi.height);
+    src.Fill(7);
+
+    ASSERT_EQ(MFX_ERR_NONE, FastCopy::CopyAndShift((mfxU16*)dst.At(0), pitch, (mfxU16*)src.At(0), pitch, roi, 6, 6, COPY_VIDEO_TO_SYS));
+
+    for (int y = 0; y < roi.height; y++)
+    {
+        const mfxU16* s = (const mfxU16*)src.At(y * pitch);
+        const mfxU16* d = (const mfxU16*)dst.At(y * pitch);
+        for (int x = 0; x < roi.width; x++)
+            ASSERT_EQ(s[x] >> 6, d[x]) << "row " << y << " column " << x;
+    }
+
+    ASSERT_EQ(MFX_ERR_NONE, FastCopy::CopyAndShift((mfxU16*)dst.At(0), pitch, (mfxU16*)src.At(0), pitch, roi, 6, 6, COPY_SYS_TO_VIDEO));
+
+    for (int y = 0; y < roi.height; y++)
+    {
+        const mfxU16* s = (const mfxU16*)src.At(y * pitch);
+        const mfxU16* d = (const mfxU16*)dst.At(y * pitch);
+        for (int x = 0; x < roi.width; x++)
+            ASSERT_EQ(mfxU16(s[x] << 6), d[x]) << "row " << y << " column " << x;
+    }
+}
+
+// the plane is split into bands copied by the threads of the pool, each row
+// is copied once whatever the number of bands
+TEST(FastCopy, CopiesLargePlaneInBands)
+{
+    for (int threads = 0; threads < FAST_COPY_MAX_BANDS; threads++)
+    {
+        FastCopyBands bands(threads);
+        mfxSize roi = { 2048 + 5, 2048 + 3 };
+        mfxU32 srcPitch = 2112, dstPitch = 2176;
+        Buffer src(srcPitch * roi.height), dst(dstPitch * roi.height);
+        src.Fill(10 + threads);
+        dst.Fill(11);
+
+        ASSERT_EQ(MFX_ERR_NONE, FastCopy::Copy(dst.At(0), dstPitch, src.At(0), srcPitch, roi, COPY_VIDEO_TO_SYS, bands));
+
+        for (int y = 0; y < roi.height; y++)
+            ASSERT_EQ(0, memcmp(src.At(y * srcPitch), dst.At(y * dstPitch), roi.width)) << "threads " << threads << " row " << y;
+
+        mfxSize roi16 = { 1024, roi.height };
+        ASSERT_EQ(MFX_ERR_NONE, FastCopy::CopyAndShift((mfxU16*)dst.At(0), dstPitch, (mfxU16*)src.At(0), srcPitch, roi16, 2, 2, COPY_SYS_TO_VIDEO, bands));
+
+        for (int y = 0; y < roi.height; y++)
+        {
+            const mfxU16* s = (const mfxU16*)src.At(y * srcPitch);
+            const mfxU16* d = (const mfxU16*)dst.At(y * dstPitch);
+            for (int x = 0; x < roi16.width; x++)
+                ASSERT_EQ(mfxU16(s[x] << 2), d[x]) << "threads " << threads << " row " << y << " column " << x;
+        }
+    }
+}
+
+// a caller which finds the pool busy copies its plane alone
+TEST(FastCopy, RunsBandsOfConcurrentCallers)
+{
+    FastCopyBands bands(2);
+    const int callers = 4, rows = FAST_COPY_MIN_BAND_ROWS * 8;
+    std::vector<std::vector<int>> copied(callers, std::vector<int>(rows));
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < callers; c++)
+    {
+        threads.emplace_back([&, c]()
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                bands.Run(rows, [&](int first, int count)
+                {
+                    for (int y = first; y < first + count; y++)
+                        copied[c][y]++;
+                });
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int c = 0; c < callers; c++)
+        for (int y = 0; y < rows; y++)
+            ASSERT_EQ(100, copied[c][y]) << "caller " << c << " row " << y;
+}
+
+// Throughput of the row kernels and of FastCopy for NV12 frames, run with
+// --gtest_also_run_disabled_tests
+TEST(FastCopyBenchmark, DISABLED_Throughput)
+{
+    struct { const char* name; int width, height; } sizes[] =
+    {
+        { "1080p", 1920, 1080 },
+        { "4K",    3840, 2160 },
+        { "8K",    7680, 4320 },
+    };
+
+    for (auto& size : sizes)
+    {
+        mfxU32 pitch = (size.width * 2 + 63) & ~63;
+        int height = size.height * 3 / 2;
+        Buffer src(pitch * height), dst(pitch * height);
+        src.Fill(8);
+        dst.Fill(9);
+
+        int repeat = std::max(4, 2000000000 / (size.width * height));
+        double bytes = double(size.width) * height * repeat;
+
+        auto measure = [&](const char* name, const std::function<void()>& copyFrame)
+        {
+            copyFrame();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeat; i++)
+                copyFrame();
+            std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start;
+            printf("%-6s %-32s %8.2f GB/s\n", size.name, name, bytes / sec.count() / 1e9);
+        };
+
+        for (const CopyVariant& v : SupportedVariants())
+        {
+            for (int stream = 0; stream < 2; stream++)
+            {
+                std::string name = std::string(v.name) + (stream ? " stream" : "");
+                measure(name.c_str(), [&]()
+                {
+                    for (int y = 0; y < height; y++)
+                        v.copy[stream](src.At(y * pitch), dst.At(y * pitch), size.width);
+                    _mm_sfence();
+                });
+
+                name = std::string(v.name) + (stream ? " shift stream" : " shift");
+                measure(name.c_str(), [&]()
+                {
+                    for (int y = 0; y < height; y++)
+                        v.toSysShift[stream]((const mfxU16*)src.At(y * pitch), (mfxU16*)dst.At(y * pitch), size.width / 2, 6);
+                    _mm_sfence();
+                });
+            }
+        }
+
+        // planes below FAST_COPY_LARGE_PLANE are copied in one band
+        for (int threads = 0; threads < FAST_COPY_MAX_BANDS; threads++)
+        {
+            FastCopyBands bands(threads);
+            std::string suffix = " " + std::to_string(threads + 1) + " band(s)";
+
+            mfxSize roi = { size.width, height };
+            measure(("FastCopy::Copy" + suffix).c_str(), [&]()
+            {
+                FastCopy::Copy(dst.At(0), pitch, src.At(0), pitch, roi, COPY_VIDEO_TO_SYS, bands);
+            });
+
+            mfxSize roi16 = { size.width / 2, height };
+            measure(("FastCopy::Shift" + suffix).c_str(), [&]()
+            {
+                FastCopy::CopyAndShift((mfxU16*)dst.At(0), pitch, (mfxU16*)src.At(0), pitch, roi16, 6, 6, COPY_VIDEO_TO_SYS, bands);
+            });
+        }
+    }
+}
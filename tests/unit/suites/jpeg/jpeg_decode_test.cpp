@@ -0,0 +1,260 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "umc_defs.h"
+#include "jpegdec.h"
+#include "jpegenc.h"
+#include "jpegkernels.h"
+#include "membuffout.h"
+
+namespace
+{
+    const int WIDTH  = 200;
+    const int HEIGHT = 120;
+
+    struct Picture
+    {
+        Picture(int width, int height)
+            : size{width, height}
+            , luma(width * height)
+            , chroma(width * height / 2)
+        {}
+
+        mfxSize              size;
+        std::vector<uint8_t> luma;
+        std::vector<uint8_t> chroma;
+    };
+
+    // gradients with some detail, so that every MCU row has AC coefficients
+    std::vector<uint8_t> MakePlane(int width, int height, int seed)
+    {
+        std::vector<uint8_t> plane(width * height);
+
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+                plane[y * width + x] = (uint8_t)((x * 3 + y * 2 + seed) ^ ((x * y + seed) >> 3));
+
+        return plane;
+    }
+
+    std::vector<uint8_t> Encode(int restartInterval)
+    {
+        std::vector<uint8_t> y = MakePlane(WIDTH, HEIGHT, 0);
+        std::vector<uint8_t> u = MakePlane(WIDTH / 2, HEIGHT / 2, 64);
+        std::vector<uint8_t> v = MakePlane(WIDTH / 2, HEIGHT / 2, 128);
+        std::vector<uint8_t> bitstream(WIDTH * HEIGHT * 4);
+
+        uint8_t *pSrc[4] = { y.data(), u.data(), v.data(), nullptr };
+        int srcStep[4]   = { WIDTH, WIDTH / 2, WIDTH / 2, 0 };
+        mfxSize srcSize  = { WIDTH, HEIGHT };
+
+        CJPEGEncoder encoder;
+        CMemBuffOutput streamOut;
+
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultQuantTable(75));
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultACTable());
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultDCTable());
+        EXPECT_EQ(JPEG_OK, streamOut.Open(bitstream.data(), (int)bitstream.size()));
+        EXPECT_EQ(JPEG_OK, encoder.SetDestination(&streamOut));
+        EXPECT_EQ(JPEG_OK, encoder.SetSource(pSrc, srcStep, srcSize, 3, JC_YCBCR, JS_420, 8));
+        EXPECT_EQ(JPEG_OK, encoder.SetParams(JPEG_BASELINE, JC_YCBCR, JS_420, restartInterval, 1, 1, 0, 0, 0, 0, 75));
+        EXPECT_EQ(JPEG_OK, encoder.WriteHeader());
+        EXPECT_EQ(JPEG_OK, encoder.WriteData());
+
+        bitstream.resize(streamOut.GetPosition());
+
+        return bitstream;
+    }
+
+    // numHelpers threads call ProcessPipelinedRows() again and again like the
+    // scheduler does with calls returning MFX_TASK_WORKING
+    Picture Decode(const std::vector<uint8_t> &bitstream, int pipelineThreads, int numHelpers)
+    {
+        Picture picture(WIDTH, HEIGHT);
+        CJPEGDecoder decoder;
+        int width, height, channels, precision;
+        JCOLOR color;
+        JSS sampling;
+
+        decoder.SetPipelineThreads(pipelineThreads);
+
+        EXPECT_EQ(JPEG_OK, decoder.SetSource(bitstream.data(), bitstream.size()));
+        EXPECT_EQ(JPEG_OK, decoder.ReadHeader(&width, &height, &channels, &color, &sampling, &precision));
+        EXPECT_EQ(WIDTH, width);
+        EXPECT_EQ(HEIGHT, height);
+
+        uint8_t *pDst[4] = { picture.luma.data(), picture.chroma.data(), nullptr, nullptr };
+        int dstStep[4]   = { WIDTH, WIDTH, 0, 0 };
+
+        EXPECT_EQ(JPEG_OK, decoder.SetDestination(pDst, dstStep, picture.size, 3, JC_NV12, JS_420));
+
+        decoder.StartPipeline();
+
+        std::atomic<int> calls(0);
+        std::vector<std::thread> helpers;
+        for (int i = 1; i <= numHelpers; i++)
+        {
+            helpers.emplace_back([&decoder, &calls, i]()
+            {
+                do
+                {
+                    calls++;
+                    std::this_thread::yield();
+                } while (decoder.ProcessPipelinedRows(i) >= 0);
+            });
+        }
+
+        EXPECT_EQ(JPEG_OK, decoder.ReadData());
+        decoder.FinishPipeline();
+
+        for (auto &helper : helpers)
+            helper.join();
+
+        EXPECT_LE(numHelpers, calls.load());
+
+        return picture;
+    }
+}
+
+TEST(JpegDecodePipeline, DecodesSameOutputAsSequentialDecoding)
+{
+    std::vector<uint8_t> bitstream = Encode(0);
+    Picture reference = Decode(bitstream, 1, 0);
+    std::vector<uint8_t> source = MakePlane(WIDTH, HEIGHT, 0);
+
+    // the reference is the encoded picture
+    int sad = 0;
+    for (size_t i = 0; i < source.size(); i++)
+        sad += std::abs(source[i] - reference.luma[i]);
+    EXPECT_GT(16 * (int)source.size(), sad);
+
+    for (int helpers = 0; helpers < 4; helpers++)
+    {
+        Picture picture = Decode(bitstream, 4, helpers);
+
+        EXPECT_EQ(reference.luma, picture.luma) << "helpers " << helpers;
+        EXPECT_EQ(reference.chroma, picture.chroma) << "helpers " << helpers;
+    }
+}
+
+TEST(JpegDecodePipeline, DecodesChromaOfNV12)
+{
+    Picture picture = Decode(Encode(0), 1, 0);
+    std::vector<uint8_t> u = MakePlane(WIDTH / 2, HEIGHT / 2, 64);
+    std::vector<uint8_t> v = MakePlane(WIDTH / 2, HEIGHT / 2, 128);
+
+    // 420 chroma is interleaved without resampling
+    int sad = 0;
+    for (size_t i = 0; i < u.size(); i++)
+    {
+        sad += std::abs(u[i] - picture.chroma[2 * i]);
+        sad += std::abs(v[i] - picture.chroma[2 * i + 1]);
+    }
+    EXPECT_GT(16 * 2 * (int)u.size(), sad);
+}
+
+TEST(JpegDecodePipeline, DecodesRestartIntervalsWithoutPipeline)
+{
+    std::vector<uint8_t> bitstream = Encode(4);
+    Picture reference = Decode(bitstream, 1, 0);
+    Picture picture = Decode(bitstream, 4, 3);
+
+    EXPECT_EQ(reference.luma, picture.luma);
+    EXPECT_EQ(reference.chroma, picture.chroma);
+}
+
+TEST(JpegDecodePipeline, HelpersReturnWhileNoRowIsReady)
+{
+    CJPEGDecoder decoder;
+
+    decoder.SetPipelineThreads(4);
+    decoder.StartPipeline();
+
+    // the picture is not started, the helpers reconstruct nothing and
+    // are called again
+    EXPECT_EQ(0, decoder.ProcessPipelinedRows(1));
+    EXPECT_EQ(0, decoder.ProcessPipelinedRows(3));
+
+    // the buffers of thread 0 and beyond the pipeline are never used
+    EXPECT_EQ(-1, decoder.ProcessPipelinedRows(0));
+    EXPECT_EQ(-1, decoder.ProcessPipelinedRows(4));
+
+    decoder.FinishPipeline();
+
+    EXPECT_EQ(-1, decoder.ProcessPipelinedRows(1));
+}
+
+TEST(JpegDecodePipeline, DISABLED_DecodesMCURowsPerSecond)
+{
+    const int FRAMES = 500;
+    const int MCU_ROWS = (HEIGHT + 15) / 16;
+    const JPEGKernelsLevel levels[] = { JPEG_KERNELS_C, JPEG_KERNELS_SSE4, JPEG_KERNELS_AVX2 };
+    const char *levelNames[] = { "C", "SSE4", "AVX2" };
+    std::vector<uint8_t> bitstream = Encode(0);
+    std::vector<uint8_t> frame(WIDTH * HEIGHT * 4);
+
+    for (JPEGKernelsLevel level : levels)
+    {
+        if (JPEG_SetKernelsLevel(level) != level)
+            continue;
+
+        for (JCOLOR color : { JC_NV12, JC_BGRA })
+        {
+            uint8_t *pDst[4] = { frame.data(), nullptr, nullptr, nullptr };
+            int dstStep[4]   = { WIDTH * 4, 0, 0, 0 };
+            mfxSize dstSize  = { WIDTH, HEIGHT };
+
+            if (JC_NV12 == color)
+            {
+                pDst[1] = frame.data() + WIDTH * HEIGHT;
+                dstStep[0] = dstStep[1] = WIDTH;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < FRAMES; i++)
+            {
+                CJPEGDecoder decoder;
+                int width, height, channels, precision;
+                JCOLOR jpegColor;
+                JSS sampling;
+
+                ASSERT_EQ(JPEG_OK, decoder.SetSource(bitstream.data(), bitstream.size()));
+                ASSERT_EQ(JPEG_OK, decoder.ReadHeader(&width, &height, &channels, &jpegColor, &sampling, &precision));
+                ASSERT_EQ(JPEG_OK, decoder.SetDestination(pDst, dstStep, dstSize, (JC_NV12 == color) ? 3 : 4, color, (JC_NV12 == color) ? JS_420 : JS_444));
+                ASSERT_EQ(JPEG_OK, decoder.ReadData());
+            }
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            printf("%-4s %-4s: %.0f MCU rows/s\n", levelNames[level], (JC_NV12 == color) ? "NV12" : "BGRA",
+                FRAMES * MCU_ROWS / elapsed.count());
+        }
+    }
+
+    JPEG_SetKernelsLevel(JPEG_KERNELS_AVX2);
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "umc_defs.h"
+#include "jpegenc.h"
+#include "membuffout.h"
+
+namespace
+{
+    const int WIDTH  = 232;
+    const int HEIGHT = 136;
+
+    // gradients with some detail, so that every MCU row has AC coefficients
+    std::vector<uint8_t> MakePlane(int width, int height, int seed)
+    {
+        std::vector<uint8_t> plane(width * height);
+
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+                plane[y * width + x] = (uint8_t)((x * 5 + y * 3 + seed) ^ ((x * y + seed) >> 4));
+
+        return plane;
+    }
+
+    // numHelpers threads call ProcessPipelinedRows() again and again like the
+    // scheduler does with calls returning MFX_TASK_WORKING
+    std::vector<uint8_t> Encode(int restartInterval, int pipelineThreads, int numHelpers)
+    {
+        std::vector<uint8_t> y = MakePlane(WIDTH, HEIGHT, 0);
+        std::vector<uint8_t> u = MakePlane(WIDTH / 2, HEIGHT / 2, 64);
+        std::vector<uint8_t> v = MakePlane(WIDTH / 2, HEIGHT / 2, 128);
+        std::vector<uint8_t> bitstream(WIDTH * HEIGHT * 4);
+
+        uint8_t *pSrc[4] = { y.data(), u.data(), v.data(), nullptr };
+        int srcStep[4]   = { WIDTH, WIDTH / 2, WIDTH / 2, 0 };
+        mfxSize srcSize  = { WIDTH, HEIGHT };
+
+        CJPEGEncoder encoder;
+        CMemBuffOutput streamOut;
+
+        encoder.SetPipelineThreads(pipelineThreads);
+
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultQuantTable(75));
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultACTable());
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultDCTable());
+        EXPECT_EQ(JPEG_OK, streamOut.Open(bitstream.data(), (int)bitstream.size()));
+        EXPECT_EQ(JPEG_OK, encoder.SetDestination(&streamOut));
+        EXPECT_EQ(JPEG_OK, encoder.SetSource(pSrc, srcStep, srcSize, 3, JC_YCBCR, JS_420, 8));
+        EXPECT_EQ(JPEG_OK, encoder.SetParams(JPEG_BASELINE, JC_YCBCR, JS_420, restartInterval, 1, 1, 0, 0, 0, 0, 75));
+
+        encoder.StartPipeline();
+
+        std::atomic<int> calls(0);
+        std::vector<std::thread> helpers;
+        for (int i = 1; i <= numHelpers; i++)
+        {
+            helpers.emplace_back([&encoder, &calls, i]()
+            {
+                do
+                {
+                    calls++;
+                    std::this_thread::yield();
+                } while (encoder.ProcessPipelinedRows(i) >= 0);
+            });
+        }
+
+        EXPECT_EQ(JPEG_OK, encoder.WriteHeader());
+        EXPECT_EQ(JPEG_OK, encoder.WriteData());
+        encoder.FinishPipeline();
+
+        for (auto &helper : helpers)
+            helper.join();
+
+        EXPECT_LE(numHelpers, calls.load());
+
+        bitstream.resize(streamOut.GetPosition());
+
+        return bitstream;
+    }
+
+    // optimal Huffman tables generated in one or two passes
+    std::vector<uint8_t> EncodeOptimal(JCOLOR color, JSS sampling, int width, int height, bool singlePass)
+    {
+        int chromaWidth  = (JS_420 == sampling) ? (width + 1) / 2 : width;
+        int chromaHeight = (JS_420 == sampling) ? (height + 1) / 2 : height;
+        int channels     = (JC_GRAY == color) ? 1 : 3;
+        std::vector<uint8_t> y = MakePlane(width, height, 0);
+        std::vector<uint8_t> u = MakePlane(chromaWidth, chromaHeight, 64);
+        std::vector<uint8_t> v = MakePlane(chromaWidth, chromaHeight, 128);
+        std::vector<uint8_t> bitstream(width * height * 4);
+
+        uint8_t *pSrc[4] = { y.data(), u.data(), v.data(), nullptr };
+        int srcStep[4]   = { width, chromaWidth, chromaWidth, 0 };
+        mfxSize srcSize  = { width, height };
+
+        CJPEGEncoder encoder;
+        CMemBuffOutput streamOut;
+
+        encoder.SetHuffmanSinglePass(singlePass);
+
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultQuantTable(75));
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultACTable());
+        EXPECT_EQ(JPEG_OK, encoder.SetDefaultDCTable());
+        EXPECT_EQ(JPEG_OK, streamOut.Open(bitstream.data(), (int)bitstream.size()));
+        EXPECT_EQ(JPEG_OK, encoder.SetDestination(&streamOut));
+        EXPECT_EQ(JPEG_OK, encoder.SetSource(pSrc, srcStep, srcSize, channels, color, sampling, 8));
+        EXPECT_EQ(JPEG_OK, encoder.SetParams(JPEG_BASELINE, color, sampling, 0, 1, 1, 0, 0, 0, 1, 75));
+        EXPECT_EQ(JPEG_OK, encoder.WriteHeader());
+        EXPECT_EQ(JPEG_OK, encoder.WriteData());
+
+        bitstream.resize(streamOut.GetPosition());
+
+        return bitstream;
+    }
+}
+
+TEST(JpegEncodePipeline, EncodesSameBitstreamAsSequentialEncoding)
+{
+    std::vector<uint8_t> reference = Encode(0, 1, 0);
+    ASSERT_LT(1000u, reference.size());
+
+    for (int helpers = 0; helpers < 4; helpers++)
+    {
+        EXPECT_EQ(reference, Encode(0, 4, helpers)) << "helpers " << helpers;
+    }
+}
+
+TEST(JpegEncodePipeline, EncodesRestartIntervalsWithoutPipeline)
+{
+    std::vector<uint8_t> reference = Encode(4, 1, 0);
+
+    EXPECT_EQ(reference, Encode(4, 4, 3));
+}
+
+TEST(JpegEncodePipeline, HelpersReturnWhileNoRowIsAvailable)
+{
+    CJPEGEncoder encoder;
+
+    encoder.SetPipelineThreads(4);
+    encoder.StartPipeline();
+
+    // the picture is not started, the helpers transform nothing and
+    // are called again
+    EXPECT_EQ(0, encoder.ProcessPipelinedRows(1));
+    EXPECT_EQ(0, encoder.ProcessPipelinedRows(3));
+
+    // the buffers of thread 0 and beyond the pipeline are never used
+    EXPECT_EQ(-1, encoder.ProcessPipelinedRows(0));
+    EXPECT_EQ(-1, encoder.ProcessPipelinedRows(4));
+
+    encoder.FinishPipeline();
+
+    EXPECT_EQ(-1, encoder.ProcessPipelinedRows(1));
+}
+
+TEST(JpegEncodeHuffman, SinglePassEncodesSameBitstreamAsTwoPasses)
+{
+    struct
+    {
+        JCOLOR color;
+        JSS    sampling;
+    } const formats[] = {
+        { JC_YCBCR, JS_444 },
+        { JC_YCBCR, JS_420 },
+        { JC_GRAY,  JS_444 },
+    };
+
+    // sizes being no multiple of the MCU pad the last row and column
+    for (auto &format : formats)
+    {
+        std::vector<uint8_t> reference = EncodeOptimal(format.color, format.sampling, WIDTH + 1, HEIGHT + 3, false);
+        ASSERT_LT(1000u, reference.size());
+
+        EXPECT_EQ(reference, EncodeOptimal(format.color, format.sampling, WIDTH + 1, HEIGHT + 3, true))
+            << "color " << format.color << " sampling " << format.sampling;
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "umc_defs.h"
+#include "ippj.h"
+#include "jpegkernels.h"
+
+namespace
+{
+    // kernel levels the CPU runs, the reference for each of them is IPP or
+    // the C level
+    std::vector<JPEGKernelsLevel> SupportedLevels()
+    {
+        std::vector<JPEGKernelsLevel> levels;
+
+        for (JPEGKernelsLevel level : { JPEG_KERNELS_C, JPEG_KERNELS_SSE4, JPEG_KERNELS_AVX2 })
+            if (JPEG_SetKernelsLevel(level) == level)
+                levels.push_back(level);
+
+        JPEG_SetKernelsLevel(JPEG_KERNELS_AVX2);
+        return levels;
+    }
+
+    std::string LevelName(const ::testing::TestParamInfo<JPEGKernelsLevel>& info)
+    {
+        return info.param == JPEG_KERNELS_AVX2 ? "AVX2" : (info.param == JPEG_KERNELS_SSE4 ? "SSE4" : "C");
+    }
+
+    class JpegKernels : public ::testing::TestWithParam<JPEGKernelsLevel>
+    {
+    protected:
+        void SetUp() override
+        {
+            JPEG_SetKernelsLevel(GetParam());
+        }
+
+        void TearDown() override
+        {
+            JPEG_SetKernelsLevel(JPEG_KERNELS_AVX2);
+        }
+
+        std::vector<uint8_t> Random8u(size_t size)
+        {
+            std::uniform_int_distribution<int> dist(0, 255);
+            std::vector<uint8_t> v(size);
+
+            for (auto& x : v)
+                x = (uint8_t)dist(rng);
+
+            return v;
+        }
+
+        std::mt19937 rng{ 2019 };
+    };
+}
+
+TEST_P(JpegKernels, InverseDCTMatchesIPP)
+{
+    const int dstStep = 4 * 8 + 5;
+    std::uniform_int_distribution<int> coeff(-256, 255);
+    std::uniform_int_distribution<int> quant(1, 64);
+
+    for (int numBlocks = 1; numBlocks <= 4; numBlocks++)
+    {
+        for (int iter = 0; iter < 200; iter++)
+        {
+            std::vector<int16_t>  src(64 * numBlocks);
+            std::vector<uint16_t> qtbl(64);
+            std::vector<uint8_t>  expected(8 * dstStep, 0x55), actual(8 * dstStep, 0x55);
+
+            for (auto& x : src)  x = (int16_t)coeff(rng);
+            for (auto& x : qtbl) x = (uint16_t)quant(rng);
+
+            for (int n = 0; n < numBlocks; n++)
+                ASSERT_EQ(ippStsNoErr, mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R(src.data() + 64 * n, expected.data() + 8 * n, dstStep, qtbl.data()));
+
+            ASSERT_EQ(ippStsNoErr, JPEG_DCTQuantInv8x8LS_16s8u_C1R(src.data(), actual.data(), dstStep, qtbl.data(), numBlocks));
+            ASSERT_EQ(expected, actual) << "blocks " << numBlocks << " iteration " << iter;
+        }
+    }
+}
+
+TEST_P(JpegKernels, ForwardDCTMatchesIPP)
+{
+    const int srcStep = 4 * 8 + 3;
+    std::uniform_int_distribution<int> quant(1, 255);
+
+    for (int numBlocks = 1; numBlocks <= 4; numBlocks++)
+    {
+        for (int iter = 0; iter < 200; iter++)
+        {
+            // flat blocks hit the saturation and rounding corners
+            std::vector<uint8_t>  src = (iter % 10) ? Random8u(8 * srcStep) : std::vector<uint8_t>(8 * srcStep, (uint8_t)(iter * 25));
+            std::vector<uint8_t>  raw(64);
+            std::vector<uint16_t> qtbl(64);
+            std::vector<int16_t>  expected(64 * numBlocks), actual(64 * numBlocks);
+
+            for (auto& x : raw) x = (uint8_t)quant(rng);
+            if (iter % 7 == 0) std::fill(raw.begin(), raw.end(), 1);
+            ASSERT_EQ(ippStsNoErr, mfxiQuantFwdTableInit_JPEG_8u16u(raw.data(), qtbl.data()));
+
+            for (int n = 0; n < numBlocks; n++)
+                ASSERT_EQ(ippStsNoErr, mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R(src.data() + 8 * n, srcStep, expected.data() + 64 * n, qtbl.data()));
+
+            ASSERT_EQ(ippStsNoErr, JPEG_DCTQuantFwd8x8LS_8u16s_C1R(src.data(), srcStep, actual.data(), qtbl.data(), numBlocks));
+            ASSERT_EQ(expected, actual) << "blocks " << numBlocks << " iteration " << iter;
+        }
+    }
+}
+
+TEST_P(JpegKernels, UpsampledColorConversionMatchesIPP)
+{
+    for (int vertical = 0; vertical < 2; vertical++)
+    {
+        for (int chromaWidth = 2; chromaWidth <= 80; chromaWidth++)
+        {
+            for (int width = 2 * chromaWidth - 1; width <= 2 * chromaWidth; width++)
+            {
+                std::vector<uint8_t> y = Random8u(width), cb = Random8u(chromaWidth), cr = Random8u(chromaWidth);
+                std::vector<uint8_t> cbFar = Random8u(chromaWidth), crFar = Random8u(chromaWidth);
+                std::vector<uint8_t> cbUp(2 * chromaWidth), crUp(2 * chromaWidth);
+                std::vector<uint8_t> expected(4 * width), actual(4 * width);
+
+                if (vertical)
+                {
+                    ASSERT_EQ(ippStsNoErr, mfxiSampleUpRowH2V2_Triangle_JPEG_8u_C1(cb.data(), cbFar.data(), chromaWidth, cbUp.data()));
+                    ASSERT_EQ(ippStsNoErr, mfxiSampleUpRowH2V2_Triangle_JPEG_8u_C1(cr.data(), crFar.data(), chromaWidth, crUp.data()));
+                }
+                else
+                {
+                    ASSERT_EQ(ippStsNoErr, mfxiSampleUpRowH2V1_Triangle_JPEG_8u_C1(cb.data(), chromaWidth, cbUp.data()));
+                    ASSERT_EQ(ippStsNoErr, mfxiSampleUpRowH2V1_Triangle_JPEG_8u_C1(cr.data(), chromaWidth, crUp.data()));
+                }
+
+                const Ipp8u* planes[3] = { y.data(), cbUp.data(), crUp.data() };
+                IppiSize     roi       = { width, 1 };
+                ASSERT_EQ(ippStsNoErr, mfxiYCbCrToBGR_JPEG_8u_P3C4R(planes, 2 * chromaWidth, expected.data(), 4 * width, roi, 0xFF));
+
+                JPEG_YCbCrH2ToBGRA_8u_Row(y.data(), cb.data(), cr.data(),
+                                          vertical ? cbFar.data() : nullptr, vertical ? crFar.data() : nullptr,
+                                          chromaWidth, actual.data(), width);
+                ASSERT_EQ(expected, actual) << "vertical " << vertical << " chroma width " << chromaWidth << " width " << width;
+            }
+        }
+    }
+}
+
+TEST_P(JpegKernels, PixelPackingMatchesC)
+{
+    const JPEGKernelsLevel level = GetParam();
+
+    for (int width = 1; width <= 100; width += 11)
+    {
+        const mfxSize roi = { width, 3 };
+        const int     step = width + 7;
+        std::vector<uint8_t> r = Random8u(3 * step), g = Random8u(3 * step), b = Random8u(3 * step);
+        std::vector<uint8_t> bgra = Random8u(3 * 4 * step);
+
+        std::vector<uint8_t> expected[4], actual[4];
+        for (int i = 0; i < 4; i++)
+        {
+            expected[i].assign(3 * 4 * step, 0);
+            actual[i].assign(3 * 4 * step, 0);
+        }
+
+        const uint8_t* rgb[3] = { r.data(), g.data(), b.data() };
+        uint8_t* planesExpected[3] = { expected[3].data(), expected[3].data() + step, expected[3].data() + 2 * step };
+        uint8_t* planesActual[3]   = { actual[3].data(),   actual[3].data() + step,   actual[3].data() + 2 * step };
+
+        JPEG_SetKernelsLevel(JPEG_KERNELS_C);
+        JPEG_InterleaveUV_8u(r.data(), step, g.data(), step, expected[0].data(), 2 * step, roi);
+        JPEG_GrayToBGRA_8u(r.data(), step, expected[1].data(), 4 * step, roi);
+        JPEG_RGBToBGRA_8u_P3C4R(rgb, step, expected[2].data(), 4 * step, roi);
+        JPEG_BGRAToRGB_8u_C4P3R(bgra.data(), 4 * step, planesExpected, 3 * step, { width, 1 });
+
+        JPEG_SetKernelsLevel(level);
+        JPEG_InterleaveUV_8u(r.data(), step, g.data(), step, actual[0].data(), 2 * step, roi);
+        JPEG_GrayToBGRA_8u(r.data(), step, actual[1].data(), 4 * step, roi);
+        JPEG_RGBToBGRA_8u_P3C4R(rgb, step, actual[2].data(), 4 * step, roi);
+        JPEG_BGRAToRGB_8u_C4P3R(bgra.data(), 4 * step, planesActual, 3 * step, { width, 1 });
+
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(expected[i], actual[i]) << "kernel " << i << " width " << width;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Isa, JpegKernels, ::testing::ValuesIn(SupportedLevels()), LevelName);
@@ -25,6 +25,7 @@
 #include <gmock/gmock.h>
 #include <mfxvideo.h>
 #include <algorithm>
+#include <chrono>
 #include <type_traits>
 #include "mfx_dispatch_test_mocks.h"
 
@@ -274,19 +275,238 @@ TEST_F(DispatcherLibsTest, ShouldSucceedIfFirstLibBadSecondLibGood)
     sts = MFXClose(session);
     ASSERT_EQ(sts, MFX_ERR_NONE);
 
-    EXPECT_CALL(mock, dlopen).Times(AtLeast(1)).WillRepeatedly(Return(MOCK_DLOPEN_HANDLE));
-    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillOnce(Return(nullptr)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
-    EXPECT_CALL(mock, MFXInitEx).Times(AtLeast(1)).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
-    EXPECT_CALL(mock, MFXQueryIMPL).Times(AtLeast(1)).WillRepeatedly(Return(MFX_ERR_NONE));
-    EXPECT_CALL(mock, MFXQueryVersion).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
-    EXPECT_CALL(mock, dlclose).Times(AtLeast(1));
+    // Use another library handle, otherwise functions table of the library
+    // loaded above is taken from the dispatcher cache.
+    ResetMockCallObj();
+    MockCallObj& mock2 = *g_call_obj_ptr;
+    mock2.emulated_api_version = ver;
+
+    EXPECT_CALL(mock2, dlopen).Times(AtLeast(1)).WillRepeatedly(Return(MOCK_DLOPEN_HANDLE));
+    EXPECT_CALL(mock2, dlsym).Times(AtLeast(1)).WillOnce(Return(nullptr)).WillRepeatedly(Invoke(&mock2, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock2, MFXInitEx).Times(AtLeast(1)).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock2, MFXQueryIMPL).Times(AtLeast(1)).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock2, MFXQueryVersion).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock2, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock2, dlclose).Times(AtLeast(1));
 
     sts = MFXInit(impl, &ver, &session);
     EXPECT_EQ(sts, MFX_ERR_NONE);
 
-    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(1);
+    EXPECT_CALL(mock2, MFXClose(MOCK_SESSION_HANDLE)).Times(1);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+}
+
+
+
+TEST_F(DispatcherLibsTest, ShouldReuseFunctionsTableOfLoadedLib)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    ver = {{MFX_VERSION_MINOR, MFX_VERSION_MAJOR}};
+    mock.emulated_api_version = ver;
+
+    EXPECT_CALL(mock, dlopen).Times(2).WillRepeatedly(Return(MOCK_DLOPEN_HANDLE));
+    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(2).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(2).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(2).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(2);
+
+    mfxStatus sts = MFXInit(impl, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Library is loaded by the first session and the same handle is
+    // returned, so functions should not be resolved once again. The extra
+    // reference taken by dlopen is dropped at once.
+    mfxSession session_new = nullptr;
+
+    EXPECT_CALL(mock, dlsym).Times(0);
+    EXPECT_CALL(mock, dlclose(MOCK_DLOPEN_HANDLE)).Times(1);
+
+    sts = MFXInit(impl, &ver, &session_new);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Sessions share the handle, which stays loaded after the last of them
+    EXPECT_CALL(mock, dlclose(MOCK_DLOPEN_HANDLE)).Times(0);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(session_new);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+}
+
+TEST_F(DispatcherLibsTest, ShouldKeepLibLoadedAfterLastClose)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    ver = {{MFX_VERSION_MINOR, MFX_VERSION_MAJOR}};
+    mock.emulated_api_version = ver;
+
+    EXPECT_CALL(mock, dlopen).Times(2).WillRepeatedly(Return(MOCK_DLOPEN_HANDLE));
+    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(2).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(2).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(2).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(2);
+
+    // The dispatcher keeps the library loaded after the last session
+    EXPECT_CALL(mock, dlclose(MOCK_DLOPEN_HANDLE)).Times(0);
+
+    mfxStatus sts = MFXInit(impl, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Next session gets the same handle and skips functions resolution, the
+    // extra reference taken by dlopen is dropped at once.
+    EXPECT_CALL(mock, dlsym).Times(0);
+    EXPECT_CALL(mock, dlclose(MOCK_DLOPEN_HANDLE)).Times(1);
+
+    sts = MFXInit(impl, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
     sts = MFXClose(session);
     ASSERT_EQ(sts, MFX_ERR_NONE);
 }
 
+TEST_F(DispatcherLibsTest, ShouldReleaseLeastRecentlyUsedLib)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    ver = {{MFX_VERSION_MINOR, MFX_VERSION_MAJOR}};
+    mock.emulated_api_version = ver;
+
+    void* handle_sw = MOCK_DLOPEN_HANDLE;
+    void* handle_hw = (char*)MOCK_DLOPEN_HANDLE + 0x200;
+    void* handle_sw_dir = (char*)MOCK_DLOPEN_HANDLE + 0x300;
+
+    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(3).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(3).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(3).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(3);
+    EXPECT_CALL(mock, dlclose(handle_hw)).Times(0);
+    EXPECT_CALL(mock, dlclose(handle_sw_dir)).Times(0);
+
+    EXPECT_CALL(mock, dlopen).Times(1).WillOnce(Return(handle_sw));
+    mfxStatus sts = MFXInit(MFX_IMPL_SOFTWARE, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
 
+    EXPECT_CALL(mock, dlopen).Times(1).WillOnce(Return(handle_hw));
+    sts = MFXInit(MFX_IMPL_HARDWARE, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Third library loaded releases the least recently initialized one
+    EXPECT_CALL(mock, dlopen).Times(2).WillOnce(Return(nullptr)).WillOnce(Return(handle_sw_dir));
+    EXPECT_CALL(mock, dlclose(handle_sw)).Times(1);
+    sts = MFXInit(MFX_IMPL_SOFTWARE, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+}
+
+TEST_F(DispatcherLibsTest, ShouldFailIfLoadedLibVersionLessThanRequested)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    mock.emulated_api_version = {{28, 1}};
+    ver = {{18, 1}};
+
+    EXPECT_CALL(mock, dlopen).Times(AtLeast(2)).WillRepeatedly(Return(MOCK_DLOPEN_HANDLE));
+    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(AtLeast(2)).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(AtLeast(2)).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(1).WillRepeatedly(Return(MFX_ERR_NONE));
+
+    mfxStatus sts = MFXInit(impl, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Functions table is taken from the cache, but version reported by the
+    // library is still checked against the requested one.
+    mfxVersion ver_new = {{30, 1}};
+    mfxSession session_new = nullptr;
+
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(AtLeast(1));
+    EXPECT_CALL(mock, dlclose).Times(AtLeast(1));
+
+    sts = MFXInit(impl, &ver_new, &session_new);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+}
+
+TEST_F(DispatcherLibsTest, ShouldResolveFunctionsIfLibHandleChanged)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    ver = {{MFX_VERSION_MINOR, MFX_VERSION_MAJOR}};
+    mock.emulated_api_version = ver;
+
+    void* handle = MOCK_DLOPEN_HANDLE;
+    void* handle_new = (char*)MOCK_DLOPEN_HANDLE + 0x100;
+
+    EXPECT_CALL(mock, dlopen).Times(2).WillOnce(Return(handle)).WillOnce(Return(handle_new));
+    EXPECT_CALL(mock, dlsym).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(2).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(2).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(2).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(2);
+
+    mfxStatus sts = MFXInit(impl, &ver, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // Library was reloaded while the first session is open: the functions
+    // are resolved from the new one, each session keeps its own library.
+    mfxSession session_new = nullptr;
+
+    EXPECT_CALL(mock, dlsym(handle_new, _)).Times(AtLeast(1)).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+
+    sts = MFXInit(impl, &ver, &session_new);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // The old library is not kept loaded anymore, the new one is
+    EXPECT_CALL(mock, dlclose(handle)).Times(1);
+    sts = MFXClose(session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_CALL(mock, dlclose(handle_new)).Times(0);
+    sts = MFXClose(session_new);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+}
+
+TEST_F(DispatcherLibsTest, DISABLED_InitCloseThroughput)
+{
+    MockCallObj& mock = *g_call_obj_ptr;
+
+    ver = {{MFX_VERSION_MINOR, MFX_VERSION_MAJOR}};
+    mock.emulated_api_version = ver;
+
+    EXPECT_CALL(mock, dlsym).Times(AnyNumber()).WillRepeatedly(Invoke(&mock, &MockCallObj::EmulateAPI));
+    EXPECT_CALL(mock, MFXInitEx).Times(AnyNumber()).WillRepeatedly(DoAll(SetArgPointee<1>(MOCK_SESSION_HANDLE), Return(MFX_ERR_NONE)));
+    EXPECT_CALL(mock, MFXQueryIMPL).Times(AnyNumber()).WillRepeatedly(Return(MFX_ERR_NONE));
+    EXPECT_CALL(mock, MFXQueryVersion).Times(AnyNumber()).WillRepeatedly(Invoke(&mock, &MockCallObj::ReturnEmulatedVersion));
+    EXPECT_CALL(mock, MFXClose(MOCK_SESSION_HANDLE)).Times(AnyNumber());
+    EXPECT_CALL(mock, dlclose).Times(AnyNumber());
+
+    const int iterations = 20000;
+
+    // Cold: every session gets a library it has not seen, as if the
+    // library were loaded and resolved each time.
+    for (int cold = 1; cold >= 0; --cold)
+    {
+        char* handle = (char*)MOCK_DLOPEN_HANDLE + 0x1000;
+
+        EXPECT_CALL(mock, dlopen).Times(AnyNumber()).WillRepeatedly(Invoke(
+            [&handle, cold](const char*, int) { return cold ? (void*)++handle : (void*)handle; }));
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            ASSERT_EQ(MFX_ERR_NONE, MFXInit(MFX_IMPL_SOFTWARE, &ver, &session));
+            ASSERT_EQ(MFX_ERR_NONE, MFXClose(session));
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        printf("%s: %.2f us per MFXInit + MFXClose\n", cold ? "cold" : "warm", elapsed.count() / iterations);
+    }
+}
@@ -22,6 +22,7 @@
 #include "mfx_dispatch_test_mocks.h"
 
 std::unique_ptr<MockCallObj> g_call_obj_ptr;
+void* g_mock_dlopen_handle = (void*)0x0BADCAFE;
 
 extern "C"
 {
@@ -32,6 +33,9 @@ extern "C"
 
     int dlclose(void* handle)
     {
+        // Libraries kept loaded by the dispatcher are closed at exit
+        if (!g_call_obj_ptr)
+            return 0;
         return g_call_obj_ptr->dlclose(handle);
     }
 
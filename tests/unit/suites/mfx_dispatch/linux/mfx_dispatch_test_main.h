@@ -37,7 +37,9 @@
 #define MFX_PLUGINS_CONF_DIR "ERROR: MFX_PLUGINS_CONF_DIR was not defined!"
 #endif
 
-#define MOCK_DLOPEN_HANDLE (void*)0x0BADCAFE
+// Dispatcher caches functions table of loaded library by its handle, so each
+// test gets its own handle to keep libraries loaded by other tests aside.
+#define MOCK_DLOPEN_HANDLE g_mock_dlopen_handle
 #define MOCK_FUNC_PTR (void*)0xDEADBEEF
 #define MOCK_SESSION_HANDLE (mfxSession)0xFADEBABE
 #define MOCK_FILE_DESCRIPTOR (FILE*) 0x31337FAD
@@ -45,6 +47,7 @@
 
 
 extern std::unique_ptr<MockCallObj> g_call_obj_ptr;
+extern void* g_mock_dlopen_handle;
 
 extern "C"
 {
@@ -62,6 +65,12 @@ extern "C"
 inline void ResetMockCallObj()
 {
     g_call_obj_ptr.reset(new MockCallObj);
+    g_mock_dlopen_handle = (char*)g_mock_dlopen_handle + 1;
+
+    // Dispatcher keeps few recently used libraries loaded, those of earlier
+    // tests may be closed by this one. Expectations of the test come later
+    // and take precedence.
+    EXPECT_CALL(*g_call_obj_ptr, dlclose(_)).Times(AnyNumber());
 }
 
 inline bool operator==(mfxPluginUID lhs, mfxPluginUID rhs)
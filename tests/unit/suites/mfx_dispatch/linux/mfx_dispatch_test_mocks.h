@@ -27,6 +27,7 @@
 
 using ::testing::_;
 using ::testing::AtLeast;
+using ::testing::AnyNumber;
 using ::testing::Matches;
 using ::testing::StrEq;
 using ::testing::Return;
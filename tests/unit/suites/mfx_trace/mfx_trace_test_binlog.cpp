@@ -0,0 +1,301 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "mfx_trace.h"
+#include "mfx_trace_binlog.h"
+
+struct BinLogThread
+{
+    mfxTraceU32 dropped = 0;
+    std::vector<mfxTraceBinLogRecord> records;
+};
+
+struct BinLog
+{
+    mfxTraceBinLogHeader header;
+    std::map<mfxTraceU32, std::string> names;       // id -> task name
+    std::map<mfxTraceU32, BinLogThread> threads;    // tid -> records
+};
+
+static bool ReadBinLog(const std::string& fileName, BinLog& log)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    std::vector<char> data;
+    char buffer[4096];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + read);
+    fclose(file);
+
+    if (data.size() < sizeof(log.header))
+        return false;
+    memcpy(&log.header, data.data(), sizeof(log.header));
+
+    size_t offset = sizeof(log.header);
+    while (offset < data.size())
+    {
+        mfxTraceBinLogChunk chunk;
+        if (data.size() - offset < sizeof(chunk))
+            return false;
+        memcpy(&chunk, &data[offset], sizeof(chunk));
+        offset += sizeof(chunk);
+        if (data.size() - offset < chunk.size)
+            return false;
+
+        const char* payload = &data[offset];
+        offset += chunk.size;
+
+        if (chunk.type == MFX_TRACE_BINLOG_CHUNK_NAME)
+        {
+            mfxTraceBinLogName name;
+            memcpy(&name, payload, sizeof(name));
+            log.names[name.id] = payload + sizeof(name);
+        }
+        else if (chunk.type == MFX_TRACE_BINLOG_CHUNK_EVENTS)
+        {
+            mfxTraceBinLogEvents events;
+            memcpy(&events, payload, sizeof(events));
+
+            BinLogThread& thread = log.threads[events.thread];
+            thread.dropped += events.dropped;
+
+            size_t count = (chunk.size - sizeof(events)) / sizeof(mfxTraceBinLogRecord);
+            size_t first = thread.records.size();
+            thread.records.resize(first + count);
+            memcpy(&thread.records[first], payload + sizeof(events), count * sizeof(mfxTraceBinLogRecord));
+        }
+        else if (chunk.type != MFX_TRACE_BINLOG_CHUNK_CLOCK)
+            return false;
+    }
+    return true;
+}
+
+class BinLogTrace : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char dir[] = "/tmp/mfx_trace_test_XXXXXX";
+        ASSERT_TRUE(mkdtemp(dir));
+        m_dir = dir;
+        m_log = m_dir + "/test.trace";
+
+        const char* home = getenv("HOME");
+        if (home)
+            m_home = home;
+        setenv("HOME", m_dir.c_str(), 1);
+    }
+
+    void TearDown() override
+    {
+        if (!m_home.empty())
+            setenv("HOME", m_home.c_str(), 1);
+        remove((m_dir + "/.mfx_trace").c_str());
+        remove(m_log.c_str());
+        rmdir(m_dir.c_str());
+    }
+
+    void Configure(mfxTraceU32 ringSize)
+    {
+        FILE* conf = fopen((m_dir + "/.mfx_trace").c_str(), "w");
+        ASSERT_TRUE(conf);
+        fprintf(conf, "Output=0x%x\nBinLog=%s\nBinLogRingSize=%u\n", MFX_TRACE_OUTPUT_BINLOG, m_log.c_str(), ringSize);
+        fclose(conf);
+    }
+
+    std::string m_dir;
+    std::string m_log;
+    std::string m_home;
+};
+
+static void Inner()
+{
+    MFX_AUTO_LTRACE_WITHID(MFX_TRACE_LEVEL_API, "Inner");
+}
+
+static void Outer(int calls)
+{
+    for (int i = 0; i < calls; i++)
+    {
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_API, "Outer");
+        Inner();
+    }
+}
+
+TEST_F(BinLogTrace, RecordsNestedTasksOfAllThreads)
+{
+    const int threads = 4, calls = 2000;
+    Configure(1 << 16);
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+        workers.push_back(std::thread(Outer, calls));
+    Outer(calls);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    ASSERT_EQ(0u, MFXTrace_Close());
+
+    BinLog log;
+    ASSERT_TRUE(ReadBinLog(m_log, log));
+    EXPECT_EQ(0, memcmp(log.header.magic, MFX_TRACE_BINLOG_MAGIC, sizeof(log.header.magic)));
+    EXPECT_EQ(MFX_TRACE_BINLOG_VERSION, log.header.version);
+    EXPECT_EQ((mfxTraceU32)getpid(), log.header.pid);
+
+    ASSERT_EQ(2u, log.names.size());
+    ASSERT_EQ((size_t)threads + 1, log.threads.size());
+
+    std::set<mfxTraceU32> taskIds;
+    for (auto& it : log.threads)
+    {
+        const BinLogThread& thread = it.second;
+        EXPECT_EQ(0u, thread.dropped);
+        ASSERT_EQ(4u * calls, thread.records.size());
+
+        std::vector<mfxTraceU32> stack;
+        mfxTraceU64 ticks = 0;
+        for (const mfxTraceBinLogRecord& record : thread.records)
+        {
+            ASSERT_LE(ticks, record.ticks);
+            ticks = record.ticks;
+
+            mfxTraceU32 id = record.id & ~MFX_TRACE_BINLOG_END;
+            ASSERT_TRUE(log.names.count(id));
+
+            if (record.id & MFX_TRACE_BINLOG_END)
+            {
+                ASSERT_FALSE(stack.empty());
+                ASSERT_EQ(stack.back(), id);
+                stack.pop_back();
+            }
+            else
+            {
+                stack.push_back(id);
+
+                // only Inner() requests task ids and they are unique
+                if (log.names[id] == "Inner")
+                    EXPECT_TRUE(taskIds.insert(record.task).second);
+                else
+                    EXPECT_EQ(0u, record.task);
+            }
+        }
+        EXPECT_TRUE(stack.empty());
+    }
+}
+
+TEST_F(BinLogTrace, CountsRecordsDroppedOnFullRing)
+{
+    const int calls = 100000;
+    Configure(1024);
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+    Outer(calls);
+    ASSERT_EQ(0u, MFXTrace_Close());
+
+    BinLog log;
+    ASSERT_TRUE(ReadBinLog(m_log, log));
+    ASSERT_EQ(1u, log.threads.size());
+
+    const BinLogThread& thread = log.threads.begin()->second;
+    EXPECT_EQ(4u * calls, thread.records.size() + thread.dropped);
+}
+
+static void SetCounters(mfxTraceU64 value)
+{
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_API, "Frames", value);
+    MFX_LTRACE_COUNTER(MFX_TRACE_LEVEL_API, "Bytes", value << 32);
+}
+
+TEST_F(BinLogTrace, RecordsCounterValues)
+{
+    const int calls = 100;
+    Configure(1 << 16);
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+    for (int i = 0; i < calls; i++)
+        SetCounters(i);
+    ASSERT_EQ(0u, MFXTrace_Close());
+
+    BinLog log;
+    ASSERT_TRUE(ReadBinLog(m_log, log));
+    ASSERT_EQ(2u, log.names.size());
+    ASSERT_EQ(1u, log.threads.size());
+
+    const BinLogThread& thread = log.threads.begin()->second;
+    ASSERT_EQ(2u * calls, thread.records.size());
+
+    for (int i = 0; i < calls; i++)
+    {
+        const mfxTraceBinLogRecord& frames = thread.records[2 * i];
+        const mfxTraceBinLogRecord& bytes  = thread.records[2 * i + 1];
+
+        ASSERT_TRUE(frames.id & MFX_TRACE_BINLOG_COUNTER);
+        ASSERT_TRUE(bytes.id & MFX_TRACE_BINLOG_COUNTER);
+        EXPECT_EQ("Frames", log.names[frames.id & ~MFX_TRACE_BINLOG_COUNTER]);
+        EXPECT_EQ("Bytes", log.names[bytes.id & ~MFX_TRACE_BINLOG_COUNTER]);
+
+        EXPECT_EQ((mfxTraceU32)i, frames.task);
+        // values not fitting 32 bits are saturated
+        EXPECT_EQ(i ? 0xFFFFFFFFu : 0u, bytes.task);
+    }
+}
+
+// Cost of a traced task with the binary log, run with --gtest_also_run_disabled_tests
+TEST_F(BinLogTrace, DISABLED_BeginEndOverhead)
+{
+    const int calls = 1000000;
+    Configure(1 << 20);
+
+    auto measure = [&]()
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < calls; i++)
+        {
+            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_API, "Task");
+        }
+        std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+        return ns.count() / calls;
+    };
+
+    double idle = measure();
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+    measure(); // first records allocate the ring
+    double logged = measure();
+    ASSERT_EQ(0u, MFXTrace_Close());
+
+    printf("BeginTask + EndTask: %.1f ns not initialized, %.1f ns with binary log\n", idle, logged);
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "mfx_trace.h"
+extern "C"
+{
+#include "mfx_trace_stat.h"
+}
+
+class StatTrace : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char dir[] = "/tmp/mfx_trace_test_XXXXXX";
+        ASSERT_TRUE(mkdtemp(dir));
+        m_dir = dir;
+        m_log = m_dir + "/stat.txt";
+
+        const char* home = getenv("HOME");
+        if (home)
+            m_home = home;
+        setenv("HOME", m_dir.c_str(), 1);
+
+        FILE* conf = fopen((m_dir + "/.mfx_trace").c_str(), "w");
+        ASSERT_TRUE(conf);
+        fprintf(conf, "Output=0x%x\nStatistic=%s\n", MFX_TRACE_OUTPUT_STAT, m_log.c_str());
+        fclose(conf);
+    }
+
+    void TearDown() override
+    {
+        if (!m_home.empty())
+            setenv("HOME", m_home.c_str(), 1);
+        remove((m_dir + "/.mfx_trace").c_str());
+        remove(m_log.c_str());
+        rmdir(m_dir.c_str());
+    }
+
+    std::vector<mfxTraceStatLatency> GetLatency()
+    {
+        mfxTraceU32 count = 0;
+        std::vector<mfxTraceStatLatency> latency;
+
+        while (MFXTraceStat_GetLatency(latency.data(), &count))
+            latency.resize(count);
+        latency.resize(count);
+        return latency;
+    }
+
+    std::string m_dir;
+    std::string m_log;
+    std::string m_home;
+};
+
+static void Leaf(int sleepMs)
+{
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_API, "Leaf");
+    if (sleepMs)
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+}
+
+static void Frame(int calls)
+{
+    for (int i = 0; i < calls; i++)
+    {
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_API, "Frame");
+        Leaf(0);
+        Leaf(0);
+    }
+}
+
+TEST_F(StatTrace, BuildsCallTreeMergedOverThreads)
+{
+    const int threads = 4, calls = 1000;
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+        workers.push_back(std::thread(Frame, calls));
+    for (std::thread& worker : workers)
+        worker.join();
+
+    // same task out of Frame is a different node
+    Leaf(0);
+
+    std::vector<mfxTraceStatLatency> latency = GetLatency();
+    ASSERT_EQ(3u, latency.size());
+
+    // depth-first: Frame, Frame/Leaf, Leaf
+    EXPECT_STREQ("Frame", latency[0].task_name);
+    EXPECT_EQ(1u, latency[0].depth);
+    EXPECT_EQ(0u, latency[0].parent);
+    EXPECT_EQ((mfxTraceU64)threads * calls, latency[0].count);
+
+    EXPECT_STREQ("Leaf", latency[1].task_name);
+    EXPECT_EQ(2u, latency[1].depth);
+    EXPECT_EQ(latency[0].id, latency[1].parent);
+    EXPECT_EQ(2ull * threads * calls, latency[1].count);
+
+    EXPECT_STREQ("Leaf", latency[2].task_name);
+    EXPECT_EQ(1u, latency[2].depth);
+    EXPECT_EQ(1u, latency[2].count);
+
+    for (const mfxTraceStatLatency& node : latency)
+    {
+        EXPECT_LE(node.min, node.p50);
+        EXPECT_LE(node.p50, node.p99);
+        EXPECT_LE(node.p99, node.p999);
+        EXPECT_LE(node.p999, node.max);
+        EXPECT_LE(node.max, node.total);
+    }
+
+    // a child can't be longer than its parent
+    EXPECT_LE(latency[1].total, latency[0].total);
+
+    ASSERT_EQ(0u, MFXTrace_Close());
+
+    std::ifstream file(m_log);
+    std::stringstream text;
+    text << file.rdbuf();
+    EXPECT_NE(std::string::npos, text.str().find("Task tree"));
+    EXPECT_NE(std::string::npos, text.str().find("\n  Leaf"));
+
+    // close starts new statistics
+    EXPECT_TRUE(GetLatency().empty());
+}
+
+TEST_F(StatTrace, FindsTailLatency)
+{
+    const int calls = 200, slowMs = 20;
+
+    ASSERT_EQ(0u, MFXTrace_Init());
+
+    // one percent of the calls is slow
+    for (int i = 0; i < calls; i++)
+        Leaf(i % 100 == 99 ? slowMs : 0);
+
+    std::vector<mfxTraceStatLatency> latency = GetLatency();
+    ASSERT_EQ(1u, latency.size());
+    EXPECT_EQ((mfxTraceU64)calls, latency[0].count);
+    EXPECT_LT(latency[0].p50, slowMs * 1e-3 / 10);
+    EXPECT_LT(latency[0].p99, slowMs * 1e-3 / 10);
+    EXPECT_GE(latency[0].p999, slowMs * 1e-3 * 31 / 32);
+    EXPECT_GE(latency[0].max, slowMs * 1e-3);
+
+    double p = 0;
+    EXPECT_EQ(0u, MFXTraceStat_GetPercentile(latency[0].id, 99.5, &p));
+    EXPECT_GE(p, slowMs * 1e-3 * 31 / 32);
+    EXPECT_EQ(0u, MFXTraceStat_GetPercentile(latency[0].id, 1., &p));
+    EXPECT_LE(latency[0].min, p);
+    EXPECT_LE(p, latency[0].p50);
+    EXPECT_NE(0u, MFXTraceStat_GetPercentile(latency[0].id, 0., &p));
+    EXPECT_NE(0u, MFXTraceStat_GetPercentile(0, 50., &p));
+
+    ASSERT_EQ(0u, MFXTrace_Close());
+}
@@ -0,0 +1,369 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "mfx_scheduler_core.h"
+
+namespace
+{
+
+const mfxU32 NUM_THREADS = 4;
+
+struct Counters
+{
+    Counters() : next(0), active(0), maxActive(0), calls(0) {}
+
+    std::atomic<int> next;
+    std::atomic<int> active;
+    std::atomic<int> maxActive;
+    std::atomic<int> calls;
+};
+
+struct ChainParam
+{
+    Counters *pCounters;
+    std::atomic<bool> *pGate;
+    int order;
+};
+
+mfxStatus ChainRoutine(void *, void *pParam, mfxU32, mfxU32)
+{
+    ChainParam *pChain = (ChainParam *) pParam;
+
+    // the first task holds the chain until all tasks are submitted
+    if ((pChain->pGate) && (false == *pChain->pGate))
+    {
+        return MFX_TASK_BUSY;
+    }
+    pChain->order = pChain->pCounters->next++;
+    return MFX_TASK_DONE;
+}
+
+// every call processes one piece, threads join the task until
+// all pieces are processed
+mfxStatus PiecesRoutine(void *, void *pParam, mfxU32, mfxU32)
+{
+    Counters *pCounters = (Counters *) pParam;
+
+    if (pCounters->next++ >= 64)
+    {
+        return MFX_TASK_DONE;
+    }
+    pCounters->calls++;
+    return MFX_TASK_WORKING;
+}
+
+// tracks the number of threads being inside the routine simultaneously
+mfxStatus ExclusiveRoutine(void *pState, void *, mfxU32, mfxU32)
+{
+    Counters *pCounters = (Counters *) pState;
+
+    int active = ++pCounters->active;
+    int maxActive = pCounters->maxActive;
+    while ((active > maxActive) &&
+           (false == pCounters->maxActive.compare_exchange_weak(maxActive, active)))
+    {
+    }
+    std::this_thread::yield();
+    pCounters->calls++;
+    pCounters->active--;
+
+    return MFX_TASK_DONE;
+}
+
+// reports the device is busy for the first calls
+mfxStatus BusyRoutine(void *, void *pParam, mfxU32, mfxU32)
+{
+    Counters *pCounters = (Counters *) pParam;
+
+    return (++pCounters->calls < 8) ? MFX_TASK_BUSY : MFX_TASK_DONE;
+}
+
+MFX_TASK MakeTask(mfxTaskRoutine pRoutine, void *pState, void *pParam,
+                  mfxTaskThreadingPolicy threadingPolicy, mfxU32 requiredNumThreads = 1)
+{
+    MFX_TASK task = {};
+
+    task.pOwner = pState;
+    task.entryPoint.pRoutine = pRoutine;
+    task.entryPoint.pState = pState;
+    task.entryPoint.pParam = pParam;
+    task.entryPoint.requiredNumThreads = requiredNumThreads;
+    task.threadingPolicy = threadingPolicy;
+    task.priority = MFX_PRIORITY_NORMAL;
+
+    return task;
+}
+
+} // namespace
+
+class SchedulerQueueMode : public ::testing::TestWithParam<mfxSchedulerQueueMode>
+{
+protected:
+    void SetUp() override
+    {
+        MFX_SCHEDULER_PARAM2 param = {};
+
+        param.flags = MFX_SCHEDULER_DEFAULT;
+        param.numberOfThreads = NUM_THREADS;
+        param.queueMode = GetParam();
+
+        m_pScheduler = new mfxSchedulerCore;
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->Initialize2(&param));
+    }
+
+    void TearDown() override
+    {
+        m_pScheduler->Release();
+    }
+
+    mfxStatus Run(const MFX_TASK &task)
+    {
+        mfxSyncPoint syncPoint = NULL;
+        mfxStatus sts = m_pScheduler->AddTask(task, &syncPoint);
+
+        return (MFX_ERR_NONE == sts) ? m_pScheduler->Synchronize(syncPoint, 10000) : sts;
+    }
+
+    mfxSchedulerCore *m_pScheduler;
+};
+
+TEST_P(SchedulerQueueMode, RunsDependentTasksInOrder)
+{
+    const int numTasks = 64;
+    Counters counters;
+    std::atomic<bool> gate(false);
+    std::vector<ChainParam> params(numTasks, ChainParam{&counters, NULL, -1});
+    std::vector<char> deps(numTasks);
+    std::vector<mfxSyncPoint> syncPoints(numTasks);
+
+    params[0].pGate = &gate;
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        MFX_TASK task = MakeTask(ChainRoutine, &params[i], &params[i], MFX_TASK_THREADING_INTER);
+        task.pSrc[0] = (i) ? &deps[i - 1] : NULL;
+        task.pDst[0] = &deps[i];
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+    }
+    gate = true;
+    m_pScheduler->ResetWaitingStatus(&params[0]);
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        EXPECT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+    }
+
+    for (int i = 0; i < numTasks - 1; i += 1)
+    {
+        EXPECT_LT(params[i].order, params[i + 1].order);
+    }
+    EXPECT_EQ(numTasks, counters.next);
+}
+
+TEST_P(SchedulerQueueMode, ThreadsJoinTasksOfRecycledObjects)
+{
+    // more tasks than the scheduler has task objects
+    const int numTasks = 2 * MFX_MAX_NUMBER_TASK;
+    const int batch = 32;
+
+    for (int first = 0; first < numTasks; first += batch)
+    {
+        std::vector<Counters> counters(batch);
+        std::vector<mfxSyncPoint> syncPoints(batch);
+
+        for (int i = 0; i < batch; i += 1)
+        {
+            MFX_TASK task = MakeTask(PiecesRoutine, &counters[i], &counters[i],
+                                     MFX_TASK_THREADING_INTER, NUM_THREADS);
+            ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+        }
+        for (int i = 0; i < batch; i += 1)
+        {
+            ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+            EXPECT_EQ(64, counters[i].calls);
+        }
+    }
+}
+
+TEST_P(SchedulerQueueMode, LimitsThreadsOfSharedAssignment)
+{
+    const int numTasks = 256;
+    Counters counters;
+    std::vector<mfxSyncPoint> syncPoints(numTasks);
+
+    // all tasks use the same thread assignment, which lets 2 threads in.
+    // Ready tasks wait for the assignment to get a free thread. Both
+    // threads might enter the same task.
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        MFX_TASK task = MakeTask(ExclusiveRoutine, &counters, NULL, MFX_TASK_THREADING_SHARED, 2);
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+    }
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        EXPECT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+    }
+
+    EXPECT_LE(numTasks, counters.calls);
+    EXPECT_LE(counters.maxActive, 2);
+}
+
+TEST_P(SchedulerQueueMode, SerializesIntraTasks)
+{
+    const int numTasks = 64;
+    Counters counters;
+    std::vector<mfxSyncPoint> syncPoints(numTasks);
+
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        MFX_TASK task = MakeTask(ExclusiveRoutine, &counters, NULL, MFX_TASK_THREADING_INTRA);
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+    }
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        EXPECT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+    }
+
+    EXPECT_EQ(numTasks, counters.calls);
+    EXPECT_EQ(1, counters.maxActive);
+}
+
+TEST_P(SchedulerQueueMode, ResumesBusyTask)
+{
+    Counters counters;
+
+    EXPECT_EQ(MFX_ERR_NONE, Run(MakeTask(BusyRoutine, &counters, &counters, MFX_TASK_THREADING_INTER)));
+    EXPECT_EQ(8, counters.calls);
+}
+
+TEST_P(SchedulerQueueMode, RunsDedicatedTasks)
+{
+    const int numTasks = 64;
+    Counters counters;
+    std::vector<mfxSyncPoint> syncPoints(numTasks);
+
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        MFX_TASK task = MakeTask(ExclusiveRoutine, &counters, NULL, MFX_TASK_THREADING_DEDICATED);
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+    }
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        EXPECT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+    }
+
+    EXPECT_EQ(numTasks, counters.calls);
+    EXPECT_EQ(1, counters.maxActive);
+}
+
+TEST_P(SchedulerQueueMode, ReportsStatistics)
+{
+    const int numTasks = 32;
+    Counters counters;
+    std::vector<mfxSyncPoint> syncPoints(numTasks);
+    MFX_SCHEDULER_STATISTICS stat = {};
+    mfxU64 numRuns = 0;
+
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        MFX_TASK task = MakeTask(ExclusiveRoutine, &counters, NULL, MFX_TASK_THREADING_INTER);
+        ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+    }
+    for (int i = 0; i < numTasks; i += 1)
+    {
+        EXPECT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoints[i], 10000));
+    }
+
+    EXPECT_EQ(MFX_ERR_NULL_PTR, m_pScheduler->GetStatistics(NULL));
+    ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->GetStatistics(&stat));
+    for (int i = 0; i < MFX_SCHEDULER_HISTOGRAM_BINS; i += 1)
+    {
+        numRuns += stat.runTime[i];
+    }
+    // run time is accounted before the task is signaled as done
+    EXPECT_EQ((mfxU64) numTasks, numRuns);
+    EXPECT_EQ((mfxU32) (2 * MFX_MAX_NUMBER_TASK), stat.dependencyTableSize);
+    EXPECT_LE(stat.numDependencies, stat.maxNumDependencies);
+}
+
+// gives the test access to the scheduler's guard
+class GuardedScheduler : public mfxSchedulerCore
+{
+public:
+    void HoldGuard(std::chrono::milliseconds time)
+    {
+        Guard guard(*this);
+        std::this_thread::sleep_for(time);
+    }
+};
+
+TEST(Scheduler, CountsGuardTimeOfCallers)
+{
+    MFX_SCHEDULER_PARAM2 param = {};
+    MFX_SCHEDULER_STATISTICS stat = {};
+    Counters counters;
+    mfxSyncPoint syncPoint;
+
+    param.flags = MFX_SCHEDULER_DEFAULT;
+    param.numberOfThreads = NUM_THREADS;
+
+    GuardedScheduler *pScheduler = new GuardedScheduler;
+    ASSERT_EQ(MFX_ERR_NONE, pScheduler->Initialize2(&param));
+
+    std::atomic<bool> holding(false);
+    std::thread holder([pScheduler, &holding]
+    {
+        holding = true;
+        pScheduler->HoldGuard(std::chrono::milliseconds(100));
+    });
+    while (false == holding)
+    {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // the caller waits for the guard until the holder leaves it
+    MFX_TASK task = MakeTask(ExclusiveRoutine, &counters, NULL, MFX_TASK_THREADING_INTER);
+    ASSERT_EQ(MFX_ERR_NONE, pScheduler->AddTask(task, &syncPoint));
+    holder.join();
+    EXPECT_EQ(MFX_ERR_NONE, pScheduler->Synchronize(syncPoint, 10000));
+
+    ASSERT_EQ(MFX_ERR_NONE, pScheduler->GetStatistics(&stat));
+    EXPECT_LE(50000u, stat.lockWaitTime);
+    EXPECT_LE(100000u, stat.lockHoldTime);
+
+    pScheduler->Release();
+}
+
+TEST(Scheduler, ReportsNoStatisticsBeforeInitialization)
+{
+    MFX_SCHEDULER_STATISTICS stat = {};
+    mfxSchedulerCore *pScheduler = new mfxSchedulerCore;
+
+    EXPECT_EQ(MFX_ERR_NOT_INITIALIZED, pScheduler->GetStatistics(&stat));
+
+    pScheduler->Release();
+}
+
+INSTANTIATE_TEST_CASE_P(Scheduler, SchedulerQueueMode,
+    ::testing::Values(MFX_SCHEDULER_QUEUE_SHARED, MFX_SCHEDULER_QUEUE_WORK_STEALING));
@@ -0,0 +1,222 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "mfx_umc_alloc_wrapper.h"
+
+namespace
+{
+    // Locks surfaces the way the core does and nothing else
+    class FakeCore : public VideoCORE
+    {
+    public:
+        mfxStatus GetHandle(mfxHandleType, mfxHDL *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus SetHandle(mfxHandleType, mfxHDL) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus SetBufferAllocator(mfxBufferAllocator *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus SetFrameAllocator(mfxFrameAllocator *) override { return MFX_ERR_UNSUPPORTED; }
+
+        mfxStatus AllocBuffer(mfxU32, mfxU16, mfxMemId *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus LockBuffer(mfxMemId, mfxU8 **) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus UnlockBuffer(mfxMemId) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus FreeBuffer(mfxMemId) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus CheckHandle() override { return MFX_ERR_NONE; }
+
+        mfxStatus GetFrameHDL(mfxMemId, mfxHDL *, bool) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus AllocFrames(mfxFrameAllocRequest *, mfxFrameAllocResponse *, bool) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus AllocFrames(mfxFrameAllocRequest *, mfxFrameAllocResponse *, mfxFrameSurface1 **, mfxU32) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus LockFrame(mfxMemId, mfxFrameData *) override { return MFX_ERR_NONE; }
+        mfxStatus UnlockFrame(mfxMemId, mfxFrameData *) override { return MFX_ERR_NONE; }
+        mfxStatus FreeFrames(mfxFrameAllocResponse *, bool) override { return MFX_ERR_NONE; }
+        mfxStatus LockExternalFrame(mfxMemId, mfxFrameData *, bool) override { return MFX_ERR_NONE; }
+        mfxStatus GetExternalFrameHDL(mfxMemId, mfxHDL *, bool) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus UnlockExternalFrame(mfxMemId, mfxFrameData *, bool) override { return MFX_ERR_NONE; }
+
+        mfxMemId MapIdx(mfxMemId mid) override { return mid; }
+        mfxFrameSurface1* GetNativeSurface(mfxFrameSurface1 *, bool) override { return 0; }
+        mfxFrameSurface1* GetOpaqSurface(mfxMemId, bool) override { return 0; }
+
+        mfxStatus IncreaseReference(mfxFrameData *ptr, bool) override { return IncreasePureReference(ptr->Locked); }
+        mfxStatus DecreaseReference(mfxFrameData *ptr, bool) override { return DecreasePureReference(ptr->Locked); }
+        mfxStatus IncreasePureReference(mfxU16 &locked) override { locked++; return MFX_ERR_NONE; }
+        mfxStatus DecreasePureReference(mfxU16 &locked) override
+        {
+            if (!locked)
+                return MFX_ERR_MORE_DATA;
+            locked--;
+            return MFX_ERR_NONE;
+        }
+
+        void GetVA(mfxHDL *phdl, mfxU16) override { *phdl = 0; }
+        mfxStatus CreateVA(mfxVideoParam *, mfxFrameAllocRequest *, mfxFrameAllocResponse *, UMC::FrameAllocator *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxU32 GetAdapterNumber(void) override { return 0; }
+        void GetVideoProcessing(mfxHDL *phdl) override { *phdl = 0; }
+        mfxStatus CreateVideoProcessing(mfxVideoParam *) override { return MFX_ERR_UNSUPPORTED; }
+        eMFXPlatform GetPlatformType() override { return MFX_PLATFORM_SOFTWARE; }
+        mfxU32 GetNumWorkingThreads(void) override { return 1; }
+        void INeedMoreThreadsInside(const void *) override {}
+
+        mfxStatus DoFastCopy(mfxFrameSurface1 *, mfxFrameSurface1 *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus DoFastCopyExtended(mfxFrameSurface1 *, mfxFrameSurface1 *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus DoFastCopyWrapper(mfxFrameSurface1 *, mfxU16, mfxFrameSurface1 *, mfxU16) override { return MFX_ERR_UNSUPPORTED; }
+        bool IsFastCopyEnabled(void) override { return false; }
+        bool IsExternalFrameAllocator(void) const override { return false; }
+        eMFXHWType GetHWType() override { return MFX_HW_UNKNOWN; }
+        bool SetCoreId(mfxU32) override { return true; }
+        eMFXVAType GetVAType() const override { return MFX_HW_NO; }
+        mfxStatus CopyFrame(mfxFrameSurface1 *, mfxFrameSurface1 *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus CopyBuffer(mfxU8 *, mfxU32, mfxFrameSurface1 *) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus CopyFrameEx(mfxFrameSurface1 *, mfxU16, mfxFrameSurface1 *, mfxU16) override { return MFX_ERR_UNSUPPORTED; }
+        mfxStatus IsGuidSupported(const GUID, mfxVideoParam *, bool) override { return MFX_ERR_UNSUPPORTED; }
+        bool CheckOpaqueRequest(mfxFrameAllocRequest *, mfxFrameSurface1 **, mfxU32, bool) override { return false; }
+        bool IsOpaqSurfacesAlreadyMapped(mfxFrameSurface1 **, mfxU32, mfxFrameAllocResponse *, bool) override { return false; }
+
+        void* QueryCoreInterface(const MFX_GUID &) override { return 0; }
+        mfxSession GetSession() override { return 0; }
+        void SetWrapper(void *) override {}
+        mfxU16 GetAutoAsyncDepth() override { return 1; }
+        bool IsCompatibleForOpaq() override { return false; }
+    };
+
+    class UmcFrameAllocator : public ::testing::Test
+    {
+    protected:
+        void Init(mfxU16 numSurfaces)
+        {
+            mfxVideoParam par = {};
+            par.mfx.FrameInfo.FourCC = MFX_FOURCC_NV12;
+            par.mfx.FrameInfo.Width  = 64;
+            par.mfx.FrameInfo.Height = 64;
+            par.IOPattern = MFX_IOPATTERN_OUT_SYSTEM_MEMORY;
+
+            mfxFrameAllocRequest request = {};
+            request.Info = par.mfx.FrameInfo;
+            request.Type = MFX_MEMTYPE_INTERNAL_FRAME | MFX_MEMTYPE_SYSTEM_MEMORY;
+            request.NumFrameMin = request.NumFrameSuggested = numSurfaces;
+
+            m_mids.resize(numSurfaces);
+            for (mfxU16 i = 0; i < numSurfaces; i++)
+                m_mids[i] = (mfxMemId)(size_t)(i + 1);
+
+            m_response = {};
+            m_response.mids = m_mids.data();
+            m_response.NumFrameActual = numSurfaces;
+
+            ASSERT_EQ(UMC::UMC_OK, m_allocator.InitMfx(0, &m_core, &par, &request, &m_response, false, true));
+            ASSERT_EQ(UMC::UMC_OK, m_info.Init(64, 64, UMC::NV12, 8));
+        }
+
+        // a decoded frame is referenced until the decoder releases it
+        UMC::FrameMemID Alloc()
+        {
+            UMC::FrameMemID mid = UMC::FRAME_MID_INVALID;
+
+            if (UMC::UMC_OK != m_allocator.Alloc(&mid, &m_info, 0))
+                return UMC::FRAME_MID_INVALID;
+
+            EXPECT_EQ(UMC::UMC_OK, m_allocator.IncreaseReference(mid));
+            return mid;
+        }
+
+        FakeCore               m_core;
+        mfx_UMC_FrameAllocator m_allocator;
+        UMC::VideoDataInfo     m_info;
+        std::vector<mfxMemId>  m_mids;
+        mfxFrameAllocResponse  m_response;
+    };
+}
+
+TEST_F(UmcFrameAllocator, ReusesSurfacesInReleaseOrder)
+{
+    Init(8);
+
+    std::vector<UMC::FrameMemID> mids;
+    for (int i = 0; i < 8; i++)
+        mids.push_back(Alloc());
+    EXPECT_EQ(UMC::FRAME_MID_INVALID, Alloc());
+
+    EXPECT_EQ(UMC::UMC_OK, m_allocator.DecreaseReference(mids[5]));
+    EXPECT_EQ(UMC::UMC_OK, m_allocator.DecreaseReference(mids[2]));
+
+    EXPECT_EQ(mids[5], Alloc());
+    EXPECT_EQ(mids[2], Alloc());
+    EXPECT_EQ(UMC::FRAME_MID_INVALID, Alloc());
+}
+
+TEST_F(UmcFrameAllocator, FindsSurfacesUnlockedOutsideOfAllocator)
+{
+    Init(4);
+
+    std::vector<UMC::FrameMemID> mids;
+    for (int i = 0; i < 4; i++)
+        mids.push_back(Alloc());
+
+    // the output surface is still locked by the application when the decoder releases it
+    mfxFrameSurface1 *output = m_allocator.GetSurfaceByIndex(mids[1]);
+    ASSERT_NE(nullptr, output);
+    EXPECT_EQ(MFX_ERR_NONE, m_core.IncreaseReference(&output->Data, true));
+    EXPECT_EQ(UMC::UMC_OK, m_allocator.DecreaseReference(mids[1]));
+    EXPECT_EQ(UMC::FRAME_MID_INVALID, Alloc());
+
+    EXPECT_EQ(MFX_ERR_NONE, m_core.DecreaseReference(&output->Data, true));
+    EXPECT_EQ(mids[1], Alloc());
+    EXPECT_EQ(UMC::FRAME_MID_INVALID, Alloc());
+}
+
+TEST_F(UmcFrameAllocator, DISABLED_Throughput)
+{
+    const int frames = 1000000, poolSize = 32, inFlight = 24;
+
+    Init(poolSize);
+
+    // decode loop: the oldest frame is released before the next one is allocated
+    std::vector<UMC::FrameMemID> ring;
+    for (int i = 0; i < inFlight; i++)
+        ring.push_back(Alloc());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        int slot = frame % inFlight;
+        m_allocator.DecreaseReference(ring[slot]);
+        ring[slot] = Alloc();
+    }
+    std::chrono::duration<double, std::nano> cycle = std::chrono::steady_clock::now() - start;
+
+    // exhausted pool: the decoder asks again and again until the application frees a surface
+    std::vector<UMC::FrameMemID> rest;
+    for (UMC::FrameMemID mid = Alloc(); mid != UMC::FRAME_MID_INVALID; mid = Alloc())
+        rest.push_back(mid);
+
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        UMC::FrameMemID mid;
+        m_allocator.Alloc(&mid, &m_info, 0);
+    }
+    std::chrono::duration<double, std::nano> exhausted = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(poolSize - inFlight, (int)rest.size());
+
+    printf("release + allocation: %.1f ns\n", cycle.count() / frames);
+    printf("allocation from exhausted pool: %.1f ns\n", exhausted.count() / frames);
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_H264_VIDEO_DECODE)
+#include "umc_h264_heap.h"
+#endif
+#if defined (MFX_ENABLE_H265_VIDEO_DECODE)
+#include "umc_h265_heap.h"
+#endif
+
+template <typename Base, size_t N>
+class TestObject : public Base
+{
+public:
+    TestObject() : resets(0) { created++; }
+    virtual ~TestObject() { destroyed++; }
+
+    virtual void Reset() { resets++; }
+
+    int resets;
+    char payload[N];
+
+    static std::atomic<int> created;
+    static std::atomic<int> destroyed;
+};
+
+template <typename Base, size_t N>
+std::atomic<int> TestObject<Base, N>::created(0);
+template <typename Base, size_t N>
+std::atomic<int> TestObject<Base, N>::destroyed(0);
+
+#if defined (MFX_ENABLE_H264_VIDEO_DECODE)
+struct H264Heap
+{
+    typedef UMC::H264_Heap_Objects Heap;
+    typedef UMC::HeapObject        Object;
+};
+#endif
+
+#if defined (MFX_ENABLE_H265_VIDEO_DECODE)
+struct H265Heap
+{
+    typedef UMC_HEVC_DECODER::Heap_Objects Heap;
+    typedef UMC_HEVC_DECODER::HeapObject   Object;
+};
+#endif
+
+typedef ::testing::Types<
+#if defined (MFX_ENABLE_H264_VIDEO_DECODE)
+    H264Heap
+#endif
+#if defined (MFX_ENABLE_H264_VIDEO_DECODE) && defined (MFX_ENABLE_H265_VIDEO_DECODE)
+    ,
+#endif
+#if defined (MFX_ENABLE_H265_VIDEO_DECODE)
+    H265Heap
+#endif
+> HeapTypes;
+
+template <typename T>
+class HeapObjects : public ::testing::Test
+{
+protected:
+    typedef typename T::Heap Heap;
+    typedef TestObject<typename T::Object, 64>  Small;
+    typedef TestObject<typename T::Object, 256> Large;
+
+    void SetUp() override
+    {
+        Small::created = 0;
+        Small::destroyed = 0;
+        Large::created = 0;
+        Large::destroyed = 0;
+    }
+
+    Heap m_heap;
+};
+
+TYPED_TEST_CASE(HeapObjects, HeapTypes);
+
+TYPED_TEST(HeapObjects, ReusesFreedObjectOfSameSize)
+{
+    typedef typename TestFixture::Small Small;
+
+    Small* first = this->m_heap.template AllocateObject<Small>();
+    this->m_heap.FreeObject(first);
+    EXPECT_EQ(1, first->resets);
+
+    Small* second = this->m_heap.template AllocateObject<Small>();
+    EXPECT_EQ(first, second);
+    this->m_heap.FreeObject(second);
+}
+
+TYPED_TEST(HeapObjects, KeepsTypedAndRawItemsApart)
+{
+    typedef typename TestFixture::Small Small;
+
+    Small* object = this->m_heap.template AllocateObject<Small>();
+    this->m_heap.FreeObject(object);
+
+    void* raw = this->m_heap.Allocate(sizeof(Small));
+    EXPECT_NE((void*)object, raw);
+    this->m_heap.Free(raw);
+
+    EXPECT_EQ(object, this->m_heap.template AllocateObject<Small>());
+    EXPECT_EQ(raw, this->m_heap.Allocate(sizeof(Small)));
+    this->m_heap.FreeObject(object);
+    this->m_heap.Free(raw);
+}
+
+TYPED_TEST(HeapObjects, IgnoresSecondFree)
+{
+    typedef typename TestFixture::Small Small;
+
+    Small* object = this->m_heap.template AllocateObject<Small>();
+    this->m_heap.FreeObject(object);
+    this->m_heap.FreeObject(object);
+    EXPECT_EQ(1, object->resets);
+
+    Small* first = this->m_heap.template AllocateObject<Small>();
+    Small* second = this->m_heap.template AllocateObject<Small>();
+    EXPECT_NE(first, second);
+    this->m_heap.FreeObject(first);
+    this->m_heap.FreeObject(second);
+}
+
+// the owner of the reference frees the object again, so trims keep it
+TYPED_TEST(HeapObjects, KeepsObjectFreedWhileReferenced)
+{
+    typedef typename TestFixture::Small Small;
+
+    Small* owned = this->m_heap.template AllocateObject<Small>();
+    Small* other = this->m_heap.template AllocateObject<Small>();
+    owned->IncrementReference();
+    this->m_heap.FreeObject(owned);
+    this->m_heap.FreeObject(other);
+
+    // the second trim releases items above the high water mark
+    this->m_heap.Trim();
+    this->m_heap.Trim();
+    ASSERT_EQ(1, Small::destroyed);
+
+    owned->DecrementReference();
+    EXPECT_EQ(1, owned->resets);
+
+    this->m_heap.Trim();
+    EXPECT_EQ(2, Small::destroyed);
+}
+
+TYPED_TEST(HeapObjects, TrimsSizeNotUsedAnymore)
+{
+    typedef typename TestFixture::Small Small;
+    typedef typename TestFixture::Large Large;
+    const int count = 16;
+
+    std::vector<Small*> objects;
+    for (int i = 0; i < count; i++)
+        objects.push_back(this->m_heap.template AllocateObject<Small>());
+    for (Small* object : objects)
+        this->m_heap.FreeObject(object);
+
+    // like after resolution change: other size only, enough frees for a few trims
+    for (int i = 0; i < 8192; i++)
+        this->m_heap.FreeObject(this->m_heap.template AllocateObject<Large>());
+
+    EXPECT_EQ(count, Small::destroyed);
+    EXPECT_EQ(0, Large::destroyed);
+}
+
+TYPED_TEST(HeapObjects, KeepsItemsUpToHighWaterMark)
+{
+    typedef typename TestFixture::Small Small;
+    const int inFlight = 8;
+
+    std::vector<Small*> objects;
+    for (int i = 0; i < 8192; i++)
+    {
+        objects.push_back(this->m_heap.template AllocateObject<Small>());
+        if (objects.size() == inFlight)
+        {
+            for (Small* object : objects)
+                this->m_heap.FreeObject(object);
+            objects.clear();
+        }
+    }
+
+    // all items were needed at once, so none is released
+    EXPECT_EQ(0, Small::destroyed);
+
+    this->m_heap.Release();
+    EXPECT_EQ(inFlight, Small::destroyed);
+}
+
+// Half of the objects are freed by the next thread, so items move between the
+// caches of the threads and the bins. Run it with TSan too.
+TYPED_TEST(HeapObjects, ThreadsAllocateAndFreeConcurrently)
+{
+    typedef typename TestFixture::Small Small;
+    const int threads = 4, objects = 20000, batch = 16;
+
+    std::mutex mutex;
+    std::vector<std::vector<Small*> > inbox(threads);
+    std::vector<std::thread> workers;
+
+    auto freeAll = [this](std::vector<Small*>& objects, char stamp)
+    {
+        for (Small* object : objects)
+        {
+            for (char c : object->payload)
+                ASSERT_EQ(stamp, c);
+            this->m_heap.FreeObject(object);
+        }
+        objects.clear();
+    };
+
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+        {
+            std::vector<Small*> own, passed, received;
+
+            for (int i = 0; i < objects; i++)
+            {
+                Small* object = this->m_heap.template AllocateObject<Small>();
+                memset(object->payload, t, sizeof(object->payload));
+                (i & 1 ? own : passed).push_back(object);
+
+                if (own.size() < batch)
+                    continue;
+
+                freeAll(own, (char)t);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto& next = inbox[(t + 1) % threads];
+                    next.insert(next.end(), passed.begin(), passed.end());
+                    received.swap(inbox[t]);
+                }
+                passed.clear();
+                freeAll(received, (char)((t + threads - 1) % threads));
+            }
+
+            freeAll(own, (char)t);
+            freeAll(passed, (char)t);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    for (int t = 0; t < threads; t++)
+        freeAll(inbox[t], (char)((t + threads - 1) % threads));
+
+    this->m_heap.Release();
+    EXPECT_EQ(Small::created, Small::destroyed);
+}
+
+// Allocation pattern of a decoder: slices and list items of few frames in flight
+// while items of the previous resolution stay on the free list. Returns ns per
+// allocation and free.
+template <typename Heap, typename Small, typename Large>
+double AllocateLikeDecoder(Heap& heap, int frames)
+{
+    const int inFlight = 8, slices = 4, deadSizes = 64;
+
+    std::vector<void*> dead;
+    for (int i = 0; i < deadSizes; i++)
+        dead.push_back(heap.Allocate(1024 + 16 * i));
+    for (void* ptr : dead)
+        heap.Free(ptr);
+
+    std::vector<std::vector<void*> > raw(inFlight);
+    std::vector<std::vector<Large*> > typed(inFlight);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        int slot = frame % inFlight;
+        for (void* ptr : raw[slot])
+            heap.Free(ptr);
+        for (Large* slice : typed[slot])
+            heap.FreeObject(slice);
+        raw[slot].clear();
+        typed[slot].clear();
+
+        for (int i = 0; i < slices; i++)
+        {
+            typed[slot].push_back(heap.template AllocateObject<Large>());
+            raw[slot].push_back(heap.Allocate(sizeof(Small)));
+        }
+    }
+    std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+
+    for (int slot = 0; slot < inFlight; slot++)
+    {
+        for (void* ptr : raw[slot])
+            heap.Free(ptr);
+        for (Large* slice : typed[slot])
+            heap.FreeObject(slice);
+    }
+
+    return ns.count() / (frames * slices * 2);
+}
+
+// Run with --gtest_also_run_disabled_tests
+TYPED_TEST(HeapObjects, DISABLED_Throughput)
+{
+    typedef typename TestFixture::Small Small;
+    typedef typename TestFixture::Large Large;
+
+    printf("allocation + free: %.1f ns\n", AllocateLikeDecoder<typename TestFixture::Heap, Small, Large>(this->m_heap, 200000));
+}
+
+// Threads decoding slices allocate from one heap
+TYPED_TEST(HeapObjects, DISABLED_ThroughputOfThreads)
+{
+    typedef typename TestFixture::Small Small;
+    typedef typename TestFixture::Large Large;
+    const int threads = 4;
+
+    std::vector<double> ns(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+        {
+            ns[t] = AllocateLikeDecoder<typename TestFixture::Heap, Small, Large>(this->m_heap, 200000);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    for (int t = 0; t < threads; t++)
+        printf("thread %d allocation + free: %.1f ns\n", t, ns[t]);
+}
@@ -0,0 +1,336 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "umc_start_code.h"
+
+namespace
+{
+    typedef const uint8_t * (*FindFunc)(const uint8_t * begin, const uint8_t * end);
+    typedef void (*SwapFunc)(uint8_t * pBuffer, size_t nSize);
+
+    struct Variant
+    {
+        const char * name;
+        bool         supported;
+        FindFunc     findStartCode;
+        FindFunc     findEmulationPrevention;
+        SwapFunc     swapDwords;
+    };
+
+    std::vector<Variant> SupportedVariants()
+    {
+        const Variant variants[] =
+        {
+            { "C",    true,                                  UMC::FindStartCodePrefix_C,    UMC::FindEmulationPrevention_C,    UMC::SwapDwords_C },
+            { "SSE4", __builtin_cpu_supports("sse4.1") != 0, UMC::FindStartCodePrefix_SSE4, UMC::FindEmulationPrevention_SSE4, UMC::SwapDwords_SSE4 },
+            { "AVX2", __builtin_cpu_supports("avx2") != 0,   UMC::FindStartCodePrefix_AVX2, UMC::FindEmulationPrevention_AVX2, UMC::SwapDwords_AVX2 },
+        };
+
+        std::vector<Variant> supported;
+        for (const Variant & v : variants)
+        {
+            if (v.supported)
+                supported.push_back(v);
+        }
+        return supported;
+    }
+
+    std::string VariantName(const ::testing::TestParamInfo<Variant> & info)
+    {
+        return info.param.name;
+    }
+
+    // byte by byte search the kernels are checked against
+    const uint8_t * FindStartCodePrefixRef(const uint8_t * begin, const uint8_t * end)
+    {
+        for (const uint8_t * p = begin; end - p >= 3; p++)
+        {
+            if (!p[0] && !p[1] && p[2] == 1)
+                return p;
+        }
+        return nullptr;
+    }
+
+    const uint8_t * FindEmulationPreventionRef(const uint8_t * begin, const uint8_t * end)
+    {
+        for (const uint8_t * p = begin; end - p >= 3; p++)
+        {
+            if (!p[0] && !p[1] && p[2] == 3)
+                return p;
+        }
+        return nullptr;
+    }
+
+    // drops 0x03 which follows two zero bytes, zero count restarts after the dropped byte
+    std::vector<uint8_t> RemoveEmulationPreventionRef(const std::vector<uint8_t> & src, std::vector<uint32_t> & removed)
+    {
+        std::vector<uint8_t> dst;
+        int zeros = 0;
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            if (zeros >= 2 && src[i] == 3)
+            {
+                removed.push_back(uint32_t(i));
+                zeros = 0;
+                continue;
+            }
+            zeros = src[i] ? 0 : zeros + 1;
+            dst.push_back(src[i]);
+        }
+        return dst;
+    }
+
+    // bytes which start or break the sequences the kernels look for
+    std::vector<uint8_t> RandomStream(std::mt19937 & rng, size_t size)
+    {
+        const uint8_t bytes[] = { 0, 0, 0, 1, 3, 0x80, 0xff };
+        std::uniform_int_distribution<size_t> pick(0, sizeof(bytes) - 1);
+
+        std::vector<uint8_t> stream(size);
+        for (auto & x : stream)
+            x = bytes[pick(rng)];
+        return stream;
+    }
+
+    class StartCode : public ::testing::TestWithParam<Variant>
+    {
+    protected:
+        std::mt19937 rng{ 2019 };
+    };
+}
+
+TEST_P(StartCode, FindsPrefixAtEveryOffset)
+{
+    // every position around 16 and 32 byte chunk boundaries, with unaligned begin
+    for (size_t shift = 0; shift < 4; shift++)
+    {
+        for (size_t size = 0; size <= 100; size++)
+        {
+            std::vector<uint8_t> buffer(shift + size + 4, 0xff);
+            const uint8_t * begin = buffer.data() + shift;
+            const uint8_t * end   = begin + size;
+
+            ASSERT_EQ(nullptr, GetParam().findStartCode(begin, end)) << "size " << size;
+
+            for (size_t pos = 0; pos + 3 <= size + 2; pos++)
+            {
+                std::fill(buffer.begin(), buffer.end(), 0xff);
+                buffer[shift + pos]     = 0;
+                buffer[shift + pos + 1] = 0;
+                buffer[shift + pos + 2] = 1;
+
+                // prefix which doesn't end within the range isn't found
+                const uint8_t * expected = (pos + 3 <= size) ? begin + pos : nullptr;
+                ASSERT_EQ(expected, GetParam().findStartCode(begin, end))
+                    << "shift " << shift << " size " << size << " position " << pos;
+            }
+        }
+    }
+}
+
+TEST_P(StartCode, MatchesReferenceOnRandomStreams)
+{
+    for (int iter = 0; iter < 2000; iter++)
+    {
+        std::vector<uint8_t> stream = RandomStream(rng, 1 + iter % 300);
+        const uint8_t * begin = stream.data();
+        const uint8_t * end   = begin + stream.size();
+
+        // walk all prefixes the way the splitters do
+        for (const uint8_t * from = begin; from < end; )
+        {
+            const uint8_t * expected = FindStartCodePrefixRef(from, end);
+            ASSERT_EQ(expected, GetParam().findStartCode(from, end))
+                << "iteration " << iter << " offset " << (from - begin);
+            if (!expected)
+                break;
+            from = expected + 1;
+        }
+    }
+}
+
+TEST_P(StartCode, SwapsDwords)
+{
+    for (size_t size = 0; size <= 160; size += 4)
+    {
+        std::vector<uint8_t> buffer = RandomStream(rng, size + 1);
+        std::vector<uint8_t> expected = buffer;
+        for (size_t i = 0; i < size; i += 4)
+            std::reverse(expected.begin() + i, expected.begin() + i + 4);
+
+        GetParam().swapDwords(buffer.data(), size);
+        ASSERT_EQ(expected, buffer) << "size " << size;
+    }
+}
+
+TEST_P(StartCode, FindsEmulationPreventionAtVectorBoundaries)
+{
+    for (size_t shift = 0; shift < 4; shift++)
+    {
+        for (size_t size = 0; size <= 100; size++)
+        {
+            std::vector<uint8_t> buffer(shift + size + 4);
+            const uint8_t * begin = buffer.data() + shift;
+            const uint8_t * end   = begin + size;
+
+            for (size_t pos = 0; pos + 3 <= size + 2; pos++)
+            {
+                // start code prefixes around the sequence mustn't be taken for it
+                std::fill(buffer.begin(), buffer.end(), 1);
+                buffer[shift + pos]     = 0;
+                buffer[shift + pos + 1] = 0;
+                buffer[shift + pos + 2] = 3;
+
+                const uint8_t * expected = (pos + 3 <= size) ? begin + pos : nullptr;
+                ASSERT_EQ(expected, GetParam().findEmulationPrevention(begin, end))
+                    << "shift " << shift << " size " << size << " position " << pos;
+            }
+        }
+    }
+}
+
+TEST_P(StartCode, FindsEmulationPreventionOnRandomStreams)
+{
+    for (int iter = 0; iter < 2000; iter++)
+    {
+        std::vector<uint8_t> stream = RandomStream(rng, 1 + iter % 300);
+        const uint8_t * begin = stream.data();
+        const uint8_t * end   = begin + stream.size();
+
+        for (const uint8_t * from = begin; from < end; )
+        {
+            const uint8_t * expected = FindEmulationPreventionRef(from, end);
+            ASSERT_EQ(expected, GetParam().findEmulationPrevention(from, end))
+                << "iteration " << iter << " offset " << (from - begin);
+            if (!expected)
+                break;
+            from = expected + 3;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Isa, StartCode, ::testing::ValuesIn(SupportedVariants()), VariantName);
+
+TEST(EmulationPrevention, RemovesRunsAtVectorBoundaries)
+{
+    // runs of 0x000003 starting around 16 and 32 byte boundaries, back to back
+    // and separated by one byte, followed by a zero which mustn't be dropped
+    for (size_t pos = 0; pos < 70; pos++)
+    {
+        for (size_t count = 1; count <= 4; count++)
+        {
+            for (size_t gap = 0; gap < 2; gap++)
+            {
+                std::vector<uint8_t> src(pos, 0x55);
+                for (size_t i = 0; i < count; i++)
+                {
+                    src.insert(src.end(), { 0, 0, 3 });
+                    src.insert(src.end(), gap, 0x80);
+                }
+                src.insert(src.end(), { 0, 3, 0x55 });
+
+                std::vector<uint32_t> expectedOffsets, offsets;
+                std::vector<uint8_t> expected = RemoveEmulationPreventionRef(src, expectedOffsets);
+
+                std::vector<uint8_t> dst(src.size());
+                dst.resize(UMC::RemoveEmulationPreventionBytes(dst.data(), src.data(), src.size(), &offsets));
+
+                ASSERT_EQ(expected, dst) << "position " << pos << " count " << count << " gap " << gap;
+                ASSERT_EQ(expectedOffsets, offsets) << "position " << pos << " count " << count << " gap " << gap;
+            }
+        }
+    }
+}
+
+TEST(EmulationPrevention, MatchesReferenceOnRandomStreams)
+{
+    std::mt19937 rng(2019);
+    for (int iter = 0; iter < 2000; iter++)
+    {
+        std::vector<uint8_t> src = RandomStream(rng, iter % 300);
+
+        std::vector<uint32_t> expectedOffsets, offsets;
+        std::vector<uint8_t> expected = RemoveEmulationPreventionRef(src, expectedOffsets);
+
+        std::vector<uint8_t> dst(src.size());
+        dst.resize(UMC::RemoveEmulationPreventionBytes(dst.data(), src.data(), src.size(), &offsets));
+
+        ASSERT_EQ(expected, dst) << "iteration " << iter;
+        ASSERT_EQ(expectedOffsets, offsets) << "iteration " << iter;
+    }
+}
+
+TEST(StartCodeDispatch, MatchesReference)
+{
+    std::mt19937 rng(7);
+    std::vector<uint8_t> stream = RandomStream(rng, 4096);
+    const uint8_t * end = stream.data() + stream.size();
+
+    for (const uint8_t * from = stream.data(); from < end; from++)
+        ASSERT_EQ(FindStartCodePrefixRef(from, end), UMC::FindStartCodePrefix(from, end));
+}
+
+// Scan speed on a high bitrate intra-like stream: random slice data without
+// zero pairs and a start code every 64 KB. Run with --gtest_also_run_disabled_tests
+TEST(StartCodeBenchmark, DISABLED_Throughput)
+{
+    const size_t size = 64 << 20, slice = 64 << 10;
+    std::mt19937 rng(2019);
+    std::uniform_int_distribution<int> byte(1, 255);
+
+    std::vector<uint8_t> stream(size);
+    for (auto & x : stream)
+        x = (uint8_t)byte(rng);
+    for (size_t pos = 0; pos + 3 <= size; pos += slice)
+    {
+        stream[pos]     = 0;
+        stream[pos + 1] = 0;
+        stream[pos + 2] = 1;
+    }
+
+    const uint8_t * end = stream.data() + size;
+    std::vector<const uint8_t *> expected;
+    for (const uint8_t * p = FindStartCodePrefixRef(stream.data(), end); p; p = FindStartCodePrefixRef(p + 3, end))
+        expected.push_back(p);
+
+    const int repeat = 8;
+    for (const Variant & v : SupportedVariants())
+    {
+        std::vector<const uint8_t *> found;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeat; i++)
+        {
+            found.clear();
+            for (const uint8_t * p = v.findStartCode(stream.data(), end); p; p = v.findStartCode(p + 3, end))
+                found.push_back(p);
+        }
+        std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(expected, found) << v.name;
+        printf("%-5s %8.2f GB/s\n", v.name, double(size) * repeat / sec.count() / 1e9);
+    }
+}
@@ -19,10 +19,15 @@
 // SOFTWARE.
 
 #pragma once
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include <list>
-#include <set>
+#include <algorithm>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <type_traits>
+#include <cstddef>
 #include <memory.h>
 
 //#define BS_MEM_TRACE
@@ -73,6 +78,19 @@ public:
     void* Get() { return m_obj; }
 };
 
+// Small objects are placed into chunks instead of separate heap blocks.
+// A chunk is reused as a whole when the last object placed into it is freed,
+// since objects of one AU are allocated and freed together this works as a per-AU arena.
+struct ArenaChunk
+{
+    static const size_t Size  = 64 * 1024;
+    static const size_t Align = alignof(std::max_align_t);
+
+    unsigned char data[Size];
+    size_t used  = 0;
+    unsigned int live = 0;
+};
+
 class MemD
 {
 public:
@@ -80,6 +98,7 @@ public:
         : locked(0)
         , to_delete(false)
         , mem(nullptr)
+        , chunk(nullptr)
     {
     }
 
@@ -91,19 +110,108 @@ public:
 
     unsigned int locked;
     bool to_delete;
-    std::set<void*> base;
-    std::set<void*> dep;
+    std::vector<void*> base; // usually 0-2 entries, no need for a set
+    std::vector<void*> dep;
     MemBase* mem;
+    ArenaChunk* chunk;
 };
 
 class Allocator
 {
 private:
-    std::map<void*, MemD> m_mem;
+    // chunks must outlive m_mem
+    std::vector<std::unique_ptr<ArenaChunk>> m_chunks;
+    std::vector<ArenaChunk*> m_spareChunks;
+    ArenaChunk* m_chunk;
+    std::unordered_map<void*, MemD> m_mem;
     std::recursive_mutex m_mtx;
     bool m_zero;
 
     inline bool Touch(void* p) { return !!m_mem.count(p); }
+
+    static inline void Insert(std::vector<void*>& v, void* p)
+    {
+        if (std::find(v.begin(), v.end(), p) == v.end())
+            v.push_back(p);
+    }
+
+    static inline void Erase(std::vector<void*>& v, void* p)
+    {
+        auto it = std::find(v.begin(), v.end(), p);
+        if (it != v.end())
+            v.erase(it);
+    }
+
+    void* ArenaAlloc(size_t size, ArenaChunk*& chunk)
+    {
+        size = (size + ArenaChunk::Align - 1) & ~(ArenaChunk::Align - 1);
+
+        if (m_chunk && m_chunk->used + size > ArenaChunk::Size)
+        {
+            if (m_chunk->live)
+                m_chunk = nullptr; // will be recycled by the last ArenaFree()
+            else
+                m_chunk->used = 0;
+        }
+
+        if (!m_chunk)
+        {
+            if (!m_spareChunks.empty())
+            {
+                m_chunk = m_spareChunks.back();
+                m_spareChunks.pop_back();
+            }
+            else
+            {
+                m_chunks.emplace_back(new ArenaChunk);
+                m_chunk = m_chunks.back().get();
+            }
+        }
+
+        void* p = m_chunk->data + m_chunk->used;
+        m_chunk->used += size;
+        m_chunk->live++;
+        chunk = m_chunk;
+
+        return p;
+    }
+
+    void ArenaFree(ArenaChunk* chunk)
+    {
+        if (--chunk->live)
+            return;
+
+        chunk->used = 0;
+
+        if (chunk != m_chunk)
+            m_spareChunks.push_back(chunk);
+    }
+
+    template<class T> T* AllocObj(unsigned int count, bool zero)
+    {
+        if (!std::is_trivially_destructible<T>::value || (size_t)count * sizeof(T) > ArenaChunk::Size / 4)
+        {
+            MemBase* pObj = new MemObj<T>(count, zero);
+            T* p = (T*)pObj->Get();
+
+            m_mem[p].mem = pObj;
+            return p;
+        }
+
+        ArenaChunk* chunk = nullptr;
+        T* p = (T*)ArenaAlloc(sizeof(T) * count, chunk);
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (zero)
+                new (p + i) T{};
+            else
+                new (p + i) T;
+        }
+
+        m_mem[p].chunk = chunk;
+        return p;
+    }
     inline void __notrace(const char*, ...) {}
 
 #ifdef BS_MEM_TRACE
@@ -115,7 +223,8 @@ private:
 public:
 
     Allocator()
-        : m_zero(false)
+        : m_chunk(nullptr)
+        , m_zero(false)
     {
     }
 
@@ -144,8 +253,8 @@ public:
         if (!Touch(base) || !Touch(dep))
             throw std::bad_alloc();
 
-        m_mem[base].dep.insert(dep);
-        m_mem[dep].base.insert(base);
+        Insert(m_mem[base].dep, dep);
+        Insert(m_mem[dep].base, base);
     }
 
     template<class T> T* alloc(void* base = nullptr, unsigned int count = 1)
@@ -155,10 +264,7 @@ public:
 
         std::unique_lock<std::recursive_mutex> _lock(m_mtx);
 
-        MemBase* pObj = new MemObj<T>(count, m_zero);
-        T* p = (T*)pObj->Get();
-
-        m_mem[p].mem = pObj;
+        T* p = AllocObj<T>(count, m_zero);
 
         BS_MEM_TRACE_F("BS_MEM::alloc(%p, %d) = %p\n", base, count, p);
         if (base)
@@ -174,10 +280,7 @@ public:
 
         std::unique_lock<std::recursive_mutex> _lock(m_mtx);
 
-        MemBase* pObj = new MemObj<T>(count, false);
-        T* p = (T*)pObj->Get();
-
-        m_mem[p].mem = pObj;
+        T* p = AllocObj<T>(count, false);
 
         BS_MEM_TRACE_F("BS_MEM::alloc_nozero(%p, %d) = %p\n", base, count, p);
         if (base)
@@ -215,12 +318,15 @@ public:
         {
             auto& ddep = m_mem[pdep];
 
-            ddep.base.erase(p);
+            Erase(ddep.base, p);
 
             if (ddep.base.empty())
                 free(pdep);
         }
 
+        if (d.chunk)
+            ArenaFree(d.chunk);
+
         m_mem.erase(p);
     }
 
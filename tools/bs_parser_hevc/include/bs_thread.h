@@ -23,12 +23,18 @@
 #include <mutex>
 #include <condition_variable>
 #include <list>
+#include <deque>
+#include <vector>
+#include <set>
+#include <unordered_map>
 #include <algorithm>
 #include <exception>
 
 namespace BsThread
 {
 
+struct Thread;
+
 typedef enum
 {
       DONE = 0
@@ -49,12 +55,23 @@ struct Task
     unsigned int id;
     int priority;
     unsigned int n;
-    std::list<Task*> dependent;
+    std::vector<Task*> dependent;
+    std::vector<Task*> base;
     unsigned int blocked;
     bool detach;
     State state;
-    std::mutex mtx;
-    std::condition_variable cv;
+    Thread* local; // worker whose ready queue holds the task
+};
+
+// ready queue order: higher priority first, then submission order
+struct TaskOrder
+{
+    bool operator() (const Task* l, const Task* r) const
+    {
+        if (l->priority != r->priority)
+            return l->priority > r->priority;
+        return l->id < r->id;
+    }
 };
 
 struct Thread
@@ -65,6 +82,8 @@ struct Thread
     Task* task;
     bool terminate;
     unsigned int id;
+    // tasks unblocked by this worker, it takes the newest, idle workers steal the oldest
+    std::deque<Task*> ready;
 };
 
 inline bool Ready(State s)
@@ -84,7 +103,13 @@ class Scheduler
 {
 private:
     std::list<Thread>       m_thread;
-    std::list<Task>         m_task;
+    std::list<Task>         m_task;     // submitted tasks
+    std::list<Task>         m_free;     // released tasks kept for reuse
+    std::unordered_map<SyncPoint, std::list<Task>::iterator> m_index;
+    std::set<Task*, TaskOrder> m_queued;  // submitted and re-queued tasks
+    size_t                  m_local;    // tasks in the ready queues of the workers
+    std::list<Task*>        m_waiting;  // returned WAITING, re-queued when any task is ready
+    std::vector<Thread*>    m_idle;
     std::recursive_mutex    m_mtx;
     std::condition_variable_any m_cv;
     unsigned int            m_id;
@@ -94,6 +119,16 @@ private:
     static void Execute (Thread& self, Scheduler& sync);
     static void Update  (Scheduler& self, Thread* thread);
 
+    Task*   Find    (SyncPoint id);
+    Task&   NewTask ();
+    void    Queue   (Task& task, Thread* local = 0);
+    void    Dequeue (Task& task);
+    Task*   Next    (Thread& thread);
+    void    Unlink  (Task& task);
+    void    Remove  (Task& task);
+    void    Dispatch(Thread* thread);
+
+    void _Lose(Task& task);
     void _AbortDependent(Task& task);
 
 public:
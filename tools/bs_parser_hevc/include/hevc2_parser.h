@@ -29,6 +29,7 @@
 #include <algorithm>
 #include <vector>
 #include <list>
+#include <map>
 
 namespace BS_HEVC2
 {
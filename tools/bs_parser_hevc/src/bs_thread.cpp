@@ -69,6 +69,7 @@ Scheduler::Scheduler()
     m_locked = 0;
     m_id = 0;
     m_depth = 0;
+    m_local = 0;
 }
 
 Scheduler::~Scheduler()
@@ -98,8 +99,11 @@ void Scheduler::Init(unsigned int nThreads, unsigned int depth)
             t->id = id++;
             t->task = 0;
             t->terminate = false;
+            m_idle.push_back(&*t);
             t->thread = std::thread(Execute, std::ref(*t), std::ref(*this));
         }
+
+        Dispatch(0);
     }
 
     m_depth += depth;
@@ -129,14 +133,135 @@ void Scheduler::Close()
         for (auto& t : m_thread)
             t.thread.join();
 
+        m_idle.resize(0);
         m_thread.resize(0);
+        m_queued.clear();
+        m_local = 0;
+        m_waiting.clear();
+        m_index.clear();
         m_task.resize(0);
+        m_free.resize(0);
 
         m_id = 0;
         m_depth = 0;
     }
 }
 
+Task* Scheduler::Find(SyncPoint id)
+{
+    auto it = m_index.find(id);
+
+    if (it == m_index.end())
+        return 0;
+
+    return &*it->second;
+}
+
+Task& Scheduler::NewTask()
+{
+    if (m_free.empty())
+        m_free.resize(1);
+
+    m_task.splice(m_task.end(), m_free, m_free.begin());
+
+    Task& task = m_task.back();
+
+    task.id = m_id++;
+    task.dependent.clear();
+    task.base.clear();
+    m_index[task.id] = std::prev(m_task.end());
+
+    return task;
+}
+
+void Scheduler::Queue(Task& task, Thread* local)
+{
+    task.state = QUEUED;
+    task.local = local;
+
+    if (local)
+    {
+        local->ready.push_back(&task);
+        m_local++;
+    }
+    else
+        m_queued.insert(&task);
+}
+
+void Scheduler::Dequeue(Task& task)
+{
+    if (task.local)
+    {
+        auto& ready = task.local->ready;
+        ready.erase(std::remove(ready.begin(), ready.end(), &task), ready.end());
+        task.local = 0;
+        m_local--;
+    }
+    else
+        m_queued.erase(&task);
+}
+
+// The worker continues with the newest task it unblocked unless a queued task has
+// a higher priority. Without such tasks it steals the oldest task of another worker,
+// the one with the highest priority if there is a choice.
+Task* Scheduler::Next(Thread& thread)
+{
+    Task* pTask = 0;
+
+    if (!thread.ready.empty())
+        pTask = thread.ready.back();
+
+    if (!m_queued.empty() && (!pTask || TaskOrder()(*m_queued.begin(), pTask)))
+        pTask = *m_queued.begin();
+
+    if (!pTask)
+    {
+        for (auto& t : m_thread)
+        {
+            if (!t.ready.empty() && (!pTask || TaskOrder()(t.ready.front(), pTask)))
+                pTask = t.ready.front();
+        }
+    }
+
+    if (pTask)
+        Dequeue(*pTask);
+
+    return pTask;
+}
+
+void Scheduler::Unlink(Task& task)
+{
+    for (Task* pBase : task.base)
+    {
+        auto& dep = pBase->dependent;
+        dep.erase(std::remove(dep.begin(), dep.end(), &task), dep.end());
+    }
+    task.base.clear();
+}
+
+void Scheduler::Remove(Task& task)
+{
+    auto it = m_index.find(task.id);
+
+    if (it == m_index.end())
+        return;
+
+    Dequeue(task);
+    m_waiting.remove(&task);
+
+    Unlink(task);
+
+    for (Task* pDep : task.dependent)
+    {
+        auto& base = pDep->base;
+        base.erase(std::remove(base.begin(), base.end(), &task), base.end());
+    }
+    task.dependent.clear();
+
+    m_free.splice(m_free.end(), m_task, it->second);
+    m_index.erase(it);
+}
+
 unsigned int Scheduler::Submit(Routine* routine, void* par, int priority, unsigned int nDep, unsigned int *dep)
 {
     std::unique_lock<std::recursive_mutex> lock(m_mtx);
@@ -147,15 +272,16 @@ unsigned int Scheduler::Submit(Routine* routine, void* par, int priority, unsign
     {
         bool flag = false;
 
-        m_task.remove_if(
-            [&] (Task& t) -> bool
-            {
-                if (t.state != DONE || !t.dependent.empty())
-                    return false;
-                flag = true;
-                return true;
-            }
-        );
+        for (auto it = m_task.begin(); it != m_task.end();)
+        {
+            Task& t = *it++;
+
+            if (t.state != DONE || !t.dependent.empty())
+                continue;
+
+            Remove(t);
+            flag = true;
+        }
 
         if (!flag)
         {
@@ -170,45 +296,45 @@ unsigned int Scheduler::Submit(Routine* routine, void* par, int priority, unsign
         }
     }
 
-    m_task.resize(m_task.size() + 1);
-    Task& task = m_task.back();
+    Task& task = NewTask();
 
-    task.id = m_id++;
     task.Execute = routine;
     task.param = par;
     task.priority = priority;
     task.blocked = 0;
     task.n = 0;
     task.detach = false;
+    task.state = WAITING;
+    task.local = 0;
 
     for (unsigned int i = 0; i < nDep; i++)
     {
-        auto it = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == dep[i]; });
+        Task* pBase = Find(dep[i]);
 
-        if (it != m_task.end())
+        if (pBase)
         {
-            if (it->state == FAILED || it->state == LOST)
+            if (pBase->state == FAILED || pBase->state == LOST)
             {
-                BS_THREAD_TRACE_F(": ID=%d BL=0 -- LOST on %d\n", task.id, it->id);
+                BS_THREAD_TRACE_F(": ID=%d BL=0 -- LOST on %d\n", task.id, pBase->id);
                 BS_THREAD_TRACE_FLUSH;
 
-                task.blocked = 0;
-                task.state = LOST;
+                _Lose(task);
                 return task.id;
             }
 
-            if (it->state != DONE)
+            if (pBase->state != DONE)
             {
-                it->dependent.push_back(&task);
+                pBase->dependent.push_back(&task);
+                task.base.push_back(pBase);
                 task.blocked++;
             }
         }
     }
 
-    task.state = task.blocked ? WAITING : QUEUED;
+    if (!task.blocked)
+        Queue(task);
 
-    BS_THREAD_TRACE_F(": ID=%d BL=%d -- QUEUED\n", task.id, task.blocked);
+    BS_THREAD_TRACE_F(": ID=%d BL=%d -- %s\n", task.id, task.blocked, State2CS[task.state]);
     BS_THREAD_TRACE_FLUSH;
 
     Update(*this, 0);
@@ -223,44 +349,33 @@ State Scheduler::Sync(unsigned int id, unsigned int waitMS, bool keepStat)
     BS_THREAD_TRACE_F("Scheduler::Sync(ID=%d, Wait=%d, Keep=%d) ", id, waitMS, keepStat);
     BS_THREAD_TRACE_FLUSH;
 
-    auto it = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == id; });
+    Task* pTask = Find(id);
 
-    if (it == m_task.end() || it->detach)
+    if (!pTask || pTask->detach)
     {
         BS_THREAD_TRACE_F("-- LOST(DEQUEUED)\n");
         BS_THREAD_TRACE_FLUSH;
         return LOST;
     }
-    Task* pTask = &*it;
     st = pTask->state;
 
-    if (waitMS)
+    if (waitMS && !Ready(st))
     {
         BS_THREAD_TRACE_F(": wait\n");
         BS_THREAD_TRACE_FLUSH;
 
-        lock.unlock();
-
-        {
-            std::unique_lock<std::mutex> lockTask(pTask->mtx);
-
-            pTask->cv.wait_for(lockTask, std::chrono::milliseconds(waitMS),
-                [&]() -> bool { return Ready(pTask->state); } );
-
-            st = pTask->state;
-        }
+        // the task may be dequeued while waiting, so look it up again on every wake-up
+        m_cv.wait_for(lock, std::chrono::milliseconds(waitMS),
+            [&]() -> bool { pTask = Find(id); return !pTask || Ready(pTask->state); });
 
-        lock.lock();
+        st = pTask ? pTask->state : LOST;
 
         BS_THREAD_TRACE_F("Scheduler::Sync(ID=%d, Wait=%d, Keep=%d) : return ", id, waitMS, keepStat);
         BS_THREAD_TRACE_FLUSH;
     }
 
-    if (Ready(st) && !keepStat)
-    {
-        m_task.remove_if([&] (Task& t) -> bool { return t.id == id; });
-    }
+    if (pTask && Ready(st) && !keepStat)
+        Remove(*pTask);
 
     BS_THREAD_TRACE_F("-- %s\n", State2CS[st]);
     BS_THREAD_TRACE_FLUSH;
@@ -274,24 +389,21 @@ void Scheduler::Detach(SyncPoint id)
     BS_THREAD_TRACE_F("Scheduler::Detach(ID=%d) ", id);
     BS_THREAD_TRACE_FLUSH;
 
-    auto itT = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == id; });
+    Task* pTask = Find(id);
 
-    if (itT == m_task.end())
+    if (!pTask)
     {
         BS_THREAD_TRACE_F("-- LOST(DEQUEUED)\n");
         BS_THREAD_TRACE_FLUSH;
         return;
     }
 
-    BS_THREAD_TRACE_F(" -- %s\n", State2CS[itT->state]);
+    BS_THREAD_TRACE_F(" -- %s\n", State2CS[pTask->state]);
 
-    itT->detach = true;
+    pTask->detach = true;
 
-    if (Ready(itT->state))
-    {
-        m_task.remove_if([&] (Task& t) -> bool { return t.id == id; });
-    }
+    if (Ready(pTask->state))
+        Remove(*pTask);
 }
 
 bool Scheduler::WaitForAny(unsigned int waitMS)
@@ -307,16 +419,15 @@ State Scheduler::AddDependency(SyncPoint id, unsigned int nDep, SyncPoint *dep)
     BS_THREAD_TRACE_F("Scheduler::AddDependency(ID=%d, D=%s) ", id, __UIA2CS(nDep, dep).c_str);
     BS_THREAD_TRACE_FLUSH;
 
-    auto itT = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == id; });
+    Task* pTask = Find(id);
 
-    if (itT == m_task.end())
+    if (!pTask)
     {
         BS_THREAD_TRACE_F("-- LOST(DEQUEUED)\n");
         BS_THREAD_TRACE_FLUSH;
         return LOST;
     }
-    Task& task = *itT;
+    Task& task = *pTask;
 
     if (Ready(task.state) || task.state == WORKING)
     {
@@ -327,28 +438,23 @@ State Scheduler::AddDependency(SyncPoint id, unsigned int nDep, SyncPoint *dep)
 
     for (unsigned int i = 0; i < nDep; i++)
     {
-        auto it = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == dep[i]; });
+        Task* pBase = Find(dep[i]);
 
-        if (it != m_task.end())
+        if (pBase)
         {
-            auto& base = *it;
-            std::unique_lock<std::mutex> lockTask(task.mtx);
-
-            if (base.state == FAILED || base.state == LOST)
+            if (pBase->state == FAILED || pBase->state == LOST)
             {
-                BS_THREAD_TRACE_F(" -- LOST on %d\n", base.id);
+                BS_THREAD_TRACE_F(" -- LOST on %d\n", pBase->id);
                 BS_THREAD_TRACE_FLUSH;
 
-                task.blocked = 0;
-                task.state = LOST;
+                _Lose(task);
                 return LOST;
             }
 
-            if (base.state != DONE)
+            if (pBase->state != DONE)
             {
-                //std::unique_lock<std::mutex> lockBase(task.mtx);
-                base.dependent.push_back(&task);
+                pBase->dependent.push_back(&task);
+                task.base.push_back(pBase);
                 task.blocked++;
             }
         }
@@ -356,7 +462,7 @@ State Scheduler::AddDependency(SyncPoint id, unsigned int nDep, SyncPoint *dep)
 
     if (task.blocked)
     {
-        std::unique_lock<std::mutex> lockTask(task.mtx);
+        Dequeue(task);
         task.state = WAITING;
     }
 
@@ -372,47 +478,43 @@ bool Scheduler::Abort(SyncPoint id, unsigned int waitMS)
     BS_THREAD_TRACE_F("Scheduler::Abort(ID=%d, Wait=%d) ", id, waitMS);
     BS_THREAD_TRACE_FLUSH;
 
-    auto it = std::find_if(m_task.begin(), m_task.end(),
-            [&] (Task& t) -> bool { return t.id == id; });
+    Task* pTask = Find(id);
 
-    if (it == m_task.end())
+    if (!pTask)
     {
         BS_THREAD_TRACE_F("-- LOST(DEQUEUED)\n");
         BS_THREAD_TRACE_FLUSH;
         return true;
     }
 
-    Task* pTask = &*it;
     BS_THREAD_TRACE_F(": wait\n");
     BS_THREAD_TRACE_FLUSH;
 
-    lock.unlock();
-
+    if (pTask->state == WORKING)
     {
-        std::unique_lock<std::mutex> lockTask(pTask->mtx);
-
-        pTask->cv.wait_for(lockTask, std::chrono::milliseconds(waitMS),
-            [&]() -> bool { return pTask->state != WORKING; } );
+        m_cv.wait_for(lock, std::chrono::milliseconds(waitMS),
+            [&]() -> bool { pTask = Find(id); return !pTask || pTask->state != WORKING; });
     }
 
-    lock.lock();
+    if (!pTask)
+    {
+        BS_THREAD_TRACE_F("Scheduler::Abort(ID=%d, Wait=%d) : DEQUEUED\n", id, waitMS);
+        BS_THREAD_TRACE_FLUSH;
+        return true;
+    }
 
     if (pTask->state != WORKING)
     {
         BS_THREAD_TRACE_F("Scheduler::Abort(ID=%d, Wait=%d) : DONE\n", id, waitMS);
         BS_THREAD_TRACE_FLUSH;
         pTask->state = LOST;
+        pTask->blocked = 0;
 
         if (!pTask->dependent.empty())
             _AbortDependent(*pTask);
 
-        if (pTask->blocked)
-        {
-            for (auto& t : m_task)
-                t.dependent.remove(pTask);
-        }
-
-        m_task.remove_if([&] (Task& t) -> bool { return t.id == id; });
+        Remove(*pTask);
+        m_cv.notify_all();
 
         return true;
     }
@@ -423,19 +525,42 @@ bool Scheduler::Abort(SyncPoint id, unsigned int waitMS)
     return false;
 }
 
+void Scheduler::_Lose(Task& task)
+{
+    task.state = LOST;
+    task.blocked = 0;
+
+    Dequeue(task);
+    m_waiting.remove(&task);
+    Unlink(task);
+
+    if (!task.dependent.empty())
+        _AbortDependent(task);
+
+    if (task.detach)
+        Remove(task);
+    else
+        m_cv.notify_all();
+}
+
 void Scheduler::_AbortDependent(Task& task)
 {
     BS_THREAD_TRACE_F("      Abort:");
 
-    for (auto& dep : task.dependent)
+    std::vector<Task*> dependent;
+    dependent.swap(task.dependent);
+
+    for (auto& dep : dependent)
     {
-        std::unique_lock<std::mutex> lockDep(dep->mtx);
-        dep->blocked = 0;
-        dep->state = LOST;
+        dep->base.erase(std::remove(dep->base.begin(), dep->base.end(), &task), dep->base.end());
+
+        // already unblocked by this task and started or finished
+        if (dep->state == WORKING || Ready(dep->state))
+            continue;
+
         BS_THREAD_TRACE_F(" %d", dep->id);
-        dep->cv.notify_one();
+        _Lose(*dep);
     }
-    task.dependent.resize(0);
 
     BS_THREAD_TRACE_F("\n");
     BS_THREAD_TRACE_FLUSH;
@@ -468,119 +593,89 @@ void Scheduler::Execute(Thread& self, Scheduler& sync)
 void Scheduler::Update(Scheduler& self, Thread* thread)
 {
     std::unique_lock<std::recursive_mutex> lock(self.m_mtx);
-    auto FindThread = [&] () -> Thread*
-    {
-        auto it = std::find_if(self.m_thread.begin(), self.m_thread.end(),
-            [] (Thread& t) -> bool { return !t.task; });
-
-        if (it == self.m_thread.end())
-            return 0;
-
-        return &*it;
-    };
-    std::list<Task*> queued;
-    std::list<SyncPoint> detached;
 
     BS_THREAD_TRACE_F("Scheduler::Update()\n");
     BS_THREAD_TRACE_FLUSH;
 
     if (thread && thread->task)
     {
+        Task& task = *thread->task;
+        thread->task = 0;
+
         BS_THREAD_TRACE_F("    : TH=%d ID=%d N=%d -- %s\n",
-            thread->id, thread->task->id, thread->task->n, State2CS[thread->task->state]);
+            thread->id, task.id, task.n, State2CS[task.state]);
         BS_THREAD_TRACE_FLUSH;
 
-        if (thread->task->state == WORKING)
-            thread->task->state = QUEUED;
-
-        if (   thread->task->state == DONE
-            || thread->task->state == FAILED)
+        if (task.state == WORKING || task.state == QUEUED)
+            self.Queue(task);
+        else if (task.state == WAITING)
+        {
+            self.m_waiting.push_back(&task);
+            // wake up Abort() waiting for the task to leave WORKING
+            self.m_cv.notify_all();
+        }
+        else if (task.state == DONE)
         {
-            std::unique_lock<std::mutex> lockTask(thread->task->mtx);
+            BS_THREAD_TRACE_F("      Unlock:");
 
-            if (thread->task->state == DONE)
+            for (auto& dep : task.dependent)
             {
-                BS_THREAD_TRACE_F("      Unlock:");
-
-                for (auto& dep : thread->task->dependent)
+                if (dep->blocked)
                 {
-                    if (dep->blocked)
-                    {
-                        dep->blocked--;
+                    dep->blocked--;
 
-                        if (!dep->blocked)
-                            dep->state = QUEUED;
+                    if (!dep->blocked)
+                        self.Queue(*dep, thread);
 
-                        BS_THREAD_TRACE_F(" %d(%d)", dep->id, dep->blocked);
-                    }
+                    BS_THREAD_TRACE_F(" %d(%d)", dep->id, dep->blocked);
                 }
-                BS_THREAD_TRACE_F("\n");
-                BS_THREAD_TRACE_FLUSH;
             }
-            else if (!thread->task->dependent.empty())
-                self._AbortDependent(*thread->task);
-
-            thread->task->cv.notify_one();
+            BS_THREAD_TRACE_F("\n");
+            BS_THREAD_TRACE_FLUSH;
         }
+        else if (!task.dependent.empty())
+            self._AbortDependent(task);
 
-        if (Ready(thread->task->state))
+        if (Ready(task.state))
         {
-            for (auto& task : self.m_task)
+            for (Task* pWaiting : self.m_waiting)
             {
-                if (   task.state == WAITING
-                    && !task.blocked
-                    && task.id != thread->task->id)
-                {
-                    task.state = QUEUED;
-                }
-                task.dependent.remove(thread->task);
+                if (pWaiting->state == WAITING && !pWaiting->blocked)
+                    self.Queue(*pWaiting);
             }
+            self.m_waiting.clear();
 
-            if (thread->task->detach)
-                detached.push_back(thread->task->id);
-
-            self.m_cv.notify_one();
-        }
-
-        thread->task = 0;
-    }
+            self.Unlink(task);
 
-    for (auto& task : self.m_task)
-    {
-        if (task.state == LOST)
-        {
-            if (task.dependent.size())
-                self._AbortDependent(task);
             if (task.detach)
-                detached.push_back(task.id);
-            else
-            {
-                std::unique_lock<std::mutex> lockTask(task.mtx);
-                task.cv.notify_one();
-            }
-        }
-        else if (task.state == QUEUED)
-            queued.push_back(&task);
+                self.Remove(task);
 
-        BS_THREAD_TRACE_F("    : ID=%d BL=%d P=%d N=%d -- %s\n",
-            task.id, task.blocked, task.priority, task.n, State2CS[task.state]);
-        BS_THREAD_TRACE_FLUSH;
-    }
-
-    for (auto& id : detached)
-    {
-        self.m_task.remove_if([&id] (Task& t) -> bool { return t.id == id; });
+            self.m_cv.notify_all();
+        }
     }
 
-    queued.sort([](Task* l, Task* r) { return (l->priority > r->priority); });
+    self.Dispatch(thread);
+}
 
-    for (Task* pTask : queued)
+void Scheduler::Dispatch(Thread* thread)
+{
+    while (!m_queued.empty() || m_local)
     {
-        Thread* pThread = FindThread();
+        Thread* pThread = 0;
 
-        if (!pThread)
+        // keep the calling worker busy before waking up an idle one
+        if (thread && !thread->task)
+            pThread = thread;
+        else if (!m_idle.empty())
+        {
+            pThread = m_idle.back();
+            m_idle.pop_back();
+        }
+        else
             break;
 
+        Task* pTask = Next(*pThread);
+
         std::unique_lock<std::mutex> lockThread(pThread->mtx, std::defer_lock);
 
         if (pThread != thread)
@@ -599,4 +694,7 @@ void Scheduler::Update(Scheduler& self, Thread* thread)
             lockThread.unlock();
         }
     }
+
+    if (thread && !thread->task)
+        m_idle.push_back(thread);
 }
@@ -0,0 +1,267 @@
+// Copyright (c) 2019 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Converts binary log of mfx_trace (MFX_TRACE_OUTPUT_BINLOG) into Chrome trace
+// JSON which can be opened in chrome://tracing or Perfetto UI.
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mfx_trace_binlog.h"
+
+struct TaskName
+{
+    std::string task;
+    std::string function;
+    std::string file;
+    mfxTraceU32 line = 0;
+};
+
+struct ThreadEvents
+{
+    mfxTraceU32 thread = 0;
+    mfxTraceU32 dropped = 0;
+    std::vector<mfxTraceBinLogRecord> records;
+};
+
+static void PrintUsage(const char* app)
+{
+    fprintf(stderr, "Usage: %s <binary log> [<output json>]\n", app);
+}
+
+static bool ReadFile(const char* name, std::vector<char>& data)
+{
+    FILE* file = fopen(name, "rb");
+    if (!file)
+        return false;
+
+    char buffer[1 << 16];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + read);
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static std::string Escape(const std::string& str)
+{
+    std::string out;
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+        }
+        else
+            out += c;
+    }
+    return out;
+}
+
+// reads zero terminated string, moves pos after it
+static std::string ReadString(const char*& pos, const char* end)
+{
+    const char* zero = std::find(pos, end, '\0');
+    std::string str(pos, zero);
+    pos = (zero < end) ? zero + 1 : end;
+    return str;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<char> data;
+    if (!ReadFile(argv[1], data))
+    {
+        fprintf(stderr, "Error: failed to read %s\n", argv[1]);
+        return 1;
+    }
+
+    mfxTraceBinLogHeader header = {};
+    if (data.size() < sizeof(header))
+    {
+        fprintf(stderr, "Error: %s is not a binary log\n", argv[1]);
+        return 1;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, MFX_TRACE_BINLOG_MAGIC, sizeof(header.magic)) || header.version != MFX_TRACE_BINLOG_VERSION)
+    {
+        fprintf(stderr, "Error: %s is not a binary log of version %d\n", argv[1], MFX_TRACE_BINLOG_VERSION);
+        return 1;
+    }
+
+    std::map<mfxTraceU32, TaskName> names;
+    std::vector<ThreadEvents> chunks;
+    std::vector<mfxTraceBinLogClock> clocks;
+    mfxTraceU64 start = ~0ull;
+
+    size_t offset = sizeof(header);
+    while (offset + sizeof(mfxTraceBinLogChunk) <= data.size())
+    {
+        mfxTraceBinLogChunk chunk;
+        memcpy(&chunk, &data[offset], sizeof(chunk));
+        offset += sizeof(chunk);
+
+        if (chunk.size > data.size() - offset)
+        {
+            fprintf(stderr, "Warning: log is truncated\n");
+            break;
+        }
+
+        const char* pos = &data[offset];
+        const char* end = pos + chunk.size;
+        offset += chunk.size;
+
+        if (chunk.type == MFX_TRACE_BINLOG_CHUNK_NAME && chunk.size >= sizeof(mfxTraceBinLogName))
+        {
+            mfxTraceBinLogName name;
+            memcpy(&name, pos, sizeof(name));
+            pos += sizeof(name);
+
+            TaskName& task = names[name.id];
+            task.line     = name.line_num;
+            task.task     = ReadString(pos, end);
+            task.function = ReadString(pos, end);
+            task.file     = ReadString(pos, end);
+        }
+        else if (chunk.type == MFX_TRACE_BINLOG_CHUNK_EVENTS && chunk.size >= sizeof(mfxTraceBinLogEvents))
+        {
+            mfxTraceBinLogEvents events;
+            memcpy(&events, pos, sizeof(events));
+            pos += sizeof(events);
+
+            ThreadEvents thread;
+            thread.thread  = events.thread;
+            thread.dropped = events.dropped;
+            thread.records.resize((end - pos) / sizeof(mfxTraceBinLogRecord));
+            if (!thread.records.empty())
+            {
+                memcpy(thread.records.data(), pos, thread.records.size() * sizeof(mfxTraceBinLogRecord));
+                start = std::min(start, thread.records.front().ticks);
+            }
+            chunks.push_back(std::move(thread));
+        }
+        else if (chunk.type == MFX_TRACE_BINLOG_CHUNK_CLOCK && chunk.size >= sizeof(mfxTraceBinLogClock))
+        {
+            mfxTraceBinLogClock clock;
+            memcpy(&clock, pos, sizeof(clock));
+            clocks.push_back(clock);
+        }
+        // unknown chunks are skipped
+    }
+
+    // the trace clock is steady, scale is taken from the most distant points
+    double nsPerTick = 1.0;
+    if (clocks.size() >= 2 && clocks.back().ticks > clocks.front().ticks)
+    {
+        nsPerTick = double(clocks.back().time - clocks.front().time) /
+                    double(clocks.back().ticks - clocks.front().ticks);
+    }
+    const double usPerTick = nsPerTick / 1000.0;
+
+    FILE* out = stdout;
+    if (argc == 3)
+    {
+        out = fopen(argv[2], "w");
+        if (!out)
+        {
+            fprintf(stderr, "Error: failed to open %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    const char* separator = "";
+    size_t count = 0, dropped = 0;
+    for (const ThreadEvents& thread : chunks)
+    {
+        if (thread.dropped)
+        {
+            // chunk follows the records lost, mark the point they were noticed at
+            mfxTraceU64 ticks = thread.records.empty() ? start : thread.records.front().ticks;
+            fprintf(out, "%s{\"name\":\"%u records dropped\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u}",
+                separator, thread.dropped, (ticks - start) * usPerTick, header.pid, thread.thread);
+            separator = ",\n";
+            dropped += thread.dropped;
+        }
+
+        for (const mfxTraceBinLogRecord& record : thread.records)
+        {
+            const TaskName& task = names[record.id & ~(MFX_TRACE_BINLOG_END | MFX_TRACE_BINLOG_COUNTER)];
+            std::string name = Escape(task.task.empty() ? task.function : task.task);
+
+            if (record.id & MFX_TRACE_BINLOG_COUNTER)
+            {
+                fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%u,\"args\":{\"value\":%u}}",
+                    separator, name.c_str(), Escape(task.function).c_str(),
+                    (record.ticks - start) * usPerTick, header.pid, record.task);
+                separator = ",\n";
+                ++count;
+                continue;
+            }
+
+            fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u",
+                separator, name.c_str(), Escape(task.function).c_str(),
+                (record.id & MFX_TRACE_BINLOG_END) ? "E" : "B",
+                (record.ticks - start) * usPerTick, header.pid, thread.thread);
+
+            if (!(record.id & MFX_TRACE_BINLOG_END))
+            {
+                fprintf(out, ",\"args\":{\"file\":\"%s:%u\"", Escape(task.file).c_str(), task.line);
+                if (record.task)
+                    fprintf(out, ",\"task\":%u", record.task);
+                fprintf(out, "}");
+            }
+            fprintf(out, "}");
+            separator = ",\n";
+            ++count;
+        }
+    }
+
+    fprintf(out, "\n]}\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "%zu events converted", count);
+    if (dropped)
+        fprintf(stderr, ", %zu events were dropped, increase BinLogRingSize", dropped);
+    fprintf(stderr, "\n");
+    return 0;
+}